@@ -11,6 +11,7 @@
 #include <chrono>
 #include <cstdint>
 #include <iostream>
+#include <kalshi/orderbook_book.hpp>
 #include <kalshi/websocket.hpp>
 #include <map>
 #include <mutex>
@@ -40,9 +41,9 @@ struct LiveMarketState {
 	// Sequence tracking for orderbook
 	std::int32_t last_seq{0};
 
-	// Internal orderbook depth (yes side only for simplicity)
-	std::map<std::int32_t, std::int32_t> yes_bids; // price -> quantity
-	std::map<std::int32_t, std::int32_t> yes_asks; // price -> quantity (derived from no bids)
+	// Full depth for both sides. A subscription usually covers several
+	// tickers, so seq is only monotonic per market, not contiguous.
+	OrderBookBook book{SeqCheck::Monotonic};
 };
 
 /// Manages live market state for multiple tickers
@@ -131,26 +132,7 @@ private:
 		auto& state = states_[snap.market_ticker];
 		state.ticker = snap.market_ticker;
 		state.last_seq = snap.seq;
-
-		// Clear and rebuild orderbook
-		state.yes_bids.clear();
-		state.yes_asks.clear();
-
-		// YES bids are direct bids on the YES side
-		for (const OrderBookEntry& entry : snap.yes) {
-			if (entry.quantity > 0) {
-				state.yes_bids[entry.price_cents] = entry.quantity;
-			}
-		}
-
-		// NO bids at price P translate to YES asks at price (100 - P)
-		for (const OrderBookEntry& entry : snap.no) {
-			if (entry.quantity > 0) {
-				std::int32_t yes_ask_price = 100 - entry.price_cents;
-				state.yes_asks[yes_ask_price] = entry.quantity;
-			}
-		}
-
+		(void)state.book.apply(snap);
 		update_best_bid_ask(state);
 	}
 
@@ -158,26 +140,10 @@ private:
 		std::lock_guard lock(mutex_);
 		auto& state = states_[delta.market_ticker];
 		state.ticker = delta.market_ticker;
-		state.last_seq = delta.seq;
-
-		if (delta.side == Side::Yes) {
-			// Delta on YES side affects YES bids
-			std::map<std::int32_t, std::int32_t>& book = state.yes_bids;
-			book[delta.price] += delta.delta;
-			if (book[delta.price] <= 0) {
-				book.erase(delta.price);
-			}
-		} else {
-			// Delta on NO side affects YES asks (100 - price)
-			std::int32_t yes_ask_price = 100 - delta.price;
-			std::map<std::int32_t, std::int32_t>& book = state.yes_asks;
-			book[yes_ask_price] += delta.delta;
-			if (book[yes_ask_price] <= 0) {
-				book.erase(yes_ask_price);
-			}
+		if (state.book.apply(delta) == BookUpdate::Applied) {
+			state.last_seq = delta.seq;
+			update_best_bid_ask(state);
 		}
-
-		update_best_bid_ask(state);
 	}
 
 	void handle_trade(const WsTrade& trade) {
@@ -191,25 +157,14 @@ private:
 	}
 
 	void update_best_bid_ask(LiveMarketState& state) {
-		// Best bid = highest price with quantity > 0
-		if (!state.yes_bids.empty()) {
-			auto it = state.yes_bids.rbegin(); // highest price
-			state.best_bid_price = it->first;
-			state.best_bid_size = it->second;
-		} else {
-			state.best_bid_price = std::nullopt;
-			state.best_bid_size = std::nullopt;
-		}
-
-		// Best ask = lowest price with quantity > 0
-		if (!state.yes_asks.empty()) {
-			auto it = state.yes_asks.begin(); // lowest price
-			state.best_ask_price = it->first;
-			state.best_ask_size = it->second;
-		} else {
-			state.best_ask_price = std::nullopt;
-			state.best_ask_size = std::nullopt;
-		}
+		// YES bid = highest YES bid; YES ask = 100 - highest NO bid.
+		const std::optional<OrderBookEntry> bid = state.book.best_bid(Side::Yes);
+		state.best_bid_price = bid ? std::optional<std::int32_t>(bid->price_cents) : std::nullopt;
+		state.best_bid_size = bid ? std::optional<std::int32_t>(bid->quantity) : std::nullopt;
+
+		const std::optional<OrderBookEntry> ask = state.book.best_ask(Side::Yes);
+		state.best_ask_price = ask ? std::optional<std::int32_t>(ask->price_cents) : std::nullopt;
+		state.best_ask_size = ask ? std::optional<std::int32_t>(ask->quantity) : std::nullopt;
 	}
 };
 
@@ -4,19 +4,29 @@
 /// @brief Complete REST API client for Kalshi
 
 #include "kalshi/error.hpp"
+#include "kalshi/field_mask.hpp"
 #include "kalshi/http_client.hpp"
 #include "kalshi/models/market.hpp"
 #include "kalshi/models/order.hpp"
 #include "kalshi/pagination.hpp"
+#include "kalshi/rate_limit.hpp"
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace kalshi {
 
+class MetadataCache;
+class RiskGate;
+
 // Forward declarations for API response types
 
 /// Event containing multiple markets
@@ -44,32 +54,6 @@ struct ExchangeStatus {
 	bool exchange_active{false};
 };
 
-/// Token-bucket budget for one Kalshi API rate-limit bucket.
-struct AccountRateLimitBucket {
-	std::int64_t refill_rate{0};
-	std::int64_t bucket_capacity{0};
-};
-
-/// Authenticated account API usage tier and read/write token budgets.
-struct AccountApiLimits {
-	std::string usage_tier;
-	AccountRateLimitBucket read;
-	AccountRateLimitBucket write;
-};
-
-/// Non-default token cost for one API endpoint.
-struct EndpointCost {
-	std::string method;
-	std::string path;
-	std::int64_t cost{0};
-};
-
-/// Account-level endpoint cost metadata.
-struct EndpointCosts {
-	std::int64_t default_cost{0};
-	std::vector<EndpointCost> endpoint_costs;
-};
-
 /// Account balance
 struct Balance {
 	std::int64_t balance{0};		   // cents
@@ -412,6 +396,12 @@ struct GetMarketsParams {
 	std::optional<std::string> series_ticker;
 	std::optional<std::string> status;	// "open", "closed", "settled"
 	std::optional<std::string> tickers; // comma-separated
+	/// Only markets whose metadata changed after this unix time (status,
+	/// times, titles; not quotes). The exchange rejects it combined with
+	/// the other filters.
+	std::optional<std::int64_t> min_updated_ts;
+	/// Members to parse; the rest keep their defaults. Client-side only.
+	MarketFields fields{MarketFields::all()};
 };
 
 /// Parameters for listing events
@@ -524,6 +514,8 @@ struct GetOrdersParams {
 	std::optional<std::string> cursor;
 	std::optional<std::string> market_ticker;
 	std::optional<std::string> status; // "open", "pending", etc.
+	/// Members to parse; the rest keep their defaults. Client-side only.
+	OrderFields fields{OrderFields::all()};
 };
 
 /// Parameters for listing fills
@@ -552,6 +544,8 @@ struct GetTradesParams {
 	std::optional<std::string> market_ticker;
 	std::optional<std::int64_t> min_ts;
 	std::optional<std::int64_t> max_ts;
+	/// Members to parse; the rest keep their defaults. Client-side only.
+	TradeFields fields{TradeFields::all()};
 };
 
 /// Parameters for market candlesticks
@@ -573,11 +567,12 @@ struct CreateOrderParams {
 	Action action{Action::Buy};
 	std::string type{"limit"}; // "limit" or "market"
 	std::int32_t count{0};
-	std::optional<std::string> count_fp;
+	std::optional<Quantity> count_fp;
 	std::optional<std::int32_t> yes_price;
 	std::optional<std::int32_t> no_price;
-	std::optional<std::string> yes_price_dollars;
-	std::optional<std::string> no_price_dollars;
+	/// Sub-cent limit prices; sent as ``"D.DDDD"`` strings
+	std::optional<Price> yes_price_dollars;
+	std::optional<Price> no_price_dollars;
 	std::optional<std::string> client_order_id;
 	std::optional<std::int64_t> expiration_ts;
 	std::optional<std::string> time_in_force;
@@ -666,10 +661,62 @@ struct BatchResponse {
 	std::vector<std::string> errors;
 };
 
+/// Completion handler for ``KalshiClient`` ``*_async`` methods. Runs on
+/// the ``HttpClient`` event-loop thread; keep it short and non-blocking.
+template <typename T> using AsyncCallback = std::function<void(Result<T>)>;
+
+/// Receives each market as ``KalshiClient::for_each_market`` decodes it.
+/// Return false to stop the scan.
+using MarketSink = std::function<bool(const Market&)>;
+
+/// Receives each trade as ``KalshiClient::for_each_trade`` decodes it.
+/// Return false to stop the scan.
+using TradeSink = std::function<bool(const PublicTrade&)>;
+
+/// Receives each order as ``KalshiClient::for_each_order`` decodes it.
+/// Return false to stop the scan.
+using OrderSink = std::function<bool(const Order&)>;
+
+/// Receives each fill as ``KalshiClient::for_each_fill`` decodes it.
+/// Return false to stop the scan.
+using FillSink = std::function<bool(const Fill&)>;
+
+/// Most tickers ``GET /markets/orderbooks`` accepts per request
+inline constexpr std::size_t kMaxOrderbookTickers = 100;
+
+/// Receives each book from ``KalshiClient::refresh_orderbooks``. Return
+/// false to stop the refresh.
+using OrderBookSink = std::function<bool(const OrderBook&)>;
+
+/// Chunking and concurrency for ``KalshiClient::refresh_orderbooks``
+struct OrderbookRefreshOptions {
+	/// Tickers per request, capped at ``kMaxOrderbookTickers``
+	std::size_t chunk_size{kMaxOrderbookTickers};
+	/// Requests in flight at once (at least 1). Each is still charged
+	/// against the HTTP client's rate limiter, if one is installed.
+	std::size_t max_in_flight{4};
+};
+
+/// Outcome of ``KalshiClient::refresh_orderbooks``
+struct OrderbookRefreshStats {
+	std::size_t requests{0};				 ///< Chunks sent
+	std::size_t books{0};					 ///< Books handed to the sink
+	std::vector<std::string> failed_tickers; ///< Tickers whose chunk failed; retry these
+	std::vector<std::string> errors;		 ///< One message per failed chunk
+	bool stopped{false};					 ///< The sink returned false
+};
+
 /// Complete Kalshi REST API client
 ///
 /// Provides typed methods for all Kalshi v2 API endpoints.
 /// Uses the HttpClient for actual HTTP communication.
+///
+/// The latency-sensitive order-management and portfolio-refresh calls
+/// also have ``*_async`` variants. They are multiplexed over the
+/// HttpClient's single ``curl_multi`` event loop instead of blocking a
+/// caller thread per request, and resolve to the same ``Result<T>`` as
+/// the synchronous method, either through an ``AsyncCallback`` or a
+/// ``std::future``. Arguments are serialized before the call returns.
 class KalshiClient {
 public:
 	/// Create a client with the given HTTP client
@@ -683,6 +730,75 @@ public:
 	KalshiClient(const KalshiClient&) = delete;
 	KalshiClient& operator=(const KalshiClient&) = delete;
 
+	/// Attach a ticker interning table (typically
+	/// ``WebSocketClient::ticker_table()``). Markets returned afterwards
+	/// carry ``Market::ticker_id`` from it; null detaches.
+	void set_ticker_table(std::shared_ptr<TickerTable> table);
+
+	/// Currently attached ticker table (null when none)
+	[[nodiscard]] const std::shared_ptr<TickerTable>& ticker_table() const noexcept;
+
+	/// Attach a ``MetadataCache`` (``kalshi/metadata_cache.hpp``).
+	/// ``get_market`` / ``get_event`` / ``get_event_metadata`` /
+	/// ``get_series`` then answer from it while entries are fresh and
+	/// fill it on a miss; feed it ``MarketLifecycle`` messages with
+	/// ``MetadataCache::apply``. May be shared between clients; null
+	/// detaches.
+	void set_metadata_cache(std::shared_ptr<MetadataCache> cache);
+
+	/// Currently attached metadata cache (null when none)
+	[[nodiscard]] const std::shared_ptr<MetadataCache>& metadata_cache() const noexcept;
+
+	/// Attach a ``RiskGate`` (``kalshi/risk_gate.hpp``). ``create_order``
+	/// / ``batch_create_orders`` and their async forms then check every
+	/// order before rendering or signing it: a rejection fails the call
+	/// with ``ErrorCode::RiskRejected`` (an async callback runs on the
+	/// calling thread), and a clip sends the reduced count. A batch with
+	/// any rejected order is not sent. Null detaches.
+	void set_risk_gate(std::shared_ptr<RiskGate> gate);
+
+	/// Currently attached risk gate (null when none)
+	[[nodiscard]] const std::shared_ptr<RiskGate>& risk_gate() const noexcept;
+
+	/// Fetch ``get_account_api_limits`` and ``get_endpoint_costs`` and
+	/// install an ``EndpointRateLimiter`` built from them on the HTTP
+	/// client, replacing the Basic-tier default from
+	/// ``ClientConfig::rate_limits``. Every later request (sync or async)
+	/// is charged its endpoint cost against the read or write bucket.
+	/// Requests that cannot get their tokens within ``max_wait`` fail
+	/// with ``ErrorCode::RateLimited``; unset waits as long as needed.
+	[[nodiscard]] Result<void>
+	enable_rate_limits(std::optional<std::chrono::milliseconds> max_wait = std::nullopt);
+
+	/// Pre-sign ``create_order`` (``POST /portfolio/orders``). It and
+	/// ``create_order_async`` then send through a ``PreparedRequest``
+	/// (``kalshi/http_client.hpp``): the handle is configured and
+	/// signatures with their header lists are built ahead of time, so only
+	/// the body is filled in per order. Keep signatures topped up with
+	/// ``refill_prepared`` from a timer or other off-path thread.
+	[[nodiscard]] Result<void> prepare_create_order(PreparedRequestConfig config = {});
+
+	/// Pre-sign ``amend_order`` for one order; the path carries the order
+	/// id, so prepare once the id is known. Stays prepared until
+	/// ``release_prepared``.
+	[[nodiscard]] Result<void> prepare_amend_order(const std::string& order_id,
+												   PreparedRequestConfig config = {});
+
+	/// Pre-sign ``cancel_order_v2`` for ``params``. Released automatically
+	/// once a cancel through it succeeds.
+	[[nodiscard]] Result<void> prepare_cancel_order_v2(const CancelOrderV2Params& params,
+													   PreparedRequestConfig config = {});
+
+	/// ``PreparedRequest::refill`` on every prepared endpoint; returns the
+	/// first failure after trying them all
+	[[nodiscard]] Result<void> refill_prepared();
+
+	/// Drop the prepared amend / cancel requests of ``order_id``
+	void release_prepared(std::string_view order_id);
+
+	/// Prepared endpoints currently held
+	[[nodiscard]] std::size_t prepared_endpoints() const;
+
 	// ===== Exchange API =====
 
 	/// Get exchange status
@@ -710,19 +826,58 @@ public:
 	/// Get a single market by ticker
 	[[nodiscard]] Result<Market> get_market(const std::string& ticker);
 
+	/// ``get_market`` returning the cached object itself: a fresh hit
+	/// performs no allocation. Without a cache, wraps a fetch.
+	[[nodiscard]] Result<std::shared_ptr<const Market>>
+	get_market_shared(const std::string& ticker);
+
 	/// List markets with optional filters
 	[[nodiscard]] Result<PaginatedResponse<Market>>
 	get_markets(const GetMarketsParams& params = {});
 
+	/// Async ``get_markets``
+	void get_markets_async(const GetMarketsParams& params,
+						   AsyncCallback<PaginatedResponse<Market>> callback);
+	[[nodiscard]] std::future<Result<PaginatedResponse<Market>>>
+	get_markets_async(const GetMarketsParams& params = {});
+
+	/// Scan every market matching ``params`` without materializing a
+	/// ``std::vector<Market>``. Each page is parsed incrementally straight
+	/// from the libcurl write buffer, and every market is handed to
+	/// ``sink`` as soon as its object closes, so memory stays at about one
+	/// market. Pages are followed by cursor until exhausted or ``sink``
+	/// returns false. Returns the number of markets delivered.
+	[[nodiscard]] Result<std::size_t> for_each_market(const GetMarketsParams& params,
+													  const MarketSink& sink);
+
+	/// Pipelined page source for ``PaginatedIterator<Market>``: each page
+	/// is requested through ``HttpClient::request_async`` as soon as the
+	/// previous page's cursor is scanned, so ``fetch_all`` overlaps the
+	/// round trip with parsing. ``params.limit`` / ``params.cursor`` are
+	/// overridden per page. The client must outlive the iterator.
+	[[nodiscard]] PipelinedFetch<Market> markets_pipeline(GetMarketsParams params = {});
+
 	/// Get market orderbook
 	[[nodiscard]] Result<OrderBook>
 	get_market_orderbook(const std::string& ticker,
 						 std::optional<std::int32_t> depth = std::nullopt);
 
-	/// Get orderbooks for up to 100 markets in one request
+	/// Get orderbooks for up to 100 markets in one request. Each book is
+	/// parsed as soon as its object has downloaded.
 	[[nodiscard]] Result<std::vector<OrderBook>>
 	get_market_orderbooks(const std::vector<std::string>& tickers);
 
+	/// Fetch books for any number of markets. ``tickers`` is split into
+	/// ``get_market_orderbooks``-sized chunks, up to
+	/// ``options.max_in_flight`` chunks are on the wire at once, and each
+	/// response is parsed as soon as it lands. Books go to ``sink`` one at
+	/// a time on the calling thread, so the sink may feed a
+	/// single-threaded book engine directly. A failed chunk does not stop
+	/// the others; its tickers are listed in the stats.
+	[[nodiscard]] Result<OrderbookRefreshStats>
+	refresh_orderbooks(const std::vector<std::string>& tickers, const OrderBookSink& sink,
+					   OrderbookRefreshOptions options = {});
+
 	/// Get market candlesticks (price history)
 	[[nodiscard]] Result<std::vector<Candlestick>>
 	get_market_candlesticks(const GetCandlesticksParams& params);
@@ -731,22 +886,39 @@ public:
 	[[nodiscard]] Result<PaginatedResponse<PublicTrade>>
 	get_trades(const GetTradesParams& params = {});
 
+	/// ``for_each_market`` for ``get_trades``: every page, parsed as it
+	/// downloads. Returns the number of trades delivered.
+	[[nodiscard]] Result<std::size_t> for_each_trade(const GetTradesParams& params,
+													 const TradeSink& sink);
+
 	// ===== Events API =====
 
 	/// Get a single event by ticker
 	[[nodiscard]] Result<Event> get_event(const std::string& event_ticker);
 
+	/// ``get_event`` returning the cached object (see ``get_market_shared``)
+	[[nodiscard]] Result<std::shared_ptr<const Event>>
+	get_event_shared(const std::string& event_ticker);
+
 	/// List events with optional filters
 	[[nodiscard]] Result<PaginatedResponse<Event>> get_events(const GetEventsParams& params = {});
 
 	/// Get event metadata
 	[[nodiscard]] Result<EventMetadata> get_event_metadata(const std::string& event_ticker);
 
+	/// ``get_event_metadata`` returning the cached object
+	[[nodiscard]] Result<std::shared_ptr<const EventMetadata>>
+	get_event_metadata_shared(const std::string& event_ticker);
+
 	// ===== Series API =====
 
 	/// Get a single series by ticker
 	[[nodiscard]] Result<Series> get_series(const std::string& series_ticker);
 
+	/// ``get_series`` returning the cached object
+	[[nodiscard]] Result<std::shared_ptr<const Series>>
+	get_series_shared(const std::string& series_ticker);
+
 	/// List all series
 	[[nodiscard]] Result<PaginatedResponse<Series>>
 	get_series_list(const GetSeriesParams& params = {});
@@ -763,12 +935,34 @@ public:
 	/// Get user orders
 	[[nodiscard]] Result<PaginatedResponse<Order>> get_orders(const GetOrdersParams& params = {});
 
+	/// ``for_each_market`` for ``get_orders``. Returns the number of orders
+	/// delivered.
+	[[nodiscard]] Result<std::size_t> for_each_order(const GetOrdersParams& params,
+													 const OrderSink& sink);
+
 	/// Get a single order by ID
 	[[nodiscard]] Result<Order> get_order(const std::string& order_id);
 
+	/// Async ``get_positions``
+	void get_positions_async(const GetPositionsParams& params,
+							 AsyncCallback<PaginatedResponse<Position>> callback);
+	[[nodiscard]] std::future<Result<PaginatedResponse<Position>>>
+	get_positions_async(const GetPositionsParams& params = {});
+
+	/// Async ``get_orders``
+	void get_orders_async(const GetOrdersParams& params,
+						  AsyncCallback<PaginatedResponse<Order>> callback);
+	[[nodiscard]] std::future<Result<PaginatedResponse<Order>>>
+	get_orders_async(const GetOrdersParams& params = {});
+
 	/// Get user fills (trade executions)
 	[[nodiscard]] Result<PaginatedResponse<Fill>> get_fills(const GetFillsParams& params = {});
 
+	/// ``for_each_market`` for ``get_fills``. Returns the number of fills
+	/// delivered.
+	[[nodiscard]] Result<std::size_t> for_each_fill(const GetFillsParams& params,
+													const FillSink& sink);
+
 	/// Get user settlements
 	[[nodiscard]] Result<PaginatedResponse<Settlement>>
 	get_settlements(const GetPositionsParams& params = {});
@@ -829,7 +1023,9 @@ public:
 	/// Decrease order count
 	[[nodiscard]] Result<Order> decrease_order(const DecreaseOrderParams& params);
 
-	/// Create multiple orders in a batch
+	/// Create multiple orders in a batch. ``results`` keeps request order;
+	/// a rejected order leaves an entry with an empty ``order_id`` and its
+	/// message in ``errors``.
 	[[nodiscard]] Result<BatchResponse<Order>>
 	batch_create_orders(const BatchOrderRequest& request);
 
@@ -841,6 +1037,45 @@ public:
 	[[nodiscard]] Result<BatchResponse<OrderCancelResult>>
 	batch_cancel_orders_v2(const BatchCancelRequest& request);
 
+	/// Render the ``create_order`` / ``batch_create_orders`` JSON body into
+	/// ``out``, replacing its contents but keeping its capacity. The
+	/// blocking submit calls render into a per-thread buffer this way and
+	/// hand it to ``HttpClient`` as a view, so a steady requote loop does
+	/// no allocation for the body. Use these to pre-render or to drive
+	/// your own ``HttpClient``.
+	static void render_create_order(const CreateOrderParams& params, std::string& out);
+	static void render_batch_create(const BatchOrderRequest& request, std::string& out);
+
+	/// Async ``create_order``
+	void create_order_async(const CreateOrderParams& params, AsyncCallback<Order> callback);
+	[[nodiscard]] std::future<Result<Order>> create_order_async(const CreateOrderParams& params);
+
+	/// Async ``cancel_order``
+	void cancel_order_async(const std::string& order_id, AsyncCallback<void> callback);
+	[[nodiscard]] std::future<Result<void>> cancel_order_async(const std::string& order_id);
+
+	/// Async ``amend_order``
+	void amend_order_async(const AmendOrderParams& params, AsyncCallback<Order> callback);
+	[[nodiscard]] std::future<Result<Order>> amend_order_async(const AmendOrderParams& params);
+
+	/// Async ``batch_create_orders``
+	void batch_create_orders_async(const BatchOrderRequest& request,
+								   AsyncCallback<BatchResponse<Order>> callback);
+	[[nodiscard]] std::future<Result<BatchResponse<Order>>>
+	batch_create_orders_async(const BatchOrderRequest& request);
+
+	/// Async ``batch_cancel_orders``
+	void batch_cancel_orders_async(const BatchCancelRequest& request,
+								   AsyncCallback<BatchResponse<std::string>> callback);
+	[[nodiscard]] std::future<Result<BatchResponse<std::string>>>
+	batch_cancel_orders_async(const BatchCancelRequest& request);
+
+	/// Async ``batch_cancel_orders_v2``
+	void batch_cancel_orders_v2_async(const BatchCancelRequest& request,
+									  AsyncCallback<BatchResponse<OrderCancelResult>> callback);
+	[[nodiscard]] std::future<Result<BatchResponse<OrderCancelResult>>>
+	batch_cancel_orders_v2_async(const BatchCancelRequest& request);
+
 	// ===== Order Groups (Authenticated) =====
 
 	/// Create an order group
@@ -982,16 +1217,44 @@ private:
 	struct Impl;
 	std::unique_ptr<Impl> impl_;
 
+	// Network paths behind the cache-aware metadata getters
+	[[nodiscard]] Result<Market> fetch_market(const std::string& ticker);
+	[[nodiscard]] Result<Event> fetch_event(const std::string& event_ticker);
+	[[nodiscard]] Result<EventMetadata> fetch_event_metadata(const std::string& event_ticker);
+	[[nodiscard]] Result<Series> fetch_series(const std::string& series_ticker);
+
 	// JSON parsing helpers
-	[[nodiscard]] Result<Market> parse_market(const std::string& json);
-	[[nodiscard]] Result<std::vector<Market>> parse_markets(const std::string& json);
-	[[nodiscard]] Result<Order> parse_order(const std::string& json);
-	[[nodiscard]] Result<std::vector<Order>> parse_orders(const std::string& json);
+	[[nodiscard]] static Result<Market> parse_market(const std::string& json);
+	[[nodiscard]] static Result<std::vector<Market>>
+	parse_markets(const std::string& json, MarketFields fields = MarketFields::all());
+	[[nodiscard]] static Result<Order> parse_order(const std::string& json,
+												   OrderFields fields = OrderFields::all());
+	[[nodiscard]] static Result<std::vector<Order>>
+	parse_orders(const std::string& json, OrderFields fields = OrderFields::all());
 	[[nodiscard]] Result<OrderBook> parse_orderbook(const std::string& json);
 	[[nodiscard]] Result<std::vector<OrderBook>> parse_orderbooks(const std::string& json);
 
+	// Response handlers shared by the sync and ``*_async`` variants.
+	// Static so async completions never touch a (possibly moved) client.
+	[[nodiscard]] static Result<PaginatedResponse<Market>>
+	handle_markets(Result<HttpResponse> response, const std::shared_ptr<TickerTable>& tickers,
+				   MarketFields fields);
+	[[nodiscard]] static Result<PaginatedResponse<Position>>
+	handle_positions(Result<HttpResponse> response);
+	[[nodiscard]] static Result<PaginatedResponse<Order>>
+	handle_orders(Result<HttpResponse> response, OrderFields fields);
+	[[nodiscard]] static Result<Order> handle_create_order(Result<HttpResponse> response);
+	[[nodiscard]] static Result<void> handle_cancel_order(Result<HttpResponse> response);
+	[[nodiscard]] static Result<Order> handle_amend_order(Result<HttpResponse> response);
+	[[nodiscard]] static Result<BatchResponse<Order>>
+	handle_batch_create(Result<HttpResponse> response);
+	[[nodiscard]] static Result<BatchResponse<std::string>>
+	handle_batch_cancel(Result<HttpResponse> response, std::vector<std::string> requested_ids);
+	[[nodiscard]] static Result<BatchResponse<OrderCancelResult>>
+	handle_batch_cancel_v2(Result<HttpResponse> response);
+
 	// Query string builders
-	[[nodiscard]] std::string build_markets_query(const GetMarketsParams& params);
+	[[nodiscard]] static std::string build_markets_query(const GetMarketsParams& params);
 	[[nodiscard]] std::string build_events_query(const GetEventsParams& params);
 	[[nodiscard]] std::string build_orders_query(const GetOrdersParams& params);
 	[[nodiscard]] std::string build_fills_query(const GetFillsParams& params);
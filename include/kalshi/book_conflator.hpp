@@ -0,0 +1,113 @@
+#pragma once
+
+/// @file book_conflator.hpp
+/// @brief Latest-value top-of-book delivery for consumers slower than the feed.
+
+#include "kalshi/models/market.hpp"
+#include "kalshi/orderbook_book.hpp"
+#include "kalshi/ticker_table.hpp"
+#include "kalshi/websocket.hpp"
+#include "kalshi/ws_event.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace kalshi {
+
+/// Conflator configuration
+struct BookConflatorConfig {
+	/// Largest ``TickerId`` value + 1 with a book. Updates for markets past
+	/// it are counted in ``BookConflatorStats::ignored``.
+	std::size_t max_markets{8192};
+	/// Deliver changed markets to ``on_update`` this often, from the
+	/// conflator's own thread. 0 (default) starts no thread; pull with
+	/// ``drain`` instead.
+	std::chrono::milliseconds interval{0};
+};
+
+/// One market's state at delivery
+struct ConflatedUpdate {
+	TopOfBook top;
+	/// YES price and size of the latest trade (``quantity`` 0 before any)
+	OrderBookEntry last_trade{0, 0};
+	/// Book and trade updates folded into this delivery (at least 1)
+	std::uint64_t merged{0};
+};
+
+/// Counters since construction
+struct BookConflatorStats {
+	std::uint64_t updates{0};	///< Snapshots, deltas and trades applied
+	std::uint64_t delivered{0}; ///< ``ConflatedUpdate``s handed out
+	std::uint64_t ignored{0};	///< Updates for markets past ``max_markets``
+};
+
+/// Callback for one interval's changed markets. The span is valid only
+/// during the call.
+using ConflatedCallback = std::function<void(std::span<const ConflatedUpdate>)>;
+
+/// Keeps an ``OrderBookBook`` per market and hands slow consumers (dashboards,
+/// hedgers, risk monitors) at most one update per changed market per
+/// delivery, however many deltas arrived in between.
+///
+/// Feed it from ``on_message`` (and ``on_event`` in compact mode). Each
+/// update costs the feeding thread one book write, one seqlock publish and
+/// one bit in a dirty set, and never waits on a consumer, so a consumer
+/// that falls behind cannot build a backlog or stall the service thread:
+/// it just sees fewer, later states. Consumers take the changed markets
+/// with ``drain`` or receive them every ``interval`` through
+/// ``on_update``; either way the work per delivery is bounded by the
+/// number of markets, not the message rate.
+///
+/// Books are checked ``SeqCheck::Monotonic``; pass ``on_sequence_gap``
+/// reports to ``apply`` so the gapped subscription's books read invalid
+/// until their resync snapshots arrive. Feed from one thread at a time.
+class BookConflator {
+public:
+	explicit BookConflator(BookConflatorConfig config = {});
+	~BookConflator();
+
+	BookConflator(BookConflator&&) noexcept;
+	BookConflator& operator=(BookConflator&&) noexcept;
+
+	BookConflator(const BookConflator&) = delete;
+	BookConflator& operator=(const BookConflator&) = delete;
+
+	// ===== Feeding side =====
+
+	/// Fold in a snapshot, delta or trade; other messages are ignored
+	void apply(const WsMessage& message);
+	/// Fold in a compact delta or trade; fills are ignored
+	void apply(const WsEvent& event);
+	/// Invalidate every book last snapshotted on ``gap.sid``
+	void apply(const WsSeqGap& gap);
+
+	// ===== Consuming side =====
+
+	/// Move up to ``out.size()`` changed markets into ``out``, clearing
+	/// their dirty bits; the rest stay pending for the next call.
+	/// Never waits on the feeding thread; safe from any thread.
+	[[nodiscard]] std::size_t drain(std::span<ConflatedUpdate> out);
+
+	/// Receive the changed markets every ``interval`` on the conflator's
+	/// thread (no calls while nothing changed). Must not block for long
+	/// or call ``on_update``; a slow callback only delays the next
+	/// delivery.
+	void on_update(ConflatedCallback callback);
+
+	/// Latest state of one market, dirty or not; nullopt before its first
+	/// update or past ``max_markets``
+	[[nodiscard]] std::optional<ConflatedUpdate> latest(TickerId id) const;
+
+	[[nodiscard]] BookConflatorStats stats() const noexcept;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
@@ -0,0 +1,196 @@
+/// @file json_scan.hpp
+/// @brief Vectorized byte scanning for the hand-rolled JSON readers.
+///
+/// The REST splitters and the ``extract_*`` helpers spend their time
+/// walking past bytes that cannot matter (digits, letters, whitespace) to
+/// reach the next quote, brace or bracket. ``find_any`` classifies 32
+/// bytes per step with AVX2, or 16 with NEON, and stops at the first byte
+/// from a compile-time set. The backend is picked once at runtime: AVX2
+/// when the CPU has it (the code is built with ``target("avx2")``
+/// regardless of ``-march``), NEON on AArch64, else a scalar loop.
+///
+/// ``parse_dollars_canonical`` is the SWAR fast path behind
+/// ``parse_dollar_cents`` for Kalshi's fixed ``"D.DDDD"`` price strings:
+/// all four fraction digits are validated and decoded from one 32-bit load.
+///
+/// Internal (``detail``) — not part of the public API.
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define KALSHI_JSON_SCAN_AVX2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define KALSHI_JSON_SCAN_NEON 1
+#endif
+
+namespace kalshi::detail {
+
+/// Scanner implementation in use.
+enum class ScanBackend : std::uint8_t { Scalar, Avx2, Neon };
+
+/// First index at or after ``from`` holding one of ``Cs``, or ``npos``.
+/// One byte at a time; the reference the vector paths must match.
+template <char... Cs>
+[[nodiscard]] inline std::size_t find_any_scalar(std::string_view s, std::size_t from) noexcept {
+	for (std::size_t i = from; i < s.size(); ++i) {
+		const char c = s[i];
+		if (((c == Cs) || ...)) {
+			return i;
+		}
+	}
+	return std::string_view::npos;
+}
+
+#if defined(KALSHI_JSON_SCAN_AVX2)
+template <char... Cs>
+__attribute__((target("avx2"))) [[nodiscard]] inline std::size_t
+find_any_avx2(std::string_view s, std::size_t from) noexcept {
+	std::size_t i = from;
+	for (; i + 32 <= s.size(); i += 32) {
+		const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.data() + i));
+		const __m256i hits =
+			(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(Cs)) | ...);
+		const std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+		if (mask != 0) {
+			return i + static_cast<std::size_t>(std::countr_zero(mask));
+		}
+	}
+	return find_any_scalar<Cs...>(s, i);
+}
+#endif
+
+#if defined(KALSHI_JSON_SCAN_NEON)
+template <char... Cs>
+[[nodiscard]] inline std::size_t find_any_neon(std::string_view s, std::size_t from) noexcept {
+	std::size_t i = from;
+	for (; i + 16 <= s.size(); i += 16) {
+		const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const std::uint8_t*>(s.data() + i));
+		const uint8x16_t hits =
+			(vceqq_u8(chunk, vdupq_n_u8(static_cast<std::uint8_t>(Cs))) | ...);
+		// Narrow each byte lane to a nibble: 16 lanes -> one 64-bit mask.
+		const std::uint64_t mask = vget_lane_u64(
+			vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+		if (mask != 0) {
+			return i + static_cast<std::size_t>(std::countr_zero(mask) >> 2);
+		}
+	}
+	return find_any_scalar<Cs...>(s, i);
+}
+#endif
+
+[[nodiscard]] inline ScanBackend detect_scan_backend() noexcept {
+#if defined(KALSHI_JSON_SCAN_AVX2)
+	return __builtin_cpu_supports("avx2") ? ScanBackend::Avx2 : ScanBackend::Scalar;
+#elif defined(KALSHI_JSON_SCAN_NEON)
+	return ScanBackend::Neon;
+#else
+	return ScanBackend::Scalar;
+#endif
+}
+
+/// Backend chosen for this process (detected on first use).
+[[nodiscard]] inline ScanBackend scan_backend() noexcept {
+	static const ScanBackend backend = detect_scan_backend();
+	return backend;
+}
+
+/// First index at or after ``from`` holding one of ``Cs``, or ``npos``.
+template <char... Cs>
+[[nodiscard]] inline std::size_t find_any(std::string_view s, std::size_t from) noexcept {
+	static_assert(sizeof...(Cs) > 0 && sizeof...(Cs) <= 8, "find_any takes 1-8 bytes");
+	if (from >= s.size()) {
+		return std::string_view::npos;
+	}
+#if defined(KALSHI_JSON_SCAN_AVX2)
+	if (scan_backend() == ScanBackend::Avx2) {
+		return find_any_avx2<Cs...>(s, from);
+	}
+#elif defined(KALSHI_JSON_SCAN_NEON)
+	return find_any_neon<Cs...>(s, from);
+#endif
+	return find_any_scalar<Cs...>(s, from);
+}
+
+/// Index one past the quote that closes the string whose body starts at
+/// ``from`` (just after its opening quote), honouring backslash escapes;
+/// ``npos`` when unterminated.
+[[nodiscard]] inline std::size_t skip_json_string(std::string_view s, std::size_t from) noexcept {
+	std::size_t pos = from;
+	for (;;) {
+		pos = find_any<'"', '\\'>(s, pos);
+		if (pos == std::string_view::npos) {
+			return pos;
+		}
+		if (s[pos] == '"') {
+			return pos + 1;
+		}
+		pos += 2; // Skip the escaped byte.
+	}
+}
+
+/// Index one past the bracket that closes ``s[open]`` (``{`` or ``[``).
+/// Brackets inside strings are ignored; ``npos`` when ``s[open]`` is not
+/// an opening bracket or it is never closed.
+[[nodiscard]] inline std::size_t find_matching_close(std::string_view s,
+													 std::size_t open) noexcept {
+	if (open >= s.size() || (s[open] != '{' && s[open] != '[')) {
+		return std::string_view::npos;
+	}
+	const bool object = s[open] == '{';
+	std::int32_t depth = 1;
+	std::size_t pos = open + 1;
+	while (depth > 0) {
+		pos = object ? find_any<'"', '{', '}'>(s, pos) : find_any<'"', '[', ']'>(s, pos);
+		if (pos == std::string_view::npos) {
+			return pos;
+		}
+		const char c = s[pos];
+		if (c == '"') {
+			pos = skip_json_string(s, pos + 1);
+			if (pos == std::string_view::npos) {
+				return pos;
+			}
+			continue;
+		}
+		depth += (c == '{' || c == '[') ? 1 : -1;
+		++pos;
+	}
+	return pos;
+}
+
+/// SWAR decode of a canonical ``D.DDDD`` dollar string into cents, rounding
+/// half-up on the third fraction digit exactly like ``parse_dollar_cents``.
+/// Returns false (leaving ``cents`` alone) for any other shape so the
+/// caller can fall back to the general parser.
+[[nodiscard]] inline bool parse_dollars_canonical(std::string_view s,
+												  std::int32_t& cents) noexcept {
+	if constexpr (std::endian::native != std::endian::little) {
+		return false;
+	} else {
+		if (s.size() != 6 || s[1] != '.' || s[0] < '0' || s[0] > '9') {
+			return false;
+		}
+		std::uint32_t word = 0;
+		std::memcpy(&word, s.data() + 2, sizeof(word));
+		// Every byte in '0'..'9': high nibble 3, and adding 6 keeps it 3.
+		if ((word & 0xF0F0F0F0U) != 0x30303030U ||
+			((word + 0x06060606U) & 0xF0F0F0F0U) != 0x30303030U) {
+			return false;
+		}
+		const std::uint32_t digits = word - 0x30303030U;
+		const std::int32_t tenths = static_cast<std::int32_t>(digits & 0xFFU);
+		const std::int32_t hundredths = static_cast<std::int32_t>((digits >> 8) & 0xFFU);
+		const std::int32_t round_up = ((digits >> 16) & 0xFFU) >= 5 ? 1 : 0;
+		cents = (s[0] - '0') * 100 + tenths * 10 + hundredths + round_up;
+		return true;
+	}
+}
+
+} // namespace kalshi::detail
@@ -0,0 +1,84 @@
+/// @file mpsc_queue.hpp
+/// @brief Unbounded lock-free multi-producer / single-consumer queue.
+///
+/// Used to hand outgoing WebSocket commands from any number of caller
+/// threads to the libwebsockets service thread. Any thread may call
+/// ``push``; exactly one thread may call ``pop``.
+///
+/// Vyukov's intrusive node queue. Nodes are owned by the caller and carry
+/// their own ``std::atomic<Node*> next`` link, so a push is one exchange
+/// and one store with no allocation. ``push`` is wait-free; ``pop`` may
+/// briefly return null while a producer sits between its exchange and its
+/// link store, in which case the item shows up on the next call.
+#pragma once
+
+#include "kalshi/detail/spsc_ring.hpp"
+
+#include <atomic>
+
+namespace kalshi::detail {
+
+/// ``Node`` must be default-constructible (one is kept as the stub) and
+/// expose a public ``std::atomic<Node*> next`` member.
+template <typename Node> class MpscQueue {
+public:
+	MpscQueue() noexcept : head_(&stub_), tail_(&stub_) {}
+
+	MpscQueue(const MpscQueue&) = delete;
+	MpscQueue& operator=(const MpscQueue&) = delete;
+
+	/// Producer side (any thread). The queue does not take ownership;
+	/// ``node`` must stay alive until it is popped.
+	void push(Node* node) noexcept {
+		node->next.store(nullptr, std::memory_order_relaxed);
+		Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+		prev->next.store(node, std::memory_order_release);
+	}
+
+	/// Consumer side. Oldest node, or null when empty (or when a push is
+	/// still being linked in).
+	[[nodiscard]] Node* pop() noexcept {
+		Node* tail = tail_;
+		Node* next = tail->next.load(std::memory_order_acquire);
+		if (tail == &stub_) {
+			if (next == nullptr) {
+				return nullptr;
+			}
+			tail_ = next;
+			tail = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+		if (next != nullptr) {
+			tail_ = next;
+			return tail;
+		}
+		if (tail != head_.load(std::memory_order_acquire)) {
+			return nullptr;
+		}
+		// `tail` is the last node: re-insert the stub behind it so it can
+		// be handed out without leaving the queue headless.
+		push(&stub_);
+		next = tail->next.load(std::memory_order_acquire);
+		if (next != nullptr) {
+			tail_ = next;
+			return tail;
+		}
+		return nullptr;
+	}
+
+	/// Consumer side. True when nothing is waiting; a push that is still
+	/// being linked in may not be counted yet.
+	[[nodiscard]] bool empty() const noexcept {
+		return tail_ == &stub_ && stub_.next.load(std::memory_order_acquire) == nullptr;
+	}
+
+private:
+	// Producer-shared.
+	alignas(kCacheLineSize) std::atomic<Node*> head_;
+
+	// Consumer-owned.
+	alignas(kCacheLineSize) Node* tail_;
+	Node stub_{};
+};
+
+} // namespace kalshi::detail
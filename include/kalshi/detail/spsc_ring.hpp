@@ -0,0 +1,112 @@
+/// @file spsc_ring.hpp
+/// @brief Bounded lock-free single-producer / single-consumer ring.
+///
+/// Used to hand parsed messages from the libwebsockets service thread to
+/// a consumer without a mutex on either side. Exactly one thread may
+/// call the producer methods (``try_push``) and exactly one thread the
+/// consumer methods (``try_pop`` / ``pop_bulk``); ``size`` is safe from
+/// anywhere but only approximate while both sides are running.
+///
+/// Classic Lamport ring with cached opposite indices: each side keeps a
+/// private copy of the other side's index and only reloads the shared
+/// atomic when the cached value says the ring looks full / empty, so the
+/// steady state touches one shared cache line per operation.
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace kalshi::detail {
+
+/// Cache-line size used to keep producer and consumer indices apart.
+/// ``std::hardware_destructive_interference_size`` is deliberately not
+/// used: GCC warns that its value is ABI-unstable across ``-mtune``.
+inline constexpr std::size_t kCacheLineSize = 64;
+
+template <typename T> class SpscRing {
+public:
+	/// Create a ring holding at least ``min_capacity`` elements. The
+	/// capacity is rounded up to a power of two (minimum 2) so index
+	/// wrap is a mask rather than a modulo.
+	explicit SpscRing(std::size_t min_capacity)
+		: slots_(std::bit_ceil(min_capacity < 2 ? std::size_t{2} : min_capacity)),
+		  mask_(slots_.size() - 1) {}
+
+	SpscRing(const SpscRing&) = delete;
+	SpscRing& operator=(const SpscRing&) = delete;
+
+	/// Producer: move ``value`` into the ring. Returns false (and leaves
+	/// ``value`` untouched) when the ring is full.
+	[[nodiscard]] bool try_push(T&& value) {
+		const std::size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail - cached_head_ == slots_.size()) {
+			cached_head_ = head_.load(std::memory_order_acquire);
+			if (tail - cached_head_ == slots_.size()) {
+				return false;
+			}
+		}
+		slots_[tail & mask_] = std::move(value);
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Consumer: move the oldest element into ``out``. Returns false when
+	/// the ring is empty.
+	[[nodiscard]] bool try_pop(T& out) {
+		const std::size_t head = head_.load(std::memory_order_relaxed);
+		if (head == cached_tail_) {
+			cached_tail_ = tail_.load(std::memory_order_acquire);
+			if (head == cached_tail_) {
+				return false;
+			}
+		}
+		out = std::move(slots_[head & mask_]);
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Consumer: move up to ``out.size()`` elements into ``out`` in FIFO
+	/// order with a single index publish. Returns the number moved.
+	[[nodiscard]] std::size_t pop_bulk(std::span<T> out) {
+		const std::size_t head = head_.load(std::memory_order_relaxed);
+		cached_tail_ = tail_.load(std::memory_order_acquire);
+		std::size_t n = cached_tail_ - head;
+		if (n > out.size()) {
+			n = out.size();
+		}
+		for (std::size_t i = 0; i < n; ++i) {
+			out[i] = std::move(slots_[(head + i) & mask_]);
+		}
+		if (n > 0) {
+			head_.store(head + n, std::memory_order_release);
+		}
+		return n;
+	}
+
+	/// Approximate number of queued elements.
+	[[nodiscard]] std::size_t size() const noexcept {
+		const std::size_t head = head_.load(std::memory_order_acquire);
+		const std::size_t tail = tail_.load(std::memory_order_acquire);
+		return tail >= head ? tail - head : 0;
+	}
+
+	[[nodiscard]] std::size_t capacity() const noexcept { return slots_.size(); }
+
+private:
+	std::vector<T> slots_;
+	std::size_t mask_;
+
+	// Consumer-owned.
+	alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+	std::size_t cached_tail_{0};
+
+	// Producer-owned.
+	alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+	std::size_t cached_head_{0};
+};
+
+} // namespace kalshi::detail
@@ -2,62 +2,66 @@
 /// @brief Internal JSON helpers used by the WebSocket parser.
 ///
 /// The WebSocket message handler needs a very small, allocation-free
-/// JSON reader: only extract_int / extract_string / extract_orderbook_entries
-/// are used, and only from a handful of call sites. A full JSON library
-/// would pull in more dependencies and perform worse on hot-path messages.
+/// JSON reader. A full JSON library would pull in more dependencies and
+/// perform worse on hot-path messages.
+///
+/// Two layers live here. The ``parse_*`` functions convert a single value
+/// slice (the text between the quotes, or the bare scalar) and are what the
+/// single-pass frame decoder in ``src/ws/frame_decoder.cpp`` calls once per
+/// field. The ``extract_*`` functions are the older find-by-key scanners,
+/// kept as thin wrappers over the ``parse_*`` layer for ad-hoc lookups.
+///
+/// Byte scanning (the next quote, comma or bracket) goes through
+/// ``find_any`` in ``json_scan.hpp``, which uses AVX2/NEON when available.
 ///
 /// The helpers live here (rather than inline in websocket.cpp) so the
 /// unit tests can exercise them directly. They are in the ``detail``
 /// namespace and should not be considered part of the public API.
 #pragma once
 
+#include "kalshi/detail/json_scan.hpp"
+
+#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 namespace kalshi::detail {
 
-/// Extract an integer value for ``key`` from ``json``.
+/// Parse an integer value slice into int64.
 ///
-/// Tolerates both raw JSON numbers (``"x":47``) and JSON-string numbers
-/// (``"x":"47"``). Kalshi's v2 WebSocket schema encodes trade / orderbook
-/// price and count fields as strings; earlier revisions of this parser
-/// treated the leading ``"`` as end-of-number and silently returned 0,
-/// zeroing out every production tick. Returns 0 when the key is absent
-/// or the value cannot be parsed.
-inline std::int32_t extract_int(const std::string& json, const std::string& key) {
-	const std::string search = "\"" + key + "\"";
-	std::size_t pos = json.find(search);
-	if (pos == std::string::npos)
-		return 0;
-	pos = json.find(':', pos);
-	if (pos == std::string::npos)
-		return 0;
-	pos++;
-	while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t'))
+/// Tolerates both raw JSON numbers (``47``) and JSON-string numbers
+/// (``"47"``, or the already-unquoted ``47``). Parsing stops at the
+/// first non-digit; an empty or non-numeric slice returns 0. The
+/// magnitude saturates instead of overflowing, so a malformed/hostile
+/// frame cannot trigger signed-overflow UB.
+inline std::int64_t parse_int64_value(std::string_view v) {
+	std::size_t pos = 0;
+	while (pos < v.size() && (v[pos] == ' ' || v[pos] == '\t'))
 		pos++;
-	const bool quoted = pos < json.size() && json[pos] == '"';
-	if (quoted)
+	if (pos < v.size() && v[pos] == '"')
 		pos++;
 	bool negative = false;
-	if (pos < json.size() && json[pos] == '-') {
+	if (pos < v.size() && v[pos] == '-') {
 		negative = true;
 		pos++;
 	}
-	// Accumulate in int64 and clamp, mirroring extract_dollar_cents: a bare
-	// int32 accumulator silently overflows (UB) on an out-of-range numeric
-	// field from a malformed/hostile WS frame. Saturate the magnitude so int64
-	// itself never overflows, then clamp to the int32 range.
+	constexpr std::int64_t kMaxMagnitude = INT64_MAX / 10 - 1;
 	std::int64_t val = 0;
-	while (pos < json.size() && json[pos] >= '0' && json[pos] <= '9') {
-		val = val * 10 + (json[pos] - '0');
-		if (val > 2147483648LL) { // |INT32_MIN| — largest magnitude we keep
-			val = 2147483648LL;
+	while (pos < v.size() && v[pos] >= '0' && v[pos] <= '9') {
+		if (val < kMaxMagnitude) {
+			val = val * 10 + (v[pos] - '0');
 		}
 		pos++;
 	}
-	const std::int64_t result = negative ? -val : val;
+	return negative ? -val : val;
+}
+
+/// Parse an integer value slice, clamped to the int32 range.
+inline std::int32_t parse_int_value(std::string_view v) {
+	const std::int64_t result = parse_int64_value(v);
 	if (result < INT32_MIN) {
 		return INT32_MIN;
 	}
@@ -67,6 +71,26 @@ inline std::int32_t extract_int(const std::string& json, const std::string& key)
 	return static_cast<std::int32_t>(result);
 }
 
+/// Extract an integer value for ``key`` from ``json``.
+///
+/// Tolerates both raw JSON numbers (``"x":47``) and JSON-string numbers
+/// (``"x":"47"``). Kalshi's v2 WebSocket schema encodes trade / orderbook
+/// price and count fields as strings; earlier revisions of this parser
+/// treated the leading ``"`` as end-of-number and silently returned 0,
+/// zeroing out every production tick. Returns 0 when the key is absent
+/// or the value cannot be parsed. Out-of-range values clamp to the int32
+/// bounds rather than wrapping.
+inline std::int32_t extract_int(const std::string& json, const std::string& key) {
+	const std::string search = "\"" + key + "\"";
+	std::size_t pos = json.find(search);
+	if (pos == std::string::npos)
+		return 0;
+	pos = find_any<':'>(json, pos);
+	if (pos == std::string::npos)
+		return 0;
+	return parse_int_value(std::string_view(json).substr(pos + 1));
+}
+
 /// Extract a string value for ``key`` from ``json``. Returns "" when
 /// the key is absent or the value is not a string.
 inline std::string extract_string(const std::string& json, const std::string& key) {
@@ -74,14 +98,14 @@ inline std::string extract_string(const std::string& json, const std::string& ke
 	std::size_t pos = json.find(search);
 	if (pos == std::string::npos)
 		return "";
-	pos = json.find(':', pos);
+	pos = find_any<':'>(json, pos);
 	if (pos == std::string::npos)
 		return "";
-	pos = json.find('"', pos);
+	pos = find_any<'"'>(json, pos);
 	if (pos == std::string::npos)
 		return "";
 	const std::size_t start = pos + 1;
-	const std::size_t end = json.find('"', start);
+	const std::size_t end = find_any<'"'>(json, start);
 	if (end == std::string::npos)
 		return "";
 	return json.substr(start, end - start);
@@ -99,11 +123,13 @@ inline std::string extract_string(const std::string& json, const std::string& ke
 /// it reads integer and fractional parts as decimal digits and sums
 /// ``integer * 100 + round(fractional_digits_1..2)``. Digits past
 /// the second fractional position round-half-up the cent. Out-of-range
-/// or malformed input returns 0.
-inline std::int32_t extract_dollar_cents(const std::string& json, const std::string& key) {
-	const std::string s = extract_string(json, key);
+/// or malformed input returns 0. The canonical ``D.DDDD`` shape takes the
+/// SWAR path in ``parse_dollars_canonical``.
+inline std::int32_t parse_dollar_cents(std::string_view s) {
 	if (s.empty())
 		return 0;
+	if (std::int32_t cents = 0; parse_dollars_canonical(s, cents))
+		return cents;
 
 	std::size_t i = 0;
 	bool negative = false;
@@ -143,14 +169,19 @@ inline std::int32_t extract_dollar_cents(const std::string& json, const std::str
 	return static_cast<std::int32_t>(signed_total);
 }
 
+/// Extract ``json[key]`` as a decimal-dollar string and convert it to
+/// integer cents via ``parse_dollar_cents``.
+inline std::int32_t extract_dollar_cents(const std::string& json, const std::string& key) {
+	return parse_dollar_cents(extract_string(json, key));
+}
+
 /// Parse a floating-point-count JSON-string value into a rounded integer.
 ///
 /// Kalshi's v2 schema delivers ``count_fp`` and orderbook ``delta_fp``
 /// as string-encoded floats (``"40.00"``, ``"-30.87"``). The SDK's
 /// public structs keep counts as ``std::int32_t`` — this rounds to
 /// the nearest integer and preserves sign. Malformed input → 0.
-inline std::int32_t extract_fp_int(const std::string& json, const std::string& key) {
-	const std::string s = extract_string(json, key);
+inline std::int32_t parse_fp_int(std::string_view s) {
 	if (s.empty())
 		return 0;
 
@@ -180,6 +211,12 @@ inline std::int32_t extract_fp_int(const std::string& json, const std::string& k
 	return static_cast<std::int32_t>(signed_total);
 }
 
+/// Extract ``json[key]`` as a floating-point-count string and round it
+/// via ``parse_fp_int``.
+inline std::int32_t extract_fp_int(const std::string& json, const std::string& key) {
+	return parse_fp_int(extract_string(json, key));
+}
+
 /// Parse an ISO-8601 timestamp string (``2026-04-20T08:19:13.898402Z``)
 /// into Unix milliseconds. Returns 0 on parse failure.
 ///
@@ -187,12 +224,11 @@ inline std::int32_t extract_fp_int(const std::string& json, const std::string& k
 /// Kalshi sends UTC timestamps with an optional fractional component
 /// and a trailing ``Z``. Accepts up to microsecond precision; truncates
 /// below millisecond.
-inline std::int64_t extract_iso8601_millis(const std::string& json, const std::string& key) {
-	const std::string s = extract_string(json, key);
+inline std::int64_t parse_iso8601_millis(std::string_view s) {
 	if (s.size() < 19) // min "YYYY-MM-DDTHH:MM:SS"
 		return 0;
 
-	auto read_uint = [](const std::string& str, std::size_t pos, int n) -> int {
+	auto read_uint = [](std::string_view str, std::size_t pos, int n) -> int {
 		int v = 0;
 		for (int i = 0; i < n && pos + i < str.size(); i++) {
 			char c = str[pos + i];
@@ -243,26 +279,30 @@ inline std::int64_t extract_iso8601_millis(const std::string& json, const std::s
 	return seconds * 1000 + millis;
 }
 
+/// Extract ``json[key]`` as an ISO-8601 string and convert it via
+/// ``parse_iso8601_millis``.
+inline std::int64_t extract_iso8601_millis(const std::string& json, const std::string& key) {
+	return parse_iso8601_millis(extract_string(json, key));
+}
+
 /// Result of a single orderbook-array entry.
 struct PriceQty {
 	std::int32_t price{0};
 	std::int32_t quantity{0};
 };
 
-/// Extract a list of ``[price, quantity]`` tuples from
-/// ``json[key]``. Supports both raw-number and JSON-string encodings
-/// for either slot, mirroring ``extract_int``'s quote tolerance.
-/// Returns an empty vector when the key is absent or malformed.
-inline std::vector<PriceQty> extract_orderbook_entries(const std::string& json,
-													   const std::string& key) {
-	std::vector<PriceQty> entries;
-	const std::string search = "\"" + key + "\"";
-	std::size_t pos = json.find(search);
-	if (pos == std::string::npos)
-		return entries;
-	pos = json.find('[', pos);
-	if (pos == std::string::npos)
-		return entries;
+/// Visit each ``[price, quantity]`` tuple of an orderbook array.
+///
+/// ``json`` is positioned at (or before) the outer ``[``; scanning stops
+/// at its closing ``]``. Supports both raw-number and JSON-string
+/// encodings for either slot, mirroring ``parse_int_value``'s quote
+/// tolerance. ``visit`` is called as ``visit(price, quantity)`` so
+/// callers can write straight into their own container without an
+/// intermediate vector.
+template <typename Visit> void for_each_orderbook_entry(std::string_view json, Visit&& visit) {
+	std::size_t pos = find_any<'['>(json, 0);
+	if (pos == std::string_view::npos)
+		return;
 	pos++; // Skip outer '['
 
 	auto read_num = [&]() -> std::int32_t {
@@ -296,21 +336,35 @@ inline std::vector<PriceQty> extract_orderbook_entries(const std::string& json,
 		if (json[pos] == '[') {
 			pos++;
 			const std::int32_t price = read_num();
-			while (pos < json.size() && json[pos] != ',' && json[pos] != ']')
-				pos++;
+			pos = std::min(find_any<',', ']'>(json, pos), json.size());
 			if (pos < json.size() && json[pos] == ',')
 				pos++;
 			const std::int32_t qty = read_num();
-			while (pos < json.size() && json[pos] != ']')
-				pos++;
+			pos = std::min(find_any<']'>(json, pos), json.size());
 			if (pos < json.size())
 				pos++; // Skip ']'
-			entries.push_back(PriceQty{price, qty});
+			visit(price, qty);
 		}
 
 		while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == ','))
 			pos++;
 	}
+}
+
+/// Extract a list of ``[price, quantity]`` tuples from
+/// ``json[key]``. Returns an empty vector when the key is absent or
+/// malformed.
+inline std::vector<PriceQty> extract_orderbook_entries(const std::string& json,
+													   const std::string& key) {
+	std::vector<PriceQty> entries;
+	const std::string search = "\"" + key + "\"";
+	const std::size_t pos = json.find(search);
+	if (pos == std::string::npos)
+		return entries;
+	for_each_orderbook_entry(std::string_view(json).substr(pos),
+							 [&](std::int32_t price, std::int32_t qty) {
+								 entries.push_back(PriceQty{price, qty});
+							 });
 	return entries;
 }
 
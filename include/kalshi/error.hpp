@@ -18,6 +18,7 @@ enum class ErrorCode {
 	ParseError,
 	SigningError,
 	InvalidKey,
+	RiskRejected, ///< Refused by the attached ``RiskGate``; nothing was sent
 	Unknown
 };
 
@@ -0,0 +1,116 @@
+#pragma once
+
+/// @file field_mask.hpp
+/// @brief Projection masks for the REST response parsers.
+///
+/// A ``FieldMask<Field>`` names which members of a parsed model the
+/// caller will read. Parsers skip the scan (and any ISO-8601 / decimal
+/// conversion) for fields not in the mask, leaving them at their default
+/// value. Masks are plain ``constexpr`` bitsets, so a projection written
+/// as a ``constexpr`` constant costs nothing to build.
+///
+/// Masks are client-side only; Kalshi still returns every field.
+
+#include <cstdint>
+#include <initializer_list>
+
+namespace kalshi {
+
+template <typename Field>
+class FieldMask {
+public:
+	/// Empty mask
+	constexpr FieldMask() noexcept = default;
+
+	constexpr FieldMask(std::initializer_list<Field> fields) noexcept {
+		for (Field field : fields) {
+			bits_ |= bit(field);
+		}
+	}
+
+	/// Every field (the parsers' default)
+	[[nodiscard]] static constexpr FieldMask all() noexcept {
+		FieldMask mask;
+		mask.bits_ = ~std::uint64_t{0};
+		return mask;
+	}
+
+	[[nodiscard]] constexpr bool has(Field field) const noexcept {
+		return (bits_ & bit(field)) != 0;
+	}
+
+	[[nodiscard]] constexpr FieldMask operator|(FieldMask other) const noexcept {
+		FieldMask mask;
+		mask.bits_ = bits_ | other.bits_;
+		return mask;
+	}
+
+	[[nodiscard]] constexpr std::uint64_t bits() const noexcept { return bits_; }
+
+	constexpr bool operator==(const FieldMask&) const noexcept = default;
+
+private:
+	[[nodiscard]] static constexpr std::uint64_t bit(Field field) noexcept {
+		return std::uint64_t{1} << static_cast<std::uint32_t>(field);
+	}
+
+	std::uint64_t bits_{0};
+};
+
+/// ``Market`` members, one per parsed field.
+enum class MarketField : std::uint8_t {
+	Ticker,
+	Title,
+	Subtitle,
+	Status,
+	OpenTime,
+	CloseTime,
+	ExpectedExpirationTime,
+	ExpirationTime,
+	LatestExpirationTime,
+	SettlementTs,
+	YesBid,
+	YesAsk,
+	NoBid,
+	NoAsk,
+	Volume,
+	OpenInterest,
+	SettlementTimerSeconds,
+	SettlementValue,
+	ExpirationValue,
+	Result,
+};
+using MarketFields = FieldMask<MarketField>;
+
+/// ``Order`` members, one per parsed field. ``Counts`` covers
+/// ``initial_count`` / ``remaining_count`` / ``filled_count``, which are
+/// derived from each other.
+enum class OrderField : std::uint8_t {
+	OrderId,
+	Ticker,
+	Side,
+	Action,
+	Type,
+	Status,
+	Counts,
+	Price,
+	CreatedTime,
+	ExpirationTs,
+	MutationTs,
+};
+using OrderFields = FieldMask<OrderField>;
+
+/// ``PublicTrade`` members, one per parsed field.
+enum class TradeField : std::uint8_t {
+	TradeId,
+	Ticker,
+	YesPrice,
+	NoPrice,
+	Count,
+	TakerSide,
+	CreatedTime,
+	IsBlockTrade,
+};
+using TradeFields = FieldMask<TradeField>;
+
+} // namespace kalshi
@@ -0,0 +1,170 @@
+#pragma once
+
+/// @file history_cache.hpp
+/// @brief Bulk candlestick / trade loader with a memory-mapped columnar cache.
+
+#include "kalshi/api.hpp"
+#include "kalshi/error.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kalshi {
+
+/// Inclusive range of unix seconds
+struct HistoryRange {
+	std::int64_t from{0};
+	std::int64_t to{0};
+};
+
+/// History cache configuration
+struct HistoryCacheConfig {
+	/// Directory holding one file per market and interval (created if
+	/// missing)
+	std::string directory;
+	/// Requests in flight at once across every series being loaded (at
+	/// least 1). Each is still charged against the HTTP client's rate
+	/// limiter, if one is installed.
+	std::size_t max_in_flight{4};
+	/// Candles asked for per request; longer ranges are split into
+	/// windows of this many periods and fetched in parallel
+	std::size_t max_candles_per_request{5000};
+	/// Windows a missing trade range is split into, each paged
+	/// separately so they can be fetched in parallel
+	std::size_t trade_windows{4};
+	/// ``limit`` for each trades page
+	std::int32_t trades_page_limit{1000};
+	/// The most recent stretch of a range is fetched but not recorded as
+	/// covered, so a candle still in progress or a trade published late is
+	/// fetched again on the next load
+	std::chrono::seconds settle_lag{60};
+};
+
+/// Counters since ``open``
+struct HistoryCacheStats {
+	std::uint64_t requests{0};		 ///< HTTP requests sent
+	std::uint64_t records_fetched{0}; ///< Candles and trades received
+	std::uint64_t cache_hits{0};	 ///< Series served from disk without a request
+	std::uint64_t files_written{0};	 ///< Cache files rewritten with new data
+};
+
+/// One market's candles at one interval, oldest first, as parallel
+/// columns. The spans view the cache file's mapping and stay valid as long
+/// as this object or a copy of it lives; nothing is parsed to read them.
+struct CandleHistory {
+	std::span<const std::int64_t> timestamps; ///< Period end (``end_period_ts``)
+	std::span<const std::int32_t> open;
+	std::span<const std::int32_t> high;
+	std::span<const std::int32_t> low;
+	std::span<const std::int32_t> close;
+	std::span<const std::int32_t> volume;
+	/// What the cache file has complete data for (nullopt when nothing is
+	/// cached yet)
+	std::optional<HistoryRange> covered;
+	std::shared_ptr<const void> storage; ///< Keeps the mapping alive
+
+	[[nodiscard]] std::size_t size() const noexcept { return timestamps.size(); }
+	[[nodiscard]] bool empty() const noexcept { return timestamps.empty(); }
+};
+
+/// One market's public trades, oldest first, as parallel columns. Trade
+/// ids are not cached.
+struct TradeHistory {
+	std::span<const std::int64_t> timestamps; ///< ``created_time``
+	std::span<const std::int32_t> yes_prices;
+	std::span<const std::int32_t> counts;
+	std::span<const Side> taker_sides;
+	std::span<const std::uint8_t> block_trades; ///< 1 for block trades
+	std::optional<HistoryRange> covered;
+	std::shared_ptr<const void> storage;
+
+	[[nodiscard]] std::size_t size() const noexcept { return timestamps.size(); }
+	[[nodiscard]] bool empty() const noexcept { return timestamps.empty(); }
+};
+
+/// One market's trades to load
+struct TradeHistoryParams {
+	std::string market_ticker;
+	std::int64_t min_ts{0}; ///< Unix seconds, inclusive
+	std::int64_t max_ts{0}; ///< Unix seconds, inclusive
+};
+
+/// Loads candlestick and trade history for backtests and keeps it in a
+/// local columnar cache, so repeated research runs do not download and
+/// parse the same JSON again.
+///
+/// Each market (and candle interval) has one file: a small header with
+/// the covered time range, then one array per field. A load fetches only
+/// what the file does not cover yet, typically the tail since the last
+/// run, splitting it into windows that are requested in parallel (up to
+/// ``max_in_flight`` across every series in the call). The new records
+/// are merged in, the file is rewritten atomically (write, then rename),
+/// and the result is returned as spans into a read-only mapping of it.
+///
+/// Different series may be loaded from several threads at once. Two
+/// concurrent loads of the same series both fetch, and the later rename
+/// wins; neither sees a torn file.
+class HistoryCache {
+public:
+	/// Open (and create, if needed) the cache directory
+	[[nodiscard]] static Result<HistoryCache> open(HistoryCacheConfig config);
+
+	~HistoryCache();
+	HistoryCache(HistoryCache&&) noexcept;
+	HistoryCache& operator=(HistoryCache&&) noexcept;
+
+	HistoryCache(const HistoryCache&) = delete;
+	HistoryCache& operator=(const HistoryCache&) = delete;
+
+	/// Candles for every series in ``params`` (``start_ts`` and ``end_ts``
+	/// required), fetching what is missing; results are in input order
+	/// and limited to each requested range. Series that loaded are
+	/// written to the cache even when another one fails; the first failure
+	/// is returned.
+	[[nodiscard]] Result<std::vector<CandleHistory>>
+	load_candles(KalshiClient& client, std::span<const GetCandlesticksParams> params);
+	[[nodiscard]] Result<CandleHistory> load_candles(KalshiClient& client,
+													 const GetCandlesticksParams& params);
+
+	/// Trades for every series in ``params``, as ``load_candles``
+	[[nodiscard]] Result<std::vector<TradeHistory>>
+	load_trades(KalshiClient& client, std::span<const TradeHistoryParams> params);
+	[[nodiscard]] Result<TradeHistory> load_trades(KalshiClient& client,
+												   const TradeHistoryParams& params);
+
+	/// Everything cached for a series, without touching the network
+	/// (empty, with no ``covered`` range, when nothing is)
+	[[nodiscard]] Result<CandleHistory> cached_candles(std::string_view market_ticker,
+													   std::int32_t period_interval) const;
+	[[nodiscard]] Result<TradeHistory> cached_trades(std::string_view market_ticker) const;
+
+	/// Merge records obtained elsewhere: cached entries inside ``range``
+	/// are replaced by ``candles`` / ``trades``. The covered range becomes
+	/// the union with ``range`` when the two overlap or touch, and
+	/// ``range`` alone otherwise.
+	[[nodiscard]] Result<CandleHistory> store_candles(std::string_view market_ticker,
+													  std::int32_t period_interval,
+													  std::span<const Candlestick> candles,
+													  HistoryRange range);
+	[[nodiscard]] Result<TradeHistory> store_trades(std::string_view market_ticker,
+													std::span<const PublicTrade> trades,
+													HistoryRange range);
+
+	[[nodiscard]] HistoryCacheStats stats() const noexcept;
+
+	[[nodiscard]] const HistoryCacheConfig& config() const noexcept;
+
+private:
+	struct Impl;
+	explicit HistoryCache(std::unique_ptr<Impl> impl);
+	std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
@@ -1,9 +1,15 @@
 #pragma once
 
 #include "kalshi/error.hpp"
+#include "kalshi/latency_stats.hpp"
+#include "kalshi/rate_limit.hpp"
 #include "kalshi/signer.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
@@ -49,18 +55,109 @@ struct HttpResponse {
 	std::vector<std::pair<std::string, std::string>> headers;
 };
 
+/// Completion handler for ``HttpClient::request_async``.
+using HttpCallback = std::function<void(Result<HttpResponse>)>;
+
+/// Receives successive chunks of a streamed 2xx response body. Return
+/// false to abort the transfer.
+using HttpChunkCallback = std::function<bool(std::string_view chunk)>;
+
 /// HTTP client configuration
 struct ClientConfig {
 	std::string base_url{"https://external-api.kalshi.com/trade-api/v2"};
 	std::chrono::seconds timeout{30};
 	bool verify_ssl{true};
+
+	/// Maximum number of pooled connections (curl easy handles). Requests
+	/// beyond this many in flight wait for a handle to free up. Handles
+	/// are created lazily and kept warm; ``0`` is treated as ``1``.
+	std::size_t max_connections{4};
+
+	/// Negotiate HTTP/2 over TLS via ALPN (falls back to HTTP/1.1).
+	bool http2{true};
+
+	/// Budget for the ``EndpointRateLimiter`` the client installs at
+	/// construction, every endpoint costing one token. Defaults to Kalshi's
+	/// Basic tier so a new client stays inside the exchange's limits;
+	/// ``KalshiClient::enable_rate_limits`` replaces it with the account's
+	/// own tier and endpoint costs. ``std::nullopt`` starts unlimited.
+	std::optional<AccountApiLimits> rate_limits{
+		AccountApiLimits{.usage_tier = "basic", .read = {20, 20}, .write = {10, 10}}};
+};
+
+/// Options for ``HttpClient::prepare``
+struct PreparedRequestConfig {
+	/// Signed header lists kept ready by ``refill``
+	std::size_t presigned{4};
+	/// Oldest signature ``send`` will use; older ones are dropped and the
+	/// request signs inline. Keep it well inside the exchange's timestamp
+	/// tolerance.
+	std::chrono::milliseconds max_age{std::chrono::seconds{5}};
+};
+
+/// ``PreparedRequest`` counters
+struct PreparedRequestStats {
+	std::uint64_t sent{0};			///< ``send`` / ``send_async`` calls
+	std::uint64_t signed_inline{0}; ///< Sends that found no fresh signature
+};
+
+/// A request whose method and path are fixed ahead of time, so everything
+/// but the body is ready before it is needed.
+///
+/// ``HttpClient::prepare`` builds the full URL once. ``refill`` signs
+/// ahead and builds each signature's complete header list, off the hot
+/// path (e.g. from a timer). ``send`` then leases a handle from the
+/// client's pool, takes a header list, points the handle at the body and
+/// performs it. Signatures older than ``max_age`` are discarded; with none
+/// fresh, ``send`` signs inline like ``HttpClient::request``.
+///
+/// ``send``, ``send_async`` and ``refill`` may all run concurrently;
+/// concurrent sends use separate pooled handles. The client must outlive
+/// it.
+class PreparedRequest {
+public:
+	~PreparedRequest();
+	PreparedRequest(PreparedRequest&&) noexcept;
+	PreparedRequest& operator=(PreparedRequest&&) noexcept;
+
+	PreparedRequest(const PreparedRequest&) = delete;
+	PreparedRequest& operator=(const PreparedRequest&) = delete;
+
+	/// Drop stale signatures and sign until ``presigned`` are ready
+	[[nodiscard]] Result<void> refill();
+
+	/// Perform the request with ``body``
+	[[nodiscard]] Result<HttpResponse> send(std::string_view body = {});
+
+	/// ``send`` on the client's event loop, as ``HttpClient::request_async``
+	void send_async(std::string body, HttpCallback callback);
+
+	/// Fresh or stale signatures currently held
+	[[nodiscard]] std::size_t presigned() const;
+
+	[[nodiscard]] PreparedRequestStats stats() const noexcept;
+
+	[[nodiscard]] HttpMethod method() const noexcept;
+	[[nodiscard]] std::string_view path() const noexcept;
+
+private:
+	friend class HttpClient;
+	struct Impl;
+	explicit PreparedRequest(std::unique_ptr<Impl> impl);
+	std::unique_ptr<Impl> impl_;
 };
 
 /// HTTP client for Kalshi API
 ///
-/// @note Thread Safety: This class is NOT thread-safe. The underlying CURL
-/// handle is shared across all requests. If you need concurrent API access,
-/// create one HttpClient instance per thread or protect access with a mutex.
+/// @note Thread Safety: requests may be issued concurrently from any
+/// number of threads. Each in-flight request leases its own CURL handle
+/// from a pool of up to ``ClientConfig::max_connections``; idle handles
+/// keep their connections open, and all handles share one DNS cache, TLS
+/// session cache and connection cache. ``request_async`` transfers run
+/// on a single ``curl_multi`` event-loop thread instead of the caller's,
+/// which keeps up to ``max_connections`` handles of its own warm.
+/// Moving or destroying the client while synchronous requests are in
+/// flight is not safe.
 class HttpClient {
 public:
 	/// Create a client with the given signer and configuration
@@ -91,11 +188,73 @@ public:
 	[[nodiscard]] Result<HttpResponse> request(HttpMethod method, std::string_view path,
 											   std::string_view body = {}) const;
 
+	/// Perform a request, handing a 2xx body to ``on_chunk`` as libcurl
+	/// receives it instead of buffering it. The returned response carries
+	/// the status and headers; ``body`` is empty unless the status is not
+	/// 2xx, in which case the body is buffered as usual for the error
+	/// message. Stopping early via ``on_chunk`` is not an error.
+	[[nodiscard]] Result<HttpResponse> request_stream(HttpMethod method, std::string_view path,
+													  std::string_view body,
+													  const HttpChunkCallback& on_chunk) const;
+
+	/// Queue a request on the client's ``curl_multi`` event loop and
+	/// return immediately. The request is signed on the calling thread,
+	/// or on the loop thread when the rate limiter defers it;
+	/// ``callback`` runs on the event-loop thread once the transfer
+	/// completes (or fails), so it should be short and must not block.
+	/// The loop thread is started on first use. Requests still pending
+	/// when the client is destroyed complete with a network error.
+	void request_async(HttpMethod method, std::string path, std::string body,
+					   HttpCallback callback) const;
+
+	/// Future-returning variant of ``request_async``.
+	[[nodiscard]] std::future<Result<HttpResponse>>
+	request_async(HttpMethod method, std::string path, std::string body = {}) const;
+
+	/// Set up ``method`` + ``path`` as a ``PreparedRequest`` (see there).
+	/// Signs nothing yet; call ``refill`` before the first ``send``.
+	[[nodiscard]] Result<PreparedRequest> prepare(HttpMethod method, std::string path,
+												  PreparedRequestConfig config = {}) const;
+
+	/// Charge every request against ``limiter`` before it is signed and
+	/// sent; a request that cannot get its tokens within the limiter's
+	/// ``max_wait`` fails with ``ErrorCode::RateLimited``. Synchronous
+	/// requests wait on the calling thread. Async requests never block:
+	/// their tokens are reserved at submission and the event loop holds
+	/// the transfer until they are due, signing it then. Replaces the
+	/// limiter built from ``ClientConfig::rate_limits``; null disables
+	/// limiting. Set it before issuing requests; it is not synchronised
+	/// with them.
+	void set_rate_limiter(std::shared_ptr<EndpointRateLimiter> limiter);
+
+	/// Limiter in use: the ``ClientConfig`` default or the last
+	/// ``set_rate_limiter`` (may be null)
+	[[nodiscard]] const std::shared_ptr<EndpointRateLimiter>& rate_limiter() const noexcept;
+
+	/// Record sign, first-byte and total time plus request / error / byte
+	/// / 429 counts per endpoint into ``stats`` (``kalshi/latency_stats.hpp``).
+	/// ``KalshiClient`` adds parse time for its order and portfolio calls.
+	/// Null (default) disables it. Same threading rule as
+	/// ``set_rate_limiter``.
+	void set_latency_stats(std::shared_ptr<LatencyStats> stats);
+
+	/// Stats installed with ``set_latency_stats`` (may be null)
+	[[nodiscard]] const std::shared_ptr<LatencyStats>& latency_stats() const noexcept;
+
 	/// Get the client configuration
 	[[nodiscard]] const ClientConfig& config() const noexcept;
 
 private:
+	friend class PreparedRequest;
+	friend class RequestScheduler;
 	struct Impl;
+
+	/// ``request_async``, charging the client's limiter only when
+	/// ``charge_limiter`` is set. A ``RequestScheduler`` with its own
+	/// limiter has already charged it and passes false.
+	void submit_async(HttpMethod method, std::string path, std::string body,
+					  HttpCallback callback, bool charge_limiter) const;
+
 	std::unique_ptr<Impl> impl_;
 };
 
@@ -4,13 +4,29 @@
 /// @brief Main include file for the Kalshi C++ SDK
 
 #include "kalshi/api.hpp"
+#include "kalshi/book_conflator.hpp"
 #include "kalshi/error.hpp"
+#include "kalshi/history_cache.hpp"
 #include "kalshi/http_client.hpp"
+#include "kalshi/latency_stats.hpp"
+#include "kalshi/market_table.hpp"
+#include "kalshi/metadata_cache.hpp"
 #include "kalshi/models/market.hpp"
 #include "kalshi/models/order.hpp"
+#include "kalshi/models/price.hpp"
+#include "kalshi/order_batcher.hpp"
+#include "kalshi/orderbook_book.hpp"
 #include "kalshi/pagination.hpp"
+#include "kalshi/portfolio_state.hpp"
 #include "kalshi/rate_limit.hpp"
+#include "kalshi/request_scheduler.hpp"
 #include "kalshi/retry.hpp"
+#include "kalshi/risk_gate.hpp"
+#include "kalshi/sharded_websocket.hpp"
+#include "kalshi/shm_feed.hpp"
 #include "kalshi/signer.hpp"
 #include "kalshi/version.hpp"
+#include "kalshi/warm_state.hpp"
 #include "kalshi/websocket.hpp"
+#include "kalshi/ws_event.hpp"
+#include "kalshi/ws_recorder.hpp"
@@ -0,0 +1,201 @@
+#pragma once
+
+/// @file latency_stats.hpp
+/// @brief Per-endpoint / per-message-type latency histograms and counters.
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kalshi {
+
+/// Where a request or message spent its time
+enum class LatencyStage : std::uint8_t {
+	Sign,	   ///< REST: RSA-PSS signing and header build
+	FirstByte, ///< REST: transfer start to first response byte (libcurl)
+	Total,	   ///< REST: signing to response; WS: frame in to callback return
+	Parse,	   ///< REST: response body to model; WS: frame decode
+	Callback,  ///< WS: user callback (or queue push in queue mode)
+};
+inline constexpr std::size_t kLatencyStageCount = 5;
+
+[[nodiscard]] std::string_view to_string(LatencyStage stage) noexcept;
+
+/// Event counts kept next to the histograms
+enum class LatencyCounter : std::uint8_t {
+	Requests,	 ///< REST requests sent
+	Errors,		 ///< REST transport failures and 4xx / 5xx responses
+	BytesOut,	 ///< Request bytes uploaded
+	BytesIn,	 ///< Response bytes or WS frame bytes received
+	Retries,	 ///< Extra attempts by ``RetryingClient`` / ``RequestScheduler``
+	RateLimited, ///< HTTP 429 responses
+	Messages,	 ///< WS frames handled
+};
+inline constexpr std::size_t kLatencyCounterCount = 7;
+
+[[nodiscard]] std::string_view to_string(LatencyCounter counter) noexcept;
+
+enum class LatencySource : std::uint8_t { Rest, WebSocket };
+
+/// Log-linear (HDR-style) histogram of nanosecond durations.
+///
+/// Values below 32 ns get their own bucket; above that each power of two
+/// is split into 16 buckets, so a reported percentile is within 1/16 of
+/// the true value. Durations of 2^36 ns (about 69 s) and up share the
+/// last bucket. A plain value type: snapshots hand these out, and two
+/// can be ``merge``d.
+class LatencyHistogram {
+public:
+	static constexpr std::size_t kSubBuckets = 16;
+	static constexpr std::size_t kBucketCount = 528;
+
+	[[nodiscard]] static constexpr std::size_t bucket_index(std::uint64_t ns) noexcept {
+		if (ns < 2 * kSubBuckets) {
+			return static_cast<std::size_t>(ns);
+		}
+		const int shift = std::bit_width(ns) - 5; // Keep the top five bits.
+		const std::size_t index = static_cast<std::size_t>(shift + 1) * kSubBuckets +
+								  static_cast<std::size_t>((ns >> shift) & (kSubBuckets - 1));
+		return index < kBucketCount ? index : kBucketCount - 1;
+	}
+
+	/// Smallest value that lands in bucket ``index``
+	[[nodiscard]] static constexpr std::uint64_t bucket_lower(std::size_t index) noexcept {
+		if (index < 2 * kSubBuckets) {
+			return index;
+		}
+		const std::size_t shift = index / kSubBuckets - 1;
+		return (kSubBuckets + index % kSubBuckets) << shift;
+	}
+
+	void record(std::uint64_t ns) noexcept;
+	void merge(const LatencyHistogram& other) noexcept;
+
+	[[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+	[[nodiscard]] std::uint64_t sum_ns() const noexcept { return sum_; }
+	[[nodiscard]] std::uint64_t min_ns() const noexcept { return count_ == 0 ? 0 : min_; }
+	[[nodiscard]] std::uint64_t max_ns() const noexcept { return max_; }
+	[[nodiscard]] double mean_ns() const noexcept {
+		return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+	}
+	/// Value at quantile ``q`` (0..1): the top of the bucket holding it,
+	/// capped at ``max_ns``. 0 when empty.
+	[[nodiscard]] std::uint64_t percentile(double q) const noexcept;
+
+	[[nodiscard]] std::uint64_t bucket(std::size_t index) const noexcept {
+		return buckets_[index];
+	}
+
+private:
+	friend class LatencyStats; // Builds snapshots from its shards directly.
+
+	std::array<std::uint64_t, kBucketCount> buckets_{};
+	std::uint64_t count_{0};
+	std::uint64_t sum_{0};
+	std::uint64_t min_{~std::uint64_t{0}};
+	std::uint64_t max_{0};
+};
+
+/// Everything recorded for one endpoint or message type, summed over
+/// threads
+struct LatencySeries {
+	LatencySource source{LatencySource::Rest};
+	/// ``"POST /portfolio/orders"`` (see ``latency_endpoint``) or a WS
+	/// message type such as ``"orderbook_delta"``
+	std::string name;
+	std::array<LatencyHistogram, kLatencyStageCount> stages{};
+	std::array<std::uint64_t, kLatencyCounterCount> counters{};
+
+	[[nodiscard]] const LatencyHistogram& stage(LatencyStage s) const noexcept {
+		return stages[static_cast<std::size_t>(s)];
+	}
+	[[nodiscard]] std::uint64_t counter(LatencyCounter c) const noexcept {
+		return counters[static_cast<std::size_t>(c)];
+	}
+};
+
+/// Point-in-time copy of a ``LatencyStats``
+struct LatencySnapshot {
+	/// Sorted by source, then name
+	std::vector<LatencySeries> series;
+
+	[[nodiscard]] const LatencySeries* find(LatencySource source,
+											std::string_view name) const noexcept;
+};
+
+/// Series name for a REST call: ``"<METHOD> <path>"`` with the query
+/// string dropped and every path segment holding a digit or an upper-case
+/// letter (tickers, order ids) replaced by ``{id}``, e.g.
+/// ``"GET /markets/{id}/orderbook"``.
+[[nodiscard]] std::string latency_endpoint(std::string_view method, std::string_view path);
+
+/// Latency histograms and counters for the REST client and WebSocket
+/// feed.
+///
+/// Attach one with ``HttpClient::set_latency_stats`` and / or
+/// ``WsConfig::latency_stats`` (one instance may serve both). Each thread
+/// records into its own shard, so recording is a hash lookup plus a few
+/// relaxed stores with no shared cache lines and no lock; ``snapshot``
+/// sums the shards. With nothing attached the instrumented paths skip
+/// even the clock reads.
+class LatencyStats {
+	struct Cell;
+
+public:
+	/// One series as seen from the thread that looked it up. Only that
+	/// thread may record through it.
+	class Recorder {
+	public:
+		Recorder() = default;
+
+		void record(LatencyStage stage, std::uint64_t ns) noexcept;
+		void record(LatencyStage stage, std::chrono::nanoseconds elapsed) noexcept {
+			record(stage, static_cast<std::uint64_t>(elapsed.count() < 0 ? 0 : elapsed.count()));
+		}
+		void add(LatencyCounter counter, std::uint64_t n = 1) noexcept;
+
+		explicit operator bool() const noexcept { return cell_ != nullptr; }
+
+	private:
+		friend class LatencyStats;
+		explicit Recorder(Cell* cell) noexcept : cell_(cell) {}
+
+		Cell* cell_{nullptr};
+	};
+
+	LatencyStats();
+	~LatencyStats();
+
+	LatencyStats(const LatencyStats&) = delete;
+	LatencyStats& operator=(const LatencyStats&) = delete;
+
+	/// This thread's series for a REST call (named by ``latency_endpoint``)
+	[[nodiscard]] Recorder rest(std::string_view method, std::string_view path);
+	/// This thread's series for a WebSocket message type
+	[[nodiscard]] Recorder ws(std::string_view message_type);
+
+	[[nodiscard]] LatencySnapshot snapshot() const;
+
+private:
+	struct Shard;
+	struct Impl;
+
+	[[nodiscard]] Recorder lookup(LatencySource source, std::string_view name);
+
+	std::unique_ptr<Impl> impl_;
+};
+
+/// Render ``snapshot`` in the Prometheus text exposition format: one
+/// ``<prefix>_latency_seconds`` summary (p50 / p90 / p99 / p99.9, sum,
+/// count) per series and stage that has samples, and one
+/// ``<prefix>_<counter>_total`` counter family per ``LatencyCounter``.
+[[nodiscard]] std::string to_prometheus(const LatencySnapshot& snapshot,
+										std::string_view prefix = "kalshi");
+
+} // namespace kalshi
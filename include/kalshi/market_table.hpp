@@ -0,0 +1,215 @@
+#pragma once
+
+/// @file market_table.hpp
+/// @brief Column-oriented market universe for scans over many markets.
+
+#include "kalshi/api.hpp"
+#include "kalshi/error.hpp"
+#include "kalshi/models/market.hpp"
+#include "kalshi/orderbook_book.hpp"
+#include "kalshi/ticker_table.hpp"
+#include "kalshi/websocket.hpp"
+#include "kalshi/ws_event.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace kalshi {
+
+/// Numeric column of a ``MarketTable``, for ``sort`` and ``value``
+enum class MarketColumn : std::uint8_t {
+	YesBid,
+	YesAsk,
+	NoBid,
+	NoAsk,
+	Spread, ///< ``yes_ask - yes_bid``
+	Volume,
+	OpenInterest,
+	LastPrice,
+	OpenTime,
+	CloseTime,
+};
+
+enum class SortOrder : std::uint8_t { Ascending, Descending };
+
+/// Row predicate for ``MarketTable::select``. Every bound is inclusive;
+/// the defaults let every row through.
+struct MarketFilter {
+	std::optional<MarketStatus> status;
+	std::int32_t min_yes_bid{std::numeric_limits<std::int32_t>::min()};
+	std::int32_t max_yes_ask{std::numeric_limits<std::int32_t>::max()};
+	std::int32_t max_spread{std::numeric_limits<std::int32_t>::max()};
+	std::int32_t min_volume{std::numeric_limits<std::int32_t>::min()};
+	std::int32_t min_open_interest{std::numeric_limits<std::int32_t>::min()};
+	std::int64_t close_after{std::numeric_limits<std::int64_t>::min()};
+	std::int64_t close_before{std::numeric_limits<std::int64_t>::max()};
+};
+
+/// Every market of a universe, one array per field.
+///
+/// A scan over ``std::vector<Market>`` drags each market's strings and
+/// optionals through the cache to read four numbers. Here each numeric
+/// field is a contiguous array indexed by row, and tickers, titles and
+/// subtitles live in one shared character pool, so a filter touches only
+/// the columns it tests. ``select`` evaluates a ``MarketFilter`` in blocks
+/// of branch-free comparisons the compiler vectorizes, then compacts the
+/// surviving row numbers.
+///
+/// Rows are assigned in insertion order and never move; a market is found
+/// by ticker or, when it was built with a ``TickerTable`` attached, by
+/// ``TickerId``. Fill it with ``load`` (which streams pages straight into
+/// the columns, never building a ``std::vector<Market>``) or ``upsert``,
+/// then keep it current with ``apply``: top-of-book from
+/// ``BookConflator`` / ``ShmFeedReader``, trades and lifecycle messages
+/// from the WebSocket.
+///
+/// Prices are cents. Not thread-safe: update and scan from one thread, as
+/// with ``OrderBookBook``.
+class MarketTable {
+public:
+	MarketTable() = default;
+
+	/// Insert ``market`` or overwrite the row with its ticker; returns the row
+	std::uint32_t upsert(const Market& market);
+
+	/// ``upsert`` every market matching ``params``, following cursors until
+	/// the last page. Returns the number of markets received.
+	[[nodiscard]] Result<std::size_t> load(KalshiClient& client,
+										   const GetMarketsParams& params = {});
+
+	void reserve(std::size_t markets);
+	void clear();
+
+	[[nodiscard]] std::size_t size() const noexcept { return close_times_.size(); }
+	[[nodiscard]] bool empty() const noexcept { return close_times_.empty(); }
+
+	/// Row of a market, if present
+	[[nodiscard]] std::optional<std::uint32_t> find(std::string_view ticker) const;
+	[[nodiscard]] std::optional<std::uint32_t> find(TickerId id) const;
+
+	// ===== Updates =====
+
+	/// Quotes from a book's best bids: ``yes_ask`` is 100 minus the best
+	/// NO bid (100 when that side is empty), and likewise ``no_ask``.
+	/// Ignores invalid books. Returns true when a row changed.
+	bool apply(const TopOfBook& top);
+	/// Trades add to ``volume`` and set the last price; lifecycle messages
+	/// update status, result, subtitle and open / close times. Other
+	/// messages are ignored.
+	bool apply(const WsMessage& message);
+	/// Compact trades, as ``apply(const WsMessage&)``
+	bool apply(const WsEvent& event);
+
+	// ===== Scans =====
+
+	/// Rows passing ``filter``, ascending, into ``rows`` (replacing its
+	/// contents). Returns the count.
+	std::size_t select(const MarketFilter& filter, std::vector<std::uint32_t>& rows) const;
+
+	/// Reorder ``rows`` by one column; ties keep row order
+	void sort(std::span<std::uint32_t> rows, MarketColumn column,
+			  SortOrder order = SortOrder::Descending) const;
+
+	/// One cell of a numeric column, widened
+	[[nodiscard]] std::int64_t value(std::uint32_t row, MarketColumn column) const noexcept;
+
+	/// Reassemble the row as a ``Market`` (quotes to the cent; fields the
+	/// table does not keep are left at their defaults)
+	[[nodiscard]] Market market(std::uint32_t row) const;
+
+	// ===== Columns, indexed by row =====
+
+	[[nodiscard]] std::span<const std::int64_t> open_times() const noexcept { return open_times_; }
+	[[nodiscard]] std::span<const std::int64_t> close_times() const noexcept {
+		return close_times_;
+	}
+	[[nodiscard]] std::span<const std::int32_t> yes_bids() const noexcept { return yes_bids_; }
+	[[nodiscard]] std::span<const std::int32_t> yes_asks() const noexcept { return yes_asks_; }
+	[[nodiscard]] std::span<const std::int32_t> no_bids() const noexcept { return no_bids_; }
+	[[nodiscard]] std::span<const std::int32_t> no_asks() const noexcept { return no_asks_; }
+	[[nodiscard]] std::span<const std::int32_t> volumes() const noexcept { return volumes_; }
+	[[nodiscard]] std::span<const std::int32_t> open_interests() const noexcept {
+		return open_interests_;
+	}
+	/// YES price of the latest trade applied (0 before any)
+	[[nodiscard]] std::span<const std::int32_t> last_prices() const noexcept {
+		return last_prices_;
+	}
+	[[nodiscard]] std::span<const MarketStatus> statuses() const noexcept { return statuses_; }
+	[[nodiscard]] std::span<const TickerId> ticker_ids() const noexcept { return ticker_ids_; }
+
+	/// Views into the string pool; valid until the next update
+	[[nodiscard]] std::string_view ticker(std::uint32_t row) const noexcept;
+	[[nodiscard]] std::string_view title(std::uint32_t row) const noexcept;
+	[[nodiscard]] std::string_view subtitle(std::uint32_t row) const noexcept;
+	/// ``result`` once determined or settled, else empty
+	[[nodiscard]] std::string_view result(std::uint32_t row) const noexcept;
+
+	/// Bytes in the string pool, including text superseded by updates
+	/// (reclaimed once it outgrows the live text)
+	[[nodiscard]] std::size_t pool_bytes() const noexcept { return pool_.size(); }
+
+private:
+	friend class WarmState; // Persists and restores the columns directly.
+
+	/// A string in ``pool_``
+	struct Text {
+		std::uint32_t offset{0};
+		std::uint32_t length{0};
+	};
+
+	/// Lets ``index_`` be probed with a ``string_view`` without building a key
+	struct StringHash {
+		using is_transparent = void;
+		std::size_t operator()(std::string_view s) const noexcept {
+			return std::hash<std::string_view>{}(s);
+		}
+	};
+
+	[[nodiscard]] std::optional<std::uint32_t> row_of(TickerId id,
+													  std::string_view ticker) const;
+	[[nodiscard]] std::string_view text(Text t) const noexcept;
+	void assign(std::vector<Text>& column, std::uint32_t row, std::string_view value);
+	[[nodiscard]] Text intern(std::string_view value);
+	void index_id(TickerId id, std::uint32_t row);
+	bool apply_trade(TickerId id, std::string_view ticker, std::int32_t yes_price,
+					 std::int32_t count);
+	bool apply_lifecycle(const MarketLifecycle& lifecycle);
+	void compact();
+
+	// Numeric columns
+	std::vector<std::int64_t> open_times_;
+	std::vector<std::int64_t> close_times_;
+	std::vector<std::int32_t> yes_bids_;
+	std::vector<std::int32_t> yes_asks_;
+	std::vector<std::int32_t> no_bids_;
+	std::vector<std::int32_t> no_asks_;
+	std::vector<std::int32_t> volumes_;
+	std::vector<std::int32_t> open_interests_;
+	std::vector<std::int32_t> last_prices_;
+	std::vector<MarketStatus> statuses_;
+	std::vector<TickerId> ticker_ids_;
+
+	// Text columns
+	std::vector<Text> tickers_;
+	std::vector<Text> titles_;
+	std::vector<Text> subtitles_;
+	std::vector<Text> results_;
+	std::string pool_;
+	std::size_t dead_bytes_{0}; ///< Pool text no row refers to any more
+
+	std::unordered_map<std::string, std::uint32_t, StringHash, std::equal_to<>> index_;
+	std::vector<std::uint32_t> row_of_id_; ///< By ``TickerId::value``; ``kNoRow`` if unset
+
+	static constexpr std::uint32_t kNoRow = 0xFFFFFFFFU;
+};
+
+} // namespace kalshi
@@ -0,0 +1,122 @@
+#pragma once
+
+/// @file metadata_cache.hpp
+/// @brief Local cache for market / event / series metadata.
+
+#include "kalshi/api.hpp"
+#include "kalshi/models/market.hpp"
+#include "kalshi/websocket.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace kalshi {
+
+/// Freshness limits for ``MetadataCache``
+struct MetadataCacheConfig {
+	/// Markets carry quote fields (``yes_bid`` …) as of the fetch; the TTL
+	/// bounds how old those may be. Status and times are additionally
+	/// kept current by ``apply`` and by the close-time check.
+	std::chrono::milliseconds market_ttl{std::chrono::seconds{5}};
+	std::chrono::milliseconds event_ttl{std::chrono::minutes{1}};
+	std::chrono::milliseconds event_metadata_ttl{std::chrono::minutes{10}};
+	std::chrono::milliseconds series_ttl{std::chrono::minutes{10}};
+	/// Entries per kind. A full cache first drops expired entries, then
+	/// evicts arbitrary ones. 0 means unbounded.
+	std::size_t max_entries{65536};
+};
+
+/// Cache counters
+struct MetadataCacheStats {
+	std::uint64_t hits{0};
+	std::uint64_t misses{0};		///< Absent, expired, or past ``close_time``
+	std::uint64_t patches{0};		///< Markets updated in place by ``apply``
+	std::uint64_t invalidations{0}; ///< Entries dropped by ``apply`` / ``invalidate_*``
+};
+
+/// A cached value and how much longer it stays fresh
+template <typename T> struct MetadataEntry {
+	std::shared_ptr<const T> value;
+	std::chrono::milliseconds ttl{0};
+};
+
+/// Every unexpired entry of a ``MetadataCache``, as returned by ``entries``
+struct MetadataCacheEntries {
+	std::vector<MetadataEntry<Market>> markets;
+	std::vector<MetadataEntry<Event>> events;
+	std::vector<MetadataEntry<EventMetadata>> event_metadata;
+	std::vector<MetadataEntry<Series>> series;
+};
+
+/// Thread-safe, TTL-bounded store of ``Market`` / ``Event`` /
+/// ``EventMetadata`` / ``Series`` responses, keyed by ticker.
+///
+/// Attach one with ``KalshiClient::set_metadata_cache`` and the client's
+/// ``get_market`` / ``get_event`` / ``get_event_metadata`` /
+/// ``get_series`` answer from it while entries are fresh, and fill it on
+/// a miss. Entries are immutable and shared: a hit is a shared lock, a
+/// hash lookup and a ``shared_ptr`` copy, with no allocation.
+///
+/// An ``Open`` market whose ``close_time`` has passed counts as a miss,
+/// and ``apply`` keeps markets current from the WebSocket lifecycle
+/// channel, so order-entry checks of status and close time can trust
+/// a hit.
+class MetadataCache {
+public:
+	explicit MetadataCache(MetadataCacheConfig config = {});
+	~MetadataCache();
+
+	MetadataCache(const MetadataCache&) = delete;
+	MetadataCache& operator=(const MetadataCache&) = delete;
+
+	/// Fresh entry for the ticker, or null
+	[[nodiscard]] std::shared_ptr<const Market> market(std::string_view ticker) const;
+	[[nodiscard]] std::shared_ptr<const Event> event(std::string_view event_ticker) const;
+	[[nodiscard]] std::shared_ptr<const EventMetadata>
+	event_metadata(std::string_view event_ticker) const;
+	[[nodiscard]] std::shared_ptr<const Series> series(std::string_view series_ticker) const;
+
+	/// Store (or replace) an entry with a fresh TTL; returns the stored copy
+	std::shared_ptr<const Market> put(Market market);
+	std::shared_ptr<const Event> put(Event event);
+	std::shared_ptr<const EventMetadata> put(EventMetadata metadata);
+	std::shared_ptr<const Series> put(Series series);
+
+	/// Store with an explicit TTL instead of the configured one (e.g. the
+	/// remainder of an entry restored by ``WarmState``)
+	std::shared_ptr<const Market> put(Market market, std::chrono::milliseconds ttl);
+	std::shared_ptr<const Event> put(Event event, std::chrono::milliseconds ttl);
+	std::shared_ptr<const EventMetadata> put(EventMetadata metadata,
+											 std::chrono::milliseconds ttl);
+	std::shared_ptr<const Series> put(Series series, std::chrono::milliseconds ttl);
+
+	/// Fold a ``market_lifecycle_v2`` message into the cached market, if
+	/// any. Settled / determined / deactivated / subtitle changes are
+	/// patched in place (keeping the entry's expiry); open / create and
+	/// unrecognized frames drop the entry. Returns true when an entry
+	/// changed.
+	bool apply(const MarketLifecycle& lifecycle);
+
+	void invalidate_market(std::string_view ticker);
+	/// Drops both the event and its metadata
+	void invalidate_event(std::string_view event_ticker);
+	void invalidate_series(std::string_view series_ticker);
+	void clear();
+
+	/// Copy out every unexpired entry with its remaining TTL
+	[[nodiscard]] MetadataCacheEntries entries() const;
+
+	[[nodiscard]] MetadataCacheStats stats() const noexcept;
+
+	[[nodiscard]] const MetadataCacheConfig& config() const noexcept;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "kalshi/models/price.hpp"
+#include "kalshi/ticker_table.hpp"
+
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -43,6 +46,8 @@ enum class MarketStatus : std::uint8_t { Open, Closed, Settled, Unopened, Paused
 struct OrderBookEntry {
 	std::int32_t price_cents; // 1-99 for binary markets
 	std::int32_t quantity;
+
+	[[nodiscard]] constexpr Price price() const noexcept { return Price::from_cents(price_cents); }
 };
 
 /// Order book for a market
@@ -62,6 +67,12 @@ struct Market {
 	std::optional<std::int64_t> expiration_time;
 	std::optional<std::int64_t> latest_expiration_time;
 	std::optional<std::int64_t> settlement_ts;
+	/// Exact quotes, sub-cent ticks included; ``yes_bid`` etc. hold their
+	/// ``cents()``
+	Price yes_bid_dollars;
+	Price yes_ask_dollars;
+	Price no_bid_dollars;
+	Price no_ask_dollars;
 
 	// 4-byte fields grouped together
 	std::int32_t yes_bid{0};
@@ -72,6 +83,7 @@ struct Market {
 	std::int32_t open_interest{0};
 	std::optional<std::int32_t> settlement_timer_seconds;
 	std::optional<std::int32_t> settlement_value_cents;
+	TickerId ticker_id; ///< Set when the client has a ticker table attached
 
 	// 1-byte enum
 	MarketStatus status{MarketStatus::Open};
@@ -0,0 +1,242 @@
+#pragma once
+
+/// @file price.hpp
+/// @brief Fixed-point ``Price`` and ``Quantity`` at Kalshi's wire precision.
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace kalshi {
+
+namespace detail {
+
+/// Parse ``[-]digits[.digits]`` into an integer count of
+/// ``10^-Decimals`` units. Digits past ``Decimals`` round half away from
+/// zero on the first dropped digit, like ``parse_dollar_cents``. Empty,
+/// malformed or out-of-range input yields nullopt.
+template <int Decimals>
+[[nodiscard]] constexpr std::optional<std::int64_t> parse_fixed(std::string_view s) noexcept {
+	constexpr std::int64_t kMax = std::numeric_limits<std::int64_t>::max();
+	std::size_t i = 0;
+	const bool negative = !s.empty() && s[0] == '-';
+	if (negative) {
+		++i;
+	}
+	std::int64_t units = 0;
+	bool any_digit = false;
+	for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) {
+		if (units > (kMax - 9) / 10) {
+			return std::nullopt;
+		}
+		units = units * 10 + (s[i] - '0');
+		any_digit = true;
+	}
+	int decimals = 0;
+	bool round_up = false;
+	if (i < s.size() && s[i] == '.') {
+		++i;
+		for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) {
+			if (decimals < Decimals) {
+				if (units > (kMax - 9) / 10) {
+					return std::nullopt;
+				}
+				units = units * 10 + (s[i] - '0');
+				++decimals;
+			} else if (decimals == Decimals) {
+				round_up = s[i] >= '5';
+				++decimals; // Later digits do not matter.
+			}
+			any_digit = true;
+		}
+	}
+	if (!any_digit || i != s.size()) {
+		return std::nullopt;
+	}
+	for (; decimals < Decimals; ++decimals) {
+		if (units > kMax / 10) {
+			return std::nullopt;
+		}
+		units *= 10;
+	}
+	if (round_up) {
+		if (units == kMax) {
+			return std::nullopt;
+		}
+		++units;
+	}
+	return negative ? -units : units;
+}
+
+/// Write ``units`` as ``[-]D.<Decimals digits>`` at ``out`` and return the
+/// end. Writes at most 21 bytes; no terminator.
+template <int Decimals>
+constexpr char* format_fixed(char* out, std::int64_t units) noexcept {
+	// Work on the magnitude as unsigned so INT64_MIN formats correctly.
+	std::uint64_t magnitude = units < 0 ? ~static_cast<std::uint64_t>(units) + 1
+										: static_cast<std::uint64_t>(units);
+	if (units < 0) {
+		*out++ = '-';
+	}
+	char digits[24]{};
+	int n = 0;
+	do {
+		digits[n++] = static_cast<char>('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0 || n <= Decimals);
+	while (n > Decimals) {
+		*out++ = digits[--n];
+	}
+	*out++ = '.';
+	while (n > 0) {
+		*out++ = digits[--n];
+	}
+	return out;
+}
+
+/// Round ``units`` of ``10^-Decimals`` to a multiple of ``Step`` units,
+/// half away from zero, and return the multiple.
+template <std::int64_t Step>
+[[nodiscard]] constexpr std::int64_t round_units(std::int64_t units) noexcept {
+	const std::int64_t half = Step / 2;
+	return units >= 0 ? (units / Step) + ((units % Step) >= half ? 1 : 0)
+					  : -((-(units / Step)) + ((-(units % Step)) >= half ? 1 : 0));
+}
+
+} // namespace detail
+
+/// Dollar amount in exchange ticks of $0.0001.
+///
+/// Kalshi sends prices as ``"D.DDDD"`` strings, and sub-cent markets
+/// quote between whole cents. ``Price`` holds that value exactly as an
+/// integer tick count, so nothing is lost between parsing a quote and
+/// sending an order. ``parse`` and ``format_to`` work in place and never
+/// allocate. The ``std::int32_t`` cent fields on the models remain, and
+/// hold ``cents()`` of the matching ``Price``.
+class Price {
+public:
+	static constexpr std::int64_t kTicksPerCent = 100;
+	static constexpr std::int64_t kTicksPerDollar = 100 * kTicksPerCent;
+	/// Upper bound on the bytes ``format_to`` writes
+	static constexpr std::size_t kMaxChars = 24;
+
+	constexpr Price() noexcept = default;
+
+	[[nodiscard]] static constexpr Price from_ticks(std::int64_t ticks) noexcept {
+		return Price{ticks};
+	}
+	[[nodiscard]] static constexpr Price from_cents(std::int64_t cents) noexcept {
+		return Price{cents * kTicksPerCent};
+	}
+
+	/// Parse a decimal dollar string (``"0.4250"``, ``"1"``, ``"-0.01"``).
+	/// Digits past the fourth decimal round half away from zero.
+	[[nodiscard]] static constexpr std::optional<Price> parse(std::string_view dollars) noexcept {
+		const std::optional<std::int64_t> ticks = detail::parse_fixed<4>(dollars);
+		if (!ticks) {
+			return std::nullopt;
+		}
+		return Price{*ticks};
+	}
+
+	[[nodiscard]] constexpr std::int64_t ticks() const noexcept { return ticks_; }
+
+	/// Nearest whole cent, half away from zero
+	[[nodiscard]] constexpr std::int32_t cents() const noexcept {
+		return static_cast<std::int32_t>(detail::round_units<kTicksPerCent>(ticks_));
+	}
+
+	/// False for sub-cent prices, which ``cents()`` rounds
+	[[nodiscard]] constexpr bool whole_cents() const noexcept {
+		return ticks_ % kTicksPerCent == 0;
+	}
+
+	/// Write the wire form (``"0.4250"``, always four decimals, no quotes)
+	/// and return the end. ``out`` needs ``kMaxChars`` bytes.
+	constexpr char* format_to(char* out) const noexcept {
+		return detail::format_fixed<4>(out, ticks_);
+	}
+
+	[[nodiscard]] std::string to_string() const {
+		char buf[kMaxChars];
+		return std::string(buf, format_to(buf));
+	}
+
+	constexpr std::strong_ordering operator<=>(const Price&) const noexcept = default;
+
+	constexpr Price operator+(Price other) const noexcept { return Price{ticks_ + other.ticks_}; }
+	constexpr Price operator-(Price other) const noexcept { return Price{ticks_ - other.ticks_}; }
+
+private:
+	constexpr explicit Price(std::int64_t ticks) noexcept : ticks_(ticks) {}
+
+	std::int64_t ticks_{0};
+};
+
+/// Contract count in hundredths, the precision of the ``*_fp`` fields.
+///
+/// Same idea as ``Price``: exact, ``constexpr``, and parsed and
+/// formatted without allocating. The ``std::int32_t`` count fields hold
+/// ``contracts()``.
+class Quantity {
+public:
+	static constexpr std::int64_t kUnitsPerContract = 100;
+	/// Upper bound on the bytes ``format_to`` writes
+	static constexpr std::size_t kMaxChars = 24;
+
+	constexpr Quantity() noexcept = default;
+
+	[[nodiscard]] static constexpr Quantity from_units(std::int64_t units) noexcept {
+		return Quantity{units};
+	}
+	[[nodiscard]] static constexpr Quantity from_contracts(std::int64_t contracts) noexcept {
+		return Quantity{contracts * kUnitsPerContract};
+	}
+
+	/// Parse a decimal count string (``"40.00"``, ``"-30.87"``, ``"3"``)
+	[[nodiscard]] static constexpr std::optional<Quantity> parse(std::string_view s) noexcept {
+		const std::optional<std::int64_t> units = detail::parse_fixed<2>(s);
+		if (!units) {
+			return std::nullopt;
+		}
+		return Quantity{*units};
+	}
+
+	[[nodiscard]] constexpr std::int64_t units() const noexcept { return units_; }
+
+	/// Nearest whole contract, half away from zero
+	[[nodiscard]] constexpr std::int32_t contracts() const noexcept {
+		return static_cast<std::int32_t>(detail::round_units<kUnitsPerContract>(units_));
+	}
+
+	/// Write the wire form (``"40.00"``) and return the end. ``out`` needs
+	/// ``kMaxChars`` bytes.
+	constexpr char* format_to(char* out) const noexcept {
+		return detail::format_fixed<2>(out, units_);
+	}
+
+	[[nodiscard]] std::string to_string() const {
+		char buf[kMaxChars];
+		return std::string(buf, format_to(buf));
+	}
+
+	constexpr std::strong_ordering operator<=>(const Quantity&) const noexcept = default;
+
+	constexpr Quantity operator+(Quantity other) const noexcept {
+		return Quantity{units_ + other.units_};
+	}
+	constexpr Quantity operator-(Quantity other) const noexcept {
+		return Quantity{units_ - other.units_};
+	}
+
+private:
+	constexpr explicit Quantity(std::int64_t units) noexcept : units_(units) {}
+
+	std::int64_t units_{0};
+};
+
+} // namespace kalshi
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "kalshi/api.hpp"
+#include "kalshi/error.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+
+namespace kalshi {
+
+/// Order batcher configuration
+struct OrderBatcherConfig {
+	/// How long the first intent of a batch waits for company
+	std::chrono::microseconds window{200};
+	/// Intents per batch request; a full batch is sent without waiting
+	std::size_t max_batch{20};
+};
+
+/// Counters since construction.
+struct OrderBatcherStats {
+	std::uint64_t creates{0};		 ///< Create intents accepted
+	std::uint64_t cancels{0};		 ///< Cancel intents accepted
+	std::uint64_t create_batches{0}; ///< ``POST /portfolio/orders/batched`` sent
+	std::uint64_t cancel_batches{0}; ///< ``DELETE /portfolio/events/orders/batched`` sent
+};
+
+/// Coalesces single order operations into Kalshi's batch endpoints.
+///
+/// ``create_order`` and ``cancel_order`` queue one intent each. A flusher
+/// thread sends the queued intents as one ``batch_create_orders_async`` /
+/// ``batch_cancel_orders_v2_async`` call once the oldest has waited
+/// ``window`` or ``max_batch`` are queued, cancels first, and splits the
+/// batch response back to each caller: creates by position, cancels by
+/// ``order_id``. A rejected entry completes its caller with
+/// ``ErrorCode::ServerError`` and the exchange's message; a failed batch
+/// request completes every caller in it with that error.
+///
+/// Callbacks run on the HTTP event-loop thread and must not block. The
+/// client must outlive the batcher; intents still queued at destruction
+/// are sent immediately.
+class OrderBatcher {
+public:
+	explicit OrderBatcher(KalshiClient& client, OrderBatcherConfig config = {});
+	~OrderBatcher();
+
+	OrderBatcher(OrderBatcher&&) noexcept;
+	OrderBatcher& operator=(OrderBatcher&&) noexcept;
+
+	OrderBatcher(const OrderBatcher&) = delete;
+	OrderBatcher& operator=(const OrderBatcher&) = delete;
+
+	/// Queue an order for the next create batch
+	void create_order(CreateOrderParams params, AsyncCallback<Order> callback);
+	[[nodiscard]] std::future<Result<Order>> create_order(CreateOrderParams params);
+
+	/// Queue a cancel for the next cancel batch
+	void cancel_order(CancelOrderV2Params params, AsyncCallback<OrderCancelResult> callback);
+	[[nodiscard]] std::future<Result<OrderCancelResult>> cancel_order(CancelOrderV2Params params);
+
+	/// Send everything queued now instead of waiting out the window
+	void flush();
+
+	[[nodiscard]] OrderBatcherStats stats() const;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
@@ -0,0 +1,128 @@
+#pragma once
+
+/// @file orderbook_book.hpp
+/// @brief Flat-array L2 order book fed directly by WebSocket snapshots / deltas.
+///
+/// Binary-market prices are bounded, so each side is a fixed array of
+/// resting quantity indexed by price in cents, plus a bitmap of occupied
+/// levels. A delta is one array write and one bit flip; top-of-book is a
+/// bit scan over two 64-bit words. No allocation after construction.
+///
+/// Kalshi books only carry bids: a NO bid at P cents is a YES ask at
+/// ``100 - P`` and vice versa, which is how ``best_ask`` is derived.
+
+#include "kalshi/models/market.hpp"
+#include "kalshi/websocket.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace kalshi {
+
+/// Outcome of applying a snapshot or delta to an ``OrderBookBook``.
+enum class BookUpdate : std::uint8_t {
+	Applied,	   ///< Book mutated
+	Stale,		   ///< ``seq`` at or below the last applied one; ignored
+	Gap,		   ///< ``seq`` skipped ahead; book invalidated until the next snapshot
+	NeedsSnapshot, ///< Delta before any snapshot (or after a gap); ignored
+	OutOfRange,	   ///< Price outside [kMinPrice, kMaxPrice]; ignored
+};
+
+/// How strictly ``OrderBookBook`` checks delta sequence numbers.
+///
+/// Kalshi numbers ``seq`` per *subscription*, not per market. When a
+/// book's market is the only one on its subscription every delta is
+/// ``last + 1`` and ``Contiguous`` detects dropped deltas exactly. When a
+/// subscription covers several markets a book sees gaps by design; use
+/// ``Monotonic`` (reject only duplicates / reordering) and track gaps per
+/// subscription instead.
+enum class SeqCheck : std::uint8_t { Contiguous, Monotonic };
+
+/// Best bid on each side of one market, as last published (by
+/// ``ShmFeedWriter`` or ``BookConflator``)
+struct TopOfBook {
+	TickerId ticker_id;
+	OrderBookEntry yes_bid{0, 0}; ///< ``quantity`` 0 when the side is empty
+	OrderBookEntry no_bid{0, 0};  ///< ``quantity`` 0 when the side is empty
+	std::int32_t seq{0};		  ///< Sequence number of the last applied update
+	bool valid{false};			  ///< Book built from a snapshot, no gap since
+	std::int64_t updated_ns{0};	  ///< Publisher ``system_clock`` time of the update
+	std::uint64_t version{0};	  ///< Bumped on every publish of this market
+};
+
+/// Single-market L2 book with O(1) deltas and O(1) top-of-book.
+///
+/// Not thread-safe: apply updates and read from the same thread (e.g. the
+/// queue-mode consumer of ``WebSocketClient::poll``).
+class OrderBookBook {
+public:
+	static constexpr std::int32_t kMinPrice = 1;
+	static constexpr std::int32_t kMaxPrice = 99;
+
+	explicit OrderBookBook(SeqCheck seq_check = SeqCheck::Contiguous) noexcept;
+
+	/// Replace both sides with the snapshot and reset the sequence base.
+	BookUpdate apply(const OrderbookSnapshot& snapshot) noexcept;
+
+	/// Apply a signed quantity change at one price level. Levels whose
+	/// quantity drops to zero or below are removed.
+	BookUpdate apply(const OrderbookDelta& delta) noexcept;
+
+	/// Drop all levels and require a fresh snapshot.
+	void clear() noexcept;
+
+	/// True once a snapshot has been applied and no gap seen since.
+	[[nodiscard]] bool valid() const noexcept { return initialized_; }
+
+	/// Sequence number of the last applied snapshot or delta.
+	[[nodiscard]] std::int32_t last_seq() const noexcept { return last_seq_; }
+
+	[[nodiscard]] SeqCheck seq_check() const noexcept { return seq_check_; }
+
+	/// Resting bid quantity on ``side`` at ``price_cents`` (0 when empty
+	/// or out of range).
+	[[nodiscard]] std::int32_t quantity(Side side, std::int32_t price_cents) const noexcept;
+
+	/// Highest bid on ``side``.
+	[[nodiscard]] std::optional<OrderBookEntry> best_bid(Side side) const noexcept;
+
+	/// Lowest ask on ``side``, implied by the opposite side's best bid.
+	[[nodiscard]] std::optional<OrderBookEntry> best_ask(Side side) const noexcept;
+
+	/// Number of occupied levels on ``side``.
+	[[nodiscard]] std::size_t level_count(Side side) const noexcept;
+
+	/// Materialize both sides as an ``OrderBook`` (ascending price, the
+	/// same order ``GET /markets/{ticker}/orderbook`` returns).
+	[[nodiscard]] OrderBook to_order_book(std::string market_ticker) const;
+
+	/// Both sides and ``last_seq`` as a snapshot (``sid`` 0) that
+	/// ``apply`` reproduces this book from, e.g. to persist it
+	[[nodiscard]] OrderbookSnapshot to_snapshot(std::string market_ticker) const;
+
+private:
+	struct Ladder {
+		std::array<std::int32_t, kMaxPrice + 1> quantity{};
+		std::array<std::uint64_t, 2> occupied{}; ///< Bit p set ⇔ quantity[p] > 0
+
+		void set(std::int32_t price, std::int32_t qty) noexcept;
+		[[nodiscard]] std::int32_t best_price() const noexcept; ///< 0 when empty
+		void clear() noexcept;
+	};
+
+	[[nodiscard]] Ladder& ladder(Side side) noexcept { return side == Side::Yes ? yes_ : no_; }
+	[[nodiscard]] const Ladder& ladder(Side side) const noexcept {
+		return side == Side::Yes ? yes_ : no_;
+	}
+
+	Ladder yes_;
+	Ladder no_;
+	std::int32_t last_seq_{0};
+	bool initialized_{false};
+	SeqCheck seq_check_;
+};
+
+} // namespace kalshi
@@ -3,10 +3,14 @@
 #include "kalshi/error.hpp"
 #include "kalshi/http_client.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <future>
+#include <iterator>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace kalshi {
@@ -35,9 +39,28 @@ struct PaginatedResponse {
 	}
 };
 
+/// Split page fetch for ``PaginatedIterator``'s pipelined mode.
+///
+/// The next page's cursor is known as soon as a response body arrives,
+/// long before its items are parsed. Splitting the fetch into a
+/// non-blocking request, a cheap cursor scan and the full parse lets
+/// page N+1 be on the wire while page N is being parsed.
+template <typename T>
+struct PipelinedFetch {
+	/// Start the request for one page; must not wait for the response
+	/// (e.g. ``HttpClient::request_async``).
+	std::function<std::future<Result<HttpResponse>>(const PaginationParams&)> request;
+	/// Extract the next-page cursor from a raw response (empty/none = last page)
+	std::function<std::optional<Cursor>(const HttpResponse&)> cursor;
+	/// Parse one page, appending its items to ``out``
+	std::function<Result<void>(const HttpResponse&, std::vector<T>& out)> parse;
+};
+
 /// Iterator for paginated results
 ///
-/// Automatically fetches next pages as needed.
+/// Automatically fetches next pages as needed. Constructed from a
+/// ``PipelinedFetch``, ``fetch_all`` keeps one page request in flight
+/// while the previous page is parsed.
 template <typename T>
 class PaginatedIterator {
 public:
@@ -46,6 +69,11 @@ public:
 	PaginatedIterator(FetchFunction fetch, std::int32_t page_size = 100)
 		: fetch_(std::move(fetch)), page_size_(page_size) {}
 
+	/// Pipelined iterator. ``next_page`` still fetches one page at a
+	/// time; ``fetch_all`` / ``fetch_all_into`` overlap requests and parsing.
+	PaginatedIterator(PipelinedFetch<T> pipeline, std::int32_t page_size = 100)
+		: pipeline_(std::move(pipeline)), page_size_(page_size) {}
+
 	/// Fetch the next page of results
 	[[nodiscard]] Result<std::vector<T>> next_page() {
 		PaginationParams params;
@@ -54,6 +82,20 @@ public:
 			params.cursor = current_cursor_;
 		}
 
+		if (pipeline_) {
+			Result<HttpResponse> response = await_page(pipeline_->request(params));
+			if (!response) {
+				return std::unexpected(response.error());
+			}
+			std::vector<T> items;
+			advance(pipeline_->cursor(*response));
+			Result<void> parsed = pipeline_->parse(*response, items);
+			if (!parsed) {
+				return std::unexpected(parsed.error());
+			}
+			return items;
+		}
+
 		Result<PaginatedResponse<T>> result = fetch_(params);
 		if (!result) {
 			return std::unexpected(result.error());
@@ -67,24 +109,93 @@ public:
 	/// Check if there are more pages
 	[[nodiscard]] bool has_more() const noexcept { return has_more_; }
 
-	/// Fetch all remaining results (use with caution for large datasets)
-	[[nodiscard]] Result<std::vector<T>> fetch_all() {
+	/// Fetch all remaining results (use with caution for large datasets).
+	/// ``expected_items`` pre-sizes the output when the total is roughly known.
+	[[nodiscard]] Result<std::vector<T>> fetch_all(std::size_t expected_items = 0) {
 		std::vector<T> all_items;
+		all_items.reserve(expected_items);
+		Result<void> fetched = fetch_all_into(all_items);
+		if (!fetched) {
+			return std::unexpected(fetched.error());
+		}
+		return all_items;
+	}
 
+	/// Append all remaining results to ``out`` (reserve it first to avoid
+	/// regrowth). On error ``out`` keeps the pages fetched so far.
+	[[nodiscard]] Result<void> fetch_all_into(std::vector<T>& out) {
+		if (pipeline_) {
+			return fetch_all_pipelined(out);
+		}
 		do {
 			Result<std::vector<T>> page = next_page();
 			if (!page) {
 				return std::unexpected(page.error());
 			}
-			all_items.insert(all_items.end(), std::make_move_iterator(page->begin()),
-							 std::make_move_iterator(page->end()));
+			if (out.empty() && out.capacity() < page->size()) {
+				out = std::move(*page);
+			} else {
+				out.insert(out.end(), std::make_move_iterator(page->begin()),
+						   std::make_move_iterator(page->end()));
+			}
 		} while (has_more_);
-
-		return all_items;
+		return {};
 	}
 
 private:
+	[[nodiscard]] PaginationParams params_for(const std::optional<Cursor>& cursor) const {
+		PaginationParams params;
+		params.limit = page_size_;
+		if (cursor) {
+			params.cursor = cursor;
+		}
+		return params;
+	}
+
+	void advance(std::optional<Cursor> next) {
+		has_more_ = next.has_value() && !next->empty();
+		current_cursor_ = std::move(next);
+	}
+
+	// Wait for a page and reject non-2xx statuses, which the parse step
+	// would otherwise read as an empty last page.
+	[[nodiscard]] static Result<HttpResponse>
+	await_page(std::future<Result<HttpResponse>> pending) {
+		Result<HttpResponse> response = pending.get();
+		if (response && (response->status_code < 200 || response->status_code >= 300)) {
+			return std::unexpected(
+				Error{ErrorCode::ServerError,
+					  "Failed to fetch page: " + std::to_string(response->status_code),
+					  response->status_code});
+		}
+		return response;
+	}
+
+	[[nodiscard]] Result<void> fetch_all_pipelined(std::vector<T>& out) {
+		std::future<Result<HttpResponse>> in_flight =
+			pipeline_->request(params_for(current_cursor_));
+		for (;;) {
+			Result<HttpResponse> response = await_page(std::move(in_flight));
+			if (!response) {
+				return std::unexpected(response.error());
+			}
+			advance(pipeline_->cursor(*response));
+			if (has_more_) {
+				// Issue page N+1 before parsing page N.
+				in_flight = pipeline_->request(params_for(current_cursor_));
+			}
+			Result<void> parsed = pipeline_->parse(*response, out);
+			if (!parsed) {
+				return std::unexpected(parsed.error());
+			}
+			if (!has_more_) {
+				return {};
+			}
+		}
+	}
+
 	FetchFunction fetch_;
+	std::optional<PipelinedFetch<T>> pipeline_;
 	std::int32_t page_size_;
 	std::optional<Cursor> current_cursor_;
 	bool has_more_{true};
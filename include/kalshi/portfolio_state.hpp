@@ -0,0 +1,160 @@
+#pragma once
+
+/// @file portfolio_state.hpp
+/// @brief Local positions / resting orders / cash kept current from fills.
+
+#include "kalshi/api.hpp"
+#include "kalshi/error.hpp"
+#include "kalshi/models/market.hpp"
+#include "kalshi/models/order.hpp"
+#include "kalshi/ticker_table.hpp"
+#include "kalshi/websocket.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace kalshi {
+
+/// ``PortfolioState`` configuration
+struct PortfolioStateConfig {
+	/// Background REST reconciliation period; zero disables the thread
+	/// (call ``reconcile`` yourself).
+	std::chrono::milliseconds reconcile_interval{std::chrono::seconds{30}};
+	/// Page size for the reconciliation ``get_positions`` / ``get_orders``
+	std::int32_t page_limit{1000};
+	/// Markets tracked, indexed by ``TickerId``; fills for ids past this
+	/// are counted in ``PortfolioStats::dropped`` and otherwise ignored.
+	std::size_t max_markets{8192};
+	/// Interning table for tickers. Share the WebSocket client's so
+	/// ``WsFill::ticker_id`` can be used directly; when null, the
+	/// ``KalshiClient``'s table is used, else a private one.
+	std::shared_ptr<TickerTable> tickers;
+};
+
+/// One market's exposure as of the last applied fill, ack or reconcile
+struct MarketExposure {
+	/// Net YES contracts; negative when holding NO (``Position::yes_contracts``)
+	std::int32_t position{0};
+	/// Resting contracts that would add YES exposure (buy YES / sell NO)
+	std::int32_t resting_yes{0};
+	/// Resting contracts that would add NO exposure (buy NO / sell YES)
+	std::int32_t resting_no{0};
+	/// Bumped on every change; 0 means never touched
+	std::uint32_t version{0};
+
+	/// YES exposure if every resting YES-side order filled
+	[[nodiscard]] constexpr std::int32_t max_yes() const noexcept {
+		return position + resting_yes;
+	}
+	/// NO exposure if every resting NO-side order filled
+	[[nodiscard]] constexpr std::int32_t max_no() const noexcept { return resting_no - position; }
+};
+
+/// REST view installed by ``PortfolioState::reset``
+struct PortfolioSnapshot {
+	Balance balance;
+	std::vector<Position> positions;
+	/// Resting orders; entries with ``remaining_count == 0`` are ignored
+	std::vector<Order> orders;
+};
+
+/// Counters since construction
+struct PortfolioStats {
+	std::uint64_t fills{0};			  ///< ``on_fill`` calls applied
+	std::uint64_t orders{0};		  ///< ``on_order`` calls applied
+	std::uint64_t reconciles{0};	  ///< Snapshots installed
+	std::uint64_t reconcile_errors{0}; ///< Background reconciles that failed
+	/// Markets whose incremental position disagreed with a snapshot
+	std::uint64_t corrections{0};
+	std::uint64_t dropped{0}; ///< Updates for markets past ``max_markets``
+};
+
+/// Positions, resting quantities and cash for one account, kept current
+/// without polling.
+///
+/// ``create`` seeds the state from ``get_balance`` / ``get_positions`` /
+/// ``get_orders``. After that, feed it every ``WsFill`` from the ``fill``
+/// channel and every ``Order`` the exchange returns for your own
+/// create / amend / decrease / cancel calls. Fills move the position
+/// (by ``derive_outcome_side``), the cash and the filled order's resting
+/// quantity; order acks set resting quantities. A background thread
+/// re-reads REST every ``reconcile_interval`` as a backstop for missed
+/// messages and for fees, which fills do not carry.
+///
+/// Reads are lock-free: each market is a seqlock-protected slot indexed
+/// by ``TickerId``, so ``exposure(TickerId)`` is a few relaxed loads and
+/// a pre-trade check never waits on a writer or the network. Writers
+/// (the fill, ack and reconcile threads) serialize on an internal mutex.
+///
+/// A market that takes a fill while a reconcile is in flight keeps its
+/// incremental value; the next pass checks it.
+class PortfolioState {
+public:
+	/// Seed from REST and start background reconciliation. ``client``
+	/// must outlive the state.
+	[[nodiscard]] static Result<PortfolioState> create(KalshiClient& client,
+													   PortfolioStateConfig config = {});
+
+	/// Seed from ``seed`` instead of REST (e.g. a ``WarmState`` whose
+	/// portfolio is still current) and start background reconciliation.
+	/// ``client`` must outlive the state.
+	[[nodiscard]] static PortfolioState resume(KalshiClient& client, const PortfolioSnapshot& seed,
+											   PortfolioStateConfig config = {});
+
+	/// Empty state with no client, fed through ``reset`` / ``on_fill`` /
+	/// ``on_order``. ``reconcile`` fails.
+	explicit PortfolioState(PortfolioStateConfig config = {});
+	~PortfolioState();
+
+	PortfolioState(PortfolioState&&) noexcept;
+	PortfolioState& operator=(PortfolioState&&) noexcept;
+
+	PortfolioState(const PortfolioState&) = delete;
+	PortfolioState& operator=(const PortfolioState&) = delete;
+
+	/// Apply one of our fills. Call from the WebSocket callback.
+	void on_fill(const WsFill& fill);
+
+	/// Apply an order as acknowledged by the exchange (create / amend /
+	/// decrease / cancel response, or a ``get_order`` read). Sets the
+	/// order's resting quantity to what is left after every fill seen
+	/// so far; a cancelled or filled order stops resting.
+	void on_order(const Order& order);
+
+	/// Replace everything with a REST snapshot
+	void reset(const PortfolioSnapshot& snapshot);
+
+	/// Fetch a snapshot now and install it
+	Result<void> reconcile();
+
+	/// The current state in ``reset``'s form: cash as ``balance.balance``,
+	/// one ``Position`` per market with contracts, one ``Order`` per
+	/// resting order (``remaining_count`` is what still rests; ``side`` /
+	/// ``action`` give its exposure). ``reset`` of the result reproduces
+	/// every ``exposure``.
+	[[nodiscard]] PortfolioSnapshot snapshot() const;
+
+	/// Lock-free read of one market
+	[[nodiscard]] MarketExposure exposure(TickerId id) const noexcept;
+	/// By ticker; adds a ``TickerTable`` lookup. Nullopt for a ticker
+	/// never seen.
+	[[nodiscard]] std::optional<MarketExposure> exposure(std::string_view ticker) const;
+
+	/// Cash in cents: the last ``Balance::balance`` plus fills since
+	[[nodiscard]] std::int64_t cash_cents() const noexcept;
+
+	[[nodiscard]] PortfolioStats stats() const noexcept;
+
+	[[nodiscard]] const std::shared_ptr<TickerTable>& ticker_table() const noexcept;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
@@ -2,42 +2,93 @@
 
 #include "kalshi/error.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
-#include <mutex>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 namespace kalshi {
 
+/// Token-bucket budget for one Kalshi API rate-limit bucket.
+struct AccountRateLimitBucket {
+	std::int64_t refill_rate{0};
+	std::int64_t bucket_capacity{0};
+};
+
+/// Authenticated account API usage tier and read/write token budgets.
+struct AccountApiLimits {
+	std::string usage_tier;
+	AccountRateLimitBucket read;
+	AccountRateLimitBucket write;
+};
+
+/// Non-default token cost for one API endpoint.
+struct EndpointCost {
+	std::string method;
+	std::string path;
+	std::int64_t cost{0};
+};
+
+/// Account-level endpoint cost metadata.
+struct EndpointCosts {
+	std::int64_t default_cost{0};
+	std::vector<EndpointCost> endpoint_costs;
+};
+
 /// Token bucket rate limiter
 ///
-/// Implements a token bucket algorithm to limit request rates.
+/// Implements a token bucket as a generic cell rate algorithm: the only
+/// state is the theoretical time at which the bucket is full again,
+/// advanced with a compare-and-swap. Acquisition never takes a lock and
+/// refill is continuous rather than stepped.
 /// Thread-safe for concurrent access.
 class RateLimiter {
 public:
 	/// Configuration for rate limiting
 	struct Config {
-		std::uint16_t max_tokens = 10;					   ///< Maximum tokens (0-65535)
-		std::chrono::milliseconds refill_interval{1000};   // Time to add one token
-		std::uint16_t initial_tokens = 10;				   ///< Starting tokens (0-65535)
-		std::optional<std::chrono::milliseconds> max_wait; // Max time to wait
+		std::uint32_t max_tokens = 10;					   ///< Bucket capacity
+		/// Time to add one token; zero means unlimited
+		std::chrono::nanoseconds refill_interval{std::chrono::seconds{1}};
+		std::uint32_t initial_tokens = 10;				   ///< Starting tokens
+		std::optional<std::chrono::milliseconds> max_wait; ///< Max time to wait
+
+		/// Bucket refilling ``bucket.refill_rate`` tokens per second, full
+		/// at start. A zero rate yields an unlimited bucket; a zero
+		/// capacity allows one second of refill.
+		[[nodiscard]] static Config from_bucket(const AccountRateLimitBucket& bucket);
 	};
 
 	explicit RateLimiter(Config config);
 
-	/// Try to acquire a token, returns true if successful
-	[[nodiscard]] bool try_acquire() noexcept;
+	RateLimiter(const RateLimiter&) = delete;
+	RateLimiter& operator=(const RateLimiter&) = delete;
+
+	/// Try to take ``cost`` tokens, returns true if successful
+	[[nodiscard]] bool try_acquire(std::uint32_t cost = 1) noexcept;
+
+	/// Take ``cost`` tokens, blocking if necessary
+	/// Returns false if max_wait exceeded or ``cost`` exceeds the capacity
+	[[nodiscard]] bool acquire(std::uint32_t cost = 1);
+
+	/// Take ``cost`` tokens, blocking up to max_wait
+	[[nodiscard]] bool acquire_for(std::chrono::milliseconds max_wait, std::uint32_t cost = 1);
 
-	/// Acquire a token, blocking if necessary
-	/// Returns false if max_wait exceeded
-	[[nodiscard]] bool acquire();
+	/// Take ``cost`` tokens now without blocking, going into debt if the
+	/// bucket is short, and return how long to wait before using them;
+	/// later callers queue behind the debt. Nullopt (nothing taken) when
+	/// that wait would exceed max_wait or ``cost`` exceeds the capacity.
+	[[nodiscard]] std::optional<std::chrono::nanoseconds> reserve(std::uint32_t cost = 1) noexcept;
 
-	/// Acquire a token, blocking up to max_wait
-	[[nodiscard]] bool acquire_for(std::chrono::milliseconds max_wait);
+	/// Time until ``cost`` tokens are available (zero if they are now)
+	[[nodiscard]] std::chrono::nanoseconds
+	time_until_available(std::uint32_t cost = 1) const noexcept;
 
 	/// Get current number of available tokens
-	[[nodiscard]] std::uint16_t available_tokens() const noexcept;
+	[[nodiscard]] std::uint32_t available_tokens() const noexcept;
 
 	/// Reset the rate limiter to initial state
 	void reset() noexcept;
@@ -46,12 +97,60 @@ public:
 	[[nodiscard]] const Config& config() const noexcept;
 
 private:
-	void refill() noexcept;
-
 	Config config_;
-	mutable std::mutex mutex_;
-	std::uint16_t tokens_;
-	std::chrono::steady_clock::time_point last_refill_;
+	std::int64_t interval_ns_;
+	std::int64_t capacity_ns_; // max_tokens * interval
+	// Steady-clock nanoseconds at which the bucket is full again.
+	std::atomic<std::int64_t> full_at_ns_;
+};
+
+/// Read/write token buckets charged per endpoint, matching Kalshi's
+/// account limits.
+///
+/// ``GET`` requests draw from the read bucket, every other method from
+/// the write bucket. A request costs the matching ``EndpointCosts`` row,
+/// else ``default_cost`` (1 when that is 0). Path templates such as
+/// ``/portfolio/orders/{order_id}`` match any single segment in the
+/// brace position; query strings and a leading ``/trade-api/v2`` are
+/// ignored. Thread-safe.
+class EndpointRateLimiter {
+public:
+	EndpointRateLimiter(const AccountApiLimits& limits, const EndpointCosts& costs,
+						std::optional<std::chrono::milliseconds> max_wait = std::nullopt);
+
+	EndpointRateLimiter(const EndpointRateLimiter&) = delete;
+	EndpointRateLimiter& operator=(const EndpointRateLimiter&) = delete;
+
+	/// Tokens one ``method`` ``path`` request costs
+	[[nodiscard]] std::uint32_t cost(std::string_view method, std::string_view path) const noexcept;
+
+	/// Take the request's cost from its bucket without waiting
+	[[nodiscard]] bool try_acquire(std::string_view method, std::string_view path) noexcept;
+
+	/// Take the request's cost, waiting up to ``max_wait`` (forever if unset)
+	[[nodiscard]] bool acquire(std::string_view method, std::string_view path);
+
+	/// ``RateLimiter::reserve`` the request's cost from its bucket
+	[[nodiscard]] std::optional<std::chrono::nanoseconds> reserve(std::string_view method,
+																  std::string_view path) noexcept;
+
+	/// Bucket ``method`` draws from
+	[[nodiscard]] RateLimiter& bucket_for(std::string_view method) noexcept;
+
+	[[nodiscard]] RateLimiter& read() noexcept;
+	[[nodiscard]] RateLimiter& write() noexcept;
+
+private:
+	struct Rule {
+		std::string method;
+		std::string path; // leading "/trade-api/v2" stripped
+		std::uint32_t cost;
+	};
+
+	RateLimiter read_;
+	RateLimiter write_;
+	std::uint32_t default_cost_;
+	std::vector<Rule> rules_;
 };
 
 /// Scoped rate limit acquisition
@@ -59,7 +158,7 @@ private:
 /// RAII wrapper that acquires a rate limit token on construction.
 class ScopedRateLimit {
 public:
-	explicit ScopedRateLimit(RateLimiter& limiter);
+	explicit ScopedRateLimit(RateLimiter& limiter, std::uint32_t cost = 1);
 
 	/// Check if acquisition was successful
 	[[nodiscard]] bool acquired() const noexcept;
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "kalshi/error.hpp"
+#include "kalshi/http_client.hpp"
+#include "kalshi/rate_limit.hpp"
+#include "kalshi/retry.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace kalshi {
+
+/// Priority lane of a scheduled request, highest first.
+enum class RequestLane : std::uint8_t {
+	Cancel, ///< Cancels, amends and decreases: being late here costs the most
+	Create, ///< New orders and other non-GET writes
+	Read,	///< Read-only polling; may be coalesced or shed
+};
+
+inline constexpr std::size_t REQUEST_LANE_COUNT = 3;
+
+/// Lane a request lands in when none is given: ``DELETE`` and the
+/// ``/amend`` / ``/decrease`` endpoints go to ``Cancel``, other writes to
+/// ``Create``, ``GET`` to ``Read``.
+[[nodiscard]] RequestLane default_lane(HttpMethod method, std::string_view path) noexcept;
+
+/// Scheduler configuration
+struct SchedulerConfig {
+	/// Queued reads beyond this shed the oldest one
+	std::size_t max_queued_reads{256};
+	/// Reads still queued after this long are shed instead of sent
+	std::chrono::milliseconds max_read_age{2000};
+	/// A ``GET`` for a path already queued joins that request and shares
+	/// its response instead of spending tokens again
+	bool coalesce_reads{true};
+	/// 429 / 5xx / network failures are re-queued at the front of their
+	/// lane after the policy's backoff instead of sleeping a thread
+	RetryPolicy retry{};
+};
+
+/// Counters since construction, plus current queue depths.
+struct SchedulerStats {
+	std::array<std::size_t, REQUEST_LANE_COUNT> queued{};
+	std::uint64_t dispatched{0};
+	std::uint64_t coalesced{0};
+	std::uint64_t shed{0};
+	std::uint64_t retried{0};
+};
+
+/// Rate-limit-aware request scheduler with priority lanes.
+///
+/// Requests are queued per ``RequestLane`` and a dispatcher thread sends
+/// them through ``HttpClient::request_async`` as the ``EndpointRateLimiter``
+/// budget allows. A lane is always served before the lanes below it that
+/// draw on the same bucket, so a burst of polls can never hold a cancel
+/// back; reads use the read bucket and keep flowing while writes wait.
+/// When reads back up they are coalesced and, past ``max_queued_reads``
+/// or ``max_read_age``, shed with ``ErrorCode::RateLimited``.
+///
+/// The scheduler charges ``limiter`` itself and sends its requests past
+/// the client's own limiter, so none is charged twice; requests made on
+/// the client directly are still limited as before. A null limiter means
+/// no budget of the scheduler's own, only ordering, and its requests are
+/// charged against the client's limiter like any other. Callbacks run on
+/// the HTTP event-loop thread (or on the dispatcher thread for shed
+/// requests) and must not block. The client must outlive the scheduler;
+/// requests still queued at destruction complete with a network error.
+class RequestScheduler {
+public:
+	RequestScheduler(HttpClient& client, std::shared_ptr<EndpointRateLimiter> limiter,
+					 SchedulerConfig config = {});
+	~RequestScheduler();
+
+	RequestScheduler(RequestScheduler&&) noexcept;
+	RequestScheduler& operator=(RequestScheduler&&) noexcept;
+
+	RequestScheduler(const RequestScheduler&) = delete;
+	RequestScheduler& operator=(const RequestScheduler&) = delete;
+
+	/// Queue a request in its ``default_lane``
+	void submit(HttpMethod method, std::string path, std::string body, HttpCallback callback);
+
+	/// Queue a request in ``lane``
+	void submit(RequestLane lane, HttpMethod method, std::string path, std::string body,
+				HttpCallback callback);
+
+	/// Future-returning variant of ``submit``
+	[[nodiscard]] std::future<Result<HttpResponse>>
+	submit(HttpMethod method, std::string path, std::string body = {});
+
+	[[nodiscard]] SchedulerStats stats() const;
+
+private:
+	struct Impl;
+	std::shared_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
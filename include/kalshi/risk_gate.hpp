@@ -0,0 +1,160 @@
+#pragma once
+
+/// @file risk_gate.hpp
+/// @brief Pre-trade limits checked before an order is rendered or signed.
+
+#include "kalshi/api.hpp"
+#include "kalshi/error.hpp"
+#include "kalshi/models/order.hpp"
+#include "kalshi/models/price.hpp"
+#include "kalshi/orderbook_book.hpp"
+#include "kalshi/portfolio_state.hpp"
+#include "kalshi/ticker_table.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace kalshi {
+
+/// One market's (or series') limits. Zero disables a limit.
+struct RiskLimits {
+	/// Largest ``count`` per order
+	std::int32_t max_order_contracts{0};
+	/// Largest cost per order, in cents: ``count`` times the price paid per
+	/// contract (the YES price for YES exposure, else the NO price)
+	std::int64_t max_order_notional_cents{0};
+	/// Largest exposure per side once every resting order and this one
+	/// fill (``MarketExposure::max_yes`` / ``max_no``). Needs a
+	/// ``PortfolioState``.
+	std::int32_t max_position{0};
+	/// Fat-finger band: reject a bid above the best ask, or an ask below
+	/// the best bid, by more than this. Needs ``on_book`` / ``on_quote``.
+	Price max_price_through{};
+	/// Reject an order that would trade against one of our own resting
+	/// orders (fed through ``on_order``)
+	bool reject_self_cross{true};
+	/// Reduce ``count`` to fit the size, notional and position limits
+	/// instead of rejecting
+	bool clip{true};
+};
+
+/// Why a check rejected or clipped
+enum class RiskReason : std::uint8_t {
+	None,
+	Halted,			///< ``set_halted(true)``
+	OrderSize,		///< ``max_order_contracts``
+	Notional,		///< ``max_order_notional_cents``
+	Position,		///< ``max_position``
+	PriceThrough,	///< ``max_price_through``
+	SelfCross,		///< ``reject_self_cross``
+	NoPrice,		///< Limit order without a price
+	TooManyMarkets, ///< Ticker id past ``RiskGateConfig::max_markets``
+};
+
+/// Human-readable name for a reason
+[[nodiscard]] std::string_view to_string(RiskReason reason) noexcept;
+
+/// Outcome of ``RiskGate::check``
+struct RiskDecision {
+	enum class Verdict : std::uint8_t { Accept, Clip, Reject };
+
+	Verdict verdict{Verdict::Accept};
+	RiskReason reason{RiskReason::None};
+	/// Contracts allowed; below the requested ``count`` on ``Clip``, 0 on
+	/// ``Reject``
+	std::int32_t count{0};
+
+	[[nodiscard]] constexpr bool accepted() const noexcept { return verdict != Verdict::Reject; }
+};
+
+/// ``RiskGate`` configuration
+struct RiskGateConfig {
+	/// Limits for markets with no ticker or series entry
+	RiskLimits defaults{};
+	/// Markets tracked, indexed by ``TickerId``. Orders for ids past this
+	/// are rejected with ``RiskReason::TooManyMarkets``.
+	std::size_t max_markets{8192};
+	/// Distinct limit sets ``set_limits`` / ``set_series_limits`` may
+	/// install over the gate's lifetime
+	std::size_t max_profiles{1024};
+	/// Source of positions and resting quantities for ``max_position``;
+	/// null skips that check
+	std::shared_ptr<const PortfolioState> portfolio;
+	/// Interning table; defaults to the portfolio's, else a private one.
+	/// Share it with the book feed so ``on_book`` ids match.
+	std::shared_ptr<TickerTable> tickers;
+};
+
+/// Gate counters
+struct RiskGateStats {
+	std::uint64_t checked{0};
+	std::uint64_t clipped{0};
+	std::uint64_t rejected{0};
+};
+
+/// Pre-trade risk checks that run before any serialization or signing.
+///
+/// Attach one with ``KalshiClient::set_risk_gate`` and every
+/// ``create_order`` / ``batch_create_orders`` (blocking or async) is
+/// checked first: a rejection fails the call with
+/// ``ErrorCode::RiskRejected`` before the body is rendered or the RSA
+/// signature computed, and a clip sends the reduced ``count``.
+///
+/// Limits come from, in order, ``set_limits`` for the ticker,
+/// ``set_series_limits`` for its series (the ticker's prefix before the
+/// first ``-``), or ``RiskGateConfig::defaults``. Per-market state lives
+/// in flat arrays indexed by ``TickerId``: after a market's first order
+/// a check is one ``TickerTable::find``, a handful of relaxed atomic loads
+/// and some arithmetic, with no lock and no allocation.
+///
+/// Feed it top of book with ``on_book`` / ``on_quote`` (from the L2 feed)
+/// and our own resting orders with ``on_order`` (the same acks given to
+/// ``PortfolioState::on_order``). Thread-safe.
+class RiskGate {
+public:
+	explicit RiskGate(RiskGateConfig config = {});
+	~RiskGate();
+
+	RiskGate(const RiskGate&) = delete;
+	RiskGate& operator=(const RiskGate&) = delete;
+
+	/// Limits for one market. Fails when ``max_profiles`` are used up.
+	Result<void> set_limits(std::string_view ticker, const RiskLimits& limits);
+	/// Limits for every market in a series without its own entry
+	Result<void> set_series_limits(std::string_view series_ticker, const RiskLimits& limits);
+
+	/// Reject everything while set (kill switch)
+	void set_halted(bool halted) noexcept;
+	[[nodiscard]] bool halted() const noexcept;
+
+	/// Best YES bid / ask for a market; nullopt clears that side
+	void on_quote(TickerId id, std::optional<Price> best_bid, std::optional<Price> best_ask);
+	/// Top of ``book`` via ``on_quote``. Inline so ``kalshi_api`` does not
+	/// link the WebSocket library that owns ``OrderBookBook``.
+	void on_book(TickerId id, const OrderBookBook& book) {
+		const std::optional<OrderBookEntry> bid = book.best_bid(Side::Yes);
+		const std::optional<OrderBookEntry> ask = book.best_ask(Side::Yes);
+		on_quote(id, bid ? std::optional(bid->price()) : std::nullopt,
+				 ask ? std::optional(ask->price()) : std::nullopt);
+	}
+
+	/// Track one of our orders for the self-cross check; a cancelled or
+	/// filled order (or one with nothing remaining) is dropped.
+	void on_order(const Order& order);
+
+	/// Decide on ``params`` without sending anything
+	[[nodiscard]] RiskDecision check(const CreateOrderParams& params) const;
+
+	[[nodiscard]] RiskGateStats stats() const noexcept;
+
+	[[nodiscard]] const std::shared_ptr<TickerTable>& ticker_table() const noexcept;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "kalshi/error.hpp"
+#include "kalshi/signer.hpp"
+#include "kalshi/ticker_table.hpp"
+#include "kalshi/websocket.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kalshi {
+
+/// Sharded WebSocket client configuration
+struct ShardedWsConfig {
+	/// Settings for every connection. One ``ticker_table`` is shared by
+	/// all shards (created when null), so ``ticker_id`` agrees across them.
+	/// Each shard runs its own service thread, so ``WsServiceMode::External``
+	/// falls back to ``Blocking``.
+	WsConfig connection{};
+	/// Connections, each with its own libwebsockets service thread
+	std::size_t shards{4};
+	/// Split ticker-less subscriptions across the shards with the server's
+	/// ``shard_factor`` / ``shard_key``. When false, shard 0 takes the
+	/// whole firehose.
+	bool server_sharding{true};
+	/// ``rebalance`` acts once the busiest shard is this far above the mean
+	double rebalance_tolerance{0.25};
+	/// Markets ``rebalance`` may move per call
+	std::size_t max_moves_per_rebalance{8};
+	/// CPU for each shard's service thread, by shard index, overriding
+	/// ``connection.service_cpu``; shards past the end keep that value.
+	std::vector<int> service_cpus;
+};
+
+/// Handle for a subscription spread over one or more shards.
+struct ShardedSubscription {
+	std::int32_t id{0};
+	Channel channel{Channel::OrderbookDelta};
+};
+
+/// A market ``rebalance`` moved between shards.
+struct ShardMove {
+	std::string ticker;
+	std::size_t from{0};
+	std::size_t to{0};
+};
+
+/// Callback for one shard's connection state changes
+using ShardStateCallback = std::function<void(std::size_t shard, bool connected)>;
+
+/// Buffer watermark crossing on one shard
+using ShardBackpressureCallback =
+	std::function<void(std::size_t shard, const WsBackpressure& backpressure)>;
+
+/// WebSocket client spread over several connections.
+///
+/// Markets named in a subscription are placed on a shard by a stable hash
+/// of the ticker and stay there across subscriptions, so a market's book
+/// and trades arrive in order on one connection. Ticker-less
+/// subscriptions to ``orderbook_delta`` and ``trade`` are split by the
+/// server (``WsShard``) when ``server_sharding`` is set; fills and
+/// lifecycle events always use shard 0.
+///
+/// The shards' streams merge into one: ``on_message`` / ``on_error`` /
+/// ``on_sequence_gap`` callbacks are serialized across shards, and in
+/// queue mode (``WsConfig::message_queue_capacity`` > 0) ``poll`` drains
+/// every shard's ring round-robin from one consumer thread. Messages are
+/// counted per market as they are delivered; ``rebalance`` uses those
+/// counts to move hot markets off the busiest shard.
+class ShardedWebSocketClient {
+public:
+	ShardedWebSocketClient(const Signer& signer, ShardedWsConfig config = {});
+	~ShardedWebSocketClient();
+
+	ShardedWebSocketClient(ShardedWebSocketClient&&) noexcept;
+	ShardedWebSocketClient& operator=(ShardedWebSocketClient&&) noexcept;
+
+	ShardedWebSocketClient(const ShardedWebSocketClient&) = delete;
+	ShardedWebSocketClient& operator=(const ShardedWebSocketClient&) = delete;
+
+	/// Connect every shard; on failure the shards already connected are
+	/// disconnected again
+	[[nodiscard]] Result<void> connect();
+
+	/// Disconnect every shard
+	void disconnect();
+
+	/// True when every shard is connected
+	[[nodiscard]] bool is_connected() const noexcept;
+
+	/// Number of shards (0 on a moved-from client)
+	[[nodiscard]] std::size_t shard_count() const noexcept;
+
+	/// Shard that carries ``ticker``
+	[[nodiscard]] std::size_t shard_for(std::string_view ticker) const;
+
+	/// Subscribe to orderbook updates; no tickers means the whole firehose
+	[[nodiscard]] Result<ShardedSubscription>
+	subscribe_orderbook(const std::vector<std::string>& market_tickers);
+
+	/// Subscribe to trades (optionally filtered by markets)
+	[[nodiscard]] Result<ShardedSubscription>
+	subscribe_trades(const std::vector<std::string>& market_tickers = {});
+
+	/// Subscribe to fills for the authenticated user (shard 0)
+	[[nodiscard]] Result<ShardedSubscription>
+	subscribe_fills(const std::vector<std::string>& market_tickers = {});
+
+	/// Subscribe to market lifecycle events (shard 0)
+	[[nodiscard]] Result<ShardedSubscription> subscribe_lifecycle();
+
+	/// Unsubscribe on every shard the subscription spans
+	[[nodiscard]] Result<void> unsubscribe(ShardedSubscription sub);
+
+	/// Add markets, each on its own shard
+	[[nodiscard]] Result<void> add_markets(ShardedSubscription sub,
+										   const std::vector<std::string>& market_tickers);
+
+	/// Remove markets from the shards carrying them
+	[[nodiscard]] Result<void> remove_markets(ShardedSubscription sub,
+											  const std::vector<std::string>& market_tickers);
+
+	/// Set callback for messages from every shard
+	void on_message(WsMessageCallback callback);
+
+	/// Set callback for errors from every shard
+	void on_error(WsErrorCallback callback);
+
+	/// Set callback for per-shard connection state changes
+	void on_state_change(ShardStateCallback callback);
+
+	/// Set callback for orderbook sequence gaps from every shard
+	void on_sequence_gap(WsSeqGapCallback callback);
+
+	/// Set callback for per-shard inbound buffer watermark crossings
+	void on_backpressure(ShardBackpressureCallback callback);
+
+	/// Drain up to ``out.size()`` queued messages from all shards (queue
+	/// mode), round-robin so no shard starves the others. Single consumer.
+	[[nodiscard]] std::size_t poll(std::span<WsMessage> out);
+
+	/// Move hot markets off the busiest shard, emptying the per-market
+	/// counters. Markets are added on their new shard before they are
+	/// removed from the old one, so a move may briefly deliver both.
+	[[nodiscard]] std::vector<ShardMove> rebalance();
+
+	/// Messages delivered per shard since the last ``rebalance``
+	[[nodiscard]] std::vector<std::uint64_t> shard_load() const;
+
+	/// Inbound queue counters, one entry per shard (queue mode)
+	[[nodiscard]] std::vector<WsQueueStats> queue_stats() const;
+
+	/// permessage-deflate counters, one entry per shard
+	[[nodiscard]] std::vector<WsCompressionStats> compression_stats() const;
+
+	/// Decode worker counters, one entry per shard
+	[[nodiscard]] std::vector<WsPipelineStats> pipeline_stats() const;
+
+	/// Overflow handling counters, one entry per shard
+	[[nodiscard]] std::vector<WsOverflowStats> overflow_stats() const;
+
+	/// Interning table shared by every shard (null on a moved-from client)
+	[[nodiscard]] std::shared_ptr<TickerTable> ticker_table() const noexcept;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
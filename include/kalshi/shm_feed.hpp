@@ -0,0 +1,191 @@
+#pragma once
+
+/// @file shm_feed.hpp
+/// @brief Shared-memory market data fan-out.
+///
+/// One ``ShmFeedPublisher`` process owns the WebSocket connections and
+/// the L2 books, and publishes into a named POSIX shared-memory segment:
+///
+/// - a broadcast ring of ``WsEvent``s (deltas, trades, fills), each slot
+///   stamped with its event number so readers detect being lapped;
+/// - per-market top-of-book records behind a seqlock;
+/// - the ticker name for every ``TickerId`` the feed has used.
+///
+/// Any number of ``ShmFeedReader``s in other processes map the segment
+/// read-only. Polling events and reading books are plain loads: no
+/// syscalls and no locks, and a slow reader never holds up the publisher
+/// (it loses the events it was lapped on, counted in ``overruns``).
+///
+/// POSIX only (``shm_open``); ``create`` / ``open`` fail elsewhere.
+
+#include "kalshi/error.hpp"
+#include "kalshi/models/market.hpp"
+#include "kalshi/orderbook_book.hpp"
+#include "kalshi/sharded_websocket.hpp"
+#include "kalshi/signer.hpp"
+#include "kalshi/ticker_table.hpp"
+#include "kalshi/websocket.hpp"
+#include "kalshi/ws_event.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace kalshi {
+
+/// Longest ticker a feed segment can name. Each name slot is one cache
+/// line: a 4-byte length, the bytes and a terminating NUL.
+inline constexpr std::size_t kShmMaxTickerName = 59;
+
+/// Shared-memory segment geometry
+struct ShmFeedConfig {
+	/// Segment name for ``shm_open`` (leading ``/``, no other slashes)
+	std::string name{"/kalshi-feed"};
+	/// Event ring slots (rounded up to a power of two). Readers that fall
+	/// further behind than this lose events.
+	std::size_t event_capacity{std::size_t{1} << 16};
+	/// Largest ``TickerId`` value + 1 the segment has book and name slots
+	/// for. Events for markets past it are still published; their books
+	/// and names are not.
+	std::size_t max_markets{8192};
+};
+
+/// Writing side of a feed segment. Creates (replacing any stale one) and
+/// unlinks the segment; one writer thread.
+class ShmFeedWriter {
+public:
+	[[nodiscard]] static Result<ShmFeedWriter> create(ShmFeedConfig config = {});
+
+	~ShmFeedWriter();
+	ShmFeedWriter(ShmFeedWriter&&) noexcept;
+	ShmFeedWriter& operator=(ShmFeedWriter&&) noexcept;
+
+	ShmFeedWriter(const ShmFeedWriter&) = delete;
+	ShmFeedWriter& operator=(const ShmFeedWriter&) = delete;
+
+	/// Make ``ticker``'s name visible to readers under ``id`` (first call
+	/// per id wins; later calls are a load and a compare). Returns false,
+	/// publishing nothing, when ``ticker`` is empty or longer than
+	/// ``kShmMaxTickerName`` or ``id`` is past ``max_markets``; readers
+	/// then see no name for ``id``, though its events and book still flow.
+	bool register_ticker(TickerId id, std::string_view ticker) noexcept;
+
+	/// Append one event to the ring
+	void publish(const WsEvent& event) noexcept;
+
+	/// Publish ``book``'s top of book for ``id``
+	void update_book(TickerId id, const OrderBookBook& book) noexcept;
+
+	/// Events published since creation
+	[[nodiscard]] std::uint64_t published() const noexcept;
+
+	[[nodiscard]] const ShmFeedConfig& config() const noexcept;
+
+private:
+	struct Impl;
+	explicit ShmFeedWriter(std::unique_ptr<Impl> impl);
+	std::unique_ptr<Impl> impl_;
+};
+
+/// Reader counters
+struct ShmFeedReaderStats {
+	std::uint64_t received{0}; ///< Events returned by ``poll``
+	std::uint64_t overruns{0}; ///< Events lost to being lapped by the publisher
+};
+
+/// Read-only attachment to a feed segment from any process.
+class ShmFeedReader {
+public:
+	/// Map the segment ``name``. The reader starts at the newest event;
+	/// ``poll`` returns only events published after ``open``.
+	[[nodiscard]] static Result<ShmFeedReader> open(const std::string& name = "/kalshi-feed");
+
+	~ShmFeedReader();
+	ShmFeedReader(ShmFeedReader&&) noexcept;
+	ShmFeedReader& operator=(ShmFeedReader&&) noexcept;
+
+	ShmFeedReader(const ShmFeedReader&) = delete;
+	ShmFeedReader& operator=(const ShmFeedReader&) = delete;
+
+	/// Copy up to ``out.size()`` events published since the last poll.
+	/// Non-blocking; one thread per reader.
+	[[nodiscard]] std::size_t poll(std::span<WsEvent> out) noexcept;
+
+	/// Skip everything not yet polled
+	void seek_to_latest() noexcept;
+
+	/// Consistent copy of one market's top of book; nullopt for ids the
+	/// publisher has not written
+	[[nodiscard]] std::optional<TopOfBook> top_of_book(TickerId id) const noexcept;
+
+	/// Ticker name for ``id``; empty when unknown. Views stay valid while
+	/// the reader is open.
+	[[nodiscard]] std::string_view ticker_name(TickerId id) const noexcept;
+
+	/// Id for ``ticker``: a scan over the registered names, so resolve
+	/// once and keep the id
+	[[nodiscard]] std::optional<TickerId> find(std::string_view ticker) const noexcept;
+
+	/// False once the publisher has shut down
+	[[nodiscard]] bool publisher_alive() const noexcept;
+
+	[[nodiscard]] ShmFeedReaderStats stats() const noexcept;
+
+private:
+	struct Impl;
+	explicit ShmFeedReader(std::unique_ptr<Impl> impl);
+	std::unique_ptr<Impl> impl_;
+};
+
+/// Publisher configuration
+struct ShmFeedPublisherConfig {
+	/// Connections feeding the segment. Inline callbacks are required, so
+	/// ``connection.message_queue_capacity`` is forced to 0.
+	ShardedWsConfig ws{};
+	ShmFeedConfig feed{};
+};
+
+/// Owns a ``ShardedWebSocketClient``, one ``OrderBookBook`` per market and
+/// a ``ShmFeedWriter``: every delta, trade and fill goes into the ring,
+/// and every snapshot or delta republishes that market's top of book.
+/// Books are checked ``SeqCheck::Monotonic``; the client's per-sid gap
+/// handling invalidates and resyncs them.
+///
+/// Subscribe and connect through ``client()``. Its ``on_message`` and
+/// ``on_sequence_gap`` callbacks belong to the publisher; use the
+/// publisher's ``on_message`` to see messages locally as well.
+class ShmFeedPublisher {
+public:
+	[[nodiscard]] static Result<ShmFeedPublisher> create(const Signer& signer,
+														 ShmFeedPublisherConfig config = {});
+
+	~ShmFeedPublisher();
+	ShmFeedPublisher(ShmFeedPublisher&&) noexcept;
+	ShmFeedPublisher& operator=(ShmFeedPublisher&&) noexcept;
+
+	ShmFeedPublisher(const ShmFeedPublisher&) = delete;
+	ShmFeedPublisher& operator=(const ShmFeedPublisher&) = delete;
+
+	/// The connections; subscribe and connect here
+	[[nodiscard]] ShardedWebSocketClient& client() noexcept;
+
+	/// Also deliver every message to ``callback`` (after publishing)
+	void on_message(WsMessageCallback callback);
+
+	/// Publish one message as if it had arrived on the connections, e.g.
+	/// from a ``ReplayClient``. Not while the client is connected.
+	void publish(const WsMessage& message);
+
+	[[nodiscard]] const ShmFeedWriter& writer() const noexcept;
+
+private:
+	struct Impl;
+	explicit ShmFeedPublisher(std::unique_ptr<Impl> impl);
+	std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
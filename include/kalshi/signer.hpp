@@ -3,8 +3,10 @@
 #include "kalshi/error.hpp"
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -17,12 +19,27 @@ struct AuthHeaders {
 	std::string timestamp;
 };
 
+/// Length of the padded base64 encoding of ``size`` bytes
+[[nodiscard]] constexpr std::size_t base64_encoded_size(std::size_t size) noexcept {
+	return (size + 2) / 3 * 4;
+}
+
+/// Standard padded base64 (RFC 4648, no line breaks) of ``data`` written
+/// into ``out``. Returns the number of characters written, or 0 when
+/// ``out`` is smaller than ``base64_encoded_size(data.size())``.
+std::size_t base64_encode(std::span<const unsigned char> data, std::span<char> out) noexcept;
+
 /// RSA-PSS signer for Kalshi API authentication
 ///
 /// Creates signatures compatible with Kalshi's authentication scheme:
 /// - Message format: {timestamp}{method}{path}
 /// - Algorithm: RSA-PSS with SHA-256
 /// - Salt length: same as digest (32 bytes)
+///
+/// The digest / padding setup is done once at construction. Each
+/// signature copies that prototype into a context cached per thread, so
+/// signing allocates nothing beyond the returned strings. Safe to call
+/// concurrently from multiple threads.
 class Signer {
 public:
 	/// Create a signer from a PEM-encoded RSA private key
@@ -49,6 +66,16 @@ public:
 														  std::string_view path,
 														  std::int64_t timestamp_ms) const;
 
+	/// Sign into ``out``, reusing its string buffers. Keep one
+	/// ``AuthHeaders`` per thread and pass it back in to sign without
+	/// allocating once the buffers have grown.
+	[[nodiscard]] Result<void> sign_into(std::string_view method, std::string_view path,
+										 std::int64_t timestamp_ms, AuthHeaders& out) const;
+
+	/// ``sign_into`` stamped with the current time
+	[[nodiscard]] Result<void> sign_into(std::string_view method, std::string_view path,
+										 AuthHeaders& out) const;
+
 	/// Get the API key ID
 	[[nodiscard]] std::string_view api_key_id() const noexcept;
 
@@ -59,4 +86,41 @@ private:
 	explicit Signer(std::unique_ptr<Impl> impl);
 };
 
+/// Pre-signed headers for one fixed request, typically the WebSocket
+/// handshake (``GET /trade-api/ws/v2``), so a (re)connect does not pay
+/// for an RSA-PSS signature.
+///
+/// ``refill`` signs ahead, off the hot path. ``take`` hands out the
+/// newest entry younger than ``max_age`` and signs on demand when the
+/// pool has nothing fresh. The signer must outlive the pool. Thread-safe.
+class PresignedHeaderPool {
+public:
+	PresignedHeaderPool(const Signer& signer, std::string method, std::string path,
+						std::size_t capacity = 4,
+						std::chrono::milliseconds max_age = std::chrono::seconds{5});
+
+	~PresignedHeaderPool();
+	PresignedHeaderPool(PresignedHeaderPool&&) noexcept;
+	PresignedHeaderPool& operator=(PresignedHeaderPool&&) noexcept;
+
+	PresignedHeaderPool(const PresignedHeaderPool&) = delete;
+	PresignedHeaderPool& operator=(const PresignedHeaderPool&) = delete;
+
+	/// Drop stale entries and sign new ones until the pool holds ``capacity``
+	[[nodiscard]] Result<void> refill();
+
+	/// Newest fresh entry, or a freshly signed one when none is left
+	[[nodiscard]] Result<AuthHeaders> take();
+
+	/// Entries currently held (fresh or not)
+	[[nodiscard]] std::size_t size() const;
+
+	[[nodiscard]] std::string_view method() const noexcept;
+	[[nodiscard]] std::string_view path() const noexcept;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl_;
+};
+
 } // namespace kalshi
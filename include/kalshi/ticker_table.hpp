@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace kalshi {
+
+/// Dense id for an interned market ticker.
+///
+/// Ids are assigned 0, 1, 2, ... in first-seen order and never reused,
+/// so consumers can keep per-market state in a plain
+/// ``std::vector`` indexed by ``value`` instead of hashing the ticker
+/// string on every message.
+struct TickerId {
+	static constexpr std::uint32_t kInvalid = 0xFFFFFFFFU;
+
+	std::uint32_t value{kInvalid};
+
+	[[nodiscard]] constexpr bool valid() const noexcept { return value != kInvalid; }
+
+	constexpr bool operator==(const TickerId&) const noexcept = default;
+};
+
+/// Thread-safe ticker interning table.
+///
+/// A single table is meant to be shared (via ``std::shared_ptr``)
+/// between ``WebSocketClient`` and ``KalshiClient`` so WS messages and
+/// REST models carry the same ``TickerId`` for the same market. Entries
+/// are never removed: ``name`` returns views that stay valid for the
+/// table's lifetime.
+class TickerTable {
+public:
+	TickerTable() = default;
+
+	TickerTable(const TickerTable&) = delete;
+	TickerTable& operator=(const TickerTable&) = delete;
+
+	/// Return the id for ``ticker``, assigning the next one on first
+	/// sight. Empty tickers are not interned and yield an invalid id.
+	[[nodiscard]] TickerId intern(std::string_view ticker);
+
+	/// Look up an existing id without assigning one.
+	[[nodiscard]] std::optional<TickerId> find(std::string_view ticker) const;
+
+	/// Ticker string for ``id``; empty view for an invalid / unknown id.
+	[[nodiscard]] std::string_view name(TickerId id) const;
+
+	/// Number of interned tickers (one past the largest id).
+	[[nodiscard]] std::size_t size() const;
+
+private:
+	mutable std::shared_mutex mutex_;
+	std::deque<std::string> names_; ///< Indexed by id; deque keeps elements (and views) stable
+	std::unordered_map<std::string_view, std::uint32_t> ids_;
+};
+
+} // namespace kalshi
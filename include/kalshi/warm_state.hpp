@@ -0,0 +1,120 @@
+#pragma once
+
+/// @file warm_state.hpp
+/// @brief Persisted snapshot of markets, metadata, portfolio and books for fast restarts.
+
+#include "kalshi/api.hpp"
+#include "kalshi/error.hpp"
+#include "kalshi/market_table.hpp"
+#include "kalshi/metadata_cache.hpp"
+#include "kalshi/portfolio_state.hpp"
+#include "kalshi/ticker_table.hpp"
+#include "kalshi/websocket.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace kalshi {
+
+/// What ``WarmState::save`` writes; null members are skipped
+struct WarmStateSources {
+	const MarketTable* markets{nullptr};
+	const MetadataCache* metadata{nullptr};
+	const PortfolioState* portfolio{nullptr};
+	/// ``get_user_data_timestamp`` read just before capturing
+	/// ``portfolio``; without it ``portfolio_current`` always says no
+	std::optional<std::int64_t> user_data_timestamp;
+	/// Books to persist: ``OrderBookBook::to_snapshot`` of each valid book
+	std::vector<OrderbookSnapshot> books;
+};
+
+/// A warm-state file, mapped read-only.
+///
+/// A cold start pages through ``get_markets``, reads positions and orders,
+/// and waits for an orderbook snapshot per market before it can trade.
+/// ``save`` writes what those produced to one binary file on shutdown;
+/// ``open`` maps it on the next start and the ``restore`` calls copy it
+/// back, after which only what changed in between needs fetching:
+///
+/// - ``MarketTable`` columns and string pool are stored as flat arrays and
+///   copied back with a few ``memcpy`` calls. ``refresh_markets`` then
+///   asks only for markets whose metadata changed since the snapshot
+///   (``GetMarketsParams::min_updated_ts``); quotes catch up from the
+///   WebSocket.
+/// - ``MetadataCache`` entries come back with what remained of their TTL
+///   less the time the process was down, so nothing is served staler than
+///   a live cache would have served it.
+/// - The portfolio is ``PortfolioState::snapshot``. ``portfolio_current``
+///   compares the exchange's ``get_user_data_timestamp`` with the one
+///   saved; when nothing was recorded since, ``PortfolioState::resume``
+///   seeds from the file and skips the REST round trips.
+/// - Books are stored as ``OrderbookSnapshot`` values carrying their last
+///   ``seq``, giving a usable (if dated) book until the subscription's own
+///   snapshot replaces it.
+///
+/// The file is written beside ``path`` and renamed over it, so a crash
+/// mid-save leaves the previous snapshot intact. Movable, not copyable;
+/// the accessors are safe to call from several threads.
+class WarmState {
+public:
+	/// Write ``sources`` to ``path``, replacing any previous snapshot
+	[[nodiscard]] static Result<void> save(const std::string& path,
+										   const WarmStateSources& sources);
+
+	/// Map ``path``. Fails when it is missing, foreign, of another
+	/// version or truncated.
+	[[nodiscard]] static Result<WarmState> open(const std::string& path);
+
+	~WarmState();
+	WarmState(WarmState&&) noexcept;
+	WarmState& operator=(WarmState&&) noexcept;
+
+	WarmState(const WarmState&) = delete;
+	WarmState& operator=(const WarmState&) = delete;
+
+	/// When ``save`` ran
+	[[nodiscard]] std::chrono::system_clock::time_point saved_at() const noexcept;
+
+	/// ``WarmStateSources::user_data_timestamp`` as saved
+	[[nodiscard]] std::optional<std::int64_t> user_data_timestamp() const noexcept;
+
+	/// Replace ``table``'s contents with the saved markets. With
+	/// ``tickers``, each ticker is interned there so ``find(TickerId)``
+	/// works. Returns the rows restored; 0, leaving ``table`` as it was,
+	/// when no markets were saved.
+	std::size_t restore(MarketTable& table, TickerTable* tickers = nullptr) const;
+
+	/// ``put`` every saved entry still within its TTL. Returns how many.
+	std::size_t restore(MetadataCache& cache) const;
+
+	/// The saved portfolio, if one was saved
+	[[nodiscard]] std::optional<PortfolioSnapshot> portfolio() const;
+
+	/// The saved books, ready for ``OrderBookBook::apply``; ``sid`` is 0
+	/// and ``seq`` the last one the book had applied
+	[[nodiscard]] std::vector<OrderbookSnapshot> books() const;
+
+	/// True when a portfolio was saved and the exchange reports no account
+	/// data recorded after it (``get_user_data_timestamp`` not past the
+	/// saved one), so ``portfolio()`` can seed ``PortfolioState::resume``
+	[[nodiscard]] Result<bool> portfolio_current(KalshiClient& client) const;
+
+	/// Fetch the markets whose metadata changed since ``saved_at`` less
+	/// ``slack`` and ``upsert`` / ``put`` them into ``table`` / ``cache``
+	/// (either may be null). Returns the number received.
+	[[nodiscard]] Result<std::size_t>
+	refresh_markets(KalshiClient& client, MarketTable* table, MetadataCache* cache = nullptr,
+					std::chrono::seconds slack = std::chrono::seconds{60}) const;
+
+private:
+	struct Impl;
+	explicit WarmState(std::unique_ptr<Impl> impl);
+	std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
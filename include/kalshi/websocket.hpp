@@ -1,16 +1,23 @@
 #pragma once
 
 #include "kalshi/error.hpp"
+#include "kalshi/latency_stats.hpp"
 #include "kalshi/models/market.hpp"
+#include "kalshi/retry.hpp"
 #include "kalshi/signer.hpp"
+#include "kalshi/ticker_table.hpp"
+#include "kalshi/ws_event.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -18,6 +25,8 @@
 
 namespace kalshi {
 
+class WsRecorder;
+
 /// WebSocket channels available for subscription
 enum class Channel : std::uint8_t { OrderbookDelta, Trade, Fill, MarketLifecycle };
 
@@ -43,6 +52,38 @@ struct OrderbookSnapshot {
 	std::string market_ticker;
 	std::vector<OrderBookEntry> yes;
 	std::vector<OrderBookEntry> no;
+	/// Interned ``market_ticker``; index per-market state by ``ticker_id.value``
+	TickerId ticker_id;
+	/// Borrowed levels (``WsConfig::borrowed_snapshots``). They point into
+	/// a per-connection buffer that is reused by the next snapshot, so they
+	/// are valid only for the duration of the ``on_message`` call; ``yes``
+	/// / ``no`` are left empty. Read through ``yes_levels`` / ``no_levels``
+	/// to handle both modes.
+	std::span<const OrderBookEntry> yes_view;
+	std::span<const OrderBookEntry> no_view;
+
+	/// YES bids, borrowed or owned.
+	[[nodiscard]] std::span<const OrderBookEntry> yes_levels() const noexcept {
+		return yes_view.empty() ? std::span<const OrderBookEntry>{yes} : yes_view;
+	}
+
+	/// NO bids, borrowed or owned.
+	[[nodiscard]] std::span<const OrderBookEntry> no_levels() const noexcept {
+		return no_view.empty() ? std::span<const OrderBookEntry>{no} : no_view;
+	}
+
+	/// Copy borrowed levels into ``yes`` / ``no`` so the snapshot may
+	/// outlive the callback. No-op for an owning snapshot.
+	void make_owned() {
+		if (!yes_view.empty()) {
+			yes.assign(yes_view.begin(), yes_view.end());
+			yes_view = {};
+		}
+		if (!no_view.empty()) {
+			no.assign(no_view.begin(), no_view.end());
+			no_view = {};
+		}
+	}
 };
 
 /// Orderbook delta message
@@ -53,6 +94,8 @@ struct OrderbookDelta {
 	std::int32_t price{0};
 	std::int32_t delta{0};
 	Side side{Side::Yes};
+	/// Interned ``market_ticker``; index per-market state by ``ticker_id.value``
+	TickerId ticker_id;
 };
 
 /// Trade message from WebSocket
@@ -65,6 +108,8 @@ struct WsTrade {
 	std::int32_t count{0};
 	Side taker_side{Side::Yes};
 	std::int64_t timestamp{0};
+	/// Interned ``market_ticker``; index per-market state by ``ticker_id.value``
+	TickerId ticker_id;
 };
 
 /// Fill message (user's order was filled)
@@ -79,7 +124,14 @@ struct WsFill {
 	std::int32_t no_price{0};
 	std::int32_t count{0};
 	Action action{Action::Buy};
+	/// Exact fill price and size; ``yes_price`` / ``no_price`` / ``count``
+	/// hold them rounded
+	Price yes_price_dollars;
+	Price no_price_dollars;
+	Quantity count_fp;
 	std::int64_t timestamp{0};
+	/// Interned ``market_ticker``; index per-market state by ``ticker_id.value``
+	TickerId ticker_id;
 };
 
 /// Market lifecycle message
@@ -96,6 +148,8 @@ struct MarketLifecycle {
 	/// yes-side subtitle change. Added to the v2 channel 2026-05-11.
 	/// Nullopt when the frame omits the field (most lifecycle frames).
 	std::optional<std::string> yes_sub_title;
+	/// Interned ``market_ticker``; index per-market state by ``ticker_id.value``
+	TickerId ticker_id;
 };
 
 /// Kalshi's `market_lifecycle_v2` channel multiplexes several sub-event
@@ -150,18 +204,52 @@ classify_lifecycle_event(const MarketLifecycle& lc) noexcept {
 /// Union of all possible WebSocket data messages
 using WsMessage = std::variant<OrderbookSnapshot, OrderbookDelta, WsTrade, WsFill, MarketLifecycle>;
 
+/// Compact form of ``msg``; nullopt for snapshots and lifecycle messages,
+/// which keep their rich form. Needs ``msg.ticker_id`` set (the client
+/// always sets it).
+[[nodiscard]] std::optional<WsEvent> to_event(const WsMessage& msg) noexcept;
+
+/// Rich view of ``event``. ``market_ticker`` is filled from ``tickers``
+/// when given; ids are rendered back to their hyphenated form.
+[[nodiscard]] WsMessage to_message(const WsEvent& event, const TickerTable* tickers = nullptr);
+
 /// Subscription ID returned when subscribing
 struct SubscriptionId {
 	std::int32_t sid{0};
 	Channel channel{Channel::OrderbookDelta};
 };
 
+/// Server-side sharding of a subscription (``shard_factor`` /
+/// ``shard_key``): the server delivers only the markets that hash to
+/// shard ``key`` of ``factor``, so ``factor`` connections subscribing with
+/// keys ``0 .. factor-1`` split one firehose between them.
+struct WsShard {
+	std::int32_t factor{1};
+	std::int32_t key{0};
+};
+
 /// WebSocket error
 struct WsError {
 	std::int32_t code{0};
 	std::string message;
 };
 
+/// Sequence gap detected on an orderbook subscription.
+///
+/// ``seq`` is numbered per subscription, so a gap cannot be pinned on a
+/// single market: every market on ``sid`` is suspect. When
+/// ``WsConfig::resync_on_gap`` is set the client re-adds exactly those
+/// markets (``resync_tickers``) to the existing subscription and drops
+/// their deltas until each fresh snapshot arrives. A further gap on
+/// ``sid`` before those snapshots land is still reported, but starts no
+/// second resync.
+struct WsSeqGap {
+	std::int32_t sid{0};
+	std::int32_t expected_seq{0};
+	std::int32_t received_seq{0};
+	std::vector<std::string> resync_tickers; ///< Empty when no resync was started
+};
+
 /// Map a Kalshi WebSocket error code to the canonical name documented at
 /// https://docs.kalshi.com/websockets/websocket-connection#error-messages.
 /// Returns "Unknown error code" for codes outside the documented range.
@@ -230,12 +318,282 @@ using WsErrorCallback = std::function<void(const WsError&)>;
 /// Callback for connection state changes
 using WsStateCallback = std::function<void(bool connected)>;
 
+/// Callback for orderbook sequence gaps
+using WsSeqGapCallback = std::function<void(const WsSeqGap&)>;
+
+/// What an inbound buffer does with a message that does not fit
+/// (``WsConfig::queue_overflow`` / ``decode_overflow``)
+enum class WsOverflowPolicy : std::uint8_t {
+	/// Wait for the consumer. The service thread stops reading, so the
+	/// backlog moves to the socket and then the exchange, which drops a
+	/// subscription that falls too far behind (error 25). Needs the
+	/// consumer on another thread.
+	Block,
+	/// Discard the incoming message
+	DropNewest,
+	/// Discard queued messages, oldest first, until the incoming one fits
+	DropOldest,
+	/// An orderbook message that does not fit is discarded and its market
+	/// re-added to the subscription, so the consumer gets one fresh
+	/// snapshot in place of the backlog of deltas it missed; deltas for the
+	/// market are held back until that snapshot. Other messages are
+	/// discarded as with ``DropNewest``.
+	Conflate,
+	/// Discard everything queued and drop the connection; auto-reconnect
+	/// replays every subscription, which delivers fresh snapshots (with
+	/// ``auto_reconnect`` off the client stays disconnected)
+	Resync,
+};
+
+/// Which inbound buffer a ``WsBackpressure`` report is about
+enum class WsBuffer : std::uint8_t {
+	MessageQueue,  ///< Queue mode's ring (``message_queue_capacity``)
+	DecodeWorkers, ///< The decode workers' rings (``decode_workers``)
+};
+
+/// An inbound buffer crossing ``WsConfig::high_watermark``
+struct WsBackpressure {
+	WsBuffer buffer{WsBuffer::MessageQueue};
+	/// True when it filled past the mark; false once it drained below half
+	/// of it
+	bool high{false};
+	std::size_t depth{0};	 ///< Messages queued
+	std::size_t capacity{0}; ///< Slots
+	std::size_t bytes{0};	 ///< Bytes queued (0 without ``max_queued_bytes``)
+	std::size_t max_bytes{0};
+};
+
+/// Callback for buffer watermark crossings
+using WsBackpressureCallback = std::function<void(const WsBackpressure&)>;
+
+/// Default ``WsConfig::reconnect_backoff``: 100 ms doubling to 5 s, ±20% jitter
+[[nodiscard]] inline RetryPolicy default_reconnect_backoff() noexcept {
+	RetryPolicy policy;
+	policy.initial_delay = std::chrono::milliseconds{100};
+	policy.max_delay = std::chrono::milliseconds{5000};
+	policy.backoff_multiplier = 2.0;
+	policy.jitter_factor = 0.2;
+	return policy;
+}
+
+/// How the libwebsockets event loop is driven
+enum class WsServiceMode : std::uint8_t {
+	/// A client-owned service thread that sleeps in ``poll`` until the
+	/// socket, a timer or an outbound command needs it
+	Blocking,
+	/// A client-owned service thread that never sleeps: every round polls
+	/// with a zero timeout. Spends a whole core to skip the wakeup; pair
+	/// it with ``service_cpu``.
+	BusyPoll,
+	/// No thread: the caller runs the loop with ``WebSocketClient::poll_once``
+	/// and all callbacks fire on that thread
+	External,
+};
+
 /// WebSocket client configuration
 struct WsConfig {
 	std::string url{"wss://external-api-ws.kalshi.com/trade-api/ws/v2"};
+	/// Unused; superseded by ``reconnect_backoff``. Kept for source
+	/// compatibility.
 	std::chrono::seconds reconnect_delay{5};
-	std::uint16_t max_reconnect_attempts{10}; ///< Max reconnect attempts (0-65535, default 10)
+	/// Reconnect attempts per outage before giving up (0 retries forever)
+	std::uint16_t max_reconnect_attempts{10};
+	/// Re-establish a dropped connection and replay every active
+	/// subscription on it. Subscription ids stay valid across reconnects.
 	bool auto_reconnect{true};
+	/// Wait before each reconnect attempt: exponential with jitter via
+	/// ``calculate_retry_delay``. ``max_attempts`` and the ``retry_on_*``
+	/// flags are ignored (see ``max_reconnect_attempts``).
+	RetryPolicy reconnect_backoff{default_reconnect_backoff()};
+
+	/// Capacity of the inbound message queue. ``0`` (default) invokes the
+	/// ``on_message`` callback inline on the libwebsockets service thread.
+	/// Any other value enables queue mode: parsed messages go into a
+	/// bounded lock-free SPSC ring (rounded up to a power of two) and are
+	/// drained with ``WebSocketClient::poll``; ``on_message`` is not
+	/// called. When the ring is full ``queue_overflow`` decides what
+	/// happens; by default new messages are dropped and counted in
+	/// ``WsQueueStats::dropped``.
+	std::size_t message_queue_capacity{0};
+
+	/// On an orderbook ``seq`` gap, repair the affected subscription in
+	/// place: ``update_subscription`` delete + add for its markets, with
+	/// their deltas suppressed until the replacement snapshots arrive.
+	/// When false, gaps are only reported via ``on_sequence_gap``.
+	bool resync_on_gap{true};
+
+	/// Ticker interning table stamped into every message's ``ticker_id``.
+	/// Null (default) makes the client create its own; pass one shared
+	/// table here and to ``KalshiClient::set_ticker_table`` so WS and REST
+	/// agree on ids.
+	std::shared_ptr<TickerTable> ticker_table;
+
+	/// Populate ``market_ticker`` strings on messages. Set false to rely
+	/// on ``ticker_id`` alone and skip the per-message string allocation
+	/// (tickers are usually longer than the small-string buffer).
+	bool ticker_strings{true};
+
+	/// Decode snapshot levels into a reusable per-connection buffer and
+	/// expose them as ``OrderbookSnapshot::yes_view`` / ``no_view`` instead
+	/// of allocating two vectors per snapshot. The views are valid only
+	/// inside ``on_message``; call ``make_owned`` to keep a snapshot.
+	/// Ignored in queue mode, where messages outlive the decode.
+	bool borrowed_snapshots{false};
+
+	/// Decode orderbook deltas, trades and fills straight into fixed-size
+	/// ``WsEvent``s delivered to ``on_event`` (on_message still receives
+	/// snapshots and lifecycle messages, in stream order with the events).
+	/// No strings are built for those kinds. Ignored in queue mode.
+	bool compact_events{false};
+
+	/// Pre-signed handshake headers. When set, and its method and path
+	/// match the ``GET`` on ``url``, each (re)connect takes from it rather
+	/// than signing inline; keep it topped up with ``refill``. Null
+	/// (default) signs every handshake.
+	std::shared_ptr<PresignedHeaderPool> handshake_headers;
+
+	/// Capture every complete inbound frame, with its receive time, to a
+	/// replayable log (``kalshi/ws_recorder.hpp``). The service thread only
+	/// copies into the recorder's ring; file I/O happens on its writer
+	/// thread. Null (default) records nothing.
+	std::shared_ptr<WsRecorder> recorder;
+
+	/// Per-message-type decode, callback and total latency plus message
+	/// and byte counts (``kalshi/latency_stats.hpp``), recorded on the
+	/// service thread. Null (default) skips the clock reads entirely.
+	std::shared_ptr<LatencyStats> latency_stats;
+
+	/// Who runs the event loop and whether it sleeps (``WsServiceMode``)
+	WsServiceMode service_mode{WsServiceMode::Blocking};
+	/// Pin the service thread to this CPU (-1, the default, leaves it to
+	/// the scheduler). Linux only; ignored in ``External`` mode, where the
+	/// caller places its own thread.
+	int service_cpu{-1};
+	/// Run the service thread under ``SCHED_FIFO`` at this priority
+	/// (1-99; 0, the default, keeps the normal policy). Needs
+	/// ``CAP_SYS_NICE`` or an ``RLIMIT_RTPRIO`` allowance. Linux only;
+	/// ignored in ``External`` mode.
+	int service_priority{0};
+	/// Set ``TCP_NODELAY`` on the connection so small command frames are
+	/// not held back by Nagle's algorithm
+	bool tcp_nodelay{true};
+	/// ``SO_BUSY_POLL`` budget in microseconds: blocking reads spin on the
+	/// NIC queue this long before sleeping. 0 (default) leaves the system
+	/// setting. Linux only; values above ``net.core.busy_read`` need
+	/// ``CAP_NET_ADMIN``. A failure is reported through ``on_error`` and
+	/// the connection carries on untuned.
+	std::uint32_t socket_busy_poll_us{0};
+
+	/// Offer permessage-deflate in the handshake. If the server accepts,
+	/// frames arrive compressed and are inflated on the service thread
+	/// into per-connection buffers (no per-message allocation); see
+	/// ``WebSocketClient::compression_stats``. Costs CPU per message for
+	/// less bandwidth, which mostly pays off on long-haul links and
+	/// snapshot bursts.
+	bool permessage_deflate{false};
+
+	/// Decode and dispatch on this many worker threads instead of the
+	/// service thread. The service thread then only reassembles frames,
+	/// reads their ``type`` / ``sid`` / ``seq`` / ``market_ticker``, runs
+	/// sequence tracking, and copies each frame to the worker that owns
+	/// its market. One market's messages are always decoded and delivered
+	/// by the same worker, in stream order; different markets run in
+	/// parallel, so ``on_message`` / ``on_event`` are called concurrently
+	/// from several threads (never concurrently for one market). Gap,
+	/// error and state callbacks stay on the service thread and may
+	/// overtake messages still queued for a worker. 0 (default) does all
+	/// of it on the service thread. Ignored in queue mode.
+	std::size_t decode_workers{0};
+	/// Frames each worker's ring holds (rounded up to a power of two).
+	/// When a worker falls this far behind ``decode_overflow`` applies; by
+	/// default the service thread waits for it rather than drop a frame,
+	/// pushing back on the socket (see ``WsPipelineStats::stalls``).
+	std::size_t decode_ring_capacity{4096};
+
+	/// What a full message queue does (queue mode). ``DropNewest``
+	/// (default) never holds up the service thread. ``DropOldest`` and
+	/// ``Resync`` make ``poll`` take a lock it shares with the service
+	/// thread.
+	WsOverflowPolicy queue_overflow{WsOverflowPolicy::DropNewest};
+	/// What a full decode worker ring does. ``Block`` (default) loses
+	/// nothing. ``DropOldest`` makes workers take a per-worker lock for
+	/// each frame.
+	WsOverflowPolicy decode_overflow{WsOverflowPolicy::Block};
+	/// Cap on the bytes held by the message queue or, with decode workers,
+	/// by all their rings together; past it the buffer counts as full. 0
+	/// (default) bounds them by slot count alone. Queue mode counts each
+	/// message's decoded size, workers the raw frame; a buffer that is
+	/// empty always takes one message, however large.
+	std::size_t max_queued_bytes{0};
+	/// Largest inbound message, in bytes. A longer one is discarded as it
+	/// arrives, reported through ``on_error`` and handled as
+	/// ``WsOverflowPolicy::Resync``, since whatever it carried is lost. 0
+	/// (default) accepts any size.
+	std::size_t max_message_bytes{0};
+	/// Fill level, as a fraction of slots or of ``max_queued_bytes``
+	/// (whichever is reached first), at which ``on_backpressure`` reports a
+	/// buffer as filling. It reports it again once it drains below half of
+	/// that.
+	double high_watermark{0.75};
+};
+
+/// Counters for the inbound message queue (queue mode only; all zero
+/// when ``WsConfig::message_queue_capacity`` is 0).
+struct WsQueueStats {
+	std::size_t depth{0};	   ///< Messages waiting to be polled (approximate)
+	std::size_t capacity{0};   ///< Ring capacity after power-of-two rounding
+	std::uint64_t enqueued{0}; ///< Messages accepted since construction
+	std::uint64_t dropped{0};  ///< Messages rejected because the ring was full
+	std::size_t bytes{0};	   ///< Bytes queued (0 without ``max_queued_bytes``)
+	std::uint64_t evicted{0};  ///< Queued messages discarded (``DropOldest`` / ``Resync``)
+};
+
+/// Auto-reconnect counters. Latencies run from the moment the connection
+/// dropped to the first market data message after it was re-established.
+struct WsReconnectStats {
+	std::uint64_t reconnects{0};					   ///< Times a dropped connection came back
+	std::uint64_t failed_attempts{0};				   ///< Reconnect attempts that did not connect
+	std::chrono::microseconds last_resume_latency{0}; ///< Most recent outage
+	std::chrono::microseconds max_resume_latency{0};  ///< Longest outage since construction
+	std::uint16_t pending_attempts{0};				   ///< Attempts in the current outage
+};
+
+/// permessage-deflate counters (``WsConfig::permessage_deflate``).
+/// Byte and time totals run since construction, across reconnects.
+struct WsCompressionStats {
+	/// The server accepted deflate on the current connection
+	bool negotiated{false};
+	std::uint64_t wire_bytes{0};			  ///< Compressed payload bytes received
+	std::uint64_t inflated_bytes{0};		  ///< Bytes those inflated to
+	std::chrono::nanoseconds inflate_time{0}; ///< Service-thread time spent inflating
+
+	/// Inflated bytes per wire byte (0 before any compressed frame)
+	[[nodiscard]] double ratio() const noexcept {
+		return wire_bytes == 0
+				   ? 0.0
+				   : static_cast<double>(inflated_bytes) / static_cast<double>(wire_bytes);
+	}
+};
+
+/// Decode worker counters (``WsConfig::decode_workers``; all zero
+/// without workers). Totals run since construction.
+struct WsPipelineStats {
+	std::size_t workers{0};	  ///< Decode worker threads
+	std::size_t depth{0};	  ///< Frames waiting across all workers (approximate)
+	std::uint64_t frames{0};  ///< Frames handed to workers
+	std::uint64_t stalls{0};  ///< Times the service thread waited on a full worker ring
+	std::size_t bytes{0};	  ///< Frame bytes queued (0 without ``max_queued_bytes``)
+	std::uint64_t dropped{0}; ///< Frames discarded for lack of room
+	std::uint64_t evicted{0}; ///< Queued frames discarded (``DropOldest`` / ``Resync``)
+};
+
+/// Overflow handling counters (``WsOverflowPolicy``). Totals run since
+/// construction.
+struct WsOverflowStats {
+	std::uint64_t conflated{0};		  ///< Markets re-added by ``Conflate``
+	std::uint64_t resyncs{0};		  ///< Connections dropped to resync
+	std::uint64_t oversized{0};		  ///< Messages over ``max_message_bytes``
+	std::uint64_t high_watermarks{0}; ///< Times a buffer filled past ``high_watermark``
 };
 
 /// WebSocket streaming client for Kalshi
@@ -279,6 +637,13 @@ public:
 	/// Subscribe to market lifecycle events
 	[[nodiscard]] Result<SubscriptionId> subscribe_lifecycle();
 
+	/// Subscribe to ``channel``, optionally for ``market_tickers`` only and
+	/// optionally server-sharded. The ``subscribe_*`` helpers are this with
+	/// their channel's validation.
+	[[nodiscard]] Result<SubscriptionId> subscribe(Channel channel,
+												   const std::vector<std::string>& market_tickers,
+												   std::optional<WsShard> shard = std::nullopt);
+
 	/// Unsubscribe from a subscription
 	[[nodiscard]] Result<void> unsubscribe(SubscriptionId sub_id);
 
@@ -293,15 +658,65 @@ public:
 	/// Set callback for incoming messages
 	void on_message(WsMessageCallback callback);
 
+	/// Set callback for compact deltas, trades and fills
+	/// (``WsConfig::compact_events``)
+	void on_event(WsEventCallback callback);
+
 	/// Set callback for errors
 	void on_error(WsErrorCallback callback);
 
 	/// Set callback for connection state changes
 	void on_state_change(WsStateCallback callback);
 
+	/// Set callback for orderbook sequence gaps (invoked on the service
+	/// thread, before any resync commands are sent)
+	void on_sequence_gap(WsSeqGapCallback callback);
+
+	/// Set callback for inbound buffers crossing ``WsConfig::high_watermark``
+	/// (invoked on the service thread as it queues a message)
+	void on_backpressure(WsBackpressureCallback callback);
+
+	/// Drain up to ``out.size()`` queued messages into ``out`` (queue mode).
+	///
+	/// Non-blocking; returns the number of messages written, 0 when the
+	/// queue is empty or queue mode is off. Must only be called from one
+	/// consumer thread at a time. Errors and state changes are still
+	/// delivered through their callbacks on the service thread.
+	[[nodiscard]] std::size_t poll(std::span<WsMessage> out);
+
+	/// Run one round of the event loop on the calling thread
+	/// (``WsServiceMode::External`` only): read and dispatch whatever has
+	/// arrived, write queued commands and fire due reconnect timers.
+	///
+	/// Waits up to ``timeout`` for something to do; 0 returns at once.
+	/// ``subscribe_*`` from another thread wakes a waiting call. Keep
+	/// calling it after a drop: auto-reconnect runs from here too. Errors
+	/// when not in External mode or before ``connect`` / after
+	/// ``disconnect``. ``connect``, ``poll_once`` and ``disconnect`` must
+	/// not run concurrently.
+	Result<void> poll_once(std::chrono::milliseconds timeout = std::chrono::milliseconds{0});
+
+	/// Inbound queue depth / drop counters (queue mode).
+	[[nodiscard]] WsQueueStats queue_stats() const noexcept;
+
+	/// Auto-reconnect counters and resume latencies
+	[[nodiscard]] WsReconnectStats reconnect_stats() const noexcept;
+
+	/// permessage-deflate counters (all zero when it is off or declined)
+	[[nodiscard]] WsCompressionStats compression_stats() const noexcept;
+
+	/// Decode worker counters (all zero without ``decode_workers``)
+	[[nodiscard]] WsPipelineStats pipeline_stats() const noexcept;
+
+	/// Overflow policy, message size and watermark counters
+	[[nodiscard]] WsOverflowStats overflow_stats() const noexcept;
+
 	/// Get the configuration
 	[[nodiscard]] const WsConfig& config() const noexcept;
 
+	/// Interning table behind ``ticker_id`` (null on a moved-from client)
+	[[nodiscard]] std::shared_ptr<TickerTable> ticker_table() const noexcept;
+
 private:
 	struct Impl;
 	std::unique_ptr<Impl> impl_;
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "kalshi/models/market.hpp"
+#include "kalshi/ticker_table.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace kalshi {
+
+/// 128-bit identifier in binary form. Kalshi ``trade_id`` / ``order_id``
+/// values are UUIDs; holding them as 16 raw bytes instead of a 36-char
+/// string keeps ``WsEvent`` fixed-size.
+struct Uuid {
+	std::array<std::uint8_t, 16> bytes{};
+
+	/// Parse ``8-4-4-4-12`` hyphenated or 32-digit bare hex (either case).
+	/// Returns nullopt for anything else.
+	[[nodiscard]] static std::optional<Uuid> parse(std::string_view text) noexcept;
+
+	/// Lowercase hyphenated form; empty for the nil (all-zero) id.
+	[[nodiscard]] std::string to_string() const;
+
+	[[nodiscard]] constexpr bool is_nil() const noexcept {
+		for (const std::uint8_t b : bytes) {
+			if (b != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	constexpr bool operator==(const Uuid&) const noexcept = default;
+};
+
+/// Kind of a ``WsEvent``
+enum class WsEventKind : std::uint8_t { None, Delta, Trade, Fill };
+
+/// Fixed-size form of the high-rate WebSocket messages: orderbook
+/// deltas, trades and fills.
+///
+/// Trivially copyable and exactly one cache line, so it can be
+/// ``memcpy``'d into rings, shared memory and capture logs. Tickers are
+/// ``TickerId``s and ids are binary ``Uuid``s (nil when the wire id is
+/// not a UUID). Prices are cents. ``to_message`` (``websocket.hpp``)
+/// rebuilds the matching ``OrderbookDelta`` / ``WsTrade`` / ``WsFill``.
+///
+/// Fields shared by several kinds mean:
+///
+/// | field       | Delta          | Trade       | Fill       |
+/// |-------------|----------------|-------------|------------|
+/// | ``side``    | book side      | taker side  | fill side  |
+/// | ``price``   | level price    | yes price   | yes price  |
+/// | ``quantity``| size change    | count       | count      |
+struct WsEvent {
+	WsEventKind kind{WsEventKind::None};
+	Side side{Side::Yes};
+	Action action{Action::Buy}; ///< Fill only
+	bool is_taker{false};		///< Fill only
+	std::int32_t sid{0};
+	TickerId ticker_id;
+	std::int32_t seq{0};		  ///< Delta only
+	std::int64_t timestamp{0};	  ///< Trade / fill
+	std::int16_t price{0};		  ///< Cents; see the table above
+	std::int16_t no_price{0};	  ///< Trade / fill, cents
+	std::int32_t quantity{0};	  ///< See the table above
+	Uuid trade_id;				  ///< Trade / fill
+	Uuid order_id;				  ///< Fill only
+};
+
+static_assert(std::is_trivially_copyable_v<WsEvent>, "WsEvent must stay memcpy-able");
+static_assert(sizeof(WsEvent) == 64, "WsEvent must stay one cache line");
+
+/// Callback for compact events (``WsConfig::compact_events``)
+using WsEventCallback = std::function<void(const WsEvent&)>;
+
+} // namespace kalshi
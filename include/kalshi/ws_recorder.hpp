@@ -0,0 +1,221 @@
+#pragma once
+
+#include "kalshi/error.hpp"
+#include "kalshi/ticker_table.hpp"
+#include "kalshi/websocket.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace kalshi {
+
+/// Kind of a record in a WebSocket capture log.
+enum class WsLogRecordType : std::uint16_t {
+	/// One complete inbound text frame, exactly as received
+	Frame = 1,
+	/// One ``WsEvent``, stored as its 64 raw bytes
+	Event = 2,
+	/// Ticker name for an id used by later ``Event`` records: u32 id, then
+	/// the name. Written once per id, before the first event that uses it.
+	Ticker = 3,
+};
+
+/// One record read back from a capture log. ``payload`` points into the
+/// reader's mapping and is valid for the reader's lifetime.
+struct WsLogRecord {
+	std::uint64_t recv_ns{0}; ///< Receive time, ``system_clock`` nanoseconds since the epoch
+	WsLogRecordType type{WsLogRecordType::Frame};
+	std::string_view payload;
+};
+
+/// Capture log layout (host byte order; little-endian on every supported
+/// target). A 16-byte file header (``"KALSHIWS"``, u16 version, u16 header
+/// size, u32 reserved) is followed by records, each a 16-byte header
+/// (u32 payload length, u16 type, u16 reserved, u64 ``recv_ns``) and the
+/// payload zero-padded to 8 bytes. Every record therefore starts 8-byte
+/// aligned in a mapping of the file, and a log is only ever appended to.
+inline constexpr std::string_view kWsLogMagic{"KALSHIWS"};
+inline constexpr std::uint16_t kWsLogVersion = 1;
+
+/// WebSocket recorder configuration
+struct WsRecorderConfig {
+	/// Log file; created when missing, appended to otherwise
+	std::string path;
+	/// Start a fresh log instead of appending
+	bool truncate{false};
+	/// In-memory ring between the recording thread and the writer
+	/// (rounded up to a power of two). Frames that do not fit are dropped
+	/// and counted, never waited for.
+	std::size_t buffer_bytes{std::size_t{8} << 20};
+	/// How often the writer thread drains the ring when it is not prodded
+	/// by a filling buffer or ``flush``
+	std::chrono::milliseconds flush_interval{10};
+	/// Record raw frames (``WsLogRecordType::Frame``)
+	bool frames{true};
+	/// Also record deltas, trades and fills as pre-decoded ``WsEvent``s,
+	/// so a replay can skip JSON decoding
+	bool events{false};
+};
+
+/// Recorder counters
+struct WsRecorderStats {
+	std::uint64_t records{0};		///< Frames and events accepted into the ring
+	std::uint64_t dropped{0};		///< Frames and events rejected because the ring was full
+	std::uint64_t bytes_written{0}; ///< Bytes handed to the file, headers included
+};
+
+/// Append-only capture of inbound WebSocket frames.
+///
+/// ``record`` copies the frame and its header into a byte ring and
+/// returns; a background thread writes the ring out to the log, so the
+/// caller never touches the file. Attach one through
+/// ``WsConfig::recorder`` and ``WebSocketClient`` records every complete
+/// frame before decoding it. Several connections may share a recorder
+/// (``record`` serializes producers with a spin lock held only for the
+/// copy). Queued frames are written out on destruction.
+class WsRecorder {
+public:
+	/// Open (or create) the log and start the writer thread
+	[[nodiscard]] static Result<WsRecorder> open(WsRecorderConfig config);
+
+	~WsRecorder();
+	WsRecorder(WsRecorder&&) noexcept;
+	WsRecorder& operator=(WsRecorder&&) noexcept;
+
+	WsRecorder(const WsRecorder&) = delete;
+	WsRecorder& operator=(const WsRecorder&) = delete;
+
+	/// Queue one frame received at ``recv_ns``. Never blocks on I/O;
+	/// returns false when the ring is full and the frame was dropped.
+	bool record(std::string_view frame, std::uint64_t recv_ns) noexcept;
+
+	/// Queue one pre-decoded event; ``ticker`` is the name behind
+	/// ``event.ticker_id`` and is logged the first time that id is seen.
+	/// Every connection sharing a recorder must share one ``TickerTable``.
+	bool record_event(const WsEvent& event, std::string_view ticker,
+					  std::uint64_t recv_ns) noexcept;
+
+	/// ``WsRecorderConfig::frames`` / ``events``
+	[[nodiscard]] bool records_frames() const noexcept;
+	[[nodiscard]] bool records_events() const noexcept;
+
+	/// Block until every frame queued so far has been written to the file
+	void flush();
+
+	[[nodiscard]] WsRecorderStats stats() const noexcept;
+
+	[[nodiscard]] const std::string& path() const noexcept;
+
+private:
+	struct Impl;
+	explicit WsRecorder(std::unique_ptr<Impl> impl);
+	std::unique_ptr<Impl> impl_;
+};
+
+/// Sequential reader over a capture log. The file is memory-mapped where
+/// the platform allows (read into memory otherwise); records are returned
+/// as views into it.
+class WsLogReader {
+public:
+	/// Open ``path`` and validate its header
+	[[nodiscard]] static Result<WsLogReader> open(const std::string& path);
+
+	~WsLogReader();
+	WsLogReader(WsLogReader&&) noexcept;
+	WsLogReader& operator=(WsLogReader&&) noexcept;
+
+	WsLogReader(const WsLogReader&) = delete;
+	WsLogReader& operator=(const WsLogReader&) = delete;
+
+	/// Read the next record; false at the end of the log. A record cut
+	/// short by a crash mid-write ends the log and sets ``truncated``.
+	[[nodiscard]] bool next(WsLogRecord& out) noexcept;
+
+	/// Go back to the first record
+	void rewind() noexcept;
+
+	/// The log ended in a partial record
+	[[nodiscard]] bool truncated() const noexcept;
+
+	/// Size of the log in bytes
+	[[nodiscard]] std::size_t size_bytes() const noexcept;
+
+private:
+	struct Impl;
+	explicit WsLogReader(std::unique_ptr<Impl> impl);
+	std::unique_ptr<Impl> impl_;
+};
+
+/// Replay pacing and decode settings
+struct ReplayConfig {
+	/// Playback rate relative to the recorded timing: 1.0 is wall-clock
+	/// speed, 10.0 ten times faster, and 0 (or less) as fast as possible
+	double speed{1.0};
+	/// Interning table for ``ticker_id``; null makes the client create one
+	std::shared_ptr<TickerTable> ticker_table;
+	/// Populate ``market_ticker`` strings, as ``WsConfig::ticker_strings``
+	bool ticker_strings{true};
+};
+
+/// Replay counters
+struct ReplayStats {
+	std::uint64_t frames{0};   ///< Frame and Event records read
+	std::uint64_t messages{0}; ///< Data messages delivered to ``on_message``
+	std::uint64_t errors{0};   ///< Server error frames delivered to ``on_error``
+	std::chrono::nanoseconds recorded_span{0}; ///< Receive time of the last frame minus the first
+	std::chrono::nanoseconds elapsed{0};	   ///< Wall-clock time ``run`` took
+};
+
+/// Plays a capture log back through the same decoder and callbacks as
+/// ``WebSocketClient``, so strategy code written against ``on_message``
+/// runs unchanged on recorded data. A log holding both frames and events
+/// for the same traffic replays both; record only the form you need.
+class ReplayClient {
+public:
+	/// Open the log at ``path``
+	[[nodiscard]] static Result<ReplayClient> open(const std::string& path,
+												   ReplayConfig config = {});
+
+	~ReplayClient();
+	ReplayClient(ReplayClient&&) noexcept;
+	ReplayClient& operator=(ReplayClient&&) noexcept;
+
+	ReplayClient(const ReplayClient&) = delete;
+	ReplayClient& operator=(const ReplayClient&) = delete;
+
+	/// Set callback for replayed messages
+	void on_message(WsMessageCallback callback);
+
+	/// Set callback for replayed ``Event`` records. Without one they are
+	/// converted with ``to_message`` and delivered to ``on_message``.
+	void on_event(WsEventCallback callback);
+
+	/// Set callback for replayed server error frames
+	void on_error(WsErrorCallback callback);
+
+	/// Play the rest of the log on the calling thread, sleeping between
+	/// frames according to ``ReplayConfig::speed``. Returns when the log
+	/// ends or ``stop`` is called; a later ``run`` resumes where it left off.
+	[[nodiscard]] Result<ReplayStats> run();
+
+	/// Make ``run`` return after the current frame. Safe from a callback
+	/// or another thread.
+	void stop() noexcept;
+
+	/// Start the next ``run`` from the first frame again
+	void rewind();
+
+	/// Interning table behind ``ticker_id`` (null on a moved-from client)
+	[[nodiscard]] std::shared_ptr<TickerTable> ticker_table() const noexcept;
+
+private:
+	struct Impl;
+	explicit ReplayClient(std::unique_ptr<Impl> impl);
+	std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalshi
@@ -0,0 +1,147 @@
+#include "array_stream.hpp"
+
+#include "kalshi/detail/json_scan.hpp"
+
+namespace kalshi::api_detail {
+
+bool ArrayStreamParser::feed(std::string_view chunk) {
+	std::size_t pos = 0;
+	while (!stopped_ && pos < chunk.size()) {
+		pos = in_object_   ? feed_object(chunk, pos)
+			  : in_string_ ? feed_envelope_string(chunk, pos)
+						   : feed_envelope(chunk, pos);
+	}
+	return !stopped_;
+}
+
+std::size_t ArrayStreamParser::feed_envelope(std::string_view chunk, std::size_t pos) {
+	pos = detail::find_any<'"', ':', ',', '{', '}', '[', ']'>(chunk, pos);
+	if (pos == std::string_view::npos) {
+		return chunk.size();
+	}
+	switch (chunk[pos]) {
+		case '"':
+			in_string_ = true;
+			if (depth_ == 1 && expect_key_) {
+				capture_ = Capture::Key;
+				key_.clear();
+			} else if (depth_ == 1 && key_ == "cursor") {
+				capture_ = Capture::Cursor;
+				cursor_.clear();
+			} else {
+				capture_ = Capture::None;
+			}
+			break;
+		case ':':
+			if (depth_ == 1) {
+				expect_key_ = false;
+			}
+			break;
+		case ',':
+			if (depth_ == 1) {
+				expect_key_ = true;
+			}
+			break;
+		case '{':
+			if (in_array_ && depth_ == 2) {
+				// feed_object takes it from the brace itself.
+				in_object_ = true;
+				object_depth_ = 0;
+				object_.clear();
+				return pos;
+			}
+			++depth_;
+			if (depth_ == 1) {
+				expect_key_ = true;
+			}
+			break;
+		case '[':
+			if (depth_ == 1 && !expect_key_ && key_ == array_key_) {
+				in_array_ = true;
+			}
+			++depth_;
+			break;
+		default: // '}' or ']'
+			--depth_;
+			if (in_array_ && depth_ == 1) {
+				in_array_ = false;
+			}
+			break;
+	}
+	return pos + 1;
+}
+
+std::size_t ArrayStreamParser::feed_envelope_string(std::string_view chunk, std::size_t pos) {
+	std::string* target = capture_ == Capture::Key	  ? &key_
+						  : capture_ == Capture::Cursor ? &cursor_
+														: nullptr;
+	if (escape_) {
+		escape_ = false;
+		if (target != nullptr) {
+			target->push_back(chunk[pos]);
+		}
+		return pos + 1;
+	}
+	const std::size_t end = detail::find_any<'"', '\\'>(chunk, pos);
+	const std::size_t run_end = end == std::string_view::npos ? chunk.size() : end;
+	if (target != nullptr) {
+		target->append(chunk.substr(pos, run_end - pos));
+	}
+	if (end == std::string_view::npos) {
+		return chunk.size();
+	}
+	if (chunk[end] == '\\') {
+		escape_ = true;
+		if (target != nullptr) {
+			target->push_back('\\');
+		}
+	} else {
+		in_string_ = false;
+		capture_ = Capture::None;
+	}
+	return end + 1;
+}
+
+std::size_t ArrayStreamParser::feed_object(std::string_view chunk, std::size_t pos) {
+	const std::size_t from = pos;
+	for (;;) {
+		if (escape_) {
+			if (pos >= chunk.size()) {
+				break;
+			}
+			escape_ = false;
+			++pos;
+			continue;
+		}
+		pos = in_string_ ? detail::find_any<'"', '\\'>(chunk, pos)
+						 : detail::find_any<'"', '{', '}', '[', ']'>(chunk, pos);
+		if (pos == std::string_view::npos) {
+			break;
+		}
+		const char c = chunk[pos++];
+		if (in_string_) {
+			if (c == '\\') {
+				escape_ = true;
+			} else {
+				in_string_ = false;
+			}
+		} else if (c == '"') {
+			in_string_ = true;
+		} else if (c == '{' || c == '[') {
+			++object_depth_;
+		} else if (--object_depth_ == 0) {
+			object_.append(chunk.substr(from, pos - from));
+			in_object_ = false;
+			++objects_;
+			if (!on_object_(object_)) {
+				stopped_ = true;
+			}
+			return pos;
+		}
+	}
+	// The object continues in the next chunk.
+	object_.append(chunk.substr(from));
+	return chunk.size();
+}
+
+} // namespace kalshi::api_detail
@@ -0,0 +1,81 @@
+#pragma once
+
+/// @file array_stream.hpp
+/// @brief Incremental splitter for paginated REST array responses.
+///
+/// ``ArrayStreamParser`` is fed a response body in arbitrary chunks
+/// (straight from the libcurl write callback) and hands each element of
+/// one top-level array -- ``markets``, ``orderbooks``, ``trades``,
+/// ``orders``, ``fills`` -- to a callback as soon as its closing brace
+/// arrives, so parsing overlaps the download instead of following it.
+/// Only the object currently being assembled is buffered, so memory
+/// stays at roughly one element regardless of page size. The top-level
+/// ``cursor`` string is captured wherever it appears.
+///
+/// Bytes are consumed in runs: ``detail::find_any`` jumps to the next
+/// quote, backslash or bracket and everything in between is appended in
+/// one go. The parser is resumable at any byte, including inside keys,
+/// escapes and nested objects; ``tests/fuzz_array_stream.cpp`` checks
+/// that every split of an input yields the same objects and cursor as
+/// feeding it whole, and that malformed input never reads out of bounds.
+///
+/// Not installed: consumed by ``client.cpp``, the unit tests, the fuzz
+/// target and the benchmarks.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace kalshi::api_detail {
+
+class ArrayStreamParser {
+public:
+	/// Receives one complete array element (raw JSON). The string is
+	/// reused for the next element. Return false to stop; later input is
+	/// ignored.
+	using ObjectCallback = std::function<bool(const std::string& object)>;
+
+	/// Split the elements of the top-level array named ``array_key``
+	ArrayStreamParser(std::string array_key, ObjectCallback on_object)
+		: on_object_(std::move(on_object)), array_key_(std::move(array_key)) {}
+
+	/// Consume the next chunk. Returns false once the callback has asked
+	/// to stop.
+	bool feed(std::string_view chunk);
+
+	/// Top-level ``cursor`` value seen so far (empty when absent).
+	[[nodiscard]] const std::string& cursor() const noexcept { return cursor_; }
+
+	/// Number of objects delivered.
+	[[nodiscard]] std::size_t objects() const noexcept { return objects_; }
+
+private:
+	enum class Capture : std::uint8_t { None, Key, Cursor };
+
+	/// Each consumes ``chunk`` from ``pos`` up to a state change and
+	/// returns where it stopped.
+	std::size_t feed_envelope(std::string_view chunk, std::size_t pos);
+	std::size_t feed_envelope_string(std::string_view chunk, std::size_t pos);
+	std::size_t feed_object(std::string_view chunk, std::size_t pos);
+
+	ObjectCallback on_object_;
+	std::string array_key_;
+	std::string object_;
+	std::string key_;
+	std::string cursor_;
+	std::size_t objects_{0};
+	std::int32_t depth_{0};		   ///< Nesting outside the current object
+	std::int32_t object_depth_{0}; ///< Nesting inside it
+	Capture capture_{Capture::None};
+	bool in_string_{false};
+	bool escape_{false};
+	bool expect_key_{false};
+	bool in_array_{false};
+	bool in_object_{false};
+	bool stopped_{false};
+};
+
+} // namespace kalshi::api_detail
@@ -1,14 +1,32 @@
 #include "kalshi/api.hpp"
 
+#include "kalshi/detail/json_scan.hpp"
+#include "kalshi/metadata_cache.hpp"
+#include "kalshi/risk_gate.hpp"
+
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <charconv>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstring>
+#include <deque>
+#include <future>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include "array_stream.hpp"
 #include "json_bodies.hpp"
 #include "query_builders.hpp"
 #include "response_parsers.hpp"
@@ -37,13 +55,14 @@ namespace kalshi {
 namespace {
 
 // Convert a public CreateOrderParams into the shim shape used for
-// serialization. Centralized so `serialize_create_order` and
-// `serialize_batch_create` share the same field ordering.
+// serialization. Centralized so `render_create_order` and
+// `render_batch_create` share the same field ordering. The body views
+// the params' strings, so this copies nothing.
 ser::CreateOrderBody to_create_order_body(const CreateOrderParams& params) {
 	ser::CreateOrderBody body;
 	body.ticker = params.ticker;
-	body.side = std::string(to_json_string(params.side));
-	body.action = std::string(to_json_string(params.action));
+	body.side = to_json_string(params.side);
+	body.action = to_json_string(params.action);
 	body.type = params.type;
 	body.count = params.count;
 	body.count_fp = params.count_fp;
@@ -66,6 +85,91 @@ ser::CreateOrderBody to_create_order_body(const CreateOrderParams& params) {
 	return body;
 }
 
+/// Per-thread order body buffer for the blocking submit calls. It keeps
+/// its capacity, so steady-state requotes render without allocating.
+std::string& order_body_buffer() {
+	thread_local std::string buffer;
+	return buffer;
+}
+
+void clip_count(CreateOrderParams& params, std::int32_t count) {
+	params.count = count;
+	if (params.count_fp) {
+		params.count_fp = Quantity::from_contracts(count);
+	}
+}
+
+/// Run ``gate`` (may be null) over ``params`` and return what to send:
+/// ``params`` itself, or ``clipped`` holding a copy with the reduced
+/// count. The copy is only made on the rare clip path.
+Result<const CreateOrderParams*> gate_order(const RiskGate* gate, const CreateOrderParams& params,
+											 std::optional<CreateOrderParams>& clipped) {
+	if (gate == nullptr) {
+		return &params;
+	}
+	const RiskDecision decision = gate->check(params);
+	if (!decision.accepted()) {
+		return std::unexpected(Error{ErrorCode::RiskRejected,
+									 "Risk gate rejected order: " +
+										 std::string(to_string(decision.reason))});
+	}
+	if (decision.verdict == RiskDecision::Verdict::Clip) {
+		clipped.emplace(params);
+		clip_count(*clipped, decision.count);
+		return &*clipped;
+	}
+	return &params;
+}
+
+/// ``gate_order`` for every order of a batch; any rejection fails it all
+Result<const BatchOrderRequest*> gate_batch(const RiskGate* gate, const BatchOrderRequest& request,
+											 std::optional<BatchOrderRequest>& clipped) {
+	if (gate == nullptr) {
+		return &request;
+	}
+	for (std::size_t i = 0; i < request.orders.size(); ++i) {
+		const RiskDecision decision = gate->check(request.orders[i]);
+		if (!decision.accepted()) {
+			return std::unexpected(Error{ErrorCode::RiskRejected,
+										 "Risk gate rejected order " + std::to_string(i) +
+											 ": " + std::string(to_string(decision.reason))});
+		}
+		if (decision.verdict == RiskDecision::Verdict::Clip) {
+			if (!clipped) {
+				clipped.emplace(request);
+			}
+			clip_count(clipped->orders[i], decision.count);
+		}
+	}
+	return clipped ? &*clipped : &request;
+}
+
+/// Times turning a response into a model as the endpoint's
+/// ``LatencyStage::Parse``. Construct it once the response is in hand; the
+/// sample is taken on destruction, after the return value is built. A
+/// no-op unless ``HttpClient::set_latency_stats`` attached stats.
+class ParseTimer {
+public:
+	ParseTimer(const HttpClient& http, HttpMethod method, std::string_view path) {
+		if (const std::shared_ptr<LatencyStats>& stats = http.latency_stats()) {
+			recorder_ = stats->rest(to_string(method), path);
+			start_ = std::chrono::steady_clock::now();
+		}
+	}
+	~ParseTimer() {
+		if (recorder_) {
+			recorder_.record(LatencyStage::Parse, std::chrono::steady_clock::now() - start_);
+		}
+	}
+
+	ParseTimer(const ParseTimer&) = delete;
+	ParseTimer& operator=(const ParseTimer&) = delete;
+
+private:
+	LatencyStats::Recorder recorder_;
+	std::chrono::steady_clock::time_point start_;
+};
+
 ser::BatchCancelOrderBody to_batch_cancel_order_body(const BatchCancelOrder& order) {
 	ser::BatchCancelOrderBody body;
 	body.order_id = order.order_id;
@@ -87,12 +191,124 @@ std::vector<std::string> batch_cancel_result_ids(const BatchCancelRequest& reque
 	return request.order_ids;
 }
 
+// Adapt a callback-style ``*_async`` call into a future.
+template <typename T, typename Start> std::future<Result<T>> make_future(Start&& start) {
+	std::shared_ptr<std::promise<Result<T>>> promise = std::make_shared<std::promise<Result<T>>>();
+	std::future<Result<T>> future = promise->get_future();
+	start([promise](Result<T> result) { promise->set_value(std::move(result)); });
+	return future;
+}
+
+// Stamp Market::ticker_id from the attached table, if any.
+void stamp_ticker_ids(const std::shared_ptr<TickerTable>& tickers, std::vector<Market>& markets) {
+	if (!tickers) {
+		return;
+	}
+	for (Market& market : markets) {
+		market.ticker_id = tickers->intern(market.ticker);
+	}
+}
+
+// Cache-first lookup behind the get_*_shared metadata calls: a fresh
+// entry is returned as is, a miss is fetched and stored.
+template <typename T, typename Lookup, typename Fetch>
+Result<std::shared_ptr<const T>> cached(MetadataCache* cache, Lookup&& lookup, Fetch&& fetch) {
+	if (cache) {
+		if (std::shared_ptr<const T> hit = lookup(*cache)) {
+			return hit;
+		}
+	}
+	Result<T> fetched = fetch();
+	if (!fetched) {
+		return std::unexpected(fetched.error());
+	}
+	if (cache) {
+		return cache->put(std::move(*fetched));
+	}
+	return std::make_shared<const T>(std::move(*fetched));
+}
+
 } // anonymous namespace
 
 struct KalshiClient::Impl {
+	/// A pre-signed order endpoint, keyed by path in ``prepared``
+	struct PreparedEndpoint {
+		std::shared_ptr<PreparedRequest> request;
+		std::string order_id; ///< Empty for ``create_order``
+	};
+
+	/// Lets ``prepared`` be probed with a ``string_view`` without building a key
+	struct StringHash {
+		using is_transparent = void;
+		std::size_t operator()(std::string_view s) const noexcept {
+			return std::hash<std::string_view>{}(s);
+		}
+	};
+
 	HttpClient client;
+	std::shared_ptr<TickerTable> tickers;
+	std::shared_ptr<MetadataCache> metadata;
+	std::shared_ptr<RiskGate> risk;
+
+	mutable std::shared_mutex prepared_mutex;
+	std::unordered_map<std::string, PreparedEndpoint, StringHash, std::equal_to<>> prepared;
+	/// ``prepared.size()``, read without the lock so clients that never
+	/// prepare anything skip it
+	std::atomic<std::size_t> prepared_count{0};
 
 	explicit Impl(HttpClient c) : client(std::move(c)) {}
+
+	Result<void> prepare(HttpMethod method, std::string path, std::string order_id,
+						 PreparedRequestConfig config) {
+		Result<PreparedRequest> request = client.prepare(method, path, config);
+		if (!request) {
+			return std::unexpected(request.error());
+		}
+		std::unique_lock lock(prepared_mutex);
+		prepared.insert_or_assign(
+			std::move(path),
+			PreparedEndpoint{std::make_shared<PreparedRequest>(std::move(*request)),
+							 std::move(order_id)});
+		prepared_count.store(prepared.size(), std::memory_order_release);
+		return {};
+	}
+
+	std::shared_ptr<PreparedRequest> find_prepared(HttpMethod method, std::string_view path) const {
+		if (prepared_count.load(std::memory_order_acquire) == 0) {
+			return nullptr;
+		}
+		std::shared_lock lock(prepared_mutex);
+		const auto it = prepared.find(path);
+		if (it == prepared.end() || it->second.request->method() != method) {
+			return nullptr;
+		}
+		return it->second.request;
+	}
+
+	void release(std::string_view path) {
+		std::unique_lock lock(prepared_mutex);
+		if (const auto it = prepared.find(path); it != prepared.end()) {
+			prepared.erase(it);
+			prepared_count.store(prepared.size(), std::memory_order_release);
+		}
+	}
+
+	/// Through the prepared request for ``path`` when there is one
+	Result<HttpResponse> send(HttpMethod method, std::string_view path, std::string_view body) {
+		if (const std::shared_ptr<PreparedRequest> request = find_prepared(method, path)) {
+			return request->send(body);
+		}
+		return client.request(method, path, body);
+	}
+
+	void send_async(HttpMethod method, std::string path, std::string body,
+					HttpCallback callback) {
+		if (const std::shared_ptr<PreparedRequest> request = find_prepared(method, path)) {
+			request->send_async(std::move(body), std::move(callback));
+			return;
+		}
+		client.request_async(method, std::move(path), std::move(body), std::move(callback));
+	}
 };
 
 KalshiClient::KalshiClient(HttpClient client) : impl_(std::make_unique<Impl>(std::move(client))) {}
@@ -103,6 +319,92 @@ KalshiClient::KalshiClient(KalshiClient&&) noexcept = default;
 
 KalshiClient& KalshiClient::operator=(KalshiClient&&) noexcept = default;
 
+void KalshiClient::set_ticker_table(std::shared_ptr<TickerTable> table) {
+	impl_->tickers = std::move(table);
+}
+
+const std::shared_ptr<TickerTable>& KalshiClient::ticker_table() const noexcept {
+	return impl_->tickers;
+}
+
+void KalshiClient::set_metadata_cache(std::shared_ptr<MetadataCache> cache) {
+	impl_->metadata = std::move(cache);
+}
+
+const std::shared_ptr<MetadataCache>& KalshiClient::metadata_cache() const noexcept {
+	return impl_->metadata;
+}
+
+void KalshiClient::set_risk_gate(std::shared_ptr<RiskGate> gate) {
+	impl_->risk = std::move(gate);
+}
+
+const std::shared_ptr<RiskGate>& KalshiClient::risk_gate() const noexcept {
+	return impl_->risk;
+}
+
+Result<void> KalshiClient::enable_rate_limits(std::optional<std::chrono::milliseconds> max_wait) {
+	Result<AccountApiLimits> limits = get_account_api_limits();
+	if (!limits) {
+		return std::unexpected(limits.error());
+	}
+	Result<EndpointCosts> costs = get_endpoint_costs();
+	if (!costs) {
+		return std::unexpected(costs.error());
+	}
+	impl_->client.set_rate_limiter(
+		std::make_shared<EndpointRateLimiter>(*limits, *costs, max_wait));
+	return {};
+}
+
+Result<void> KalshiClient::prepare_create_order(PreparedRequestConfig config) {
+	return impl_->prepare(HttpMethod::POST, "/portfolio/orders", {}, config);
+}
+
+Result<void> KalshiClient::prepare_amend_order(const std::string& order_id,
+											   PreparedRequestConfig config) {
+	return impl_->prepare(HttpMethod::POST, api_detail::build_amend_order_path(order_id),
+						  order_id, config);
+}
+
+Result<void> KalshiClient::prepare_cancel_order_v2(const CancelOrderV2Params& params,
+												   PreparedRequestConfig config) {
+	return impl_->prepare(HttpMethod::DEL, api_detail::build_cancel_order_v2_path(params),
+						  params.order_id, config);
+}
+
+Result<void> KalshiClient::refill_prepared() {
+	std::vector<std::shared_ptr<PreparedRequest>> requests;
+	{
+		std::shared_lock lock(impl_->prepared_mutex);
+		requests.reserve(impl_->prepared.size());
+		for (const auto& [path, endpoint] : impl_->prepared) {
+			requests.push_back(endpoint.request);
+		}
+	}
+	// Signing happens outside the lock so order entry is never held up
+	Result<void> result;
+	for (const std::shared_ptr<PreparedRequest>& request : requests) {
+		Result<void> refilled = request->refill();
+		if (!refilled && result) {
+			result = std::unexpected(refilled.error());
+		}
+	}
+	return result;
+}
+
+void KalshiClient::release_prepared(std::string_view order_id) {
+	std::unique_lock lock(impl_->prepared_mutex);
+	std::erase_if(impl_->prepared, [order_id](const auto& entry) {
+		return !entry.second.order_id.empty() && entry.second.order_id == order_id;
+	});
+	impl_->prepared_count.store(impl_->prepared.size(), std::memory_order_release);
+}
+
+std::size_t KalshiClient::prepared_endpoints() const {
+	return impl_->prepared_count.load(std::memory_order_acquire);
+}
+
 HttpClient& KalshiClient::http_client() {
 	return impl_->client;
 }
@@ -120,37 +422,21 @@ std::string extract_string(const std::string& json, const std::string& key) {
 	if (pos == std::string::npos)
 		return "";
 
-	pos = json.find(':', pos);
+	pos = detail::find_any<':'>(json, pos);
 	if (pos == std::string::npos)
 		return "";
 
-	pos = json.find('"', pos);
+	pos = detail::find_any<'"'>(json, pos);
 	if (pos == std::string::npos)
 		return "";
 
-	size_t start = pos + 1;
-	// Handle escaped quotes - find unescaped closing quote
-	size_t end = start;
-	while (end < json.size()) {
-		end = json.find('"', end);
-		if (end == std::string::npos)
-			return "";
-		// Check if this quote is escaped (count preceding backslashes)
-		size_t backslash_count = 0;
-		size_t check = end;
-		while (check > start && json[check - 1] == '\\') {
-			backslash_count++;
-			check--;
-		}
-		// If even number of backslashes, quote is not escaped
-		if (backslash_count % 2 == 0)
-			break;
-		end++;
-	}
-	if (end == std::string::npos || end > json.size())
+	// Escape-aware: an embedded \" does not end the string.
+	const size_t start = pos + 1;
+	const size_t end = detail::skip_json_string(json, start);
+	if (end == std::string::npos)
 		return "";
 
-	return json.substr(start, end - start);
+	return json.substr(start, end - 1 - start);
 }
 
 std::int64_t extract_int(const std::string& json, const std::string& key) {
@@ -159,7 +445,7 @@ std::int64_t extract_int(const std::string& json, const std::string& key) {
 	if (pos == std::string::npos)
 		return 0;
 
-	pos = json.find(':', pos);
+	pos = detail::find_any<':'>(json, pos);
 	if (pos == std::string::npos)
 		return 0;
 
@@ -202,6 +488,8 @@ std::int64_t extract_dollar_cents(const std::string& json, const std::string& ke
 	const std::string s = extract_string(json, key);
 	if (s.empty())
 		return 0;
+	if (std::int32_t cents = 0; detail::parse_dollars_canonical(s, cents))
+		return cents;
 	std::size_t i = 0;
 	bool negative = false;
 	if (i < s.size() && s[i] == '-') {
@@ -246,6 +534,16 @@ std::int64_t extract_cents_or_dollars(const std::string& json, const std::string
 	return extract_int(json, key);
 }
 
+/// ``extract_cents_or_dollars`` without the rounding: the exact
+/// ``<key>_dollars`` price when present, else ``<key>`` as cents.
+Price extract_price_or_cents(const std::string& json, const std::string& key) {
+	const std::string dollars_key = key + "_dollars";
+	if (json.find("\"" + dollars_key + "\"") != std::string::npos) {
+		return Price::parse(extract_string(json, dollars_key)).value_or(Price{});
+	}
+	return Price::from_cents(extract_int(json, key));
+}
+
 std::int64_t extract_fixed_point_int(const std::string& json, const std::string& key) {
 	const std::string s = extract_string(json, key);
 	if (s.empty()) {
@@ -272,7 +570,7 @@ bool extract_bool(const std::string& json, const std::string& key) {
 	if (pos == std::string::npos)
 		return false;
 
-	pos = json.find(':', pos);
+	pos = detail::find_any<':'>(json, pos);
 	if (pos == std::string::npos)
 		return false;
 
@@ -314,6 +612,8 @@ std::int64_t extract_datetime(const std::string& json, const std::string& key) {
 	int hour = parse_int(11, 2);
 	int min = parse_int(14, 2);
 	int sec = parse_int(17, 2);
+	if (month < 1 || month > 12)
+		return 0;
 
 	// Days in each month (non-leap year)
 	static const int days_in_month[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
@@ -353,40 +653,14 @@ size_t find_object_start(const std::string& json, const std::string& key) {
 	if (pos == std::string::npos)
 		return std::string::npos;
 
-	pos = json.find('{', pos);
-	return pos;
+	return detail::find_any<'{'>(json, pos);
 }
 
 // Find matching closing brace (tracks strings to avoid false matches)
 size_t find_object_end(const std::string& json, size_t start) {
 	if (start >= json.size() || json[start] != '{')
 		return std::string::npos;
-
-	int depth = 1;
-	size_t pos = start + 1;
-	bool in_string = false;
-	while (pos < json.size() && depth > 0) {
-		char c = json[pos];
-		if (c == '"' && (pos == start + 1 || json[pos - 1] != '\\')) {
-			// Check for even number of backslashes (proper escape handling)
-			size_t backslash_count = 0;
-			size_t check = pos;
-			while (check > start && json[check - 1] == '\\') {
-				backslash_count++;
-				check--;
-			}
-			if (backslash_count % 2 == 0) {
-				in_string = !in_string;
-			}
-		} else if (!in_string) {
-			if (c == '{')
-				depth++;
-			else if (c == '}')
-				depth--;
-		}
-		pos++;
-	}
-	return depth == 0 ? pos : std::string::npos;
+	return detail::find_matching_close(json, start);
 }
 
 // Find the start of a JSON array by key
@@ -396,31 +670,14 @@ size_t find_array_start(const std::string& json, const std::string& key) {
 	if (pos == std::string::npos)
 		return std::string::npos;
 
-	pos = json.find('[', pos);
-	return pos;
+	return detail::find_any<'['>(json, pos);
 }
 
 // Find matching closing bracket
 size_t find_array_end(const std::string& json, size_t start) {
 	if (start >= json.size() || json[start] != '[')
 		return std::string::npos;
-
-	int depth = 1;
-	size_t pos = start + 1;
-	bool in_string = false;
-	while (pos < json.size() && depth > 0) {
-		char c = json[pos];
-		if (c == '"' && (pos == 0 || json[pos - 1] != '\\')) {
-			in_string = !in_string;
-		} else if (!in_string) {
-			if (c == '[')
-				depth++;
-			else if (c == ']')
-				depth--;
-		}
-		pos++;
-	}
-	return depth == 0 ? pos : std::string::npos;
+	return detail::find_matching_close(json, start);
 }
 
 // Extract array elements as separate JSON strings
@@ -439,21 +696,22 @@ std::vector<std::string> extract_array_objects(const std::string& json, const st
 	if (array_end - array_start < 2)
 		return result;
 
-	std::string array_content = json.substr(array_start + 1, array_end - array_start - 2);
+	const std::string_view array_content =
+		std::string_view(json).substr(array_start + 1, array_end - array_start - 2);
 
 	// Parse individual objects
 	size_t pos = 0;
 	while (pos < array_content.size()) {
 		// Find next object start
-		size_t obj_start = array_content.find('{', pos);
+		size_t obj_start = detail::find_any<'{'>(array_content, pos);
 		if (obj_start == std::string::npos)
 			break;
 
-		size_t obj_end = find_object_end(array_content, obj_start);
+		size_t obj_end = detail::find_matching_close(array_content, obj_start);
 		if (obj_end == std::string::npos)
 			break;
 
-		result.push_back(array_content.substr(obj_start, obj_end - obj_start));
+		result.emplace_back(array_content.substr(obj_start, obj_end - obj_start));
 		pos = obj_end;
 	}
 
@@ -668,6 +926,15 @@ void append_query_param(std::string& query, const std::string& key, std::int64_t
 	query += key + "=" + std::to_string(value);
 }
 
+// GET /markets/orderbooks for one chunk of tickers
+std::string orderbooks_path(std::span<const std::string> tickers) {
+	std::string path = "/markets/orderbooks";
+	for (const std::string& ticker : tickers) {
+		append_query_param(path, "tickers", ticker);
+	}
+	return path;
+}
+
 std::optional<std::int64_t> extract_optional_datetime(const std::string& json,
 													  const std::string& key) {
 	const std::int64_t value = extract_datetime(json, key);
@@ -699,33 +966,45 @@ std::optional<std::int32_t> extract_optional_cents_or_dollars(const std::string&
 
 namespace api_detail {
 
-Market parse_market_response(std::string_view body) {
+Market parse_market_response(std::string_view body, MarketFields fields) {
 	const std::string response_body{body};
 	// Find market object (may be nested under "market" key or at root)
 	size_t market_start = find_object_start(response_body, "market");
-	std::string market_json =
-		market_start != std::string::npos
-			? response_body.substr(market_start,
-								   find_object_end(response_body, market_start) - market_start)
-			: response_body;
+	if (market_start == std::string::npos) {
+		return parse_market_object(response_body, fields);
+	}
+	return parse_market_object(
+		response_body.substr(market_start,
+							 find_object_end(response_body, market_start) - market_start),
+		fields);
+}
 
+Market parse_market_object(const std::string& market_json, MarketFields fields) {
 	Market market;
-	market.ticker = extract_string(market_json, "ticker");
-	market.title = extract_string(market_json, "title");
-	market.subtitle = extract_string(market_json, "subtitle");
-
-	std::string status_str = extract_string(market_json, "status");
-	market.status = parse_market_status(status_str);
+	if (fields.has(MarketField::Ticker))
+		market.ticker = extract_string(market_json, "ticker");
+	if (fields.has(MarketField::Title))
+		market.title = extract_string(market_json, "title");
+	if (fields.has(MarketField::Subtitle))
+		market.subtitle = extract_string(market_json, "subtitle");
+	if (fields.has(MarketField::Status))
+		market.status = parse_market_status(extract_string(market_json, "status"));
 
 	// Time fields are ISO 8601 datetime strings in the Kalshi API response
-	market.open_time = extract_datetime(market_json, "open_time");
-	market.close_time = extract_datetime(market_json, "close_time");
-	market.expected_expiration_time =
-		extract_optional_datetime(market_json, "expected_expiration_time");
-	market.expiration_time = extract_optional_datetime(market_json, "expiration_time");
-	market.latest_expiration_time =
-		extract_optional_datetime(market_json, "latest_expiration_time");
-	market.settlement_ts = extract_optional_datetime(market_json, "settlement_ts");
+	if (fields.has(MarketField::OpenTime))
+		market.open_time = extract_datetime(market_json, "open_time");
+	if (fields.has(MarketField::CloseTime))
+		market.close_time = extract_datetime(market_json, "close_time");
+	if (fields.has(MarketField::ExpectedExpirationTime))
+		market.expected_expiration_time =
+			extract_optional_datetime(market_json, "expected_expiration_time");
+	if (fields.has(MarketField::ExpirationTime))
+		market.expiration_time = extract_optional_datetime(market_json, "expiration_time");
+	if (fields.has(MarketField::LatestExpirationTime))
+		market.latest_expiration_time =
+			extract_optional_datetime(market_json, "latest_expiration_time");
+	if (fields.has(MarketField::SettlementTs))
+		market.settlement_ts = extract_optional_datetime(market_json, "settlement_ts");
 
 	// Kalshi's v2 REST schema uses ``yes_bid_dollars`` / ``yes_ask_dollars``
 	// etc. (string decimal dollars) in current responses but ``yes_bid`` /
@@ -734,40 +1013,62 @@ Market parse_market_response(std::string_view body) {
 	// the ``_dollars`` form when present. Without this, open-market
 	// rows land with 0s for every price field and the trader's
 	// scanner reports "0 executable markets".
-	market.yes_bid = static_cast<std::int32_t>(extract_cents_or_dollars(market_json, "yes_bid"));
-	market.yes_ask = static_cast<std::int32_t>(extract_cents_or_dollars(market_json, "yes_ask"));
-	market.no_bid = static_cast<std::int32_t>(extract_cents_or_dollars(market_json, "no_bid"));
-	market.no_ask = static_cast<std::int32_t>(extract_cents_or_dollars(market_json, "no_ask"));
-	market.volume = static_cast<std::int32_t>(extract_int(market_json, "volume"));
-	market.open_interest = static_cast<std::int32_t>(extract_int(market_json, "open_interest"));
-	market.settlement_timer_seconds =
-		extract_optional_int32(market_json, "settlement_timer_seconds");
-	market.settlement_value_cents =
-		extract_optional_cents_or_dollars(market_json, "settlement_value");
-
-	std::string expiration_value_str = extract_string(market_json, "expiration_value");
-	if (!expiration_value_str.empty()) {
-		market.expiration_value = expiration_value_str;
+	// The exact ``Price`` is kept alongside the cents so sub-cent quotes
+	// survive.
+	if (fields.has(MarketField::YesBid)) {
+		market.yes_bid_dollars = extract_price_or_cents(market_json, "yes_bid");
+		market.yes_bid = market.yes_bid_dollars.cents();
+	}
+	if (fields.has(MarketField::YesAsk)) {
+		market.yes_ask_dollars = extract_price_or_cents(market_json, "yes_ask");
+		market.yes_ask = market.yes_ask_dollars.cents();
+	}
+	if (fields.has(MarketField::NoBid)) {
+		market.no_bid_dollars = extract_price_or_cents(market_json, "no_bid");
+		market.no_bid = market.no_bid_dollars.cents();
+	}
+	if (fields.has(MarketField::NoAsk)) {
+		market.no_ask_dollars = extract_price_or_cents(market_json, "no_ask");
+		market.no_ask = market.no_ask_dollars.cents();
+	}
+	if (fields.has(MarketField::Volume))
+		market.volume = static_cast<std::int32_t>(extract_int(market_json, "volume"));
+	if (fields.has(MarketField::OpenInterest))
+		market.open_interest =
+			static_cast<std::int32_t>(extract_int(market_json, "open_interest"));
+	if (fields.has(MarketField::SettlementTimerSeconds))
+		market.settlement_timer_seconds =
+			extract_optional_int32(market_json, "settlement_timer_seconds");
+	if (fields.has(MarketField::SettlementValue))
+		market.settlement_value_cents =
+			extract_optional_cents_or_dollars(market_json, "settlement_value");
+
+	if (fields.has(MarketField::ExpirationValue)) {
+		std::string expiration_value_str = extract_string(market_json, "expiration_value");
+		if (!expiration_value_str.empty()) {
+			market.expiration_value = expiration_value_str;
+		}
 	}
 
-	std::string result_str = extract_string(market_json, "result");
-	if (!result_str.empty()) {
-		market.result = result_str;
+	if (fields.has(MarketField::Result)) {
+		std::string result_str = extract_string(market_json, "result");
+		if (!result_str.empty()) {
+			market.result = result_str;
+		}
 	}
 
 	return market;
 }
 
-std::vector<Market> parse_markets_response(std::string_view body) {
-	const std::string response_body{body};
+std::vector<Market> parse_markets_response(std::string_view body, MarketFields fields) {
+	// One pass over the body; each object is parsed from the splitter's
+	// reused buffer instead of a materialized vector of object strings.
 	std::vector<Market> markets;
-	std::vector<std::string> market_objects = extract_array_objects(response_body, "markets");
-	markets.reserve(market_objects.size());
-
-	for (const std::string& obj : market_objects) {
-		markets.push_back(parse_market_response(obj));
-	}
-
+	ArrayStreamParser parser("markets", [&markets, fields](const std::string& object) {
+		markets.push_back(parse_market_object(object, fields));
+		return true;
+	});
+	parser.feed(body);
 	return markets;
 }
 
@@ -807,16 +1108,22 @@ OrderBook parse_orderbook_response(std::string_view body) {
 }
 
 std::vector<OrderBook> parse_orderbooks_response(std::string_view body) {
-	const std::string response_body{body};
 	std::vector<OrderBook> books;
-	const std::vector<std::string> objs = extract_array_objects(response_body, "orderbooks");
-	books.reserve(objs.size());
-	for (const std::string& obj : objs) {
-		books.push_back(parse_orderbook_response(obj));
-	}
+	for_each_orderbook(body, [&books](const OrderBook& book) {
+		books.push_back(book);
+		return true;
+	});
 	return books;
 }
 
+std::size_t for_each_orderbook(std::string_view body, const OrderBookSink& on_book) {
+	ArrayStreamParser parser("orderbooks", [&on_book](const std::string& object) {
+		return on_book(parse_orderbook_response(object));
+	});
+	parser.feed(body);
+	return parser.objects();
+}
+
 std::vector<Candlestick> parse_candlesticks_response(std::string_view body) {
 	const std::string response_body{body};
 	std::vector<Candlestick> candlesticks;
@@ -921,26 +1228,62 @@ std::vector<Withdrawal> parse_withdrawals_response(std::string_view body) {
 	return parse_portfolio_movements<Withdrawal>(body, "withdrawals");
 }
 
-std::vector<PublicTrade> parse_trades_response(std::string_view body) {
-	const std::string buf{body};
-	const std::vector<std::string> trade_objects = extract_array_objects(buf, "trades");
-	std::vector<PublicTrade> trades;
-	trades.reserve(trade_objects.size());
-	for (const std::string& obj : trade_objects) {
-		PublicTrade t;
+PublicTrade parse_trade_object(const std::string& obj, TradeFields fields) {
+	PublicTrade t;
+	if (fields.has(TradeField::TradeId))
 		t.trade_id = extract_string(obj, "trade_id");
+	if (fields.has(TradeField::Ticker))
 		t.market_ticker = extract_string(obj, "ticker");
+	if (fields.has(TradeField::YesPrice))
 		t.yes_price = static_cast<std::int32_t>(extract_int(obj, "yes_price"));
+	if (fields.has(TradeField::NoPrice))
 		t.no_price = static_cast<std::int32_t>(extract_int(obj, "no_price"));
+	if (fields.has(TradeField::Count))
 		t.count = static_cast<std::int32_t>(extract_int(obj, "count"));
+	if (fields.has(TradeField::TakerSide))
 		t.taker_side = parse_side(extract_string(obj, "taker_side"));
+	if (fields.has(TradeField::CreatedTime))
 		t.created_time = extract_int(obj, "created_time");
+	if (fields.has(TradeField::IsBlockTrade))
 		t.is_block_trade = extract_bool(obj, "is_block_trade");
-		trades.push_back(t);
-	}
+	return t;
+}
+
+std::vector<PublicTrade> parse_trades_response(std::string_view body, TradeFields fields) {
+	std::vector<PublicTrade> trades;
+	ArrayStreamParser parser("trades", [&trades, fields](const std::string& object) {
+		trades.push_back(parse_trade_object(object, fields));
+		return true;
+	});
+	parser.feed(body);
 	return trades;
 }
 
+Fill parse_fill_object(const std::string& obj) {
+	Fill f;
+	f.trade_id = extract_string(obj, "trade_id");
+	f.order_id = extract_string(obj, "order_id");
+	f.market_ticker = extract_string(obj, "ticker");
+	f.side = parse_side(extract_string(obj, "side"));
+	f.action = parse_action(extract_string(obj, "action"));
+	f.count = static_cast<std::int32_t>(extract_int(obj, "count"));
+	f.yes_price = static_cast<std::int32_t>(extract_int(obj, "yes_price"));
+	f.no_price = static_cast<std::int32_t>(extract_int(obj, "no_price"));
+	f.created_time = extract_int(obj, "created_time");
+	f.is_taker = extract_bool(obj, "is_taker");
+	return f;
+}
+
+std::vector<Fill> parse_fills_response(std::string_view body) {
+	std::vector<Fill> fills;
+	ArrayStreamParser parser("fills", [&fills](const std::string& object) {
+		fills.push_back(parse_fill_object(object));
+		return true;
+	});
+	parser.feed(body);
+	return fills;
+}
+
 OrderCancelResult parse_order_cancel_result_response(std::string_view body) {
 	const std::string obj{body};
 	OrderCancelResult result;
@@ -980,6 +1323,28 @@ std::vector<OrderCancelResult> parse_batch_order_cancel_result_response(std::str
 	return results;
 }
 
+std::vector<std::string> parse_batch_create_errors(std::string_view body) {
+	const std::string response_body{body};
+	std::vector<std::string> errors;
+	for (const std::string& obj : extract_array_objects(response_body, "orders")) {
+		const size_t error_start = find_object_start(obj, "error");
+		if (error_start == std::string::npos) {
+			continue;
+		}
+		const size_t error_end = find_object_end(obj, error_start);
+		if (error_end == std::string::npos || error_end <= error_start) {
+			continue;
+		}
+		const std::string error_obj = obj.substr(error_start, error_end - error_start);
+		std::string message = extract_string(error_obj, "message");
+		if (message.empty()) {
+			message = extract_string(error_obj, "code");
+		}
+		errors.push_back(message.empty() ? std::string("order rejected") : std::move(message));
+	}
+	return errors;
+}
+
 AccountApiLimits parse_account_api_limits_response(std::string_view body) {
 	const std::string response_body{body};
 	AccountApiLimits result;
@@ -1037,6 +1402,43 @@ std::string build_series_query_string(const GetSeriesParams& params) {
 	return query;
 }
 
+std::string build_candlesticks_path(const GetCandlesticksParams& params) {
+	// Despite the path saying "series", it takes the event ticker.
+	std::string path =
+		"/series/" + params.event_ticker + "/markets/" + params.ticker + "/candlesticks";
+	append_query_param(path, "period_interval", params.period_interval);
+	if (params.start_ts)
+		append_query_param(path, "start_ts", *params.start_ts);
+	if (params.end_ts)
+		append_query_param(path, "end_ts", *params.end_ts);
+	return path;
+}
+
+std::string build_trades_path(const GetTradesParams& params) {
+	std::string query = "/trades";
+	if (params.limit)
+		append_query_param(query, "limit", *params.limit);
+	if (params.cursor)
+		append_query_param(query, "cursor", *params.cursor);
+	if (params.market_ticker)
+		append_query_param(query, "ticker", *params.market_ticker);
+	if (params.min_ts)
+		append_query_param(query, "min_ts", *params.min_ts);
+	if (params.max_ts)
+		append_query_param(query, "max_ts", *params.max_ts);
+	return query;
+}
+
+std::string parse_cursor(std::string_view body) {
+	return extract_cursor(std::string(body));
+}
+
+std::string build_amend_order_path(std::string_view order_id) {
+	std::string path = "/portfolio/orders/";
+	path.append(order_id).append("/amend");
+	return path;
+}
+
 std::string build_cancel_order_v2_path(const CancelOrderV2Params& params) {
 	std::string path = "/portfolio/events/orders/" + params.order_id;
 	if (params.subaccount)
@@ -1104,6 +1506,23 @@ Result<EndpointCosts> KalshiClient::get_endpoint_costs() {
 // ===== Markets API =====
 
 Result<Market> KalshiClient::get_market(const std::string& ticker) {
+	if (!impl_->metadata) {
+		return fetch_market(ticker);
+	}
+	Result<std::shared_ptr<const Market>> market = get_market_shared(ticker);
+	if (!market) {
+		return std::unexpected(market.error());
+	}
+	return **market;
+}
+
+Result<std::shared_ptr<const Market>> KalshiClient::get_market_shared(const std::string& ticker) {
+	return cached<Market>(
+		impl_->metadata.get(), [&](const MetadataCache& c) { return c.market(ticker); },
+		[&] { return fetch_market(ticker); });
+}
+
+Result<Market> KalshiClient::fetch_market(const std::string& ticker) {
 	Result<HttpResponse> response = impl_->client.get("/markets/" + ticker);
 	if (!response) {
 		return std::unexpected(response.error());
@@ -1116,15 +1535,20 @@ Result<Market> KalshiClient::get_market(const std::string& ticker) {
 				  response->status_code});
 	}
 
-	return parse_market(response->body);
+	Result<Market> market = parse_market(response->body);
+	if (market && impl_->tickers) {
+		market->ticker_id = impl_->tickers->intern(market->ticker);
+	}
+	return market;
 }
 
 Result<Market> KalshiClient::parse_market(const std::string& json) {
 	return api_detail::parse_market_response(json);
 }
 
-Result<std::vector<Market>> KalshiClient::parse_markets(const std::string& json) {
-	return api_detail::parse_markets_response(json);
+Result<std::vector<Market>> KalshiClient::parse_markets(const std::string& json,
+														MarketFields fields) {
+	return api_detail::parse_markets_response(json, fields);
 }
 
 std::string KalshiClient::build_markets_query(const GetMarketsParams& params) {
@@ -1142,13 +1566,130 @@ std::string KalshiClient::build_markets_query(const GetMarketsParams& params) {
 		append_query_param(query, "status", *params.status);
 	if (params.tickers)
 		append_query_param(query, "tickers", *params.tickers);
+	if (params.min_updated_ts)
+		append_query_param(query, "min_updated_ts", *params.min_updated_ts);
 
 	return query;
 }
 
 Result<PaginatedResponse<Market>> KalshiClient::get_markets(const GetMarketsParams& params) {
-	std::string path = build_markets_query(params);
+	const std::string path = build_markets_query(params);
 	Result<HttpResponse> response = impl_->client.get(path);
+	const ParseTimer timer(impl_->client, HttpMethod::GET, path);
+	return handle_markets(std::move(response), impl_->tickers, params.fields);
+}
+
+void KalshiClient::get_markets_async(const GetMarketsParams& params,
+									 AsyncCallback<PaginatedResponse<Market>> callback) {
+	impl_->client.request_async(HttpMethod::GET, build_markets_query(params), {},
+								[callback = std::move(callback), tickers = impl_->tickers,
+								 fields = params.fields](Result<HttpResponse> response) {
+									callback(handle_markets(std::move(response), tickers, fields));
+								});
+}
+
+std::future<Result<PaginatedResponse<Market>>>
+KalshiClient::get_markets_async(const GetMarketsParams& params) {
+	return make_future<PaginatedResponse<Market>>(
+		[&](AsyncCallback<PaginatedResponse<Market>> callback) {
+			get_markets_async(params, std::move(callback));
+		});
+}
+
+namespace {
+
+// Backs the for_each_* scans: GET ``path_of(page)`` for every page,
+// splitting the ``array_key`` array out of each body as libcurl delivers
+// it, so objects are decoded while the rest of the page is still on the
+// wire. ``on_object`` returns false to stop. Pages are followed by
+// cursor until exhausted or stopped.
+template <typename Params, typename PathOf, typename OnObject>
+Result<void> stream_pages(const HttpClient& client, Params page, const PathOf& path_of,
+						  const char* array_key, const OnObject& on_object) {
+	for (;;) {
+		bool stopped = false;
+		api_detail::ArrayStreamParser parser(array_key, [&](const std::string& object) {
+			stopped = !on_object(object);
+			return !stopped;
+		});
+		Result<HttpResponse> response =
+			client.request_stream(HttpMethod::GET, path_of(page), {},
+								  [&parser](std::string_view chunk) { return parser.feed(chunk); });
+		if (!response) {
+			return std::unexpected(response.error());
+		}
+		if (response->status_code != 200) {
+			return std::unexpected(Error{ErrorCode::ServerError,
+										 "Failed to get " + std::string(array_key) + ": " +
+											 std::to_string(response->status_code),
+										 response->status_code});
+		}
+		if (stopped || parser.cursor().empty()) {
+			return {};
+		}
+		page.cursor = parser.cursor();
+	}
+}
+
+} // anonymous namespace
+
+Result<std::size_t> KalshiClient::for_each_market(const GetMarketsParams& params,
+												  const MarketSink& sink) {
+	std::size_t delivered = 0;
+	Result<void> scanned = stream_pages(
+		impl_->client, params, &KalshiClient::build_markets_query, "markets",
+		[&](const std::string& object) {
+			Market market = api_detail::parse_market_object(object, params.fields);
+			if (impl_->tickers) {
+				market.ticker_id = impl_->tickers->intern(market.ticker);
+			}
+			++delivered;
+			return sink(market);
+		});
+	if (!scanned) {
+		return std::unexpected(scanned.error());
+	}
+	return delivered;
+}
+
+PipelinedFetch<Market> KalshiClient::markets_pipeline(GetMarketsParams params) {
+	PipelinedFetch<Market> fetch;
+	// Taken before ``params`` moves into the request lambda.
+	const MarketFields fields = params.fields;
+	fetch.request = [client = &impl_->client,
+					 params = std::move(params)](const PaginationParams& page) {
+		GetMarketsParams page_params = params;
+		page_params.limit = page.limit;
+		page_params.cursor.reset();
+		if (page.cursor && !page.cursor->empty()) {
+			page_params.cursor = page.cursor->value;
+		}
+		return client->request_async(HttpMethod::GET, build_markets_query(page_params));
+	};
+	fetch.cursor = [](const HttpResponse& response) -> std::optional<Cursor> {
+		std::string cursor = extract_cursor(response.body);
+		if (cursor.empty()) {
+			return std::nullopt;
+		}
+		return Cursor{std::move(cursor)};
+	};
+	fetch.parse = [tickers = impl_->tickers, fields](
+					  const HttpResponse& response, std::vector<Market>& out) -> Result<void> {
+		Result<std::vector<Market>> markets = parse_markets(response.body, fields);
+		if (!markets) {
+			return std::unexpected(markets.error());
+		}
+		stamp_ticker_ids(tickers, *markets);
+		out.insert(out.end(), std::make_move_iterator(markets->begin()),
+				   std::make_move_iterator(markets->end()));
+		return {};
+	};
+	return fetch;
+}
+
+Result<PaginatedResponse<Market>>
+KalshiClient::handle_markets(Result<HttpResponse> response,
+							 const std::shared_ptr<TickerTable>& tickers, MarketFields fields) {
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1160,13 +1701,14 @@ Result<PaginatedResponse<Market>> KalshiClient::get_markets(const GetMarketsPara
 				  response->status_code});
 	}
 
-	Result<std::vector<Market>> markets = parse_markets(response->body);
+	Result<std::vector<Market>> markets = parse_markets(response->body, fields);
 	if (!markets) {
 		return std::unexpected(markets.error());
 	}
 
 	PaginatedResponse<Market> result;
 	result.items = std::move(*markets);
+	stamp_ticker_ids(tickers, result.items);
 
 	std::string cursor = extract_cursor(response->body);
 	if (!cursor.empty()) {
@@ -1208,17 +1750,20 @@ KalshiClient::get_market_orderbooks(const std::vector<std::string>& tickers) {
 		return std::unexpected(
 			Error{ErrorCode::InvalidRequest, "get_market_orderbooks requires at least one ticker"});
 	}
-	if (tickers.size() > 100) {
+	if (tickers.size() > kMaxOrderbookTickers) {
 		return std::unexpected(
 			Error{ErrorCode::InvalidRequest, "get_market_orderbooks accepts at most 100 tickers"});
 	}
 
-	std::string path = "/markets/orderbooks";
-	for (const std::string& ticker : tickers) {
-		append_query_param(path, "tickers", ticker);
-	}
-
-	Result<HttpResponse> response = impl_->client.get(path);
+	std::vector<OrderBook> books;
+	books.reserve(tickers.size());
+	api_detail::ArrayStreamParser parser("orderbooks", [&books](const std::string& object) {
+		books.push_back(api_detail::parse_orderbook_response(object));
+		return true;
+	});
+	Result<HttpResponse> response = impl_->client.request_stream(
+		HttpMethod::GET, orderbooks_path(tickers), {},
+		[&parser](std::string_view chunk) { return parser.feed(chunk); });
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1230,7 +1775,88 @@ KalshiClient::get_market_orderbooks(const std::vector<std::string>& tickers) {
 				  response->status_code});
 	}
 
-	return parse_orderbooks(response->body);
+	return books;
+}
+
+Result<OrderbookRefreshStats>
+KalshiClient::refresh_orderbooks(const std::vector<std::string>& tickers, const OrderBookSink& sink,
+								 OrderbookRefreshOptions options) {
+	const std::size_t chunk_size =
+		std::clamp<std::size_t>(options.chunk_size, 1, kMaxOrderbookTickers);
+	const std::size_t max_in_flight = std::max<std::size_t>(options.max_in_flight, 1);
+	const std::size_t chunks = (tickers.size() + chunk_size - 1) / chunk_size;
+
+	// Responses land on the event-loop thread; parsing and the sink stay
+	// on this one, in completion order.
+	struct Completed {
+		std::size_t chunk;
+		Result<HttpResponse> response;
+	};
+	struct Inbox {
+		std::mutex mutex;
+		std::condition_variable ready;
+		std::deque<Completed> done;
+	};
+	const std::shared_ptr<Inbox> inbox = std::make_shared<Inbox>();
+	const std::span<const std::string> all(tickers);
+	const auto chunk_of = [&](std::size_t chunk) {
+		return all.subspan(chunk * chunk_size,
+						   std::min(chunk_size, tickers.size() - chunk * chunk_size));
+	};
+
+	OrderbookRefreshStats stats;
+	std::size_t next = 0;
+	std::size_t in_flight = 0;
+	while (in_flight > 0 || (!stats.stopped && next < chunks)) {
+		while (!stats.stopped && next < chunks && in_flight < max_in_flight) {
+			const std::size_t chunk = next++;
+			++in_flight;
+			++stats.requests;
+			impl_->client.request_async(
+				HttpMethod::GET, orderbooks_path(chunk_of(chunk)), {},
+				[inbox, chunk](Result<HttpResponse> response) {
+					{
+						std::lock_guard lock(inbox->mutex);
+						inbox->done.push_back({chunk, std::move(response)});
+					}
+					inbox->ready.notify_one();
+				});
+		}
+
+		Completed completed = [&] {
+			std::unique_lock lock(inbox->mutex);
+			inbox->ready.wait(lock, [&] { return !inbox->done.empty(); });
+			Completed front = std::move(inbox->done.front());
+			inbox->done.pop_front();
+			return front;
+		}();
+		--in_flight;
+		if (stats.stopped) {
+			continue; // Drain what is still on the wire.
+		}
+
+		std::optional<Error> failure;
+		if (!completed.response) {
+			failure = completed.response.error();
+		} else if (completed.response->status_code != 200) {
+			failure = Error{ErrorCode::ServerError,
+							"Failed to get orderbooks: " +
+								std::to_string(completed.response->status_code),
+							completed.response->status_code};
+		}
+		if (failure) {
+			const std::span<const std::string> failed = chunk_of(completed.chunk);
+			stats.failed_tickers.insert(stats.failed_tickers.end(), failed.begin(), failed.end());
+			stats.errors.push_back(std::move(failure->message));
+			continue;
+		}
+		stats.books +=
+			api_detail::for_each_orderbook(completed.response->body, [&](const OrderBook& book) {
+				stats.stopped = !sink(book);
+				return !stats.stopped;
+			});
+	}
+	return stats;
 }
 
 Result<std::vector<OrderBook>> KalshiClient::parse_orderbooks(const std::string& json) {
@@ -1240,16 +1866,7 @@ Result<std::vector<OrderBook>> KalshiClient::parse_orderbooks(const std::string&
 Result<std::vector<Candlestick>>
 KalshiClient::get_market_candlesticks(const GetCandlesticksParams& params) {
 	// Endpoint: GET /series/{event_ticker}/markets/{ticker}/candlesticks
-	// Note: Despite the path saying "series", it actually uses the event_ticker
-	std::string path =
-		"/series/" + params.event_ticker + "/markets/" + params.ticker + "/candlesticks";
-	append_query_param(path, "period_interval", params.period_interval);
-	if (params.start_ts)
-		append_query_param(path, "start_ts", *params.start_ts);
-	if (params.end_ts)
-		append_query_param(path, "end_ts", *params.end_ts);
-
-	Result<HttpResponse> response = impl_->client.get(path);
+	Result<HttpResponse> response = impl_->client.get(api_detail::build_candlesticks_path(params));
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1266,20 +1883,7 @@ KalshiClient::get_market_candlesticks(const GetCandlesticksParams& params) {
 }
 
 std::string KalshiClient::build_trades_query(const GetTradesParams& params) {
-	std::string query = "/trades";
-
-	if (params.limit)
-		append_query_param(query, "limit", *params.limit);
-	if (params.cursor)
-		append_query_param(query, "cursor", *params.cursor);
-	if (params.market_ticker)
-		append_query_param(query, "ticker", *params.market_ticker);
-	if (params.min_ts)
-		append_query_param(query, "min_ts", *params.min_ts);
-	if (params.max_ts)
-		append_query_param(query, "max_ts", *params.max_ts);
-
-	return query;
+	return api_detail::build_trades_path(params);
 }
 
 Result<PaginatedResponse<PublicTrade>> KalshiClient::get_trades(const GetTradesParams& params) {
@@ -1297,7 +1901,7 @@ Result<PaginatedResponse<PublicTrade>> KalshiClient::get_trades(const GetTradesP
 	}
 
 	PaginatedResponse<PublicTrade> result;
-	result.items = api_detail::parse_trades_response(response->body);
+	result.items = api_detail::parse_trades_response(response->body, params.fields);
 
 	std::string cursor = extract_cursor(response->body);
 	if (!cursor.empty()) {
@@ -1307,6 +1911,21 @@ Result<PaginatedResponse<PublicTrade>> KalshiClient::get_trades(const GetTradesP
 	return result;
 }
 
+Result<std::size_t> KalshiClient::for_each_trade(const GetTradesParams& params,
+												 const TradeSink& sink) {
+	std::size_t delivered = 0;
+	Result<void> scanned = stream_pages(
+		impl_->client, params, &api_detail::build_trades_path, "trades",
+		[&](const std::string& object) {
+			++delivered;
+			return sink(api_detail::parse_trade_object(object, params.fields));
+		});
+	if (!scanned) {
+		return std::unexpected(scanned.error());
+	}
+	return delivered;
+}
+
 // ===== Events API =====
 
 std::string KalshiClient::build_events_query(const GetEventsParams& params) {
@@ -1325,6 +1944,24 @@ std::string KalshiClient::build_events_query(const GetEventsParams& params) {
 }
 
 Result<Event> KalshiClient::get_event(const std::string& event_ticker) {
+	if (!impl_->metadata) {
+		return fetch_event(event_ticker);
+	}
+	Result<std::shared_ptr<const Event>> event = get_event_shared(event_ticker);
+	if (!event) {
+		return std::unexpected(event.error());
+	}
+	return **event;
+}
+
+Result<std::shared_ptr<const Event>>
+KalshiClient::get_event_shared(const std::string& event_ticker) {
+	return cached<Event>(
+		impl_->metadata.get(), [&](const MetadataCache& c) { return c.event(event_ticker); },
+		[&] { return fetch_event(event_ticker); });
+}
+
+Result<Event> KalshiClient::fetch_event(const std::string& event_ticker) {
 	Result<HttpResponse> response = impl_->client.get("/events/" + event_ticker);
 	if (!response) {
 		return std::unexpected(response.error());
@@ -1394,6 +2031,24 @@ Result<PaginatedResponse<Event>> KalshiClient::get_events(const GetEventsParams&
 // ===== Series API =====
 
 Result<Series> KalshiClient::get_series(const std::string& series_ticker) {
+	if (!impl_->metadata) {
+		return fetch_series(series_ticker);
+	}
+	Result<std::shared_ptr<const Series>> series = get_series_shared(series_ticker);
+	if (!series) {
+		return std::unexpected(series.error());
+	}
+	return **series;
+}
+
+Result<std::shared_ptr<const Series>>
+KalshiClient::get_series_shared(const std::string& series_ticker) {
+	return cached<Series>(
+		impl_->metadata.get(), [&](const MetadataCache& c) { return c.series(series_ticker); },
+		[&] { return fetch_series(series_ticker); });
+}
+
+Result<Series> KalshiClient::fetch_series(const std::string& series_ticker) {
 	Result<HttpResponse> response = impl_->client.get("/series/" + series_ticker);
 	if (!response) {
 		return std::unexpected(response.error());
@@ -1429,6 +2084,7 @@ Result<Balance> KalshiClient::get_balance() {
 	if (!response) {
 		return std::unexpected(response.error());
 	}
+	const ParseTimer timer(impl_->client, HttpMethod::GET, "/portfolio/balance");
 
 	if (response->status_code != 200) {
 		return std::unexpected(
@@ -1469,8 +2125,30 @@ std::string KalshiClient::build_positions_query(const GetPositionsParams& params
 }
 
 Result<PaginatedResponse<Position>> KalshiClient::get_positions(const GetPositionsParams& params) {
-	std::string path = build_positions_query(params);
+	const std::string path = build_positions_query(params);
 	Result<HttpResponse> response = impl_->client.get(path);
+	const ParseTimer timer(impl_->client, HttpMethod::GET, path);
+	return handle_positions(std::move(response));
+}
+
+void KalshiClient::get_positions_async(const GetPositionsParams& params,
+									   AsyncCallback<PaginatedResponse<Position>> callback) {
+	impl_->client.request_async(
+		HttpMethod::GET, build_positions_query(params), {},
+		[callback = std::move(callback)](Result<HttpResponse> response) {
+			callback(handle_positions(std::move(response)));
+		});
+}
+
+std::future<Result<PaginatedResponse<Position>>>
+KalshiClient::get_positions_async(const GetPositionsParams& params) {
+	return make_future<PaginatedResponse<Position>>(
+		[&](AsyncCallback<PaginatedResponse<Position>> callback) {
+			get_positions_async(params, std::move(callback));
+		});
+}
+
+Result<PaginatedResponse<Position>> KalshiClient::handle_positions(Result<HttpResponse> response) {
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1520,7 +2198,7 @@ std::string KalshiClient::build_orders_query(const GetOrdersParams& params) {
 	return query;
 }
 
-Result<Order> KalshiClient::parse_order(const std::string& json) {
+Result<Order> KalshiClient::parse_order(const std::string& json, OrderFields fields) {
 	// Find order object
 	size_t order_start = find_object_start(json, "order");
 	std::string order_json =
@@ -1529,34 +2207,50 @@ Result<Order> KalshiClient::parse_order(const std::string& json) {
 			: json;
 
 	Order order;
-	order.order_id = extract_string(order_json, "order_id");
-	order.market_ticker = extract_string(order_json, "ticker");
-	order.side = parse_side(extract_string(order_json, "side"));
-	order.action = parse_action(extract_string(order_json, "action"));
-
-	std::string type_str = extract_string(order_json, "type");
-	order.type = (type_str == "market") ? OrderType::Market : OrderType::Limit;
-
-	order.status = parse_order_status(extract_string(order_json, "status"));
-
-	order.initial_count = static_cast<std::int32_t>(extract_int(order_json, "original_count"));
-	if (order.initial_count == 0) {
-		order.initial_count = static_cast<std::int32_t>(extract_int(order_json, "count"));
+	if (fields.has(OrderField::OrderId))
+		order.order_id = extract_string(order_json, "order_id");
+	if (fields.has(OrderField::Ticker))
+		order.market_ticker = extract_string(order_json, "ticker");
+	if (fields.has(OrderField::Side))
+		order.side = parse_side(extract_string(order_json, "side"));
+	if (fields.has(OrderField::Action))
+		order.action = parse_action(extract_string(order_json, "action"));
+
+	if (fields.has(OrderField::Type)) {
+		std::string type_str = extract_string(order_json, "type");
+		order.type = (type_str == "market") ? OrderType::Market : OrderType::Limit;
+	}
+
+	if (fields.has(OrderField::Status))
+		order.status = parse_order_status(extract_string(order_json, "status"));
+
+	if (fields.has(OrderField::Counts)) {
+		order.initial_count =
+			static_cast<std::int32_t>(extract_int(order_json, "original_count"));
+		if (order.initial_count == 0) {
+			order.initial_count = static_cast<std::int32_t>(extract_int(order_json, "count"));
+		}
+		order.remaining_count =
+			static_cast<std::int32_t>(extract_int(order_json, "remaining_count"));
+		order.filled_count = order.initial_count - order.remaining_count;
 	}
-	order.remaining_count = static_cast<std::int32_t>(extract_int(order_json, "remaining_count"));
-	order.filled_count = order.initial_count - order.remaining_count;
 
 	// Price might be yes_price or no_price depending on side
-	order.price = static_cast<std::int32_t>(extract_int(order_json, "yes_price"));
-	if (order.price == 0) {
-		order.price = static_cast<std::int32_t>(extract_int(order_json, "no_price"));
+	if (fields.has(OrderField::Price)) {
+		order.price = static_cast<std::int32_t>(extract_int(order_json, "yes_price"));
+		if (order.price == 0) {
+			order.price = static_cast<std::int32_t>(extract_int(order_json, "no_price"));
+		}
 	}
 
-	order.created_time = extract_int(order_json, "created_time");
+	if (fields.has(OrderField::CreatedTime))
+		order.created_time = extract_int(order_json, "created_time");
 
-	std::int64_t exp = extract_int(order_json, "expiration_ts");
-	if (exp > 0) {
-		order.expiration_ts = exp;
+	if (fields.has(OrderField::ExpirationTs)) {
+		std::int64_t exp = extract_int(order_json, "expiration_ts");
+		if (exp > 0) {
+			order.expiration_ts = exp;
+		}
 	}
 
 	// V2 order-mutating endpoints (create / amend / decrease / batch_*)
@@ -1564,31 +2258,55 @@ Result<Order> KalshiClient::parse_order(const std::string& json) {
 	// wrapped `order` object (added 2026-05-05). When parse_order is
 	// called from a list endpoint each `obj` is just the order body
 	// (no ts_ms sibling) and extract_int returns 0 → leave nullopt.
-	std::int64_t ts_ms = extract_int(json, "ts_ms");
-	if (ts_ms > 0) {
-		order.mutation_ts_ms = ts_ms;
+	if (fields.has(OrderField::MutationTs)) {
+		std::int64_t ts_ms = extract_int(json, "ts_ms");
+		if (ts_ms > 0) {
+			order.mutation_ts_ms = ts_ms;
+		}
 	}
 
 	return order;
 }
 
-Result<std::vector<Order>> KalshiClient::parse_orders(const std::string& json) {
+Result<std::vector<Order>> KalshiClient::parse_orders(const std::string& json, OrderFields fields) {
 	std::vector<Order> orders;
-	std::vector<std::string> order_objects = extract_array_objects(json, "orders");
-
-	for (const std::string& obj : order_objects) {
-		Result<Order> order = parse_order(obj);
+	api_detail::ArrayStreamParser parser("orders", [&orders, fields](const std::string& object) {
+		Result<Order> order = parse_order(object, fields);
 		if (order) {
 			orders.push_back(std::move(*order));
 		}
-	}
-
+		return true;
+	});
+	parser.feed(json);
 	return orders;
 }
 
 Result<PaginatedResponse<Order>> KalshiClient::get_orders(const GetOrdersParams& params) {
-	std::string path = build_orders_query(params);
+	const std::string path = build_orders_query(params);
 	Result<HttpResponse> response = impl_->client.get(path);
+	const ParseTimer timer(impl_->client, HttpMethod::GET, path);
+	return handle_orders(std::move(response), params.fields);
+}
+
+void KalshiClient::get_orders_async(const GetOrdersParams& params,
+									AsyncCallback<PaginatedResponse<Order>> callback) {
+	impl_->client.request_async(HttpMethod::GET, build_orders_query(params), {},
+								[callback = std::move(callback),
+								 fields = params.fields](Result<HttpResponse> response) {
+									callback(handle_orders(std::move(response), fields));
+								});
+}
+
+std::future<Result<PaginatedResponse<Order>>>
+KalshiClient::get_orders_async(const GetOrdersParams& params) {
+	return make_future<PaginatedResponse<Order>>(
+		[&](AsyncCallback<PaginatedResponse<Order>> callback) {
+			get_orders_async(params, std::move(callback));
+		});
+}
+
+Result<PaginatedResponse<Order>> KalshiClient::handle_orders(Result<HttpResponse> response,
+															 OrderFields fields) {
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1600,7 +2318,7 @@ Result<PaginatedResponse<Order>> KalshiClient::get_orders(const GetOrdersParams&
 				  response->status_code});
 	}
 
-	Result<std::vector<Order>> orders = parse_orders(response->body);
+	Result<std::vector<Order>> orders = parse_orders(response->body, fields);
 	if (!orders) {
 		return std::unexpected(orders.error());
 	}
@@ -1616,6 +2334,26 @@ Result<PaginatedResponse<Order>> KalshiClient::get_orders(const GetOrdersParams&
 	return result;
 }
 
+Result<std::size_t> KalshiClient::for_each_order(const GetOrdersParams& params,
+												 const OrderSink& sink) {
+	std::size_t delivered = 0;
+	Result<void> scanned = stream_pages(
+		impl_->client, params,
+		[this](const GetOrdersParams& page) { return build_orders_query(page); }, "orders",
+		[&](const std::string& object) {
+			Result<Order> order = parse_order(object, params.fields);
+			if (!order) {
+				return true;
+			}
+			++delivered;
+			return sink(*order);
+		});
+	if (!scanned) {
+		return std::unexpected(scanned.error());
+	}
+	return delivered;
+}
+
 Result<Order> KalshiClient::get_order(const std::string& order_id) {
 	Result<HttpResponse> response = impl_->client.get("/portfolio/orders/" + order_id);
 	if (!response) {
@@ -1656,6 +2394,7 @@ Result<PaginatedResponse<Fill>> KalshiClient::get_fills(const GetFillsParams& pa
 	if (!response) {
 		return std::unexpected(response.error());
 	}
+	const ParseTimer timer(impl_->client, HttpMethod::GET, path);
 
 	if (response->status_code != 200) {
 		return std::unexpected(Error{
@@ -1663,26 +2402,8 @@ Result<PaginatedResponse<Fill>> KalshiClient::get_fills(const GetFillsParams& pa
 			response->status_code});
 	}
 
-	std::vector<Fill> fills;
-	std::vector<std::string> fill_objects = extract_array_objects(response->body, "fills");
-
-	for (const std::string& obj : fill_objects) {
-		Fill f;
-		f.trade_id = extract_string(obj, "trade_id");
-		f.order_id = extract_string(obj, "order_id");
-		f.market_ticker = extract_string(obj, "ticker");
-		f.side = parse_side(extract_string(obj, "side"));
-		f.action = parse_action(extract_string(obj, "action"));
-		f.count = static_cast<std::int32_t>(extract_int(obj, "count"));
-		f.yes_price = static_cast<std::int32_t>(extract_int(obj, "yes_price"));
-		f.no_price = static_cast<std::int32_t>(extract_int(obj, "no_price"));
-		f.created_time = extract_int(obj, "created_time");
-		f.is_taker = extract_bool(obj, "is_taker");
-		fills.push_back(f);
-	}
-
 	PaginatedResponse<Fill> result;
-	result.items = std::move(fills);
+	result.items = api_detail::parse_fills_response(response->body);
 
 	std::string cursor = extract_cursor(response->body);
 	if (!cursor.empty()) {
@@ -1692,6 +2413,22 @@ Result<PaginatedResponse<Fill>> KalshiClient::get_fills(const GetFillsParams& pa
 	return result;
 }
 
+Result<std::size_t> KalshiClient::for_each_fill(const GetFillsParams& params,
+												const FillSink& sink) {
+	std::size_t delivered = 0;
+	Result<void> scanned = stream_pages(
+		impl_->client, params,
+		[this](const GetFillsParams& page) { return build_fills_query(page); }, "fills",
+		[&](const std::string& object) {
+			++delivered;
+			return sink(api_detail::parse_fill_object(object));
+		});
+	if (!scanned) {
+		return std::unexpected(scanned.error());
+	}
+	return delivered;
+}
+
 Result<PaginatedResponse<Settlement>>
 KalshiClient::get_settlements(const GetPositionsParams& params) {
 	std::string path = "/portfolio/settlements";
@@ -1799,15 +2536,54 @@ KalshiClient::get_withdrawals(const GetPortfolioMovementParams& params) {
 
 // ===== Order Management =====
 
-std::string KalshiClient::serialize_create_order(const CreateOrderParams& params) {
+void KalshiClient::render_create_order(const CreateOrderParams& params, std::string& out) {
 	// API requires stable key order — pinned by `glz::meta<ser::CreateOrderBody>`.
-	return render_body(to_create_order_body(params));
+	render_body_to(to_create_order_body(params), out);
+}
+
+std::string KalshiClient::serialize_create_order(const CreateOrderParams& params) {
+	std::string body;
+	render_create_order(params, body);
+	return body;
 }
 
 Result<Order> KalshiClient::create_order(const CreateOrderParams& params) {
-	std::string body = serialize_create_order(params);
+	std::optional<CreateOrderParams> clipped;
+	const Result<const CreateOrderParams*> gated = gate_order(impl_->risk.get(), params, clipped);
+	if (!gated) {
+		return std::unexpected(gated.error());
+	}
+	std::string& body = order_body_buffer();
+	render_create_order(**gated, body);
+	Result<HttpResponse> response = impl_->send(HttpMethod::POST, "/portfolio/orders", body);
+	const ParseTimer timer(impl_->client, HttpMethod::POST, "/portfolio/orders");
+	return handle_create_order(std::move(response));
+}
+
+void KalshiClient::create_order_async(const CreateOrderParams& params,
+									  AsyncCallback<Order> callback) {
+	std::optional<CreateOrderParams> clipped;
+	const Result<const CreateOrderParams*> gated = gate_order(impl_->risk.get(), params, clipped);
+	if (!gated) {
+		callback(std::unexpected(gated.error()));
+		return;
+	}
+	impl_->send_async(
+		HttpMethod::POST, "/portfolio/orders", serialize_create_order(**gated),
+		[callback = std::move(callback), &http = impl_->client](Result<HttpResponse> response) {
+			callback([&] {
+				const ParseTimer timer(http, HttpMethod::POST, "/portfolio/orders");
+				return handle_create_order(std::move(response));
+			}());
+		});
+}
 
-	Result<HttpResponse> response = impl_->client.post("/portfolio/orders", body);
+std::future<Result<Order>> KalshiClient::create_order_async(const CreateOrderParams& params) {
+	return make_future<Order>(
+		[&](AsyncCallback<Order> callback) { create_order_async(params, std::move(callback)); });
+}
+
+Result<Order> KalshiClient::handle_create_order(Result<HttpResponse> response) {
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1822,7 +2598,22 @@ Result<Order> KalshiClient::create_order(const CreateOrderParams& params) {
 }
 
 Result<void> KalshiClient::cancel_order(const std::string& order_id) {
-	Result<HttpResponse> response = impl_->client.del("/portfolio/orders/" + order_id);
+	return handle_cancel_order(impl_->client.del("/portfolio/orders/" + order_id));
+}
+
+void KalshiClient::cancel_order_async(const std::string& order_id, AsyncCallback<void> callback) {
+	impl_->client.request_async(HttpMethod::DEL, "/portfolio/orders/" + order_id, {},
+								[callback = std::move(callback)](Result<HttpResponse> response) {
+									callback(handle_cancel_order(std::move(response)));
+								});
+}
+
+std::future<Result<void>> KalshiClient::cancel_order_async(const std::string& order_id) {
+	return make_future<void>(
+		[&](AsyncCallback<void> callback) { cancel_order_async(order_id, std::move(callback)); });
+}
+
+Result<void> KalshiClient::handle_cancel_order(Result<HttpResponse> response) {
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1837,8 +2628,8 @@ Result<void> KalshiClient::cancel_order(const std::string& order_id) {
 }
 
 Result<OrderCancelResult> KalshiClient::cancel_order_v2(const CancelOrderV2Params& params) {
-	Result<HttpResponse> response =
-		impl_->client.del(api_detail::build_cancel_order_v2_path(params));
+	const std::string path = api_detail::build_cancel_order_v2_path(params);
+	Result<HttpResponse> response = impl_->send(HttpMethod::DEL, path, {});
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1849,6 +2640,9 @@ Result<OrderCancelResult> KalshiClient::cancel_order_v2(const CancelOrderV2Param
 									 response->status_code});
 	}
 
+	if (impl_->prepared_count.load(std::memory_order_acquire) != 0) {
+		impl_->release(path);
+	}
 	return api_detail::parse_order_cancel_result_response(response->body);
 }
 
@@ -1862,10 +2656,28 @@ std::string KalshiClient::serialize_amend_order(const AmendOrderParams& params)
 }
 
 Result<Order> KalshiClient::amend_order(const AmendOrderParams& params) {
-	std::string body = serialize_amend_order(params);
-
+	const std::string path = api_detail::build_amend_order_path(params.order_id);
 	Result<HttpResponse> response =
-		impl_->client.post("/portfolio/orders/" + params.order_id + "/amend", body);
+		impl_->send(HttpMethod::POST, path, serialize_amend_order(params));
+	const ParseTimer timer(impl_->client, HttpMethod::POST, path);
+	return handle_amend_order(std::move(response));
+}
+
+void KalshiClient::amend_order_async(const AmendOrderParams& params,
+									 AsyncCallback<Order> callback) {
+	impl_->send_async(HttpMethod::POST, api_detail::build_amend_order_path(params.order_id),
+					  serialize_amend_order(params),
+					  [callback = std::move(callback)](Result<HttpResponse> response) {
+						  callback(handle_amend_order(std::move(response)));
+					  });
+}
+
+std::future<Result<Order>> KalshiClient::amend_order_async(const AmendOrderParams& params) {
+	return make_future<Order>(
+		[&](AsyncCallback<Order> callback) { amend_order_async(params, std::move(callback)); });
+}
+
+Result<Order> KalshiClient::handle_amend_order(Result<HttpResponse> response) {
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1888,11 +2700,12 @@ std::string KalshiClient::serialize_decrease_order(const DecreaseOrderParams& pa
 Result<Order> KalshiClient::decrease_order(const DecreaseOrderParams& params) {
 	std::string body = serialize_decrease_order(params);
 
-	Result<HttpResponse> response =
-		impl_->client.post("/portfolio/orders/" + params.order_id + "/decrease", body);
+	const std::string path = "/portfolio/orders/" + params.order_id + "/decrease";
+	Result<HttpResponse> response = impl_->client.post(path, body);
 	if (!response) {
 		return std::unexpected(response.error());
 	}
+	const ParseTimer timer(impl_->client, HttpMethod::POST, path);
 
 	if (response->status_code != 200) {
 		return std::unexpected(Error{ErrorCode::ServerError,
@@ -1903,23 +2716,66 @@ Result<Order> KalshiClient::decrease_order(const DecreaseOrderParams& params) {
 	return parse_order(response->body);
 }
 
-std::string KalshiClient::serialize_batch_create(const BatchOrderRequest& request) {
+void KalshiClient::render_batch_create(const BatchOrderRequest& request, std::string& out) {
 	// API requires stable key order in embedded order objects — pinned by
 	// `glz::meta<ser::CreateOrderBody>`. The pre-migration impl serialized
 	// each order to a string and parsed it back into an ordered_json node;
 	// here we just build the same struct vector and let Glaze emit it.
-	ser::BatchOrdersBody body;
-	body.orders.reserve(request.orders.size());
+	// The vector is per-thread so its capacity carries over between calls.
+	thread_local ser::BatchOrdersBody body;
+	body.orders.clear();
 	for (const CreateOrderParams& order : request.orders) {
 		body.orders.push_back(to_create_order_body(order));
 	}
-	return render_body(body);
+	render_body_to(body, out);
+	body.orders.clear(); // Drop the views into ``request``.
 }
 
-Result<BatchResponse<Order>> KalshiClient::batch_create_orders(const BatchOrderRequest& request) {
-	std::string body = serialize_batch_create(request);
+std::string KalshiClient::serialize_batch_create(const BatchOrderRequest& request) {
+	std::string body;
+	render_batch_create(request, body);
+	return body;
+}
 
+Result<BatchResponse<Order>> KalshiClient::batch_create_orders(const BatchOrderRequest& request) {
+	std::optional<BatchOrderRequest> clipped;
+	const Result<const BatchOrderRequest*> gated = gate_batch(impl_->risk.get(), request, clipped);
+	if (!gated) {
+		return std::unexpected(gated.error());
+	}
+	std::string& body = order_body_buffer();
+	render_batch_create(**gated, body);
 	Result<HttpResponse> response = impl_->client.post("/portfolio/orders/batched", body);
+	const ParseTimer timer(impl_->client, HttpMethod::POST, "/portfolio/orders/batched");
+	return handle_batch_create(std::move(response));
+}
+
+void KalshiClient::batch_create_orders_async(const BatchOrderRequest& request,
+											 AsyncCallback<BatchResponse<Order>> callback) {
+	std::optional<BatchOrderRequest> clipped;
+	const Result<const BatchOrderRequest*> gated = gate_batch(impl_->risk.get(), request, clipped);
+	if (!gated) {
+		callback(std::unexpected(gated.error()));
+		return;
+	}
+	impl_->client.request_async(
+		HttpMethod::POST, "/portfolio/orders/batched", serialize_batch_create(**gated),
+		[callback = std::move(callback), &http = impl_->client](Result<HttpResponse> response) {
+			callback([&] {
+				const ParseTimer timer(http, HttpMethod::POST, "/portfolio/orders/batched");
+				return handle_batch_create(std::move(response));
+			}());
+		});
+}
+
+std::future<Result<BatchResponse<Order>>>
+KalshiClient::batch_create_orders_async(const BatchOrderRequest& request) {
+	return make_future<BatchResponse<Order>>([&](AsyncCallback<BatchResponse<Order>> callback) {
+		batch_create_orders_async(request, std::move(callback));
+	});
+}
+
+Result<BatchResponse<Order>> KalshiClient::handle_batch_create(Result<HttpResponse> response) {
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1935,6 +2791,7 @@ Result<BatchResponse<Order>> KalshiClient::batch_create_orders(const BatchOrderR
 	if (orders) {
 		result.results = std::move(*orders);
 	}
+	result.errors = api_detail::parse_batch_create_errors(response->body);
 
 	return result;
 }
@@ -1957,9 +2814,32 @@ std::string KalshiClient::serialize_batch_cancel(const BatchCancelRequest& reque
 
 Result<BatchResponse<std::string>>
 KalshiClient::batch_cancel_orders(const BatchCancelRequest& request) {
-	std::string body = serialize_batch_cancel(request);
+	return handle_batch_cancel(
+		impl_->client.del("/portfolio/orders/batched", serialize_batch_cancel(request)),
+		batch_cancel_result_ids(request));
+}
 
-	Result<HttpResponse> response = impl_->client.del("/portfolio/orders/batched", body);
+void KalshiClient::batch_cancel_orders_async(const BatchCancelRequest& request,
+											 AsyncCallback<BatchResponse<std::string>> callback) {
+	impl_->client.request_async(
+		HttpMethod::DEL, "/portfolio/orders/batched", serialize_batch_cancel(request),
+		[callback = std::move(callback),
+		 ids = batch_cancel_result_ids(request)](Result<HttpResponse> response) mutable {
+			callback(handle_batch_cancel(std::move(response), std::move(ids)));
+		});
+}
+
+std::future<Result<BatchResponse<std::string>>>
+KalshiClient::batch_cancel_orders_async(const BatchCancelRequest& request) {
+	return make_future<BatchResponse<std::string>>(
+		[&](AsyncCallback<BatchResponse<std::string>> callback) {
+			batch_cancel_orders_async(request, std::move(callback));
+		});
+}
+
+Result<BatchResponse<std::string>>
+KalshiClient::handle_batch_cancel(Result<HttpResponse> response,
+								  std::vector<std::string> requested_ids) {
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -1971,15 +2851,35 @@ KalshiClient::batch_cancel_orders(const BatchCancelRequest& request) {
 	}
 
 	BatchResponse<std::string> result;
-	result.results = batch_cancel_result_ids(request); // Assume all requested IDs cancelled if 200
+	result.results = std::move(requested_ids); // Assume all requested IDs cancelled if 200
 	return result;
 }
 
 Result<BatchResponse<OrderCancelResult>>
 KalshiClient::batch_cancel_orders_v2(const BatchCancelRequest& request) {
-	std::string body = serialize_batch_cancel(request);
+	return handle_batch_cancel_v2(
+		impl_->client.del("/portfolio/events/orders/batched", serialize_batch_cancel(request)));
+}
 
-	Result<HttpResponse> response = impl_->client.del("/portfolio/events/orders/batched", body);
+void KalshiClient::batch_cancel_orders_v2_async(
+	const BatchCancelRequest& request, AsyncCallback<BatchResponse<OrderCancelResult>> callback) {
+	impl_->client.request_async(HttpMethod::DEL, "/portfolio/events/orders/batched",
+								serialize_batch_cancel(request),
+								[callback = std::move(callback)](Result<HttpResponse> response) {
+									callback(handle_batch_cancel_v2(std::move(response)));
+								});
+}
+
+std::future<Result<BatchResponse<OrderCancelResult>>>
+KalshiClient::batch_cancel_orders_v2_async(const BatchCancelRequest& request) {
+	return make_future<BatchResponse<OrderCancelResult>>(
+		[&](AsyncCallback<BatchResponse<OrderCancelResult>> callback) {
+			batch_cancel_orders_v2_async(request, std::move(callback));
+		});
+}
+
+Result<BatchResponse<OrderCancelResult>>
+KalshiClient::handle_batch_cancel_v2(Result<HttpResponse> response) {
 	if (!response) {
 		return std::unexpected(response.error());
 	}
@@ -2073,6 +2973,25 @@ Result<std::vector<Announcement>> KalshiClient::get_exchange_announcements() {
 // ===== Phase 2: Events/Series API =====
 
 Result<EventMetadata> KalshiClient::get_event_metadata(const std::string& event_ticker) {
+	if (!impl_->metadata) {
+		return fetch_event_metadata(event_ticker);
+	}
+	Result<std::shared_ptr<const EventMetadata>> metadata = get_event_metadata_shared(event_ticker);
+	if (!metadata) {
+		return std::unexpected(metadata.error());
+	}
+	return **metadata;
+}
+
+Result<std::shared_ptr<const EventMetadata>>
+KalshiClient::get_event_metadata_shared(const std::string& event_ticker) {
+	return cached<EventMetadata>(
+		impl_->metadata.get(),
+		[&](const MetadataCache& c) { return c.event_metadata(event_ticker); },
+		[&] { return fetch_event_metadata(event_ticker); });
+}
+
+Result<EventMetadata> KalshiClient::fetch_event_metadata(const std::string& event_ticker) {
 	Result<HttpResponse> response = impl_->client.get("/events/" + event_ticker + "/metadata");
 	if (!response) {
 		return std::unexpected(response.error());
@@ -2901,6 +3820,7 @@ Result<PaginatedResponse<Market>> KalshiClient::search_markets(const SearchParam
 			result.items.push_back(*market);
 		}
 	}
+	stamp_ticker_ids(impl_->tickers, result.items);
 
 	return result;
 }
@@ -0,0 +1,829 @@
+#include "kalshi/history_cache.hpp"
+
+#include "kalshi/http_client.hpp"
+
+#include "mapped_file.hpp"
+#include "query_builders.hpp"
+#include "response_parsers.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <system_error>
+#include <utility>
+
+namespace kalshi {
+
+namespace {
+
+using api_detail::map_file;
+using api_detail::Mapping;
+using api_detail::padded;
+using api_detail::write_file_atomically;
+
+// File layout: a 64-byte header, then one array per field, each padded to
+// 8 bytes so every column is aligned for its element type.
+//
+//   0  magic "KALSHIHC"     16  u64 record count
+//   8  u16 version          24  u32 flags (bit 0: covered range valid)
+//  10  u16 series kind      32  i64 covered.from
+//  12  i32 candle interval  40  i64 covered.to
+constexpr std::string_view kMagic{"KALSHIHC"};
+constexpr std::uint16_t kVersion = 1;
+constexpr std::size_t kHeaderSize = 64;
+constexpr std::uint32_t kFlagCovered = 1;
+
+enum class SeriesKind : std::uint16_t { Candles = 1, Trades = 2 };
+
+// Element widths: timestamp, open, high, low, close, volume.
+constexpr std::array<std::size_t, 6> kCandleWidths{8, 4, 4, 4, 4, 4};
+// Element widths: timestamp, yes price, count, taker side, block flag.
+constexpr std::array<std::size_t, 5> kTradeWidths{8, 4, 4, 1, 1};
+
+struct FileHeader {
+	SeriesKind kind{SeriesKind::Candles};
+	std::int32_t interval{0};
+	std::uint64_t count{0};
+	std::optional<HistoryRange> covered;
+};
+
+// A validated cache file and where each of its columns starts.
+struct SeriesFile {
+	FileHeader header;
+	std::shared_ptr<const Mapping> mapping;
+	std::vector<const char*> columns;
+};
+
+Error file_error(std::string what, const std::string& path) {
+	return Error{ErrorCode::InvalidRequest, std::move(what) + ": " + path};
+}
+
+std::size_t columns_size(std::span<const std::size_t> widths, std::uint64_t count) {
+	std::size_t total = 0;
+	for (const std::size_t width : widths) {
+		total += padded(width * static_cast<std::size_t>(count));
+	}
+	return total;
+}
+
+// Missing file: nullopt. Present but unreadable, foreign or truncated: an
+// error, so a damaged cache is reported rather than silently refetched.
+Result<std::optional<SeriesFile>> read_series(const std::string& path, SeriesKind kind,
+											  std::int32_t interval,
+											  std::span<const std::size_t> widths) {
+	std::error_code ec;
+	if (!std::filesystem::exists(path, ec)) {
+		return std::optional<SeriesFile>{};
+	}
+	std::shared_ptr<const Mapping> mapping = map_file(path);
+	if (!mapping || mapping->size < kHeaderSize ||
+		std::memcmp(mapping->data, kMagic.data(), kMagic.size()) != 0) {
+		return std::unexpected(Error::parse("Not a history cache file: " + path));
+	}
+	const char* data = mapping->data;
+	std::uint16_t version = 0;
+	std::uint16_t stored_kind = 0;
+	std::uint32_t flags = 0;
+	SeriesFile file;
+	std::memcpy(&version, data + 8, sizeof(version));
+	std::memcpy(&stored_kind, data + 10, sizeof(stored_kind));
+	std::memcpy(&file.header.interval, data + 12, sizeof(file.header.interval));
+	std::memcpy(&file.header.count, data + 16, sizeof(file.header.count));
+	std::memcpy(&flags, data + 24, sizeof(flags));
+	if (version != kVersion) {
+		return std::unexpected(Error::parse("Unsupported history cache version: " + path));
+	}
+	if (stored_kind != static_cast<std::uint16_t>(kind) || file.header.interval != interval) {
+		return std::unexpected(Error::parse("History cache file holds another series: " + path));
+	}
+	if (file.header.count > (mapping->size - kHeaderSize) ||
+		kHeaderSize + columns_size(widths, file.header.count) > mapping->size) {
+		return std::unexpected(Error::parse("Truncated history cache file: " + path));
+	}
+	file.header.kind = kind;
+	if ((flags & kFlagCovered) != 0) {
+		HistoryRange covered;
+		std::memcpy(&covered.from, data + 32, sizeof(covered.from));
+		std::memcpy(&covered.to, data + 40, sizeof(covered.to));
+		file.header.covered = covered;
+	}
+	const char* column = data + kHeaderSize;
+	for (const std::size_t width : widths) {
+		file.columns.push_back(column);
+		column += padded(width * static_cast<std::size_t>(file.header.count));
+	}
+	file.mapping = std::move(mapping);
+	return std::optional<SeriesFile>{std::move(file)};
+}
+
+// Writes next to `path` and renames over it, so a reader (or a crash)
+// never sees half a file.
+Result<void> write_series(const std::string& path, const FileHeader& header,
+						  std::span<const std::span<const std::byte>> columns) {
+	char head[kHeaderSize]{};
+	const std::uint16_t version = kVersion;
+	const std::uint16_t kind = static_cast<std::uint16_t>(header.kind);
+	const std::uint32_t flags = header.covered ? kFlagCovered : 0;
+	std::memcpy(head, kMagic.data(), kMagic.size());
+	std::memcpy(head + 8, &version, sizeof(version));
+	std::memcpy(head + 10, &kind, sizeof(kind));
+	std::memcpy(head + 12, &header.interval, sizeof(header.interval));
+	std::memcpy(head + 16, &header.count, sizeof(header.count));
+	std::memcpy(head + 24, &flags, sizeof(flags));
+	if (header.covered) {
+		std::memcpy(head + 32, &header.covered->from, sizeof(header.covered->from));
+		std::memcpy(head + 40, &header.covered->to, sizeof(header.covered->to));
+	}
+
+	std::vector<std::span<const std::byte>> chunks;
+	chunks.reserve(columns.size() + 1);
+	chunks.push_back(std::as_bytes(std::span<const char>(head)));
+	chunks.insert(chunks.end(), columns.begin(), columns.end());
+	if (!write_file_atomically(path, chunks)) {
+		return std::unexpected(file_error("Failed to write history cache", path));
+	}
+	return {};
+}
+
+template <typename T> std::span<const T> column_of(const SeriesFile& file, std::size_t index) {
+	return {reinterpret_cast<const T*>(file.columns[index]),
+			static_cast<std::size_t>(file.header.count)};
+}
+
+template <typename T> std::span<const std::byte> bytes_of(const std::vector<T>& column) {
+	return std::as_bytes(std::span<const T>(column));
+}
+
+CandleHistory candle_view(const SeriesFile& file) {
+	CandleHistory history;
+	history.timestamps = column_of<std::int64_t>(file, 0);
+	history.open = column_of<std::int32_t>(file, 1);
+	history.high = column_of<std::int32_t>(file, 2);
+	history.low = column_of<std::int32_t>(file, 3);
+	history.close = column_of<std::int32_t>(file, 4);
+	history.volume = column_of<std::int32_t>(file, 5);
+	history.covered = file.header.covered;
+	history.storage = file.mapping;
+	return history;
+}
+
+TradeHistory trade_view(const SeriesFile& file) {
+	TradeHistory history;
+	history.timestamps = column_of<std::int64_t>(file, 0);
+	history.yes_prices = column_of<std::int32_t>(file, 1);
+	history.counts = column_of<std::int32_t>(file, 2);
+	history.taker_sides = column_of<Side>(file, 3);
+	history.block_trades = column_of<std::uint8_t>(file, 4);
+	history.covered = file.header.covered;
+	history.storage = file.mapping;
+	return history;
+}
+
+// [lo, hi) of the rows whose timestamp falls in `range`.
+std::pair<std::size_t, std::size_t> rows_in(std::span<const std::int64_t> timestamps,
+											HistoryRange range) {
+	const auto lo = std::lower_bound(timestamps.begin(), timestamps.end(), range.from);
+	const auto hi = std::upper_bound(lo, timestamps.end(), range.to);
+	return {static_cast<std::size_t>(lo - timestamps.begin()),
+			static_cast<std::size_t>(hi - timestamps.begin())};
+}
+
+CandleHistory slice(CandleHistory history, HistoryRange range) {
+	const auto [lo, hi] = rows_in(history.timestamps, range);
+	const std::size_t n = hi - lo;
+	history.timestamps = history.timestamps.subspan(lo, n);
+	history.open = history.open.subspan(lo, n);
+	history.high = history.high.subspan(lo, n);
+	history.low = history.low.subspan(lo, n);
+	history.close = history.close.subspan(lo, n);
+	history.volume = history.volume.subspan(lo, n);
+	return history;
+}
+
+TradeHistory slice(TradeHistory history, HistoryRange range) {
+	const auto [lo, hi] = rows_in(history.timestamps, range);
+	const std::size_t n = hi - lo;
+	history.timestamps = history.timestamps.subspan(lo, n);
+	history.yes_prices = history.yes_prices.subspan(lo, n);
+	history.counts = history.counts.subspan(lo, n);
+	history.taker_sides = history.taker_sides.subspan(lo, n);
+	history.block_trades = history.block_trades.subspan(lo, n);
+	return history;
+}
+
+bool replaced(std::int64_t ts, std::span<const HistoryRange> windows) {
+	return std::any_of(windows.begin(), windows.end(), [ts](const HistoryRange& window) {
+		return ts >= window.from && ts <= window.to;
+	});
+}
+
+// Cached rows outside `windows` plus `fresh`, by timestamp. Rows with equal
+// timestamps keep their order (cached first), so a trade stream stays in
+// the order the exchange listed it.
+template <typename Row, typename Timestamp>
+std::vector<Row> merge_rows(std::vector<Row> cached, std::vector<Row> fresh,
+							std::span<const HistoryRange> windows, Timestamp timestamp_of) {
+	std::erase_if(cached, [&](const Row& row) { return replaced(timestamp_of(row), windows); });
+	cached.insert(cached.end(), std::make_move_iterator(fresh.begin()),
+				  std::make_move_iterator(fresh.end()));
+	std::stable_sort(cached.begin(), cached.end(), [&](const Row& a, const Row& b) {
+		return timestamp_of(a) < timestamp_of(b);
+	});
+	return cached;
+}
+
+std::vector<Candlestick> candle_rows(const CandleHistory& history) {
+	std::vector<Candlestick> rows(history.size());
+	for (std::size_t i = 0; i < rows.size(); ++i) {
+		rows[i] = {history.timestamps[i], history.open[i],	history.close[i],
+				   history.high[i],		  history.low[i],	history.volume[i]};
+	}
+	return rows;
+}
+
+// The columns of a trade, in file order.
+struct TradeRow {
+	std::int64_t timestamp{0};
+	std::int32_t yes_price{0};
+	std::int32_t count{0};
+	Side taker_side{Side::Yes};
+	std::uint8_t block{0};
+};
+
+TradeRow trade_row(const PublicTrade& trade) {
+	return {trade.created_time, trade.yes_price, trade.count, trade.taker_side,
+			static_cast<std::uint8_t>(trade.is_block_trade ? 1 : 0)};
+}
+
+std::vector<TradeRow> trade_rows(const TradeHistory& history) {
+	std::vector<TradeRow> rows(history.size());
+	for (std::size_t i = 0; i < rows.size(); ++i) {
+		rows[i] = {history.timestamps[i], history.yes_prices[i], history.counts[i],
+				   history.taker_sides[i], history.block_trades[i]};
+	}
+	return rows;
+}
+
+// Covered range after storing `range` on top of `covered`.
+HistoryRange grow(const std::optional<HistoryRange>& covered, HistoryRange range) {
+	if (!covered || range.to < covered->from - 1 || range.from > covered->to + 1) {
+		return range;
+	}
+	return {std::min(covered->from, range.from), std::max(covered->to, range.to)};
+}
+
+// What a load of `want` has to fetch given what is `covered`: the part
+// before it and the part after it. Anything between them and `covered`
+// is included, so coverage stays one contiguous range.
+std::vector<HistoryRange> missing(const std::optional<HistoryRange>& covered, HistoryRange want) {
+	if (!covered) {
+		return {want};
+	}
+	std::vector<HistoryRange> pieces;
+	if (want.from < covered->from) {
+		pieces.push_back({want.from, std::max(want.from, covered->from - 1)});
+	}
+	if (want.to > covered->to) {
+		pieces.push_back({std::min(want.to, covered->to + 1), want.to});
+	}
+	return pieces;
+}
+
+// Covered range once the pieces of `want` are fetched: the newest
+// `settle_lag` before `now` is left out so it is fetched again next time.
+std::optional<HistoryRange> covered_after(const std::optional<HistoryRange>& covered,
+										  HistoryRange want, std::int64_t settled_until) {
+	const std::int64_t to = std::min(want.to, settled_until);
+	if (!covered) {
+		return to >= want.from ? std::optional<HistoryRange>{HistoryRange{want.from, to}}
+							   : std::nullopt;
+	}
+	const HistoryRange hull{std::min(covered->from, want.from), std::max(covered->to, to)};
+	return hull;
+}
+
+std::string sanitized(std::string_view ticker) {
+	std::string name(ticker);
+	for (char& c : name) {
+		const bool keep = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+						  (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.';
+		if (!keep) {
+			c = '_';
+		}
+	}
+	return name;
+}
+
+// One request's worth of a series: a time window and, for trades, the
+// cursor of the next page.
+struct Window {
+	std::size_t series{0};
+	HistoryRange range;
+	std::string cursor;
+};
+
+} // namespace
+
+struct HistoryCache::Impl {
+	HistoryCacheConfig config;
+	std::filesystem::path directory;
+
+	std::atomic<std::uint64_t> requests{0};
+	std::atomic<std::uint64_t> records_fetched{0};
+	std::atomic<std::uint64_t> cache_hits{0};
+	std::atomic<std::uint64_t> files_written{0};
+
+	[[nodiscard]] std::string candle_path(std::string_view ticker, std::int32_t interval) const {
+		return (directory / (sanitized(ticker) + "." + std::to_string(interval) + "m.candles"))
+			.string();
+	}
+
+	[[nodiscard]] std::string trade_path(std::string_view ticker) const {
+		return (directory / (sanitized(ticker) + ".trades")).string();
+	}
+
+	[[nodiscard]] Result<CandleHistory> read_candles(std::string_view ticker,
+													 std::int32_t interval) const {
+		Result<std::optional<SeriesFile>> file = read_series(
+			candle_path(ticker, interval), SeriesKind::Candles, interval, kCandleWidths);
+		if (!file) {
+			return std::unexpected(file.error());
+		}
+		return *file ? candle_view(**file) : CandleHistory{};
+	}
+
+	[[nodiscard]] Result<TradeHistory> read_trades(std::string_view ticker) const {
+		Result<std::optional<SeriesFile>> file =
+			read_series(trade_path(ticker), SeriesKind::Trades, 0, kTradeWidths);
+		if (!file) {
+			return std::unexpected(file.error());
+		}
+		return *file ? trade_view(**file) : TradeHistory{};
+	}
+
+	Result<CandleHistory> write_candles(std::string_view ticker, std::int32_t interval,
+										const std::vector<Candlestick>& rows,
+										std::optional<HistoryRange> covered) {
+		std::vector<std::int64_t> timestamps(rows.size());
+		std::array<std::vector<std::int32_t>, 5> fields;
+		for (std::vector<std::int32_t>& field : fields) {
+			field.resize(rows.size());
+		}
+		for (std::size_t i = 0; i < rows.size(); ++i) {
+			timestamps[i] = rows[i].timestamp;
+			fields[0][i] = rows[i].open_price;
+			fields[1][i] = rows[i].high_price;
+			fields[2][i] = rows[i].low_price;
+			fields[3][i] = rows[i].close_price;
+			fields[4][i] = rows[i].volume;
+		}
+		const std::array<std::span<const std::byte>, 6> columns{
+			bytes_of(timestamps), bytes_of(fields[0]), bytes_of(fields[1]),
+			bytes_of(fields[2]),  bytes_of(fields[3]), bytes_of(fields[4])};
+		const FileHeader header{SeriesKind::Candles, interval, rows.size(), covered};
+		if (Result<void> written = write_series(candle_path(ticker, interval), header, columns);
+			!written) {
+			return std::unexpected(written.error());
+		}
+		files_written.fetch_add(1, std::memory_order_relaxed);
+		return read_candles(ticker, interval);
+	}
+
+	Result<TradeHistory> write_trades(std::string_view ticker, const std::vector<TradeRow>& rows,
+									  std::optional<HistoryRange> covered) {
+		std::vector<std::int64_t> timestamps(rows.size());
+		std::vector<std::int32_t> prices(rows.size());
+		std::vector<std::int32_t> counts(rows.size());
+		std::vector<Side> sides(rows.size());
+		std::vector<std::uint8_t> blocks(rows.size());
+		for (std::size_t i = 0; i < rows.size(); ++i) {
+			timestamps[i] = rows[i].timestamp;
+			prices[i] = rows[i].yes_price;
+			counts[i] = rows[i].count;
+			sides[i] = rows[i].taker_side;
+			blocks[i] = rows[i].block;
+		}
+		const std::array<std::span<const std::byte>, 5> columns{
+			bytes_of(timestamps), bytes_of(prices), bytes_of(counts), bytes_of(sides),
+			bytes_of(blocks)};
+		const FileHeader header{SeriesKind::Trades, 0, rows.size(), covered};
+		if (Result<void> written = write_series(trade_path(ticker), header, columns); !written) {
+			return std::unexpected(written.error());
+		}
+		files_written.fetch_add(1, std::memory_order_relaxed);
+		return read_trades(ticker);
+	}
+
+	[[nodiscard]] std::int64_t settled_until() const {
+		const std::chrono::system_clock::duration now =
+			std::chrono::system_clock::now().time_since_epoch();
+		return std::chrono::duration_cast<std::chrono::seconds>(now).count() -
+			   config.settle_lag.count();
+	}
+
+	// Sends every window, plus the follow-up pages `handle` asks for, with
+	// at most max_in_flight outstanding. Responses land on the HTTP
+	// event-loop thread; `handle` runs on this one, in completion order,
+	// and returns the window of the next page if there is one. A series'
+	// first failure is kept and its remaining windows are skipped.
+	void fetch(HttpClient& http, std::deque<Window> pending,
+			   const std::function<std::string(const Window&)>& path_of,
+			   const std::function<std::optional<Window>(const Window&, std::string_view)>& handle,
+			   std::string_view what, std::vector<std::optional<Error>>& failures) {
+		struct Completed {
+			Window window;
+			Result<HttpResponse> response;
+		};
+		struct Inbox {
+			std::mutex mutex;
+			std::condition_variable ready;
+			std::deque<Completed> done;
+		};
+		const std::shared_ptr<Inbox> inbox = std::make_shared<Inbox>();
+		const std::size_t max_in_flight = std::max<std::size_t>(config.max_in_flight, 1);
+		std::size_t in_flight = 0;
+		while (in_flight > 0 || !pending.empty()) {
+			while (!pending.empty() && in_flight < max_in_flight) {
+				Window window = std::move(pending.front());
+				pending.pop_front();
+				if (failures[window.series]) {
+					continue;
+				}
+				++in_flight;
+				requests.fetch_add(1, std::memory_order_relaxed);
+				std::string path = path_of(window);
+				http.request_async(HttpMethod::GET, std::move(path), {},
+								   [inbox, window](Result<HttpResponse> response) mutable {
+									   {
+										   std::lock_guard lock(inbox->mutex);
+										   inbox->done.push_back(
+											   {std::move(window), std::move(response)});
+									   }
+									   inbox->ready.notify_one();
+								   });
+			}
+			if (in_flight == 0) {
+				break;
+			}
+
+			Completed completed = [&] {
+				std::unique_lock lock(inbox->mutex);
+				inbox->ready.wait(lock, [&] { return !inbox->done.empty(); });
+				Completed front = std::move(inbox->done.front());
+				inbox->done.pop_front();
+				return front;
+			}();
+			--in_flight;
+			std::optional<Error>& failure = failures[completed.window.series];
+			if (failure) {
+				continue;
+			}
+			if (!completed.response) {
+				failure = completed.response.error();
+			} else if (completed.response->status_code != 200) {
+				failure = Error{ErrorCode::ServerError,
+								"Failed to get " + std::string(what) + ": HTTP " +
+									std::to_string(completed.response->status_code),
+								completed.response->status_code};
+			} else if (std::optional<Window> next =
+						   handle(completed.window, completed.response->body)) {
+				pending.push_front(std::move(*next));
+			}
+		}
+	}
+};
+
+Result<HistoryCache> HistoryCache::open(HistoryCacheConfig config) {
+	if (config.directory.empty()) {
+		return std::unexpected(
+			Error{ErrorCode::InvalidRequest, "History cache directory required"});
+	}
+	std::error_code ec;
+	std::filesystem::create_directories(config.directory, ec);
+	if (ec || !std::filesystem::is_directory(config.directory, ec)) {
+		return std::unexpected(
+			file_error("Failed to create history cache directory", config.directory));
+	}
+	std::unique_ptr<Impl> impl = std::make_unique<Impl>();
+	impl->directory = config.directory;
+	impl->config = std::move(config);
+	return HistoryCache(std::move(impl));
+}
+
+HistoryCache::HistoryCache(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+HistoryCache::~HistoryCache() = default;
+HistoryCache::HistoryCache(HistoryCache&&) noexcept = default;
+HistoryCache& HistoryCache::operator=(HistoryCache&&) noexcept = default;
+
+Result<std::vector<CandleHistory>>
+HistoryCache::load_candles(KalshiClient& client, std::span<const GetCandlesticksParams> params) {
+	if (!impl_) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "History cache moved-from"});
+	}
+	Impl& impl = *impl_;
+	for (const GetCandlesticksParams& p : params) {
+		if (!p.start_ts || !p.end_ts || *p.start_ts > *p.end_ts || p.period_interval <= 0) {
+			return std::unexpected(
+				Error{ErrorCode::InvalidRequest,
+					  "Candle loads need period_interval and start_ts <= end_ts"});
+		}
+	}
+
+	const std::size_t n = params.size();
+	std::vector<CandleHistory> cached(n);
+	std::vector<std::vector<HistoryRange>> pieces(n);
+	std::vector<std::vector<Candlestick>> fetched(n);
+	std::vector<std::optional<Error>> failures(n);
+	std::deque<Window> pending;
+	for (std::size_t i = 0; i < n; ++i) {
+		const GetCandlesticksParams& p = params[i];
+		Result<CandleHistory> on_disk = impl.read_candles(p.ticker, p.period_interval);
+		if (!on_disk) {
+			return std::unexpected(on_disk.error());
+		}
+		cached[i] = std::move(*on_disk);
+		pieces[i] = missing(cached[i].covered, {*p.start_ts, *p.end_ts});
+		const std::int64_t span = static_cast<std::int64_t>(
+			std::max<std::size_t>(impl.config.max_candles_per_request, 1) *
+			static_cast<std::size_t>(p.period_interval) * 60);
+		for (const HistoryRange& piece : pieces[i]) {
+			for (std::int64_t from = piece.from; from <= piece.to; from += span) {
+				pending.push_back({i, {from, std::min(piece.to, from + span - 1)}, {}});
+			}
+		}
+	}
+
+	impl.fetch(
+		client.http_client(), std::move(pending),
+		[&](const Window& window) {
+			GetCandlesticksParams request = params[window.series];
+			request.start_ts = window.range.from;
+			request.end_ts = window.range.to;
+			return api_detail::build_candlesticks_path(request);
+		},
+		[&](const Window& window, std::string_view body) -> std::optional<Window> {
+			const std::vector<Candlestick> candles = api_detail::parse_candlesticks_response(body);
+			impl.records_fetched.fetch_add(candles.size(), std::memory_order_relaxed);
+			// Keep only the window's own rows, so neighbouring windows that
+			// both return a boundary record do not store it twice.
+			std::vector<Candlestick>& into = fetched[window.series];
+			for (const Candlestick& candle : candles) {
+				if (candle.timestamp >= window.range.from && candle.timestamp <= window.range.to) {
+					into.push_back(candle);
+				}
+			}
+			return std::nullopt;
+		},
+		"candlesticks", failures);
+
+	const std::int64_t settled = impl.settled_until();
+	std::vector<CandleHistory> out;
+	out.reserve(n);
+	std::optional<Error> first_failure;
+	for (std::size_t i = 0; i < n; ++i) {
+		const GetCandlesticksParams& p = params[i];
+		const HistoryRange want{*p.start_ts, *p.end_ts};
+		if (failures[i]) {
+			first_failure = first_failure ? first_failure : failures[i];
+			continue;
+		}
+		if (pieces[i].empty()) {
+			impl.cache_hits.fetch_add(1, std::memory_order_relaxed);
+			out.push_back(slice(std::move(cached[i]), want));
+			continue;
+		}
+		std::vector<Candlestick> rows =
+			merge_rows(candle_rows(cached[i]), std::move(fetched[i]), pieces[i],
+					   [](const Candlestick& c) { return c.timestamp; });
+		Result<CandleHistory> written = impl.write_candles(
+			p.ticker, p.period_interval, rows, covered_after(cached[i].covered, want, settled));
+		if (!written) {
+			first_failure = first_failure ? first_failure : written.error();
+			continue;
+		}
+		out.push_back(slice(std::move(*written), want));
+	}
+	if (first_failure) {
+		return std::unexpected(std::move(*first_failure));
+	}
+	return out;
+}
+
+Result<CandleHistory> HistoryCache::load_candles(KalshiClient& client,
+												 const GetCandlesticksParams& params) {
+	Result<std::vector<CandleHistory>> loaded = load_candles(client, std::span(&params, 1));
+	if (!loaded) {
+		return std::unexpected(loaded.error());
+	}
+	return std::move(loaded->front());
+}
+
+Result<std::vector<TradeHistory>>
+HistoryCache::load_trades(KalshiClient& client, std::span<const TradeHistoryParams> params) {
+	if (!impl_) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "History cache moved-from"});
+	}
+	Impl& impl = *impl_;
+	for (const TradeHistoryParams& p : params) {
+		if (p.market_ticker.empty() || p.min_ts > p.max_ts) {
+			return std::unexpected(Error{ErrorCode::InvalidRequest,
+										 "Trade loads need market_ticker and min_ts <= max_ts"});
+		}
+	}
+
+	const std::size_t n = params.size();
+	std::vector<TradeHistory> cached(n);
+	std::vector<std::vector<HistoryRange>> pieces(n);
+	std::vector<std::vector<TradeRow>> fetched(n);
+	std::vector<std::optional<Error>> failures(n);
+	std::deque<Window> pending;
+	for (std::size_t i = 0; i < n; ++i) {
+		const TradeHistoryParams& p = params[i];
+		Result<TradeHistory> on_disk = impl.read_trades(p.market_ticker);
+		if (!on_disk) {
+			return std::unexpected(on_disk.error());
+		}
+		cached[i] = std::move(*on_disk);
+		pieces[i] = missing(cached[i].covered, {p.min_ts, p.max_ts});
+		for (const HistoryRange& piece : pieces[i]) {
+			// Trades are paged by cursor, so parallelism comes from paging
+			// several sub-ranges at once.
+			const std::int64_t length = piece.to - piece.from + 1;
+			const std::int64_t windows = std::clamp<std::int64_t>(
+				static_cast<std::int64_t>(impl.config.trade_windows), 1, length);
+			const std::int64_t step = (length + windows - 1) / windows;
+			for (std::int64_t from = piece.from; from <= piece.to; from += step) {
+				pending.push_back({i, {from, std::min(piece.to, from + step - 1)}, {}});
+			}
+		}
+	}
+
+	constexpr TradeFields kColumns{TradeField::YesPrice, TradeField::Count, TradeField::TakerSide,
+								   TradeField::CreatedTime, TradeField::IsBlockTrade};
+	impl.fetch(
+		client.http_client(), std::move(pending),
+		[&](const Window& window) {
+			GetTradesParams request;
+			request.market_ticker = params[window.series].market_ticker;
+			request.min_ts = window.range.from;
+			request.max_ts = window.range.to;
+			request.limit = impl.config.trades_page_limit;
+			if (!window.cursor.empty()) {
+				request.cursor = window.cursor;
+			}
+			return api_detail::build_trades_path(request);
+		},
+		[&](const Window& window, std::string_view body) -> std::optional<Window> {
+			const std::vector<PublicTrade> trades =
+				api_detail::parse_trades_response(body, kColumns);
+			impl.records_fetched.fetch_add(trades.size(), std::memory_order_relaxed);
+			std::vector<TradeRow>& into = fetched[window.series];
+			for (const PublicTrade& trade : trades) {
+				if (trade.created_time >= window.range.from &&
+					trade.created_time <= window.range.to) {
+					into.push_back(trade_row(trade));
+				}
+			}
+			std::string cursor = api_detail::parse_cursor(body);
+			if (trades.empty() || cursor.empty()) {
+				return std::nullopt;
+			}
+			return Window{window.series, window.range, std::move(cursor)};
+		},
+		"trades", failures);
+
+	const std::int64_t settled = impl.settled_until();
+	std::vector<TradeHistory> out;
+	out.reserve(n);
+	std::optional<Error> first_failure;
+	for (std::size_t i = 0; i < n; ++i) {
+		const TradeHistoryParams& p = params[i];
+		const HistoryRange want{p.min_ts, p.max_ts};
+		if (failures[i]) {
+			first_failure = first_failure ? first_failure : failures[i];
+			continue;
+		}
+		if (pieces[i].empty()) {
+			impl.cache_hits.fetch_add(1, std::memory_order_relaxed);
+			out.push_back(slice(std::move(cached[i]), want));
+			continue;
+		}
+		std::vector<TradeRow> rows =
+			merge_rows(trade_rows(cached[i]), std::move(fetched[i]), pieces[i],
+					   [](const TradeRow& t) { return t.timestamp; });
+		Result<TradeHistory> written = impl.write_trades(
+			p.market_ticker, rows, covered_after(cached[i].covered, want, settled));
+		if (!written) {
+			first_failure = first_failure ? first_failure : written.error();
+			continue;
+		}
+		out.push_back(slice(std::move(*written), want));
+	}
+	if (first_failure) {
+		return std::unexpected(std::move(*first_failure));
+	}
+	return out;
+}
+
+Result<TradeHistory> HistoryCache::load_trades(KalshiClient& client,
+											   const TradeHistoryParams& params) {
+	Result<std::vector<TradeHistory>> loaded = load_trades(client, std::span(&params, 1));
+	if (!loaded) {
+		return std::unexpected(loaded.error());
+	}
+	return std::move(loaded->front());
+}
+
+Result<CandleHistory> HistoryCache::cached_candles(std::string_view market_ticker,
+												   std::int32_t period_interval) const {
+	if (!impl_) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "History cache moved-from"});
+	}
+	return impl_->read_candles(market_ticker, period_interval);
+}
+
+Result<TradeHistory> HistoryCache::cached_trades(std::string_view market_ticker) const {
+	if (!impl_) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "History cache moved-from"});
+	}
+	return impl_->read_trades(market_ticker);
+}
+
+Result<CandleHistory> HistoryCache::store_candles(std::string_view market_ticker,
+												  std::int32_t period_interval,
+												  std::span<const Candlestick> candles,
+												  HistoryRange range) {
+	if (!impl_) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "History cache moved-from"});
+	}
+	if (range.from > range.to) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "range.from after range.to"});
+	}
+	Result<CandleHistory> cached = impl_->read_candles(market_ticker, period_interval);
+	if (!cached) {
+		return std::unexpected(cached.error());
+	}
+	std::vector<Candlestick> fresh;
+	std::copy_if(candles.begin(), candles.end(), std::back_inserter(fresh),
+				 [&](const Candlestick& c) {
+					 return c.timestamp >= range.from && c.timestamp <= range.to;
+				 });
+	const std::vector<Candlestick> rows =
+		merge_rows(candle_rows(*cached), std::move(fresh), std::span(&range, 1),
+				   [](const Candlestick& c) { return c.timestamp; });
+	return impl_->write_candles(market_ticker, period_interval, rows, grow(cached->covered, range));
+}
+
+Result<TradeHistory> HistoryCache::store_trades(std::string_view market_ticker,
+												std::span<const PublicTrade> trades,
+												HistoryRange range) {
+	if (!impl_) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "History cache moved-from"});
+	}
+	if (range.from > range.to) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "range.from after range.to"});
+	}
+	Result<TradeHistory> cached = impl_->read_trades(market_ticker);
+	if (!cached) {
+		return std::unexpected(cached.error());
+	}
+	std::vector<TradeRow> fresh;
+	for (const PublicTrade& trade : trades) {
+		if (trade.created_time >= range.from && trade.created_time <= range.to) {
+			fresh.push_back(trade_row(trade));
+		}
+	}
+	const std::vector<TradeRow> rows =
+		merge_rows(trade_rows(*cached), std::move(fresh), std::span(&range, 1),
+				   [](const TradeRow& t) { return t.timestamp; });
+	return impl_->write_trades(market_ticker, rows, grow(cached->covered, range));
+}
+
+HistoryCacheStats HistoryCache::stats() const noexcept {
+	if (!impl_) {
+		return {};
+	}
+	return {
+		.requests = impl_->requests.load(std::memory_order_relaxed),
+		.records_fetched = impl_->records_fetched.load(std::memory_order_relaxed),
+		.cache_hits = impl_->cache_hits.load(std::memory_order_relaxed),
+		.files_written = impl_->files_written.load(std::memory_order_relaxed),
+	};
+}
+
+const HistoryCacheConfig& HistoryCache::config() const noexcept {
+	if (!impl_) {
+		static const HistoryCacheConfig kEmpty{};
+		return kEmpty;
+	}
+	return impl_->config;
+}
+
+} // namespace kalshi
@@ -22,35 +22,42 @@
 /// when nullopt, matching the pre-migration `if (params.foo) body["foo"] = *params.foo;`
 /// pattern.
 
+#include "kalshi/models/price.hpp"
+
 #include <cstdint>
 #include <glaze/glaze.hpp>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace kalshi::ser {
 
 /// POST /portfolio/orders (and embedded inside batched orders)
+///
+/// Order submission is the hot path, so the string members are views
+/// into the ``CreateOrderParams`` being rendered rather than copies: a
+/// body must not outlive the params it was built from.
 struct CreateOrderBody {
-	std::string ticker;
-	std::string side;
-	std::string action;
-	std::string type;
+	std::string_view ticker;
+	std::string_view side;
+	std::string_view action;
+	std::string_view type;
 	std::int32_t count{0};
-	std::optional<std::string> count_fp;
+	std::optional<Quantity> count_fp;
 	std::optional<std::int32_t> yes_price;
 	std::optional<std::int32_t> no_price;
-	std::optional<std::string> yes_price_dollars;
-	std::optional<std::string> no_price_dollars;
-	std::optional<std::string> client_order_id;
+	std::optional<Price> yes_price_dollars;
+	std::optional<Price> no_price_dollars;
+	std::optional<std::string_view> client_order_id;
 	std::optional<std::int64_t> expiration_ts;
-	std::optional<std::string> time_in_force;
+	std::optional<std::string_view> time_in_force;
 	std::optional<std::int32_t> sell_position_floor;
 	std::optional<std::int32_t> buy_max_cost;
 	std::optional<bool> post_only;
 	std::optional<bool> reduce_only;
-	std::optional<std::string> self_trade_prevention_type;
-	std::optional<std::string> order_group_id;
+	std::optional<std::string_view> self_trade_prevention_type;
+	std::optional<std::string_view> order_group_id;
 	std::optional<bool> cancel_order_on_pause;
 	std::optional<std::int64_t> subaccount;
 	std::optional<std::int32_t> exchange_index;
@@ -164,18 +171,51 @@ struct SubaccountNettingBody {
 // on the explicit field order in each `glz::meta` below.
 inline constexpr glz::opts kBodyOpts{.prettify = false};
 
+/// Render into ``out``, replacing its contents but keeping its capacity,
+/// so a buffer reused across calls stops allocating once it has grown to
+/// the largest body.
 template <class T>
-[[nodiscard]] inline std::string render_body(const T& body) {
-	std::string out;
+inline void render_body_to(const T& body, std::string& out) {
 	// `glz::write` returns error_ctx; a statically-typed struct with no
 	// inf/NaN possibilities cannot produce a write error in practice.
-	// Discard the result to keep the call-site signature as `std::string`.
 	(void)glz::write<kBodyOpts>(body, out);
+}
+
+template <class T>
+[[nodiscard]] inline std::string render_body(const T& body) {
+	std::string out;
+	render_body_to(body, out);
 	return out;
 }
 
 } // namespace kalshi::ser
 
+// ===== Fixed-point writers =====
+//
+// `Price` / `Quantity` go on the wire as JSON strings (`"0.4250"`,
+// `"10.00"`), formatted into a stack buffer and written straight into
+// the output — no intermediate `std::string`.
+
+template <>
+struct glz::to<glz::JSON, kalshi::Price> {
+	template <auto Opts>
+	static void op(const kalshi::Price& value, auto&&... args) noexcept {
+		char buf[kalshi::Price::kMaxChars];
+		const std::string_view text{buf, static_cast<std::size_t>(value.format_to(buf) - buf)};
+		serialize<JSON>::op<Opts>(text, args...);
+	}
+};
+
+template <>
+struct glz::to<glz::JSON, kalshi::Quantity> {
+	template <auto Opts>
+	static void op(const kalshi::Quantity& value, auto&&... args) noexcept {
+		char buf[kalshi::Quantity::kMaxChars];
+		const std::string_view text{buf, static_cast<std::size_t>(value.format_to(buf) - buf)};
+		serialize<JSON>::op<Opts>(text, args...);
+	}
+};
+
 // ===== glz::meta specializations =====
 //
 // MUST be at namespace scope. Field order here defines the JSON key
@@ -0,0 +1,127 @@
+#pragma once
+
+/// @file mapped_file.hpp
+/// @brief Read-only file mappings and atomic rewrites for on-disk caches.
+///
+/// Shared by ``HistoryCache`` and ``WarmState``: files are read through
+/// ``mmap`` where available (falling back to an 8-byte aligned copy) and
+/// replaced by writing a sibling ``.tmp`` file and renaming it over the
+/// original, so a reader or a crash never sees half a file.
+///
+/// Not installed: consumed by the cache implementations.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kalshi::api_detail {
+
+/// ``n`` rounded up to a multiple of 8
+constexpr std::size_t padded(std::size_t n) noexcept {
+	return (n + 7) & ~std::size_t{7};
+}
+
+/// A read-only view of one file: mapped when possible, read into memory
+/// (8-byte aligned) otherwise.
+struct Mapping {
+	const char* data{nullptr};
+	std::size_t size{0};
+#if !defined(_WIN32)
+	void* map{nullptr};
+#endif
+	std::vector<std::int64_t> owned;
+
+	Mapping() = default;
+	Mapping(const Mapping&) = delete;
+	Mapping& operator=(const Mapping&) = delete;
+
+	~Mapping() {
+#if !defined(_WIN32)
+		if (map != nullptr) {
+			::munmap(map, size);
+		}
+#endif
+	}
+};
+
+/// Null when the file is missing, empty or unreadable
+inline std::shared_ptr<const Mapping> map_file(const std::string& path) {
+	std::shared_ptr<Mapping> mapping = std::make_shared<Mapping>();
+#if !defined(_WIN32)
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd >= 0) {
+		struct stat st {};
+		if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+			void* map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ,
+							   MAP_PRIVATE, fd, 0);
+			if (map != MAP_FAILED) {
+				mapping->map = map;
+				mapping->data = static_cast<const char*>(map);
+				mapping->size = static_cast<std::size_t>(st.st_size);
+			}
+		}
+		::close(fd);
+	}
+#endif
+	if (mapping->data == nullptr) {
+		std::ifstream in(path, std::ios::binary | std::ios::ate);
+		if (!in) {
+			return nullptr;
+		}
+		const std::streamoff size = in.tellg();
+		if (size <= 0) {
+			return nullptr;
+		}
+		mapping->owned.resize(padded(static_cast<std::size_t>(size)) / 8);
+		in.seekg(0);
+		in.read(reinterpret_cast<char*>(mapping->owned.data()), size);
+		mapping->data = reinterpret_cast<const char*>(mapping->owned.data());
+		mapping->size = static_cast<std::size_t>(size);
+	}
+	return mapping;
+}
+
+/// Write ``chunks`` back to back, each zero-padded to 8 bytes, next to
+/// ``path`` and rename the result over it. False (leaving ``path``
+/// untouched) on any I/O error.
+inline bool write_file_atomically(const std::string& path,
+								  std::span<const std::span<const std::byte>> chunks) {
+	const std::string tmp = path + ".tmp";
+	std::FILE* out = std::fopen(tmp.c_str(), "wb");
+	if (out == nullptr) {
+		return false;
+	}
+	static constexpr char kZeros[8]{};
+	bool ok = true;
+	for (const std::span<const std::byte> chunk : chunks) {
+		const std::size_t pad = padded(chunk.size()) - chunk.size();
+		ok = ok && std::fwrite(chunk.data(), 1, chunk.size(), out) == chunk.size() &&
+			 std::fwrite(kZeros, 1, pad, out) == pad;
+	}
+	ok = std::fclose(out) == 0 && ok;
+	std::error_code ec;
+	if (ok) {
+		std::filesystem::rename(tmp, path, ec);
+	}
+	if (!ok || ec) {
+		std::filesystem::remove(tmp, ec);
+		return false;
+	}
+	return true;
+}
+
+} // namespace kalshi::api_detail
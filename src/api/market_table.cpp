@@ -0,0 +1,381 @@
+#include "kalshi/market_table.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace kalshi {
+
+namespace {
+
+/// Rows whose predicate bytes are computed before compacting. Small
+/// enough for the mask to stay in L1, large enough to amortize the loop
+/// setup per column.
+constexpr std::size_t kSelectBlock = 256;
+
+/// Pool text below this is never worth a compaction pass
+constexpr std::size_t kMinCompactBytes = 4096;
+
+constexpr std::int32_t kPriceScale = 100;
+
+} // namespace
+
+std::uint32_t MarketTable::upsert(const Market& market) {
+	if (const std::optional<std::uint32_t> existing = find(market.ticker)) {
+		const std::uint32_t row = *existing;
+		open_times_[row] = market.open_time;
+		close_times_[row] = market.close_time;
+		yes_bids_[row] = market.yes_bid;
+		yes_asks_[row] = market.yes_ask;
+		no_bids_[row] = market.no_bid;
+		no_asks_[row] = market.no_ask;
+		volumes_[row] = market.volume;
+		open_interests_[row] = market.open_interest;
+		statuses_[row] = market.status;
+		if (market.ticker_id.valid()) {
+			ticker_ids_[row] = market.ticker_id;
+			index_id(market.ticker_id, row);
+		}
+		assign(titles_, row, market.title);
+		assign(subtitles_, row, market.subtitle);
+		assign(results_, row, market.result.value_or(std::string{}));
+		return row;
+	}
+
+	const std::uint32_t row = static_cast<std::uint32_t>(size());
+	open_times_.push_back(market.open_time);
+	close_times_.push_back(market.close_time);
+	yes_bids_.push_back(market.yes_bid);
+	yes_asks_.push_back(market.yes_ask);
+	no_bids_.push_back(market.no_bid);
+	no_asks_.push_back(market.no_ask);
+	volumes_.push_back(market.volume);
+	open_interests_.push_back(market.open_interest);
+	last_prices_.push_back(0);
+	statuses_.push_back(market.status);
+	ticker_ids_.push_back(market.ticker_id);
+	tickers_.push_back(intern(market.ticker));
+	titles_.push_back(intern(market.title));
+	subtitles_.push_back(intern(market.subtitle));
+	results_.push_back(intern(market.result.value_or(std::string{})));
+	index_.emplace(market.ticker, row);
+	index_id(market.ticker_id, row);
+	return row;
+}
+
+Result<std::size_t> MarketTable::load(KalshiClient& client, const GetMarketsParams& params) {
+	return client.for_each_market(params, [this](const Market& market) {
+		upsert(market);
+		return true;
+	});
+}
+
+void MarketTable::reserve(std::size_t markets) {
+	open_times_.reserve(markets);
+	close_times_.reserve(markets);
+	yes_bids_.reserve(markets);
+	yes_asks_.reserve(markets);
+	no_bids_.reserve(markets);
+	no_asks_.reserve(markets);
+	volumes_.reserve(markets);
+	open_interests_.reserve(markets);
+	last_prices_.reserve(markets);
+	statuses_.reserve(markets);
+	ticker_ids_.reserve(markets);
+	tickers_.reserve(markets);
+	titles_.reserve(markets);
+	subtitles_.reserve(markets);
+	results_.reserve(markets);
+	index_.reserve(markets);
+}
+
+void MarketTable::clear() {
+	*this = MarketTable{};
+}
+
+std::optional<std::uint32_t> MarketTable::find(std::string_view ticker) const {
+	const auto it = index_.find(ticker);
+	if (it == index_.end()) {
+		return std::nullopt;
+	}
+	return it->second;
+}
+
+std::optional<std::uint32_t> MarketTable::find(TickerId id) const {
+	if (!id.valid() || id.value >= row_of_id_.size() || row_of_id_[id.value] == kNoRow) {
+		return std::nullopt;
+	}
+	return row_of_id_[id.value];
+}
+
+std::optional<std::uint32_t> MarketTable::row_of(TickerId id, std::string_view ticker) const {
+	if (const std::optional<std::uint32_t> row = find(id)) {
+		return row;
+	}
+	return ticker.empty() ? std::nullopt : find(ticker);
+}
+
+bool MarketTable::apply(const TopOfBook& top) {
+	const std::optional<std::uint32_t> row = find(top.ticker_id);
+	if (!row || !top.valid) {
+		return false;
+	}
+	const std::int32_t yes_bid = top.yes_bid.quantity > 0 ? top.yes_bid.price_cents : 0;
+	const std::int32_t no_bid = top.no_bid.quantity > 0 ? top.no_bid.price_cents : 0;
+	yes_bids_[*row] = yes_bid;
+	no_bids_[*row] = no_bid;
+	yes_asks_[*row] = kPriceScale - no_bid;
+	no_asks_[*row] = kPriceScale - yes_bid;
+	return true;
+}
+
+bool MarketTable::apply(const WsMessage& message) {
+	if (const auto* trade = std::get_if<WsTrade>(&message)) {
+		return apply_trade(trade->ticker_id, trade->market_ticker, trade->yes_price,
+						   trade->count);
+	}
+	if (const auto* lifecycle = std::get_if<MarketLifecycle>(&message)) {
+		return apply_lifecycle(*lifecycle);
+	}
+	return false;
+}
+
+bool MarketTable::apply(const WsEvent& event) {
+	if (event.kind != WsEventKind::Trade) {
+		return false;
+	}
+	return apply_trade(event.ticker_id, {}, event.price, event.quantity);
+}
+
+bool MarketTable::apply_trade(TickerId id, std::string_view ticker, std::int32_t yes_price,
+							  std::int32_t count) {
+	const std::optional<std::uint32_t> row = row_of(id, ticker);
+	if (!row) {
+		return false;
+	}
+	volumes_[*row] += count;
+	last_prices_[*row] = yes_price;
+	return true;
+}
+
+bool MarketTable::apply_lifecycle(const MarketLifecycle& lifecycle) {
+	const std::optional<std::uint32_t> row = row_of(lifecycle.ticker_id, lifecycle.market_ticker);
+	if (!row) {
+		return false;
+	}
+	switch (classify_lifecycle_event(lifecycle)) {
+	case LifecycleEventType::Settled:
+		statuses_[*row] = MarketStatus::Settled;
+		if (lifecycle.result) {
+			assign(results_, *row, *lifecycle.result);
+		}
+		return true;
+	case LifecycleEventType::Determined:
+		// MarketStatus has no "determined"; trading is over either way.
+		statuses_[*row] = MarketStatus::Closed;
+		if (lifecycle.result) {
+			assign(results_, *row, *lifecycle.result);
+		}
+		return true;
+	case LifecycleEventType::Deactivated:
+		statuses_[*row] = MarketStatus::Paused;
+		return true;
+	case LifecycleEventType::MetadataUpdated:
+		assign(subtitles_, *row, *lifecycle.yes_sub_title);
+		return true;
+	case LifecycleEventType::OpenOrCreated:
+		// Created and activated look alike on the wire, so the status is
+		// left to the next load; the times are authoritative either way.
+		if (lifecycle.open_ts != 0) {
+			open_times_[*row] = lifecycle.open_ts;
+		}
+		if (lifecycle.close_ts != 0) {
+			close_times_[*row] = lifecycle.close_ts;
+		}
+		return true;
+	case LifecycleEventType::Unknown:
+		break;
+	}
+	return false;
+}
+
+std::size_t MarketTable::select(const MarketFilter& filter,
+								std::vector<std::uint32_t>& rows) const {
+	const std::size_t n = size();
+	rows.resize(n);
+	std::size_t count = 0;
+	std::array<std::uint8_t, kSelectBlock> keep{};
+	for (std::size_t base = 0; base < n; base += kSelectBlock) {
+		const std::size_t len = std::min(kSelectBlock, n - base);
+		const std::int32_t* const bid = yes_bids_.data() + base;
+		const std::int32_t* const ask = yes_asks_.data() + base;
+		const std::int32_t* const volume = volumes_.data() + base;
+		const std::int32_t* const open_interest = open_interests_.data() + base;
+		const std::int64_t* const close = close_times_.data() + base;
+
+		// One pass per column width, using & rather than && so each loop
+		// is branch-free and vectorizes.
+		for (std::size_t i = 0; i < len; ++i) {
+			keep[i] = static_cast<std::uint8_t>(
+				(bid[i] >= filter.min_yes_bid) & (ask[i] <= filter.max_yes_ask) &
+				(ask[i] - bid[i] <= filter.max_spread) & (volume[i] >= filter.min_volume) &
+				(open_interest[i] >= filter.min_open_interest));
+		}
+		for (std::size_t i = 0; i < len; ++i) {
+			keep[i] &= static_cast<std::uint8_t>((close[i] >= filter.close_after) &
+												 (close[i] <= filter.close_before));
+		}
+		if (filter.status) {
+			const MarketStatus* const status = statuses_.data() + base;
+			for (std::size_t i = 0; i < len; ++i) {
+				keep[i] &= static_cast<std::uint8_t>(status[i] == *filter.status);
+			}
+		}
+		// Compact without a branch: every row is written, only kept rows
+		// advance the cursor.
+		for (std::size_t i = 0; i < len; ++i) {
+			rows[count] = static_cast<std::uint32_t>(base + i);
+			count += keep[i];
+		}
+	}
+	rows.resize(count);
+	return count;
+}
+
+void MarketTable::sort(std::span<std::uint32_t> rows, MarketColumn column,
+					   SortOrder order) const {
+	// Gather the keys once so the sort compares plain integers.
+	std::vector<std::pair<std::int64_t, std::uint32_t>> keyed;
+	keyed.reserve(rows.size());
+	for (const std::uint32_t row : rows) {
+		keyed.emplace_back(value(row, column), row);
+	}
+	if (order == SortOrder::Ascending) {
+		std::stable_sort(keyed.begin(), keyed.end(),
+						 [](const auto& a, const auto& b) { return a.first < b.first; });
+	} else {
+		std::stable_sort(keyed.begin(), keyed.end(),
+						 [](const auto& a, const auto& b) { return a.first > b.first; });
+	}
+	for (std::size_t i = 0; i < rows.size(); ++i) {
+		rows[i] = keyed[i].second;
+	}
+}
+
+std::int64_t MarketTable::value(std::uint32_t row, MarketColumn column) const noexcept {
+	switch (column) {
+	case MarketColumn::YesBid:
+		return yes_bids_[row];
+	case MarketColumn::YesAsk:
+		return yes_asks_[row];
+	case MarketColumn::NoBid:
+		return no_bids_[row];
+	case MarketColumn::NoAsk:
+		return no_asks_[row];
+	case MarketColumn::Spread:
+		return std::int64_t{yes_asks_[row]} - yes_bids_[row];
+	case MarketColumn::Volume:
+		return volumes_[row];
+	case MarketColumn::OpenInterest:
+		return open_interests_[row];
+	case MarketColumn::LastPrice:
+		return last_prices_[row];
+	case MarketColumn::OpenTime:
+		return open_times_[row];
+	case MarketColumn::CloseTime:
+		return close_times_[row];
+	}
+	return 0;
+}
+
+Market MarketTable::market(std::uint32_t row) const {
+	Market market;
+	market.open_time = open_times_[row];
+	market.close_time = close_times_[row];
+	market.yes_bid = yes_bids_[row];
+	market.yes_ask = yes_asks_[row];
+	market.no_bid = no_bids_[row];
+	market.no_ask = no_asks_[row];
+	market.yes_bid_dollars = Price::from_cents(market.yes_bid);
+	market.yes_ask_dollars = Price::from_cents(market.yes_ask);
+	market.no_bid_dollars = Price::from_cents(market.no_bid);
+	market.no_ask_dollars = Price::from_cents(market.no_ask);
+	market.volume = volumes_[row];
+	market.open_interest = open_interests_[row];
+	market.ticker_id = ticker_ids_[row];
+	market.status = statuses_[row];
+	market.ticker = ticker(row);
+	market.title = title(row);
+	market.subtitle = subtitle(row);
+	if (const std::string_view settled = result(row); !settled.empty()) {
+		market.result = std::string(settled);
+	}
+	return market;
+}
+
+std::string_view MarketTable::ticker(std::uint32_t row) const noexcept {
+	return text(tickers_[row]);
+}
+
+std::string_view MarketTable::title(std::uint32_t row) const noexcept {
+	return text(titles_[row]);
+}
+
+std::string_view MarketTable::subtitle(std::uint32_t row) const noexcept {
+	return text(subtitles_[row]);
+}
+
+std::string_view MarketTable::result(std::uint32_t row) const noexcept {
+	return text(results_[row]);
+}
+
+std::string_view MarketTable::text(Text t) const noexcept {
+	return std::string_view(pool_).substr(t.offset, t.length);
+}
+
+void MarketTable::assign(std::vector<Text>& column, std::uint32_t row, std::string_view value) {
+	if (text(column[row]) == value) {
+		return;
+	}
+	// Release the old text first so a compaction triggered by ``intern``
+	// does not carry it over.
+	dead_bytes_ += column[row].length;
+	column[row] = Text{};
+	column[row] = intern(value);
+}
+
+MarketTable::Text MarketTable::intern(std::string_view value) {
+	if (dead_bytes_ > kMinCompactBytes && dead_bytes_ > pool_.size() / 2) {
+		compact();
+	}
+	const Text t{static_cast<std::uint32_t>(pool_.size()),
+				 static_cast<std::uint32_t>(value.size())};
+	pool_.append(value);
+	return t;
+}
+
+void MarketTable::index_id(TickerId id, std::uint32_t row) {
+	if (!id.valid()) {
+		return;
+	}
+	if (id.value >= row_of_id_.size()) {
+		row_of_id_.resize(std::size_t{id.value} + 1, kNoRow);
+	}
+	row_of_id_[id.value] = row;
+}
+
+void MarketTable::compact() {
+	std::string pool;
+	pool.reserve(pool_.size() - dead_bytes_);
+	for (std::vector<Text>* column : {&tickers_, &titles_, &subtitles_, &results_}) {
+		for (Text& t : *column) {
+			const std::string_view live = text(t);
+			t.offset = static_cast<std::uint32_t>(pool.size());
+			pool.append(live);
+		}
+	}
+	pool_ = std::move(pool);
+	dead_bytes_ = 0;
+}
+
+} // namespace kalshi
@@ -0,0 +1,302 @@
+#include "kalshi/metadata_cache.hpp"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace kalshi {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Lets the maps be probed with a ``string_view`` without building a key
+struct StringHash {
+	using is_transparent = void;
+	std::size_t operator()(std::string_view s) const noexcept {
+		return std::hash<std::string_view>{}(s);
+	}
+};
+
+template <typename T> struct Entry {
+	std::shared_ptr<const T> value;
+	Clock::time_point expires;
+};
+
+template <typename T>
+using EntryMap = std::unordered_map<std::string, Entry<T>, StringHash, std::equal_to<>>;
+
+/// One kind of cached object with its own lock and TTL
+template <typename T> struct Store {
+	mutable std::shared_mutex mutex;
+	EntryMap<T> entries;
+	Clock::duration ttl;
+
+	/// Fresh entry or null. ``usable`` vetoes entries that are within
+	/// their TTL but known to be out of date.
+	template <typename Usable>
+	std::shared_ptr<const T> get(std::string_view key, Clock::time_point now,
+								 Usable&& usable) const {
+		std::shared_lock lock(mutex);
+		const auto it = entries.find(key);
+		if (it == entries.end() || it->second.expires <= now || !usable(*it->second.value)) {
+			return nullptr;
+		}
+		return it->second.value;
+	}
+
+	std::shared_ptr<const T> put(std::string key, T value, Clock::time_point now,
+								 std::size_t max_entries) {
+		return put(std::move(key), std::move(value), now, ttl, max_entries);
+	}
+
+	std::shared_ptr<const T> put(std::string key, T value, Clock::time_point now,
+								 Clock::duration lifetime, std::size_t max_entries) {
+		std::shared_ptr<const T> shared = std::make_shared<const T>(std::move(value));
+		std::unique_lock lock(mutex);
+		// max_entries == 0 leaves the store unbounded.
+		if (max_entries != 0 && entries.size() >= max_entries && !entries.contains(key)) {
+			std::erase_if(entries, [now](const auto& kv) { return kv.second.expires <= now; });
+			if (entries.size() >= max_entries && !entries.empty()) {
+				entries.erase(entries.begin());
+			}
+		}
+		entries.insert_or_assign(std::move(key), Entry<T>{shared, now + lifetime});
+		return shared;
+	}
+
+	void collect(std::vector<MetadataEntry<T>>& out, Clock::time_point now) const {
+		std::shared_lock lock(mutex);
+		out.reserve(entries.size());
+		for (const auto& [key, entry] : entries) {
+			if (entry.expires > now) {
+				const std::chrono::milliseconds left =
+					std::chrono::duration_cast<std::chrono::milliseconds>(entry.expires - now);
+				out.push_back({entry.value, left});
+			}
+		}
+	}
+
+	bool erase(std::string_view key) {
+		std::unique_lock lock(mutex);
+		const auto it = entries.find(key);
+		if (it == entries.end()) {
+			return false;
+		}
+		entries.erase(it);
+		return true;
+	}
+
+	void clear() {
+		std::unique_lock lock(mutex);
+		entries.clear();
+	}
+};
+
+std::int64_t unix_seconds() noexcept {
+	return std::chrono::duration_cast<std::chrono::seconds>(
+			   std::chrono::system_clock::now().time_since_epoch())
+		.count();
+}
+
+} // namespace
+
+struct MetadataCache::Impl {
+	MetadataCacheConfig config;
+	Store<Market> markets;
+	Store<Event> events;
+	Store<EventMetadata> event_metadata;
+	Store<Series> series;
+
+	mutable std::atomic<std::uint64_t> hits{0};
+	mutable std::atomic<std::uint64_t> misses{0};
+	std::atomic<std::uint64_t> patches{0};
+	std::atomic<std::uint64_t> invalidations{0};
+
+	explicit Impl(MetadataCacheConfig c) : config(c) {
+		markets.ttl = config.market_ttl;
+		events.ttl = config.event_ttl;
+		event_metadata.ttl = config.event_metadata_ttl;
+		series.ttl = config.series_ttl;
+	}
+
+	template <typename T> std::shared_ptr<const T> count(std::shared_ptr<const T> found) const {
+		(found ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+		return found;
+	}
+
+	void dropped(bool erased) {
+		if (erased) {
+			invalidations.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+};
+
+MetadataCache::MetadataCache(MetadataCacheConfig config)
+	: impl_(std::make_unique<Impl>(config)) {}
+
+MetadataCache::~MetadataCache() = default;
+
+std::shared_ptr<const Market> MetadataCache::market(std::string_view ticker) const {
+	// An Open market past its close time has changed state even if no
+	// lifecycle message has said so yet.
+	const std::int64_t now_s = unix_seconds();
+	return impl_->count(impl_->markets.get(ticker, Clock::now(), [now_s](const Market& m) {
+		return m.status != MarketStatus::Open || m.close_time == 0 || m.close_time > now_s;
+	}));
+}
+
+std::shared_ptr<const Event> MetadataCache::event(std::string_view event_ticker) const {
+	return impl_->count(
+		impl_->events.get(event_ticker, Clock::now(), [](const Event&) { return true; }));
+}
+
+std::shared_ptr<const EventMetadata>
+MetadataCache::event_metadata(std::string_view event_ticker) const {
+	return impl_->count(impl_->event_metadata.get(event_ticker, Clock::now(),
+												  [](const EventMetadata&) { return true; }));
+}
+
+std::shared_ptr<const Series> MetadataCache::series(std::string_view series_ticker) const {
+	return impl_->count(
+		impl_->series.get(series_ticker, Clock::now(), [](const Series&) { return true; }));
+}
+
+std::shared_ptr<const Market> MetadataCache::put(Market market) {
+	std::string key = market.ticker;
+	return impl_->markets.put(std::move(key), std::move(market), Clock::now(),
+							  impl_->config.max_entries);
+}
+
+std::shared_ptr<const Event> MetadataCache::put(Event event) {
+	std::string key = event.event_ticker;
+	return impl_->events.put(std::move(key), std::move(event), Clock::now(),
+							 impl_->config.max_entries);
+}
+
+std::shared_ptr<const EventMetadata> MetadataCache::put(EventMetadata metadata) {
+	std::string key = metadata.event_ticker;
+	return impl_->event_metadata.put(std::move(key), std::move(metadata), Clock::now(),
+									 impl_->config.max_entries);
+}
+
+std::shared_ptr<const Series> MetadataCache::put(Series series) {
+	std::string key = series.ticker;
+	return impl_->series.put(std::move(key), std::move(series), Clock::now(),
+							 impl_->config.max_entries);
+}
+
+std::shared_ptr<const Market> MetadataCache::put(Market market, std::chrono::milliseconds ttl) {
+	std::string key = market.ticker;
+	return impl_->markets.put(std::move(key), std::move(market), Clock::now(), ttl,
+							  impl_->config.max_entries);
+}
+
+std::shared_ptr<const Event> MetadataCache::put(Event event, std::chrono::milliseconds ttl) {
+	std::string key = event.event_ticker;
+	return impl_->events.put(std::move(key), std::move(event), Clock::now(), ttl,
+							 impl_->config.max_entries);
+}
+
+std::shared_ptr<const EventMetadata> MetadataCache::put(EventMetadata metadata,
+														std::chrono::milliseconds ttl) {
+	std::string key = metadata.event_ticker;
+	return impl_->event_metadata.put(std::move(key), std::move(metadata), Clock::now(), ttl,
+									 impl_->config.max_entries);
+}
+
+std::shared_ptr<const Series> MetadataCache::put(Series series, std::chrono::milliseconds ttl) {
+	std::string key = series.ticker;
+	return impl_->series.put(std::move(key), std::move(series), Clock::now(), ttl,
+							 impl_->config.max_entries);
+}
+
+bool MetadataCache::apply(const MarketLifecycle& lifecycle) {
+	Store<Market>& store = impl_->markets;
+	std::unique_lock lock(store.mutex);
+	const auto it = store.entries.find(std::string_view{lifecycle.market_ticker});
+	if (it == store.entries.end()) {
+		return false;
+	}
+
+	Market patched = *it->second.value;
+	switch (classify_lifecycle_event(lifecycle)) {
+	case LifecycleEventType::Settled:
+		patched.status = MarketStatus::Settled;
+		patched.settlement_ts = lifecycle.settled_ts;
+		if (lifecycle.result) {
+			patched.result = lifecycle.result;
+		}
+		break;
+	case LifecycleEventType::Determined:
+		// MarketStatus has no "determined"; trading is over either way.
+		patched.status = MarketStatus::Closed;
+		if (lifecycle.result) {
+			patched.result = lifecycle.result;
+		}
+		break;
+	case LifecycleEventType::Deactivated:
+		patched.status = MarketStatus::Paused;
+		break;
+	case LifecycleEventType::MetadataUpdated:
+		patched.subtitle = *lifecycle.yes_sub_title;
+		break;
+	case LifecycleEventType::OpenOrCreated:
+	case LifecycleEventType::Unknown:
+		// Reopened, re-timed or unrecognized: refetch rather than guess.
+		store.entries.erase(it);
+		impl_->invalidations.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+	it->second.value = std::make_shared<const Market>(std::move(patched));
+	impl_->patches.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void MetadataCache::invalidate_market(std::string_view ticker) {
+	impl_->dropped(impl_->markets.erase(ticker));
+}
+
+void MetadataCache::invalidate_event(std::string_view event_ticker) {
+	impl_->dropped(impl_->events.erase(event_ticker));
+	impl_->dropped(impl_->event_metadata.erase(event_ticker));
+}
+
+void MetadataCache::invalidate_series(std::string_view series_ticker) {
+	impl_->dropped(impl_->series.erase(series_ticker));
+}
+
+void MetadataCache::clear() {
+	impl_->markets.clear();
+	impl_->events.clear();
+	impl_->event_metadata.clear();
+	impl_->series.clear();
+}
+
+MetadataCacheEntries MetadataCache::entries() const {
+	const Clock::time_point now = Clock::now();
+	MetadataCacheEntries out;
+	impl_->markets.collect(out.markets, now);
+	impl_->events.collect(out.events, now);
+	impl_->event_metadata.collect(out.event_metadata, now);
+	impl_->series.collect(out.series, now);
+	return out;
+}
+
+MetadataCacheStats MetadataCache::stats() const noexcept {
+	return {impl_->hits.load(std::memory_order_relaxed),
+			impl_->misses.load(std::memory_order_relaxed),
+			impl_->patches.load(std::memory_order_relaxed),
+			impl_->invalidations.load(std::memory_order_relaxed)};
+}
+
+const MetadataCacheConfig& MetadataCache::config() const noexcept {
+	return impl_->config;
+}
+
+} // namespace kalshi
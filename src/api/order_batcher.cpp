@@ -0,0 +1,346 @@
+#include "kalshi/order_batcher.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace kalshi {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+Error shut_down_error() {
+	return Error::network("OrderBatcher shut down");
+}
+
+// Creates come back in request order; each rejected entry has an empty
+// order_id and the next message in `errors`.
+void split_creates(std::vector<AsyncCallback<Order>>& callbacks,
+				   Result<BatchResponse<Order>> response) {
+	if (!response) {
+		for (AsyncCallback<Order>& callback : callbacks) {
+			callback(std::unexpected(response.error()));
+		}
+		return;
+	}
+
+	std::size_t rejected = 0;
+	for (std::size_t i = 0; i < callbacks.size(); ++i) {
+		if (i >= response->results.size()) {
+			callbacks[i](std::unexpected(
+				Error{ErrorCode::ServerError, "Order missing from batch create response"}));
+		} else if (response->results[i].order_id.empty()) {
+			const std::string message = rejected < response->errors.size()
+											? response->errors[rejected]
+											: std::string("order rejected");
+			++rejected;
+			callbacks[i](
+				std::unexpected(Error{ErrorCode::ServerError, "Batch order rejected: " + message}));
+		} else {
+			callbacks[i](std::move(response->results[i]));
+		}
+	}
+}
+
+// Cancels are matched on order_id; an entry without one takes the first
+// unanswered slot.
+void split_cancels(const std::vector<std::string>& order_ids,
+				   std::vector<AsyncCallback<OrderCancelResult>>& callbacks,
+				   Result<BatchResponse<OrderCancelResult>> response) {
+	if (!response) {
+		for (AsyncCallback<OrderCancelResult>& callback : callbacks) {
+			callback(std::unexpected(response.error()));
+		}
+		return;
+	}
+
+	std::vector<std::optional<OrderCancelResult>> answers(callbacks.size());
+	for (OrderCancelResult& result : response->results) {
+		std::size_t slot = answers.size();
+		for (std::size_t i = 0; i < answers.size(); ++i) {
+			if (!answers[i] && (result.order_id.empty() || order_ids[i] == result.order_id)) {
+				slot = i;
+				break;
+			}
+		}
+		if (slot < answers.size()) {
+			answers[slot] = std::move(result);
+		}
+	}
+
+	for (std::size_t i = 0; i < callbacks.size(); ++i) {
+		if (!answers[i]) {
+			callbacks[i](std::unexpected(Error{ErrorCode::ServerError,
+											   "Order missing from batch cancel response: " +
+												   order_ids[i]}));
+		} else if (answers[i]->error) {
+			const std::string& message = answers[i]->error->message.empty()
+											 ? answers[i]->error->code
+											 : answers[i]->error->message;
+			callbacks[i](std::unexpected(
+				Error{ErrorCode::ServerError, "Batch cancel rejected: " + message}));
+		} else {
+			callbacks[i](std::move(*answers[i]));
+		}
+	}
+}
+
+} // namespace
+
+struct OrderBatcher::Impl {
+	struct CreateIntent {
+		CreateOrderParams params;
+		AsyncCallback<Order> callback;
+		Clock::time_point enqueued{};
+	};
+
+	struct CancelIntent {
+		CancelOrderV2Params params;
+		AsyncCallback<OrderCancelResult> callback;
+		Clock::time_point enqueued{};
+	};
+
+	KalshiClient* client;
+	OrderBatcherConfig config;
+
+	// Everything below is guarded by `mutex`.
+	mutable std::mutex mutex;
+	std::condition_variable cv;
+	std::deque<CreateIntent> creates;
+	std::deque<CancelIntent> cancels;
+	OrderBatcherStats counters;
+	bool stopping{false};
+	std::thread flusher;
+
+	Impl(KalshiClient& c, OrderBatcherConfig cfg) : client(&c), config(cfg) {
+		config.max_batch = std::max<std::size_t>(config.max_batch, 1);
+	}
+
+	// Caller holds `mutex`. Takes up to `max_batch` intents off the front.
+	template <typename Intent> std::vector<Intent> take(std::deque<Intent>& queue) const {
+		const std::size_t count = std::min(queue.size(), config.max_batch);
+		std::vector<Intent> batch;
+		batch.reserve(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			batch.push_back(std::move(queue.front()));
+			queue.pop_front();
+		}
+		return batch;
+	}
+
+	// Caller holds `mutex`. True when `queue` holds a batch due at `now`.
+	template <typename Intent>
+	[[nodiscard]] bool due(const std::deque<Intent>& queue, Clock::time_point now) const {
+		return !queue.empty() &&
+			   (queue.size() >= config.max_batch || now - queue.front().enqueued >= config.window);
+	}
+
+	void send_creates(std::vector<CreateIntent> batch) {
+		BatchOrderRequest request;
+		request.orders.reserve(batch.size());
+		std::vector<AsyncCallback<Order>> callbacks;
+		callbacks.reserve(batch.size());
+		for (CreateIntent& intent : batch) {
+			request.orders.push_back(std::move(intent.params));
+			callbacks.push_back(std::move(intent.callback));
+		}
+		client->batch_create_orders_async(
+			request, [callbacks = std::move(callbacks)](
+						 Result<BatchResponse<Order>> response) mutable {
+				split_creates(callbacks, std::move(response));
+			});
+	}
+
+	void send_cancels(std::vector<CancelIntent> batch) {
+		BatchCancelRequest request;
+		request.orders.reserve(batch.size());
+		std::vector<std::string> order_ids;
+		order_ids.reserve(batch.size());
+		std::vector<AsyncCallback<OrderCancelResult>> callbacks;
+		callbacks.reserve(batch.size());
+		for (CancelIntent& intent : batch) {
+			order_ids.push_back(intent.params.order_id);
+			request.orders.push_back(BatchCancelOrder{.order_id = std::move(intent.params.order_id),
+													  .subaccount = intent.params.subaccount,
+													  .exchange_index =
+														  intent.params.exchange_index});
+			callbacks.push_back(std::move(intent.callback));
+		}
+		client->batch_cancel_orders_v2_async(
+			request, [order_ids = std::move(order_ids), callbacks = std::move(callbacks)](
+						 Result<BatchResponse<OrderCancelResult>> response) mutable {
+				split_cancels(order_ids, callbacks, std::move(response));
+			});
+	}
+
+	// Caller holds `lock`; it is released while sending. Sends every queued
+	// intent when `all`, else only batches that are due.
+	void send_due(std::unique_lock<std::mutex>& lock, bool all) {
+		for (;;) {
+			const Clock::time_point now = Clock::now();
+			if ((all && !cancels.empty()) || due(cancels, now)) {
+				std::vector<CancelIntent> batch = take(cancels);
+				++counters.cancel_batches;
+				lock.unlock();
+				send_cancels(std::move(batch));
+				lock.lock();
+			} else if ((all && !creates.empty()) || due(creates, now)) {
+				std::vector<CreateIntent> batch = take(creates);
+				++counters.create_batches;
+				lock.unlock();
+				send_creates(std::move(batch));
+				lock.lock();
+			} else {
+				return;
+			}
+		}
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (!stopping) {
+			send_due(lock, false);
+			if (stopping) {
+				break;
+			}
+
+			std::optional<Clock::time_point> deadline;
+			if (!cancels.empty()) {
+				deadline = cancels.front().enqueued + config.window;
+			}
+			if (!creates.empty()) {
+				const Clock::time_point create_deadline = creates.front().enqueued + config.window;
+				deadline = deadline ? std::min(*deadline, create_deadline) : create_deadline;
+			}
+			if (deadline) {
+				cv.wait_until(lock, *deadline);
+			} else {
+				cv.wait(lock);
+			}
+		}
+	}
+
+	// Moves `intent` into `queue`, waking the flusher when it opens a batch
+	// or fills one. Returns false, leaving `intent` alone, once stopped.
+	template <typename Intent>
+	bool enqueue(std::deque<Intent>& queue, Intent& intent, std::uint64_t& counter) {
+		bool wake = false;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (stopping) {
+				return false;
+			}
+			intent.enqueued = Clock::now();
+			queue.push_back(std::move(intent));
+			++counter;
+			wake = queue.size() == 1 || queue.size() >= config.max_batch;
+		}
+		if (wake) {
+			cv.notify_one();
+		}
+		return true;
+	}
+
+	void stop() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		cv.notify_all();
+		if (flusher.joinable()) {
+			flusher.join();
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		send_due(lock, true);
+	}
+};
+
+OrderBatcher::OrderBatcher(KalshiClient& client, OrderBatcherConfig config)
+	: impl_(std::make_unique<Impl>(client, config)) {
+	impl_->flusher = std::thread([impl = impl_.get()] { impl->run(); });
+}
+
+OrderBatcher::~OrderBatcher() {
+	if (impl_) {
+		impl_->stop();
+	}
+}
+
+OrderBatcher::OrderBatcher(OrderBatcher&&) noexcept = default;
+
+OrderBatcher& OrderBatcher::operator=(OrderBatcher&& other) noexcept {
+	if (this != &other) {
+		if (impl_) {
+			impl_->stop();
+		}
+		impl_ = std::move(other.impl_);
+	}
+	return *this;
+}
+
+void OrderBatcher::create_order(CreateOrderParams params, AsyncCallback<Order> callback) {
+	if (!impl_) {
+		callback(std::unexpected(Error::network("OrderBatcher has been moved from")));
+		return;
+	}
+	Impl::CreateIntent intent{.params = std::move(params), .callback = std::move(callback)};
+	if (!impl_->enqueue(impl_->creates, intent, impl_->counters.creates)) {
+		intent.callback(std::unexpected(shut_down_error()));
+	}
+}
+
+std::future<Result<Order>> OrderBatcher::create_order(CreateOrderParams params) {
+	std::shared_ptr<std::promise<Result<Order>>> promise =
+		std::make_shared<std::promise<Result<Order>>>();
+	std::future<Result<Order>> future = promise->get_future();
+	create_order(std::move(params),
+				 [promise](Result<Order> result) { promise->set_value(std::move(result)); });
+	return future;
+}
+
+void OrderBatcher::cancel_order(CancelOrderV2Params params,
+								AsyncCallback<OrderCancelResult> callback) {
+	if (!impl_) {
+		callback(std::unexpected(Error::network("OrderBatcher has been moved from")));
+		return;
+	}
+	Impl::CancelIntent intent{.params = std::move(params), .callback = std::move(callback)};
+	if (!impl_->enqueue(impl_->cancels, intent, impl_->counters.cancels)) {
+		intent.callback(std::unexpected(shut_down_error()));
+	}
+}
+
+std::future<Result<OrderCancelResult>> OrderBatcher::cancel_order(CancelOrderV2Params params) {
+	std::shared_ptr<std::promise<Result<OrderCancelResult>>> promise =
+		std::make_shared<std::promise<Result<OrderCancelResult>>>();
+	std::future<Result<OrderCancelResult>> future = promise->get_future();
+	cancel_order(std::move(params), [promise](Result<OrderCancelResult> result) {
+		promise->set_value(std::move(result));
+	});
+	return future;
+}
+
+void OrderBatcher::flush() {
+	if (!impl_) {
+		return;
+	}
+	std::unique_lock<std::mutex> lock(impl_->mutex);
+	impl_->send_due(lock, true);
+}
+
+OrderBatcherStats OrderBatcher::stats() const {
+	if (!impl_) {
+		return {};
+	}
+	std::lock_guard<std::mutex> lock(impl_->mutex);
+	return impl_->counters;
+}
+
+} // namespace kalshi
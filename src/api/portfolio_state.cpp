@@ -0,0 +1,523 @@
+#include "kalshi/portfolio_state.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace kalshi {
+
+namespace {
+
+/// Lets the order map be probed with a ``string_view`` without building a key
+struct StringHash {
+	using is_transparent = void;
+	std::size_t operator()(std::string_view s) const noexcept {
+		return std::hash<std::string_view>{}(s);
+	}
+};
+
+/// One market, published with a seqlock: odd ``seq`` means a write is in
+/// progress. Every field is atomic so concurrent reads are race-free.
+struct alignas(64) Slot {
+	std::atomic<std::uint32_t> seq{0};
+	std::atomic<std::int32_t> position{0};
+	std::atomic<std::int32_t> resting_yes{0};
+	std::atomic<std::int32_t> resting_no{0};
+};
+
+/// Writer-side record of one of our orders
+struct RestingOrder {
+	TickerId id;
+	OutcomeSide exposure{OutcomeSide::Yes};
+	/// ``remaining_count`` from the last ack; -1 before any ack (a fill
+	/// can beat its order's ack)
+	std::int32_t remaining_ack{-1};
+	/// ``filled_count`` from the last ack
+	std::int32_t filled_ack{0};
+	/// Fills applied through ``on_fill``
+	std::int32_t filled_seen{0};
+
+	/// Contracts still resting: the ack's remainder less fills the ack
+	/// did not know about yet
+	[[nodiscard]] std::int32_t resting() const noexcept {
+		if (remaining_ack < 0) {
+			return 0;
+		}
+		return std::max(0, remaining_ack - std::max(0, filled_seen - filled_ack));
+	}
+};
+
+using OrderMap = std::unordered_map<std::string, RestingOrder, StringHash, std::equal_to<>>;
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__)
+	asm volatile("yield");
+#endif
+}
+
+bool is_done(OrderStatus status) noexcept {
+	return status == OrderStatus::Cancelled || status == OrderStatus::Filled;
+}
+
+} // namespace
+
+struct PortfolioState::Impl {
+	PortfolioStateConfig config;
+	KalshiClient* client{nullptr};
+	std::shared_ptr<TickerTable> tickers;
+	std::unique_ptr<Slot[]> slots;
+
+	// Writer state, guarded by `mutex`.
+	std::mutex mutex;
+	OrderMap orders;
+	/// Bumped by every fill / ack; ``touched[i]`` is the value at market
+	/// ``i``'s last change, so a reconcile can tell which markets moved
+	/// while its REST calls were in flight.
+	std::uint64_t epoch{0};
+	std::vector<std::uint64_t> touched;
+	/// Cash moved by fills since construction
+	std::int64_t fill_cash{0};
+	std::int64_t base_cash{0};
+
+	std::atomic<std::int64_t> cash{0};
+	std::atomic<std::uint64_t> fills{0};
+	std::atomic<std::uint64_t> acks{0};
+	std::atomic<std::uint64_t> reconciles{0};
+	std::atomic<std::uint64_t> reconcile_errors{0};
+	std::atomic<std::uint64_t> corrections{0};
+	std::atomic<std::uint64_t> dropped{0};
+
+	// Background reconciliation
+	std::mutex reconcile_mutex; ///< One reconcile at a time
+	std::mutex stop_mutex;
+	std::condition_variable stop_cv;
+	bool stopping{false};
+	std::thread reconciler;
+
+	explicit Impl(PortfolioStateConfig c)
+		: config(std::move(c)), tickers(config.tickers),
+		  slots(std::make_unique<Slot[]>(config.max_markets)), touched(config.max_markets, 0) {
+		if (!tickers) {
+			tickers = std::make_shared<TickerTable>();
+		}
+	}
+
+	// Caller holds `mutex`.
+	[[nodiscard]] Slot* slot(TickerId id) noexcept {
+		if (!id.valid() || id.value >= config.max_markets) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		return &slots[id.value];
+	}
+
+	TickerId resolve(TickerId id, std::string_view ticker) {
+		return id.valid() ? id : tickers->intern(ticker);
+	}
+
+	// Caller holds `mutex`; the only writer, so relaxed loads of its own
+	// stores are exact.
+	static void publish(Slot& s, std::int32_t position, std::int32_t resting_yes,
+						std::int32_t resting_no) noexcept {
+		const std::uint32_t seq = s.seq.load(std::memory_order_relaxed);
+		s.seq.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		s.position.store(position, std::memory_order_relaxed);
+		s.resting_yes.store(resting_yes, std::memory_order_relaxed);
+		s.resting_no.store(resting_no, std::memory_order_relaxed);
+		s.seq.store(seq + 2, std::memory_order_release);
+	}
+
+	// Caller holds `mutex`. Moves an order's resting contribution from
+	// `before` to its current value.
+	void restate(const RestingOrder& order, std::int32_t before) noexcept {
+		const std::int32_t delta = order.resting() - before;
+		if (delta == 0) {
+			return;
+		}
+		Slot* s = slot(order.id);
+		if (s == nullptr) {
+			return;
+		}
+		const bool yes = order.exposure == OutcomeSide::Yes;
+		publish(*s, s->position.load(std::memory_order_relaxed),
+				s->resting_yes.load(std::memory_order_relaxed) + (yes ? delta : 0),
+				s->resting_no.load(std::memory_order_relaxed) + (yes ? 0 : delta));
+	}
+
+	// Caller holds `mutex`.
+	void mark(TickerId id) noexcept {
+		if (id.valid() && id.value < config.max_markets) {
+			touched[id.value] = ++epoch;
+		}
+	}
+
+	/// Install ``snapshot``, leaving markets changed after ``since`` (and
+	/// cash moved by fills after ``cash_since``) as they are.
+	void install(const PortfolioSnapshot& snapshot, std::uint64_t since, std::int64_t cash_since) {
+		std::vector<std::int32_t> position(config.max_markets, 0);
+		std::vector<std::int32_t> resting_yes(config.max_markets, 0);
+		std::vector<std::int32_t> resting_no(config.max_markets, 0);
+		for (const Position& p : snapshot.positions) {
+			const TickerId id = tickers->intern(p.market_ticker);
+			if (id.valid() && id.value < config.max_markets) {
+				position[id.value] += p.yes_contracts;
+			}
+		}
+
+		std::lock_guard lock(mutex);
+		const auto kept = [&](TickerId id) {
+			return id.valid() && id.value < config.max_markets && touched[id.value] > since;
+		};
+		std::erase_if(orders, [&](const auto& entry) { return !kept(entry.second.id); });
+		for (const Order& o : snapshot.orders) {
+			if (o.remaining_count <= 0 || is_done(o.status) || o.order_id.empty()) {
+				continue;
+			}
+			const TickerId id = tickers->intern(o.market_ticker);
+			if (kept(id)) {
+				continue;
+			}
+			RestingOrder& order = orders[o.order_id];
+			order.id = id;
+			order.exposure = derive_outcome_side(o.side, o.action);
+			order.remaining_ack = o.remaining_count;
+			order.filled_ack = o.filled_count;
+			order.filled_seen = o.filled_count;
+			if (id.valid() && id.value < config.max_markets) {
+				(order.exposure == OutcomeSide::Yes ? resting_yes : resting_no)[id.value] +=
+					o.remaining_count;
+			} else {
+				dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		for (std::size_t i = 0; i < config.max_markets; ++i) {
+			if (touched[i] > since) {
+				continue;
+			}
+			Slot& s = slots[i];
+			const std::int32_t old_position = s.position.load(std::memory_order_relaxed);
+			if (old_position == position[i] &&
+				s.resting_yes.load(std::memory_order_relaxed) == resting_yes[i] &&
+				s.resting_no.load(std::memory_order_relaxed) == resting_no[i]) {
+				continue;
+			}
+			if (old_position != position[i] && s.seq.load(std::memory_order_relaxed) != 0) {
+				corrections.fetch_add(1, std::memory_order_relaxed);
+			}
+			publish(s, position[i], resting_yes[i], resting_no[i]);
+		}
+
+		base_cash = snapshot.balance.balance - cash_since;
+		cash.store(base_cash + fill_cash, std::memory_order_relaxed);
+		reconciles.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	Result<PortfolioSnapshot> fetch() const {
+		PortfolioSnapshot snapshot;
+		Result<Balance> balance = client->get_balance();
+		if (!balance) {
+			return std::unexpected(balance.error());
+		}
+		snapshot.balance = *balance;
+
+		std::optional<std::string> cursor;
+		do {
+			GetPositionsParams params;
+			params.limit = config.page_limit;
+			params.cursor = cursor;
+			Result<PaginatedResponse<Position>> page = client->get_positions(params);
+			if (!page) {
+				return std::unexpected(page.error());
+			}
+			std::move(page->items.begin(), page->items.end(),
+					  std::back_inserter(snapshot.positions));
+			cursor = page->has_more() ? std::optional(page->next_cursor->value) : std::nullopt;
+		} while (cursor);
+
+		do {
+			GetOrdersParams params;
+			params.limit = config.page_limit;
+			params.cursor = cursor;
+			params.status = "resting";
+			Result<PaginatedResponse<Order>> page = client->get_orders(params);
+			if (!page) {
+				return std::unexpected(page.error());
+			}
+			std::move(page->items.begin(), page->items.end(), std::back_inserter(snapshot.orders));
+			cursor = page->has_more() ? std::optional(page->next_cursor->value) : std::nullopt;
+		} while (cursor);
+		return snapshot;
+	}
+
+	Result<void> reconcile() {
+		if (client == nullptr) {
+			return std::unexpected(
+				Error{ErrorCode::InvalidRequest, "PortfolioState has no KalshiClient"});
+		}
+		std::lock_guard serial(reconcile_mutex);
+		std::uint64_t since = 0;
+		std::int64_t cash_since = 0;
+		{
+			std::lock_guard lock(mutex);
+			since = epoch;
+			cash_since = fill_cash;
+		}
+		Result<PortfolioSnapshot> snapshot = fetch();
+		if (!snapshot) {
+			return std::unexpected(snapshot.error());
+		}
+		install(*snapshot, since, cash_since);
+		return {};
+	}
+
+	void run() {
+		std::unique_lock lock(stop_mutex);
+		for (;;) {
+			if (stop_cv.wait_for(lock, config.reconcile_interval, [this] { return stopping; })) {
+				return;
+			}
+			lock.unlock();
+			if (!reconcile()) {
+				reconcile_errors.fetch_add(1, std::memory_order_relaxed);
+			}
+			lock.lock();
+		}
+	}
+
+	void start() {
+		if (config.reconcile_interval.count() > 0) {
+			reconciler = std::thread([this] { run(); });
+		}
+	}
+
+	void stop() {
+		{
+			std::lock_guard lock(stop_mutex);
+			stopping = true;
+		}
+		stop_cv.notify_all();
+		if (reconciler.joinable()) {
+			reconciler.join();
+		}
+	}
+};
+
+Result<PortfolioState> PortfolioState::create(KalshiClient& client, PortfolioStateConfig config) {
+	if (!config.tickers) {
+		config.tickers = client.ticker_table();
+	}
+	PortfolioState state(std::move(config));
+	state.impl_->client = &client;
+	if (Result<void> seeded = state.impl_->reconcile(); !seeded) {
+		return std::unexpected(seeded.error());
+	}
+	state.impl_->start();
+	return state;
+}
+
+PortfolioState PortfolioState::resume(KalshiClient& client, const PortfolioSnapshot& seed,
+									  PortfolioStateConfig config) {
+	if (!config.tickers) {
+		config.tickers = client.ticker_table();
+	}
+	PortfolioState state(std::move(config));
+	state.impl_->client = &client;
+	state.reset(seed);
+	state.impl_->start();
+	return state;
+}
+
+PortfolioState::PortfolioState(PortfolioStateConfig config)
+	: impl_(std::make_unique<Impl>(std::move(config))) {}
+
+PortfolioState::~PortfolioState() {
+	if (impl_) {
+		impl_->stop();
+	}
+}
+
+PortfolioState::PortfolioState(PortfolioState&&) noexcept = default;
+
+PortfolioState& PortfolioState::operator=(PortfolioState&& other) noexcept {
+	if (this != &other) {
+		if (impl_) {
+			impl_->stop();
+		}
+		impl_ = std::move(other.impl_);
+	}
+	return *this;
+}
+
+void PortfolioState::on_fill(const WsFill& fill) {
+	const TickerId id = impl_->resolve(fill.ticker_id, fill.market_ticker);
+	const OutcomeSide exposure = derive_outcome_side(fill.side, fill.action);
+	const std::int32_t count = fill.count;
+
+	std::lock_guard lock(impl_->mutex);
+	Slot* s = impl_->slot(id);
+	if (s == nullptr) {
+		return;
+	}
+	// A fill on the side opposite the position closes contracts first,
+	// releasing the other side's price per contract; the rest opens at
+	// this side's price.
+	const std::int32_t position = s->position.load(std::memory_order_relaxed);
+	const bool yes = exposure == OutcomeSide::Yes;
+	const std::int32_t closing = std::clamp(yes ? -position : position, 0, count);
+	const std::int32_t opening = count - closing;
+	const std::int64_t cash_delta =
+		yes ? std::int64_t{closing} * fill.no_price - std::int64_t{opening} * fill.yes_price
+			: std::int64_t{closing} * fill.yes_price - std::int64_t{opening} * fill.no_price;
+	impl_->fill_cash += cash_delta;
+	impl_->cash.store(impl_->base_cash + impl_->fill_cash, std::memory_order_relaxed);
+
+	// The filled order's resting quantity shrinks in the same publish, so
+	// readers never see the fill counted twice or not at all.
+	std::int32_t resting_yes = s->resting_yes.load(std::memory_order_relaxed);
+	std::int32_t resting_no = s->resting_no.load(std::memory_order_relaxed);
+	if (!fill.order_id.empty()) {
+		const auto [it, inserted] = impl_->orders.try_emplace(fill.order_id);
+		RestingOrder& order = it->second;
+		if (inserted) {
+			order.id = id;
+			order.exposure = exposure;
+		}
+		const std::int32_t before = order.resting();
+		order.filled_seen += count;
+		(order.exposure == OutcomeSide::Yes ? resting_yes : resting_no) +=
+			order.resting() - before;
+	}
+	Impl::publish(*s, yes ? position + count : position - count, resting_yes, resting_no);
+	impl_->mark(id);
+	impl_->fills.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PortfolioState::on_order(const Order& ack) {
+	if (ack.order_id.empty()) {
+		return;
+	}
+	const TickerId id = impl_->resolve(TickerId{}, ack.market_ticker);
+
+	std::lock_guard lock(impl_->mutex);
+	const OrderMap::iterator it = impl_->orders.try_emplace(ack.order_id).first;
+	RestingOrder& order = it->second;
+	const std::int32_t before = order.resting();
+	order.id = id;
+	order.exposure = derive_outcome_side(ack.side, ack.action);
+	order.remaining_ack = is_done(ack.status) ? 0 : std::max(0, ack.remaining_count);
+	order.filled_ack = ack.filled_count;
+	impl_->restate(order, before);
+	if (is_done(ack.status)) {
+		impl_->orders.erase(it);
+	}
+	impl_->mark(id);
+	impl_->acks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PortfolioState::reset(const PortfolioSnapshot& snapshot) {
+	std::int64_t cash_since = 0;
+	std::uint64_t since = 0;
+	{
+		std::lock_guard lock(impl_->mutex);
+		since = impl_->epoch;
+		cash_since = impl_->fill_cash;
+	}
+	impl_->install(snapshot, since, cash_since);
+}
+
+Result<void> PortfolioState::reconcile() {
+	return impl_->reconcile();
+}
+
+PortfolioSnapshot PortfolioState::snapshot() const {
+	PortfolioSnapshot out;
+	std::lock_guard lock(impl_->mutex);
+	out.balance.balance = impl_->base_cash + impl_->fill_cash;
+	out.balance.available_balance = out.balance.balance;
+	for (std::size_t i = 0; i < impl_->config.max_markets; ++i) {
+		const std::int32_t position = impl_->slots[i].position.load(std::memory_order_relaxed);
+		const std::string_view ticker =
+			position != 0 ? impl_->tickers->name(TickerId{static_cast<std::uint32_t>(i)}) : "";
+		if (!ticker.empty()) {
+			Position& p = out.positions.emplace_back();
+			p.market_ticker = ticker;
+			p.yes_contracts = position;
+		}
+	}
+	for (const auto& [order_id, resting] : impl_->orders) {
+		const std::int32_t count = resting.resting();
+		if (count <= 0 || !resting.id.valid()) {
+			continue;
+		}
+		Order& o = out.orders.emplace_back();
+		o.order_id = order_id;
+		o.market_ticker = impl_->tickers->name(resting.id);
+		o.side = resting.exposure == OutcomeSide::Yes ? Side::Yes : Side::No;
+		o.action = Action::Buy;
+		o.status = OrderStatus::Open;
+		o.remaining_count = count;
+	}
+	return out;
+}
+
+MarketExposure PortfolioState::exposure(TickerId id) const noexcept {
+	if (!id.valid() || id.value >= impl_->config.max_markets) {
+		return {};
+	}
+	const Slot& s = impl_->slots[id.value];
+	for (;;) {
+		const std::uint32_t before = s.seq.load(std::memory_order_acquire);
+		if ((before & 1U) != 0) {
+			cpu_relax();
+			continue;
+		}
+		MarketExposure out;
+		out.position = s.position.load(std::memory_order_relaxed);
+		out.resting_yes = s.resting_yes.load(std::memory_order_relaxed);
+		out.resting_no = s.resting_no.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (s.seq.load(std::memory_order_relaxed) == before) {
+			out.version = before / 2;
+			return out;
+		}
+	}
+}
+
+std::optional<MarketExposure> PortfolioState::exposure(std::string_view ticker) const {
+	const std::optional<TickerId> id = impl_->tickers->find(ticker);
+	if (!id) {
+		return std::nullopt;
+	}
+	return exposure(*id);
+}
+
+std::int64_t PortfolioState::cash_cents() const noexcept {
+	return impl_->cash.load(std::memory_order_relaxed);
+}
+
+PortfolioStats PortfolioState::stats() const noexcept {
+	return {impl_->fills.load(std::memory_order_relaxed),
+			impl_->acks.load(std::memory_order_relaxed),
+			impl_->reconciles.load(std::memory_order_relaxed),
+			impl_->reconcile_errors.load(std::memory_order_relaxed),
+			impl_->corrections.load(std::memory_order_relaxed),
+			impl_->dropped.load(std::memory_order_relaxed)};
+}
+
+const std::shared_ptr<TickerTable>& PortfolioState::ticker_table() const noexcept {
+	return impl_->tickers;
+}
+
+} // namespace kalshi
@@ -3,6 +3,7 @@
 #include "kalshi/api.hpp"
 
 #include <string>
+#include <string_view>
 
 namespace kalshi::api_detail {
 
@@ -13,6 +14,15 @@ namespace kalshi::api_detail {
 // the access modifier is part of the mangled symbol name on Windows).
 [[nodiscard]] std::string build_series_query_string(const GetSeriesParams& params);
 
+/// Path and query for ``GET /series/{event_ticker}/markets/{ticker}/candlesticks``.
+[[nodiscard]] std::string build_candlesticks_path(const GetCandlesticksParams& params);
+
+/// Path and query for ``GET /trades``.
+[[nodiscard]] std::string build_trades_path(const GetTradesParams& params);
+
+/// Builds ``/portfolio/orders/{order_id}/amend``.
+[[nodiscard]] std::string build_amend_order_path(std::string_view order_id);
+
 /// Builds the event-market cancel-order V2 path including optional
 /// subaccount and exchange-index query parameters.
 [[nodiscard]] std::string build_cancel_order_v2_path(const CancelOrderV2Params& params);
@@ -2,6 +2,7 @@
 
 #include "kalshi/api.hpp"
 
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -9,10 +10,17 @@ namespace kalshi::api_detail {
 
 /// Parses a single market response. Accepts both ``{"market": {...}}`` and a
 /// bare market object.
-[[nodiscard]] Market parse_market_response(std::string_view body);
+[[nodiscard]] Market parse_market_response(std::string_view body,
+										   MarketFields fields = MarketFields::all());
+
+/// Parses one bare market object (an element of the ``markets`` array).
+/// Fields outside ``fields`` are not scanned and keep their defaults.
+[[nodiscard]] Market parse_market_object(const std::string& market_json,
+										 MarketFields fields = MarketFields::all());
 
 /// Parses the ``markets`` array returned by ``GET /markets``.
-[[nodiscard]] std::vector<Market> parse_markets_response(std::string_view body);
+[[nodiscard]] std::vector<Market> parse_markets_response(std::string_view body,
+														 MarketFields fields = MarketFields::all());
 
 [[nodiscard]] std::vector<Candlestick> parse_candlesticks_response(std::string_view body);
 
@@ -24,10 +32,29 @@ namespace kalshi::api_detail {
 /// Parses the ``orderbooks`` array returned by ``GET /markets/orderbooks``.
 [[nodiscard]] std::vector<OrderBook> parse_orderbooks_response(std::string_view body);
 
+/// Walks the ``orderbooks`` array in place, parsing and handing over one
+/// book at a time; stops when ``on_book`` returns false. Returns the
+/// number of books delivered.
+std::size_t for_each_orderbook(std::string_view body, const OrderBookSink& on_book);
+
+/// Parses one element of the ``trades`` array.
+[[nodiscard]] PublicTrade parse_trade_object(const std::string& trade_json,
+											 TradeFields fields = TradeFields::all());
+
 /// Parses the ``trades`` array from ``GET /markets/trades``. Returns an empty
 /// vector when the array is missing or empty. The cursor field is read
 /// separately by the client method.
-[[nodiscard]] std::vector<PublicTrade> parse_trades_response(std::string_view body);
+[[nodiscard]] std::vector<PublicTrade>
+parse_trades_response(std::string_view body, TradeFields fields = TradeFields::all());
+
+/// Parses one element of the ``fills`` array.
+[[nodiscard]] Fill parse_fill_object(const std::string& fill_json);
+
+/// Parses the ``fills`` array from ``GET /portfolio/fills``.
+[[nodiscard]] std::vector<Fill> parse_fills_response(std::string_view body);
+
+/// The ``cursor`` of a paginated response; empty on the last page.
+[[nodiscard]] std::string parse_cursor(std::string_view body);
 
 /// Parses the ``deposits`` array from ``GET /portfolio/deposits``. Returns
 /// an empty vector when the array is missing or empty. The cursor field
@@ -45,6 +72,11 @@ namespace kalshi::api_detail {
 [[nodiscard]] std::vector<OrderCancelResult>
 parse_batch_order_cancel_result_response(std::string_view body);
 
+/// Parses the per-order ``error`` messages from
+/// ``POST /portfolio/orders/batched``, one per rejected order, in request
+/// order. Falls back to the error ``code``, then to "order rejected".
+[[nodiscard]] std::vector<std::string> parse_batch_create_errors(std::string_view body);
+
 /// Parses ``GET /account/limits``.
 [[nodiscard]] AccountApiLimits parse_account_api_limits_response(std::string_view body);
 
@@ -0,0 +1,382 @@
+#include "kalshi/risk_gate.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace kalshi {
+
+namespace {
+
+constexpr std::uint32_t kUnresolved = 0xFFFFFFFFU;
+/// Set on a slot's profile when ``set_limits`` named the ticker itself,
+/// so a later ``set_series_limits`` leaves it alone.
+constexpr std::uint32_t kExplicit = 0x80000000U;
+constexpr std::int64_t kTicksPerContract = Price::kTicksPerDollar;
+
+struct StringHash {
+	using is_transparent = void;
+	std::size_t operator()(std::string_view s) const noexcept {
+		return std::hash<std::string_view>{}(s);
+	}
+};
+
+/// Best bid / ask in YES ticks packed into one word so both sides are
+/// read together; 0 means no level on that side.
+constexpr std::uint64_t pack_quote(std::int64_t bid, std::int64_t ask) noexcept {
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(bid)) << 32) |
+		   static_cast<std::uint32_t>(ask);
+}
+constexpr std::int64_t quote_bid(std::uint64_t quote) noexcept {
+	return static_cast<std::int64_t>(quote >> 32);
+}
+constexpr std::int64_t quote_ask(std::uint64_t quote) noexcept {
+	return static_cast<std::int64_t>(quote & 0xFFFFFFFFU);
+}
+
+struct alignas(64) MarketSlot {
+	std::atomic<std::uint32_t> profile{kUnresolved};
+	std::atomic<std::uint64_t> book{0};
+	std::atomic<std::uint64_t> own{0};
+};
+
+/// Our resting orders in one market, as YES-terms bid / ask ticks
+struct OwnBook {
+	std::multiset<std::int64_t> bids;
+	std::multiset<std::int64_t> asks;
+};
+
+struct OwnOrder {
+	TickerId id;
+	bool bid{true};
+	std::int64_t ticks{0};
+};
+
+/// The order's limit in YES ticks, whichever side's price it carries
+std::optional<std::int64_t> yes_ticks(const CreateOrderParams& params) noexcept {
+	if (params.yes_price_dollars) {
+		return params.yes_price_dollars->ticks();
+	}
+	if (params.yes_price) {
+		return std::int64_t{*params.yes_price} * Price::kTicksPerCent;
+	}
+	if (params.no_price_dollars) {
+		return kTicksPerContract - params.no_price_dollars->ticks();
+	}
+	if (params.no_price) {
+		return kTicksPerContract - std::int64_t{*params.no_price} * Price::kTicksPerCent;
+	}
+	return std::nullopt;
+}
+
+RiskDecision reject(RiskReason reason) noexcept {
+	return {RiskDecision::Verdict::Reject, reason, 0};
+}
+
+} // namespace
+
+std::string_view to_string(RiskReason reason) noexcept {
+	switch (reason) {
+	case RiskReason::None:
+		return "none";
+	case RiskReason::Halted:
+		return "trading halted";
+	case RiskReason::OrderSize:
+		return "order size limit";
+	case RiskReason::Notional:
+		return "order notional limit";
+	case RiskReason::Position:
+		return "position limit";
+	case RiskReason::PriceThrough:
+		return "price through the market";
+	case RiskReason::SelfCross:
+		return "self-cross";
+	case RiskReason::NoPrice:
+		return "limit order without a price";
+	case RiskReason::TooManyMarkets:
+		return "market table full";
+	}
+	return "unknown";
+}
+
+struct RiskGate::Impl {
+	RiskGateConfig config;
+	std::shared_ptr<TickerTable> tickers;
+	std::unique_ptr<MarketSlot[]> slots;
+	/// Immutable once published through a slot; index 0 is the defaults.
+	std::unique_ptr<RiskLimits[]> profiles;
+	std::atomic<bool> halted{false};
+
+	std::atomic<std::uint64_t> checked{0};
+	std::atomic<std::uint64_t> clipped{0};
+	std::atomic<std::uint64_t> rejected{0};
+
+	// Writer state, guarded by `mutex`.
+	std::mutex mutex;
+	std::size_t profile_count{1};
+	std::unordered_map<std::string, std::uint32_t, StringHash, std::equal_to<>> series;
+	std::unordered_map<std::string, OwnOrder, StringHash, std::equal_to<>> own_orders;
+	std::unordered_map<std::uint32_t, OwnBook> own_books;
+
+	explicit Impl(RiskGateConfig c)
+		: config(std::move(c)), tickers(config.tickers),
+		  slots(std::make_unique<MarketSlot[]>(config.max_markets)),
+		  profiles(std::make_unique<RiskLimits[]>(config.max_profiles + 1)) {
+		if (!tickers && config.portfolio) {
+			tickers = config.portfolio->ticker_table();
+		}
+		if (!tickers) {
+			tickers = std::make_shared<TickerTable>();
+		}
+		profiles[0] = config.defaults;
+	}
+
+	[[nodiscard]] MarketSlot* slot(TickerId id) const noexcept {
+		return id.valid() && id.value < config.max_markets ? &slots[id.value] : nullptr;
+	}
+
+	// Caller holds `mutex`.
+	Result<std::uint32_t> add_profile(const RiskLimits& limits) {
+		if (profile_count > config.max_profiles) {
+			return std::unexpected(
+				Error{ErrorCode::InvalidRequest, "RiskGate: max_profiles limit sets in use"});
+		}
+		profiles[profile_count] = limits;
+		return static_cast<std::uint32_t>(profile_count++);
+	}
+
+	/// Limits for a market seen for the first time (or since a series
+	/// change): its series entry, else the defaults.
+	std::uint32_t resolve(MarketSlot& s, std::string_view ticker) {
+		std::lock_guard lock(mutex);
+		std::uint32_t profile = s.profile.load(std::memory_order_relaxed);
+		if (profile != kUnresolved) {
+			return profile;
+		}
+		profile = 0;
+		const auto it = series.find(ticker.substr(0, ticker.find('-')));
+		if (it != series.end()) {
+			profile = it->second;
+		}
+		s.profile.store(profile, std::memory_order_release);
+		return profile;
+	}
+
+	// Caller holds `mutex`.
+	void publish_own(TickerId id) {
+		MarketSlot* s = slot(id);
+		if (s == nullptr) {
+			return;
+		}
+		const OwnBook& book = own_books[id.value];
+		const std::int64_t bid = book.bids.empty() ? 0 : *book.bids.rbegin();
+		const std::int64_t ask = book.asks.empty() ? 0 : *book.asks.begin();
+		s->own.store(pack_quote(bid, ask), std::memory_order_relaxed);
+	}
+
+	// Caller holds `mutex`.
+	void remove_own(const OwnOrder& order) {
+		OwnBook& book = own_books[order.id.value];
+		std::multiset<std::int64_t>& side = order.bid ? book.bids : book.asks;
+		if (const auto it = side.find(order.ticks); it != side.end()) {
+			side.erase(it);
+		}
+	}
+
+	RiskDecision decide(const CreateOrderParams& params) {
+		if (halted.load(std::memory_order_relaxed)) {
+			return reject(RiskReason::Halted);
+		}
+		const std::optional<TickerId> found = tickers->find(params.ticker);
+		const TickerId id = found ? *found : tickers->intern(params.ticker);
+		MarketSlot* s = slot(id);
+		if (s == nullptr) {
+			return reject(RiskReason::TooManyMarkets);
+		}
+		std::uint32_t profile = s->profile.load(std::memory_order_acquire);
+		if (profile == kUnresolved) {
+			profile = resolve(*s, params.ticker);
+		}
+		const RiskLimits& limits = profiles[profile & ~kExplicit];
+
+		const bool yes = derive_outcome_side(params.side, params.action) == OutcomeSide::Yes;
+		const std::optional<std::int64_t> price = yes_ticks(params);
+		if (!price && params.type != "market") {
+			return reject(RiskReason::NoPrice);
+		}
+		if (price) {
+			const std::uint64_t book = s->book.load(std::memory_order_relaxed);
+			const std::int64_t band = limits.max_price_through.ticks();
+			if (band > 0) {
+				const std::int64_t ask = quote_ask(book);
+				const std::int64_t bid = quote_bid(book);
+				if (yes ? (ask != 0 && *price > ask + band) : (bid != 0 && *price < bid - band)) {
+					return reject(RiskReason::PriceThrough);
+				}
+			}
+			if (limits.reject_self_cross) {
+				const std::uint64_t own = s->own.load(std::memory_order_relaxed);
+				const std::int64_t own_ask = quote_ask(own);
+				const std::int64_t own_bid = quote_bid(own);
+				if (yes ? (own_ask != 0 && *price >= own_ask)
+						: (own_bid != 0 && *price <= own_bid)) {
+					return reject(RiskReason::SelfCross);
+				}
+			}
+		}
+
+		// Size limits: the smallest one binds.
+		const std::int32_t requested = params.count;
+		std::int32_t allowed = requested;
+		RiskReason reason = RiskReason::None;
+		const auto limit_to = [&](std::int64_t cap, RiskReason why) {
+			const std::int32_t capped = static_cast<std::int32_t>(
+				std::clamp<std::int64_t>(cap, 0, std::numeric_limits<std::int32_t>::max()));
+			if (capped < allowed) {
+				allowed = capped;
+				reason = why;
+			}
+		};
+		if (limits.max_order_contracts > 0) {
+			limit_to(limits.max_order_contracts, RiskReason::OrderSize);
+		}
+		if (limits.max_order_notional_cents > 0) {
+			// Market orders are costed at a full contract.
+			const std::int64_t unit = !price ? kTicksPerContract
+								: yes	 ? *price
+										 : kTicksPerContract - *price;
+			if (unit > 0) {
+				limit_to(limits.max_order_notional_cents * Price::kTicksPerCent / unit,
+						 RiskReason::Notional);
+			}
+		}
+		if (limits.max_position > 0 && config.portfolio) {
+			const MarketExposure e = config.portfolio->exposure(id);
+			limit_to(std::int64_t{limits.max_position} - (yes ? e.max_yes() : e.max_no()),
+					 RiskReason::Position);
+		}
+
+		if (allowed == requested) {
+			return {RiskDecision::Verdict::Accept, RiskReason::None, requested};
+		}
+		if (allowed > 0 && limits.clip) {
+			clipped.fetch_add(1, std::memory_order_relaxed);
+			return {RiskDecision::Verdict::Clip, reason, allowed};
+		}
+		return reject(reason);
+	}
+};
+
+RiskGate::RiskGate(RiskGateConfig config) : impl_(std::make_unique<Impl>(std::move(config))) {}
+
+RiskGate::~RiskGate() = default;
+
+Result<void> RiskGate::set_limits(std::string_view ticker, const RiskLimits& limits) {
+	const TickerId id = impl_->tickers->intern(ticker);
+	MarketSlot* s = impl_->slot(id);
+	if (s == nullptr) {
+		return std::unexpected(
+			Error{ErrorCode::InvalidRequest, "RiskGate: ticker id past max_markets"});
+	}
+	std::lock_guard lock(impl_->mutex);
+	Result<std::uint32_t> profile = impl_->add_profile(limits);
+	if (!profile) {
+		return std::unexpected(profile.error());
+	}
+	s->profile.store(*profile | kExplicit, std::memory_order_release);
+	return {};
+}
+
+Result<void> RiskGate::set_series_limits(std::string_view series_ticker,
+										 const RiskLimits& limits) {
+	std::lock_guard lock(impl_->mutex);
+	Result<std::uint32_t> profile = impl_->add_profile(limits);
+	if (!profile) {
+		return std::unexpected(profile.error());
+	}
+	impl_->series.insert_or_assign(std::string(series_ticker), *profile);
+	// Markets without their own entry pick the new limits up on their
+	// next check.
+	for (std::size_t i = 0; i < impl_->config.max_markets; ++i) {
+		std::atomic<std::uint32_t>& slot_profile = impl_->slots[i].profile;
+		if ((slot_profile.load(std::memory_order_relaxed) & kExplicit) == 0) {
+			slot_profile.store(kUnresolved, std::memory_order_relaxed);
+		}
+	}
+	return {};
+}
+
+void RiskGate::set_halted(bool halted) noexcept {
+	impl_->halted.store(halted, std::memory_order_relaxed);
+}
+
+bool RiskGate::halted() const noexcept {
+	return impl_->halted.load(std::memory_order_relaxed);
+}
+
+void RiskGate::on_quote(TickerId id, std::optional<Price> best_bid,
+						std::optional<Price> best_ask) {
+	if (MarketSlot* s = impl_->slot(id)) {
+		const std::int64_t bid = best_bid ? best_bid->ticks() : 0;
+		const std::int64_t ask = best_ask ? best_ask->ticks() : 0;
+		s->book.store(pack_quote(bid, ask), std::memory_order_relaxed);
+	}
+}
+
+void RiskGate::on_order(const Order& order) {
+	if (order.order_id.empty()) {
+		return;
+	}
+	const TickerId id = impl_->tickers->intern(order.market_ticker);
+	if (impl_->slot(id) == nullptr) {
+		return;
+	}
+	const bool resting = order.remaining_count > 0 && order.status != OrderStatus::Cancelled &&
+						 order.status != OrderStatus::Filled;
+
+	std::lock_guard lock(impl_->mutex);
+	const auto it = impl_->own_orders.find(order.order_id);
+	if (it != impl_->own_orders.end()) {
+		impl_->remove_own(it->second);
+		if (it->second.id != id) {
+			impl_->publish_own(it->second.id);
+		}
+		impl_->own_orders.erase(it);
+	}
+	if (resting) {
+		// ``Order::price`` is the YES price when the response carries one.
+		const OwnOrder own{id, derive_outcome_side(order.side, order.action) == OutcomeSide::Yes,
+						   std::int64_t{order.price} * Price::kTicksPerCent};
+		OwnBook& book = impl_->own_books[id.value];
+		(own.bid ? book.bids : book.asks).insert(own.ticks);
+		impl_->own_orders.emplace(order.order_id, own);
+	}
+	impl_->publish_own(id);
+}
+
+RiskDecision RiskGate::check(const CreateOrderParams& params) const {
+	impl_->checked.fetch_add(1, std::memory_order_relaxed);
+	const RiskDecision decision = impl_->decide(params);
+	if (!decision.accepted()) {
+		impl_->rejected.fetch_add(1, std::memory_order_relaxed);
+	}
+	return decision;
+}
+
+RiskGateStats RiskGate::stats() const noexcept {
+	return {impl_->checked.load(std::memory_order_relaxed),
+			impl_->clipped.load(std::memory_order_relaxed),
+			impl_->rejected.load(std::memory_order_relaxed)};
+}
+
+const std::shared_ptr<TickerTable>& RiskGate::ticker_table() const noexcept {
+	return impl_->tickers;
+}
+
+} // namespace kalshi
@@ -0,0 +1,766 @@
+#include "kalshi/warm_state.hpp"
+
+#include "mapped_file.hpp"
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace kalshi {
+
+namespace {
+
+using api_detail::Mapping;
+using api_detail::padded;
+
+// File layout: a 64-byte header, then sections, each a 16-byte section
+// header (u64 kind, u64 payload bytes) and its payload padded to 8 bytes.
+// Unknown section kinds are skipped.
+//
+//   0  magic "KALSHIWS"     16  i64 saved at (unix ms)
+//   8  u16 version          24  i64 user data timestamp
+//  10  u16 flags (bit 0: user data timestamp valid)
+//  12  u32 section count
+constexpr std::string_view kMagic{"KALSHIWS"};
+constexpr std::uint16_t kVersion = 1;
+constexpr std::size_t kHeaderSize = 64;
+constexpr std::size_t kSectionHeaderSize = 16;
+constexpr std::uint16_t kFlagUserData = 1;
+
+enum class SectionKind : std::uint32_t { Markets = 1, Metadata = 2, Portfolio = 3, Books = 4 };
+
+// The markets section is columnar so it restores with one copy per
+// column: a 32-byte header (u64 rows, u64 pool bytes, u64 dead pool
+// bytes, u64 reserved), one array per column padded to 8 bytes, then the
+// string pool.
+//
+// Element widths: open time, close time, yes bid, yes ask, no bid, no ask,
+// volume, open interest, last price, status, then the ticker / title /
+// subtitle / result pool references.
+constexpr std::size_t kMarketsHeaderSize = 32;
+constexpr std::array<std::size_t, 14> kMarketWidths{8, 8, 4, 4, 4, 4, 4, 4, 4, 1, 8, 8, 8, 8};
+constexpr std::size_t kFirstTextColumn = 10;
+
+Error file_error(std::string what, const std::string& path) {
+	return Error{ErrorCode::InvalidRequest, std::move(what) + ": " + path};
+}
+
+std::int64_t unix_ms(std::chrono::system_clock::time_point t) noexcept {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()).count();
+}
+
+// Appends fixed-width values and length-prefixed strings. The
+// variable-length sections are small next to the market columns, so they
+// are encoded field by field rather than laid out for mapping.
+class ByteWriter {
+public:
+	template <typename T> void pod(const T& value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		out_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T> void pod(const std::optional<T>& value) {
+		pod<std::uint8_t>(value ? 1 : 0);
+		if (value) {
+			pod(*value);
+		}
+	}
+
+	void text(std::string_view value) {
+		pod(static_cast<std::uint32_t>(value.size()));
+		out_.append(value);
+	}
+
+	void maybe_text(const std::optional<std::string>& value) {
+		pod<std::uint8_t>(value ? 1 : 0);
+		if (value) {
+			text(*value);
+		}
+	}
+
+	[[nodiscard]] std::string& bytes() noexcept { return out_; }
+
+private:
+	std::string out_;
+};
+
+// Reads what ``ByteWriter`` wrote. Every read is bounds-checked; after the
+// first failure ``ok`` stays false and reads leave their targets alone.
+class ByteReader {
+public:
+	explicit ByteReader(std::string_view in) noexcept : in_(in) {}
+
+	template <typename T> bool pod(T& value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		if (!ok_ || in_.size() - pos_ < sizeof(T)) {
+			ok_ = false;
+			return false;
+		}
+		std::memcpy(&value, in_.data() + pos_, sizeof(T));
+		pos_ += sizeof(T);
+		return true;
+	}
+
+	template <typename T> bool pod(std::optional<T>& value) {
+		std::uint8_t present = 0;
+		if (!pod(present)) {
+			return false;
+		}
+		if (present == 0) {
+			value.reset();
+			return true;
+		}
+		T v{};
+		if (!pod(v)) {
+			return false;
+		}
+		value = v;
+		return true;
+	}
+
+	bool text(std::string& value) {
+		std::uint32_t size = 0;
+		if (!pod(size)) {
+			return false;
+		}
+		if (in_.size() - pos_ < size) {
+			ok_ = false;
+			return false;
+		}
+		value.assign(in_.data() + pos_, size);
+		pos_ += size;
+		return true;
+	}
+
+	bool maybe_text(std::optional<std::string>& value) {
+		std::uint8_t present = 0;
+		if (!pod(present)) {
+			return false;
+		}
+		if (present == 0) {
+			value.reset();
+			return true;
+		}
+		return text(value.emplace());
+	}
+
+	/// A count read ahead of that many records of at least ``min_record``
+	/// bytes; fails rather than letting a corrupt count size a vector.
+	bool count(std::uint32_t& n, std::size_t min_record) {
+		if (!pod(n)) {
+			return false;
+		}
+		if (min_record > 0 && n > (in_.size() - pos_) / min_record) {
+			ok_ = false;
+			return false;
+		}
+		return true;
+	}
+
+	[[nodiscard]] bool ok() const noexcept { return ok_; }
+
+private:
+	std::string_view in_;
+	std::size_t pos_{0};
+	bool ok_{true};
+};
+
+// ===== Record codecs =====
+
+void write(ByteWriter& w, const Market& m) {
+	w.pod(m.open_time);
+	w.pod(m.close_time);
+	w.pod(m.expected_expiration_time);
+	w.pod(m.expiration_time);
+	w.pod(m.latest_expiration_time);
+	w.pod(m.settlement_ts);
+	w.pod(m.yes_bid_dollars.ticks());
+	w.pod(m.yes_ask_dollars.ticks());
+	w.pod(m.no_bid_dollars.ticks());
+	w.pod(m.no_ask_dollars.ticks());
+	w.pod(m.yes_bid);
+	w.pod(m.yes_ask);
+	w.pod(m.no_bid);
+	w.pod(m.no_ask);
+	w.pod(m.volume);
+	w.pod(m.open_interest);
+	w.pod(m.settlement_timer_seconds);
+	w.pod(m.settlement_value_cents);
+	w.pod(m.status);
+	w.text(m.ticker);
+	w.text(m.title);
+	w.text(m.subtitle);
+	w.maybe_text(m.expiration_value);
+	w.maybe_text(m.result);
+}
+
+bool read(ByteReader& r, Market& m) {
+	std::array<std::int64_t, 4> ticks{};
+	r.pod(m.open_time);
+	r.pod(m.close_time);
+	r.pod(m.expected_expiration_time);
+	r.pod(m.expiration_time);
+	r.pod(m.latest_expiration_time);
+	r.pod(m.settlement_ts);
+	for (std::int64_t& t : ticks) {
+		r.pod(t);
+	}
+	r.pod(m.yes_bid);
+	r.pod(m.yes_ask);
+	r.pod(m.no_bid);
+	r.pod(m.no_ask);
+	r.pod(m.volume);
+	r.pod(m.open_interest);
+	r.pod(m.settlement_timer_seconds);
+	r.pod(m.settlement_value_cents);
+	r.pod(m.status);
+	r.text(m.ticker);
+	r.text(m.title);
+	r.text(m.subtitle);
+	r.maybe_text(m.expiration_value);
+	r.maybe_text(m.result);
+	m.yes_bid_dollars = Price::from_ticks(ticks[0]);
+	m.yes_ask_dollars = Price::from_ticks(ticks[1]);
+	m.no_bid_dollars = Price::from_ticks(ticks[2]);
+	m.no_ask_dollars = Price::from_ticks(ticks[3]);
+	return r.ok();
+}
+
+void write(ByteWriter& w, const Event& e) {
+	w.text(e.event_ticker);
+	w.text(e.series_ticker);
+	w.text(e.title);
+	w.text(e.category);
+	w.text(e.sub_title);
+	w.pod(e.mutually_exclusive);
+	w.pod(static_cast<std::uint32_t>(e.market_tickers.size()));
+	for (const std::string& ticker : e.market_tickers) {
+		w.text(ticker);
+	}
+}
+
+bool read(ByteReader& r, Event& e) {
+	r.text(e.event_ticker);
+	r.text(e.series_ticker);
+	r.text(e.title);
+	r.text(e.category);
+	r.text(e.sub_title);
+	r.pod(e.mutually_exclusive);
+	std::uint32_t n = 0;
+	if (r.count(n, sizeof(std::uint32_t))) {
+		e.market_tickers.resize(n);
+		for (std::string& ticker : e.market_tickers) {
+			r.text(ticker);
+		}
+	}
+	return r.ok();
+}
+
+void write(ByteWriter& w, const EventMetadata& m) {
+	w.text(m.event_ticker);
+	w.text(m.description);
+	w.text(m.rules);
+	w.text(m.resolution_source);
+}
+
+bool read(ByteReader& r, EventMetadata& m) {
+	r.text(m.event_ticker);
+	r.text(m.description);
+	r.text(m.rules);
+	r.text(m.resolution_source);
+	return r.ok();
+}
+
+void write(ByteWriter& w, const Series& s) {
+	w.text(s.ticker);
+	w.text(s.title);
+	w.text(s.category);
+	w.text(s.frequency);
+}
+
+bool read(ByteReader& r, Series& s) {
+	r.text(s.ticker);
+	r.text(s.title);
+	r.text(s.category);
+	r.text(s.frequency);
+	return r.ok();
+}
+
+void write_levels(ByteWriter& w, const std::vector<OrderBookEntry>& levels) {
+	w.pod(static_cast<std::uint32_t>(levels.size()));
+	for (const OrderBookEntry& level : levels) {
+		w.pod(level.price_cents);
+		w.pod(level.quantity);
+	}
+}
+
+bool read_levels(ByteReader& r, std::vector<OrderBookEntry>& levels) {
+	std::uint32_t n = 0;
+	if (!r.count(n, 2 * sizeof(std::int32_t))) {
+		return false;
+	}
+	levels.resize(n, OrderBookEntry{0, 0});
+	for (OrderBookEntry& level : levels) {
+		r.pod(level.price_cents);
+		r.pod(level.quantity);
+	}
+	return r.ok();
+}
+
+template <typename T>
+void write_entries(ByteWriter& w, const std::vector<MetadataEntry<T>>& entries) {
+	w.pod(static_cast<std::uint32_t>(entries.size()));
+	for (const MetadataEntry<T>& entry : entries) {
+		w.pod(static_cast<std::int64_t>(entry.ttl.count()));
+		write(w, *entry.value);
+	}
+}
+
+// Puts the entries whose TTL outlasts `elapsed_ms`, with what is left.
+template <typename T>
+std::size_t restore_entries(ByteReader& r, MetadataCache& cache, std::int64_t elapsed_ms) {
+	std::uint32_t n = 0;
+	if (!r.count(n, sizeof(std::int64_t))) {
+		return 0;
+	}
+	std::size_t restored = 0;
+	for (std::uint32_t i = 0; i < n; ++i) {
+		std::int64_t ttl_ms = 0;
+		T value;
+		if (!r.pod(ttl_ms) || !read(r, value)) {
+			break;
+		}
+		if (ttl_ms > elapsed_ms) {
+			cache.put(std::move(value), std::chrono::milliseconds{ttl_ms - elapsed_ms});
+			++restored;
+		}
+	}
+	return restored;
+}
+
+// ===== Sections =====
+
+template <typename T> std::span<const std::byte> bytes_of(const std::vector<T>& column) {
+	return std::as_bytes(std::span<const T>(column));
+}
+
+void append_padded(std::string& out, std::span<const std::byte> bytes) {
+	out.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	out.append(padded(bytes.size()) - bytes.size(), '\0');
+}
+
+std::string encode_metadata(const MetadataCache& cache) {
+	const MetadataCacheEntries entries = cache.entries();
+	ByteWriter w;
+	write_entries(w, entries.markets);
+	write_entries(w, entries.events);
+	write_entries(w, entries.event_metadata);
+	write_entries(w, entries.series);
+	return std::move(w.bytes());
+}
+
+std::string encode_portfolio(const PortfolioSnapshot& snapshot) {
+	ByteWriter w;
+	w.pod(snapshot.balance.balance);
+	w.pod(snapshot.balance.available_balance);
+	w.pod(static_cast<std::uint32_t>(snapshot.positions.size()));
+	for (const Position& p : snapshot.positions) {
+		w.text(p.market_ticker);
+		w.pod(p.yes_contracts);
+		w.pod(p.no_contracts);
+		w.pod(p.total_cost_cents);
+	}
+	w.pod(static_cast<std::uint32_t>(snapshot.orders.size()));
+	for (const Order& o : snapshot.orders) {
+		w.text(o.order_id);
+		w.text(o.market_ticker);
+		w.pod(o.side);
+		w.pod(o.action);
+		w.pod(o.status);
+		w.pod(o.remaining_count);
+		w.pod(o.filled_count);
+	}
+	return std::move(w.bytes());
+}
+
+std::string encode_books(const std::vector<OrderbookSnapshot>& books) {
+	ByteWriter w;
+	w.pod(static_cast<std::uint32_t>(books.size()));
+	for (const OrderbookSnapshot& book : books) {
+		w.text(book.market_ticker);
+		w.pod(book.seq);
+		write_levels(w, book.yes);
+		write_levels(w, book.no);
+	}
+	return std::move(w.bytes());
+}
+
+} // namespace
+
+struct WarmState::Impl {
+	std::shared_ptr<const Mapping> mapping;
+	std::int64_t saved_at_ms{0};
+	std::optional<std::int64_t> user_data_timestamp;
+	// Section payloads inside `mapping`; empty when absent
+	std::string_view markets;
+	std::string_view metadata;
+	std::string_view portfolio;
+	std::string_view books;
+
+	// The market codec lives here, inside ``MarketTable``'s friend, so it
+	// can reach the private columns.
+	static std::string encode_markets(const MarketTable& table);
+	[[nodiscard]] std::size_t restore_markets(MarketTable& table, TickerTable* tickers) const;
+	[[nodiscard]] static bool valid_markets(std::string_view payload);
+};
+
+std::string WarmState::Impl::encode_markets(const MarketTable& table) {
+	std::string out;
+	const std::array<std::uint64_t, 4> head{table.size(), table.pool_.size(), table.dead_bytes_,
+											0};
+	append_padded(out, std::as_bytes(std::span<const std::uint64_t>(head)));
+	append_padded(out, bytes_of(table.open_times_));
+	append_padded(out, bytes_of(table.close_times_));
+	append_padded(out, bytes_of(table.yes_bids_));
+	append_padded(out, bytes_of(table.yes_asks_));
+	append_padded(out, bytes_of(table.no_bids_));
+	append_padded(out, bytes_of(table.no_asks_));
+	append_padded(out, bytes_of(table.volumes_));
+	append_padded(out, bytes_of(table.open_interests_));
+	append_padded(out, bytes_of(table.last_prices_));
+	append_padded(out, bytes_of(table.statuses_));
+	append_padded(out, bytes_of(table.tickers_));
+	append_padded(out, bytes_of(table.titles_));
+	append_padded(out, bytes_of(table.subtitles_));
+	append_padded(out, bytes_of(table.results_));
+	append_padded(out, std::as_bytes(std::span<const char>(table.pool_)));
+	return out;
+}
+
+// Checks the section's sizes, every pool reference and every status, so
+// ``restore_markets`` can copy without further checks.
+bool WarmState::Impl::valid_markets(std::string_view payload) {
+	if (payload.size() < kMarketsHeaderSize) {
+		return false;
+	}
+	std::array<std::uint64_t, 4> head{};
+	std::memcpy(head.data(), payload.data(), sizeof(head));
+	const std::uint64_t rows = head[0];
+	const std::uint64_t pool = head[1];
+	if (head[2] > pool || rows > payload.size() || pool > payload.size()) {
+		return false;
+	}
+	std::size_t need = kMarketsHeaderSize + padded(static_cast<std::size_t>(pool));
+	for (const std::size_t width : kMarketWidths) {
+		need += padded(width * static_cast<std::size_t>(rows));
+	}
+	if (need > payload.size()) {
+		return false;
+	}
+	const char* column = payload.data() + kMarketsHeaderSize;
+	for (std::size_t i = 0; i < kMarketWidths.size(); ++i) {
+		const std::size_t bytes = kMarketWidths[i] * static_cast<std::size_t>(rows);
+		if (i == kFirstTextColumn - 1) {
+			for (std::size_t row = 0; row < rows; ++row) {
+				if (static_cast<std::uint8_t>(column[row]) >
+					static_cast<std::uint8_t>(MarketStatus::Paused)) {
+					return false;
+				}
+			}
+		}
+		if (i >= kFirstTextColumn) {
+			for (std::size_t row = 0; row < rows; ++row) {
+				std::array<std::uint32_t, 2> text{};
+				std::memcpy(text.data(), column + row * sizeof(text), sizeof(text));
+				if (std::uint64_t{text[0]} + text[1] > pool) {
+					return false;
+				}
+			}
+		}
+		column += padded(bytes);
+	}
+	return true;
+}
+
+std::size_t WarmState::Impl::restore_markets(MarketTable& table, TickerTable* tickers) const {
+	if (markets.empty()) {
+		return 0;
+	}
+	std::array<std::uint64_t, 4> head{};
+	std::memcpy(head.data(), markets.data(), sizeof(head));
+	const auto rows = static_cast<std::size_t>(head[0]);
+	const auto pool = static_cast<std::size_t>(head[1]);
+
+	const char* column = markets.data() + kMarketsHeaderSize;
+	const auto next = [&]<typename T>(std::vector<T>& out) {
+		out.resize(rows);
+		std::memcpy(out.data(), column, rows * sizeof(T));
+		column += padded(rows * sizeof(T));
+	};
+	table = MarketTable{};
+	next(table.open_times_);
+	next(table.close_times_);
+	next(table.yes_bids_);
+	next(table.yes_asks_);
+	next(table.no_bids_);
+	next(table.no_asks_);
+	next(table.volumes_);
+	next(table.open_interests_);
+	next(table.last_prices_);
+	next(table.statuses_);
+	next(table.tickers_);
+	next(table.titles_);
+	next(table.subtitles_);
+	next(table.results_);
+	table.pool_.assign(column, pool);
+	table.dead_bytes_ = static_cast<std::size_t>(head[2]);
+
+	table.ticker_ids_.assign(rows, TickerId{});
+	table.index_.reserve(rows);
+	for (std::size_t i = 0; i < rows; ++i) {
+		const std::uint32_t row = static_cast<std::uint32_t>(i);
+		const std::string_view ticker = table.ticker(row);
+		table.index_.emplace(ticker, row);
+		if (tickers != nullptr) {
+			const TickerId id = tickers->intern(ticker);
+			table.ticker_ids_[i] = id;
+			table.index_id(id, row);
+		}
+	}
+	return rows;
+}
+
+// ===== WarmState =====
+
+WarmState::WarmState(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+WarmState::~WarmState() = default;
+WarmState::WarmState(WarmState&&) noexcept = default;
+WarmState& WarmState::operator=(WarmState&&) noexcept = default;
+
+Result<void> WarmState::save(const std::string& path, const WarmStateSources& sources) {
+	std::vector<std::pair<SectionKind, std::string>> sections;
+	if (sources.markets != nullptr) {
+		sections.emplace_back(SectionKind::Markets, Impl::encode_markets(*sources.markets));
+	}
+	if (sources.metadata != nullptr) {
+		sections.emplace_back(SectionKind::Metadata, encode_metadata(*sources.metadata));
+	}
+	if (sources.portfolio != nullptr) {
+		sections.emplace_back(SectionKind::Portfolio,
+							  encode_portfolio(sources.portfolio->snapshot()));
+	}
+	if (!sources.books.empty()) {
+		sections.emplace_back(SectionKind::Books, encode_books(sources.books));
+	}
+
+	char head[kHeaderSize]{};
+	const std::uint16_t version = kVersion;
+	const std::uint16_t flags = sources.user_data_timestamp ? kFlagUserData : 0;
+	const std::uint32_t count = static_cast<std::uint32_t>(sections.size());
+	const std::int64_t saved_at = unix_ms(std::chrono::system_clock::now());
+	const std::int64_t user_data = sources.user_data_timestamp.value_or(0);
+	std::memcpy(head, kMagic.data(), kMagic.size());
+	std::memcpy(head + 8, &version, sizeof(version));
+	std::memcpy(head + 10, &flags, sizeof(flags));
+	std::memcpy(head + 12, &count, sizeof(count));
+	std::memcpy(head + 16, &saved_at, sizeof(saved_at));
+	std::memcpy(head + 24, &user_data, sizeof(user_data));
+
+	std::vector<std::array<std::uint64_t, 2>> section_heads;
+	section_heads.reserve(sections.size());
+	std::vector<std::span<const std::byte>> chunks;
+	chunks.push_back(std::as_bytes(std::span<const char>(head)));
+	for (const auto& [kind, payload] : sections) {
+		section_heads.push_back({static_cast<std::uint64_t>(kind), payload.size()});
+		chunks.push_back(std::as_bytes(std::span<const std::uint64_t>(section_heads.back())));
+		chunks.push_back(std::as_bytes(std::span<const char>(payload)));
+	}
+	if (!api_detail::write_file_atomically(path, chunks)) {
+		return std::unexpected(file_error("Failed to write warm state", path));
+	}
+	return {};
+}
+
+Result<WarmState> WarmState::open(const std::string& path) {
+	std::error_code ec;
+	if (!std::filesystem::exists(path, ec)) {
+		return std::unexpected(file_error("No warm state file", path));
+	}
+	std::shared_ptr<const Mapping> mapping = api_detail::map_file(path);
+	if (!mapping || mapping->size < kHeaderSize ||
+		std::memcmp(mapping->data, kMagic.data(), kMagic.size()) != 0) {
+		return std::unexpected(Error::parse("Not a warm state file: " + path));
+	}
+	const char* data = mapping->data;
+	std::uint16_t version = 0;
+	std::uint16_t flags = 0;
+	std::uint32_t count = 0;
+	std::unique_ptr<Impl> impl = std::make_unique<Impl>();
+	std::memcpy(&version, data + 8, sizeof(version));
+	std::memcpy(&flags, data + 10, sizeof(flags));
+	std::memcpy(&count, data + 12, sizeof(count));
+	std::memcpy(&impl->saved_at_ms, data + 16, sizeof(impl->saved_at_ms));
+	if (version != kVersion) {
+		return std::unexpected(Error::parse("Unsupported warm state version: " + path));
+	}
+	if ((flags & kFlagUserData) != 0) {
+		std::int64_t user_data = 0;
+		std::memcpy(&user_data, data + 24, sizeof(user_data));
+		impl->user_data_timestamp = user_data;
+	}
+
+	std::size_t offset = kHeaderSize;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		std::array<std::uint64_t, 2> section{};
+		if (mapping->size - offset < kSectionHeaderSize) {
+			return std::unexpected(Error::parse("Truncated warm state file: " + path));
+		}
+		std::memcpy(section.data(), data + offset, sizeof(section));
+		offset += kSectionHeaderSize;
+		const std::uint64_t size = section[1];
+		if (size > mapping->size - offset) {
+			return std::unexpected(Error::parse("Truncated warm state file: " + path));
+		}
+		const std::string_view payload{data + offset, static_cast<std::size_t>(size)};
+		offset += std::min(padded(static_cast<std::size_t>(size)), mapping->size - offset);
+		switch (static_cast<SectionKind>(section[0])) {
+		case SectionKind::Markets:
+			if (!Impl::valid_markets(payload)) {
+				return std::unexpected(Error::parse("Corrupt warm state markets: " + path));
+			}
+			impl->markets = payload;
+			break;
+		case SectionKind::Metadata:
+			impl->metadata = payload;
+			break;
+		case SectionKind::Portfolio:
+			impl->portfolio = payload;
+			break;
+		case SectionKind::Books:
+			impl->books = payload;
+			break;
+		}
+	}
+	impl->mapping = std::move(mapping);
+	return WarmState(std::move(impl));
+}
+
+std::chrono::system_clock::time_point WarmState::saved_at() const noexcept {
+	return std::chrono::system_clock::time_point{std::chrono::milliseconds{impl_->saved_at_ms}};
+}
+
+std::optional<std::int64_t> WarmState::user_data_timestamp() const noexcept {
+	return impl_->user_data_timestamp;
+}
+
+std::size_t WarmState::restore(MarketTable& table, TickerTable* tickers) const {
+	return impl_->restore_markets(table, tickers);
+}
+
+std::size_t WarmState::restore(MetadataCache& cache) const {
+	if (impl_->metadata.empty()) {
+		return 0;
+	}
+	const std::int64_t elapsed =
+		std::max<std::int64_t>(0, unix_ms(std::chrono::system_clock::now()) - impl_->saved_at_ms);
+	ByteReader r(impl_->metadata);
+	std::size_t restored = restore_entries<Market>(r, cache, elapsed);
+	restored += restore_entries<Event>(r, cache, elapsed);
+	restored += restore_entries<EventMetadata>(r, cache, elapsed);
+	restored += restore_entries<Series>(r, cache, elapsed);
+	return restored;
+}
+
+std::optional<PortfolioSnapshot> WarmState::portfolio() const {
+	if (impl_->portfolio.empty()) {
+		return std::nullopt;
+	}
+	ByteReader r(impl_->portfolio);
+	PortfolioSnapshot snapshot;
+	r.pod(snapshot.balance.balance);
+	r.pod(snapshot.balance.available_balance);
+	std::uint32_t n = 0;
+	if (r.count(n, sizeof(std::uint32_t))) {
+		snapshot.positions.resize(n);
+		for (Position& p : snapshot.positions) {
+			r.text(p.market_ticker);
+			r.pod(p.yes_contracts);
+			r.pod(p.no_contracts);
+			r.pod(p.total_cost_cents);
+		}
+	}
+	if (r.count(n, 2 * sizeof(std::uint32_t))) {
+		snapshot.orders.resize(n);
+		for (Order& o : snapshot.orders) {
+			r.text(o.order_id);
+			r.text(o.market_ticker);
+			r.pod(o.side);
+			r.pod(o.action);
+			r.pod(o.status);
+			r.pod(o.remaining_count);
+			r.pod(o.filled_count);
+		}
+	}
+	if (!r.ok()) {
+		return std::nullopt;
+	}
+	return snapshot;
+}
+
+std::vector<OrderbookSnapshot> WarmState::books() const {
+	std::vector<OrderbookSnapshot> out;
+	if (impl_->books.empty()) {
+		return out;
+	}
+	ByteReader r(impl_->books);
+	std::uint32_t n = 0;
+	if (!r.count(n, sizeof(std::uint32_t))) {
+		return out;
+	}
+	out.reserve(n);
+	for (std::uint32_t i = 0; i < n; ++i) {
+		OrderbookSnapshot snapshot;
+		if (!r.text(snapshot.market_ticker) || !r.pod(snapshot.seq) ||
+			!read_levels(r, snapshot.yes) || !read_levels(r, snapshot.no)) {
+			break;
+		}
+		out.push_back(std::move(snapshot));
+	}
+	return out;
+}
+
+Result<bool> WarmState::portfolio_current(KalshiClient& client) const {
+	if (impl_->portfolio.empty() || !impl_->user_data_timestamp) {
+		return false;
+	}
+	Result<UserDataTimestamp> now = client.get_user_data_timestamp();
+	if (!now) {
+		return std::unexpected(now.error());
+	}
+	return now->timestamp <= *impl_->user_data_timestamp;
+}
+
+Result<std::size_t> WarmState::refresh_markets(KalshiClient& client, MarketTable* table,
+											   MetadataCache* cache,
+											   std::chrono::seconds slack) const {
+	GetMarketsParams params;
+	params.min_updated_ts =
+		std::chrono::duration_cast<std::chrono::seconds>(saved_at().time_since_epoch() - slack)
+			.count();
+	return client.for_each_market(params, [table, cache](const Market& market) {
+		if (table != nullptr) {
+			table->upsert(market);
+		}
+		if (cache != nullptr) {
+			cache->put(market);
+		}
+		return true;
+	});
+}
+
+} // namespace kalshi
@@ -1,9 +1,13 @@
 #include "kalshi/signer.hpp"
 
+#include <algorithm>
 #include <array>
+#include <charconv>
 #include <chrono>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <mutex>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/pem.h>
@@ -16,8 +20,16 @@ namespace kalshi {
 struct Signer::Impl {
 	std::string api_key_id;
 	EVP_PKEY* pkey{nullptr};
+	// Digest, PSS padding and salt length are set here once. It is never
+	// signed with directly: each signature copies it into the calling
+	// thread's scratch context, so it stays read-only after from_pem.
+	EVP_MD_CTX* prototype{nullptr};
+	std::size_t signature_size{0};
 
 	~Impl() {
+		if (prototype) {
+			EVP_MD_CTX_free(prototype);
+		}
 		if (pkey) {
 			EVP_PKEY_free(pkey);
 		}
@@ -44,24 +56,62 @@ std::string get_openssl_error() {
 	return buf;
 }
 
-std::string base64_encode(const unsigned char* data, size_t len) {
-	BIO* bio = BIO_new(BIO_s_mem());
-	BIO* b64 = BIO_new(BIO_f_base64());
-	BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-	BIO_push(b64, bio);
-	BIO_write(b64, data, static_cast<int>(len));
-	BIO_flush(b64);
+constexpr std::array<char, 64> BASE64_ALPHABET = {
+	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+	'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+	'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+	'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'};
+
+// Per-thread signing state, reused across calls and signers.
+struct SigningScratch {
+	EVP_MD_CTX* ctx{EVP_MD_CTX_new()};
+	std::vector<unsigned char> signature;
 
-	BUF_MEM* bptr;
-	BIO_get_mem_ptr(b64, &bptr);
+	SigningScratch() = default;
+	SigningScratch(const SigningScratch&) = delete;
+	SigningScratch& operator=(const SigningScratch&) = delete;
 
-	std::string result(bptr->data, bptr->length);
-	BIO_free_all(b64);
-	return result;
+	~SigningScratch() { EVP_MD_CTX_free(ctx); }
+};
+
+SigningScratch& signing_scratch() {
+	thread_local SigningScratch scratch;
+	return scratch;
 }
 
 } // namespace
 
+std::size_t base64_encode(std::span<const unsigned char> data, std::span<char> out) noexcept {
+	const std::size_t needed = base64_encoded_size(data.size());
+	if (out.size() < needed) {
+		return 0;
+	}
+
+	std::size_t in = 0;
+	std::size_t pos = 0;
+	for (; in + 3 <= data.size(); in += 3) {
+		const std::uint32_t triple = (std::uint32_t{data[in]} << 16) |
+									 (std::uint32_t{data[in + 1]} << 8) | data[in + 2];
+		out[pos++] = BASE64_ALPHABET[(triple >> 18) & 0x3F];
+		out[pos++] = BASE64_ALPHABET[(triple >> 12) & 0x3F];
+		out[pos++] = BASE64_ALPHABET[(triple >> 6) & 0x3F];
+		out[pos++] = BASE64_ALPHABET[triple & 0x3F];
+	}
+
+	const std::size_t rest = data.size() - in;
+	if (rest > 0) {
+		std::uint32_t triple = std::uint32_t{data[in]} << 16;
+		if (rest == 2) {
+			triple |= std::uint32_t{data[in + 1]} << 8;
+		}
+		out[pos++] = BASE64_ALPHABET[(triple >> 18) & 0x3F];
+		out[pos++] = BASE64_ALPHABET[(triple >> 12) & 0x3F];
+		out[pos++] = rest == 2 ? BASE64_ALPHABET[(triple >> 6) & 0x3F] : '=';
+		out[pos++] = '=';
+	}
+	return pos;
+}
+
 Result<Signer> Signer::from_pem(std::string_view api_key_id, std::string_view pem_key) {
 	std::unique_ptr<Impl> impl = std::make_unique<Impl>();
 	impl->api_key_id = std::string(api_key_id);
@@ -79,6 +129,28 @@ Result<Signer> Signer::from_pem(std::string_view api_key_id, std::string_view pe
 			Error::signing("Failed to read private key: " + get_openssl_error()));
 	}
 
+	// Initialize the prototype for RSA-PSS with SHA-256
+	impl->prototype = EVP_MD_CTX_new();
+	if (!impl->prototype) {
+		return std::unexpected(Error::signing("Failed to create signing context"));
+	}
+
+	EVP_PKEY_CTX* pkey_ctx = nullptr;
+	if (EVP_DigestSignInit(impl->prototype, &pkey_ctx, EVP_sha256(), nullptr, impl->pkey) != 1) {
+		return std::unexpected(Error::signing("Failed to init signing: " + get_openssl_error()));
+	}
+
+	// Set RSA-PSS padding with salt length = digest length (32 bytes for SHA-256)
+	if (EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) != 1) {
+		return std::unexpected(Error::signing("Failed to set padding: " + get_openssl_error()));
+	}
+
+	if (EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, RSA_PSS_SALTLEN_DIGEST) != 1) {
+		return std::unexpected(Error::signing("Failed to set salt length: " + get_openssl_error()));
+	}
+
+	impl->signature_size = static_cast<std::size_t>(EVP_PKEY_get_size(impl->pkey));
+
 	return Signer(std::move(impl));
 }
 
@@ -93,69 +165,179 @@ Result<Signer> Signer::from_pem_file(std::string_view api_key_id, std::string_vi
 	return from_pem(api_key_id, buffer.str());
 }
 
-Result<AuthHeaders> Signer::sign(std::string_view method, std::string_view path) const {
+namespace {
+
+std::int64_t now_ms() {
 	std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-	std::int64_t ms =
-		std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-	return sign_with_timestamp(method, path, ms);
+	return std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+}
+
+} // namespace
+
+Result<AuthHeaders> Signer::sign(std::string_view method, std::string_view path) const {
+	return sign_with_timestamp(method, path, now_ms());
+}
+
+Result<void> Signer::sign_into(std::string_view method, std::string_view path,
+							   AuthHeaders& out) const {
+	return sign_into(method, path, now_ms(), out);
 }
 
 Result<AuthHeaders> Signer::sign_with_timestamp(std::string_view method, std::string_view path,
 												std::int64_t timestamp_ms) const {
-	// Build message: timestamp + method + path
-	std::string timestamp_str = std::to_string(timestamp_ms);
-	std::string message = timestamp_str + std::string(method) + std::string(path);
+	AuthHeaders headers;
+	Result<void> signed_result = sign_into(method, path, timestamp_ms, headers);
+	if (!signed_result) {
+		return std::unexpected(signed_result.error());
+	}
+	return headers;
+}
 
-	// Create signing context
-	EVP_MD_CTX* ctx = EVP_MD_CTX_new();
-	if (!ctx) {
+Result<void> Signer::sign_into(std::string_view method, std::string_view path,
+							   std::int64_t timestamp_ms, AuthHeaders& out) const {
+	SigningScratch& scratch = signing_scratch();
+	if (!scratch.ctx) {
 		return std::unexpected(Error::signing("Failed to create signing context"));
 	}
 
-	// Initialize for RSA-PSS with SHA-256
-	EVP_PKEY_CTX* pkey_ctx = nullptr;
-	if (EVP_DigestSignInit(ctx, &pkey_ctx, EVP_sha256(), nullptr, impl_->pkey) != 1) {
-		EVP_MD_CTX_free(ctx);
+	// Copying resets the scratch context and restores the initialized
+	// prototype, which is far cheaper than a fresh EVP_DigestSignInit.
+	if (EVP_MD_CTX_copy_ex(scratch.ctx, impl_->prototype) != 1) {
 		return std::unexpected(Error::signing("Failed to init signing: " + get_openssl_error()));
 	}
+	// The copy is signed once and discarded, so let the final step consume
+	// it instead of duplicating it first.
+	EVP_MD_CTX_set_flags(scratch.ctx, EVP_MD_CTX_FLAG_FINALISE);
+
+	// Message is timestamp + method + path, fed in pieces rather than
+	// concatenated.
+	std::array<char, 24> timestamp_buf{};
+	const std::to_chars_result ts =
+		std::to_chars(timestamp_buf.data(), timestamp_buf.data() + timestamp_buf.size(),
+					  timestamp_ms);
+	const std::string_view timestamp_str(timestamp_buf.data(),
+										 static_cast<std::size_t>(ts.ptr - timestamp_buf.data()));
+
+	if (EVP_DigestSignUpdate(scratch.ctx, timestamp_str.data(), timestamp_str.size()) != 1 ||
+		EVP_DigestSignUpdate(scratch.ctx, method.data(), method.size()) != 1 ||
+		EVP_DigestSignUpdate(scratch.ctx, path.data(), path.size()) != 1) {
+		return std::unexpected(Error::signing("Failed to update digest: " + get_openssl_error()));
+	}
 
-	// Set RSA-PSS padding with salt length = digest length (32 bytes for SHA-256)
-	if (EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) != 1) {
-		EVP_MD_CTX_free(ctx);
-		return std::unexpected(Error::signing("Failed to set padding: " + get_openssl_error()));
+	// Sign
+	scratch.signature.resize(impl_->signature_size);
+	size_t sig_len = scratch.signature.size();
+	if (EVP_DigestSignFinal(scratch.ctx, scratch.signature.data(), &sig_len) != 1) {
+		return std::unexpected(Error::signing("Failed to sign: " + get_openssl_error()));
 	}
 
-	if (EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, RSA_PSS_SALTLEN_DIGEST) != 1) {
-		EVP_MD_CTX_free(ctx);
-		return std::unexpected(Error::signing("Failed to set salt length: " + get_openssl_error()));
+	out.access_key.assign(impl_->api_key_id);
+	out.timestamp.assign(timestamp_str);
+	out.signature.resize(base64_encoded_size(sig_len));
+	out.signature.resize(base64_encode(std::span(scratch.signature.data(), sig_len),
+									   std::span(out.signature.data(), out.signature.size())));
+	return {};
+}
+
+struct PresignedHeaderPool::Impl {
+	struct Entry {
+		AuthHeaders headers;
+		std::chrono::steady_clock::time_point signed_at;
+	};
+
+	const Signer* signer;
+	std::string method;
+	std::string path;
+	std::size_t capacity;
+	std::chrono::milliseconds max_age;
+
+	mutable std::mutex mutex;
+	std::deque<Entry> entries; // oldest first
+
+	// Caller holds `mutex`.
+	void drop_stale(std::chrono::steady_clock::time_point now) {
+		while (!entries.empty() && now - entries.front().signed_at >= max_age) {
+			entries.pop_front();
+		}
 	}
+};
 
-	// Update with message
-	if (EVP_DigestSignUpdate(ctx, message.data(), message.size()) != 1) {
-		EVP_MD_CTX_free(ctx);
-		return std::unexpected(Error::signing("Failed to update digest: " + get_openssl_error()));
+PresignedHeaderPool::PresignedHeaderPool(const Signer& signer, std::string method,
+										 std::string path, std::size_t capacity,
+										 std::chrono::milliseconds max_age)
+	: impl_(std::make_unique<Impl>()) {
+	impl_->signer = &signer;
+	impl_->method = std::move(method);
+	impl_->path = std::move(path);
+	impl_->capacity = capacity;
+	impl_->max_age = max_age;
+}
+
+PresignedHeaderPool::~PresignedHeaderPool() = default;
+
+PresignedHeaderPool::PresignedHeaderPool(PresignedHeaderPool&&) noexcept = default;
+
+PresignedHeaderPool& PresignedHeaderPool::operator=(PresignedHeaderPool&&) noexcept = default;
+
+Result<void> PresignedHeaderPool::refill() {
+	if (!impl_) {
+		return std::unexpected(Error::signing("PresignedHeaderPool has been moved from"));
 	}
 
-	// Get signature length
-	size_t sig_len = 0;
-	if (EVP_DigestSignFinal(ctx, nullptr, &sig_len) != 1) {
-		EVP_MD_CTX_free(ctx);
-		return std::unexpected(
-			Error::signing("Failed to get signature length: " + get_openssl_error()));
+	std::size_t missing = 0;
+	{
+		std::lock_guard<std::mutex> lock(impl_->mutex);
+		impl_->drop_stale(std::chrono::steady_clock::now());
+		missing = impl_->capacity - std::min(impl_->capacity, impl_->entries.size());
 	}
 
-	// Sign
-	std::vector<unsigned char> signature(sig_len);
-	if (EVP_DigestSignFinal(ctx, signature.data(), &sig_len) != 1) {
-		EVP_MD_CTX_free(ctx);
-		return std::unexpected(Error::signing("Failed to sign: " + get_openssl_error()));
+	// Sign outside the lock so a concurrent take() never waits on RSA.
+	for (std::size_t i = 0; i < missing; ++i) {
+		Result<AuthHeaders> headers = impl_->signer->sign(impl_->method, impl_->path);
+		if (!headers) {
+			return std::unexpected(headers.error());
+		}
+		std::lock_guard<std::mutex> lock(impl_->mutex);
+		if (impl_->entries.size() >= impl_->capacity) {
+			break;
+		}
+		impl_->entries.push_back(Impl::Entry{.headers = std::move(*headers),
+											 .signed_at = std::chrono::steady_clock::now()});
 	}
+	return {};
+}
 
-	EVP_MD_CTX_free(ctx);
+Result<AuthHeaders> PresignedHeaderPool::take() {
+	if (!impl_) {
+		return std::unexpected(Error::signing("PresignedHeaderPool has been moved from"));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(impl_->mutex);
+		impl_->drop_stale(std::chrono::steady_clock::now());
+		if (!impl_->entries.empty()) {
+			AuthHeaders headers = std::move(impl_->entries.back().headers);
+			impl_->entries.pop_back();
+			return headers;
+		}
+	}
+	return impl_->signer->sign(impl_->method, impl_->path);
+}
+
+std::size_t PresignedHeaderPool::size() const {
+	if (!impl_) {
+		return 0;
+	}
+	std::lock_guard<std::mutex> lock(impl_->mutex);
+	return impl_->entries.size();
+}
+
+std::string_view PresignedHeaderPool::method() const noexcept {
+	return impl_ ? std::string_view(impl_->method) : std::string_view{};
+}
 
-	return AuthHeaders{.access_key = impl_->api_key_id,
-					   .signature = base64_encode(signature.data(), sig_len),
-					   .timestamp = timestamp_str};
+std::string_view PresignedHeaderPool::path() const noexcept {
+	return impl_ ? std::string_view(impl_->path) : std::string_view{};
 }
 
 } // namespace kalshi
@@ -0,0 +1,409 @@
+#include "kalshi/latency_stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace kalshi {
+
+namespace {
+
+struct StringHash {
+	using is_transparent = void;
+	std::size_t operator()(std::string_view s) const noexcept {
+		return std::hash<std::string_view>{}(s);
+	}
+};
+
+/// Tickers, order ids and other per-call values; see ``latency_endpoint``
+bool is_id_segment(std::string_view segment) noexcept {
+	return std::any_of(segment.begin(), segment.end(), [](char c) {
+		return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z');
+	});
+}
+
+void append_endpoint(std::string& out, std::string_view method, std::string_view path) {
+	out.append(method).push_back(' ');
+	path = path.substr(0, path.find('?'));
+	while (!path.empty()) {
+		const std::size_t end = path.find('/', 1);
+		const std::string_view segment = path.substr(0, end);
+		if (segment.size() > 1 && is_id_segment(segment.substr(1))) {
+			out.append("/{id}");
+		} else {
+			out.append(segment);
+		}
+		path.remove_prefix(end == std::string_view::npos ? path.size() : end);
+	}
+}
+
+/// Values written by one thread and read by ``snapshot``: the owner does
+/// plain load + store (no read-modify-write), readers see each word whole.
+void bump(std::atomic<std::uint64_t>& word, std::uint64_t n) noexcept {
+	word.store(word.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct AtomicHistogram {
+	std::array<std::atomic<std::uint64_t>, LatencyHistogram::kBucketCount> buckets{};
+	std::atomic<std::uint64_t> count{0};
+	std::atomic<std::uint64_t> sum{0};
+	std::atomic<std::uint64_t> min{~std::uint64_t{0}};
+	std::atomic<std::uint64_t> max{0};
+
+	void record(std::uint64_t ns) noexcept {
+		bump(buckets[LatencyHistogram::bucket_index(ns)], 1);
+		bump(count, 1);
+		bump(sum, ns);
+		if (ns < min.load(std::memory_order_relaxed)) {
+			min.store(ns, std::memory_order_relaxed);
+		}
+		if (ns > max.load(std::memory_order_relaxed)) {
+			max.store(ns, std::memory_order_relaxed);
+		}
+	}
+};
+
+std::atomic<std::uint64_t> next_stats_id{1};
+
+void append_label_value(std::string& out, std::string_view value) {
+	for (const char c : value) {
+		switch (c) {
+			case '\\':
+				out.append("\\\\");
+				break;
+			case '"':
+				out.append("\\\"");
+				break;
+			case '\n':
+				out.append("\\n");
+				break;
+			default:
+				out.push_back(c);
+		}
+	}
+}
+
+void append_labels(std::string& out, const LatencySeries& series) {
+	out.append("source=\"");
+	out.append(series.source == LatencySource::Rest ? "rest" : "ws");
+	out.append("\",name=\"");
+	append_label_value(out, series.name);
+	out.push_back('"');
+}
+
+void append_number(std::string& out, double value) {
+	char buf[32];
+	const int n = std::snprintf(buf, sizeof(buf), "%.9g", value);
+	out.append(buf, static_cast<std::size_t>(n));
+}
+
+void append_number(std::string& out, std::uint64_t value) {
+	out.append(std::to_string(value));
+}
+
+} // namespace
+
+std::string_view to_string(LatencyStage stage) noexcept {
+	switch (stage) {
+		case LatencyStage::Sign:
+			return "sign";
+		case LatencyStage::FirstByte:
+			return "first_byte";
+		case LatencyStage::Total:
+			return "total";
+		case LatencyStage::Parse:
+			return "parse";
+		case LatencyStage::Callback:
+			return "callback";
+	}
+	return "unknown";
+}
+
+std::string_view to_string(LatencyCounter counter) noexcept {
+	switch (counter) {
+		case LatencyCounter::Requests:
+			return "requests";
+		case LatencyCounter::Errors:
+			return "errors";
+		case LatencyCounter::BytesOut:
+			return "bytes_out";
+		case LatencyCounter::BytesIn:
+			return "bytes_in";
+		case LatencyCounter::Retries:
+			return "retries";
+		case LatencyCounter::RateLimited:
+			return "rate_limited";
+		case LatencyCounter::Messages:
+			return "messages";
+	}
+	return "unknown";
+}
+
+// ===== LatencyHistogram =====
+
+void LatencyHistogram::record(std::uint64_t ns) noexcept {
+	++buckets_[bucket_index(ns)];
+	++count_;
+	sum_ += ns;
+	min_ = std::min(min_, ns);
+	max_ = std::max(max_, ns);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+	for (std::size_t i = 0; i < kBucketCount; ++i) {
+		buckets_[i] += other.buckets_[i];
+	}
+	count_ += other.count_;
+	sum_ += other.sum_;
+	min_ = std::min(min_, other.min_);
+	max_ = std::max(max_, other.max_);
+}
+
+std::uint64_t LatencyHistogram::percentile(double q) const noexcept {
+	if (count_ == 0) {
+		return 0;
+	}
+	const double clamped = std::clamp(q, 0.0, 1.0);
+	const std::uint64_t rank = std::max<std::uint64_t>(
+		1, static_cast<std::uint64_t>(std::ceil(clamped * static_cast<double>(count_))));
+	std::uint64_t seen = 0;
+	for (std::size_t i = 0; i < kBucketCount; ++i) {
+		seen += buckets_[i];
+		if (seen >= rank) {
+			const std::uint64_t top =
+				i + 1 < kBucketCount ? bucket_lower(i + 1) - 1 : max_;
+			return std::clamp(top, min_, max_);
+		}
+	}
+	return max_;
+}
+
+// ===== LatencySnapshot =====
+
+const LatencySeries* LatencySnapshot::find(LatencySource source,
+										   std::string_view name) const noexcept {
+	for (const LatencySeries& s : series) {
+		if (s.source == source && s.name == name) {
+			return &s;
+		}
+	}
+	return nullptr;
+}
+
+std::string latency_endpoint(std::string_view method, std::string_view path) {
+	std::string out;
+	append_endpoint(out, method, path);
+	return out;
+}
+
+// ===== LatencyStats =====
+
+struct LatencyStats::Cell {
+	LatencySource source{LatencySource::Rest};
+	std::string name;
+	std::array<AtomicHistogram, kLatencyStageCount> stages;
+	std::array<std::atomic<std::uint64_t>, kLatencyCounterCount> counters{};
+};
+
+/// One thread's cells. Only the owning thread inserts (under `mutex`) or
+/// records; `snapshot` reads under `mutex`.
+struct LatencyStats::Shard {
+	std::mutex mutex;
+	/// Keyed by the source's tag byte followed by the name
+	std::unordered_map<std::string, std::unique_ptr<Cell>, StringHash, std::equal_to<>> cells;
+};
+
+struct LatencyStats::Impl {
+	/// Distinguishes this instance in the per-thread shard caches, which
+	/// may outlive it (addresses can be reused, ids are not).
+	const std::uint64_t id{next_stats_id.fetch_add(1, std::memory_order_relaxed)};
+	mutable std::mutex mutex;
+	std::vector<std::shared_ptr<Shard>> shards;
+};
+
+namespace {
+
+/// This thread's shard of each ``LatencyStats`` it has recorded into.
+/// Holding a ``shared_ptr`` keeps a shard valid if its stats object dies
+/// first; such entries are pruned as the cache grows.
+struct ShardCacheEntry {
+	std::uint64_t id;
+	std::shared_ptr<void> shard;
+};
+thread_local std::vector<ShardCacheEntry> shard_cache;
+
+} // namespace
+
+void LatencyStats::Recorder::record(LatencyStage stage, std::uint64_t ns) noexcept {
+	if (cell_ != nullptr) {
+		cell_->stages[static_cast<std::size_t>(stage)].record(ns);
+	}
+}
+
+void LatencyStats::Recorder::add(LatencyCounter counter, std::uint64_t n) noexcept {
+	if (cell_ != nullptr) {
+		bump(cell_->counters[static_cast<std::size_t>(counter)], n);
+	}
+}
+
+LatencyStats::LatencyStats() : impl_(std::make_unique<Impl>()) {}
+
+LatencyStats::~LatencyStats() = default;
+
+LatencyStats::Recorder LatencyStats::rest(std::string_view method, std::string_view path) {
+	thread_local std::string name;
+	name.clear();
+	append_endpoint(name, method, path);
+	return lookup(LatencySource::Rest, name);
+}
+
+LatencyStats::Recorder LatencyStats::ws(std::string_view message_type) {
+	return lookup(LatencySource::WebSocket, message_type);
+}
+
+LatencyStats::Recorder LatencyStats::lookup(LatencySource source, std::string_view name) {
+	Shard* shard = nullptr;
+	for (const ShardCacheEntry& entry : shard_cache) {
+		if (entry.id == impl_->id) {
+			shard = static_cast<Shard*>(entry.shard.get());
+			break;
+		}
+	}
+	if (shard == nullptr) {
+		if (shard_cache.size() >= 8) {
+			std::erase_if(shard_cache, [](const ShardCacheEntry& entry) {
+				return entry.shard.use_count() == 1;
+			});
+		}
+		std::shared_ptr<Shard> fresh = std::make_shared<Shard>();
+		shard = fresh.get();
+		{
+			std::lock_guard lock(impl_->mutex);
+			impl_->shards.push_back(fresh);
+		}
+		shard_cache.push_back({impl_->id, std::move(fresh)});
+	}
+
+	thread_local std::string key;
+	key.assign(1, static_cast<char>('0' + static_cast<int>(source))).append(name);
+	// Only this thread inserts into the shard, so the unlocked find is safe.
+	if (const auto it = shard->cells.find(std::string_view(key)); it != shard->cells.end()) {
+		return Recorder(it->second.get());
+	}
+	std::unique_ptr<Cell> cell = std::make_unique<Cell>();
+	cell->source = source;
+	cell->name = std::string(name);
+	Cell* raw = cell.get();
+	std::lock_guard lock(shard->mutex);
+	shard->cells.emplace(key, std::move(cell));
+	return Recorder(raw);
+}
+
+LatencySnapshot LatencyStats::snapshot() const {
+	std::map<std::pair<LatencySource, std::string>, LatencySeries> merged;
+	std::vector<std::shared_ptr<Shard>> shards;
+	{
+		std::lock_guard lock(impl_->mutex);
+		shards = impl_->shards;
+	}
+	for (const std::shared_ptr<Shard>& shard : shards) {
+		std::lock_guard lock(shard->mutex);
+		for (const auto& [key, cell] : shard->cells) {
+			LatencySeries& out = merged[{cell->source, cell->name}];
+			out.source = cell->source;
+			out.name = cell->name;
+			for (std::size_t s = 0; s < kLatencyStageCount; ++s) {
+				const AtomicHistogram& in = cell->stages[s];
+				LatencyHistogram& hist = out.stages[s];
+				// Sum the buckets rather than trusting `count`, which the
+				// owner may have bumped after the buckets were read.
+				std::uint64_t count = 0;
+				for (std::size_t i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+					const std::uint64_t n = in.buckets[i].load(std::memory_order_relaxed);
+					hist.buckets_[i] += n;
+					count += n;
+				}
+				if (count == 0) {
+					continue;
+				}
+				hist.count_ += count;
+				hist.sum_ += in.sum.load(std::memory_order_relaxed);
+				hist.min_ = std::min(hist.min_, in.min.load(std::memory_order_relaxed));
+				hist.max_ = std::max(hist.max_, in.max.load(std::memory_order_relaxed));
+			}
+			for (std::size_t c = 0; c < kLatencyCounterCount; ++c) {
+				out.counters[c] += cell->counters[c].load(std::memory_order_relaxed);
+			}
+		}
+	}
+	LatencySnapshot snapshot;
+	snapshot.series.reserve(merged.size());
+	for (auto& [key, series] : merged) {
+		snapshot.series.push_back(std::move(series));
+	}
+	return snapshot;
+}
+
+// ===== Prometheus =====
+
+std::string to_prometheus(const LatencySnapshot& snapshot, std::string_view prefix) {
+	static constexpr std::array<double, 4> kQuantiles{0.5, 0.9, 0.99, 0.999};
+	std::string out;
+	const std::string latency = std::string(prefix) + "_latency_seconds";
+	out.append("# HELP ").append(latency).append(
+		" Latency by source, endpoint or message type, and stage.\n");
+	out.append("# TYPE ").append(latency).append(" summary\n");
+	for (const LatencySeries& series : snapshot.series) {
+		for (std::size_t s = 0; s < kLatencyStageCount; ++s) {
+			const LatencyHistogram& hist = series.stages[s];
+			if (hist.count() == 0) {
+				continue;
+			}
+			const std::string_view stage = to_string(static_cast<LatencyStage>(s));
+			for (const double q : kQuantiles) {
+				out.append(latency).push_back('{');
+				append_labels(out, series);
+				out.append(",stage=\"").append(stage).append("\",quantile=\"");
+				append_number(out, q);
+				out.append("\"} ");
+				append_number(out, static_cast<double>(hist.percentile(q)) / 1e9);
+				out.push_back('\n');
+			}
+			out.append(latency).append("_sum{");
+			append_labels(out, series);
+			out.append(",stage=\"").append(stage).append("\"} ");
+			append_number(out, static_cast<double>(hist.sum_ns()) / 1e9);
+			out.push_back('\n');
+			out.append(latency).append("_count{");
+			append_labels(out, series);
+			out.append(",stage=\"").append(stage).append("\"} ");
+			append_number(out, hist.count());
+			out.push_back('\n');
+		}
+	}
+	for (std::size_t c = 0; c < kLatencyCounterCount; ++c) {
+		const std::string family = std::string(prefix) + "_" +
+								   std::string(to_string(static_cast<LatencyCounter>(c))) +
+								   "_total";
+		out.append("# TYPE ").append(family).append(" counter\n");
+		for (const LatencySeries& series : snapshot.series) {
+			if (series.counters[c] == 0) {
+				continue;
+			}
+			out.append(family).push_back('{');
+			append_labels(out, series);
+			out.append("} ");
+			append_number(out, series.counters[c]);
+			out.push_back('\n');
+		}
+	}
+	return out;
+}
+
+} // namespace kalshi
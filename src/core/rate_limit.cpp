@@ -1,86 +1,242 @@
 #include "kalshi/rate_limit.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <thread>
 
 namespace kalshi {
 
-RateLimiter::RateLimiter(Config config)
-	: config_(std::move(config)), tokens_(config_.initial_tokens),
-	  last_refill_(std::chrono::steady_clock::now()) {}
-
-void RateLimiter::refill() noexcept {
-	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-	std::chrono::milliseconds elapsed =
-		std::chrono::duration_cast<std::chrono::milliseconds>(now - last_refill_);
-
-	if (elapsed >= config_.refill_interval) {
-		// Use wider type for arithmetic to avoid overflow
-		std::int64_t intervals = elapsed / config_.refill_interval;
-		std::int64_t new_tokens = static_cast<std::int64_t>(tokens_) + intervals;
-		tokens_ = static_cast<std::uint16_t>(
-			std::min(new_tokens, static_cast<std::int64_t>(config_.max_tokens)));
-		last_refill_ = now;
+namespace {
+
+std::int64_t steady_now_ns() noexcept {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			   std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
+
+std::uint32_t clamp_tokens(std::int64_t value) noexcept {
+	return static_cast<std::uint32_t>(
+		std::clamp<std::int64_t>(value, 0, std::numeric_limits<std::uint32_t>::max()));
+}
+
+constexpr std::string_view API_PREFIX = "/trade-api/v2";
+
+std::string_view strip_query(std::string_view path) noexcept {
+	const std::size_t query = path.find('?');
+	return query == std::string_view::npos ? path : path.substr(0, query);
+}
+
+std::string_view strip_prefix(std::string_view path) noexcept {
+	if (path.starts_with(API_PREFIX)) {
+		path.remove_prefix(API_PREFIX.size());
 	}
+	return path;
 }
 
-bool RateLimiter::try_acquire() noexcept {
-	std::lock_guard lock(mutex_);
-	refill();
+// Segment-wise match where a "{...}" template segment matches any one
+// non-empty segment of `path`.
+bool path_matches(std::string_view pattern, std::string_view path) noexcept {
+	while (!pattern.empty() && !path.empty()) {
+		const std::size_t pattern_end = std::min(pattern.find('/', 1), pattern.size());
+		const std::size_t path_end = std::min(path.find('/', 1), path.size());
+		const std::string_view pattern_segment = pattern.substr(0, pattern_end);
+		const std::string_view path_segment = path.substr(0, path_end);
+		const bool wildcard = pattern_segment.size() > 2 && pattern_segment[1] == '{' &&
+							  pattern_segment.back() == '}';
+		if (wildcard ? path_segment.size() < 2 : pattern_segment != path_segment) {
+			return false;
+		}
+		pattern.remove_prefix(pattern_end);
+		path.remove_prefix(path_end);
+	}
+	return pattern.empty() && path.empty();
+}
 
-	if (tokens_ > 0) {
-		--tokens_;
-		return true;
+} // namespace
+
+RateLimiter::Config RateLimiter::Config::from_bucket(const AccountRateLimitBucket& bucket) {
+	Config config;
+	// No advertised capacity: allow one second's worth of burst.
+	config.max_tokens = clamp_tokens(bucket.bucket_capacity > 0 ? bucket.bucket_capacity
+																 : bucket.refill_rate);
+	config.initial_tokens = config.max_tokens;
+	config.refill_interval = bucket.refill_rate > 0
+								 ? std::chrono::nanoseconds{std::chrono::seconds{1}} /
+									   bucket.refill_rate
+								 : std::chrono::nanoseconds{0};
+	return config;
+}
+
+RateLimiter::RateLimiter(Config config)
+	: config_(std::move(config)), interval_ns_(config_.refill_interval.count()),
+	  capacity_ns_(interval_ns_ * static_cast<std::int64_t>(config_.max_tokens)),
+	  full_at_ns_(0) {
+	reset();
+}
+
+bool RateLimiter::try_acquire(std::uint32_t cost) noexcept {
+	const std::int64_t now = steady_now_ns();
+	const std::int64_t charge = interval_ns_ * static_cast<std::int64_t>(cost);
+	std::int64_t full_at = full_at_ns_.load(std::memory_order_relaxed);
+	for (;;) {
+		// Taking `cost` tokens pushes the full-again time out by their
+		// refill time; that may not exceed one full bucket from now.
+		const std::int64_t next = std::max(full_at, now) + charge;
+		if (next - now > capacity_ns_) {
+			return false;
+		}
+		if (full_at_ns_.compare_exchange_weak(full_at, next, std::memory_order_relaxed)) {
+			return true;
+		}
 	}
-	return false;
 }
 
-bool RateLimiter::acquire() {
+bool RateLimiter::acquire(std::uint32_t cost) {
 	if (config_.max_wait) {
-		return acquire_for(*config_.max_wait);
+		return acquire_for(*config_.max_wait, cost);
+	}
+	if (interval_ns_ > 0 && cost > config_.max_tokens) {
+		return false;
 	}
 
-	while (!try_acquire()) {
-		std::this_thread::sleep_for(config_.refill_interval / 10);
+	while (!try_acquire(cost)) {
+		std::this_thread::sleep_for(time_until_available(cost));
 	}
 	return true;
 }
 
-bool RateLimiter::acquire_for(std::chrono::milliseconds max_wait) {
+bool RateLimiter::acquire_for(std::chrono::milliseconds max_wait, std::uint32_t cost) {
+	if (interval_ns_ > 0 && cost > config_.max_tokens) {
+		return false;
+	}
 	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + max_wait;
 
-	while (std::chrono::steady_clock::now() < deadline) {
-		if (try_acquire()) {
+	for (;;) {
+		if (try_acquire(cost)) {
 			return true;
 		}
-		std::chrono::milliseconds sleep_time = std::min(
-			config_.refill_interval / 10, std::chrono::duration_cast<std::chrono::milliseconds>(
-											  deadline - std::chrono::steady_clock::now()));
-		if (sleep_time.count() > 0) {
-			std::this_thread::sleep_for(sleep_time);
+		const std::chrono::nanoseconds wait = time_until_available(cost);
+		if (std::chrono::steady_clock::now() + wait > deadline) {
+			return false;
 		}
+		std::this_thread::sleep_for(wait);
 	}
+}
 
-	return false;
+std::optional<std::chrono::nanoseconds> RateLimiter::reserve(std::uint32_t cost) noexcept {
+	if (interval_ns_ > 0 && cost > config_.max_tokens) {
+		return std::nullopt;
+	}
+	const std::int64_t now = steady_now_ns();
+	const std::int64_t charge = interval_ns_ * static_cast<std::int64_t>(cost);
+	const std::int64_t max_wait =
+		config_.max_wait
+			? std::chrono::duration_cast<std::chrono::nanoseconds>(*config_.max_wait).count()
+			: std::numeric_limits<std::int64_t>::max();
+	std::int64_t full_at = full_at_ns_.load(std::memory_order_relaxed);
+	for (;;) {
+		// As in try_acquire, but the full-again time may run past one
+		// bucket from now; the excess is how long the caller waits.
+		const std::int64_t next = std::max(full_at, now) + charge;
+		const std::int64_t wait = std::max<std::int64_t>(0, next - now - capacity_ns_);
+		if (wait > max_wait) {
+			return std::nullopt;
+		}
+		if (full_at_ns_.compare_exchange_weak(full_at, next, std::memory_order_relaxed)) {
+			return std::chrono::nanoseconds{wait};
+		}
+	}
+}
+
+std::chrono::nanoseconds RateLimiter::time_until_available(std::uint32_t cost) const noexcept {
+	const std::int64_t now = steady_now_ns();
+	const std::int64_t charge = interval_ns_ * static_cast<std::int64_t>(cost);
+	const std::int64_t full_at = full_at_ns_.load(std::memory_order_relaxed);
+	return std::chrono::nanoseconds{
+		std::max<std::int64_t>(0, std::max(full_at, now) + charge - now - capacity_ns_)};
 }
 
-std::uint16_t RateLimiter::available_tokens() const noexcept {
-	std::lock_guard lock(mutex_);
-	return tokens_;
+std::uint32_t RateLimiter::available_tokens() const noexcept {
+	if (interval_ns_ <= 0) {
+		return config_.max_tokens;
+	}
+	const std::int64_t now = steady_now_ns();
+	const std::int64_t full_at = full_at_ns_.load(std::memory_order_relaxed);
+	return clamp_tokens((capacity_ns_ - std::max<std::int64_t>(0, full_at - now)) / interval_ns_);
 }
 
 void RateLimiter::reset() noexcept {
-	std::lock_guard lock(mutex_);
-	tokens_ = config_.initial_tokens;
-	last_refill_ = std::chrono::steady_clock::now();
+	const std::int64_t initial = std::min(config_.initial_tokens, config_.max_tokens);
+	const std::int64_t missing = static_cast<std::int64_t>(config_.max_tokens) - initial;
+	full_at_ns_.store(steady_now_ns() + missing * interval_ns_, std::memory_order_relaxed);
 }
 
 const RateLimiter::Config& RateLimiter::config() const noexcept {
 	return config_;
 }
 
+// EndpointRateLimiter
+EndpointRateLimiter::EndpointRateLimiter(const AccountApiLimits& limits,
+										 const EndpointCosts& costs,
+										 std::optional<std::chrono::milliseconds> max_wait)
+	: read_([&] {
+		  RateLimiter::Config config = RateLimiter::Config::from_bucket(limits.read);
+		  config.max_wait = max_wait;
+		  return config;
+	  }()),
+	  write_([&] {
+		  RateLimiter::Config config = RateLimiter::Config::from_bucket(limits.write);
+		  config.max_wait = max_wait;
+		  return config;
+	  }()),
+	  default_cost_(costs.default_cost > 0 ? clamp_tokens(costs.default_cost) : 1) {
+	rules_.reserve(costs.endpoint_costs.size());
+	for (const EndpointCost& row : costs.endpoint_costs) {
+		rules_.push_back(Rule{.method = row.method,
+							  .path = std::string(strip_prefix(strip_query(row.path))),
+							  .cost = clamp_tokens(row.cost)});
+	}
+}
+
+std::uint32_t EndpointRateLimiter::cost(std::string_view method,
+										std::string_view path) const noexcept {
+	path = strip_prefix(strip_query(path));
+	for (const Rule& rule : rules_) {
+		if (rule.method == method && path_matches(rule.path, path)) {
+			return rule.cost;
+		}
+	}
+	return default_cost_;
+}
+
+bool EndpointRateLimiter::try_acquire(std::string_view method, std::string_view path) noexcept {
+	return bucket_for(method).try_acquire(cost(method, path));
+}
+
+bool EndpointRateLimiter::acquire(std::string_view method, std::string_view path) {
+	return bucket_for(method).acquire(cost(method, path));
+}
+
+std::optional<std::chrono::nanoseconds>
+EndpointRateLimiter::reserve(std::string_view method, std::string_view path) noexcept {
+	return bucket_for(method).reserve(cost(method, path));
+}
+
+RateLimiter& EndpointRateLimiter::bucket_for(std::string_view method) noexcept {
+	return method == "GET" ? read_ : write_;
+}
+
+RateLimiter& EndpointRateLimiter::read() noexcept {
+	return read_;
+}
+
+RateLimiter& EndpointRateLimiter::write() noexcept {
+	return write_;
+}
+
 // ScopedRateLimit
-ScopedRateLimit::ScopedRateLimit(RateLimiter& limiter) : acquired_(limiter.acquire()) {}
+ScopedRateLimit::ScopedRateLimit(RateLimiter& limiter, std::uint32_t cost)
+	: acquired_(limiter.acquire(cost)) {}
 
 bool ScopedRateLimit::acquired() const noexcept {
 	return acquired_;
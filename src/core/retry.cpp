@@ -5,20 +5,44 @@ namespace kalshi {
 RetryingClient::RetryingClient(HttpClient& client, RetryPolicy policy)
 	: client_(client), policy_(std::move(policy)) {}
 
+namespace {
+
+// Run `method` on `path` under `policy`, counting attempts past the first
+// as retries when the client records latency stats.
+Result<HttpResponse> retry_request(HttpClient& client, const RetryPolicy& policy,
+								   HttpMethod method, std::string_view path,
+								   std::string_view body) {
+	std::uint32_t attempts = 0;
+	Result<HttpResponse> result = with_retry(
+		[&]() {
+			++attempts;
+			return client.request(method, path, body);
+		},
+		policy);
+	if (attempts > 1) {
+		if (const std::shared_ptr<LatencyStats>& stats = client.latency_stats()) {
+			stats->rest(to_string(method), path).add(LatencyCounter::Retries, attempts - 1);
+		}
+	}
+	return result;
+}
+
+} // namespace
+
 Result<HttpResponse> RetryingClient::get(std::string_view path) {
-	return with_retry([this, path]() { return client_.get(path); }, policy_);
+	return retry_request(client_, policy_, HttpMethod::GET, path, {});
 }
 
 Result<HttpResponse> RetryingClient::post(std::string_view path, std::string_view body) {
-	return with_retry([this, path, body]() { return client_.post(path, body); }, policy_);
+	return retry_request(client_, policy_, HttpMethod::POST, path, body);
 }
 
 Result<HttpResponse> RetryingClient::put(std::string_view path, std::string_view body) {
-	return with_retry([this, path, body]() { return client_.put(path, body); }, policy_);
+	return retry_request(client_, policy_, HttpMethod::PUT, path, body);
 }
 
 Result<HttpResponse> RetryingClient::del(std::string_view path, std::string_view body) {
-	return with_retry([this, path, body]() { return client_.del(path, body); }, policy_);
+	return retry_request(client_, policy_, HttpMethod::DEL, path, body);
 }
 
 const RetryPolicy& RetryingClient::policy() const noexcept {
@@ -0,0 +1,52 @@
+#include "kalshi/ticker_table.hpp"
+
+#include <mutex>
+
+namespace kalshi {
+
+TickerId TickerTable::intern(std::string_view ticker) {
+	if (ticker.empty()) {
+		return TickerId{};
+	}
+	{
+		std::shared_lock lock(mutex_);
+		auto it = ids_.find(ticker);
+		if (it != ids_.end()) {
+			return TickerId{it->second};
+		}
+	}
+	std::unique_lock lock(mutex_);
+	// Re-check: another thread may have interned it between the locks.
+	auto it = ids_.find(ticker);
+	if (it != ids_.end()) {
+		return TickerId{it->second};
+	}
+	const std::uint32_t id = static_cast<std::uint32_t>(names_.size());
+	const std::string& stored = names_.emplace_back(ticker);
+	ids_.emplace(std::string_view(stored), id);
+	return TickerId{id};
+}
+
+std::optional<TickerId> TickerTable::find(std::string_view ticker) const {
+	std::shared_lock lock(mutex_);
+	auto it = ids_.find(ticker);
+	if (it == ids_.end()) {
+		return std::nullopt;
+	}
+	return TickerId{it->second};
+}
+
+std::string_view TickerTable::name(TickerId id) const {
+	std::shared_lock lock(mutex_);
+	if (!id.valid() || id.value >= names_.size()) {
+		return {};
+	}
+	return names_[id.value];
+}
+
+std::size_t TickerTable::size() const {
+	std::shared_lock lock(mutex_);
+	return names_.size();
+}
+
+} // namespace kalshi
@@ -1,27 +1,34 @@
 #include "kalshi/http_client.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <curl/curl.h>
-#include <sstream>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace kalshi {
 
-struct HttpClient::Impl {
-	Signer signer;
-	ClientConfig config;
-	CURL* curl{nullptr};
-
-	Impl(Signer s, ClientConfig c) : signer(std::move(s)), config(std::move(c)) {
-		curl = curl_easy_init();
-	}
+namespace {
 
-	~Impl() {
-		if (curl) {
-			curl_easy_cleanup(curl);
-		}
-	}
+// Lock callbacks for the CURLSH share object. One mutex per data kind so a
+// DNS lookup on one thread does not block a TLS session lookup on another.
+struct ShareLocks {
+	std::array<std::mutex, CURL_LOCK_DATA_LAST> mutexes;
 };
 
-namespace {
+void share_lock(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+	static_cast<ShareLocks*>(userptr)->mutexes[static_cast<std::size_t>(data)].lock();
+}
+
+void share_unlock(CURL*, curl_lock_data data, void* userptr) {
+	static_cast<ShareLocks*>(userptr)->mutexes[static_cast<std::size_t>(data)].unlock();
+}
 
 size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdata) {
 	std::string* response = static_cast<std::string*>(userdata);
@@ -50,8 +57,552 @@ size_t header_callback(char* buffer, size_t size, size_t nitems, void* userdata)
 	return size * nitems;
 }
 
+// Write target for request_stream: 2xx bodies go to the caller's chunk
+// callback, anything else is buffered for the error message.
+struct StreamTarget {
+	CURL* curl{nullptr};
+	const HttpChunkCallback* on_chunk{nullptr};
+	std::string* error_body{nullptr};
+	bool stopped{false};
+};
+
+size_t stream_write_callback(char* ptr, size_t size, size_t nmemb, void* userdata) {
+	StreamTarget* target = static_cast<StreamTarget*>(userdata);
+	const size_t n = size * nmemb;
+	long status = 0;
+	curl_easy_getinfo(target->curl, CURLINFO_RESPONSE_CODE, &status);
+	if (status < 200 || status >= 300) {
+		target->error_body->append(ptr, n);
+		return n;
+	}
+	if (!(*target->on_chunk)(std::string_view(ptr, n))) {
+		target->stopped = true;
+		return 0; // short write makes libcurl abort with CURLE_WRITE_ERROR
+	}
+	return n;
+}
+
+// Build the per-request header list. Caller frees with curl_slist_free_all.
+curl_slist* build_headers(const AuthHeaders& auth) {
+	thread_local std::string line;
+	curl_slist* headers = nullptr;
+	line.assign("KALSHI-ACCESS-KEY: ").append(auth.access_key);
+	headers = curl_slist_append(headers, line.c_str());
+	line.assign("KALSHI-ACCESS-SIGNATURE: ").append(auth.signature);
+	headers = curl_slist_append(headers, line.c_str());
+	line.assign("KALSHI-ACCESS-TIMESTAMP: ").append(auth.timestamp);
+	headers = curl_slist_append(headers, line.c_str());
+	headers = curl_slist_append(headers, "Content-Type: application/json");
+	headers = curl_slist_append(headers, "Accept: application/json");
+	return headers;
+}
+
+Error rate_limited(std::string_view path) {
+	return Error{ErrorCode::RateLimited,
+				 "Client-side rate limit exceeded for " + std::string(path)};
+}
+
+// Take the request's tokens from `limiter`, if one is installed.
+Result<void> charge_rate_limit(const std::shared_ptr<EndpointRateLimiter>& limiter,
+							   HttpMethod method, std::string_view path) {
+	if (limiter && !limiter->acquire(to_string(method), path)) {
+		return std::unexpected(rate_limited(path));
+	}
+	return {};
+}
+
+// Async form: reserve the tokens without waiting and return when the
+// request may go out (the epoch if it may go at once).
+Result<std::chrono::steady_clock::time_point>
+reserve_rate_limit(const std::shared_ptr<EndpointRateLimiter>& limiter, HttpMethod method,
+				   std::string_view path) {
+	using Clock = std::chrono::steady_clock;
+	if (!limiter) {
+		return Clock::time_point{};
+	}
+	const std::optional<std::chrono::nanoseconds> wait = limiter->reserve(to_string(method), path);
+	if (!wait) {
+		return std::unexpected(rate_limited(path));
+	}
+	if (wait->count() == 0) {
+		return Clock::time_point{};
+	}
+	return Clock::now() + std::chrono::duration_cast<Clock::duration>(*wait);
+}
+
+// Sign `method` + `path` into this thread's reusable headers and build the
+// request's header list from them. Caller frees with curl_slist_free_all.
+Result<curl_slist*> signed_headers(const Signer& signer, HttpMethod method,
+								   std::string_view path) {
+	thread_local AuthHeaders auth;
+	Result<void> signed_result = signer.sign_into(to_string(method), path, auth);
+	if (!signed_result) {
+		return std::unexpected(signed_result.error());
+	}
+	return build_headers(auth);
+}
+
+// PUT and DELETE need a custom verb; GET and POST follow from `set_body`.
+void set_method(CURL* curl, HttpMethod method) {
+	switch (method) {
+		case HttpMethod::GET:
+		case HttpMethod::POST:
+			curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, nullptr);
+			break;
+		case HttpMethod::PUT:
+			curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
+			break;
+		case HttpMethod::DEL:
+			curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+			break;
+	}
+}
+
+// Point `curl` at `body`, or switch it to a body-less request.
+void set_body(CURL* curl, HttpMethod method, std::string_view body) {
+	if (method == HttpMethod::POST || !body.empty()) {
+		curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.size()));
+		curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.empty() ? "" : body.data());
+	} else {
+		curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+	}
+}
+
+// Set every per-request option on a pooled handle. All of them are set on
+// each request, so nothing leaks from the previous one. `url`, `body`,
+// `headers` and `response` must outlive the transfer.
+void configure_request(CURL* curl, HttpMethod method, const std::string& url,
+					   std::string_view body, curl_slist* headers, HttpResponse& response) {
+	curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+	set_body(curl, method, body);
+	set_method(curl, method);
+
+	curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
+	curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, header_callback);
+	curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response.headers);
+}
+
+// Detach per-request buffers before a handle goes back to a pool.
+void detach_request(CURL* curl) {
+	curl_easy_setopt(curl, CURLOPT_HTTPHEADER, nullptr);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, nullptr);
+	curl_easy_setopt(curl, CURLOPT_HEADERDATA, nullptr);
+	curl_easy_setopt(curl, CURLOPT_PRIVATE, nullptr);
+}
+
+Result<HttpResponse> finish_request(CURL* curl, CURLcode res, HttpResponse&& response) {
+	if (res != CURLE_OK) {
+		return std::unexpected(Error::network(curl_easy_strerror(res)));
+	}
+	long status_code = 0;
+	curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status_code);
+	response.status_code = static_cast<std::int16_t>(status_code);
+	return std::move(response);
+}
+
+using SteadyClock = std::chrono::steady_clock;
+
+// Count a finished transfer and record its first-byte and total time.
+// `curl` must still hold the transfer's info.
+void record_transfer(LatencyStats::Recorder& timing, CURL* curl,
+					 const Result<HttpResponse>& result, SteadyClock::time_point start) {
+	timing.record(LatencyStage::Total, SteadyClock::now() - start);
+	timing.add(LatencyCounter::Requests);
+	curl_off_t uploaded = 0;
+	curl_off_t downloaded = 0;
+	curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &uploaded);
+	curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &downloaded);
+	timing.add(LatencyCounter::BytesOut, static_cast<std::uint64_t>(uploaded));
+	timing.add(LatencyCounter::BytesIn, static_cast<std::uint64_t>(downloaded));
+	if (!result) {
+		timing.add(LatencyCounter::Errors);
+		return;
+	}
+	curl_off_t first_byte_us = 0;
+	curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &first_byte_us);
+	timing.record(LatencyStage::FirstByte, static_cast<std::uint64_t>(first_byte_us) * 1000);
+	if (result->status_code == 429) {
+		timing.add(LatencyCounter::RateLimited);
+	}
+	if (result->status_code >= 400) {
+		timing.add(LatencyCounter::Errors);
+	}
+}
+
+// Start timing a request when stats are attached; `timing` stays empty
+// (and every record a no-op) otherwise.
+SteadyClock::time_point start_timing(const std::shared_ptr<LatencyStats>& stats,
+									 LatencyStats::Recorder& timing, HttpMethod method,
+									 std::string_view path) {
+	if (!stats) {
+		return {};
+	}
+	timing = stats->rest(to_string(method), path);
+	return SteadyClock::now();
+}
+
+// One queued or in-flight async request. Owns everything the transfer
+// points at, so it must stay put until curl reports completion.
+struct AsyncTransfer {
+	HttpMethod method{HttpMethod::GET};
+	std::string url;
+	std::string body;
+	/// Null until signed. A transfer held back by the rate limiter is
+	/// signed from ``path`` when it starts, so its timestamp is fresh.
+	curl_slist* headers{nullptr};
+	std::string path;
+	/// Not started before this (rate-limit reservation); epoch = now
+	SteadyClock::time_point not_before{};
+	HttpResponse response{};
+	HttpCallback callback;
+	/// Set when latency stats are attached
+	SteadyClock::time_point start{};
+
+	AsyncTransfer() = default;
+	AsyncTransfer(const AsyncTransfer&) = delete;
+	AsyncTransfer& operator=(const AsyncTransfer&) = delete;
+	~AsyncTransfer() { curl_slist_free_all(headers); }
+};
+
 } // namespace
 
+struct HttpClient::Impl {
+	Signer signer;
+	ClientConfig config;
+	std::shared_ptr<EndpointRateLimiter> limiter;
+	std::shared_ptr<LatencyStats> latency;
+
+	// DNS cache, TLS session cache and connection cache shared by every
+	// pooled handle, so a handle that has never talked to the host still
+	// reuses a warm connection (or at least a resumable TLS session).
+	CURLSH* share{nullptr};
+	ShareLocks share_locks;
+
+	// Handle pool. `idle` holds handles not currently in a request;
+	// `created` counts every live handle, idle or leased.
+	std::mutex pool_mutex;
+	std::condition_variable pool_cv;
+	std::vector<CURL*> idle;
+	std::size_t created{0};
+
+	// Async event loop, started on the first request_async. `multi` and
+	// `active` / `async_idle` belong to the loop thread; `submitted` and
+	// `stopping` are handed over under `async_mutex`. A burst gets one
+	// handle per transfer, but at most `max_connections` stay idle.
+	std::mutex async_mutex;
+	std::thread async_thread;
+	CURLM* multi{nullptr};
+	std::deque<std::unique_ptr<AsyncTransfer>> submitted;
+	bool stopping{false};
+	std::unordered_map<CURL*, std::unique_ptr<AsyncTransfer>> active;
+	std::vector<CURL*> async_idle;
+	// Transfers waiting out a rate-limit reservation (loop thread).
+	std::multimap<SteadyClock::time_point, std::unique_ptr<AsyncTransfer>> deferred;
+
+	Impl(Signer s, ClientConfig c) : signer(std::move(s)), config(std::move(c)) {
+		if (config.max_connections == 0) {
+			config.max_connections = 1;
+		}
+		if (config.rate_limits) {
+			limiter = std::make_shared<EndpointRateLimiter>(*config.rate_limits, EndpointCosts{});
+		}
+		share = curl_share_init();
+		if (share) {
+			curl_share_setopt(share, CURLSHOPT_LOCKFUNC, share_lock);
+			curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, share_unlock);
+			curl_share_setopt(share, CURLSHOPT_USERDATA, &share_locks);
+			curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+			curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+			curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+		}
+		// Warm one handle up front so a misconfigured libcurl fails the
+		// first request with a clear error instead of at pool growth.
+		CURL* first = create_handle();
+		if (first) {
+			idle.push_back(first);
+			++created;
+		}
+	}
+
+	~Impl() {
+		stop_async();
+		for (CURL* handle : idle) {
+			curl_easy_cleanup(handle);
+		}
+		if (share) {
+			curl_share_cleanup(share);
+		}
+	}
+
+	Impl(const Impl&) = delete;
+	Impl& operator=(const Impl&) = delete;
+
+	// Options that never change between requests are set once here;
+	// `configure_request` only touches the per-request ones. No
+	// curl_easy_reset, so the handle keeps its connection, DNS entry and
+	// TLS session.
+	CURL* create_handle() const {
+		CURL* handle = curl_easy_init();
+		if (!handle) {
+			return nullptr;
+		}
+		if (share) {
+			curl_easy_setopt(handle, CURLOPT_SHARE, share);
+		}
+		curl_easy_setopt(handle, CURLOPT_TIMEOUT, static_cast<long>(config.timeout.count()));
+		curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, config.verify_ssl ? 1L : 0L);
+		curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+		curl_easy_setopt(handle, CURLOPT_TCP_NODELAY, 1L);
+		curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+		if (config.http2) {
+			// Negotiated via ALPN; silently stays on HTTP/1.1 if the
+			// server or libcurl build lacks HTTP/2.
+			curl_easy_setopt(handle, CURLOPT_HTTP_VERSION,
+							 static_cast<long>(CURL_HTTP_VERSION_2TLS));
+		}
+		return handle;
+	}
+
+	// Borrow a handle: reuse an idle one, grow the pool up to
+	// `max_connections`, otherwise wait for one to be returned.
+	CURL* acquire() {
+		std::unique_lock lock(pool_mutex);
+		for (;;) {
+			if (!idle.empty()) {
+				CURL* handle = idle.back();
+				idle.pop_back();
+				return handle;
+			}
+			if (created < config.max_connections) {
+				++created;
+				lock.unlock();
+				CURL* handle = create_handle();
+				if (!handle) {
+					lock.lock();
+					--created;
+					pool_cv.notify_one();
+				}
+				return handle;
+			}
+			pool_cv.wait(lock);
+		}
+	}
+
+	void release(CURL* handle) {
+		{
+			std::lock_guard lock(pool_mutex);
+			idle.push_back(handle);
+		}
+		pool_cv.notify_one();
+	}
+
+	// Returns a pooled handle on scope exit, including early error returns.
+	class Lease {
+	public:
+		explicit Lease(Impl& pool) : pool_(pool), handle_(pool.acquire()) {}
+		~Lease() {
+			if (handle_) {
+				pool_.release(handle_);
+			}
+		}
+
+		Lease(const Lease&) = delete;
+		Lease& operator=(const Lease&) = delete;
+
+		[[nodiscard]] CURL* get() const noexcept { return handle_; }
+
+	private:
+		Impl& pool_;
+		CURL* handle_;
+	};
+
+	// Hand a signed transfer to the event loop, starting it if needed.
+	// Returns false (transfer untouched) when the loop cannot run.
+	bool submit(std::unique_ptr<AsyncTransfer>& transfer) {
+		std::lock_guard lock(async_mutex);
+		if (stopping) {
+			return false;
+		}
+		if (!multi) {
+			multi = curl_multi_init();
+			if (!multi) {
+				return false;
+			}
+			// Many streams over few connections: HTTP/2 multiplexing when
+			// negotiated, otherwise at most max_connections per host.
+			curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+			curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+							  static_cast<long>(config.max_connections));
+			async_thread = std::thread([this] { run_async_loop(); });
+		}
+		submitted.push_back(std::move(transfer));
+		curl_multi_wakeup(multi);
+		return true;
+	}
+
+	void stop_async() {
+		{
+			std::lock_guard lock(async_mutex);
+			stopping = true;
+			if (multi) {
+				curl_multi_wakeup(multi);
+			}
+		}
+		if (async_thread.joinable()) {
+			async_thread.join();
+		}
+		for (CURL* handle : async_idle) {
+			curl_easy_cleanup(handle);
+		}
+		async_idle.clear();
+		if (multi) {
+			curl_multi_cleanup(multi);
+			multi = nullptr;
+		}
+	}
+
+	// Loop thread: start submitted transfers, or park those whose
+	// rate-limit reservation is not yet due.
+	void start_submitted(std::deque<std::unique_ptr<AsyncTransfer>>& batch) {
+		const SteadyClock::time_point now = SteadyClock::now();
+		for (std::unique_ptr<AsyncTransfer>& transfer : batch) {
+			if (transfer->not_before > now) {
+				const SteadyClock::time_point due = transfer->not_before;
+				deferred.emplace(due, std::move(transfer));
+			} else {
+				start_transfer(std::move(transfer));
+			}
+		}
+		batch.clear();
+	}
+
+	// Loop thread: start deferred transfers that are due. Returns how long
+	// until the next one is.
+	std::chrono::milliseconds start_due() {
+		const SteadyClock::time_point now = SteadyClock::now();
+		while (!deferred.empty() && deferred.begin()->first <= now) {
+			std::unique_ptr<AsyncTransfer> transfer = std::move(deferred.begin()->second);
+			deferred.erase(deferred.begin());
+			start_transfer(std::move(transfer));
+		}
+		if (deferred.empty()) {
+			return std::chrono::milliseconds{1000};
+		}
+		// Rounded up so the loop does not wake just before it is due.
+		return std::chrono::ceil<std::chrono::milliseconds>(deferred.begin()->first - now);
+	}
+
+	// Loop thread: put a transfer on a curl handle.
+	void start_transfer(std::unique_ptr<AsyncTransfer> transfer) {
+		if (!transfer->headers) {
+			Result<curl_slist*> headers = signed_headers(signer, transfer->method, transfer->path);
+			if (!headers) {
+				transfer->callback(std::unexpected(headers.error()));
+				return;
+			}
+			transfer->headers = *headers;
+			if (latency) {
+				transfer->start = SteadyClock::now();
+			}
+		}
+		CURL* handle = nullptr;
+		if (!async_idle.empty()) {
+			handle = async_idle.back();
+			async_idle.pop_back();
+		} else {
+			handle = create_handle();
+		}
+		if (!handle) {
+			transfer->callback(std::unexpected(Error::network("CURL not initialized")));
+			return;
+		}
+		configure_request(handle, transfer->method, transfer->url, transfer->body,
+						  transfer->headers, transfer->response);
+		curl_multi_add_handle(multi, handle);
+		active.emplace(handle, std::move(transfer));
+	}
+
+	// Loop thread: deliver a finished transfer and recycle its handle.
+	void complete(CURL* handle, CURLcode res) {
+		std::unordered_map<CURL*, std::unique_ptr<AsyncTransfer>>::iterator it =
+			active.find(handle);
+		curl_multi_remove_handle(multi, handle);
+		if (it == active.end()) {
+			curl_easy_cleanup(handle);
+			return;
+		}
+		std::unique_ptr<AsyncTransfer> transfer = std::move(it->second);
+		active.erase(it);
+		Result<HttpResponse> result = finish_request(handle, res, std::move(transfer->response));
+		if (latency) {
+			// Looked up on the loop thread, which owns this recorder's shard.
+			LatencyStats::Recorder timing = latency->rest(
+				to_string(transfer->method),
+				std::string_view(transfer->url).substr(config.base_url.size()));
+			record_transfer(timing, handle, result, transfer->start);
+		}
+		detach_request(handle);
+		// Connections live in the shared cache, so freeing a surplus
+		// handle does not close one.
+		if (async_idle.size() < config.max_connections) {
+			async_idle.push_back(handle);
+		} else {
+			curl_easy_cleanup(handle);
+		}
+		transfer->callback(std::move(result));
+	}
+
+	void run_async_loop() {
+		std::deque<std::unique_ptr<AsyncTransfer>> batch;
+		for (;;) {
+			bool stop = false;
+			{
+				std::lock_guard lock(async_mutex);
+				batch.swap(submitted);
+				stop = stopping;
+			}
+			if (stop) {
+				// Fail everything still queued or in flight.
+				for (std::unique_ptr<AsyncTransfer>& transfer : batch) {
+					transfer->callback(
+						std::unexpected(Error::network("HttpClient destroyed before completion")));
+				}
+				for (std::pair<const SteadyClock::time_point, std::unique_ptr<AsyncTransfer>>&
+						 entry : deferred) {
+					entry.second->callback(
+						std::unexpected(Error::network("HttpClient destroyed before completion")));
+				}
+				deferred.clear();
+				for (std::pair<CURL* const, std::unique_ptr<AsyncTransfer>>& entry : active) {
+					curl_multi_remove_handle(multi, entry.first);
+					curl_easy_cleanup(entry.first);
+					entry.second->callback(
+						std::unexpected(Error::network("HttpClient destroyed before completion")));
+				}
+				active.clear();
+				return;
+			}
+			start_submitted(batch);
+			const std::chrono::milliseconds next_due = start_due();
+
+			int running = 0;
+			curl_multi_perform(multi, &running);
+			int queued = 0;
+			while (CURLMsg* msg = curl_multi_info_read(multi, &queued)) {
+				if (msg->msg == CURLMSG_DONE) {
+					complete(msg->easy_handle, msg->data.result);
+				}
+			}
+			// Sleeps until socket activity, a curl timer, a deferred
+			// transfer falling due, or curl_multi_wakeup from submit /
+			// stop_async.
+			curl_multi_poll(multi, nullptr, 0, static_cast<int>(next_due.count()), nullptr);
+		}
+	}
+};
+
 HttpClient::HttpClient(Signer signer, ClientConfig config)
 	: impl_(std::make_unique<Impl>(std::move(signer), std::move(config))) {}
 
@@ -61,6 +612,26 @@ HttpClient::HttpClient(HttpClient&&) noexcept = default;
 
 HttpClient& HttpClient::operator=(HttpClient&&) noexcept = default;
 
+void HttpClient::set_rate_limiter(std::shared_ptr<EndpointRateLimiter> limiter) {
+	if (impl_) {
+		impl_->limiter = std::move(limiter);
+	}
+}
+
+const std::shared_ptr<EndpointRateLimiter>& HttpClient::rate_limiter() const noexcept {
+	return impl_->limiter;
+}
+
+void HttpClient::set_latency_stats(std::shared_ptr<LatencyStats> stats) {
+	if (impl_) {
+		impl_->latency = std::move(stats);
+	}
+}
+
+const std::shared_ptr<LatencyStats>& HttpClient::latency_stats() const noexcept {
+	return impl_->latency;
+}
+
 const ClientConfig& HttpClient::config() const noexcept {
 	return impl_->config;
 }
@@ -83,87 +654,392 @@ Result<HttpResponse> HttpClient::del(std::string_view path, std::string_view bod
 
 Result<HttpResponse> HttpClient::request(HttpMethod method, std::string_view path,
 										 std::string_view body) const {
-	if (!impl_->curl) {
+	if (!impl_) {
+		return std::unexpected(Error::network("HttpClient has been moved from"));
+	}
+
+	// Sign before leasing a handle so neither rate limiting nor signing
+	// ever holds a connection.
+	Result<void> charged = charge_rate_limit(impl_->limiter, method, path);
+	if (!charged) {
+		return std::unexpected(charged.error());
+	}
+	LatencyStats::Recorder timing;
+	const SteadyClock::time_point start = start_timing(impl_->latency, timing, method, path);
+	Result<curl_slist*> headers_result = signed_headers(impl_->signer, method, path);
+	if (!headers_result) {
+		return std::unexpected(headers_result.error());
+	}
+	if (timing) {
+		timing.record(LatencyStage::Sign, SteadyClock::now() - start);
+	}
+
+	curl_slist* headers = *headers_result;
+	Impl::Lease lease(*impl_);
+	CURL* curl = lease.get();
+	if (!curl) {
+		curl_slist_free_all(headers);
 		return std::unexpected(Error::network("CURL not initialized"));
 	}
 
-	// Sign the request
-	Result<AuthHeaders> headers_result =
-		impl_->signer.sign(std::string(to_string(method)), std::string(path));
+	std::string url = impl_->config.base_url + std::string(path);
+	HttpResponse response{};
+	configure_request(curl, method, url, body, headers, response);
+
+	CURLcode res = curl_easy_perform(curl);
+
+	// The header list and response buffers die with this frame; detach
+	// them before the handle goes back to the pool.
+	detach_request(curl);
+	curl_slist_free_all(headers);
+
+	Result<HttpResponse> result = finish_request(curl, res, std::move(response));
+	if (timing) {
+		record_transfer(timing, curl, result, start);
+	}
+	return result;
+}
+
+Result<HttpResponse> HttpClient::request_stream(HttpMethod method, std::string_view path,
+												std::string_view body,
+												const HttpChunkCallback& on_chunk) const {
+	if (!impl_) {
+		return std::unexpected(Error::network("HttpClient has been moved from"));
+	}
+
+	Result<void> charged = charge_rate_limit(impl_->limiter, method, path);
+	if (!charged) {
+		return std::unexpected(charged.error());
+	}
+	LatencyStats::Recorder timing;
+	const SteadyClock::time_point start = start_timing(impl_->latency, timing, method, path);
+	Result<curl_slist*> headers_result = signed_headers(impl_->signer, method, path);
 	if (!headers_result) {
 		return std::unexpected(headers_result.error());
 	}
-	const AuthHeaders& auth = *headers_result;
+	if (timing) {
+		timing.record(LatencyStage::Sign, SteadyClock::now() - start);
+	}
+
+	curl_slist* headers = *headers_result;
+	Impl::Lease lease(*impl_);
+	CURL* curl = lease.get();
+	if (!curl) {
+		curl_slist_free_all(headers);
+		return std::unexpected(Error::network("CURL not initialized"));
+	}
 
-	// Build URL
 	std::string url = impl_->config.base_url + std::string(path);
+	HttpResponse response{};
+	configure_request(curl, method, url, body, headers, response);
+	StreamTarget target{
+		.curl = curl, .on_chunk = &on_chunk, .error_body = &response.body, .stopped = false};
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, stream_write_callback);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &target);
 
-	// Reset curl handle
-	curl_easy_reset(impl_->curl);
+	CURLcode res = curl_easy_perform(curl);
+	if (res == CURLE_WRITE_ERROR && target.stopped) {
+		res = CURLE_OK;
+	}
 
-	// Set URL
-	curl_easy_setopt(impl_->curl, CURLOPT_URL, url.c_str());
+	detach_request(curl);
+	curl_slist_free_all(headers);
 
-	// Set method
-	switch (method) {
-		case HttpMethod::GET:
-			curl_easy_setopt(impl_->curl, CURLOPT_HTTPGET, 1L);
-			break;
-		case HttpMethod::POST:
-			curl_easy_setopt(impl_->curl, CURLOPT_POST, 1L);
-			break;
-		case HttpMethod::PUT:
-			curl_easy_setopt(impl_->curl, CURLOPT_CUSTOMREQUEST, "PUT");
-			break;
-		case HttpMethod::DEL:
-			curl_easy_setopt(impl_->curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+	Result<HttpResponse> result = finish_request(curl, res, std::move(response));
+	if (timing) {
+		record_transfer(timing, curl, result, start);
+	}
+	return result;
+}
+
+void HttpClient::request_async(HttpMethod method, std::string path, std::string body,
+							   HttpCallback callback) const {
+	submit_async(method, std::move(path), std::move(body), std::move(callback), true);
+}
+
+void HttpClient::submit_async(HttpMethod method, std::string path, std::string body,
+							  HttpCallback callback, bool charge_limiter) const {
+	if (!impl_) {
+		callback(std::unexpected(Error::network("HttpClient has been moved from")));
+		return;
+	}
+
+	// Never blocks the caller: a request over budget is handed to the
+	// event loop now and held there until its tokens are due.
+	Result<SteadyClock::time_point> due =
+		reserve_rate_limit(charge_limiter ? impl_->limiter : nullptr, method, path);
+	if (!due) {
+		callback(std::unexpected(due.error()));
+		return;
+	}
+	std::unique_ptr<AsyncTransfer> transfer = std::make_unique<AsyncTransfer>();
+	transfer->method = method;
+	transfer->url = impl_->config.base_url + path;
+	transfer->body = std::move(body);
+	transfer->callback = std::move(callback);
+	if (*due != SteadyClock::time_point{}) {
+		transfer->path = std::move(path);
+		transfer->not_before = *due;
+		if (!impl_->submit(transfer)) {
+			transfer->callback(std::unexpected(Error::network("HTTP event loop unavailable")));
+		}
+		return;
+	}
+
+	// Signed on the calling thread so the timestamp reflects submission.
+	LatencyStats::Recorder timing;
+	const SteadyClock::time_point start = start_timing(impl_->latency, timing, method, path);
+	Result<curl_slist*> headers_result = signed_headers(impl_->signer, method, path);
+	if (!headers_result) {
+		transfer->callback(std::unexpected(headers_result.error()));
+		return;
+	}
+	if (timing) {
+		timing.record(LatencyStage::Sign, SteadyClock::now() - start);
+	}
+
+	transfer->headers = *headers_result;
+	transfer->start = start;
+	if (!impl_->submit(transfer)) {
+		transfer->callback(std::unexpected(Error::network("HTTP event loop unavailable")));
+	}
+}
+
+std::future<Result<HttpResponse>> HttpClient::request_async(HttpMethod method, std::string path,
+															std::string body) const {
+	std::shared_ptr<std::promise<Result<HttpResponse>>> promise =
+		std::make_shared<std::promise<Result<HttpResponse>>>();
+	std::future<Result<HttpResponse>> future = promise->get_future();
+	request_async(method, std::move(path), std::move(body), [promise](Result<HttpResponse> result) {
+		promise->set_value(std::move(result));
+	});
+	return future;
+}
+
+// ===== PreparedRequest =====
+
+struct PreparedRequest::Impl {
+	/// A signed header list and when it was signed
+	struct Entry {
+		curl_slist* headers{nullptr};
+		SteadyClock::time_point signed_at;
+	};
+
+	HttpClient::Impl* client{nullptr};
+	HttpMethod method{HttpMethod::GET};
+	std::string path;
+	std::string url;
+	PreparedRequestConfig config;
+
+	mutable std::mutex mutex;
+	std::deque<Entry> entries; // oldest first
+
+	std::atomic<std::uint64_t> sent{0};
+	std::atomic<std::uint64_t> signed_inline{0};
+
+	Impl() = default;
+	Impl(const Impl&) = delete;
+	Impl& operator=(const Impl&) = delete;
+
+	~Impl() {
+		for (const Entry& entry : entries) {
+			curl_slist_free_all(entry.headers);
+		}
+	}
+
+	// Caller holds `mutex`.
+	void drop_stale(SteadyClock::time_point now) {
+		while (!entries.empty() && now - entries.front().signed_at >= config.max_age) {
+			curl_slist_free_all(entries.front().headers);
+			entries.pop_front();
+		}
+	}
+
+	// Newest fresh header list, or one signed now. Caller frees it.
+	Result<curl_slist*> take_headers() {
+		{
+			std::lock_guard lock(mutex);
+			drop_stale(SteadyClock::now());
+			if (!entries.empty()) {
+				curl_slist* headers = entries.back().headers;
+				entries.pop_back();
+				return headers;
+			}
+		}
+		signed_inline.fetch_add(1, std::memory_order_relaxed);
+		return signed_headers(client->signer, method, path);
+	}
+};
+
+PreparedRequest::PreparedRequest(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+PreparedRequest::~PreparedRequest() = default;
+
+PreparedRequest::PreparedRequest(PreparedRequest&&) noexcept = default;
+
+PreparedRequest& PreparedRequest::operator=(PreparedRequest&&) noexcept = default;
+
+Result<PreparedRequest> HttpClient::prepare(HttpMethod method, std::string path,
+											PreparedRequestConfig config) const {
+	if (!impl_) {
+		return std::unexpected(Error::network("HttpClient has been moved from"));
+	}
+	std::unique_ptr<PreparedRequest::Impl> prepared = std::make_unique<PreparedRequest::Impl>();
+	prepared->client = impl_.get();
+	prepared->method = method;
+	prepared->url = impl_->config.base_url + path;
+	prepared->path = std::move(path);
+	prepared->config = config;
+	return PreparedRequest(std::move(prepared));
+}
+
+Result<void> PreparedRequest::refill() {
+	if (!impl_) {
+		return std::unexpected(Error::signing("PreparedRequest has been moved from"));
+	}
+
+	std::size_t missing = 0;
+	{
+		std::lock_guard lock(impl_->mutex);
+		impl_->drop_stale(SteadyClock::now());
+		const std::size_t target = impl_->config.presigned;
+		missing = target - std::min(target, impl_->entries.size());
+	}
+
+	// Sign outside the lock so a concurrent send never waits on RSA.
+	for (std::size_t i = 0; i < missing; ++i) {
+		Result<curl_slist*> headers =
+			signed_headers(impl_->client->signer, impl_->method, impl_->path);
+		if (!headers) {
+			return std::unexpected(headers.error());
+		}
+		std::lock_guard lock(impl_->mutex);
+		if (impl_->entries.size() >= impl_->config.presigned) {
+			curl_slist_free_all(*headers);
 			break;
+		}
+		impl_->entries.push_back({*headers, SteadyClock::now()});
 	}
+	return {};
+}
 
-	// Set body if present
-	if (!body.empty()) {
-		curl_easy_setopt(impl_->curl, CURLOPT_POSTFIELDS, body.data());
-		curl_easy_setopt(impl_->curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.size()));
+Result<HttpResponse> PreparedRequest::send(std::string_view body) {
+	if (!impl_) {
+		return std::unexpected(Error::network("PreparedRequest has been moved from"));
+	}
+	Impl& prepared = *impl_;
+	Result<void> charged =
+		charge_rate_limit(prepared.client->limiter, prepared.method, prepared.path);
+	if (!charged) {
+		return std::unexpected(charged.error());
 	}
+	LatencyStats::Recorder timing;
+	const SteadyClock::time_point start =
+		start_timing(prepared.client->latency, timing, prepared.method, prepared.path);
 
-	// Build headers
-	curl_slist* headers = nullptr;
-	headers = curl_slist_append(headers, ("KALSHI-ACCESS-KEY: " + auth.access_key).c_str());
-	headers = curl_slist_append(headers, ("KALSHI-ACCESS-SIGNATURE: " + auth.signature).c_str());
-	headers = curl_slist_append(headers, ("KALSHI-ACCESS-TIMESTAMP: " + auth.timestamp).c_str());
-	headers = curl_slist_append(headers, "Content-Type: application/json");
-	headers = curl_slist_append(headers, "Accept: application/json");
-	curl_easy_setopt(impl_->curl, CURLOPT_HTTPHEADER, headers);
+	// A pooled handle like any other request, so concurrent sends of one
+	// prepared request run in parallel. The headers are taken only once
+	// the handle is ours, so a wait for the pool never ages the signature.
+	HttpClient::Impl::Lease lease(*prepared.client);
+	CURL* curl = lease.get();
+	if (!curl) {
+		return std::unexpected(Error::network("CURL not initialized"));
+	}
+	const SteadyClock::time_point sign_start = SteadyClock::now();
+	Result<curl_slist*> headers = prepared.take_headers();
+	if (!headers) {
+		return std::unexpected(headers.error());
+	}
+	if (timing) {
+		timing.record(LatencyStage::Sign, SteadyClock::now() - sign_start);
+	}
+	prepared.sent.fetch_add(1, std::memory_order_relaxed);
 
-	// Set timeout
-	curl_easy_setopt(impl_->curl, CURLOPT_TIMEOUT, impl_->config.timeout.count());
+	HttpResponse response{};
+	configure_request(curl, prepared.method, prepared.url, body, *headers, response);
 
-	// SSL verification
-	curl_easy_setopt(impl_->curl, CURLOPT_SSL_VERIFYPEER, impl_->config.verify_ssl ? 1L : 0L);
+	const CURLcode res = curl_easy_perform(curl);
 
-	// Response handling
-	HttpResponse response;
-	curl_easy_setopt(impl_->curl, CURLOPT_WRITEFUNCTION, write_callback);
-	curl_easy_setopt(impl_->curl, CURLOPT_WRITEDATA, &response.body);
-	curl_easy_setopt(impl_->curl, CURLOPT_HEADERFUNCTION, header_callback);
-	curl_easy_setopt(impl_->curl, CURLOPT_HEADERDATA, &response.headers);
+	detach_request(curl);
+	curl_slist_free_all(*headers);
 
-	// Perform request
-	CURLcode res = curl_easy_perform(impl_->curl);
+	Result<HttpResponse> result = finish_request(curl, res, std::move(response));
+	if (timing) {
+		record_transfer(timing, curl, result, start);
+	}
+	return result;
+}
 
-	// Cleanup headers
-	curl_slist_free_all(headers);
+void PreparedRequest::send_async(std::string body, HttpCallback callback) {
+	if (!impl_) {
+		callback(std::unexpected(Error::network("PreparedRequest has been moved from")));
+		return;
+	}
+	Impl& prepared = *impl_;
+	Result<SteadyClock::time_point> due =
+		reserve_rate_limit(prepared.client->limiter, prepared.method, prepared.path);
+	if (!due) {
+		callback(std::unexpected(due.error()));
+		return;
+	}
+	std::unique_ptr<AsyncTransfer> transfer = std::make_unique<AsyncTransfer>();
+	transfer->method = prepared.method;
+	transfer->url = prepared.url;
+	transfer->body = std::move(body);
+	transfer->callback = std::move(callback);
+	if (*due != SteadyClock::time_point{}) {
+		// A pre-signed header list could age out while it waits; the
+		// event loop signs afresh when the transfer starts.
+		transfer->path = prepared.path;
+		transfer->not_before = *due;
+		prepared.sent.fetch_add(1, std::memory_order_relaxed);
+		if (!prepared.client->submit(transfer)) {
+			transfer->callback(std::unexpected(Error::network("HTTP event loop unavailable")));
+		}
+		return;
+	}
 
-	if (res != CURLE_OK) {
-		return std::unexpected(Error::network(curl_easy_strerror(res)));
+	LatencyStats::Recorder timing;
+	const SteadyClock::time_point start =
+		start_timing(prepared.client->latency, timing, prepared.method, prepared.path);
+	Result<curl_slist*> headers = prepared.take_headers();
+	if (!headers) {
+		transfer->callback(std::unexpected(headers.error()));
+		return;
 	}
+	if (timing) {
+		timing.record(LatencyStage::Sign, SteadyClock::now() - start);
+	}
+	prepared.sent.fetch_add(1, std::memory_order_relaxed);
+	transfer->headers = *headers;
+	transfer->start = start;
+	if (!prepared.client->submit(transfer)) {
+		transfer->callback(std::unexpected(Error::network("HTTP event loop unavailable")));
+	}
+}
 
-	// Get status code
-	long status_code = 0;
-	curl_easy_getinfo(impl_->curl, CURLINFO_RESPONSE_CODE, &status_code);
-	response.status_code = static_cast<std::int16_t>(status_code);
+std::size_t PreparedRequest::presigned() const {
+	if (!impl_) {
+		return 0;
+	}
+	std::lock_guard lock(impl_->mutex);
+	return impl_->entries.size();
+}
+
+PreparedRequestStats PreparedRequest::stats() const noexcept {
+	if (!impl_) {
+		return {};
+	}
+	return {.sent = impl_->sent.load(std::memory_order_relaxed),
+			.signed_inline = impl_->signed_inline.load(std::memory_order_relaxed)};
+}
+
+HttpMethod PreparedRequest::method() const noexcept {
+	return impl_ ? impl_->method : HttpMethod::GET;
+}
 
-	return response;
+std::string_view PreparedRequest::path() const noexcept {
+	return impl_ ? std::string_view(impl_->path) : std::string_view{};
 }
 
 } // namespace kalshi
@@ -0,0 +1,344 @@
+#include "kalshi/request_scheduler.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace kalshi {
+
+RequestLane default_lane(HttpMethod method, std::string_view path) noexcept {
+	if (method == HttpMethod::GET) {
+		return RequestLane::Read;
+	}
+	if (method == HttpMethod::DEL) {
+		return RequestLane::Cancel;
+	}
+	const std::string_view route = path.substr(0, path.find('?'));
+	if (route.ends_with("/amend") || route.ends_with("/decrease")) {
+		return RequestLane::Cancel;
+	}
+	return RequestLane::Create;
+}
+
+namespace {
+
+// Floor on dispatcher sleeps, so a bucket that reports "available now"
+// but loses the race for it does not spin.
+constexpr std::chrono::microseconds MIN_WAIT{50};
+
+Error shed_error(std::string_view path) {
+	return Error{ErrorCode::RateLimited, "Read shed by scheduler: " + std::string(path)};
+}
+
+} // namespace
+
+struct RequestScheduler::Impl : std::enable_shared_from_this<RequestScheduler::Impl> {
+	struct Pending {
+		RequestLane lane;
+		HttpMethod method;
+		std::string path;
+		std::string body;
+		std::vector<HttpCallback> callbacks; // more than one once coalesced
+		std::chrono::steady_clock::time_point enqueued;
+		std::chrono::steady_clock::time_point not_before;
+		std::uint8_t attempt{1};
+	};
+
+	HttpClient* client;
+	std::shared_ptr<EndpointRateLimiter> limiter;
+	SchedulerConfig config;
+
+	// Everything below is guarded by `mutex`. Completions re-queue from
+	// the HTTP event-loop thread; the dispatcher is the only consumer.
+	mutable std::mutex mutex;
+	std::condition_variable cv;
+	std::array<std::deque<std::shared_ptr<Pending>>, REQUEST_LANE_COUNT> lanes;
+	SchedulerStats counters;
+	bool stopping{false};
+	std::thread dispatcher;
+
+	Impl(HttpClient& c, std::shared_ptr<EndpointRateLimiter> l, SchedulerConfig cfg)
+		: client(&c), limiter(std::move(l)), config(std::move(cfg)) {}
+
+	static void deliver(Pending& pending, Result<HttpResponse> result) {
+		for (std::size_t i = 0; i + 1 < pending.callbacks.size(); ++i) {
+			pending.callbacks[i](result);
+		}
+		if (!pending.callbacks.empty()) {
+			pending.callbacks.back()(std::move(result));
+		}
+	}
+
+	// True when `method` `path` costs more than its bucket can ever hold.
+	[[nodiscard]] bool unsatisfiable(HttpMethod method, std::string_view path) const {
+		if (!limiter) {
+			return false;
+		}
+		const RateLimiter::Config& bucket = limiter->bucket_for(to_string(method)).config();
+		return bucket.refill_interval.count() > 0 &&
+			   limiter->cost(to_string(method), path) > bucket.max_tokens;
+	}
+
+	void enqueue(RequestLane lane, HttpMethod method, std::string path, std::string body,
+				 HttpCallback callback) {
+		if (unsatisfiable(method, path)) {
+			callback(std::unexpected(Error{ErrorCode::RateLimited,
+										   "Request cost exceeds bucket capacity: " + path}));
+			return;
+		}
+
+		std::shared_ptr<Pending> shed;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			if (stopping) {
+				lock.unlock();
+				callback(std::unexpected(Error::network("RequestScheduler shut down")));
+				return;
+			}
+			std::deque<std::shared_ptr<Pending>>& queue = lanes[static_cast<std::size_t>(lane)];
+
+			if (lane == RequestLane::Read && method == HttpMethod::GET && config.coalesce_reads) {
+				for (const std::shared_ptr<Pending>& queued : queue) {
+					if (queued->method == HttpMethod::GET && queued->path == path) {
+						queued->callbacks.push_back(std::move(callback));
+						++counters.coalesced;
+						return;
+					}
+				}
+			}
+
+			if (lane == RequestLane::Read && !queue.empty() &&
+				queue.size() >= config.max_queued_reads) {
+				shed = std::move(queue.front());
+				queue.pop_front();
+				++counters.shed;
+			}
+
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			std::shared_ptr<Pending> pending = std::make_shared<Pending>();
+			pending->lane = lane;
+			pending->method = method;
+			pending->path = std::move(path);
+			pending->body = std::move(body);
+			pending->callbacks.push_back(std::move(callback));
+			pending->enqueued = now;
+			pending->not_before = now;
+			queue.push_back(std::move(pending));
+		}
+		cv.notify_one();
+
+		if (shed) {
+			deliver(*shed, std::unexpected(shed_error(shed->path)));
+		}
+	}
+
+	// Caller holds `mutex`. Moves reads older than `max_read_age` into
+	// `out` and returns when the next one goes stale.
+	std::optional<std::chrono::nanoseconds>
+	shed_stale_reads(std::chrono::steady_clock::time_point now,
+					 std::vector<std::shared_ptr<Pending>>& out) {
+		std::deque<std::shared_ptr<Pending>>& reads =
+			lanes[static_cast<std::size_t>(RequestLane::Read)];
+		while (!reads.empty() && now - reads.front()->enqueued >= config.max_read_age) {
+			out.push_back(std::move(reads.front()));
+			reads.pop_front();
+			++counters.shed;
+		}
+		if (reads.empty()) {
+			return std::nullopt;
+		}
+		return reads.front()->enqueued + config.max_read_age - now;
+	}
+
+	// Caller holds `mutex`. Returns the next request allowed to go, having
+	// taken its tokens. A lane head that cannot go blocks every lower lane
+	// on the same bucket; `wait` is set to when the earliest blocked head
+	// may be able to go.
+	std::shared_ptr<Pending> pick(std::chrono::steady_clock::time_point now,
+								  std::optional<std::chrono::nanoseconds>& wait) {
+		bool read_blocked = false;
+		bool write_blocked = false;
+		for (std::deque<std::shared_ptr<Pending>>& queue : lanes) {
+			if (queue.empty()) {
+				continue;
+			}
+			Pending& head = *queue.front();
+			bool& blocked = head.method == HttpMethod::GET ? read_blocked : write_blocked;
+			if (blocked) {
+				continue;
+			}
+
+			std::chrono::nanoseconds until{0};
+			const std::string_view method = to_string(head.method);
+			if (head.not_before > now) {
+				until = head.not_before - now;
+			} else if (!limiter || limiter->try_acquire(method, head.path)) {
+				std::shared_ptr<Pending> next = std::move(queue.front());
+				queue.pop_front();
+				++counters.dispatched;
+				return next;
+			} else {
+				until = limiter->bucket_for(method).time_until_available(
+					limiter->cost(method, head.path));
+			}
+
+			blocked = true;
+			wait = wait ? std::min(*wait, until) : until;
+		}
+		return nullptr;
+	}
+
+	void send(const std::shared_ptr<Pending>& pending) {
+		// With a limiter of its own the scheduler has already charged the
+		// request, so the client's limiter is skipped.
+		client->submit_async(pending->method, pending->path, pending->body,
+							 [self = shared_from_this(), pending](Result<HttpResponse> result) {
+								 self->complete(pending, std::move(result));
+							 },
+							 !limiter);
+	}
+
+	void complete(const std::shared_ptr<Pending>& pending, Result<HttpResponse> result) {
+		const bool retry = pending->attempt < config.retry.max_attempts &&
+						   (result ? should_retry(*result, config.retry)
+								   : should_retry(result.error(), config.retry));
+		if (retry) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!stopping) {
+				pending->not_before = std::chrono::steady_clock::now() +
+									  calculate_retry_delay(pending->attempt, config.retry);
+				++pending->attempt;
+				++counters.retried;
+				// complete runs on the HTTP event-loop thread, which owns
+				// the recorder's shard.
+				if (const std::shared_ptr<LatencyStats>& stats = client->latency_stats()) {
+					stats->rest(to_string(pending->method), pending->path)
+						.add(LatencyCounter::Retries);
+				}
+				lanes[static_cast<std::size_t>(pending->lane)].push_front(pending);
+				cv.notify_one();
+				return;
+			}
+		}
+		deliver(*pending, std::move(result));
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (!stopping) {
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			std::vector<std::shared_ptr<Pending>> shed;
+			std::optional<std::chrono::nanoseconds> wait = shed_stale_reads(now, shed);
+			std::shared_ptr<Pending> next = pick(now, wait);
+
+			if (next || !shed.empty()) {
+				lock.unlock();
+				for (const std::shared_ptr<Pending>& pending : shed) {
+					deliver(*pending, std::unexpected(shed_error(pending->path)));
+				}
+				if (next) {
+					send(next);
+				}
+				lock.lock();
+				continue;
+			}
+
+			if (wait) {
+				cv.wait_for(lock, std::max<std::chrono::nanoseconds>(*wait, MIN_WAIT));
+			} else {
+				cv.wait(lock);
+			}
+		}
+	}
+
+	void stop() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		cv.notify_all();
+		if (dispatcher.joinable()) {
+			dispatcher.join();
+		}
+
+		std::array<std::deque<std::shared_ptr<Pending>>, REQUEST_LANE_COUNT> drained;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			drained.swap(lanes);
+		}
+		for (std::deque<std::shared_ptr<Pending>>& queue : drained) {
+			for (const std::shared_ptr<Pending>& pending : queue) {
+				deliver(*pending, std::unexpected(Error::network("RequestScheduler shut down")));
+			}
+		}
+	}
+};
+
+RequestScheduler::RequestScheduler(HttpClient& client,
+								   std::shared_ptr<EndpointRateLimiter> limiter,
+								   SchedulerConfig config)
+	: impl_(std::make_shared<Impl>(client, std::move(limiter), std::move(config))) {
+	impl_->dispatcher = std::thread([impl = impl_.get()] { impl->run(); });
+}
+
+RequestScheduler::~RequestScheduler() {
+	if (impl_) {
+		impl_->stop();
+	}
+}
+
+RequestScheduler::RequestScheduler(RequestScheduler&&) noexcept = default;
+
+RequestScheduler& RequestScheduler::operator=(RequestScheduler&& other) noexcept {
+	if (this != &other) {
+		if (impl_) {
+			impl_->stop();
+		}
+		impl_ = std::move(other.impl_);
+	}
+	return *this;
+}
+
+void RequestScheduler::submit(HttpMethod method, std::string path, std::string body,
+							  HttpCallback callback) {
+	const RequestLane lane = default_lane(method, path);
+	submit(lane, method, std::move(path), std::move(body), std::move(callback));
+}
+
+void RequestScheduler::submit(RequestLane lane, HttpMethod method, std::string path,
+							  std::string body, HttpCallback callback) {
+	if (!impl_) {
+		callback(std::unexpected(Error::network("RequestScheduler has been moved from")));
+		return;
+	}
+	impl_->enqueue(lane, method, std::move(path), std::move(body), std::move(callback));
+}
+
+std::future<Result<HttpResponse>> RequestScheduler::submit(HttpMethod method, std::string path,
+														   std::string body) {
+	std::shared_ptr<std::promise<Result<HttpResponse>>> promise =
+		std::make_shared<std::promise<Result<HttpResponse>>>();
+	std::future<Result<HttpResponse>> future = promise->get_future();
+	submit(method, std::move(path), std::move(body),
+		   [promise](Result<HttpResponse> result) { promise->set_value(std::move(result)); });
+	return future;
+}
+
+SchedulerStats RequestScheduler::stats() const {
+	if (!impl_) {
+		return {};
+	}
+	std::lock_guard<std::mutex> lock(impl_->mutex);
+	SchedulerStats stats = impl_->counters;
+	for (std::size_t lane = 0; lane < REQUEST_LANE_COUNT; ++lane) {
+		stats.queued[lane] = impl_->lanes[lane].size();
+	}
+	return stats;
+}
+
+} // namespace kalshi
@@ -0,0 +1,220 @@
+#pragma once
+
+/// @file backpressure.hpp
+/// @brief Memory-bounded inbound message queue and fill-level watermarks.
+///
+/// ``MessageQueue`` is the queue-mode ring (``WsConfig::message_queue_capacity``)
+/// with an optional byte cap and the producer-side operations the
+/// ``WsOverflowPolicy`` values need. ``WatermarkGate`` turns queue depth and
+/// byte counts into high / low transitions for ``on_backpressure``.
+///
+/// Not installed: consumed by ``websocket.cpp`` and the unit tests.
+
+#include "kalshi/detail/spsc_ring.hpp"
+#include "kalshi/websocket.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <utility>
+#include <variant>
+
+namespace kalshi::ws_detail {
+
+/// Approximate heap and slot footprint of a queued message. Built from
+/// sizes, not capacities, so producer and consumer agree on it after the
+/// message has been moved.
+[[nodiscard]] inline std::size_t message_bytes(const WsMessage& msg) noexcept {
+	std::size_t bytes = sizeof(WsMessage);
+	std::visit([&bytes](const auto& m) { bytes += m.market_ticker.size(); }, msg);
+	if (const auto* snapshot = std::get_if<OrderbookSnapshot>(&msg)) {
+		bytes += (snapshot->yes.size() + snapshot->no.size()) * sizeof(OrderBookEntry);
+	} else if (const auto* trade = std::get_if<WsTrade>(&msg)) {
+		bytes += trade->trade_id.size();
+	} else if (const auto* fill = std::get_if<WsFill>(&msg)) {
+		bytes += fill->trade_id.size() + fill->order_id.size();
+	}
+	return bytes;
+}
+
+/// Reports a buffer filling past ``high`` of its capacity (or byte cap) and,
+/// with hysteresis, draining back below half of that. Producer thread only.
+class WatermarkGate {
+public:
+	WatermarkGate() = default;
+
+	/// ``max_bytes`` 0 watches depth alone. ``high`` is clamped to (0, 1].
+	WatermarkGate(std::size_t capacity, std::size_t max_bytes, double high) {
+		const double fraction = std::clamp(high, 0.01, 1.0);
+		high_depth_ = std::max<std::size_t>(
+			1, static_cast<std::size_t>(std::ceil(static_cast<double>(capacity) * fraction)));
+		low_depth_ = high_depth_ / 2;
+		if (max_bytes > 0) {
+			high_bytes_ = std::max<std::size_t>(
+				1, static_cast<std::size_t>(static_cast<double>(max_bytes) * fraction));
+			low_bytes_ = high_bytes_ / 2;
+		}
+	}
+
+	/// The new state when this reading crosses a mark, else nullopt
+	[[nodiscard]] std::optional<bool> update(std::size_t depth, std::size_t bytes) noexcept {
+		if (!high_ && (depth >= high_depth_ || bytes >= high_bytes_)) {
+			high_ = true;
+			return true;
+		}
+		if (high_ && depth <= low_depth_ && bytes <= low_bytes_) {
+			high_ = false;
+			return false;
+		}
+		return std::nullopt;
+	}
+
+	[[nodiscard]] bool high() const noexcept { return high_; }
+
+	void reset() noexcept { high_ = false; }
+
+private:
+	std::size_t high_depth_{std::numeric_limits<std::size_t>::max()};
+	std::size_t low_depth_{std::numeric_limits<std::size_t>::max()};
+	std::size_t high_bytes_{std::numeric_limits<std::size_t>::max()};
+	std::size_t low_bytes_{std::numeric_limits<std::size_t>::max()};
+	bool high_{false};
+};
+
+/// Queue-mode inbound ring: the service thread produces, ``poll`` consumes.
+///
+/// Full means the ring has no free slot or, with a byte cap, the message
+/// would take the queued bytes past it (an empty queue admits any one
+/// message, so an oversized one cannot wedge it). Eviction makes the
+/// producer a second consumer; it is only allowed when the queue was built
+/// ``evicting``, in which case pops take a mutex the producer shares.
+class MessageQueue {
+public:
+	MessageQueue(std::size_t capacity, std::size_t max_bytes, bool evicting)
+		: ring_(capacity), max_bytes_(max_bytes), evicting_(evicting) {}
+
+	MessageQueue(const MessageQueue&) = delete;
+	MessageQueue& operator=(const MessageQueue&) = delete;
+
+	/// Producer: queue ``msg`` if it fits; false leaves it untouched
+	[[nodiscard]] bool try_push(WsMessage&& msg) {
+		const std::size_t bytes = max_bytes_ > 0 ? message_bytes(msg) : 0;
+		if (!fits(bytes)) {
+			return false;
+		}
+		// Counted before it is visible, so a pop never takes the total
+		// below zero.
+		add_bytes(bytes);
+		if (!ring_.try_push(std::move(msg))) {
+			sub_bytes(bytes);
+			return false;
+		}
+		return true;
+	}
+
+	/// Producer: wait for room. Gives up, returning false, once ``stop``
+	/// is set.
+	[[nodiscard]] bool push_wait(WsMessage&& msg, const std::atomic<bool>& stop) {
+		while (!try_push(std::move(msg))) {
+			if (stop.load(std::memory_order_acquire)) {
+				return false;
+			}
+			std::this_thread::yield();
+		}
+		return true;
+	}
+
+	/// Producer (``evicting`` queues): discard queued messages, oldest
+	/// first, until ``msg`` fits, then queue it. Returns how many went.
+	std::size_t push_evict(WsMessage&& msg) {
+		const std::size_t bytes = max_bytes_ > 0 ? message_bytes(msg) : 0;
+		std::size_t evicted = 0;
+		{
+			std::lock_guard lock(pop_mutex_);
+			WsMessage oldest;
+			while ((!fits(bytes) || ring_.size() == ring_.capacity()) && ring_.try_pop(oldest)) {
+				sub_bytes(max_bytes_ > 0 ? message_bytes(oldest) : 0);
+				++evicted;
+			}
+		}
+		add_bytes(bytes);
+		if (!ring_.try_push(std::move(msg))) {
+			sub_bytes(bytes);
+		}
+		return evicted;
+	}
+
+	/// Producer (``evicting`` queues): discard everything queued
+	std::size_t clear() {
+		std::lock_guard lock(pop_mutex_);
+		std::size_t cleared = 0;
+		WsMessage oldest;
+		while (ring_.try_pop(oldest)) {
+			++cleared;
+		}
+		bytes_.store(0, std::memory_order_relaxed);
+		return cleared;
+	}
+
+	/// Consumer: move up to ``out.size()`` messages into ``out``, oldest first
+	[[nodiscard]] std::size_t pop_bulk(std::span<WsMessage> out) {
+		std::unique_lock<std::mutex> lock;
+		if (evicting_) {
+			lock = std::unique_lock(pop_mutex_);
+		}
+		const std::size_t n = ring_.pop_bulk(out);
+		if (max_bytes_ > 0) {
+			std::size_t bytes = 0;
+			for (std::size_t i = 0; i < n; ++i) {
+				bytes += message_bytes(out[i]);
+			}
+			sub_bytes(bytes);
+		}
+		return n;
+	}
+
+	/// Messages queued (approximate while both sides run)
+	[[nodiscard]] std::size_t size() const noexcept { return ring_.size(); }
+	[[nodiscard]] std::size_t capacity() const noexcept { return ring_.capacity(); }
+	/// ``message_bytes`` of everything queued (0 without a byte cap)
+	[[nodiscard]] std::size_t bytes() const noexcept {
+		return bytes_.load(std::memory_order_relaxed);
+	}
+	[[nodiscard]] std::size_t max_bytes() const noexcept { return max_bytes_; }
+	[[nodiscard]] bool evicting() const noexcept { return evicting_; }
+
+private:
+	[[nodiscard]] bool fits(std::size_t bytes) const noexcept {
+		if (max_bytes_ == 0) {
+			return true;
+		}
+		const std::size_t queued = bytes_.load(std::memory_order_relaxed);
+		return queued == 0 || queued + bytes <= max_bytes_;
+	}
+
+	void add_bytes(std::size_t bytes) noexcept {
+		if (bytes > 0) {
+			bytes_.fetch_add(bytes, std::memory_order_relaxed);
+		}
+	}
+
+	void sub_bytes(std::size_t bytes) noexcept {
+		if (bytes > 0) {
+			bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+		}
+	}
+
+	detail::SpscRing<WsMessage> ring_;
+	std::size_t max_bytes_;
+	bool evicting_;
+	std::mutex pop_mutex_;
+	std::atomic<std::size_t> bytes_{0};
+};
+
+} // namespace kalshi::ws_detail
@@ -0,0 +1,366 @@
+#include "kalshi/book_conflator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace kalshi {
+
+namespace {
+
+/// One market's published state behind a seqlock: ``seq`` is odd while the
+/// feeding thread writes and is bumped by 2 per update, so ``seq / 2`` is
+/// the market's version.
+struct alignas(64) Slot {
+	std::atomic<std::uint32_t> seq{0};
+	std::atomic<std::uint32_t> valid{0};
+	std::atomic<std::int32_t> yes_price{0};
+	std::atomic<std::int32_t> yes_quantity{0};
+	std::atomic<std::int32_t> no_price{0};
+	std::atomic<std::int32_t> no_quantity{0};
+	std::atomic<std::int32_t> last_seq{0};
+	std::atomic<std::int32_t> trade_price{0};
+	std::atomic<std::int32_t> trade_quantity{0};
+	std::atomic<std::int64_t> updated_ns{0};
+};
+
+static_assert(sizeof(Slot) == 64);
+
+std::int64_t now_ns() noexcept {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			   std::chrono::system_clock::now().time_since_epoch())
+		.count();
+}
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__)
+	asm volatile("yield");
+#endif
+}
+
+/// Single-writer counter bump: a load and a store, no locked instruction
+inline void bump(std::atomic<std::uint64_t>& counter) noexcept {
+	counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+struct BookConflator::Impl {
+	BookConflatorConfig config;
+
+	// Feeding thread only. Books grow on first use up to max_markets.
+	std::vector<OrderBookBook> books;
+	std::vector<std::int32_t> book_sid;
+
+	// Written by the feeding thread, read by consumers.
+	std::unique_ptr<Slot[]> slots;
+	std::vector<std::atomic<std::uint64_t>> dirty; ///< Bit per market
+	std::atomic<std::uint64_t> updates{0};
+	std::atomic<std::uint64_t> ignored{0};
+	std::atomic<std::uint64_t> delivered{0};
+
+	// Consumers, under consumer_mutex: the version each market was last
+	// delivered at, and the dirty word the next drain starts from so a
+	// small ``out`` still reaches every market in turn.
+	std::mutex consumer_mutex;
+	std::vector<std::uint32_t> delivered_seq;
+	std::size_t next_word{0};
+
+	// Interval delivery.
+	std::mutex callback_mutex;
+	ConflatedCallback callback;
+	std::vector<ConflatedUpdate> batch;
+	std::mutex wake_mutex;
+	std::condition_variable wake;
+	bool stopping{false};
+	std::thread deliverer;
+
+	explicit Impl(BookConflatorConfig c)
+		: config(c), slots(std::make_unique<Slot[]>(c.max_markets)),
+		  dirty((c.max_markets + 63) / 64), delivered_seq(c.max_markets, 0) {
+		if (config.interval.count() > 0) {
+			deliverer = std::thread([this] { run(); });
+		}
+	}
+
+	~Impl() {
+		if (deliverer.joinable()) {
+			{
+				std::lock_guard lock(wake_mutex);
+				stopping = true;
+			}
+			wake.notify_one();
+			deliverer.join();
+		}
+	}
+
+	Impl(const Impl&) = delete;
+	Impl& operator=(const Impl&) = delete;
+
+	/// Book for ``id``, grown on first use; null past ``max_markets``
+	OrderBookBook* book(TickerId id) {
+		if (!id.valid() || id.value >= config.max_markets) {
+			bump(ignored);
+			return nullptr;
+		}
+		if (id.value >= books.size()) {
+			books.resize(static_cast<std::size_t>(id.value) + 1,
+						 OrderBookBook{SeqCheck::Monotonic});
+			book_sid.resize(books.size(), 0);
+		}
+		return &books[id.value];
+	}
+
+	// ===== Feeding thread =====
+
+	template <typename Write>
+	void publish(TickerId id, Write&& write) noexcept {
+		Slot& slot = slots[id.value];
+		const std::uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+		slot.seq.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		write(slot);
+		slot.updated_ns.store(now_ns(), std::memory_order_relaxed);
+		slot.seq.store(seq + 2, std::memory_order_release);
+		// Always the RMW: a plain "already set?" load could miss a drain
+		// clearing the bit, and the drain could miss this update.
+		dirty[id.value / 64].fetch_or(std::uint64_t{1} << (id.value % 64),
+									  std::memory_order_release);
+		bump(updates);
+	}
+
+	void publish_book(TickerId id, const OrderBookBook& b) noexcept {
+		const std::optional<OrderBookEntry> yes = b.best_bid(Side::Yes);
+		const std::optional<OrderBookEntry> no = b.best_bid(Side::No);
+		publish(id, [&](Slot& slot) {
+			slot.valid.store(b.valid() ? 1 : 0, std::memory_order_relaxed);
+			slot.yes_price.store(yes ? yes->price_cents : 0, std::memory_order_relaxed);
+			slot.yes_quantity.store(yes ? yes->quantity : 0, std::memory_order_relaxed);
+			slot.no_price.store(no ? no->price_cents : 0, std::memory_order_relaxed);
+			slot.no_quantity.store(no ? no->quantity : 0, std::memory_order_relaxed);
+			slot.last_seq.store(b.last_seq(), std::memory_order_relaxed);
+		});
+	}
+
+	void publish_trade(TickerId id, std::int32_t yes_price, std::int32_t count) noexcept {
+		if (!id.valid() || id.value >= config.max_markets) {
+			bump(ignored);
+			return;
+		}
+		publish(id, [&](Slot& slot) {
+			slot.trade_price.store(yes_price, std::memory_order_relaxed);
+			slot.trade_quantity.store(count, std::memory_order_relaxed);
+		});
+	}
+
+	void apply_delta(const OrderbookDelta& delta) {
+		if (OrderBookBook* b = book(delta.ticker_id)) {
+			const BookUpdate result = b->apply(delta);
+			if (result == BookUpdate::Applied || result == BookUpdate::Gap) {
+				publish_book(delta.ticker_id, *b);
+			}
+		}
+	}
+
+	// ===== Consumers =====
+
+	/// Consistent copy of ``id``'s slot; false before its first update
+	bool read(std::uint32_t id, ConflatedUpdate& out, std::uint32_t& version) const noexcept {
+		const Slot& slot = slots[id];
+		for (;;) {
+			const std::uint32_t before = slot.seq.load(std::memory_order_acquire);
+			if (before == 0) {
+				return false;
+			}
+			if ((before & 1U) != 0) {
+				cpu_relax();
+				continue;
+			}
+			out.top.ticker_id = TickerId{id};
+			out.top.valid = slot.valid.load(std::memory_order_relaxed) != 0;
+			out.top.yes_bid = {slot.yes_price.load(std::memory_order_relaxed),
+							   slot.yes_quantity.load(std::memory_order_relaxed)};
+			out.top.no_bid = {slot.no_price.load(std::memory_order_relaxed),
+							  slot.no_quantity.load(std::memory_order_relaxed)};
+			out.top.seq = slot.last_seq.load(std::memory_order_relaxed);
+			out.top.updated_ns = slot.updated_ns.load(std::memory_order_relaxed);
+			out.last_trade = {slot.trade_price.load(std::memory_order_relaxed),
+							  slot.trade_quantity.load(std::memory_order_relaxed)};
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.seq.load(std::memory_order_relaxed) == before) {
+				version = before / 2;
+				out.top.version = version;
+				return true;
+			}
+		}
+	}
+
+	std::size_t drain(std::span<ConflatedUpdate> out) {
+		std::lock_guard lock(consumer_mutex);
+		const std::size_t words = dirty.size();
+		std::size_t n = 0;
+		if (words == 0) {
+			return 0;
+		}
+		for (std::size_t k = 0; k < words && n < out.size(); ++k) {
+			const std::size_t w = (next_word + k) % words;
+			std::uint64_t bits = dirty[w].exchange(0, std::memory_order_acquire);
+			while (bits != 0 && n < out.size()) {
+				const std::uint32_t id =
+					static_cast<std::uint32_t>(w * 64 + std::countr_zero(bits));
+				bits &= bits - 1;
+				std::uint32_t version = 0;
+				// A bit set just after this drain read the slot can name a
+				// version already delivered; skip it.
+				if (read(id, out[n], version) && version != delivered_seq[id]) {
+					out[n].merged = version - delivered_seq[id];
+					delivered_seq[id] = version;
+					++n;
+				}
+			}
+			if (bits != 0) {
+				dirty[w].fetch_or(bits, std::memory_order_relaxed);
+				next_word = w;
+			} else {
+				next_word = (w + 1) % words;
+			}
+		}
+		delivered.fetch_add(n, std::memory_order_relaxed);
+		return n;
+	}
+
+	void run() {
+		std::unique_lock wake_lock(wake_mutex);
+		while (!wake.wait_for(wake_lock, config.interval, [this] { return stopping; })) {
+			wake_lock.unlock();
+			{
+				std::lock_guard lock(callback_mutex);
+				if (callback) {
+					if (batch.empty()) {
+						batch.resize(std::min<std::size_t>(config.max_markets, 1024));
+					}
+					for (;;) {
+						const std::size_t n = drain(batch);
+						if (n > 0) {
+							callback(std::span<const ConflatedUpdate>(batch.data(), n));
+						}
+						if (n < batch.size()) {
+							break;
+						}
+					}
+				}
+			}
+			wake_lock.lock();
+		}
+	}
+};
+
+BookConflator::BookConflator(BookConflatorConfig config)
+	: impl_(std::make_unique<Impl>(config)) {}
+
+BookConflator::~BookConflator() = default;
+
+BookConflator::BookConflator(BookConflator&&) noexcept = default;
+
+BookConflator& BookConflator::operator=(BookConflator&&) noexcept = default;
+
+void BookConflator::apply(const WsMessage& message) {
+	if (!impl_) {
+		return;
+	}
+	std::visit(
+		[this](const auto& m) {
+			using T = std::decay_t<decltype(m)>;
+			if constexpr (std::is_same_v<T, OrderbookSnapshot>) {
+				if (OrderBookBook* b = impl_->book(m.ticker_id)) {
+					b->apply(m);
+					impl_->book_sid[m.ticker_id.value] = m.sid;
+					impl_->publish_book(m.ticker_id, *b);
+				}
+			} else if constexpr (std::is_same_v<T, OrderbookDelta>) {
+				impl_->apply_delta(m);
+			} else if constexpr (std::is_same_v<T, WsTrade>) {
+				impl_->publish_trade(m.ticker_id, m.yes_price, m.count);
+			}
+		},
+		message);
+}
+
+void BookConflator::apply(const WsEvent& event) {
+	if (!impl_) {
+		return;
+	}
+	if (event.kind == WsEventKind::Delta) {
+		OrderbookDelta delta;
+		delta.sid = event.sid;
+		delta.seq = event.seq;
+		delta.price = event.price;
+		delta.delta = event.quantity;
+		delta.side = event.side;
+		delta.ticker_id = event.ticker_id;
+		impl_->apply_delta(delta);
+	} else if (event.kind == WsEventKind::Trade) {
+		impl_->publish_trade(event.ticker_id, event.price, event.quantity);
+	}
+}
+
+void BookConflator::apply(const WsSeqGap& gap) {
+	if (!impl_) {
+		return;
+	}
+	for (std::size_t i = 0; i < impl_->books.size(); ++i) {
+		if (impl_->book_sid[i] == gap.sid && impl_->books[i].valid()) {
+			impl_->books[i].clear();
+			impl_->publish_book(TickerId{static_cast<std::uint32_t>(i)}, impl_->books[i]);
+		}
+	}
+}
+
+std::size_t BookConflator::drain(std::span<ConflatedUpdate> out) {
+	return impl_ ? impl_->drain(out) : 0;
+}
+
+void BookConflator::on_update(ConflatedCallback callback) {
+	if (!impl_) {
+		return;
+	}
+	std::lock_guard lock(impl_->callback_mutex);
+	impl_->callback = std::move(callback);
+}
+
+std::optional<ConflatedUpdate> BookConflator::latest(TickerId id) const {
+	if (!impl_ || !id.valid() || id.value >= impl_->config.max_markets) {
+		return std::nullopt;
+	}
+	ConflatedUpdate update;
+	std::uint32_t version = 0;
+	if (!impl_->read(id.value, update, version)) {
+		return std::nullopt;
+	}
+	// Updates pending since the last delivery.
+	std::lock_guard lock(impl_->consumer_mutex);
+	update.merged = version - impl_->delivered_seq[id.value];
+	return update;
+}
+
+BookConflatorStats BookConflator::stats() const noexcept {
+	if (!impl_) {
+		return {};
+	}
+	return {
+		.updates = impl_->updates.load(std::memory_order_relaxed),
+		.delivered = impl_->delivered.load(std::memory_order_relaxed),
+		.ignored = impl_->ignored.load(std::memory_order_relaxed),
+	};
+}
+
+} // namespace kalshi
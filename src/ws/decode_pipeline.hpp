@@ -0,0 +1,312 @@
+#pragma once
+
+/// @file decode_pipeline.hpp
+/// @brief Worker threads that decode and dispatch frames off the service thread.
+///
+/// With ``WsConfig::decode_workers`` set, the service thread only
+/// reassembles frames, peeks their routing fields and copies each one
+/// into a worker's SPSC ring, picked by the frame's market. A market
+/// always maps to the same worker and each ring is FIFO, so one market's
+/// frames are decoded and delivered in stream order while different
+/// markets are decoded in parallel.
+///
+/// Frame buffers circulate: a worker hands every finished buffer back on
+/// a second ring and the producer copies the next frame into it, so the
+/// steady state reuses capacity and never allocates.
+///
+/// A push that finds its ring full, or the byte cap reached, waits,
+/// rejects the frame or evicts the ring's oldest frames (``Overflow``).
+/// Eviction needs the pipeline built ``evicting``: workers then pop under
+/// a per-worker mutex the producer takes to evict. ``flush`` discards
+/// everything queued without waiting for the workers.
+///
+/// Not installed: consumed by ``websocket.cpp`` and the unit tests.
+
+#include "kalshi/detail/spsc_ring.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace kalshi::ws_detail {
+
+/// One frame in flight to a worker.
+struct PipelineFrame {
+	std::string bytes;
+	/// When the service thread finished reassembling it
+	std::chrono::steady_clock::time_point received{};
+	/// Wall-clock receive time for the recorder (0 when not recording)
+	std::uint64_t recv_ns{0};
+	/// ``flush`` count when it was pushed; older frames are skipped
+	std::uint64_t generation{0};
+};
+
+/// Counters since construction.
+struct DecodePipelineStats {
+	std::uint64_t frames{0};  ///< Frames handed to workers
+	std::uint64_t stalls{0};  ///< Pushes that found their ring full and had to wait
+	std::uint64_t dropped{0}; ///< Frames rejected because there was no room
+	std::uint64_t evicted{0}; ///< Queued frames discarded to make room
+	std::uint64_t flushed{0}; ///< Queued frames discarded by ``flush``
+};
+
+class DecodePipeline {
+public:
+	/// Runs on worker ``worker`` for each of its frames, in push order.
+	using Handler = std::function<void(std::size_t worker, PipelineFrame& frame)>;
+
+	/// What ``push`` does when there is no room
+	enum class Overflow : std::uint8_t {
+		Wait,		 ///< Until the worker catches up
+		Reject,		 ///< Discard the new frame
+		EvictOldest, ///< Discard the worker's oldest frames (``evicting`` only)
+	};
+
+	/// Buffers larger than this are freed after use rather than recycled,
+	/// so one huge snapshot does not pin its size in every slot.
+	static constexpr std::size_t kMaxRetainedBytes = 64 * 1024;
+
+	/// ``max_bytes`` caps the frame bytes queued across every worker (0
+	/// leaves only the ring capacity).
+	DecodePipeline(std::size_t workers, std::size_t ring_capacity, std::size_t max_bytes = 0,
+				   bool evicting = false)
+		: max_bytes_(max_bytes), evicting_(evicting) {
+		workers_.reserve(workers);
+		for (std::size_t i = 0; i < workers; ++i) {
+			workers_.push_back(std::make_unique<Worker>(ring_capacity));
+		}
+	}
+
+	~DecodePipeline() { stop(); }
+
+	DecodePipeline(const DecodePipeline&) = delete;
+	DecodePipeline& operator=(const DecodePipeline&) = delete;
+
+	[[nodiscard]] std::size_t workers() const noexcept { return workers_.size(); }
+
+	/// Start one thread per worker. Not thread-safe against ``push`` or
+	/// ``stop``; call from the thread that owns the pipeline.
+	void start(Handler handler) {
+		stop();
+		handler_ = std::move(handler);
+		stopping_.store(false, std::memory_order_relaxed);
+		for (std::size_t i = 0; i < workers_.size(); ++i) {
+			workers_[i]->thread = std::thread([this, i] { run(i); });
+		}
+	}
+
+	/// Let every worker finish what is queued, then join them. The
+	/// producer must have stopped pushing.
+	void stop() {
+		stopping_.store(true, std::memory_order_release);
+		for (const std::unique_ptr<Worker>& worker : workers_) {
+			if (worker->thread.joinable()) {
+				worker->published.fetch_add(1, std::memory_order_release);
+				worker->published.notify_one();
+				worker->thread.join();
+			}
+		}
+	}
+
+	/// Producer (one thread): copy ``frame`` to the worker owning ``key``.
+	/// By default a full ring is waited out, not dropped, because a lost
+	/// delta would corrupt that market's book; the wait ends early only on
+	/// ``stop``, in which case the frame is discarded and false returned.
+	/// Other ``overflow`` modes return false when the frame was dropped.
+	bool push(std::uint32_t key, std::string_view frame,
+			  std::chrono::steady_clock::time_point received, std::uint64_t recv_ns,
+			  Overflow overflow = Overflow::Wait) {
+		Worker& worker = *workers_[key % workers_.size()];
+		if (!has_room(worker, frame.size())) {
+			switch (overflow) {
+				case Overflow::Wait:
+					stalls_.fetch_add(1, std::memory_order_relaxed);
+					do {
+						if (stopping_.load(std::memory_order_acquire)) {
+							return false;
+						}
+						std::this_thread::yield();
+					} while (!has_room(worker, frame.size()));
+					break;
+				case Overflow::Reject:
+					dropped_.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				case Overflow::EvictOldest:
+					if (!evict(worker, frame.size())) {
+						dropped_.fetch_add(1, std::memory_order_relaxed);
+						return false;
+					}
+					break;
+			}
+		}
+		PipelineFrame item;
+		if (worker.spare.try_pop(item.bytes)) {
+			item.bytes.assign(frame);
+		} else {
+			item.bytes = std::string(frame);
+		}
+		item.received = received;
+		item.recv_ns = recv_ns;
+		item.generation = generation_.load(std::memory_order_relaxed);
+		add_bytes(frame.size());
+		// Only this thread adds, so the room found above is still there.
+		if (!worker.frames.try_push(std::move(item))) {
+			sub_bytes(frame.size());
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		frames_.fetch_add(1, std::memory_order_relaxed);
+		worker.published.fetch_add(1, std::memory_order_release);
+		worker.published.notify_one();
+		return true;
+	}
+
+	/// Producer: discard every queued frame. Workers skip them (no decode,
+	/// no handler) as they reach them, so memory frees at their pace
+	/// without the producer waiting.
+	void flush() noexcept { generation_.fetch_add(1, std::memory_order_release); }
+
+	/// Frames queued across all workers (approximate).
+	[[nodiscard]] std::size_t depth() const noexcept {
+		std::size_t total = 0;
+		for (const std::unique_ptr<Worker>& worker : workers_) {
+			total += worker->frames.size();
+		}
+		return total;
+	}
+
+	/// Frame bytes queued across all workers (0 without a byte cap)
+	[[nodiscard]] std::size_t bytes() const noexcept {
+		return bytes_.load(std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] std::size_t capacity() const noexcept {
+		return workers_.empty() ? 0 : workers_.size() * workers_.front()->frames.capacity();
+	}
+
+	[[nodiscard]] std::size_t max_bytes() const noexcept { return max_bytes_; }
+
+	[[nodiscard]] DecodePipelineStats stats() const noexcept {
+		return {.frames = frames_.load(std::memory_order_relaxed),
+				.stalls = stalls_.load(std::memory_order_relaxed),
+				.dropped = dropped_.load(std::memory_order_relaxed),
+				.evicted = evicted_.load(std::memory_order_relaxed),
+				.flushed = flushed_.load(std::memory_order_relaxed)};
+	}
+
+private:
+	struct Worker {
+		explicit Worker(std::size_t capacity) : frames(capacity), spare(capacity) {}
+
+		detail::SpscRing<PipelineFrame> frames; ///< Producer -> worker
+		detail::SpscRing<std::string> spare;	///< Worker -> producer, emptied buffers
+		/// Serializes the worker's pops with producer evictions
+		/// (``evicting`` pipelines only)
+		std::mutex pop_mutex;
+		/// Bumped after every push (and by ``stop``); an idle worker
+		/// sleeps on it.
+		std::atomic<std::uint64_t> published{0};
+		std::thread thread;
+	};
+
+	// Producer side: the ring has a free slot and, with a byte cap, the
+	// frame fits under it (an empty pipeline admits any one frame).
+	[[nodiscard]] bool has_room(const Worker& worker, std::size_t size) const noexcept {
+		if (worker.frames.size() >= worker.frames.capacity()) {
+			return false;
+		}
+		if (max_bytes_ == 0) {
+			return true;
+		}
+		const std::size_t queued = bytes_.load(std::memory_order_relaxed);
+		return queued == 0 || queued + size <= max_bytes_;
+	}
+
+	// Producer side: pop `worker`'s oldest frames until `size` more fits.
+	// False when it still does not (the bytes are queued on other workers).
+	bool evict(Worker& worker, std::size_t size) {
+		if (!evicting_) {
+			return false;
+		}
+		std::lock_guard lock(worker.pop_mutex);
+		PipelineFrame oldest;
+		while (!has_room(worker, size) && worker.frames.try_pop(oldest)) {
+			sub_bytes(oldest.bytes.size());
+			evicted_.fetch_add(1, std::memory_order_relaxed);
+		}
+		return has_room(worker, size);
+	}
+
+	bool pop(Worker& worker, PipelineFrame& frame) {
+		if (!evicting_) {
+			return worker.frames.try_pop(frame);
+		}
+		std::lock_guard lock(worker.pop_mutex);
+		return worker.frames.try_pop(frame);
+	}
+
+	void add_bytes(std::size_t size) noexcept {
+		if (max_bytes_ > 0) {
+			bytes_.fetch_add(size, std::memory_order_relaxed);
+		}
+	}
+
+	void sub_bytes(std::size_t size) noexcept {
+		if (max_bytes_ > 0) {
+			bytes_.fetch_sub(size, std::memory_order_relaxed);
+		}
+	}
+
+	void run(std::size_t index) {
+		Worker& worker = *workers_[index];
+		PipelineFrame frame;
+		for (;;) {
+			// Read the counter before draining, so a push that lands after
+			// the last pop changes it and the wait below returns at once.
+			const std::uint64_t seen = worker.published.load(std::memory_order_acquire);
+			while (pop(worker, frame)) {
+				if (frame.generation == generation_.load(std::memory_order_acquire)) {
+					handler_(index, frame);
+				} else {
+					flushed_.fetch_add(1, std::memory_order_relaxed);
+				}
+				// Released after the handler: a frame holds its bytes until
+				// it has been delivered.
+				sub_bytes(frame.bytes.size());
+				if (frame.bytes.capacity() <= kMaxRetainedBytes) {
+					frame.bytes.clear();
+					(void)worker.spare.try_push(std::move(frame.bytes));
+				}
+				frame.bytes = std::string();
+			}
+			if (stopping_.load(std::memory_order_acquire)) {
+				return;
+			}
+			worker.published.wait(seen, std::memory_order_acquire);
+		}
+	}
+
+	std::vector<std::unique_ptr<Worker>> workers_;
+	Handler handler_;
+	std::size_t max_bytes_;
+	bool evicting_;
+	std::atomic<bool> stopping_{false};
+	std::atomic<std::uint64_t> generation_{0};
+	std::atomic<std::size_t> bytes_{0};
+	std::atomic<std::uint64_t> frames_{0};
+	std::atomic<std::uint64_t> stalls_{0};
+	std::atomic<std::uint64_t> dropped_{0};
+	std::atomic<std::uint64_t> evicted_{0};
+	std::atomic<std::uint64_t> flushed_{0};
+};
+
+} // namespace kalshi::ws_detail
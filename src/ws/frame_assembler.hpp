@@ -0,0 +1,95 @@
+#pragma once
+
+/// @file frame_assembler.hpp
+/// @brief Zero-copy reassembly of inbound WebSocket messages.
+///
+/// libwebsockets hands ``LWS_CALLBACK_CLIENT_RECEIVE`` one chunk at a
+/// time. Almost every Kalshi frame arrives as a single chunk, which is
+/// passed straight through as a view of lws's own buffer. Only messages
+/// split over several chunks (continuation frames, or payloads larger than
+/// the rx buffer) are copied, into a buffer that keeps its capacity so
+/// steady state never reallocates. With a size limit, a longer message is
+/// discarded as it arrives instead of growing the buffer.
+///
+/// Not installed: consumed by ``websocket.cpp`` and the unit tests.
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace kalshi::ws_detail {
+
+/// Per-connection message reassembler. Service thread only.
+class FrameAssembler {
+public:
+	FrameAssembler() = default;
+
+	/// Messages longer than ``max_bytes`` are discarded (0: no limit)
+	explicit FrameAssembler(std::size_t max_bytes) : max_bytes_(max_bytes) {}
+
+	/// Feed one received chunk. ``first`` / ``final`` say whether it starts
+	/// and completes a message. Calls ``on_frame(std::string_view)`` once
+	/// per complete message; the view is valid only during the call.
+	/// Returns false for the chunk that takes a message past the size
+	/// limit; the rest of that message is skipped.
+	template <typename OnFrame>
+	bool feed(std::string_view chunk, bool first, bool final, OnFrame&& on_frame) {
+		if (first) {
+			// A new message abandons any half-assembled one (its tail was
+			// lost with the previous connection).
+			buffer_.clear();
+			assembling_ = false;
+			discarding_ = false;
+		}
+		if (discarding_) {
+			discarding_ = !final;
+			return true;
+		}
+		if (max_bytes_ > 0 && buffer_.size() + chunk.size() > max_bytes_) {
+			buffer_.clear();
+			assembling_ = false;
+			discarding_ = !final;
+			++oversized_;
+			return false;
+		}
+		if (final && !assembling_) {
+			on_frame(chunk);
+			return true;
+		}
+		buffer_.append(chunk);
+		assembling_ = true;
+		if (final) {
+			on_frame(std::string_view{buffer_});
+			buffer_.clear();
+			assembling_ = false;
+			++reassembled_;
+		}
+		return true;
+	}
+
+	/// Drop any partial message (connection closed or reset).
+	void reset() noexcept {
+		buffer_.clear();
+		assembling_ = false;
+		discarding_ = false;
+	}
+
+	/// Messages that needed copying since construction.
+	[[nodiscard]] std::size_t reassembled() const noexcept { return reassembled_; }
+
+	/// Messages discarded for exceeding the size limit since construction.
+	[[nodiscard]] std::size_t oversized() const noexcept { return oversized_; }
+
+	/// Reserved bytes in the reassembly buffer.
+	[[nodiscard]] std::size_t capacity() const noexcept { return buffer_.capacity(); }
+
+private:
+	std::string buffer_;
+	std::size_t max_bytes_{0};
+	bool assembling_{false};
+	bool discarding_{false};
+	std::size_t reassembled_{0};
+	std::size_t oversized_{0};
+};
+
+} // namespace kalshi::ws_detail
@@ -0,0 +1,498 @@
+#include "kalshi/detail/ws_json.hpp"
+
+#include "frame_decoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace kalshi::ws_detail {
+
+namespace {
+
+// Every key the decoder understands. Order is irrelevant except that
+// `Count` must stay last.
+enum class Field : std::uint8_t {
+	Type,
+	Id,
+	Sid,
+	Seq,
+	Msg,
+	Code,
+	Message,
+	MarketTicker,
+	PriceDollars,
+	DeltaFp,
+	Side,
+	TradeId,
+	OrderId,
+	YesPriceDollars,
+	NoPriceDollars,
+	CountFp,
+	TakerSide,
+	Ts,
+	IsTaker,
+	Action,
+	OpenTs,
+	CloseTs,
+	DeterminationTs,
+	SettledTs,
+	Result,
+	IsDeactivated,
+	YesSubTitle,
+	Yes,
+	No,
+	Count,
+};
+
+constexpr std::size_t kFieldCount = static_cast<std::size_t>(Field::Count);
+
+struct FieldName {
+	std::string_view name;
+	Field field;
+};
+
+constexpr std::array<FieldName, kFieldCount> kFieldNames{{
+	{"type", Field::Type},
+	{"id", Field::Id},
+	{"sid", Field::Sid},
+	{"seq", Field::Seq},
+	{"msg", Field::Msg},
+	{"code", Field::Code},
+	{"message", Field::Message},
+	{"market_ticker", Field::MarketTicker},
+	{"price_dollars", Field::PriceDollars},
+	{"delta_fp", Field::DeltaFp},
+	{"side", Field::Side},
+	{"trade_id", Field::TradeId},
+	{"order_id", Field::OrderId},
+	{"yes_price_dollars", Field::YesPriceDollars},
+	{"no_price_dollars", Field::NoPriceDollars},
+	{"count_fp", Field::CountFp},
+	{"taker_side", Field::TakerSide},
+	{"ts", Field::Ts},
+	{"is_taker", Field::IsTaker},
+	{"action", Field::Action},
+	{"open_ts", Field::OpenTs},
+	{"close_ts", Field::CloseTs},
+	{"determination_ts", Field::DeterminationTs},
+	{"settled_ts", Field::SettledTs},
+	{"result", Field::Result},
+	{"is_deactivated", Field::IsDeactivated},
+	{"yes_sub_title", Field::YesSubTitle},
+	{"yes", Field::Yes},
+	{"no", Field::No},
+}};
+
+static_assert(kFieldCount <= 64, "FieldSlots::present is a 64-bit mask");
+
+// Nesting guard: Kalshi frames are at most two objects deep. Anything
+// deeper is skipped, not recursed into, so a hostile frame cannot blow
+// the lws service thread's stack.
+constexpr int kMaxDepth = 8;
+
+// Value slices for one frame. String values are stored without their
+// quotes; scalars (numbers, true/false/null) verbatim; the `yes` / `no`
+// orderbook arrays from `[` through the matching `]`.
+struct FieldSlots {
+	std::array<std::string_view, kFieldCount> values{};
+	std::uint64_t present{0};
+
+	[[nodiscard]] bool has(Field f) const {
+		return (present >> static_cast<std::size_t>(f)) & 1U;
+	}
+	[[nodiscard]] std::string_view get(Field f) const {
+		return values[static_cast<std::size_t>(f)];
+	}
+	void set(Field f, std::string_view v) {
+		if (has(f)) {
+			return; // first occurrence wins
+		}
+		values[static_cast<std::size_t>(f)] = v;
+		present |= std::uint64_t{1} << static_cast<std::size_t>(f);
+	}
+};
+
+// Sentinel for keys the decoder does not care about.
+constexpr Field kUnknownField = Field::Count;
+
+Field classify_key(std::string_view key) {
+	for (const FieldName& entry : kFieldNames) {
+		if (entry.name.size() == key.size() && entry.name == key) {
+			return entry.field;
+		}
+	}
+	return kUnknownField;
+}
+
+class FrameScanner {
+public:
+	// A non-zero `stop_when` ends the scan as soon as every field in that
+	// mask has been seen; the slots it holds are the same a full scan
+	// would record, since the first occurrence wins either way.
+	explicit FrameScanner(std::string_view frame, std::uint64_t stop_when = 0)
+		: s_(frame), stop_when_(stop_when) {}
+
+	FieldSlots scan() {
+		skip_ws();
+		if (pos_ < s_.size() && s_[pos_] == '{') {
+			scan_object(0);
+		}
+		return std::move(slots_);
+	}
+
+private:
+	std::string_view s_;
+	std::size_t pos_{0};
+	std::uint64_t stop_when_{0};
+	FieldSlots slots_;
+
+	[[nodiscard]] bool done() const {
+		return stop_when_ != 0 && (slots_.present & stop_when_) == stop_when_;
+	}
+
+	void skip_ws() {
+		while (pos_ < s_.size() &&
+			   (s_[pos_] == ' ' || s_[pos_] == '\t' || s_[pos_] == '\n' || s_[pos_] == '\r'))
+			pos_++;
+	}
+
+	// Positioned on an opening quote; returns the unquoted contents and
+	// leaves pos_ after the closing quote. Escapes are skipped over (so
+	// an embedded \" does not end the string) but not decoded.
+	std::string_view scan_string() {
+		const std::size_t start = pos_ + 1; // past the opening '"'
+		const std::size_t after = detail::skip_json_string(s_, start);
+		if (after == std::string_view::npos) {
+			pos_ = s_.size();
+			return s_.substr(start);
+		}
+		pos_ = after;
+		return s_.substr(start, after - 1 - start);
+	}
+
+	// Positioned on '[' or '{'; advances past the matching closer,
+	// stepping over strings so brackets inside them do not count.
+	std::string_view skip_container() {
+		const std::size_t start = pos_;
+		int depth = 0;
+		while (pos_ < s_.size()) {
+			const char c = s_[pos_];
+			if (c == '"') {
+				scan_string();
+				continue;
+			}
+			pos_++;
+			if (c == '[' || c == '{') {
+				depth++;
+			} else if (c == ']' || c == '}') {
+				if (--depth == 0)
+					break;
+			}
+		}
+		return s_.substr(start, pos_ - start);
+	}
+
+	std::string_view scan_scalar() {
+		const std::size_t start = pos_;
+		while (pos_ < s_.size() && s_[pos_] != ',' && s_[pos_] != '}' && s_[pos_] != ']' &&
+			   s_[pos_] != ' ' && s_[pos_] != '\t' && s_[pos_] != '\n' && s_[pos_] != '\r')
+			pos_++;
+		return s_.substr(start, pos_ - start);
+	}
+
+	// Positioned on '{'. Records every known key's value slice and
+	// returns with pos_ after the matching '}' (or at end of input).
+	void scan_object(int depth) {
+		pos_++; // '{'
+		while (!done()) {
+			skip_ws();
+			if (pos_ >= s_.size())
+				return;
+			if (s_[pos_] == '}') {
+				pos_++;
+				return;
+			}
+			if (s_[pos_] == ',') {
+				pos_++;
+				continue;
+			}
+			if (s_[pos_] != '"')
+				return; // malformed — keep what we have
+			const Field field = classify_key(scan_string());
+			skip_ws();
+			if (pos_ >= s_.size() || s_[pos_] != ':')
+				return;
+			pos_++;
+			skip_ws();
+			if (pos_ >= s_.size())
+				return;
+
+			const char c = s_[pos_];
+			if (c == '"') {
+				const std::string_view value = scan_string();
+				if (field != kUnknownField)
+					slots_.set(field, value);
+			} else if (c == '{') {
+				if (field != kUnknownField)
+					slots_.set(field, std::string_view{});
+				if (depth + 1 < kMaxDepth) {
+					scan_object(depth + 1);
+				} else {
+					skip_container();
+				}
+			} else if (c == '[') {
+				const std::string_view value = skip_container();
+				if (field == Field::Yes || field == Field::No)
+					slots_.set(field, value);
+			} else {
+				const std::string_view value = scan_scalar();
+				if (field != kUnknownField)
+					slots_.set(field, value);
+			}
+		}
+	}
+};
+
+std::string to_owned(std::string_view v) {
+	return std::string(v);
+}
+
+// Fill `market_ticker` / `ticker_id` per the decode options.
+template <typename Msg>
+void set_ticker(Msg& msg, std::string_view ticker, const DecodeOptions& options) {
+	if (options.ticker_strings) {
+		msg.market_ticker = to_owned(ticker);
+	}
+	if (options.tickers) {
+		msg.ticker_id = options.tickers->intern(ticker);
+	}
+}
+
+Side parse_wire_side(std::string_view v) {
+	return v == "yes" ? Side::Yes : Side::No;
+}
+
+// Accepts both the JSON literal (`true`) and the string form (`"true"`).
+bool parse_wire_bool(std::string_view v) {
+	return v == "true";
+}
+
+void append_book_side(std::string_view array, std::vector<OrderBookEntry>& out) {
+	detail::for_each_orderbook_entry(array, [&](std::int32_t price, std::int32_t qty) {
+		out.push_back(OrderBookEntry{price, qty});
+	});
+}
+
+std::vector<OrderBookEntry> parse_book_side(std::string_view array) {
+	std::vector<OrderBookEntry> entries;
+	append_book_side(array, entries);
+	return entries;
+}
+
+TickerId intern_ticker(std::string_view ticker, const DecodeOptions& options) {
+	return options.tickers != nullptr ? options.tickers->intern(ticker) : TickerId{};
+}
+
+std::int16_t cents16(std::string_view dollars) {
+	const std::int32_t cents = detail::parse_dollar_cents(dollars);
+	return static_cast<std::int16_t>(std::clamp<std::int32_t>(cents, INT16_MIN, INT16_MAX));
+}
+
+// Compact decode of the three high-rate kinds; no allocation beyond the
+// first sight of a ticker. Returns false for any other type.
+bool decode_event(std::string_view type, const FieldSlots& f, const DecodeOptions& options,
+				  WsEvent& ev) {
+	if (type == "orderbook_delta") {
+		ev.kind = WsEventKind::Delta;
+		ev.seq = detail::parse_int_value(f.get(Field::Seq));
+		ev.price = cents16(f.get(Field::PriceDollars));
+		ev.quantity = detail::parse_fp_int(f.get(Field::DeltaFp));
+		ev.side = parse_wire_side(f.get(Field::Side));
+	} else if (type == "trade") {
+		ev.kind = WsEventKind::Trade;
+		ev.trade_id = Uuid::parse(f.get(Field::TradeId)).value_or(Uuid{});
+		ev.price = cents16(f.get(Field::YesPriceDollars));
+		ev.no_price = cents16(f.get(Field::NoPriceDollars));
+		ev.quantity = detail::parse_fp_int(f.get(Field::CountFp));
+		ev.side = parse_wire_side(f.get(Field::TakerSide));
+		ev.timestamp = detail::parse_int64_value(f.get(Field::Ts));
+	} else if (type == "fill") {
+		ev.kind = WsEventKind::Fill;
+		ev.trade_id = Uuid::parse(f.get(Field::TradeId)).value_or(Uuid{});
+		ev.order_id = Uuid::parse(f.get(Field::OrderId)).value_or(Uuid{});
+		ev.is_taker = parse_wire_bool(f.get(Field::IsTaker));
+		ev.side = parse_wire_side(f.get(Field::Side));
+		ev.price = cents16(f.get(Field::YesPriceDollars));
+		ev.no_price = cents16(f.get(Field::NoPriceDollars));
+		ev.quantity = detail::parse_fp_int(f.get(Field::CountFp));
+		ev.action = f.get(Field::Action) == "buy" ? Action::Buy : Action::Sell;
+		ev.timestamp = detail::parse_int64_value(f.get(Field::Ts));
+	} else {
+		return false;
+	}
+	ev.sid = detail::parse_int_value(f.get(Field::Sid));
+	ev.ticker_id = intern_ticker(f.get(Field::MarketTicker), options);
+	return true;
+}
+
+} // anonymous namespace
+
+DecodedFrame decode_frame(std::string_view frame, const DecodeOptions& options) {
+	DecodedFrame out;
+	const FieldSlots f = FrameScanner(frame).scan();
+	if (!f.has(Field::Type))
+		return out;
+
+	const std::string_view type = f.get(Field::Type);
+
+	if (options.compact_events && decode_event(type, f, options, out.event)) {
+		out.kind = FrameKind::Event;
+		return out;
+	}
+
+	if (type == "error") {
+		out.kind = FrameKind::Error;
+		// Only a nested `msg` object carries the code / message pair.
+		if (f.has(Field::Msg)) {
+			out.error.code = detail::parse_int_value(f.get(Field::Code));
+			out.error.message = to_owned(f.get(Field::Message));
+			if (out.error.message.empty()) {
+				// No explicit message field — fall back to the documented
+				// error-code name (e.g. code 7 → "Unknown subscription ID").
+				out.error.message = std::string{ws_error_code_name(out.error.code)};
+			}
+		}
+	} else if (type == "subscribed") {
+		// {"type":"subscribed","id":1,"msg":{"sid":12345,...}}
+		out.kind = FrameKind::Subscribed;
+		out.client_id = detail::parse_int_value(f.get(Field::Id));
+		out.server_sid = detail::parse_int_value(f.get(Field::Sid));
+	} else if (type == "orderbook_snapshot") {
+		OrderbookSnapshot snap;
+		snap.sid = detail::parse_int_value(f.get(Field::Sid));
+		snap.seq = detail::parse_int_value(f.get(Field::Seq));
+		set_ticker(snap, f.get(Field::MarketTicker), options);
+		if (options.snapshot_levels != nullptr) {
+			std::vector<OrderBookEntry>& levels = *options.snapshot_levels;
+			levels.clear();
+			append_book_side(f.get(Field::Yes), levels);
+			const std::size_t yes_count = levels.size();
+			append_book_side(f.get(Field::No), levels);
+			// Take the views only after both appends: a reallocation in
+			// the second would dangle a view taken after the first.
+			const std::span<const OrderBookEntry> all{levels};
+			snap.yes_view = all.first(yes_count);
+			snap.no_view = all.subspan(yes_count);
+		} else {
+			snap.yes = parse_book_side(f.get(Field::Yes));
+			snap.no = parse_book_side(f.get(Field::No));
+		}
+		out.kind = FrameKind::Message;
+		out.message = std::move(snap);
+	} else if (type == "orderbook_delta") {
+		// Kalshi v2 wire format (as of 2026-04):
+		//   msg.price_dollars  = "0.4200"    -> 42 cents
+		//   msg.delta_fp       = "-30.87"    -> -31 (rounded)
+		//   msg.ts             = "2026-04-20T08:19:13.898Z"  (ISO, not int)
+		OrderbookDelta delta;
+		delta.sid = detail::parse_int_value(f.get(Field::Sid));
+		delta.seq = detail::parse_int_value(f.get(Field::Seq));
+		set_ticker(delta, f.get(Field::MarketTicker), options);
+		delta.price = detail::parse_dollar_cents(f.get(Field::PriceDollars));
+		delta.delta = detail::parse_fp_int(f.get(Field::DeltaFp));
+		delta.side = parse_wire_side(f.get(Field::Side));
+		out.kind = FrameKind::Message;
+		out.message = std::move(delta);
+	} else if (type == "trade") {
+		// Kalshi v2 wire format (as of 2026-04):
+		//   msg.yes_price_dollars = "0.3200"  -> 32 cents
+		//   msg.no_price_dollars  = "0.6800"  -> 68 cents
+		//   msg.count_fp          = "40.00"   -> 40 contracts (rounded)
+		WsTrade trade;
+		trade.sid = detail::parse_int_value(f.get(Field::Sid));
+		trade.trade_id = to_owned(f.get(Field::TradeId));
+		set_ticker(trade, f.get(Field::MarketTicker), options);
+		trade.yes_price = detail::parse_dollar_cents(f.get(Field::YesPriceDollars));
+		trade.no_price = detail::parse_dollar_cents(f.get(Field::NoPriceDollars));
+		trade.count = detail::parse_fp_int(f.get(Field::CountFp));
+		trade.taker_side = parse_wire_side(f.get(Field::TakerSide));
+		trade.timestamp = detail::parse_int64_value(f.get(Field::Ts));
+		out.kind = FrameKind::Message;
+		out.message = std::move(trade);
+	} else if (type == "fill") {
+		// Fill messages (user-only) use the same _dollars / _fp suffix
+		// convention as trade frames in the v2 schema.
+		WsFill fill;
+		fill.sid = detail::parse_int_value(f.get(Field::Sid));
+		fill.trade_id = to_owned(f.get(Field::TradeId));
+		fill.order_id = to_owned(f.get(Field::OrderId));
+		set_ticker(fill, f.get(Field::MarketTicker), options);
+		fill.is_taker = parse_wire_bool(f.get(Field::IsTaker));
+		fill.side = parse_wire_side(f.get(Field::Side));
+		fill.yes_price_dollars = Price::parse(f.get(Field::YesPriceDollars)).value_or(Price{});
+		fill.no_price_dollars = Price::parse(f.get(Field::NoPriceDollars)).value_or(Price{});
+		fill.count_fp = Quantity::parse(f.get(Field::CountFp)).value_or(Quantity{});
+		fill.yes_price = fill.yes_price_dollars.cents();
+		fill.no_price = fill.no_price_dollars.cents();
+		fill.count = fill.count_fp.contracts();
+		fill.action = f.get(Field::Action) == "buy" ? Action::Buy : Action::Sell;
+		fill.timestamp = detail::parse_int64_value(f.get(Field::Ts));
+		out.kind = FrameKind::Message;
+		out.message = std::move(fill);
+	} else if (type == "market_lifecycle" || type == "market_lifecycle_v2") {
+		MarketLifecycle lc;
+		lc.sid = detail::parse_int_value(f.get(Field::Sid));
+		set_ticker(lc, f.get(Field::MarketTicker), options);
+		lc.open_ts = detail::parse_int64_value(f.get(Field::OpenTs));
+		lc.close_ts = detail::parse_int64_value(f.get(Field::CloseTs));
+		const std::int64_t det = detail::parse_int64_value(f.get(Field::DeterminationTs));
+		if (det > 0)
+			lc.determination_ts = det;
+		const std::int64_t settled = detail::parse_int64_value(f.get(Field::SettledTs));
+		if (settled > 0)
+			lc.settled_ts = settled;
+		if (!f.get(Field::Result).empty())
+			lc.result = to_owned(f.get(Field::Result));
+		lc.is_deactivated = parse_wire_bool(f.get(Field::IsDeactivated));
+		// `yes_sub_title` is emitted only by the `metadata_updated` sub-event
+		// (added 2026-05-11). Non-empty here ⇒ the frame is a metadata
+		// update. Empty extraction ⇒ leave nullopt.
+		if (!f.get(Field::YesSubTitle).empty())
+			lc.yes_sub_title = to_owned(f.get(Field::YesSubTitle));
+		out.kind = FrameKind::Message;
+		out.message = std::move(lc);
+	}
+	return out;
+}
+
+FramePeek peek_frame(std::string_view frame) {
+	constexpr std::uint64_t kRouting =
+		(std::uint64_t{1} << static_cast<std::size_t>(Field::Type)) |
+		(std::uint64_t{1} << static_cast<std::size_t>(Field::Sid)) |
+		(std::uint64_t{1} << static_cast<std::size_t>(Field::Seq)) |
+		(std::uint64_t{1} << static_cast<std::size_t>(Field::MarketTicker));
+	FramePeek out;
+	const FieldSlots f = FrameScanner(frame, kRouting).scan();
+	const std::string_view type = f.get(Field::Type);
+	if (type == "orderbook_snapshot") {
+		out.kind = PeekKind::Snapshot;
+	} else if (type == "orderbook_delta") {
+		out.kind = PeekKind::Delta;
+	} else if (type == "trade" || type == "fill" || type == "market_lifecycle" ||
+			   type == "market_lifecycle_v2") {
+		out.kind = PeekKind::Data;
+	} else {
+		return out;
+	}
+	out.sid = detail::parse_int_value(f.get(Field::Sid));
+	out.seq = detail::parse_int_value(f.get(Field::Seq));
+	out.market_ticker = f.get(Field::MarketTicker);
+	return out;
+}
+
+} // namespace kalshi::ws_detail
@@ -0,0 +1,90 @@
+#pragma once
+
+/// @file frame_decoder.hpp
+/// @brief Single-pass decoder for inbound Kalshi WebSocket frames.
+///
+/// ``decode_frame`` walks a frame exactly once, records the value slice
+/// of every field the SDK understands (first occurrence wins, at any
+/// nesting depth — the same precedence the old find-by-key scanners
+/// had), then dispatches on ``type`` and converts only the fields that
+/// message kind needs. Slices are ``std::string_view``s into the frame;
+/// the only allocations are the ``std::string`` / ``std::vector``
+/// members of the public message structs themselves.
+///
+/// Not installed: consumed by ``websocket.cpp`` and the unit tests.
+
+#include "kalshi/websocket.hpp"
+#include "kalshi/ws_event.hpp"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace kalshi::ws_detail {
+
+/// What a decoded frame turned out to be.
+enum class FrameKind : std::uint8_t {
+	Ignored,	///< Unknown / unsupported ``type``, or no ``type`` at all
+	Error,		///< Server ``error`` frame; see ``DecodedFrame::error``
+	Subscribed, ///< ``subscribed`` ack; see ``client_id`` / ``server_sid``
+	Message,	///< Data frame; see ``DecodedFrame::message``
+	Event,		///< Delta / trade / fill in compact form; see ``DecodedFrame::event``
+};
+
+/// Output of ``decode_frame``. Only the members relevant to ``kind``
+/// are populated.
+struct DecodedFrame {
+	FrameKind kind{FrameKind::Ignored};
+	WsMessage message;
+	WsEvent event;
+	WsError error;
+	std::int32_t client_id{0};
+	std::int32_t server_sid{0};
+};
+
+/// Per-connection decode settings.
+struct DecodeOptions {
+	/// When set, ``market_ticker`` is interned and stamped into ``ticker_id``.
+	TickerTable* tickers{nullptr};
+	/// Copy ``market_ticker`` into the message (false = id only).
+	bool ticker_strings{true};
+	/// When set, snapshot levels are written here (YES then NO, cleared
+	/// first) and exposed as ``yes_view`` / ``no_view``; the vectors stay
+	/// empty. The views are invalidated by the next decode using it.
+	std::vector<OrderBookEntry>* snapshot_levels{nullptr};
+	/// Decode deltas, trades and fills straight into ``DecodedFrame::event``
+	/// (``FrameKind::Event``) without building their rich structs.
+	/// ``ticker_strings`` does not apply to them.
+	bool compact_events{false};
+};
+
+/// Decode one complete (reassembled) WebSocket text frame.
+///
+/// Never fails: malformed input decodes as far as the scanner got, and a
+/// frame without a recognised ``type`` yields ``FrameKind::Ignored``.
+[[nodiscard]] DecodedFrame decode_frame(std::string_view frame,
+										const DecodeOptions& options = {});
+
+/// What ``peek_frame`` found out about a frame.
+enum class PeekKind : std::uint8_t {
+	Control,  ///< Anything but market data (acks, errors, unknown types)
+	Snapshot, ///< ``orderbook_snapshot``
+	Delta,	  ///< ``orderbook_delta``
+	Data,	  ///< Trade, fill or lifecycle message
+};
+
+/// Routing fields of a data frame. ``market_ticker`` views the frame.
+struct FramePeek {
+	PeekKind kind{PeekKind::Control};
+	std::int32_t sid{0};
+	std::int32_t seq{0};
+	std::string_view market_ticker;
+};
+
+/// Read only ``type``, ``sid``, ``seq`` and ``market_ticker``, stopping
+/// as soon as all four have been seen (usually before the payload), with
+/// the same precedence rules as ``decode_frame``. Lets the service thread
+/// track sequence numbers and route a frame without decoding it.
+[[nodiscard]] FramePeek peek_frame(std::string_view frame);
+
+} // namespace kalshi::ws_detail
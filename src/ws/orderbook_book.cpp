@@ -0,0 +1,158 @@
+#include "kalshi/orderbook_book.hpp"
+
+#include <bit>
+#include <utility>
+
+namespace kalshi {
+
+namespace {
+
+bool in_range(std::int32_t price) {
+	return price >= OrderBookBook::kMinPrice && price <= OrderBookBook::kMaxPrice;
+}
+
+} // anonymous namespace
+
+void OrderBookBook::Ladder::set(std::int32_t price, std::int32_t qty) noexcept {
+	const std::size_t word = static_cast<std::size_t>(price) >> 6;
+	const std::uint64_t bit = std::uint64_t{1} << (static_cast<std::uint32_t>(price) & 63U);
+	if (qty > 0) {
+		quantity[static_cast<std::size_t>(price)] = qty;
+		occupied[word] |= bit;
+	} else {
+		quantity[static_cast<std::size_t>(price)] = 0;
+		occupied[word] &= ~bit;
+	}
+}
+
+std::int32_t OrderBookBook::Ladder::best_price() const noexcept {
+	if (occupied[1] != 0) {
+		return 64 + static_cast<std::int32_t>(std::bit_width(occupied[1])) - 1;
+	}
+	if (occupied[0] != 0) {
+		return static_cast<std::int32_t>(std::bit_width(occupied[0])) - 1;
+	}
+	return 0;
+}
+
+void OrderBookBook::Ladder::clear() noexcept {
+	quantity.fill(0);
+	occupied.fill(0);
+}
+
+OrderBookBook::OrderBookBook(SeqCheck seq_check) noexcept : seq_check_(seq_check) {}
+
+BookUpdate OrderBookBook::apply(const OrderbookSnapshot& snapshot) noexcept {
+	yes_.clear();
+	no_.clear();
+	for (const OrderBookEntry& entry : snapshot.yes_levels()) {
+		if (in_range(entry.price_cents)) {
+			yes_.set(entry.price_cents, entry.quantity);
+		}
+	}
+	for (const OrderBookEntry& entry : snapshot.no_levels()) {
+		if (in_range(entry.price_cents)) {
+			no_.set(entry.price_cents, entry.quantity);
+		}
+	}
+	last_seq_ = snapshot.seq;
+	initialized_ = true;
+	return BookUpdate::Applied;
+}
+
+BookUpdate OrderBookBook::apply(const OrderbookDelta& delta) noexcept {
+	if (!initialized_) {
+		return BookUpdate::NeedsSnapshot;
+	}
+	// seq 0 means the frame carried none; skip the checks rather than
+	// treating every such delta as stale.
+	if (delta.seq != 0) {
+		if (delta.seq <= last_seq_) {
+			return BookUpdate::Stale;
+		}
+		if (seq_check_ == SeqCheck::Contiguous && delta.seq != last_seq_ + 1) {
+			initialized_ = false;
+			return BookUpdate::Gap;
+		}
+	}
+	// The sequence number is consumed even when the level is dropped, so
+	// the next delta is not mistaken for a gap.
+	if (delta.seq != 0) {
+		last_seq_ = delta.seq;
+	}
+	if (!in_range(delta.price)) {
+		return BookUpdate::OutOfRange;
+	}
+	Ladder& side = ladder(delta.side);
+	const std::int64_t next =
+		static_cast<std::int64_t>(side.quantity[static_cast<std::size_t>(delta.price)]) +
+		delta.delta;
+	side.set(delta.price, next > INT32_MAX ? INT32_MAX : static_cast<std::int32_t>(next));
+	return BookUpdate::Applied;
+}
+
+void OrderBookBook::clear() noexcept {
+	yes_.clear();
+	no_.clear();
+	last_seq_ = 0;
+	initialized_ = false;
+}
+
+std::int32_t OrderBookBook::quantity(Side side, std::int32_t price_cents) const noexcept {
+	if (!in_range(price_cents)) {
+		return 0;
+	}
+	return ladder(side).quantity[static_cast<std::size_t>(price_cents)];
+}
+
+std::optional<OrderBookEntry> OrderBookBook::best_bid(Side side) const noexcept {
+	const Ladder& l = ladder(side);
+	const std::int32_t price = l.best_price();
+	if (price == 0) {
+		return std::nullopt;
+	}
+	return OrderBookEntry{price, l.quantity[static_cast<std::size_t>(price)]};
+}
+
+std::optional<OrderBookEntry> OrderBookBook::best_ask(Side side) const noexcept {
+	const std::optional<OrderBookEntry> opposite =
+		best_bid(side == Side::Yes ? Side::No : Side::Yes);
+	if (!opposite) {
+		return std::nullopt;
+	}
+	return OrderBookEntry{100 - opposite->price_cents, opposite->quantity};
+}
+
+std::size_t OrderBookBook::level_count(Side side) const noexcept {
+	const Ladder& l = ladder(side);
+	return static_cast<std::size_t>(std::popcount(l.occupied[0]) + std::popcount(l.occupied[1]));
+}
+
+OrderBook OrderBookBook::to_order_book(std::string market_ticker) const {
+	OrderBook book;
+	book.market_ticker = std::move(market_ticker);
+	book.yes_bids.reserve(level_count(Side::Yes));
+	book.no_bids.reserve(level_count(Side::No));
+	for (std::int32_t p = kMinPrice; p <= kMaxPrice; ++p) {
+		const std::size_t i = static_cast<std::size_t>(p);
+		if (yes_.quantity[i] > 0) {
+			book.yes_bids.push_back(OrderBookEntry{p, yes_.quantity[i]});
+		}
+		if (no_.quantity[i] > 0) {
+			book.no_bids.push_back(OrderBookEntry{p, no_.quantity[i]});
+		}
+	}
+	return book;
+}
+
+OrderbookSnapshot OrderBookBook::to_snapshot(std::string market_ticker) const {
+	OrderBook book = to_order_book(std::move(market_ticker));
+	OrderbookSnapshot snapshot;
+	snapshot.seq = last_seq_;
+	snapshot.market_ticker = std::move(book.market_ticker);
+	snapshot.yes = std::move(book.yes_bids);
+	snapshot.no = std::move(book.no_bids);
+	return snapshot;
+}
+
+} // namespace kalshi
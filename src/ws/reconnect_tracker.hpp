@@ -0,0 +1,112 @@
+#pragma once
+
+/// @file reconnect_tracker.hpp
+/// @brief Backoff and resume-latency bookkeeping for WebSocket auto-reconnect.
+///
+/// The service thread reports each connection event; the tracker decides
+/// how long to wait before the next attempt and measures each outage from
+/// the drop to the first market data message after recovery. ``stats`` may
+/// be read from any thread.
+///
+/// Not installed: consumed by ``websocket.cpp`` and the unit tests.
+
+#include "kalshi/retry.hpp"
+#include "kalshi/websocket.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace kalshi::ws_detail {
+
+class ReconnectTracker {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	/// The connection dropped, or a reconnect attempt failed. Returns the
+	/// wait before the next attempt, or null once ``max_attempts`` (0 for
+	/// unlimited) are used up for this outage.
+	[[nodiscard]] std::optional<std::chrono::milliseconds>
+	next_attempt(Clock::time_point now, const RetryPolicy& policy, std::uint16_t max_attempts) {
+		if (!lost_at_) {
+			lost_at_ = now;
+		} else if (attempt_ > 0 && !awaiting_message_) {
+			failed_attempts_.fetch_add(1, std::memory_order_relaxed);
+		}
+		awaiting_message_ = false;
+		if (max_attempts != 0 && attempt_ >= max_attempts) {
+			return std::nullopt;
+		}
+		++attempt_;
+		pending_attempts_.store(attempt_, std::memory_order_relaxed);
+		return calculate_retry_delay(
+			static_cast<std::uint8_t>(std::min<std::uint16_t>(attempt_, UINT8_MAX)), policy);
+	}
+
+	/// The connection came up. True when it ends an outage, i.e. the
+	/// caller must replay its subscriptions.
+	bool established() noexcept {
+		if (!lost_at_) {
+			return false;
+		}
+		attempt_ = 0;
+		pending_attempts_.store(0, std::memory_order_relaxed);
+		awaiting_message_ = true;
+		reconnects_.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/// A market data message was delivered; closes an outage's latency.
+	void message(Clock::time_point now) noexcept {
+		if (!awaiting_message_) {
+			return;
+		}
+		const std::chrono::microseconds latency =
+			std::chrono::duration_cast<std::chrono::microseconds>(now - *lost_at_);
+		last_latency_us_.store(latency.count(), std::memory_order_relaxed);
+		if (latency.count() > max_latency_us_.load(std::memory_order_relaxed)) {
+			max_latency_us_.store(latency.count(), std::memory_order_relaxed);
+		}
+		awaiting_message_ = false;
+		lost_at_.reset();
+	}
+
+	/// Forget the current outage (explicit disconnect or a fresh connect).
+	void reset() noexcept {
+		lost_at_.reset();
+		attempt_ = 0;
+		awaiting_message_ = false;
+		pending_attempts_.store(0, std::memory_order_relaxed);
+	}
+
+	/// True while the first message after a reconnect is outstanding
+	[[nodiscard]] bool awaiting_message() const noexcept { return awaiting_message_; }
+
+	[[nodiscard]] WsReconnectStats stats() const noexcept {
+		return WsReconnectStats{
+			.reconnects = reconnects_.load(std::memory_order_relaxed),
+			.failed_attempts = failed_attempts_.load(std::memory_order_relaxed),
+			.last_resume_latency =
+				std::chrono::microseconds{last_latency_us_.load(std::memory_order_relaxed)},
+			.max_resume_latency =
+				std::chrono::microseconds{max_latency_us_.load(std::memory_order_relaxed)},
+			.pending_attempts = pending_attempts_.load(std::memory_order_relaxed)};
+	}
+
+private:
+	// Service thread only.
+	std::optional<Clock::time_point> lost_at_;
+	std::uint16_t attempt_{0};
+	bool awaiting_message_{false};
+
+	// Published for stats().
+	std::atomic<std::uint64_t> reconnects_{0};
+	std::atomic<std::uint64_t> failed_attempts_{0};
+	std::atomic<std::int64_t> last_latency_us_{0};
+	std::atomic<std::int64_t> max_latency_us_{0};
+	std::atomic<std::uint16_t> pending_attempts_{0};
+};
+
+} // namespace kalshi::ws_detail
@@ -0,0 +1,175 @@
+#include "kalshi/ws_recorder.hpp"
+
+#include "frame_decoder.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace kalshi {
+
+struct ReplayClient::Impl {
+	WsLogReader reader;
+	ReplayConfig config;
+	ws_detail::DecodeOptions decode_options;
+
+	WsMessageCallback message_callback;
+	WsEventCallback event_callback;
+	WsErrorCallback error_callback;
+	std::vector<TickerId> ticker_map; ///< Recorded id -> id in config.ticker_table
+	std::atomic<bool> stop_requested{false};
+
+	Impl(WsLogReader r, ReplayConfig c) : reader(std::move(r)), config(std::move(c)) {
+		if (!config.ticker_table) {
+			config.ticker_table = std::make_shared<TickerTable>();
+		}
+		decode_options.tickers = config.ticker_table.get();
+		decode_options.ticker_strings = config.ticker_strings;
+	}
+
+	void map_ticker(std::string_view payload) {
+		std::uint32_t id = 0;
+		if (payload.size() < sizeof(id)) {
+			return;
+		}
+		std::memcpy(&id, payload.data(), sizeof(id));
+		if (id == TickerId::kInvalid) {
+			return;
+		}
+		if (id >= ticker_map.size()) {
+			ticker_map.resize(static_cast<std::size_t>(id) + 1);
+		}
+		ticker_map[id] = config.ticker_table->intern(payload.substr(sizeof(id)));
+	}
+
+	void deliver_event(std::string_view payload) {
+		WsEvent event;
+		std::memcpy(&event, payload.data(), sizeof(event));
+		const std::uint32_t recorded = event.ticker_id.value;
+		event.ticker_id = recorded < ticker_map.size() ? ticker_map[recorded] : TickerId{};
+		if (event_callback) {
+			event_callback(event);
+		} else if (message_callback) {
+			message_callback(
+				to_message(event, config.ticker_strings ? config.ticker_table.get() : nullptr));
+		}
+	}
+
+	ReplayStats run() {
+		using Clock = std::chrono::steady_clock;
+		stop_requested.store(false, std::memory_order_relaxed);
+		ReplayStats stats;
+		const Clock::time_point started = Clock::now();
+		const bool paced = config.speed > 0.0;
+		std::uint64_t first_ns = 0;
+		std::uint64_t last_ns = 0;
+
+		WsLogRecord record;
+		while (!stop_requested.load(std::memory_order_relaxed) && reader.next(record)) {
+			if (record.type == WsLogRecordType::Ticker) {
+				map_ticker(record.payload);
+				continue;
+			}
+			if (record.type != WsLogRecordType::Frame && record.type != WsLogRecordType::Event) {
+				continue;
+			}
+			if (stats.frames == 0) {
+				first_ns = record.recv_ns;
+			}
+			++stats.frames;
+			last_ns = record.recv_ns;
+			if (paced && record.recv_ns > first_ns) {
+				const double offset = static_cast<double>(record.recv_ns - first_ns) / config.speed;
+				std::this_thread::sleep_until(
+					started + std::chrono::duration_cast<Clock::duration>(
+								  std::chrono::duration<double, std::nano>(offset)));
+			}
+
+			if (record.type == WsLogRecordType::Event) {
+				if (record.payload.size() == sizeof(WsEvent)) {
+					++stats.messages;
+					deliver_event(record.payload);
+				}
+				continue;
+			}
+
+			ws_detail::DecodedFrame decoded =
+				ws_detail::decode_frame(record.payload, decode_options);
+			if (decoded.kind == ws_detail::FrameKind::Message) {
+				++stats.messages;
+				if (message_callback) {
+					message_callback(decoded.message);
+				}
+			} else if (decoded.kind == ws_detail::FrameKind::Error) {
+				++stats.errors;
+				if (error_callback) {
+					error_callback(decoded.error);
+				}
+			}
+		}
+
+		stats.recorded_span = std::chrono::nanoseconds(last_ns > first_ns ? last_ns - first_ns : 0);
+		stats.elapsed =
+			std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started);
+		return stats;
+	}
+};
+
+Result<ReplayClient> ReplayClient::open(const std::string& path, ReplayConfig config) {
+	Result<WsLogReader> reader = WsLogReader::open(path);
+	if (!reader) {
+		return std::unexpected(reader.error());
+	}
+	return ReplayClient(std::make_unique<Impl>(std::move(*reader), std::move(config)));
+}
+
+ReplayClient::ReplayClient(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+ReplayClient::~ReplayClient() = default;
+ReplayClient::ReplayClient(ReplayClient&&) noexcept = default;
+ReplayClient& ReplayClient::operator=(ReplayClient&&) noexcept = default;
+
+void ReplayClient::on_message(WsMessageCallback callback) {
+	if (impl_) {
+		impl_->message_callback = std::move(callback);
+	}
+}
+
+void ReplayClient::on_event(WsEventCallback callback) {
+	if (impl_) {
+		impl_->event_callback = std::move(callback);
+	}
+}
+
+void ReplayClient::on_error(WsErrorCallback callback) {
+	if (impl_) {
+		impl_->error_callback = std::move(callback);
+	}
+}
+
+Result<ReplayStats> ReplayClient::run() {
+	if (!impl_) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "ReplayClient was moved from"});
+	}
+	return impl_->run();
+}
+
+void ReplayClient::stop() noexcept {
+	if (impl_) {
+		impl_->stop_requested.store(true, std::memory_order_relaxed);
+	}
+}
+
+void ReplayClient::rewind() {
+	if (impl_) {
+		impl_->reader.rewind();
+	}
+}
+
+std::shared_ptr<TickerTable> ReplayClient::ticker_table() const noexcept {
+	return impl_ ? impl_->config.ticker_table : nullptr;
+}
+
+} // namespace kalshi
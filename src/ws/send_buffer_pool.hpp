@@ -0,0 +1,108 @@
+#pragma once
+
+/// @file send_buffer_pool.hpp
+/// @brief Reusable outbound frame buffers with libwebsockets headroom.
+///
+/// ``lws_write`` needs ``LWS_PRE`` writable bytes in front of the payload
+/// for the frame header. Each ``SendBuffer`` carries that headroom, so a
+/// command is rendered once into a pooled buffer and written from it
+/// without another copy. Buffers go back to the pool after the write and
+/// keep their capacity, so steady-state sends never allocate.
+///
+/// Not installed: consumed by ``websocket.cpp`` and the unit tests.
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace kalshi::ws_detail {
+
+/// One outbound frame: ``headroom`` bytes, then the payload. Doubles as an
+/// ``detail::MpscQueue`` node.
+struct SendBuffer {
+	std::string frame;
+	std::size_t headroom{0};
+	std::atomic<SendBuffer*> next{nullptr};
+
+	/// Turn a payload rendered at ``frame[0]`` into a frame by opening the
+	/// headroom in front of it (a move within the existing capacity).
+	void seal() { frame.insert(0, headroom, '\0'); }
+
+	[[nodiscard]] unsigned char* payload() noexcept {
+		return reinterpret_cast<unsigned char*>(frame.data()) + headroom;
+	}
+
+	[[nodiscard]] std::size_t payload_size() const noexcept {
+		return frame.size() > headroom ? frame.size() - headroom : 0;
+	}
+};
+
+/// Free list of ``SendBuffer``s. Any thread may acquire or release; the
+/// lock is held only to move one pointer in or out.
+class SendBufferPool {
+public:
+	/// Buffers larger than this are freed rather than kept, so one bulk
+	/// ``add_markets`` does not pin its frame size forever.
+	static constexpr std::size_t kMaxRetainedBytes = 64 * 1024;
+
+	explicit SendBufferPool(std::size_t headroom, std::size_t max_free = 64)
+		: headroom_(headroom), max_free_(max_free) {}
+
+	SendBufferPool(const SendBufferPool&) = delete;
+	SendBufferPool& operator=(const SendBufferPool&) = delete;
+
+	/// An empty buffer (``frame`` cleared, capacity kept), reused when one
+	/// is free.
+	[[nodiscard]] std::unique_ptr<SendBuffer> acquire() {
+		std::unique_ptr<SendBuffer> buffer;
+		{
+			std::lock_guard lock(mutex_);
+			if (!free_.empty()) {
+				buffer = std::move(free_.back());
+				free_.pop_back();
+			}
+		}
+		if (!buffer) {
+			buffer = std::make_unique<SendBuffer>();
+			buffer->headroom = headroom_;
+			allocated_.fetch_add(1, std::memory_order_relaxed);
+		}
+		buffer->frame.clear();
+		return buffer;
+	}
+
+	/// Return a written buffer to the pool
+	void release(std::unique_ptr<SendBuffer> buffer) {
+		if (!buffer || buffer->frame.capacity() > kMaxRetainedBytes) {
+			return;
+		}
+		std::lock_guard lock(mutex_);
+		if (free_.size() < max_free_) {
+			free_.push_back(std::move(buffer));
+		}
+	}
+
+	/// Buffers waiting for reuse
+	[[nodiscard]] std::size_t free_count() const {
+		std::lock_guard lock(mutex_);
+		return free_.size();
+	}
+
+	/// Buffers created since construction
+	[[nodiscard]] std::size_t allocated() const noexcept {
+		return allocated_.load(std::memory_order_relaxed);
+	}
+
+private:
+	std::size_t headroom_;
+	std::size_t max_free_;
+	mutable std::mutex mutex_;
+	std::vector<std::unique_ptr<SendBuffer>> free_;
+	std::atomic<std::size_t> allocated_{0};
+};
+
+} // namespace kalshi::ws_detail
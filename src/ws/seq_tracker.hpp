@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace kalshi::ws_detail {
+
+/// Result of feeding one ``(sid, seq)`` pair to ``SeqTracker``.
+enum class SeqStatus : std::uint8_t {
+	First,	 ///< First sequenced message on this sid; becomes the base
+	InOrder, ///< Exactly ``last + 1``
+	Duplicate, ///< At or below ``last``; replayed / reordered frame
+	Gap,	   ///< Skipped ahead; ``expected`` holds the missing seq
+};
+
+struct SeqObservation {
+	SeqStatus status{SeqStatus::First};
+	std::int32_t expected{0};
+};
+
+/// Per-subscription sequence tracker for orderbook channels.
+///
+/// Kalshi numbers ``seq`` per sid across every market on the
+/// subscription, so contiguity can only be checked at sid granularity.
+/// Touched only from the libwebsockets service thread — no locking.
+class SeqTracker {
+public:
+	SeqObservation observe(std::int32_t sid, std::int32_t seq) {
+		if (seq <= 0) {
+			return {SeqStatus::InOrder, 0}; // unsequenced frame; nothing to check
+		}
+		auto [it, inserted] = last_seq_.try_emplace(sid, seq);
+		if (inserted) {
+			return {SeqStatus::First, seq};
+		}
+		const std::int32_t expected = it->second + 1;
+		if (seq < expected) {
+			return {SeqStatus::Duplicate, expected};
+		}
+		// A gap re-bases on the received seq: the missing frames are gone
+		// for good and later frames continue from here.
+		it->second = seq;
+		return {seq == expected ? SeqStatus::InOrder : SeqStatus::Gap, expected};
+	}
+
+	void erase(std::int32_t sid) { last_seq_.erase(sid); }
+
+	void clear() { last_seq_.clear(); }
+
+private:
+	std::unordered_map<std::int32_t, std::int32_t> last_seq_;
+};
+
+} // namespace kalshi::ws_detail
@@ -0,0 +1,112 @@
+#pragma once
+
+/// @file service_tuning.hpp
+/// @brief CPU affinity, real-time priority and socket options for the
+/// WebSocket service loop.
+///
+/// Thread placement is Linux only; elsewhere asking for a CPU or a
+/// priority fails and the defaults succeed. Socket options are POSIX, with
+/// ``SO_BUSY_POLL`` applied only where the headers define it.
+///
+/// Not installed: consumed by ``websocket.cpp`` and the unit tests.
+
+#include "kalshi/error.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if !defined(_WIN32)
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+namespace kalshi::ws_detail {
+
+/// Pin ``thread`` to ``cpu`` (when >= 0) and run it under ``SCHED_FIFO``
+/// at ``priority`` (when > 0). Does nothing for ``-1`` / ``0``.
+[[nodiscard]] inline Result<void> tune_thread(std::thread::native_handle_type thread, int cpu,
+											  int priority) {
+	if (cpu < -1) {
+		return std::unexpected(
+			Error{ErrorCode::InvalidRequest, "service_cpu must be -1 or a CPU index"});
+	}
+	if (priority < 0 || priority > 99) {
+		return std::unexpected(
+			Error{ErrorCode::InvalidRequest, "service_priority must be in 0..99"});
+	}
+	if (cpu < 0 && priority == 0) {
+		return {};
+	}
+#if defined(__linux__)
+	if (cpu >= 0) {
+		if (cpu >= CPU_SETSIZE) {
+			return std::unexpected(Error{ErrorCode::InvalidRequest,
+										 "service_cpu " + std::to_string(cpu) + " out of range"});
+		}
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		if (const int rc = pthread_setaffinity_np(thread, sizeof(set), &set); rc != 0) {
+			return std::unexpected(Error{ErrorCode::InvalidRequest,
+										 "Cannot pin service thread to CPU " +
+											 std::to_string(cpu) + ": " + std::strerror(rc)});
+		}
+	}
+	if (priority > 0) {
+		sched_param param{};
+		param.sched_priority = priority;
+		// EPERM without CAP_SYS_NICE or an RLIMIT_RTPRIO allowance.
+		if (const int rc = pthread_setschedparam(thread, SCHED_FIFO, &param); rc != 0) {
+			return std::unexpected(Error{ErrorCode::InvalidRequest,
+										 "Cannot set SCHED_FIFO priority " +
+											 std::to_string(priority) + ": " + std::strerror(rc)});
+		}
+	}
+	return {};
+#else
+	(void)thread;
+	return std::unexpected(Error{ErrorCode::InvalidRequest,
+								 "service_cpu / service_priority are only supported on Linux"});
+#endif
+}
+
+#if !defined(_WIN32)
+/// Set ``TCP_NODELAY`` (when ``nodelay``) and ``SO_BUSY_POLL`` (when
+/// ``busy_poll_us`` > 0) on a connected socket.
+[[nodiscard]] inline Result<void> tune_socket(int fd, bool nodelay, std::uint32_t busy_poll_us) {
+	if (fd < 0) {
+		return std::unexpected(Error::network("No socket to tune"));
+	}
+	if (nodelay) {
+		const int on = 1;
+		if (::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)) != 0) {
+			return std::unexpected(
+				Error::network(std::string("TCP_NODELAY: ") + std::strerror(errno)));
+		}
+	}
+	if (busy_poll_us > 0) {
+#if defined(SO_BUSY_POLL)
+		const int us = static_cast<int>(busy_poll_us);
+		// Raising it above net.core.busy_read needs CAP_NET_ADMIN.
+		if (::setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &us, sizeof(us)) != 0) {
+			return std::unexpected(
+				Error::network(std::string("SO_BUSY_POLL: ") + std::strerror(errno)));
+		}
+#else
+		return std::unexpected(Error::network("SO_BUSY_POLL is not supported on this platform"));
+#endif
+	}
+	return {};
+}
+#endif
+
+} // namespace kalshi::ws_detail
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace kalshi::ws_detail {
+
+/// Default shard of ``ticker`` among ``shards``: FNV-1a, so every process
+/// and every run agrees on the placement.
+[[nodiscard]] constexpr std::size_t shard_of(std::string_view ticker, std::size_t shards) noexcept {
+	std::uint64_t hash = 14695981039346656037ULL;
+	for (const char c : ticker) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ULL;
+	}
+	return shards > 1 ? static_cast<std::size_t>(hash % shards) : 0;
+}
+
+/// Messages one movable market produced on its current shard.
+struct MarketLoad {
+	std::uint32_t ticker{0}; ///< TickerId value
+	std::size_t shard{0};
+	std::uint64_t messages{0};
+};
+
+/// One market to move, as an index into the ``plan_rebalance`` input.
+struct PlannedMove {
+	std::size_t market{0};
+	std::size_t from{0};
+	std::size_t to{0};
+};
+
+/// Greedy hot-market rebalance.
+///
+/// ``shard_messages`` is each shard's total traffic, including traffic
+/// that cannot move (server-sharded firehoses); ``markets`` lists the
+/// movable markets. While the busiest shard is more than ``tolerance``
+/// above the mean, its heaviest market lighter than the gap to the idlest
+/// shard moves there, at most once per market. Pure function.
+[[nodiscard]] inline std::vector<PlannedMove>
+plan_rebalance(std::span<const MarketLoad> markets, std::span<const std::uint64_t> shard_messages,
+			   double tolerance, std::size_t max_moves) {
+	std::vector<PlannedMove> moves;
+	if (shard_messages.size() < 2) {
+		return moves;
+	}
+	std::vector<std::uint64_t> load(shard_messages.begin(), shard_messages.end());
+	const double mean =
+		static_cast<double>(std::accumulate(load.begin(), load.end(), std::uint64_t{0})) /
+		static_cast<double>(load.size());
+	std::vector<bool> moved(markets.size(), false);
+
+	while (moves.size() < max_moves) {
+		const std::size_t hot =
+			static_cast<std::size_t>(std::max_element(load.begin(), load.end()) - load.begin());
+		const std::size_t cold =
+			static_cast<std::size_t>(std::min_element(load.begin(), load.end()) - load.begin());
+		if (static_cast<double>(load[hot]) <= mean * (1.0 + tolerance)) {
+			break;
+		}
+
+		// Moving m.messages < gap strictly lowers the larger of the two.
+		const std::uint64_t gap = load[hot] - load[cold];
+		std::size_t pick = markets.size();
+		for (std::size_t i = 0; i < markets.size(); ++i) {
+			const MarketLoad& market = markets[i];
+			if (moved[i] || market.shard != hot || market.messages == 0 ||
+				market.messages >= gap) {
+				continue;
+			}
+			if (pick == markets.size() || market.messages > markets[pick].messages) {
+				pick = i;
+			}
+		}
+		if (pick == markets.size()) {
+			break;
+		}
+
+		moved[pick] = true;
+		load[hot] -= markets[pick].messages;
+		load[cold] += markets[pick].messages;
+		moves.push_back(PlannedMove{.market = pick, .from = hot, .to = cold});
+	}
+	return moves;
+}
+
+} // namespace kalshi::ws_detail
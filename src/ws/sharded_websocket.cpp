@@ -0,0 +1,636 @@
+#include "kalshi/sharded_websocket.hpp"
+
+#include "shard_balancer.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+
+namespace kalshi {
+
+namespace {
+
+Error moved_from_error() {
+	return Error::network("ShardedWebSocketClient moved-from");
+}
+
+std::uint32_t ticker_of(const WsMessage& message) noexcept {
+	return std::visit([](const auto& typed) { return typed.ticker_id.value; }, message);
+}
+
+} // namespace
+
+struct ShardedWebSocketClient::Impl {
+	struct Handle {
+		Channel channel{Channel::OrderbookDelta};
+		/// Placed per market and eligible for rebalancing; false for
+		/// firehose and shard-0-only subscriptions
+		bool placed{true};
+		std::vector<std::optional<SubscriptionId>> per_shard;
+		std::unordered_set<std::string> tickers;
+	};
+
+	ShardedWsConfig config;
+
+	// Subscription bookkeeping, guarded by `state_mutex`. Only user threads
+	// take it; lock it before `merge_mutex` when both are needed.
+	std::mutex state_mutex;
+	std::unordered_map<std::string, std::size_t> placement;
+	std::map<std::int32_t, Handle> handles;
+	std::int32_t next_handle{1};
+
+	// Merged stream, guarded by `merge_mutex`: taken by every service
+	// thread for callbacks and by `poll` for the load counters.
+	mutable std::mutex merge_mutex;
+	WsMessageCallback message_callback;
+	WsErrorCallback error_callback;
+	ShardStateCallback state_callback;
+	WsSeqGapCallback gap_callback;
+	ShardBackpressureCallback backpressure_callback;
+	std::unordered_map<std::uint32_t, std::uint64_t> market_messages;
+	std::vector<std::uint64_t> shard_messages;
+	std::size_t next_poll{0};
+
+	// Last, so the connections (whose callbacks use everything above) shut
+	// down first.
+	std::vector<WebSocketClient> shards;
+
+	Impl(const Signer& signer, ShardedWsConfig cfg) : config(std::move(cfg)) {
+		config.shards = std::max<std::size_t>(config.shards, 1);
+		// Shards merge through on_message / poll; compact events have no
+		// merged path, so every message keeps its rich form here.
+		config.connection.compact_events = false;
+		if (config.connection.service_mode == WsServiceMode::External) {
+			config.connection.service_mode = WsServiceMode::Blocking;
+		}
+		if (!config.connection.ticker_table) {
+			config.connection.ticker_table = std::make_shared<TickerTable>();
+		}
+		shard_messages.assign(config.shards, 0);
+		shards.reserve(config.shards);
+		for (std::size_t i = 0; i < config.shards; ++i) {
+			WsConfig connection = config.connection;
+			if (i < config.service_cpus.size()) {
+				connection.service_cpu = config.service_cpus[i];
+			}
+			shards.emplace_back(signer, std::move(connection));
+			WebSocketClient& shard = shards.back();
+			shard.on_message([this, i](const WsMessage& message) { deliver(i, message); });
+			shard.on_error([this](const WsError& error) {
+				std::lock_guard<std::mutex> lock(merge_mutex);
+				if (error_callback) {
+					error_callback(error);
+				}
+			});
+			shard.on_state_change([this, i](bool connected) {
+				std::lock_guard<std::mutex> lock(merge_mutex);
+				if (state_callback) {
+					state_callback(i, connected);
+				}
+			});
+			shard.on_sequence_gap([this](const WsSeqGap& gap) {
+				std::lock_guard<std::mutex> lock(merge_mutex);
+				if (gap_callback) {
+					gap_callback(gap);
+				}
+			});
+			shard.on_backpressure([this, i](const WsBackpressure& backpressure) {
+				std::lock_guard<std::mutex> lock(merge_mutex);
+				if (backpressure_callback) {
+					backpressure_callback(i, backpressure);
+				}
+			});
+		}
+	}
+
+	// Caller holds `merge_mutex`.
+	void count(std::size_t shard, const WsMessage& message) {
+		++shard_messages[shard];
+		const std::uint32_t ticker = ticker_of(message);
+		if (ticker != TickerId::kInvalid) {
+			++market_messages[ticker];
+		}
+	}
+
+	void deliver(std::size_t shard, const WsMessage& message) {
+		std::lock_guard<std::mutex> lock(merge_mutex);
+		count(shard, message);
+		if (message_callback) {
+			message_callback(message);
+		}
+	}
+
+	// Caller holds `state_mutex`. Shard carrying `ticker`, placing it on
+	// first use.
+	std::size_t place(const std::string& ticker) {
+		return placement.try_emplace(ticker, ws_detail::shard_of(ticker, shards.size()))
+			.first->second;
+	}
+
+	// Caller holds `state_mutex`. Subscribes `channel` for `tickers` on
+	// `shard`, or adds them to the handle's subscription already there.
+	Result<void> add_on_shard(Handle& handle, std::size_t shard,
+							  const std::vector<std::string>& tickers) {
+		if (handle.per_shard[shard]) {
+			return shards[shard].add_markets(*handle.per_shard[shard], tickers);
+		}
+		Result<SubscriptionId> sub = shards[shard].subscribe(handle.channel, tickers);
+		if (!sub) {
+			return std::unexpected(sub.error());
+		}
+		handle.per_shard[shard] = *sub;
+		return {};
+	}
+
+	// Caller holds `state_mutex`.
+	void unsubscribe_all(Handle& handle) {
+		for (std::size_t i = 0; i < handle.per_shard.size(); ++i) {
+			if (handle.per_shard[i]) {
+				(void)shards[i].unsubscribe(*handle.per_shard[i]);
+			}
+		}
+	}
+
+	Result<ShardedSubscription> add_handle(Handle handle) {
+		const std::int32_t id = next_handle++;
+		const Channel channel = handle.channel;
+		handles.emplace(id, std::move(handle));
+		return ShardedSubscription{.id = id, .channel = channel};
+	}
+
+	Result<ShardedSubscription> subscribe_placed(Channel channel,
+												 const std::vector<std::string>& tickers) {
+		std::lock_guard<std::mutex> lock(state_mutex);
+		std::vector<std::vector<std::string>> groups(shards.size());
+		for (const std::string& ticker : tickers) {
+			groups[place(ticker)].push_back(ticker);
+		}
+
+		Handle handle{.channel = channel, .placed = true, .per_shard = {}, .tickers = {}};
+		handle.per_shard.resize(shards.size());
+		for (std::size_t i = 0; i < groups.size(); ++i) {
+			if (groups[i].empty()) {
+				continue;
+			}
+			Result<void> added = add_on_shard(handle, i, groups[i]);
+			if (!added) {
+				unsubscribe_all(handle);
+				return std::unexpected(added.error());
+			}
+		}
+		handle.tickers.insert(tickers.begin(), tickers.end());
+		return add_handle(std::move(handle));
+	}
+
+	Result<ShardedSubscription> subscribe_firehose(Channel channel) {
+		std::lock_guard<std::mutex> lock(state_mutex);
+		Handle handle{.channel = channel, .placed = false, .per_shard = {}, .tickers = {}};
+		handle.per_shard.resize(shards.size());
+		const bool split = config.server_sharding && shards.size() > 1;
+		const std::size_t count = split ? shards.size() : 1;
+		for (std::size_t i = 0; i < count; ++i) {
+			const std::optional<WsShard> shard =
+				split ? std::optional<WsShard>(WsShard{.factor = static_cast<std::int32_t>(count),
+													   .key = static_cast<std::int32_t>(i)})
+					  : std::nullopt;
+			Result<SubscriptionId> sub = shards[i].subscribe(channel, {}, shard);
+			if (!sub) {
+				unsubscribe_all(handle);
+				return std::unexpected(sub.error());
+			}
+			handle.per_shard[i] = *sub;
+		}
+		return add_handle(std::move(handle));
+	}
+
+	// Shard-0-only channels (fills, lifecycle).
+	Result<ShardedSubscription> subscribe_first(Channel channel,
+												const std::vector<std::string>& tickers) {
+		std::lock_guard<std::mutex> lock(state_mutex);
+		Result<SubscriptionId> sub = shards[0].subscribe(channel, tickers);
+		if (!sub) {
+			return std::unexpected(sub.error());
+		}
+		Handle handle{.channel = channel, .placed = false, .per_shard = {}, .tickers = {}};
+		handle.per_shard.resize(shards.size());
+		handle.per_shard[0] = *sub;
+		handle.tickers.insert(tickers.begin(), tickers.end());
+		return add_handle(std::move(handle));
+	}
+
+	// Caller holds `state_mutex`. Re-homes `ticker` from `from` to `to` on
+	// every placed subscription carrying it: adds first, then removes, so
+	// the market is never unsubscribed in between.
+	bool move_market(const std::string& ticker, std::size_t from, std::size_t to) {
+		std::vector<Handle*> carrying;
+		for (std::pair<const std::int32_t, Handle>& entry : handles) {
+			if (entry.second.placed && entry.second.tickers.contains(ticker)) {
+				carrying.push_back(&entry.second);
+			}
+		}
+		const std::vector<std::string> tickers{ticker};
+		for (std::size_t i = 0; i < carrying.size(); ++i) {
+			if (!add_on_shard(*carrying[i], to, tickers)) {
+				for (std::size_t j = 0; j < i; ++j) {
+					(void)shards[to].remove_markets(*carrying[j]->per_shard[to], tickers);
+				}
+				return false;
+			}
+		}
+		for (Handle* handle : carrying) {
+			if (handle->per_shard[from]) {
+				(void)shards[from].remove_markets(*handle->per_shard[from], tickers);
+			}
+		}
+		placement[ticker] = to;
+		return true;
+	}
+};
+
+ShardedWebSocketClient::ShardedWebSocketClient(const Signer& signer, ShardedWsConfig config)
+	: impl_(std::make_unique<Impl>(signer, std::move(config))) {}
+
+ShardedWebSocketClient::~ShardedWebSocketClient() {
+	disconnect();
+}
+
+ShardedWebSocketClient::ShardedWebSocketClient(ShardedWebSocketClient&&) noexcept = default;
+
+ShardedWebSocketClient&
+ShardedWebSocketClient::operator=(ShardedWebSocketClient&&) noexcept = default;
+
+Result<void> ShardedWebSocketClient::connect() {
+	if (!impl_) {
+		return std::unexpected(moved_from_error());
+	}
+	for (WebSocketClient& shard : impl_->shards) {
+		Result<void> connected = shard.connect();
+		if (!connected) {
+			disconnect();
+			return connected;
+		}
+	}
+	return {};
+}
+
+void ShardedWebSocketClient::disconnect() {
+	if (!impl_) {
+		return;
+	}
+	for (WebSocketClient& shard : impl_->shards) {
+		shard.disconnect();
+	}
+}
+
+bool ShardedWebSocketClient::is_connected() const noexcept {
+	if (!impl_) {
+		return false;
+	}
+	return std::all_of(impl_->shards.begin(), impl_->shards.end(),
+					   [](const WebSocketClient& shard) { return shard.is_connected(); });
+}
+
+std::size_t ShardedWebSocketClient::shard_count() const noexcept {
+	return impl_ ? impl_->shards.size() : 0;
+}
+
+std::size_t ShardedWebSocketClient::shard_for(std::string_view ticker) const {
+	if (!impl_) {
+		return 0;
+	}
+	std::lock_guard<std::mutex> lock(impl_->state_mutex);
+	const std::unordered_map<std::string, std::size_t>::const_iterator placed =
+		impl_->placement.find(std::string(ticker));
+	return placed != impl_->placement.end() ? placed->second
+											: ws_detail::shard_of(ticker, impl_->shards.size());
+}
+
+Result<ShardedSubscription>
+ShardedWebSocketClient::subscribe_orderbook(const std::vector<std::string>& market_tickers) {
+	if (!impl_) {
+		return std::unexpected(moved_from_error());
+	}
+	if (market_tickers.empty()) {
+		return impl_->subscribe_firehose(Channel::OrderbookDelta);
+	}
+	return impl_->subscribe_placed(Channel::OrderbookDelta, market_tickers);
+}
+
+Result<ShardedSubscription>
+ShardedWebSocketClient::subscribe_trades(const std::vector<std::string>& market_tickers) {
+	if (!impl_) {
+		return std::unexpected(moved_from_error());
+	}
+	if (market_tickers.empty()) {
+		return impl_->subscribe_firehose(Channel::Trade);
+	}
+	return impl_->subscribe_placed(Channel::Trade, market_tickers);
+}
+
+Result<ShardedSubscription>
+ShardedWebSocketClient::subscribe_fills(const std::vector<std::string>& market_tickers) {
+	if (!impl_) {
+		return std::unexpected(moved_from_error());
+	}
+	return impl_->subscribe_first(Channel::Fill, market_tickers);
+}
+
+Result<ShardedSubscription> ShardedWebSocketClient::subscribe_lifecycle() {
+	if (!impl_) {
+		return std::unexpected(moved_from_error());
+	}
+	return impl_->subscribe_first(Channel::MarketLifecycle, {});
+}
+
+Result<void> ShardedWebSocketClient::unsubscribe(ShardedSubscription sub) {
+	if (!impl_) {
+		return std::unexpected(moved_from_error());
+	}
+	std::lock_guard<std::mutex> lock(impl_->state_mutex);
+	std::map<std::int32_t, Impl::Handle>::iterator handle = impl_->handles.find(sub.id);
+	if (handle == impl_->handles.end()) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "Unknown sharded subscription"});
+	}
+
+	Result<void> result;
+	for (std::size_t i = 0; i < handle->second.per_shard.size(); ++i) {
+		if (!handle->second.per_shard[i]) {
+			continue;
+		}
+		Result<void> removed = impl_->shards[i].unsubscribe(*handle->second.per_shard[i]);
+		if (!removed && result) {
+			result = removed;
+		}
+	}
+	impl_->handles.erase(handle);
+	return result;
+}
+
+Result<void> ShardedWebSocketClient::add_markets(ShardedSubscription sub,
+												 const std::vector<std::string>& market_tickers) {
+	if (!impl_) {
+		return std::unexpected(moved_from_error());
+	}
+	if (market_tickers.empty()) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "market_tickers required"});
+	}
+	std::lock_guard<std::mutex> lock(impl_->state_mutex);
+	std::map<std::int32_t, Impl::Handle>::iterator found = impl_->handles.find(sub.id);
+	if (found == impl_->handles.end()) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "Unknown sharded subscription"});
+	}
+	Impl::Handle& handle = found->second;
+
+	if (!handle.placed) {
+		if (!handle.per_shard[0] || handle.tickers.empty()) {
+			return std::unexpected(
+				Error{ErrorCode::InvalidRequest, "Subscription already covers every market"});
+		}
+		Result<void> added = impl_->shards[0].add_markets(*handle.per_shard[0], market_tickers);
+		if (added) {
+			handle.tickers.insert(market_tickers.begin(), market_tickers.end());
+		}
+		return added;
+	}
+
+	std::vector<std::vector<std::string>> groups(impl_->shards.size());
+	for (const std::string& ticker : market_tickers) {
+		if (!handle.tickers.contains(ticker)) {
+			groups[impl_->place(ticker)].push_back(ticker);
+		}
+	}
+	for (std::size_t i = 0; i < groups.size(); ++i) {
+		if (groups[i].empty()) {
+			continue;
+		}
+		Result<void> added = impl_->add_on_shard(handle, i, groups[i]);
+		if (!added) {
+			return added;
+		}
+		handle.tickers.insert(groups[i].begin(), groups[i].end());
+	}
+	return {};
+}
+
+Result<void>
+ShardedWebSocketClient::remove_markets(ShardedSubscription sub,
+									   const std::vector<std::string>& market_tickers) {
+	if (!impl_) {
+		return std::unexpected(moved_from_error());
+	}
+	if (market_tickers.empty()) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "market_tickers required"});
+	}
+	std::lock_guard<std::mutex> lock(impl_->state_mutex);
+	std::map<std::int32_t, Impl::Handle>::iterator found = impl_->handles.find(sub.id);
+	if (found == impl_->handles.end()) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "Unknown sharded subscription"});
+	}
+	Impl::Handle& handle = found->second;
+
+	std::vector<std::vector<std::string>> groups(impl_->shards.size());
+	for (const std::string& ticker : market_tickers) {
+		if (handle.tickers.contains(ticker)) {
+			groups[handle.placed ? impl_->place(ticker) : 0].push_back(ticker);
+		}
+	}
+	for (std::size_t i = 0; i < groups.size(); ++i) {
+		if (groups[i].empty() || !handle.per_shard[i]) {
+			continue;
+		}
+		Result<void> removed = impl_->shards[i].remove_markets(*handle.per_shard[i], groups[i]);
+		if (!removed) {
+			return removed;
+		}
+		for (const std::string& ticker : groups[i]) {
+			handle.tickers.erase(ticker);
+		}
+	}
+	return {};
+}
+
+void ShardedWebSocketClient::on_message(WsMessageCallback callback) {
+	if (!impl_) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(impl_->merge_mutex);
+	impl_->message_callback = std::move(callback);
+}
+
+void ShardedWebSocketClient::on_error(WsErrorCallback callback) {
+	if (!impl_) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(impl_->merge_mutex);
+	impl_->error_callback = std::move(callback);
+}
+
+void ShardedWebSocketClient::on_state_change(ShardStateCallback callback) {
+	if (!impl_) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(impl_->merge_mutex);
+	impl_->state_callback = std::move(callback);
+}
+
+void ShardedWebSocketClient::on_sequence_gap(WsSeqGapCallback callback) {
+	if (!impl_) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(impl_->merge_mutex);
+	impl_->gap_callback = std::move(callback);
+}
+
+void ShardedWebSocketClient::on_backpressure(ShardBackpressureCallback callback) {
+	if (!impl_) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(impl_->merge_mutex);
+	impl_->backpressure_callback = std::move(callback);
+}
+
+std::size_t ShardedWebSocketClient::poll(std::span<WsMessage> out) {
+	if (!impl_ || out.empty()) {
+		return 0;
+	}
+	std::vector<WebSocketClient>& shards = impl_->shards;
+	std::lock_guard<std::mutex> lock(impl_->merge_mutex);
+
+	// First pass gives each shard an equal share, starting one shard later
+	// every call; the second lets busy shards fill what the idle ones left.
+	const std::size_t share = (out.size() + shards.size() - 1) / shards.size();
+	const std::size_t start = impl_->next_poll;
+	impl_->next_poll = (start + 1) % shards.size();
+	std::size_t filled = 0;
+	for (std::size_t pass = 0; pass < 2 && filled < out.size(); ++pass) {
+		for (std::size_t step = 0; step < shards.size() && filled < out.size(); ++step) {
+			const std::size_t shard = (start + step) % shards.size();
+			const std::size_t room = out.size() - filled;
+			const std::size_t n = shards[shard].poll(
+				out.subspan(filled, pass == 0 ? std::min(share, room) : room));
+			for (std::size_t i = filled; i < filled + n; ++i) {
+				impl_->count(shard, out[i]);
+			}
+			filled += n;
+		}
+	}
+	return filled;
+}
+
+std::vector<ShardMove> ShardedWebSocketClient::rebalance() {
+	std::vector<ShardMove> moves;
+	if (!impl_) {
+		return moves;
+	}
+
+	std::unordered_map<std::uint32_t, std::uint64_t> counts;
+	std::vector<std::uint64_t> totals;
+	{
+		std::lock_guard<std::mutex> lock(impl_->merge_mutex);
+		counts.swap(impl_->market_messages);
+		totals = impl_->shard_messages;
+		std::fill(impl_->shard_messages.begin(), impl_->shard_messages.end(), 0);
+	}
+
+	std::lock_guard<std::mutex> lock(impl_->state_mutex);
+	const TickerTable& table = *impl_->config.connection.ticker_table;
+	std::vector<ws_detail::MarketLoad> loads;
+	std::vector<const std::string*> names;
+	for (const std::pair<const std::string, std::size_t>& placed : impl_->placement) {
+		const std::optional<TickerId> id = table.find(placed.first);
+		if (!id) {
+			continue;
+		}
+		const std::unordered_map<std::uint32_t, std::uint64_t>::const_iterator count =
+			counts.find(id->value);
+		if (count == counts.end()) {
+			continue;
+		}
+		loads.push_back(ws_detail::MarketLoad{
+			.ticker = id->value, .shard = placed.second, .messages = count->second});
+		names.push_back(&placed.first);
+	}
+
+	const std::vector<ws_detail::PlannedMove> plan =
+		ws_detail::plan_rebalance(loads, totals, impl_->config.rebalance_tolerance,
+								  impl_->config.max_moves_per_rebalance);
+	for (const ws_detail::PlannedMove& move : plan) {
+		// Copy first: move_market rewrites the placement entry.
+		std::string ticker = *names[move.market];
+		if (impl_->move_market(ticker, move.from, move.to)) {
+			moves.push_back(
+				ShardMove{.ticker = std::move(ticker), .from = move.from, .to = move.to});
+		}
+	}
+	return moves;
+}
+
+std::vector<std::uint64_t> ShardedWebSocketClient::shard_load() const {
+	if (!impl_) {
+		return {};
+	}
+	std::lock_guard<std::mutex> lock(impl_->merge_mutex);
+	return impl_->shard_messages;
+}
+
+std::vector<WsQueueStats> ShardedWebSocketClient::queue_stats() const {
+	std::vector<WsQueueStats> stats;
+	if (!impl_) {
+		return stats;
+	}
+	stats.reserve(impl_->shards.size());
+	for (const WebSocketClient& shard : impl_->shards) {
+		stats.push_back(shard.queue_stats());
+	}
+	return stats;
+}
+
+std::vector<WsCompressionStats> ShardedWebSocketClient::compression_stats() const {
+	std::vector<WsCompressionStats> stats;
+	if (!impl_) {
+		return stats;
+	}
+	stats.reserve(impl_->shards.size());
+	for (const WebSocketClient& shard : impl_->shards) {
+		stats.push_back(shard.compression_stats());
+	}
+	return stats;
+}
+
+std::vector<WsPipelineStats> ShardedWebSocketClient::pipeline_stats() const {
+	std::vector<WsPipelineStats> stats;
+	if (!impl_) {
+		return stats;
+	}
+	stats.reserve(impl_->shards.size());
+	for (const WebSocketClient& shard : impl_->shards) {
+		stats.push_back(shard.pipeline_stats());
+	}
+	return stats;
+}
+
+std::vector<WsOverflowStats> ShardedWebSocketClient::overflow_stats() const {
+	std::vector<WsOverflowStats> stats;
+	if (!impl_) {
+		return stats;
+	}
+	stats.reserve(impl_->shards.size());
+	for (const WebSocketClient& shard : impl_->shards) {
+		stats.push_back(shard.overflow_stats());
+	}
+	return stats;
+}
+
+std::shared_ptr<TickerTable> ShardedWebSocketClient::ticker_table() const noexcept {
+	if (!impl_) {
+		return nullptr;
+	}
+	return impl_->config.connection.ticker_table;
+}
+
+} // namespace kalshi
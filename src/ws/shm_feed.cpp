@@ -0,0 +1,616 @@
+#include "kalshi/shm_feed.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kalshi {
+
+namespace {
+
+// Segment layout. Every region starts on a cache line; the header's
+// writer-owned counters sit on their own lines so readers polling them
+// do not share a line with anything the writer touches per event.
+//
+//   SegmentHeader | EventSlot[event_capacity] | BookSlot[max_markets] | NameSlot[max_markets]
+//
+// Everything a reader can observe while the writer changes it is an
+// atomic; the only plain bytes are ticker names, which are written once
+// before their length is published.
+
+constexpr char kShmMagic[8] = {'K', 'X', 'S', 'H', 'M', 'F', 'D', '1'};
+constexpr std::uint32_t kShmVersion = 1;
+constexpr std::uint64_t kSlotBusy = ~std::uint64_t{0};
+constexpr std::size_t kEventWords = sizeof(WsEvent) / sizeof(std::uint64_t);
+constexpr std::size_t kMaxName = kShmMaxTickerName;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+				  std::atomic<std::uint32_t>::is_always_lock_free &&
+				  std::atomic<std::int64_t>::is_always_lock_free,
+			  "Shared-memory atomics must be lock-free to work across processes");
+
+struct SegmentHeader {
+	char magic[8];
+	/// Stored last (release) once the segment is initialized
+	std::atomic<std::uint32_t> version;
+	std::uint32_t header_size;
+	std::uint64_t event_capacity;
+	std::uint64_t max_markets;
+	std::uint64_t events_offset;
+	std::uint64_t books_offset;
+	std::uint64_t names_offset;
+	std::uint64_t total_size;
+
+	alignas(64) std::atomic<std::uint64_t> published; ///< Events fully written
+	alignas(64) std::atomic<std::uint32_t> alive;
+};
+
+/// One ring entry. ``seq`` is n + 1 once event n is complete, and
+/// ``kSlotBusy`` while it is being overwritten. The event is stored as
+/// relaxed atomic words so a racing reader's copy is well-defined; it is
+/// then discarded if ``seq`` moved.
+struct alignas(64) EventSlot {
+	std::atomic<std::uint64_t> seq;
+	std::atomic<std::uint64_t> words[kEventWords];
+};
+
+/// Seqlock-protected top of book: ``seq`` is odd while the writer is
+/// inside, and counts two per publish.
+struct alignas(64) BookSlot {
+	std::atomic<std::uint32_t> seq;
+	std::atomic<std::uint32_t> valid;
+	std::atomic<std::int32_t> yes_price;
+	std::atomic<std::int32_t> yes_quantity;
+	std::atomic<std::int32_t> no_price;
+	std::atomic<std::int32_t> no_quantity;
+	std::atomic<std::int32_t> last_seq;
+	std::atomic<std::int64_t> updated_ns;
+};
+
+/// Ticker name, published by storing ``length`` after the bytes
+struct alignas(64) NameSlot {
+	std::atomic<std::uint32_t> length;
+	char name[kMaxName + 1];
+};
+
+static_assert(sizeof(EventSlot) == 128);
+static_assert(sizeof(BookSlot) == 64);
+static_assert(sizeof(NameSlot) == 64);
+
+constexpr std::size_t align_up(std::size_t n) noexcept {
+	return (n + 63) & ~std::size_t{63};
+}
+
+/// A mapped segment: base pointer plus typed views of its regions
+struct Mapping {
+	void* base{nullptr};
+	std::size_t size{0};
+
+	[[nodiscard]] SegmentHeader* header() const noexcept {
+		return static_cast<SegmentHeader*>(base);
+	}
+	[[nodiscard]] EventSlot* events() const noexcept {
+		return reinterpret_cast<EventSlot*>(static_cast<char*>(base) + header()->events_offset);
+	}
+	[[nodiscard]] BookSlot* books() const noexcept {
+		return reinterpret_cast<BookSlot*>(static_cast<char*>(base) + header()->books_offset);
+	}
+	[[nodiscard]] NameSlot* names() const noexcept {
+		return reinterpret_cast<NameSlot*>(static_cast<char*>(base) + header()->names_offset);
+	}
+
+	Mapping() = default;
+	Mapping(void* b, std::size_t s) noexcept : base(b), size(s) {}
+	Mapping(Mapping&& other) noexcept
+		: base(std::exchange(other.base, nullptr)), size(std::exchange(other.size, 0)) {}
+	Mapping& operator=(Mapping&&) = delete;
+	Mapping(const Mapping&) = delete;
+	Mapping& operator=(const Mapping&) = delete;
+
+	~Mapping() {
+#if !defined(_WIN32)
+		if (base != nullptr) {
+			::munmap(base, size);
+		}
+#endif
+	}
+};
+
+std::int64_t now_ns() noexcept {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			   std::chrono::system_clock::now().time_since_epoch())
+		.count();
+}
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__)
+	asm volatile("yield");
+#endif
+}
+
+} // namespace
+
+// ===== ShmFeedWriter =====
+
+struct ShmFeedWriter::Impl {
+	ShmFeedConfig config;
+	Mapping mapping;
+	SegmentHeader* header{nullptr};
+	EventSlot* events{nullptr};
+	BookSlot* books{nullptr};
+	NameSlot* names{nullptr};
+	std::uint64_t mask{0};
+	std::uint64_t next{0};
+
+	Impl(ShmFeedConfig c, Mapping m) : config(std::move(c)), mapping(std::move(m)) {
+		header = mapping.header();
+		events = mapping.events();
+		books = mapping.books();
+		names = mapping.names();
+		mask = header->event_capacity - 1;
+	}
+
+	~Impl() {
+#if !defined(_WIN32)
+		if (header != nullptr) {
+			header->alive.store(0, std::memory_order_release);
+			::shm_unlink(config.name.c_str());
+		}
+#endif
+	}
+};
+
+Result<ShmFeedWriter> ShmFeedWriter::create(ShmFeedConfig config) {
+#if defined(_WIN32)
+	(void)config;
+	return std::unexpected(
+		Error{ErrorCode::InvalidRequest, "Shared-memory feeds are not supported on this platform"});
+#else
+	if (config.name.size() < 2 || config.name.front() != '/' ||
+		config.name.find('/', 1) != std::string::npos) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest,
+									 "Shared-memory name must be \"/name\": " + config.name});
+	}
+	if (config.max_markets == 0) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "max_markets must be positive"});
+	}
+	config.event_capacity = std::bit_ceil(std::max<std::size_t>(config.event_capacity, 2));
+
+	const std::size_t events_offset = align_up(sizeof(SegmentHeader));
+	const std::size_t books_offset = events_offset + config.event_capacity * sizeof(EventSlot);
+	const std::size_t names_offset = books_offset + config.max_markets * sizeof(BookSlot);
+	const std::size_t total = names_offset + config.max_markets * sizeof(NameSlot);
+
+	// A segment left behind by a crashed publisher is replaced; its readers
+	// keep their old mapping and see it stop advancing.
+	::shm_unlink(config.name.c_str());
+	const int fd = ::shm_open(config.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest,
+									 "Failed to create shared-memory segment: " + config.name});
+	}
+	void* base = MAP_FAILED;
+	if (::ftruncate(fd, static_cast<off_t>(total)) == 0) {
+		base = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	}
+	::close(fd);
+	if (base == MAP_FAILED) {
+		::shm_unlink(config.name.c_str());
+		return std::unexpected(Error{ErrorCode::InvalidRequest,
+									 "Failed to map shared-memory segment: " + config.name});
+	}
+
+	SegmentHeader* header = new (base) SegmentHeader{};
+	header->header_size = sizeof(SegmentHeader);
+	header->event_capacity = config.event_capacity;
+	header->max_markets = config.max_markets;
+	header->events_offset = events_offset;
+	header->books_offset = books_offset;
+	header->names_offset = names_offset;
+	header->total_size = total;
+	header->alive.store(1, std::memory_order_relaxed);
+	char* bytes = static_cast<char*>(base);
+	std::uninitialized_value_construct_n(reinterpret_cast<EventSlot*>(bytes + events_offset),
+										 config.event_capacity);
+	std::uninitialized_value_construct_n(reinterpret_cast<BookSlot*>(bytes + books_offset),
+										 config.max_markets);
+	std::uninitialized_value_construct_n(reinterpret_cast<NameSlot*>(bytes + names_offset),
+										 config.max_markets);
+	std::memcpy(header->magic, kShmMagic, sizeof(kShmMagic));
+	header->version.store(kShmVersion, std::memory_order_release);
+
+	return ShmFeedWriter(std::make_unique<Impl>(std::move(config), Mapping{base, total}));
+#endif
+}
+
+ShmFeedWriter::ShmFeedWriter(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+ShmFeedWriter::~ShmFeedWriter() = default;
+ShmFeedWriter::ShmFeedWriter(ShmFeedWriter&&) noexcept = default;
+ShmFeedWriter& ShmFeedWriter::operator=(ShmFeedWriter&&) noexcept = default;
+
+bool ShmFeedWriter::register_ticker(TickerId id, std::string_view ticker) noexcept {
+	if (!impl_ || !id.valid() || id.value >= impl_->config.max_markets || ticker.empty() ||
+		ticker.size() > kMaxName) {
+		return false;
+	}
+	NameSlot& slot = impl_->names[id.value];
+	if (slot.length.load(std::memory_order_relaxed) != 0) {
+		return true;
+	}
+	std::memcpy(slot.name, ticker.data(), ticker.size());
+	slot.name[ticker.size()] = '\0';
+	slot.length.store(static_cast<std::uint32_t>(ticker.size()), std::memory_order_release);
+	return true;
+}
+
+void ShmFeedWriter::publish(const WsEvent& event) noexcept {
+	if (!impl_) {
+		return;
+	}
+	const std::uint64_t n = impl_->next++;
+	EventSlot& slot = impl_->events[n & impl_->mask];
+	std::uint64_t words[kEventWords];
+	std::memcpy(words, &event, sizeof(event));
+
+	slot.seq.store(kSlotBusy, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	for (std::size_t i = 0; i < kEventWords; ++i) {
+		slot.words[i].store(words[i], std::memory_order_relaxed);
+	}
+	slot.seq.store(n + 1, std::memory_order_release);
+	impl_->header->published.store(n + 1, std::memory_order_release);
+}
+
+void ShmFeedWriter::update_book(TickerId id, const OrderBookBook& book) noexcept {
+	if (!impl_ || !id.valid() || id.value >= impl_->config.max_markets) {
+		return;
+	}
+	const std::optional<OrderBookEntry> yes = book.best_bid(Side::Yes);
+	const std::optional<OrderBookEntry> no = book.best_bid(Side::No);
+	const std::int64_t stamp = now_ns();
+
+	BookSlot& slot = impl_->books[id.value];
+	const std::uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+	slot.seq.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.valid.store(book.valid() ? 1 : 0, std::memory_order_relaxed);
+	slot.yes_price.store(yes ? yes->price_cents : 0, std::memory_order_relaxed);
+	slot.yes_quantity.store(yes ? yes->quantity : 0, std::memory_order_relaxed);
+	slot.no_price.store(no ? no->price_cents : 0, std::memory_order_relaxed);
+	slot.no_quantity.store(no ? no->quantity : 0, std::memory_order_relaxed);
+	slot.last_seq.store(book.last_seq(), std::memory_order_relaxed);
+	slot.updated_ns.store(stamp, std::memory_order_relaxed);
+	slot.seq.store(seq + 2, std::memory_order_release);
+}
+
+std::uint64_t ShmFeedWriter::published() const noexcept {
+	return impl_ ? impl_->next : 0;
+}
+
+const ShmFeedConfig& ShmFeedWriter::config() const noexcept {
+	static const ShmFeedConfig empty{};
+	return impl_ ? impl_->config : empty;
+}
+
+// ===== ShmFeedReader =====
+
+struct ShmFeedReader::Impl {
+	Mapping mapping;
+	const SegmentHeader* header{nullptr};
+	const EventSlot* events{nullptr};
+	const BookSlot* books{nullptr};
+	const NameSlot* names{nullptr};
+	std::uint64_t capacity{0};
+	std::uint64_t max_markets{0};
+	std::uint64_t next{0};
+	ShmFeedReaderStats stats;
+
+	explicit Impl(Mapping m) : mapping(std::move(m)) {
+		header = mapping.header();
+		events = mapping.events();
+		books = mapping.books();
+		names = mapping.names();
+		capacity = header->event_capacity;
+		max_markets = header->max_markets;
+		next = header->published.load(std::memory_order_acquire);
+	}
+
+	/// Copy event ``n`` into ``out``; false if the writer has lapped it
+	bool read(std::uint64_t n, WsEvent& out) const noexcept {
+		const EventSlot& slot = events[n & (capacity - 1)];
+		if (slot.seq.load(std::memory_order_acquire) != n + 1) {
+			return false;
+		}
+		std::uint64_t words[kEventWords];
+		for (std::size_t i = 0; i < kEventWords; ++i) {
+			words[i] = slot.words[i].load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.seq.load(std::memory_order_relaxed) != n + 1) {
+			return false;
+		}
+		std::memcpy(&out, words, sizeof(out));
+		return true;
+	}
+};
+
+Result<ShmFeedReader> ShmFeedReader::open(const std::string& name) {
+#if defined(_WIN32)
+	(void)name;
+	return std::unexpected(
+		Error{ErrorCode::InvalidRequest, "Shared-memory feeds are not supported on this platform"});
+#else
+	const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+	if (fd < 0) {
+		return std::unexpected(
+			Error{ErrorCode::InvalidRequest, "Failed to open shared-memory segment: " + name});
+	}
+	struct stat st {};
+	void* base = MAP_FAILED;
+	if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(SegmentHeader)) {
+		base = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+	}
+	::close(fd);
+	if (base == MAP_FAILED) {
+		return std::unexpected(
+			Error{ErrorCode::InvalidRequest, "Failed to map shared-memory segment: " + name});
+	}
+	Mapping mapping{base, static_cast<std::size_t>(st.st_size)};
+
+	const SegmentHeader* header = mapping.header();
+	if (header->version.load(std::memory_order_acquire) != kShmVersion ||
+		std::memcmp(header->magic, kShmMagic, sizeof(kShmMagic)) != 0) {
+		return std::unexpected(Error::parse("Not a market data feed segment: " + name));
+	}
+	if (header->total_size > mapping.size || header->event_capacity == 0 ||
+		!std::has_single_bit(header->event_capacity) ||
+		header->names_offset + header->max_markets * sizeof(NameSlot) > header->total_size) {
+		return std::unexpected(Error::parse("Corrupt market data feed segment: " + name));
+	}
+	return ShmFeedReader(std::make_unique<Impl>(std::move(mapping)));
+#endif
+}
+
+ShmFeedReader::ShmFeedReader(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+ShmFeedReader::~ShmFeedReader() = default;
+ShmFeedReader::ShmFeedReader(ShmFeedReader&&) noexcept = default;
+ShmFeedReader& ShmFeedReader::operator=(ShmFeedReader&&) noexcept = default;
+
+std::size_t ShmFeedReader::poll(std::span<WsEvent> out) noexcept {
+	if (!impl_) {
+		return 0;
+	}
+	Impl& r = *impl_;
+	std::size_t count = 0;
+	std::uint64_t published = r.header->published.load(std::memory_order_acquire);
+	while (count < out.size() && r.next < published) {
+		if (published - r.next > r.capacity || !r.read(r.next, out[count])) {
+			// Lapped: resume at the oldest event the writer cannot be
+			// overwriting right now.
+			published = r.header->published.load(std::memory_order_acquire);
+			const std::uint64_t resume = std::max(r.next + 1, published - r.capacity + 1);
+			r.stats.overruns += resume - r.next;
+			r.next = resume;
+			continue;
+		}
+		++r.next;
+		++count;
+	}
+	r.stats.received += count;
+	return count;
+}
+
+void ShmFeedReader::seek_to_latest() noexcept {
+	if (impl_) {
+		impl_->next = impl_->header->published.load(std::memory_order_acquire);
+	}
+}
+
+std::optional<TopOfBook> ShmFeedReader::top_of_book(TickerId id) const noexcept {
+	if (!impl_ || !id.valid() || id.value >= impl_->max_markets) {
+		return std::nullopt;
+	}
+	const BookSlot& slot = impl_->books[id.value];
+	for (;;) {
+		const std::uint32_t before = slot.seq.load(std::memory_order_acquire);
+		if (before == 0) {
+			return std::nullopt;
+		}
+		if ((before & 1U) != 0) {
+			cpu_relax();
+			continue;
+		}
+		TopOfBook top;
+		top.ticker_id = id;
+		top.valid = slot.valid.load(std::memory_order_relaxed) != 0;
+		top.yes_bid = {slot.yes_price.load(std::memory_order_relaxed),
+					   slot.yes_quantity.load(std::memory_order_relaxed)};
+		top.no_bid = {slot.no_price.load(std::memory_order_relaxed),
+					  slot.no_quantity.load(std::memory_order_relaxed)};
+		top.seq = slot.last_seq.load(std::memory_order_relaxed);
+		top.updated_ns = slot.updated_ns.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.seq.load(std::memory_order_relaxed) == before) {
+			top.version = before / 2;
+			return top;
+		}
+	}
+}
+
+std::string_view ShmFeedReader::ticker_name(TickerId id) const noexcept {
+	if (!impl_ || !id.valid() || id.value >= impl_->max_markets) {
+		return {};
+	}
+	const NameSlot& slot = impl_->names[id.value];
+	const std::uint32_t length = slot.length.load(std::memory_order_acquire);
+	return {slot.name, std::min<std::size_t>(length, kMaxName)};
+}
+
+std::optional<TickerId> ShmFeedReader::find(std::string_view ticker) const noexcept {
+	if (!impl_ || ticker.empty() || ticker.size() > kMaxName) {
+		return std::nullopt;
+	}
+	for (std::uint64_t i = 0; i < impl_->max_markets; ++i) {
+		const TickerId id{static_cast<std::uint32_t>(i)};
+		if (ticker_name(id) == ticker) {
+			return id;
+		}
+	}
+	return std::nullopt;
+}
+
+bool ShmFeedReader::publisher_alive() const noexcept {
+	return impl_ && impl_->header->alive.load(std::memory_order_acquire) != 0;
+}
+
+ShmFeedReaderStats ShmFeedReader::stats() const noexcept {
+	return impl_ ? impl_->stats : ShmFeedReaderStats{};
+}
+
+// ===== ShmFeedPublisher =====
+
+struct ShmFeedPublisher::Impl {
+	ShmFeedWriter writer;
+	ShardedWebSocketClient client;
+	std::shared_ptr<TickerTable> tickers;
+	std::size_t max_markets;
+	std::vector<OrderBookBook> books; ///< Indexed by ticker_id
+	std::vector<std::int32_t> book_sid;
+	std::vector<bool> named;
+	WsMessageCallback local_callback;
+
+	Impl(ShmFeedWriter w, const Signer& signer, ShardedWsConfig ws)
+		: writer(std::move(w)), client(signer, ws), tickers(ws.connection.ticker_table),
+		  max_markets(writer.config().max_markets) {}
+
+	/// Book slot for ``id``, grown on first use; null past ``max_markets``
+	OrderBookBook* book(TickerId id) {
+		if (!id.valid() || id.value >= max_markets) {
+			return nullptr;
+		}
+		if (id.value >= books.size()) {
+			books.resize(static_cast<std::size_t>(id.value) + 1,
+						 OrderBookBook{SeqCheck::Monotonic});
+			book_sid.resize(books.size(), 0);
+		}
+		return &books[id.value];
+	}
+
+	void name(TickerId id, std::string_view ticker) {
+		if (!id.valid() || id.value >= max_markets) {
+			return;
+		}
+		if (id.value >= named.size()) {
+			named.resize(static_cast<std::size_t>(id.value) + 1, false);
+		}
+		if (!named[id.value]) {
+			named[id.value] = true;
+			writer.register_ticker(id, ticker.empty() ? tickers->name(id) : ticker);
+		}
+	}
+
+	void handle(const WsMessage& message) {
+		std::visit(
+			[&](const auto& m) {
+				using T = std::decay_t<decltype(m)>;
+				if constexpr (std::is_same_v<T, OrderbookSnapshot>) {
+					name(m.ticker_id, m.market_ticker);
+					if (OrderBookBook* b = book(m.ticker_id)) {
+						b->apply(m);
+						book_sid[m.ticker_id.value] = m.sid;
+						writer.update_book(m.ticker_id, *b);
+					}
+				} else if constexpr (std::is_same_v<T, OrderbookDelta>) {
+					name(m.ticker_id, m.market_ticker);
+					if (OrderBookBook* b = book(m.ticker_id)) {
+						const BookUpdate result = b->apply(m);
+						if (result == BookUpdate::Applied || result == BookUpdate::Gap) {
+							writer.update_book(m.ticker_id, *b);
+						}
+					}
+				} else if constexpr (std::is_same_v<T, WsTrade> || std::is_same_v<T, WsFill>) {
+					name(m.ticker_id, m.market_ticker);
+				}
+			},
+			message);
+		if (const std::optional<WsEvent> event = to_event(message)) {
+			writer.publish(*event);
+		}
+		if (local_callback) {
+			local_callback(message);
+		}
+	}
+
+	/// Every market on the gapped subscription is suspect; drop their
+	/// books until the resync snapshots arrive.
+	void handle_gap(const WsSeqGap& gap) {
+		for (std::size_t i = 0; i < books.size(); ++i) {
+			if (book_sid[i] == gap.sid && books[i].valid()) {
+				books[i].clear();
+				writer.update_book(TickerId{static_cast<std::uint32_t>(i)}, books[i]);
+			}
+		}
+	}
+};
+
+Result<ShmFeedPublisher> ShmFeedPublisher::create(const Signer& signer,
+												  ShmFeedPublisherConfig config) {
+	Result<ShmFeedWriter> writer = ShmFeedWriter::create(std::move(config.feed));
+	if (!writer) {
+		return std::unexpected(writer.error());
+	}
+	config.ws.connection.message_queue_capacity = 0;
+	if (!config.ws.connection.ticker_table) {
+		config.ws.connection.ticker_table = std::make_shared<TickerTable>();
+	}
+	std::unique_ptr<Impl> impl =
+		std::make_unique<Impl>(std::move(*writer), signer, std::move(config.ws));
+	Impl* self = impl.get();
+	impl->client.on_message([self](const WsMessage& message) { self->handle(message); });
+	impl->client.on_sequence_gap([self](const WsSeqGap& gap) { self->handle_gap(gap); });
+	return ShmFeedPublisher(std::move(impl));
+}
+
+ShmFeedPublisher::ShmFeedPublisher(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+ShmFeedPublisher::~ShmFeedPublisher() = default;
+ShmFeedPublisher::ShmFeedPublisher(ShmFeedPublisher&&) noexcept = default;
+ShmFeedPublisher& ShmFeedPublisher::operator=(ShmFeedPublisher&&) noexcept = default;
+
+ShardedWebSocketClient& ShmFeedPublisher::client() noexcept {
+	return impl_->client;
+}
+
+void ShmFeedPublisher::on_message(WsMessageCallback callback) {
+	if (impl_) {
+		impl_->local_callback = std::move(callback);
+	}
+}
+
+void ShmFeedPublisher::publish(const WsMessage& message) {
+	if (impl_) {
+		impl_->handle(message);
+	}
+}
+
+const ShmFeedWriter& ShmFeedPublisher::writer() const noexcept {
+	return impl_->writer;
+}
+
+} // namespace kalshi
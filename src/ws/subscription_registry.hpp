@@ -1,37 +1,342 @@
 #pragma once
 
+/// @file subscription_registry.hpp
+/// @brief Subscription table: client id -> server sid, channel, markets.
+///
+/// Read-mostly and copy-on-write. Every change builds a new immutable
+/// snapshot under a writer mutex and publishes it with one atomic store;
+/// the service thread reads the current snapshot with one atomic load and
+/// never waits on a user thread calling ``subscribe_*`` / ``unsubscribe``.
+///
+/// Old snapshots are reclaimed quiescent-state style: the service thread
+/// (the only lock-free reader) calls ``quiesce`` between ``lws_service``
+/// rounds, holding no snapshot, and a snapshot retired before that point
+/// is freed by the next writer. Other threads read under the writer
+/// mutex. Market lists are shared between snapshots, so a copy costs one
+/// pointer per subscription rather than its tickers.
+///
+/// Not installed: consumed by ``websocket.cpp`` and the unit tests.
+
+#include "kalshi/websocket.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <map>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace kalshi::ws_detail {
 
+/// What is needed to send one subscription again on a new connection.
+struct SubscriptionReplay {
+	std::int32_t client_id{0};
+	Channel channel{Channel::OrderbookDelta};
+	std::vector<std::string> markets;
+	std::optional<WsShard> shard;
+};
+
+/// One subscription as seen by readers.
+struct SubscriptionEntry {
+	std::int32_t client_id{0};
+	std::int32_t server_sid{0}; ///< 0 until the subscribe is acked
+	bool tracked{false};		///< Sent through ``track`` (replayed on reconnect)
+	Channel channel{Channel::OrderbookDelta};
+	std::optional<WsShard> shard;
+	std::shared_ptr<const std::vector<std::string>> markets;
+};
+
 class SubscriptionRegistry {
 public:
-	void register_ack(std::int32_t client_id, std::int32_t server_sid) {
-		std::lock_guard lock(mutex_);
-		client_to_server_sid_[client_id] = server_sid;
+	/// Immutable table; ``entries`` sorted by client id.
+	struct Snapshot {
+		std::vector<SubscriptionEntry> entries;
+		/// Server sid -> index into ``entries`` + 1 (0 = none). Sids are
+		/// small dense integers; larger ones fall back to a scan.
+		std::vector<std::uint32_t> by_sid;
+	};
+
+	/// Sids at or above this are looked up by scanning ``entries``.
+	static constexpr std::int32_t kMaxIndexedSid = 1 << 16;
+
+	SubscriptionRegistry() : current_(new Snapshot{}) {}
+
+	~SubscriptionRegistry() {
+		delete current_.load();
+		for (Retired& retired : retired_) {
+			delete retired.snapshot;
+		}
 	}
 
+	SubscriptionRegistry(const SubscriptionRegistry&) = delete;
+	SubscriptionRegistry& operator=(const SubscriptionRegistry&) = delete;
+
+	// ===== Reader (service thread) =====
+
+	/// The service thread starts reading lock-free.
+	void reader_online() noexcept { observed_.store(epoch_.load()); }
+
+	/// The service thread holds no snapshot (between ``lws_service``
+	/// rounds); snapshots retired before now may be freed.
+	void quiesce() noexcept { observed_.store(epoch_.load()); }
+
+	/// The service thread stopped; writers reclaim without waiting.
+	void reader_offline() noexcept { observed_.store(kOffline); }
+
+	/// Current snapshot, valid until the reader's next ``quiesce``.
+	/// Service thread (or a single-threaded caller) only. Wait-free.
+	[[nodiscard]] const Snapshot& read() const noexcept { return *current_.load(); }
+
+	/// Entry for ``server_sid``, or null. Same rules as ``read``.
+	[[nodiscard]] const SubscriptionEntry* find_sid(std::int32_t server_sid) const noexcept {
+		return find_sid(read(), server_sid);
+	}
+
+	/// Markets on the subscription the server knows as ``server_sid``.
+	/// Empty when the sid has not been acked or carries no tickers.
+	/// Same rules as ``read``.
+	[[nodiscard]] std::vector<std::string> markets_for_sid(std::int32_t server_sid) const {
+		const SubscriptionEntry* entry = find_sid(server_sid);
+		return entry && entry->markets ? *entry->markets : std::vector<std::string>{};
+	}
+
+	/// Every tracked subscription with its current markets, in client id
+	/// order (the order they were first sent). Same rules as ``read``.
+	[[nodiscard]] std::vector<SubscriptionReplay> replay() const {
+		const Snapshot& snapshot = read();
+		std::vector<SubscriptionReplay> out;
+		out.reserve(snapshot.entries.size());
+		for (const SubscriptionEntry& entry : snapshot.entries) {
+			if (!entry.tracked) {
+				continue;
+			}
+			out.push_back(SubscriptionReplay{
+				.client_id = entry.client_id,
+				.channel = entry.channel,
+				.markets = entry.markets ? *entry.markets : std::vector<std::string>{},
+				.shard = entry.shard});
+		}
+		return out;
+	}
+
+	// ===== Any thread =====
+
+	/// Server sid for ``client_id``; the client id itself until acked.
 	[[nodiscard]] std::int32_t resolve(std::int32_t client_id) const {
-		std::lock_guard lock(mutex_);
-		auto it = client_to_server_sid_.find(client_id);
-		return it == client_to_server_sid_.end() ? client_id : it->second;
+		const std::int32_t sid = server_sid(client_id);
+		return sid != 0 ? sid : client_id;
+	}
+
+	/// Server sid for ``client_id``; 0 until acked.
+	[[nodiscard]] std::int32_t server_sid(std::int32_t client_id) const {
+		std::lock_guard lock(writer_mutex_);
+		const SubscriptionEntry* entry = find_client(*current_.load(), client_id);
+		return entry ? entry->server_sid : 0;
+	}
+
+	/// Record a subscription as sent, so it can be replayed after a
+	/// reconnect. Also sets its markets (see ``set_markets``).
+	void track(std::int32_t client_id, Channel channel, const std::vector<std::string>& tickers,
+			   std::optional<WsShard> shard = std::nullopt) {
+		update([&](Snapshot& next) {
+			SubscriptionEntry& entry = upsert(next, client_id);
+			entry.tracked = true;
+			entry.channel = channel;
+			entry.shard = shard;
+			entry.markets = std::make_shared<const std::vector<std::string>>(tickers);
+		});
+	}
+
+	void register_ack(std::int32_t client_id, std::int32_t server_sid) {
+		update([&](Snapshot& next) {
+			upsert(next, client_id).server_sid = server_sid;
+			reindex(next);
+		});
 	}
 
 	void erase(std::int32_t client_id) {
-		std::lock_guard lock(mutex_);
-		client_to_server_sid_.erase(client_id);
+		update([&](Snapshot& next) {
+			std::vector<SubscriptionEntry>::iterator it = lower_bound(next, client_id);
+			if (it != next.entries.end() && it->client_id == client_id) {
+				next.entries.erase(it);
+				reindex(next);
+			}
+		});
 	}
 
 	void clear() {
-		std::lock_guard lock(mutex_);
-		client_to_server_sid_.clear();
+		update([](Snapshot& next) {
+			next.entries.clear();
+			next.by_sid.clear();
+		});
+	}
+
+	/// Connection lost: the server's sids are gone, the subscriptions are
+	/// not. ``resolve`` falls back to client ids until replays are acked.
+	void forget_server_sids() {
+		update([](Snapshot& next) {
+			std::erase_if(next.entries,
+						  [](const SubscriptionEntry& entry) { return !entry.tracked; });
+			for (SubscriptionEntry& entry : next.entries) {
+				entry.server_sid = 0;
+			}
+			next.by_sid.clear();
+		});
+	}
+
+	// Market tickers currently on each subscription, keyed by client id.
+	// Kept so a sequence gap can be repaired by re-adding just the
+	// subscription's markets instead of tearing the subscription down.
+
+	void set_markets(std::int32_t client_id, const std::vector<std::string>& tickers) {
+		update([&](Snapshot& next) {
+			upsert(next, client_id).markets =
+				std::make_shared<const std::vector<std::string>>(tickers);
+		});
+	}
+
+	void add_markets(std::int32_t client_id, const std::vector<std::string>& tickers) {
+		update([&](Snapshot& next) {
+			SubscriptionEntry& entry = upsert(next, client_id);
+			std::vector<std::string> current = entry.markets ? *entry.markets
+															  : std::vector<std::string>{};
+			for (const std::string& ticker : tickers) {
+				if (std::find(current.begin(), current.end(), ticker) == current.end()) {
+					current.push_back(ticker);
+				}
+			}
+			entry.markets = std::make_shared<const std::vector<std::string>>(std::move(current));
+		});
+	}
+
+	void remove_markets(std::int32_t client_id, const std::vector<std::string>& tickers) {
+		update([&](Snapshot& next) {
+			std::vector<SubscriptionEntry>::iterator it = lower_bound(next, client_id);
+			if (it == next.entries.end() || it->client_id != client_id || !it->markets) {
+				return;
+			}
+			std::vector<std::string> current = *it->markets;
+			current.erase(std::remove_if(current.begin(), current.end(),
+										 [&tickers](const std::string& t) {
+											 return std::find(tickers.begin(), tickers.end(),
+															  t) != tickers.end();
+										 }),
+						  current.end());
+			it->markets = std::make_shared<const std::vector<std::string>>(std::move(current));
+		});
+	}
+
+	/// Retired snapshots not yet freed (tests / diagnostics)
+	[[nodiscard]] std::size_t retired_count() const {
+		std::lock_guard lock(writer_mutex_);
+		return retired_.size();
 	}
 
 private:
-	mutable std::mutex mutex_;
-	std::map<std::int32_t, std::int32_t> client_to_server_sid_;
+	struct Retired {
+		const Snapshot* snapshot;
+		std::uint64_t epoch;
+	};
+
+	static constexpr std::uint64_t kOffline = std::numeric_limits<std::uint64_t>::max();
+
+	static std::vector<SubscriptionEntry>::iterator lower_bound(Snapshot& snapshot,
+																 std::int32_t client_id) {
+		return std::lower_bound(snapshot.entries.begin(), snapshot.entries.end(), client_id,
+								[](const SubscriptionEntry& entry, std::int32_t id) {
+									return entry.client_id < id;
+								});
+	}
+
+	static const SubscriptionEntry* find_client(const Snapshot& snapshot, std::int32_t client_id) {
+		std::vector<SubscriptionEntry>::const_iterator it =
+			std::lower_bound(snapshot.entries.begin(), snapshot.entries.end(), client_id,
+							 [](const SubscriptionEntry& entry, std::int32_t id) {
+								 return entry.client_id < id;
+							 });
+		return it != snapshot.entries.end() && it->client_id == client_id ? &*it : nullptr;
+	}
+
+	static const SubscriptionEntry* find_sid(const Snapshot& snapshot,
+											 std::int32_t server_sid) noexcept {
+		if (server_sid <= 0) {
+			return nullptr;
+		}
+		if (server_sid < kMaxIndexedSid) {
+			const std::size_t slot = static_cast<std::size_t>(server_sid);
+			if (slot >= snapshot.by_sid.size() || snapshot.by_sid[slot] == 0) {
+				return nullptr;
+			}
+			return &snapshot.entries[snapshot.by_sid[slot] - 1];
+		}
+		for (const SubscriptionEntry& entry : snapshot.entries) {
+			if (entry.server_sid == server_sid) {
+				return &entry;
+			}
+		}
+		return nullptr;
+	}
+
+	static SubscriptionEntry& upsert(Snapshot& snapshot, std::int32_t client_id) {
+		std::vector<SubscriptionEntry>::iterator it = lower_bound(snapshot, client_id);
+		if (it == snapshot.entries.end() || it->client_id != client_id) {
+			SubscriptionEntry entry;
+			entry.client_id = client_id;
+			it = snapshot.entries.insert(it, std::move(entry));
+			// Inserting shifts later entries; indices in by_sid move too.
+			reindex(snapshot);
+		}
+		return *it;
+	}
+
+	static void reindex(Snapshot& snapshot) {
+		snapshot.by_sid.clear();
+		for (std::size_t i = 0; i < snapshot.entries.size(); ++i) {
+			const std::int32_t sid = snapshot.entries[i].server_sid;
+			if (sid <= 0 || sid >= kMaxIndexedSid) {
+				continue;
+			}
+			const std::size_t slot = static_cast<std::size_t>(sid);
+			if (slot >= snapshot.by_sid.size()) {
+				snapshot.by_sid.resize(slot + 1, 0);
+			}
+			snapshot.by_sid[slot] = static_cast<std::uint32_t>(i + 1);
+		}
+	}
+
+	// Copy, mutate and publish; then free what the reader can no longer see.
+	template <typename Mutate> void update(Mutate&& mutate) {
+		std::lock_guard lock(writer_mutex_);
+		const Snapshot* old = current_.load();
+		std::unique_ptr<Snapshot> next = std::make_unique<Snapshot>(*old);
+		mutate(*next);
+		current_.store(next.release());
+		retired_.push_back(Retired{.snapshot = old, .epoch = epoch_.fetch_add(1) + 1});
+
+		const std::uint64_t observed = observed_.load();
+		std::erase_if(retired_, [observed](const Retired& retired) {
+			if (observed != kOffline && observed < retired.epoch) {
+				return false;
+			}
+			delete retired.snapshot;
+			return true;
+		});
+	}
+
+	// Sequentially consistent throughout: the reader's quiesce store must
+	// not pass its next load of current_, nor the writer's publish pass
+	// its read of observed_.
+	std::atomic<const Snapshot*> current_;
+	std::atomic<std::uint64_t> epoch_{0};
+	std::atomic<std::uint64_t> observed_{kOffline};
+
+	mutable std::mutex writer_mutex_;
+	std::vector<Retired> retired_;
 };
 
 } // namespace kalshi::ws_detail
@@ -1,7 +1,17 @@
 #include "kalshi/websocket.hpp"
 
-#include "kalshi/detail/ws_json.hpp"
-
+#include "kalshi/ws_recorder.hpp"
+
+#include "kalshi/detail/mpsc_queue.hpp"
+
+#include "backpressure.hpp"
+#include "decode_pipeline.hpp"
+#include "frame_assembler.hpp"
+#include "frame_decoder.hpp"
+#include "reconnect_tracker.hpp"
+#include "send_buffer_pool.hpp"
+#include "seq_tracker.hpp"
+#include "service_tuning.hpp"
 #include "subscription_registry.hpp"
 
 // IMPORTANT: include order below is load-bearing on Windows.
@@ -26,15 +36,22 @@
 #include "ws_cmd_bodies.hpp"
 // clang-format on
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstring>
-#include <deque>
 #include <libwebsockets.h>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
 #include <vector>
 
 // ===== Glaze serializers for outgoing WS commands =====
@@ -46,8 +63,9 @@
 // pinned by `tests/test_json_serialize.cpp`.
 //
 // IMPORTANT: only the OUTGOING command builders use Glaze. The WS
-// `handle_message` hot path below uses the hand-rolled scanners in
-// `kalshi/detail/ws_json.hpp` and is deliberately untouched — see
+// `handle_message` hot path below uses the hand-rolled single-pass
+// decoder in `frame_decoder.cpp` (value parsers from
+// `kalshi/detail/ws_json.hpp`) and is deliberately not migrated — see
 // the `feedback_find_first_json_scanner` memory note.
 
 namespace kalshi {
@@ -59,6 +77,22 @@ static int ws_callback(struct lws* wsi, enum lws_callback_reasons reason, void*
 
 namespace {
 
+// Frames written per LWS_CALLBACK_CLIENT_WRITEABLE before yielding back to
+// the service loop, so a burst of commands does not starve reads.
+constexpr std::size_t kMaxWritesPerWriteable = 32;
+
+// How long connect() waits for the handshake.
+constexpr std::chrono::seconds kConnectTimeout{10};
+
+// Upper bound on one lws_service() wait. Sends, reconnect timers and
+// disconnect all wake the loop explicitly; this only bounds older lws
+// releases that still honour the timeout.
+constexpr int kServiceTimeoutMs = 1000;
+
+// Longest single wait while connect() drives the handshake itself
+// (WsServiceMode::External), so the connect timeout is checked promptly.
+constexpr std::chrono::milliseconds kExternalConnectPoll{50};
+
 std::string channel_to_string(Channel channel) {
 	switch (channel) {
 		case Channel::OrderbookDelta:
@@ -73,8 +107,9 @@ std::string channel_to_string(Channel channel) {
 	return "";
 }
 
-std::string build_subscribe_command(std::int32_t id, Channel channel,
-									const std::vector<std::string>& market_tickers) {
+ws_cmd::SubscribeCmd build_subscribe_command(std::int32_t id, Channel channel,
+											 const std::vector<std::string>& market_tickers,
+											 std::optional<WsShard> shard = std::nullopt) {
 	ws_cmd::SubscribeCmd cmd;
 	cmd.id = id;
 	cmd.cmd = "subscribe";
@@ -82,19 +117,24 @@ std::string build_subscribe_command(std::int32_t id, Channel channel,
 	if (!market_tickers.empty()) {
 		cmd.params.market_tickers = market_tickers;
 	}
-	return ws_cmd::render_cmd(cmd);
+	if (shard) {
+		cmd.params.shard_factor = shard->factor;
+		cmd.params.shard_key = shard->key;
+	}
+	return cmd;
 }
 
-std::string build_unsubscribe_command(std::int32_t id, std::int32_t sid) {
+ws_cmd::UnsubscribeCmd build_unsubscribe_command(std::int32_t id, std::int32_t sid) {
 	ws_cmd::UnsubscribeCmd cmd;
 	cmd.id = id;
 	cmd.cmd = "unsubscribe";
 	cmd.params.sids = {sid};
-	return ws_cmd::render_cmd(cmd);
+	return cmd;
 }
 
-std::string build_update_command(std::int32_t id, std::int32_t sid, const std::string& action,
-								 Channel channel, const std::vector<std::string>& market_tickers) {
+ws_cmd::UpdateCmd build_update_command(std::int32_t id, std::int32_t sid,
+									   const std::string& action, Channel channel,
+									   const std::vector<std::string>& market_tickers) {
 	ws_cmd::UpdateCmd cmd;
 	cmd.id = id;
 	cmd.cmd = "update_subscription";
@@ -102,11 +142,25 @@ std::string build_update_command(std::int32_t id, std::int32_t sid, const std::s
 	cmd.params.channel = std::string(to_string(channel));
 	cmd.params.sids = {sid};
 	cmd.params.market_tickers = market_tickers;
-	return ws_cmd::render_cmd(cmd);
+	return cmd;
 }
 
 } // anonymous namespace
 
+struct WsImplData;
+
+// lws timer for the next reconnect attempt. ``sul`` must stay the first
+// member: the timer callback only gets its address.
+struct ReconnectTimer {
+	lws_sorted_usec_list_t sul{};
+	WsImplData* owner{nullptr};
+};
+
+static void reconnect_timer_fired(lws_sorted_usec_list_t* sul);
+
+// Only has to exist: a due timer is what ends a bounded lws_service wait.
+static void poll_deadline_fired(lws_sorted_usec_list_t*) {}
+
 // Implementation data structure - exposed for callback
 struct WsImplData {
 	const Signer* signer;
@@ -114,52 +168,346 @@ struct WsImplData {
 
 	std::atomic<bool> connected{false};
 	std::atomic<bool> should_stop{false};
+	std::atomic<bool> connect_failed{false}; ///< Handshake failed before ESTABLISHED
+
+	// Signalled on every change to `connected` / `connect_failed`;
+	// connect() waits on it instead of polling.
+	std::mutex state_mutex;
+	std::condition_variable state_cv;
 
 	WsMessageCallback message_callback;
+	WsEventCallback event_callback;
 	WsErrorCallback error_callback;
 	WsStateCallback state_callback;
+	WsSeqGapCallback gap_callback;
+	WsBackpressureCallback backpressure_callback;
 
 	std::mutex callback_mutex;
 	std::atomic<std::int32_t> next_command_id{1};
-	std::atomic<std::uint16_t> reconnect_attempts{0}; ///< Current reconnect attempts (0-65535)
 
 	// libwebsockets context and connection
 	lws_context* context{nullptr};
 	lws* wsi{nullptr};
 	std::thread service_thread;
 
-	// Send queue - deque provides contiguous storage and efficient front removal
-	std::mutex send_mutex;
-	std::deque<std::string> send_queue;
-	std::string current_send_buffer;
-
-	// Receive buffer
-	std::string recv_buffer;
-
-	// Track server-assigned subscription IDs: client command id -> server sid.
+	// Endpoint parsed from config.url by connect(), reused by reconnects.
+	std::string host;
+	std::string path{"/"};
+	int port{443};
+	bool use_ssl{true};
+
+	// Auto-reconnect (service thread only, apart from connect() resetting
+	// it before the thread starts). Armed by the first ESTABLISHED.
+	bool reconnect_armed{false};
+	bool reconnect_scheduled{false};
+	ReconnectTimer reconnect_timer;
+	ws_detail::ReconnectTracker reconnect;
+
+	// Bounds one poll_once() wait (External mode).
+	lws_sorted_usec_list_t poll_deadline{};
+
+	// Outbound commands: rendered by the calling thread into a pooled
+	// buffer with LWS_PRE headroom, handed over lock-free, and written
+	// straight from that buffer by the service thread.
+	ws_detail::SendBufferPool send_pool{LWS_PRE};
+	detail::MpscQueue<ws_detail::SendBuffer> send_queue;
+
+	// Reassembles multi-chunk messages; single-chunk ones are decoded in
+	// place from lws's buffer.
+	ws_detail::FrameAssembler assembler;
+
+	// permessage-deflate (WsConfig::permessage_deflate). Written by the
+	// extension callback on the service thread, read from anywhere.
+	std::atomic<bool> deflate_negotiated{false};
+	std::atomic<std::uint64_t> deflate_wire_bytes{0};
+	std::atomic<std::uint64_t> deflate_inflated_bytes{0};
+	std::atomic<std::uint64_t> deflate_inflate_ns{0};
+
+	// Subscriptions by client command id and server sid. Copy-on-write:
+	// the service thread reads it without locking.
 	ws_detail::SubscriptionRegistry subscriptions;
 
+	// Orderbook sequence tracking (service thread only): last seq per
+	// server sid, markets whose deltas are held back until the resync
+	// snapshot lands, and per sid the markets a gap resync still awaits
+	// (a further gap on a resyncing sid does not resend delete/add).
+	ws_detail::SeqTracker seq_tracker;
+	std::unordered_set<std::uint32_t> resyncing_markets; ///< TickerId values
+	std::unordered_map<std::int32_t, std::unordered_set<std::uint32_t>> resyncing_sids;
+
+	// Server sids the caller unsubscribed; the service thread drops their
+	// sequence state before it handles the next frame.
+	std::mutex retired_mutex;
+	std::vector<std::int32_t> retired_sids;
+	std::atomic<bool> has_retired_sids{false};
+
+	// Queue mode (WsConfig::message_queue_capacity > 0): the service thread
+	// is the only producer, WebSocketClient::poll the only consumer. Null
+	// when messages are dispatched inline.
+	std::unique_ptr<ws_detail::MessageQueue> inbound;
+	std::atomic<std::uint64_t> inbound_enqueued{0};
+	std::atomic<std::uint64_t> inbound_dropped{0};
+	std::atomic<std::uint64_t> inbound_evicted{0};
+
+	// Overflow handling (WsConfig::queue_overflow / decode_overflow). The
+	// gate watches whichever buffer is in use; service thread only, as is
+	// `close_requested`, which ends the connection from the receive
+	// callback.
+	ws_detail::WatermarkGate watermark;
+	bool close_requested{false};
+	std::atomic<std::uint64_t> overflow_conflated{0};
+	std::atomic<std::uint64_t> overflow_resyncs{0};
+	std::atomic<std::uint64_t> overflow_oversized{0};
+	std::atomic<std::uint64_t> high_watermarks{0};
+
 	// Auth headers for handshake
 	AuthHeaders auth_headers;
 
-	WsImplData(const Signer& s, WsConfig c) : signer(&s), config(std::move(c)) {}
+	// Decoder settings derived from config; tickers always points at
+	// config.ticker_table.
+	ws_detail::DecodeOptions decode_options;
+
+	// Reused backing store for borrowed snapshot levels. Service thread
+	// only; reserved for two full ladders so steady state never allocates.
+	std::vector<OrderBookEntry> snapshot_levels;
+
+	// Decode workers (WsConfig::decode_workers): data frames are routed to
+	// them by market and decoded there. Null when decoding inline. Each
+	// lane is one worker's decoder state; its mutex only guards the
+	// message / event callbacks against the setters, so workers never
+	// contend with each other.
+	struct DecodeLane {
+		std::mutex dispatch_mutex;
+		ws_detail::DecodeOptions decode_options;
+		std::vector<OrderBookEntry> snapshot_levels;
+	};
+	std::vector<std::unique_ptr<DecodeLane>> lanes;
+	std::unique_ptr<ws_detail::DecodePipeline> pipeline;
+
+	WsImplData(const Signer& s, WsConfig c) : signer(&s), config(std::move(c)) {
+		reconnect_timer.owner = this;
+		if (!config.ticker_table) {
+			config.ticker_table = std::make_shared<TickerTable>();
+		}
+		decode_options.tickers = config.ticker_table.get();
+		decode_options.ticker_strings = config.ticker_strings;
+		assembler = ws_detail::FrameAssembler(config.max_message_bytes);
+		if (config.message_queue_capacity > 0) {
+			inbound = std::make_unique<ws_detail::MessageQueue>(
+				config.message_queue_capacity, config.max_queued_bytes,
+				config.queue_overflow == WsOverflowPolicy::DropOldest ||
+					config.queue_overflow == WsOverflowPolicy::Resync);
+			watermark = ws_detail::WatermarkGate(inbound->capacity(), config.max_queued_bytes,
+												 config.high_watermark);
+		} else {
+			decode_options.compact_events = config.compact_events;
+			if (config.borrowed_snapshots) {
+				snapshot_levels.reserve(2 * 99);
+				decode_options.snapshot_levels = &snapshot_levels;
+			}
+			for (std::size_t i = 0; i < config.decode_workers; ++i) {
+				std::unique_ptr<DecodeLane> lane = std::make_unique<DecodeLane>();
+				lane->decode_options = decode_options;
+				if (config.borrowed_snapshots) {
+					lane->snapshot_levels.reserve(2 * 99);
+					lane->decode_options.snapshot_levels = &lane->snapshot_levels;
+				}
+				lanes.push_back(std::move(lane));
+			}
+			if (!lanes.empty()) {
+				pipeline = std::make_unique<ws_detail::DecodePipeline>(
+					lanes.size(), config.decode_ring_capacity, config.max_queued_bytes,
+					config.decode_overflow == WsOverflowPolicy::DropOldest);
+				watermark = ws_detail::WatermarkGate(
+					pipeline->capacity(), config.max_queued_bytes, config.high_watermark);
+			}
+		}
+	}
 
 	~WsImplData() {
+		should_stop = true;
+		if (pipeline) {
+			pipeline->stop();
+		}
 		if (context) {
+			lws_sul_cancel(&reconnect_timer.sul);
 			lws_context_destroy(context);
 		}
+		discard_sends();
+	}
+
+	void set_connected(bool up) {
+		{
+			std::lock_guard lock(state_mutex);
+			connected = up;
+		}
+		state_cv.notify_all();
+	}
+
+	void signal_connect_failed() {
+		{
+			std::lock_guard lock(state_mutex);
+			connect_failed = true;
+		}
+		state_cv.notify_all();
+	}
+
+	// Sign a fresh handshake (the signature is timestamped) and start
+	// connecting to host/path. connect() calls this before the service
+	// thread starts, the reconnect timer on it afterwards.
+	Result<void> open_connection() {
+		const std::shared_ptr<PresignedHeaderPool>& pool = config.handshake_headers;
+		Result<AuthHeaders> auth_result = pool && pool->method() == "GET" && pool->path() == path
+											  ? pool->take()
+											  : signer->sign("GET", path);
+		if (!auth_result) {
+			return std::unexpected(auth_result.error());
+		}
+		auth_headers = *auth_result;
+		deflate_negotiated.store(false, std::memory_order_relaxed);
+
+		struct lws_client_connect_info conn_info {};
+		std::memset(&conn_info, 0, sizeof(conn_info));
+		conn_info.context = context;
+		conn_info.address = host.c_str();
+		conn_info.port = port;
+		conn_info.path = path.c_str();
+		conn_info.host = host.c_str();
+		// Kalshi rejects websocket upgrades that include an Origin header
+		// (403), while the documented Python websockets example sends no
+		// Origin and succeeds. Leave this unset so libwebsockets omits it.
+		conn_info.origin = nullptr;
+
+		if (use_ssl) {
+			conn_info.ssl_connection =
+				LCCSCF_USE_SSL | LCCSCF_ALLOW_SELFSIGNED | LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK;
+		}
+
+		wsi = lws_client_connect_via_info(&conn_info);
+		if (!wsi) {
+			return std::unexpected(Error::network("Failed to initiate WebSocket connection"));
+		}
+		return {};
+	}
+
+	// One round of the event loop on the calling thread (External mode).
+	// Current lws waits for its next timer whatever the timeout, so a
+	// deadline timer bounds the wait; older releases honour it directly.
+	// A zero timeout polls without waiting.
+	int service_for(std::chrono::milliseconds timeout) {
+		int rc = 0;
+		if (timeout.count() <= 0) {
+			rc = lws_service(context, -1);
+		} else {
+			lws_sul_schedule(context, 0, &poll_deadline, poll_deadline_fired,
+							 static_cast<lws_usec_t>(timeout.count()) * LWS_US_PER_MS);
+			rc = lws_service(context, static_cast<int>(timeout.count()));
+			lws_sul_cancel(&poll_deadline);
+		}
+		subscriptions.quiesce();
+		return rc;
+	}
+
+	// Service thread: the connection dropped or an attempt failed. Arms
+	// the reconnect timer with the next backoff step, or reports that
+	// max_reconnect_attempts ran out.
+	void schedule_reconnect() {
+		if (!config.auto_reconnect || should_stop || !reconnect_armed || reconnect_scheduled) {
+			return;
+		}
+		std::optional<std::chrono::milliseconds> delay =
+			reconnect.next_attempt(ws_detail::ReconnectTracker::Clock::now(),
+								   config.reconnect_backoff, config.max_reconnect_attempts);
+		if (!delay) {
+			invoke_error_callback({-1, "WebSocket reconnect attempts exhausted"});
+			return;
+		}
+		reconnect_scheduled = true;
+		lws_sul_schedule(context, 0, &reconnect_timer.sul, reconnect_timer_fired,
+						 static_cast<lws_usec_t>(delay->count()) * LWS_US_PER_MS);
+	}
+
+	// Service thread, from the reconnect timer.
+	void attempt_reconnect() {
+		reconnect_scheduled = false;
+		if (should_stop) {
+			return;
+		}
+		if (!open_connection()) {
+			schedule_reconnect();
+		}
+	}
+
+	// Service thread, on ESTABLISHED after an outage: send every tracked
+	// subscription again under its original client id, so the acks remap
+	// the caller's SubscriptionIds to the new server sids.
+	void replay_subscriptions(lws* conn) {
+		for (const ws_detail::SubscriptionReplay& sub : subscriptions.replay()) {
+			queue_send(build_subscribe_command(sub.client_id, sub.channel, sub.markets, sub.shard));
+		}
+		if (!send_queue.empty()) {
+			lws_callback_on_writable(conn);
+		}
 	}
 
 	std::int32_t get_next_id() { return next_command_id.fetch_add(1); }
 
-	void queue_send(const std::string& msg) {
-		std::lock_guard lock(send_mutex);
-		send_queue.push_back(msg);
-		if (wsi) {
-			lws_callback_on_writable(wsi);
+	// Any thread. lws_callback_on_writable is not safe off the service
+	// thread, so wake it with lws_cancel_service instead; it asks for
+	// WRITEABLE from LWS_CALLBACK_EVENT_WAIT_CANCELLED.
+	template <typename Cmd> void queue_send(const Cmd& cmd) {
+		std::unique_ptr<ws_detail::SendBuffer> buffer = send_pool.acquire();
+		ws_cmd::render_cmd(cmd, buffer->frame);
+		buffer->seal();
+		send_queue.push(buffer.release());
+		if (context) {
+			lws_cancel_service(context);
 		}
 	}
 
+	// Service thread: write queued frames until the socket pushes back or
+	// kMaxWritesPerWriteable is reached, then ask for another WRITEABLE if
+	// anything is left.
+	void drain_sends(lws* conn) {
+		for (std::size_t i = 0; i < kMaxWritesPerWriteable; ++i) {
+			if (i > 0 && lws_send_pipe_choked(conn)) {
+				break;
+			}
+			std::unique_ptr<ws_detail::SendBuffer> buffer(send_queue.pop());
+			if (!buffer) {
+				break;
+			}
+			const std::size_t size = buffer->payload_size();
+			const int written = lws_write(conn, buffer->payload(), size, LWS_WRITE_TEXT);
+			if (written < static_cast<int>(size)) {
+				invoke_error_callback({-1, "Failed to write to WebSocket"});
+			}
+			send_pool.release(std::move(buffer));
+		}
+		if (!send_queue.empty()) {
+			lws_callback_on_writable(conn);
+		}
+	}
+
+	// Consumer side (service thread, or after it is joined): drop commands
+	// meant for a connection that is gone.
+	void discard_sends() {
+		while (ws_detail::SendBuffer* raw = send_queue.pop()) {
+			send_pool.release(std::unique_ptr<ws_detail::SendBuffer>(raw));
+		}
+	}
+
+	// Setters for the callbacks workers call take every lane's lock as well
+	// as callback_mutex.
+	[[nodiscard]] std::vector<std::unique_lock<std::mutex>> lock_lanes() {
+		std::vector<std::unique_lock<std::mutex>> locks;
+		locks.reserve(lanes.size());
+		for (const std::unique_ptr<DecodeLane>& lane : lanes) {
+			locks.emplace_back(lane->dispatch_mutex);
+		}
+		return locks;
+	}
+
 	void invoke_message_callback(const WsMessage& msg) {
 		std::lock_guard lock(callback_mutex);
 		if (message_callback) {
@@ -167,6 +515,93 @@ struct WsImplData {
 		}
 	}
 
+	// Queue mode. A full ring is handled per WsConfig::queue_overflow; only
+	// Block holds up the service thread.
+	void enqueue_message(WsMessage&& msg) {
+		bool queued = inbound->try_push(std::move(msg));
+		if (!queued) {
+			switch (config.queue_overflow) {
+				case WsOverflowPolicy::Block:
+					queued = inbound->push_wait(std::move(msg), should_stop);
+					break;
+				case WsOverflowPolicy::DropNewest:
+					break;
+				case WsOverflowPolicy::DropOldest:
+					inbound_evicted.fetch_add(inbound->push_evict(std::move(msg)),
+											  std::memory_order_relaxed);
+					queued = true;
+					break;
+				case WsOverflowPolicy::Conflate:
+					if (const auto* snapshot = std::get_if<OrderbookSnapshot>(&msg)) {
+						conflate(snapshot->sid, snapshot->ticker_id);
+					} else if (const auto* delta = std::get_if<OrderbookDelta>(&msg)) {
+						conflate(delta->sid, delta->ticker_id);
+					}
+					break;
+				case WsOverflowPolicy::Resync:
+					inbound_evicted.fetch_add(inbound->clear(), std::memory_order_relaxed);
+					request_resync();
+					break;
+			}
+		}
+		(queued ? inbound_enqueued : inbound_dropped).fetch_add(1, std::memory_order_relaxed);
+		note_fill(WsBuffer::MessageQueue, inbound->size(), inbound->capacity(), inbound->bytes(),
+				  inbound->max_bytes());
+	}
+
+	// Conflate: take one market off its subscription and add it back. The
+	// snapshot that answers replaces every message it missed; its deltas
+	// are held back until then, as for a gap resync.
+	void conflate(std::int32_t sid, TickerId ticker) {
+		if (!resyncing_markets.insert(ticker.value).second) {
+			return; // already on its way
+		}
+		const std::vector<std::string> markets{std::string(config.ticker_table->name(ticker))};
+		queue_send(build_update_command(get_next_id(), sid, "delete_markets",
+										Channel::OrderbookDelta, markets));
+		queue_send(build_update_command(get_next_id(), sid, "add_markets",
+										Channel::OrderbookDelta, markets));
+		overflow_conflated.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Resync policy or an oversized message: the receive callback closes
+	// the connection once the current chunk is handled, and CLIENT_CLOSED
+	// schedules the reconnect that replays every subscription.
+	void request_resync() {
+		if (!close_requested) {
+			close_requested = true;
+			overflow_resyncs.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	// Report the buffer in use crossing the high watermark, either way.
+	void note_fill(WsBuffer buffer, std::size_t depth, std::size_t capacity, std::size_t bytes,
+				   std::size_t max_bytes) {
+		const std::optional<bool> crossed = watermark.update(depth, bytes);
+		if (!crossed) {
+			return;
+		}
+		if (*crossed) {
+			high_watermarks.fetch_add(1, std::memory_order_relaxed);
+		}
+		std::lock_guard lock(callback_mutex);
+		if (backpressure_callback) {
+			backpressure_callback(WsBackpressure{.buffer = buffer,
+												 .high = *crossed,
+												 .depth = depth,
+												 .capacity = capacity,
+												 .bytes = bytes,
+												 .max_bytes = max_bytes});
+		}
+	}
+
+	void invoke_event_callback(const WsEvent& event) {
+		std::lock_guard lock(callback_mutex);
+		if (event_callback) {
+			event_callback(event);
+		}
+	}
+
 	void invoke_error_callback(const WsError& err) {
 		std::lock_guard lock(callback_mutex);
 		if (error_callback) {
@@ -181,8 +616,69 @@ struct WsImplData {
 		}
 	}
 
+	void invoke_gap_callback(const WsSeqGap& gap) {
+		std::lock_guard lock(callback_mutex);
+		if (gap_callback) {
+			gap_callback(gap);
+		}
+	}
+
+	// Drop per-connection sequence state (new connection, new sids).
+	void reset_sequence_state() {
+		seq_tracker.clear();
+		resyncing_markets.clear();
+		resyncing_sids.clear();
+		std::lock_guard lock(retired_mutex);
+		retired_sids.clear();
+		has_retired_sids.store(false, std::memory_order_relaxed);
+	}
+
+	// Any thread: ``sid`` was unsubscribed.
+	void retire_sid(std::int32_t sid) {
+		std::lock_guard lock(retired_mutex);
+		retired_sids.push_back(sid);
+		has_retired_sids.store(true, std::memory_order_release);
+	}
+
+	// Service thread: forget the sequence state of retired sids.
+	void drop_retired_sids() {
+		if (!has_retired_sids.load(std::memory_order_acquire)) {
+			return;
+		}
+		std::vector<std::int32_t> sids;
+		{
+			std::lock_guard lock(retired_mutex);
+			sids.swap(retired_sids);
+			has_retired_sids.store(false, std::memory_order_relaxed);
+		}
+		for (const std::int32_t sid : sids) {
+			seq_tracker.erase(sid);
+			resyncing_sids.erase(sid);
+		}
+	}
+
 	// Parse incoming JSON message and dispatch to appropriate callback
-	void handle_message(const std::string& json);
+	void handle_message(std::string_view frame);
+
+	// Decode workers on: sequence-check a data frame from its peeked
+	// fields and queue it for the worker owning its market. Returns false
+	// for control frames, which handle_message decodes itself.
+	bool route_frame(std::string_view frame, std::chrono::steady_clock::time_point received,
+					 std::uint64_t recv_ns);
+	// Worker side of route_frame: decode, record and deliver.
+	void decode_on_worker(std::size_t worker, ws_detail::PipelineFrame& frame);
+
+	// Check orderbook seq continuity; returns false when the message must
+	// not be delivered (replayed frame, or a delta for a resyncing market).
+	bool track_sequence(const WsMessage& msg);
+	bool track_snapshot(std::int32_t sid, std::int32_t seq, TickerId ticker);
+	bool track_delta(std::int32_t sid, std::int32_t seq, TickerId ticker);
+
+	void record_event(const WsEvent& event, std::uint64_t recv_ns) {
+		config.recorder->record_event(event, config.ticker_table->name(event.ticker_id), recv_ns);
+	}
+
+	void start_resync(std::int32_t sid, std::int32_t expected, std::int32_t received);
 };
 
 struct WebSocketClient::Impl {
@@ -191,6 +687,11 @@ struct WebSocketClient::Impl {
 	Impl(const Signer& s, WsConfig c) : data(std::make_unique<WsImplData>(s, std::move(c))) {}
 };
 
+static void reconnect_timer_fired(lws_sorted_usec_list_t* sul) {
+	// `sul` is the first member of ReconnectTimer.
+	reinterpret_cast<ReconnectTimer*>(sul)->owner->attempt_reconnect();
+}
+
 // libwebsockets callback
 static int ws_callback(struct lws* wsi, enum lws_callback_reasons reason, void* user, void* in,
 					   size_t len) {
@@ -200,61 +701,93 @@ static int ws_callback(struct lws* wsi, enum lws_callback_reasons reason, void*
 		return 0;
 
 	switch (reason) {
-		case LWS_CALLBACK_CLIENT_ESTABLISHED:
-			impl->connected = true;
-			impl->reconnect_attempts = 0;
-			impl->subscriptions.clear();
+		case LWS_CALLBACK_CLIENT_ESTABLISHED: {
+			impl->reconnect_armed = true;
+			const bool resumed = impl->reconnect.established();
+			if (resumed) {
+				impl->subscriptions.forget_server_sids();
+			} else {
+				impl->subscriptions.clear();
+			}
+			if (impl->config.tcp_nodelay || impl->config.socket_busy_poll_us > 0) {
+#if !defined(_WIN32)
+				const int fd = static_cast<int>(lws_get_socket_fd(wsi));
+				Result<void> tuned = ws_detail::tune_socket(fd, impl->config.tcp_nodelay,
+															impl->config.socket_busy_poll_us);
+				if (!tuned) {
+					impl->invoke_error_callback({-1, tuned.error().message});
+				}
+#endif
+			}
+			impl->reset_sequence_state();
+			impl->assembler.reset();
+			impl->close_requested = false;
+			impl->set_connected(true);
+			if (resumed) {
+				impl->replay_subscriptions(wsi);
+			}
 			impl->invoke_state_callback(true);
 			break;
+		}
 
 		case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
-			impl->connected = false;
+			impl->set_connected(false);
+			impl->wsi = nullptr;
 			if (in) {
 				impl->invoke_error_callback({0, std::string(static_cast<char*>(in), len)});
 			}
+			if (impl->reconnect_armed) {
+				impl->schedule_reconnect();
+			} else {
+				impl->signal_connect_failed();
+			}
 			impl->invoke_state_callback(false);
 			break;
 
 		case LWS_CALLBACK_CLIENT_CLOSED:
-			impl->connected = false;
-			impl->subscriptions.clear();
+			impl->set_connected(false);
+			impl->wsi = nullptr;
+			// Keep the subscriptions themselves: a reconnect replays them.
+			impl->subscriptions.forget_server_sids();
+			impl->reset_sequence_state();
+			impl->discard_sends();
 			impl->invoke_state_callback(false);
+			impl->schedule_reconnect();
 			break;
 
 		case LWS_CALLBACK_CLIENT_RECEIVE:
 			if (in && len > 0) {
-				impl->recv_buffer.append(static_cast<char*>(in), len);
-
-				// Check if this is the final fragment
-				if (lws_is_final_fragment(wsi)) {
-					impl->handle_message(impl->recv_buffer);
-					impl->recv_buffer.clear();
+				// lws_is_final_fragment also waits out the rest of a payload
+				// larger than the rx buffer.
+				const std::string_view chunk(static_cast<const char*>(in), len);
+				const bool fits = impl->assembler.feed(
+					chunk, lws_is_first_fragment(wsi) != 0, lws_is_final_fragment(wsi) != 0,
+					[impl](std::string_view frame) { impl->handle_message(frame); });
+				if (!fits) {
+					impl->overflow_oversized.fetch_add(1, std::memory_order_relaxed);
+					impl->invoke_error_callback(
+						{-1, "WebSocket message exceeds max_message_bytes"});
+					impl->request_resync();
+				}
+				if (impl->close_requested) {
+					// Closing here raises CLIENT_CLOSED, which reconnects.
+					impl->close_requested = false;
+					return -1;
 				}
 			}
 			break;
 
-		case LWS_CALLBACK_CLIENT_WRITEABLE: {
-			std::lock_guard lock(impl->send_mutex);
-			if (!impl->send_queue.empty()) {
-				std::string msg = impl->send_queue.front();
-				impl->send_queue.pop_front();
-
-				// Allocate buffer with LWS_PRE padding
-				std::vector<unsigned char> buf(LWS_PRE + msg.size());
-				std::memcpy(buf.data() + LWS_PRE, msg.data(), msg.size());
-
-				int written = lws_write(wsi, buf.data() + LWS_PRE, msg.size(), LWS_WRITE_TEXT);
-				if (written < static_cast<int>(msg.size())) {
-					impl->invoke_error_callback({-1, "Failed to write to WebSocket"});
-				}
+		case LWS_CALLBACK_CLIENT_WRITEABLE:
+			impl->drain_sends(wsi);
+			break;
 
-				// If there are more messages, request another callback
-				if (!impl->send_queue.empty()) {
-					lws_callback_on_writable(wsi);
-				}
+		case LWS_CALLBACK_EVENT_WAIT_CANCELLED:
+			// Raised on a context-level wsi by lws_cancel_service from
+			// queue_send.
+			if (impl->connected && impl->wsi && !impl->send_queue.empty()) {
+				lws_callback_on_writable(impl->wsi);
 			}
 			break;
-		}
 
 		case LWS_CALLBACK_CLIENT_APPEND_HANDSHAKE_HEADER: {
 			// Add authentication headers to the WebSocket upgrade request
@@ -287,157 +820,319 @@ static int ws_callback(struct lws* wsi, enum lws_callback_reasons reason, void*
 	return 0;
 }
 
-void WsImplData::handle_message(const std::string& json) {
-	// Simple JSON type detection
-	size_t type_pos = json.find("\"type\"");
-	if (type_pos == std::string::npos)
-		return;
-
-	size_t colon = json.find(':', type_pos);
-	if (colon == std::string::npos)
-		return;
-
-	size_t quote1 = json.find('"', colon);
-	if (quote1 == std::string::npos)
-		return;
+// Series name under ``WsConfig::latency_stats`` for a decoded frame: the
+// wire message type, or what the frame turned out to be.
+static std::string_view latency_type(const ws_detail::DecodedFrame& decoded) noexcept {
+	switch (decoded.kind) {
+		case ws_detail::FrameKind::Error:
+			return "error";
+		case ws_detail::FrameKind::Subscribed:
+			return "subscribed";
+		case ws_detail::FrameKind::Message: {
+			static constexpr std::array<std::string_view, std::variant_size_v<WsMessage>> kNames{
+				"orderbook_snapshot", "orderbook_delta", "trade", "fill", "market_lifecycle"};
+			return kNames[decoded.message.index()];
+		}
+		case ws_detail::FrameKind::Event:
+			switch (decoded.event.kind) {
+				case WsEventKind::Delta:
+					return "orderbook_delta";
+				case WsEventKind::Trade:
+					return "trade";
+				case WsEventKind::Fill:
+					return "fill";
+				case WsEventKind::None:
+					break;
+			}
+			break;
+		case ws_detail::FrameKind::Ignored:
+			break;
+	}
+	return "ignored";
+}
 
-	size_t quote2 = json.find('"', quote1 + 1);
-	if (quote2 == std::string::npos)
+void WsImplData::handle_message(std::string_view frame) {
+	using SteadyClock = std::chrono::steady_clock;
+	LatencyStats* const stats = config.latency_stats.get();
+	const SteadyClock::time_point received = stats ? SteadyClock::now() : SteadyClock::time_point{};
+	std::uint64_t recv_ns = 0;
+	if (config.recorder) {
+		const std::chrono::system_clock::duration now =
+			std::chrono::system_clock::now().time_since_epoch();
+		recv_ns = static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+		if (config.recorder->records_frames()) {
+			config.recorder->record(frame, recv_ns);
+		}
+	}
+	drop_retired_sids();
+	if (pipeline && route_frame(frame, received, recv_ns)) {
 		return;
+	}
+	// One pass over the frame; see frame_decoder.hpp for the field
+	// precedence rules and the per-type conversions.
+	ws_detail::DecodedFrame decoded = ws_detail::decode_frame(frame, decode_options);
+	const SteadyClock::time_point parsed = stats ? SteadyClock::now() : SteadyClock::time_point{};
+	// Named before dispatch, which may move the message out.
+	const std::string_view type = stats ? latency_type(decoded) : std::string_view{};
+	switch (decoded.kind) {
+		case ws_detail::FrameKind::Error:
+			invoke_error_callback(decoded.error);
+			break;
+		case ws_detail::FrameKind::Subscribed:
+			if (decoded.client_id > 0 && decoded.server_sid > 0) {
+				subscriptions.register_ack(decoded.client_id, decoded.server_sid);
+			}
+			break;
+		case ws_detail::FrameKind::Message:
+			if (!track_sequence(decoded.message)) {
+				break;
+			}
+			if (reconnect.awaiting_message()) {
+				reconnect.message(ws_detail::ReconnectTracker::Clock::now());
+			}
+			if (recv_ns != 0 && config.recorder->records_events()) {
+				if (const std::optional<WsEvent> event = to_event(decoded.message)) {
+					record_event(*event, recv_ns);
+				}
+			}
+			if (inbound) {
+				enqueue_message(std::move(decoded.message));
+			} else {
+				invoke_message_callback(decoded.message);
+			}
+			break;
+		case ws_detail::FrameKind::Event:
+			if (decoded.event.kind == WsEventKind::Delta &&
+				!track_delta(decoded.event.sid, decoded.event.seq, decoded.event.ticker_id)) {
+				break;
+			}
+			if (reconnect.awaiting_message()) {
+				reconnect.message(ws_detail::ReconnectTracker::Clock::now());
+			}
+			if (recv_ns != 0 && config.recorder->records_events()) {
+				record_event(decoded.event, recv_ns);
+			}
+			invoke_event_callback(decoded.event);
+			break;
+		case ws_detail::FrameKind::Ignored:
+			break;
+	}
+	if (stats) {
+		// Callback covers everything after decode: sequence tracking, the
+		// recorder copy and the user callback or queue push.
+		const SteadyClock::time_point done = SteadyClock::now();
+		LatencyStats::Recorder series = stats->ws(type);
+		series.record(LatencyStage::Parse, parsed - received);
+		series.record(LatencyStage::Callback, done - parsed);
+		series.record(LatencyStage::Total, done - received);
+		series.add(LatencyCounter::Messages);
+		series.add(LatencyCounter::BytesIn, frame.size());
+	}
+}
 
-	std::string msg_type = json.substr(quote1 + 1, quote2 - quote1 - 1);
-
-	// Extract helpers live in detail/ws_json.hpp so the unit tests can
-	// exercise them directly — the original in-lambda versions were
-	// private to this translation unit.
-	auto extract_int = [&](const std::string& key) { return detail::extract_int(json, key); };
-
-	// Extract orderbook entries from "yes" or "no" arrays:
-	// [[price, quantity], ...] — implementation in detail/ws_json.hpp,
-	// returning PriceQty pairs we translate into the public
-	// OrderBookEntry struct.
-	auto extract_orderbook_entries = [&](const std::string& key) -> std::vector<OrderBookEntry> {
-		const std::vector<detail::PriceQty> pairs = detail::extract_orderbook_entries(json, key);
-		std::vector<OrderBookEntry> entries;
-		entries.reserve(pairs.size());
-		for (const detail::PriceQty& p : pairs)
-			entries.push_back(OrderBookEntry{p.price, p.quantity});
-		return entries;
-	};
+bool WsImplData::route_frame(std::string_view frame,
+							 std::chrono::steady_clock::time_point received,
+							 std::uint64_t recv_ns) {
+	const ws_detail::FramePeek peek = ws_detail::peek_frame(frame);
+	if (peek.kind == ws_detail::PeekKind::Control) {
+		return false;
+	}
+	// The same id the worker's decode will stamp; dense ids spread markets
+	// evenly over the workers.
+	const TickerId ticker = config.ticker_table->intern(peek.market_ticker);
+	if (peek.kind == ws_detail::PeekKind::Snapshot && !track_snapshot(peek.sid, peek.seq, ticker)) {
+		return true;
+	}
+	if (peek.kind == ws_detail::PeekKind::Delta && !track_delta(peek.sid, peek.seq, ticker)) {
+		return true;
+	}
+	if (reconnect.awaiting_message()) {
+		reconnect.message(ws_detail::ReconnectTracker::Clock::now());
+	}
+	using Overflow = ws_detail::DecodePipeline::Overflow;
+	switch (config.decode_overflow) {
+		case WsOverflowPolicy::Block:
+			(void)pipeline->push(ticker.value, frame, received, recv_ns, Overflow::Wait);
+			break;
+		case WsOverflowPolicy::DropNewest:
+			(void)pipeline->push(ticker.value, frame, received, recv_ns, Overflow::Reject);
+			break;
+		case WsOverflowPolicy::DropOldest:
+			(void)pipeline->push(ticker.value, frame, received, recv_ns, Overflow::EvictOldest);
+			break;
+		case WsOverflowPolicy::Conflate:
+			if (!pipeline->push(ticker.value, frame, received, recv_ns, Overflow::Reject) &&
+				(peek.kind == ws_detail::PeekKind::Snapshot ||
+				 peek.kind == ws_detail::PeekKind::Delta)) {
+				conflate(peek.sid, ticker);
+			}
+			break;
+		case WsOverflowPolicy::Resync:
+			if (!pipeline->push(ticker.value, frame, received, recv_ns, Overflow::Reject)) {
+				pipeline->flush();
+				request_resync();
+			}
+			break;
+	}
+	note_fill(WsBuffer::DecodeWorkers, pipeline->depth(), pipeline->capacity(), pipeline->bytes(),
+			  pipeline->max_bytes());
+	return true;
+}
 
-	auto extract_string = [&](const std::string& key) { return detail::extract_string(json, key); };
-
-	if (msg_type == "error") {
-		WsError err;
-		// Look for nested msg object
-		size_t msg_pos = json.find("\"msg\"");
-		if (msg_pos != std::string::npos) {
-			err.code = extract_int("code");
-			err.message = extract_string("message");
-			if (err.message.empty()) {
-				// No explicit message field — fall back to the documented
-				// error-code name (e.g. code 7 → "Unknown subscription ID").
-				// The pre-fix fallback `extract_string("msg")` returned the
-				// first quoted token inside the `msg` object, which is the
-				// `"code"` key name itself, surfacing as message="code" in
-				// consumer logs. The find-first scanner anti-pattern caught
-				// in 2026-05-15 production logs against kalshi-websocket.
-				err.message = std::string{ws_error_code_name(err.code)};
+void WsImplData::decode_on_worker(std::size_t worker, ws_detail::PipelineFrame& frame) {
+	using SteadyClock = std::chrono::steady_clock;
+	DecodeLane& lane = *lanes[worker];
+	LatencyStats* const stats = config.latency_stats.get();
+	const SteadyClock::time_point start = stats ? SteadyClock::now() : SteadyClock::time_point{};
+	ws_detail::DecodedFrame decoded = ws_detail::decode_frame(frame.bytes, lane.decode_options);
+	const SteadyClock::time_point parsed = stats ? SteadyClock::now() : SteadyClock::time_point{};
+	const std::string_view type = stats ? latency_type(decoded) : std::string_view{};
+	const bool record = frame.recv_ns != 0 && config.recorder->records_events();
+	if (decoded.kind == ws_detail::FrameKind::Message) {
+		if (record) {
+			if (const std::optional<WsEvent> event = to_event(decoded.message)) {
+				record_event(*event, frame.recv_ns);
 			}
 		}
-		invoke_error_callback(err);
-	} else if (msg_type == "subscribed") {
-		// Track server subscription ID: {"type":"subscribed","id":1,"msg":{"sid":12345,...}}
-		std::int32_t client_id = extract_int("id");
-		std::int32_t server_sid = extract_int("sid");
-		if (client_id > 0 && server_sid > 0) {
-			subscriptions.register_ack(client_id, server_sid);
-		}
-	} else if (msg_type == "orderbook_snapshot") {
-		OrderbookSnapshot snap;
-		snap.sid = extract_int("sid");
-		snap.seq = extract_int("seq");
-		snap.market_ticker = extract_string("market_ticker");
-		snap.yes = extract_orderbook_entries("yes");
-		snap.no = extract_orderbook_entries("no");
-		invoke_message_callback(snap);
-	} else if (msg_type == "orderbook_delta") {
-		// Kalshi v2 wire format (as of 2026-04):
-		//   msg.price_dollars  = "0.4200"    -> 42 cents
-		//   msg.delta_fp       = "-30.87"    -> -31 (rounded)
-		//   msg.ts             = "2026-04-20T08:19:13.898Z"  (ISO, not int)
-		OrderbookDelta delta;
-		delta.sid = extract_int("sid");
-		delta.seq = extract_int("seq");
-		delta.market_ticker = extract_string("market_ticker");
-		delta.price = detail::extract_dollar_cents(json, "price_dollars");
-		delta.delta = detail::extract_fp_int(json, "delta_fp");
-		std::string side_str = extract_string("side");
-		delta.side = (side_str == "yes") ? Side::Yes : Side::No;
-		invoke_message_callback(delta);
-	} else if (msg_type == "trade") {
-		// Kalshi v2 wire format (as of 2026-04):
-		//   msg.yes_price_dollars = "0.3200"  -> 32 cents
-		//   msg.no_price_dollars  = "0.6800"  -> 68 cents
-		//   msg.count_fp          = "40.00"   -> 40 contracts (rounded)
-		WsTrade trade;
-		trade.sid = extract_int("sid");
-		trade.trade_id = extract_string("trade_id");
-		trade.market_ticker = extract_string("market_ticker");
-		trade.yes_price = detail::extract_dollar_cents(json, "yes_price_dollars");
-		trade.no_price = detail::extract_dollar_cents(json, "no_price_dollars");
-		trade.count = detail::extract_fp_int(json, "count_fp");
-		std::string side_str = extract_string("taker_side");
-		trade.taker_side = (side_str == "yes") ? Side::Yes : Side::No;
-		trade.timestamp = extract_int("ts");
-		invoke_message_callback(trade);
-	} else if (msg_type == "fill") {
-		// Fill messages (user-only) use the same _dollars / _fp suffix
-		// convention as trade frames in the v2 schema.
-		WsFill fill;
-		fill.sid = extract_int("sid");
-		fill.trade_id = extract_string("trade_id");
-		fill.order_id = extract_string("order_id");
-		fill.market_ticker = extract_string("market_ticker");
-		fill.is_taker = (extract_string("is_taker") == "true");
-		std::string side_str = extract_string("side");
-		fill.side = (side_str == "yes") ? Side::Yes : Side::No;
-		fill.yes_price = detail::extract_dollar_cents(json, "yes_price_dollars");
-		fill.no_price = detail::extract_dollar_cents(json, "no_price_dollars");
-		fill.count = detail::extract_fp_int(json, "count_fp");
-		std::string action_str = extract_string("action");
-		fill.action = (action_str == "buy") ? Action::Buy : Action::Sell;
-		fill.timestamp = extract_int("ts");
-		invoke_message_callback(fill);
-	} else if (msg_type == "market_lifecycle" || msg_type == "market_lifecycle_v2") {
-		MarketLifecycle lc;
-		lc.sid = extract_int("sid");
-		lc.market_ticker = extract_string("market_ticker");
-		lc.open_ts = extract_int("open_ts");
-		lc.close_ts = extract_int("close_ts");
-		std::int64_t det = extract_int("determination_ts");
-		if (det > 0)
-			lc.determination_ts = det;
-		std::int64_t set = extract_int("settled_ts");
-		if (set > 0)
-			lc.settled_ts = set;
-		std::string result = extract_string("result");
-		if (!result.empty())
-			lc.result = result;
-		lc.is_deactivated = (extract_string("is_deactivated") == "true");
-		// `yes_sub_title` is emitted only by the `metadata_updated` sub-event
-		// (added 2026-05-11). Non-empty here ⇒ the frame is a metadata
-		// update. Empty extraction ⇒ leave nullopt.
-		std::string yes_sub_title = extract_string("yes_sub_title");
-		if (!yes_sub_title.empty())
-			lc.yes_sub_title = yes_sub_title;
-		invoke_message_callback(lc);
+		std::lock_guard lock(lane.dispatch_mutex);
+		if (message_callback) {
+			message_callback(decoded.message);
+		}
+	} else if (decoded.kind == ws_detail::FrameKind::Event) {
+		if (record) {
+			record_event(decoded.event, frame.recv_ns);
+		}
+		std::lock_guard lock(lane.dispatch_mutex);
+		if (event_callback) {
+			event_callback(decoded.event);
+		}
+	}
+	if (stats) {
+		// Total runs from receipt on the service thread, so it includes
+		// the wait in the worker's ring.
+		const SteadyClock::time_point done = SteadyClock::now();
+		LatencyStats::Recorder series = stats->ws(type);
+		series.record(LatencyStage::Parse, parsed - start);
+		series.record(LatencyStage::Callback, done - parsed);
+		series.record(LatencyStage::Total, done - frame.received);
+		series.add(LatencyCounter::Messages);
+		series.add(LatencyCounter::BytesIn, frame.bytes.size());
+	}
+}
+
+bool WsImplData::track_sequence(const WsMessage& msg) {
+	if (const OrderbookSnapshot* snap = std::get_if<OrderbookSnapshot>(&msg)) {
+		return track_snapshot(snap->sid, snap->seq, snap->ticker_id);
+	}
+	if (const OrderbookDelta* delta = std::get_if<OrderbookDelta>(&msg)) {
+		return track_delta(delta->sid, delta->seq, delta->ticker_id);
+	}
+	return true;
+}
+
+bool WsImplData::track_snapshot(std::int32_t sid, std::int32_t seq, TickerId ticker) {
+	const ws_detail::SeqObservation obs = seq_tracker.observe(sid, seq);
+	if (obs.status == ws_detail::SeqStatus::Duplicate) {
+		return false;
+	}
+	if (obs.status == ws_detail::SeqStatus::Gap) {
+		start_resync(sid, obs.expected, seq);
+	}
+	// A snapshot is self-contained: it ends this market's resync even
+	// when the gap it revealed belongs to another market.
+	resyncing_markets.erase(ticker.value);
+	const auto pending = resyncing_sids.find(sid);
+	if (pending != resyncing_sids.end() && pending->second.erase(ticker.value) != 0 &&
+		pending->second.empty()) {
+		resyncing_sids.erase(pending);
+	}
+	return true;
+}
+
+bool WsImplData::track_delta(std::int32_t sid, std::int32_t seq, TickerId ticker) {
+	const ws_detail::SeqObservation obs = seq_tracker.observe(sid, seq);
+	if (obs.status == ws_detail::SeqStatus::Duplicate) {
+		return false;
+	}
+	if (obs.status == ws_detail::SeqStatus::Gap) {
+		start_resync(sid, obs.expected, seq);
+	}
+	return resyncing_markets.empty() || !resyncing_markets.contains(ticker.value);
+}
+
+void WsImplData::start_resync(std::int32_t sid, std::int32_t expected, std::int32_t received) {
+	WsSeqGap gap{
+		.sid = sid, .expected_seq = expected, .received_seq = received, .resync_tickers = {}};
+	// A gap while this sid's resync is in flight is reported, but the
+	// snapshots already requested cover it.
+	if (config.resync_on_gap && !resyncing_sids.contains(sid)) {
+		gap.resync_tickers = subscriptions.markets_for_sid(sid);
+	}
+	invoke_gap_callback(gap);
+	if (gap.resync_tickers.empty()) {
+		return;
+	}
+	// Removing and re-adding the markets keeps the subscription (and its
+	// sid) alive; the server answers the add with fresh snapshots that
+	// continue the same seq stream.
+	queue_send(build_update_command(get_next_id(), sid, "delete_markets", Channel::OrderbookDelta,
+									gap.resync_tickers));
+	queue_send(build_update_command(get_next_id(), sid, "add_markets", Channel::OrderbookDelta,
+									gap.resync_tickers));
+	std::unordered_set<std::uint32_t>& pending = resyncing_sids[sid];
+	for (const std::string& ticker : gap.resync_tickers) {
+		const std::uint32_t id = config.ticker_table->intern(ticker).value;
+		resyncing_markets.insert(id);
+		pending.insert(id);
 	}
 }
 
 static const struct lws_protocols protocols[] = {{"kalshi-ws", ws_callback, 0, 65536},
 												 LWS_PROTOCOL_LIST_TERM};
 
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+// lws's own permessage-deflate, wrapped to count what it does. It inflates
+// into one buffer per connection, allocated when the extension is set up,
+// and hands RECEIVE the output in chunks the FrameAssembler reuses its
+// buffer for, so an inflated message allocates nothing either.
+static int deflate_extension(struct lws_context* context, const struct lws_extension* ext,
+							 struct lws* wsi, enum lws_extension_callback_reasons reason,
+							 void* user, void* in, size_t len) {
+	WsImplData* impl = context ? static_cast<WsImplData*>(lws_context_user(context)) : nullptr;
+	if (impl && reason == LWS_EXT_CB_CLIENT_CONSTRUCT) {
+		impl->deflate_negotiated.store(true, std::memory_order_relaxed);
+	}
+	if (!impl || reason != LWS_EXT_CB_PAYLOAD_RX || !in) {
+		return lws_extension_callback_pm_deflate(context, ext, wsi, reason, user, in, len);
+	}
+	// The extension advances eb_in past what it consumed and points
+	// eb_out at what it produced.
+	const lws_ext_pm_deflate_rx_ebufs* bufs = static_cast<const lws_ext_pm_deflate_rx_ebufs*>(in);
+	const int in_before = bufs->eb_in.len;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const int rc = lws_extension_callback_pm_deflate(context, ext, wsi, reason, user, in, len);
+	const std::chrono::steady_clock::duration spent = std::chrono::steady_clock::now() - start;
+	if (in_before > bufs->eb_in.len) {
+		impl->deflate_wire_bytes.fetch_add(static_cast<std::uint64_t>(in_before - bufs->eb_in.len),
+										   std::memory_order_relaxed);
+	}
+	if (bufs->eb_out.len > 0) {
+		impl->deflate_inflated_bytes.fetch_add(static_cast<std::uint64_t>(bufs->eb_out.len),
+											   std::memory_order_relaxed);
+	}
+	impl->deflate_inflate_ns.fetch_add(
+		static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(spent).count()),
+		std::memory_order_relaxed);
+	return rc;
+}
+
+static const struct lws_extension deflate_extensions[] = {
+	{"permessage-deflate", deflate_extension, "permessage-deflate; client_max_window_bits"},
+	{nullptr, nullptr, nullptr}};
+#endif
+
 WebSocketClient::WebSocketClient(const Signer& signer, WsConfig config)
 	: impl_(std::make_unique<Impl>(signer, std::move(config))) {}
 
@@ -471,21 +1166,26 @@ Result<void> WebSocketClient::connect() {
 	// kalshi-websocket before this fix.
 	if (data->service_thread.joinable()) {
 		data->should_stop = true;
+		lws_cancel_service(data->context);
 		data->service_thread.join();
 	}
 	if (data->context) {
+		lws_sul_cancel(&data->reconnect_timer.sul);
 		lws_context_destroy(data->context);
 		data->context = nullptr;
 	}
 	data->wsi = nullptr;
 	data->should_stop = false;
+	data->connect_failed = false;
+	data->reconnect_armed = false;
+	data->reconnect_scheduled = false;
+	data->reconnect.reset();
 
 	// Parse URL
-	std::string url = data->config.url;
-	bool use_ssl = (url.substr(0, 3) == "wss");
-	std::string host;
-	std::string path = "/";
-	int port = use_ssl ? 443 : 80;
+	const std::string& url = data->config.url;
+	data->use_ssl = (url.substr(0, 3) == "wss");
+	data->path = "/";
+	data->port = data->use_ssl ? 443 : 80;
 
 	// Extract host and path from URL
 	size_t host_start = url.find("://");
@@ -497,26 +1197,19 @@ Result<void> WebSocketClient::connect() {
 
 	size_t path_start = url.find('/', host_start);
 	if (path_start != std::string::npos) {
-		host = url.substr(host_start, path_start - host_start);
-		path = url.substr(path_start);
+		data->host = url.substr(host_start, path_start - host_start);
+		data->path = url.substr(path_start);
 	} else {
-		host = url.substr(host_start);
+		data->host = url.substr(host_start);
 	}
 
 	// Check for port in host
-	size_t port_pos = host.find(':');
+	size_t port_pos = data->host.find(':');
 	if (port_pos != std::string::npos) {
-		port = std::stoi(host.substr(port_pos + 1));
-		host = host.substr(0, port_pos);
+		data->port = std::stoi(data->host.substr(port_pos + 1));
+		data->host = data->host.substr(0, port_pos);
 	}
 
-	// Generate auth headers
-	Result<AuthHeaders> auth_result = data->signer->sign("GET", path);
-	if (!auth_result) {
-		return std::unexpected(auth_result.error());
-	}
-	data->auth_headers = *auth_result;
-
 	// Create context
 	struct lws_context_creation_info ctx_info {};
 	std::memset(&ctx_info, 0, sizeof(ctx_info));
@@ -524,53 +1217,86 @@ Result<void> WebSocketClient::connect() {
 	ctx_info.protocols = protocols;
 	ctx_info.user = data.get();
 	ctx_info.options = LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
+	if (data->config.permessage_deflate) {
+#if defined(LWS_WITHOUT_EXTENSIONS)
+		return std::unexpected(
+			Error{ErrorCode::InvalidRequest,
+				  "permessage_deflate needs libwebsockets built with extensions"});
+#else
+		ctx_info.extensions = deflate_extensions;
+#endif
+	}
 
 	data->context = lws_create_context(&ctx_info);
 	if (!data->context) {
 		return std::unexpected(Error::network("Failed to create WebSocket context"));
 	}
 
-	// Create connection
-	struct lws_client_connect_info conn_info {};
-	std::memset(&conn_info, 0, sizeof(conn_info));
-	conn_info.context = data->context;
-	conn_info.address = host.c_str();
-	conn_info.port = port;
-	conn_info.path = path.c_str();
-	conn_info.host = host.c_str();
-	// Kalshi rejects websocket upgrades that include an Origin header
-	// (403), while the documented Python websockets example sends no
-	// Origin and succeeds. Leave this unset so libwebsockets omits it.
-	conn_info.origin = nullptr;
-
-	if (use_ssl) {
-		conn_info.ssl_connection =
-			LCCSCF_USE_SSL | LCCSCF_ALLOW_SELFSIGNED | LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK;
-	}
-
-	data->wsi = lws_client_connect_via_info(&conn_info);
-	if (!data->wsi) {
+	// Create connection (signs the handshake)
+	Result<void> opened = data->open_connection();
+	if (!opened) {
 		lws_context_destroy(data->context);
 		data->context = nullptr;
-		return std::unexpected(Error::network("Failed to initiate WebSocket connection"));
+		return opened;
 	}
 
-	// Start service thread
-	data->service_thread = std::thread([&data = this->impl_->data]() {
-		while (!data->should_stop && data->context) {
-			lws_service(data->context, 50);
-		}
-	});
+	if (data->pipeline) {
+		WsImplData* const raw = data.get();
+		data->pipeline->start([raw](std::size_t worker, ws_detail::PipelineFrame& frame) {
+			raw->decode_on_worker(worker, frame);
+		});
+	}
 
-	// Wait briefly for connection (with timeout)
-	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
-	while (!data->connected && !data->should_stop) {
-		std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
-		if (elapsed > std::chrono::seconds(10)) {
+	bool up = false;
+	if (data->config.service_mode == WsServiceMode::External) {
+		// The caller's thread is the registry reader from here on; drive
+		// the handshake on it, then poll_once takes over.
+		data->subscriptions.reader_online();
+		const std::chrono::steady_clock::time_point deadline =
+			std::chrono::steady_clock::now() + kConnectTimeout;
+		while (!data->connected && !data->connect_failed &&
+			   std::chrono::steady_clock::now() < deadline) {
+			if (data->service_for(kExternalConnectPoll) < 0) {
+				break;
+			}
+		}
+		up = data->connected;
+	} else {
+		// A zero timeout never sleeps in poll(); otherwise lws sleeps until
+		// the socket, a timer or lws_cancel_service needs it.
+		const int timeout_ms =
+			data->config.service_mode == WsServiceMode::BusyPoll ? -1 : kServiceTimeoutMs;
+		data->service_thread = std::thread([&data = this->impl_->data, timeout_ms]() {
+			// Registry lookups from callbacks are lock-free; each round ends
+			// holding no snapshot, which lets writers reclaim old ones.
+			data->subscriptions.reader_online();
+			while (!data->should_stop && data->context) {
+				lws_service(data->context, timeout_ms);
+				data->subscriptions.quiesce();
+			}
+			data->subscriptions.reader_offline();
+		});
+		Result<void> tuned = ws_detail::tune_thread(data->service_thread.native_handle(),
+													data->config.service_cpu,
+													data->config.service_priority);
+		if (!tuned) {
 			disconnect();
-			return std::unexpected(Error::network("Connection timeout"));
+			return tuned;
 		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+		// Woken by ESTABLISHED or CONNECTION_ERROR; no polling.
+		std::unique_lock lock(data->state_mutex);
+		up = data->state_cv.wait_for(lock, kConnectTimeout,
+									 [&data] {
+										 return data->connected || data->connect_failed ||
+												data->should_stop;
+									 }) &&
+			 data->connected;
+	}
+	if (!up) {
+		const bool failed = data->connect_failed;
+		disconnect();
+		return std::unexpected(Error::network(failed ? "Connection failed" : "Connection timeout"));
 	}
 
 	return {};
@@ -594,22 +1320,51 @@ void WebSocketClient::disconnect() {
 	}
 
 	data->should_stop = true;
-	data->connected = false;
+	data->set_connected(false);
 	data->subscriptions.clear();
 
 	if (data->service_thread.joinable()) {
+		lws_cancel_service(data->context);
 		data->service_thread.join();
+	} else if (data->config.service_mode == WsServiceMode::External) {
+		data->subscriptions.reader_offline();
+	}
+	if (data->pipeline) {
+		// Nothing pushes any more; workers deliver what is queued and exit.
+		data->pipeline->stop();
 	}
+	data->reset_sequence_state();
 
 	if (data->context) {
+		lws_sul_cancel(&data->reconnect_timer.sul);
 		lws_context_destroy(data->context);
 		data->context = nullptr;
 	}
 	data->wsi = nullptr;
+	data->discard_sends();
+	data->reconnect.reset();
 
 	data->invoke_state_callback(false);
 }
 
+Result<void> WebSocketClient::poll_once(std::chrono::milliseconds timeout) {
+	if (!impl_) {
+		return std::unexpected(Error::network("Client moved-from"));
+	}
+	WsImplData& data = *impl_->data;
+	if (data.config.service_mode != WsServiceMode::External) {
+		return std::unexpected(
+			Error{ErrorCode::InvalidRequest, "poll_once needs WsServiceMode::External"});
+	}
+	if (!data.context || data.should_stop) {
+		return std::unexpected(Error::network("Not connected"));
+	}
+	if (data.service_for(timeout) < 0) {
+		return std::unexpected(Error::network("WebSocket service failed"));
+	}
+	return {};
+}
+
 bool WebSocketClient::is_connected() const noexcept {
 	if (!impl_) {
 		return false;
@@ -633,7 +1388,8 @@ WebSocketClient::subscribe_orderbook(const std::vector<std::string>& market_tick
 	}
 
 	std::int32_t id = data->get_next_id();
-	std::string cmd = build_subscribe_command(id, Channel::OrderbookDelta, market_tickers);
+	ws_cmd::SubscribeCmd cmd = build_subscribe_command(id, Channel::OrderbookDelta, market_tickers);
+	data->subscriptions.track(id, Channel::OrderbookDelta, market_tickers);
 	data->queue_send(cmd);
 
 	return SubscriptionId{.sid = id, .channel = Channel::OrderbookDelta};
@@ -651,7 +1407,8 @@ WebSocketClient::subscribe_trades(const std::vector<std::string>& market_tickers
 	}
 
 	std::int32_t id = data->get_next_id();
-	std::string cmd = build_subscribe_command(id, Channel::Trade, market_tickers);
+	ws_cmd::SubscribeCmd cmd = build_subscribe_command(id, Channel::Trade, market_tickers);
+	data->subscriptions.track(id, Channel::Trade, market_tickers);
 	data->queue_send(cmd);
 
 	return SubscriptionId{.sid = id, .channel = Channel::Trade};
@@ -669,7 +1426,8 @@ WebSocketClient::subscribe_fills(const std::vector<std::string>& market_tickers)
 	}
 
 	std::int32_t id = data->get_next_id();
-	std::string cmd = build_subscribe_command(id, Channel::Fill, market_tickers);
+	ws_cmd::SubscribeCmd cmd = build_subscribe_command(id, Channel::Fill, market_tickers);
+	data->subscriptions.track(id, Channel::Fill, market_tickers);
 	data->queue_send(cmd);
 
 	return SubscriptionId{.sid = id, .channel = Channel::Fill};
@@ -686,12 +1444,37 @@ Result<SubscriptionId> WebSocketClient::subscribe_lifecycle() {
 	}
 
 	std::int32_t id = data->get_next_id();
-	std::string cmd = build_subscribe_command(id, Channel::MarketLifecycle, {});
+	ws_cmd::SubscribeCmd cmd = build_subscribe_command(id, Channel::MarketLifecycle, {});
+	data->subscriptions.track(id, Channel::MarketLifecycle, {});
 	data->queue_send(cmd);
 
 	return SubscriptionId{.sid = id, .channel = Channel::MarketLifecycle};
 }
 
+Result<SubscriptionId> WebSocketClient::subscribe(Channel channel,
+												  const std::vector<std::string>& market_tickers,
+												  std::optional<WsShard> shard) {
+	if (!impl_) {
+		return std::unexpected(Error::network("Client moved-from"));
+	}
+	std::unique_ptr<WsImplData>& data = impl_->data;
+
+	if (!data->connected) {
+		return std::unexpected(Error::network("Not connected"));
+	}
+
+	if (shard && (shard->factor < 1 || shard->key < 0 || shard->key >= shard->factor)) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "shard_key out of range"});
+	}
+
+	std::int32_t id = data->get_next_id();
+	ws_cmd::SubscribeCmd cmd = build_subscribe_command(id, channel, market_tickers, shard);
+	data->subscriptions.track(id, channel, market_tickers, shard);
+	data->queue_send(cmd);
+
+	return SubscriptionId{.sid = id, .channel = channel};
+}
+
 Result<void> WebSocketClient::unsubscribe(SubscriptionId sub_id) {
 	if (!impl_) {
 		return std::unexpected(Error::network("Client moved-from"));
@@ -703,8 +1486,13 @@ Result<void> WebSocketClient::unsubscribe(SubscriptionId sub_id) {
 	}
 
 	std::int32_t id = data->get_next_id();
-	std::string cmd = build_unsubscribe_command(id, data->subscriptions.resolve(sub_id.sid));
+	const std::int32_t server_sid = data->subscriptions.server_sid(sub_id.sid);
+	ws_cmd::UnsubscribeCmd cmd =
+		build_unsubscribe_command(id, server_sid != 0 ? server_sid : sub_id.sid);
 	data->subscriptions.erase(sub_id.sid);
+	if (server_sid != 0) {
+		data->retire_sid(server_sid);
+	}
 	data->queue_send(cmd);
 
 	return {};
@@ -726,8 +1514,9 @@ Result<void> WebSocketClient::add_markets(SubscriptionId sub_id,
 	}
 
 	std::int32_t id = data->get_next_id();
-	std::string cmd = build_update_command(id, data->subscriptions.resolve(sub_id.sid),
-										   "add_markets", sub_id.channel, market_tickers);
+	ws_cmd::UpdateCmd cmd = build_update_command(id, data->subscriptions.resolve(sub_id.sid),
+												 "add_markets", sub_id.channel, market_tickers);
+	data->subscriptions.add_markets(sub_id.sid, market_tickers);
 	data->queue_send(cmd);
 
 	return {};
@@ -749,8 +1538,9 @@ Result<void> WebSocketClient::remove_markets(SubscriptionId sub_id,
 	}
 
 	std::int32_t id = data->get_next_id();
-	std::string cmd = build_update_command(id, data->subscriptions.resolve(sub_id.sid),
-										   "delete_markets", sub_id.channel, market_tickers);
+	ws_cmd::UpdateCmd cmd = build_update_command(id, data->subscriptions.resolve(sub_id.sid),
+												 "delete_markets", sub_id.channel, market_tickers);
+	data->subscriptions.remove_markets(sub_id.sid, market_tickers);
 	data->queue_send(cmd);
 
 	return {};
@@ -761,9 +1551,19 @@ void WebSocketClient::on_message(WsMessageCallback callback) {
 		return;
 	}
 	std::lock_guard lock(impl_->data->callback_mutex);
+	const std::vector<std::unique_lock<std::mutex>> lanes = impl_->data->lock_lanes();
 	impl_->data->message_callback = std::move(callback);
 }
 
+void WebSocketClient::on_event(WsEventCallback callback) {
+	if (!impl_) {
+		return;
+	}
+	std::lock_guard lock(impl_->data->callback_mutex);
+	const std::vector<std::unique_lock<std::mutex>> lanes = impl_->data->lock_lanes();
+	impl_->data->event_callback = std::move(callback);
+}
+
 void WebSocketClient::on_error(WsErrorCallback callback) {
 	if (!impl_) {
 		return;
@@ -780,6 +1580,102 @@ void WebSocketClient::on_state_change(WsStateCallback callback) {
 	impl_->data->state_callback = std::move(callback);
 }
 
+void WebSocketClient::on_sequence_gap(WsSeqGapCallback callback) {
+	if (!impl_) {
+		return;
+	}
+	std::lock_guard lock(impl_->data->callback_mutex);
+	impl_->data->gap_callback = std::move(callback);
+}
+
+void WebSocketClient::on_backpressure(WsBackpressureCallback callback) {
+	if (!impl_) {
+		return;
+	}
+	std::lock_guard lock(impl_->data->callback_mutex);
+	impl_->data->backpressure_callback = std::move(callback);
+}
+
+std::size_t WebSocketClient::poll(std::span<WsMessage> out) {
+	if (!impl_ || !impl_->data->inbound) {
+		return 0;
+	}
+	return impl_->data->inbound->pop_bulk(out);
+}
+
+WsQueueStats WebSocketClient::queue_stats() const noexcept {
+	if (!impl_ || !impl_->data->inbound) {
+		return {};
+	}
+	const std::unique_ptr<WsImplData>& data = impl_->data;
+	return WsQueueStats{
+		.depth = data->inbound->size(),
+		.capacity = data->inbound->capacity(),
+		.enqueued = data->inbound_enqueued.load(std::memory_order_relaxed),
+		.dropped = data->inbound_dropped.load(std::memory_order_relaxed),
+		.bytes = data->inbound->bytes(),
+		.evicted = data->inbound_evicted.load(std::memory_order_relaxed),
+	};
+}
+
+WsReconnectStats WebSocketClient::reconnect_stats() const noexcept {
+	if (!impl_) {
+		return {};
+	}
+	return impl_->data->reconnect.stats();
+}
+
+WsCompressionStats WebSocketClient::compression_stats() const noexcept {
+	if (!impl_) {
+		return {};
+	}
+	const WsImplData& data = *impl_->data;
+	return {
+		.negotiated = data.deflate_negotiated.load(std::memory_order_relaxed),
+		.wire_bytes = data.deflate_wire_bytes.load(std::memory_order_relaxed),
+		.inflated_bytes = data.deflate_inflated_bytes.load(std::memory_order_relaxed),
+		.inflate_time = std::chrono::nanoseconds(
+			data.deflate_inflate_ns.load(std::memory_order_relaxed)),
+	};
+}
+
+WsPipelineStats WebSocketClient::pipeline_stats() const noexcept {
+	if (!impl_ || !impl_->data->pipeline) {
+		return {};
+	}
+	const ws_detail::DecodePipeline& pipeline = *impl_->data->pipeline;
+	const ws_detail::DecodePipelineStats stats = pipeline.stats();
+	return {
+		.workers = pipeline.workers(),
+		.depth = pipeline.depth(),
+		.frames = stats.frames,
+		.stalls = stats.stalls,
+		.bytes = pipeline.bytes(),
+		.dropped = stats.dropped,
+		.evicted = stats.evicted + stats.flushed,
+	};
+}
+
+WsOverflowStats WebSocketClient::overflow_stats() const noexcept {
+	if (!impl_) {
+		return {};
+	}
+	const WsImplData& data = *impl_->data;
+	return {
+		.conflated = data.overflow_conflated.load(std::memory_order_relaxed),
+		.resyncs = data.overflow_resyncs.load(std::memory_order_relaxed),
+		.oversized = data.overflow_oversized.load(std::memory_order_relaxed),
+		.high_watermarks = data.high_watermarks.load(std::memory_order_relaxed),
+	};
+}
+
+std::shared_ptr<TickerTable> WebSocketClient::ticker_table() const noexcept {
+	if (!impl_) {
+		return nullptr;
+	}
+	return impl_->data->config.ticker_table;
+}
+
 const WsConfig& WebSocketClient::config() const noexcept {
 	// Returning a reference into a nullptr would crash; surface a
 	// static empty config so accessors stay safe on moved-from
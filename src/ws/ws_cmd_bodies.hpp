@@ -17,8 +17,8 @@
 /// against the pre-migration baselines.
 ///
 /// IMPORTANT: only the OUTGOING command builders use this. The WS
-/// `handle_message` hot path uses the hand-rolled scanners in
-/// `kalshi/detail/ws_json.hpp` and is deliberately not migrated.
+/// `handle_message` hot path uses the hand-rolled single-pass decoder
+/// in `frame_decoder.cpp` and is deliberately not migrated.
 
 #include <cstdint>
 #include <glaze/glaze.hpp>
@@ -31,6 +31,8 @@ namespace kalshi::ws_cmd {
 struct SubscribeParams {
 	std::vector<std::string> channels;
 	std::optional<std::vector<std::string>> market_tickers;
+	std::optional<std::int32_t> shard_factor;
+	std::optional<std::int32_t> shard_key;
 };
 
 struct SubscribeCmd {
@@ -71,6 +73,11 @@ template <class T>
 	return out;
 }
 
+/// Render into ``out``, replacing its contents but keeping its capacity.
+template <class T> inline void render_cmd(const T& cmd, std::string& out) {
+	(void)glz::write<kCmdOpts>(cmd, out);
+}
+
 } // namespace kalshi::ws_cmd
 
 // ===== glz::meta specializations =====
@@ -79,7 +86,8 @@ template <>
 struct glz::meta<kalshi::ws_cmd::SubscribeParams> {
 	using T = kalshi::ws_cmd::SubscribeParams;
 	static constexpr auto value = // auto-ok: glz::object returns unspellable tuple
-		object("channels", &T::channels, "market_tickers", &T::market_tickers);
+		object("channels", &T::channels, "market_tickers", &T::market_tickers, "shard_factor",
+			   &T::shard_factor, "shard_key", &T::shard_key);
 };
 
 template <>
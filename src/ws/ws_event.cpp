@@ -0,0 +1,171 @@
+#include "kalshi/ws_event.hpp"
+
+#include "kalshi/websocket.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <variant>
+
+namespace kalshi {
+
+namespace {
+
+int hex_value(char c) noexcept {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+std::int16_t to_cents16(std::int32_t cents) noexcept {
+	return static_cast<std::int16_t>(std::clamp<std::int32_t>(
+		cents, std::numeric_limits<std::int16_t>::min(), std::numeric_limits<std::int16_t>::max()));
+}
+
+Uuid parse_or_nil(std::string_view text) noexcept {
+	return Uuid::parse(text).value_or(Uuid{});
+}
+
+} // namespace
+
+std::optional<Uuid> Uuid::parse(std::string_view text) noexcept {
+	const bool hyphenated = text.size() == 36;
+	if (!hyphenated && text.size() != 32) {
+		return std::nullopt;
+	}
+	Uuid out;
+	std::size_t pos = 0;
+	for (std::size_t i = 0; i < out.bytes.size(); ++i) {
+		if (hyphenated && (pos == 8 || pos == 13 || pos == 18 || pos == 23)) {
+			if (text[pos] != '-') {
+				return std::nullopt;
+			}
+			++pos;
+		}
+		const int hi = hex_value(text[pos]);
+		const int lo = hex_value(text[pos + 1]);
+		if (hi < 0 || lo < 0) {
+			return std::nullopt;
+		}
+		out.bytes[i] = static_cast<std::uint8_t>((hi << 4) | lo);
+		pos += 2;
+	}
+	return out;
+}
+
+std::string Uuid::to_string() const {
+	if (is_nil()) {
+		return {};
+	}
+	static constexpr char kDigits[] = "0123456789abcdef";
+	std::string out;
+	out.reserve(36);
+	for (std::size_t i = 0; i < bytes.size(); ++i) {
+		if (i == 4 || i == 6 || i == 8 || i == 10) {
+			out.push_back('-');
+		}
+		out.push_back(kDigits[bytes[i] >> 4]);
+		out.push_back(kDigits[bytes[i] & 0x0F]);
+	}
+	return out;
+}
+
+std::optional<WsEvent> to_event(const WsMessage& msg) noexcept {
+	WsEvent ev;
+	if (const OrderbookDelta* delta = std::get_if<OrderbookDelta>(&msg)) {
+		ev.kind = WsEventKind::Delta;
+		ev.sid = delta->sid;
+		ev.seq = delta->seq;
+		ev.ticker_id = delta->ticker_id;
+		ev.side = delta->side;
+		ev.price = to_cents16(delta->price);
+		ev.quantity = delta->delta;
+		return ev;
+	}
+	if (const WsTrade* trade = std::get_if<WsTrade>(&msg)) {
+		ev.kind = WsEventKind::Trade;
+		ev.sid = trade->sid;
+		ev.ticker_id = trade->ticker_id;
+		ev.side = trade->taker_side;
+		ev.price = to_cents16(trade->yes_price);
+		ev.no_price = to_cents16(trade->no_price);
+		ev.quantity = trade->count;
+		ev.timestamp = trade->timestamp;
+		ev.trade_id = parse_or_nil(trade->trade_id);
+		return ev;
+	}
+	if (const WsFill* fill = std::get_if<WsFill>(&msg)) {
+		ev.kind = WsEventKind::Fill;
+		ev.sid = fill->sid;
+		ev.ticker_id = fill->ticker_id;
+		ev.side = fill->side;
+		ev.action = fill->action;
+		ev.is_taker = fill->is_taker;
+		ev.price = to_cents16(fill->yes_price);
+		ev.no_price = to_cents16(fill->no_price);
+		ev.quantity = fill->count;
+		ev.timestamp = fill->timestamp;
+		ev.trade_id = parse_or_nil(fill->trade_id);
+		ev.order_id = parse_or_nil(fill->order_id);
+		return ev;
+	}
+	return std::nullopt;
+}
+
+WsMessage to_message(const WsEvent& event, const TickerTable* tickers) {
+	std::string ticker = tickers != nullptr ? std::string(tickers->name(event.ticker_id)) : "";
+	switch (event.kind) {
+		case WsEventKind::Trade: {
+			WsTrade trade;
+			trade.sid = event.sid;
+			trade.trade_id = event.trade_id.to_string();
+			trade.market_ticker = std::move(ticker);
+			trade.yes_price = event.price;
+			trade.no_price = event.no_price;
+			trade.count = event.quantity;
+			trade.taker_side = event.side;
+			trade.timestamp = event.timestamp;
+			trade.ticker_id = event.ticker_id;
+			return trade;
+		}
+		case WsEventKind::Fill: {
+			WsFill fill;
+			fill.sid = event.sid;
+			fill.trade_id = event.trade_id.to_string();
+			fill.order_id = event.order_id.to_string();
+			fill.market_ticker = std::move(ticker);
+			fill.is_taker = event.is_taker;
+			fill.side = event.side;
+			fill.yes_price = event.price;
+			fill.no_price = event.no_price;
+			fill.count = event.quantity;
+			fill.yes_price_dollars = Price::from_cents(event.price);
+			fill.no_price_dollars = Price::from_cents(event.no_price);
+			fill.count_fp = Quantity::from_contracts(event.quantity);
+			fill.action = event.action;
+			fill.timestamp = event.timestamp;
+			fill.ticker_id = event.ticker_id;
+			return fill;
+		}
+		case WsEventKind::Delta:
+		case WsEventKind::None:
+			break;
+	}
+	OrderbookDelta delta;
+	delta.sid = event.sid;
+	delta.seq = event.seq;
+	delta.market_ticker = std::move(ticker);
+	delta.price = event.price;
+	delta.delta = event.quantity;
+	delta.side = event.side;
+	delta.ticker_id = event.ticker_id;
+	return delta;
+}
+
+} // namespace kalshi
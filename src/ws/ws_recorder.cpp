@@ -0,0 +1,489 @@
+#include "kalshi/ws_recorder.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kalshi {
+
+namespace {
+
+constexpr std::size_t kFileHeaderSize = 16;
+constexpr std::size_t kRecordHeaderSize = 16;
+
+constexpr std::size_t padded(std::size_t n) noexcept {
+	return (n + 7) & ~std::size_t{7};
+}
+
+void write_file_header(char* out) noexcept {
+	std::memset(out, 0, kFileHeaderSize);
+	std::memcpy(out, kWsLogMagic.data(), kWsLogMagic.size());
+	const std::uint16_t version = kWsLogVersion;
+	const std::uint16_t header_size = kFileHeaderSize;
+	std::memcpy(out + 8, &version, sizeof(version));
+	std::memcpy(out + 10, &header_size, sizeof(header_size));
+}
+
+// Validates a file header; returns the offset of the first record.
+Result<std::size_t> check_file_header(const char* data, std::size_t size) {
+	if (size < kFileHeaderSize || std::memcmp(data, kWsLogMagic.data(), kWsLogMagic.size()) != 0) {
+		return std::unexpected(Error::parse("Not a WebSocket capture log"));
+	}
+	std::uint16_t version = 0;
+	std::uint16_t header_size = 0;
+	std::memcpy(&version, data + 8, sizeof(version));
+	std::memcpy(&header_size, data + 10, sizeof(header_size));
+	if (version != kWsLogVersion || header_size < kFileHeaderSize || header_size > size) {
+		return std::unexpected(Error::parse("Unsupported WebSocket capture log version"));
+	}
+	return std::size_t{header_size};
+}
+
+} // namespace
+
+// ===== WsRecorder =====
+
+struct WsRecorder::Impl {
+	WsRecorderConfig config;
+	std::FILE* file{nullptr};
+
+	std::unique_ptr<char[]> ring;
+	std::size_t capacity{0};
+	std::size_t mask{0};
+
+	// Producers advance `head` under `producer_lock`; the writer thread
+	// alone advances `tail`. Both count bytes since construction.
+	alignas(64) std::atomic<std::uint64_t> head{0};
+	alignas(64) std::atomic<std::uint64_t> tail{0};
+	std::atomic_flag producer_lock;
+	std::vector<bool> tickers_logged; ///< By TickerId value; under producer_lock
+
+	std::atomic<std::uint64_t> records{0};
+	std::atomic<std::uint64_t> dropped{0};
+	std::atomic<std::uint64_t> bytes_written{0};
+
+	std::mutex wake_mutex;
+	std::condition_variable wake_cv;
+	std::condition_variable drained_cv;
+	bool flush_requested{false};
+	bool stopping{false};
+	std::thread writer;
+
+	~Impl() {
+		{
+			std::lock_guard lock(wake_mutex);
+			stopping = true;
+		}
+		wake_cv.notify_one();
+		if (writer.joinable()) {
+			writer.join();
+		}
+		if (file != nullptr) {
+			std::fclose(file);
+		}
+	}
+
+	void copy_in(std::uint64_t at, const void* src, std::size_t n) noexcept {
+		if (n == 0) {
+			return; // ``src`` may be null (an empty string_view)
+		}
+		const std::size_t offset = static_cast<std::size_t>(at) & mask;
+		const std::size_t first = std::min(n, capacity - offset);
+		std::memcpy(ring.get() + offset, src, first);
+		std::memcpy(ring.get(), static_cast<const char*>(src) + first, n - first);
+	}
+
+	void zero_fill(std::uint64_t at, std::size_t n) noexcept {
+		static constexpr char kZeros[8]{};
+		copy_in(at, kZeros, n);
+	}
+
+	void lock_producers() noexcept {
+		while (producer_lock.test_and_set(std::memory_order_acquire)) {
+			producer_lock.wait(true, std::memory_order_relaxed);
+		}
+	}
+
+	void unlock_producers() noexcept {
+		producer_lock.clear(std::memory_order_release);
+		producer_lock.notify_one();
+	}
+
+	static constexpr std::size_t record_size(std::size_t payload) noexcept {
+		return kRecordHeaderSize + padded(payload);
+	}
+
+	// Copies one record at `at`; the payload is `a` followed by `b`.
+	void write_record(std::uint64_t at, WsLogRecordType type, std::uint64_t recv_ns,
+					  std::string_view a, std::string_view b) noexcept {
+		const std::size_t length = a.size() + b.size();
+		char header[kRecordHeaderSize]{};
+		const std::uint32_t length32 = static_cast<std::uint32_t>(length);
+		const std::uint16_t type16 = static_cast<std::uint16_t>(type);
+		std::memcpy(header, &length32, sizeof(length32));
+		std::memcpy(header + 4, &type16, sizeof(type16));
+		std::memcpy(header + 8, &recv_ns, sizeof(recv_ns));
+		copy_in(at, header, sizeof(header));
+		copy_in(at + kRecordHeaderSize, a.data(), a.size());
+		copy_in(at + kRecordHeaderSize + a.size(), b.data(), b.size());
+		zero_fill(at + kRecordHeaderSize + length, padded(length) - length);
+	}
+
+	// Reserves `total` bytes under the producer lock; false (lock
+	// released, drop counted) when they do not fit.
+	bool reserve(std::size_t total, std::uint64_t& at, std::uint64_t& used) noexcept {
+		lock_producers();
+		return reserve_locked(total, at, used);
+	}
+
+	// `reserve` for a caller already holding the producer lock.
+	bool reserve_locked(std::size_t total, std::uint64_t& at, std::uint64_t& used) noexcept {
+		at = head.load(std::memory_order_relaxed);
+		used = at - tail.load(std::memory_order_acquire);
+		if (total > capacity || used + total > capacity) {
+			unlock_producers();
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			wake_cv.notify_one();
+			return false;
+		}
+		return true;
+	}
+
+	void commit(std::uint64_t end, std::uint64_t used_after) noexcept {
+		head.store(end, std::memory_order_release);
+		unlock_producers();
+		records.fetch_add(1, std::memory_order_relaxed);
+		// Past half full: wake the writer early rather than wait out the
+		// interval. Rare, and notify without the mutex never blocks.
+		if (used_after > capacity / 2) {
+			wake_cv.notify_one();
+		}
+	}
+
+	bool record(std::string_view frame, std::uint64_t recv_ns) noexcept {
+		if (frame.size() > UINT32_MAX) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		const std::size_t total = record_size(frame.size());
+		std::uint64_t at = 0;
+		std::uint64_t used = 0;
+		if (!reserve(total, at, used)) {
+			return false;
+		}
+		write_record(at, WsLogRecordType::Frame, recv_ns, frame, {});
+		commit(at + total, used + total);
+		return true;
+	}
+
+	bool record_event(const WsEvent& event, std::string_view ticker,
+					  std::uint64_t recv_ns) noexcept {
+		const std::string_view bytes(reinterpret_cast<const char*>(&event), sizeof(event));
+		const std::uint32_t id = event.ticker_id.value;
+		const std::size_t event_size = record_size(sizeof(event));
+		const std::size_t ticker_size = record_size(sizeof(id) + ticker.size());
+
+		std::uint64_t at = 0;
+		std::uint64_t used = 0;
+		// A new ticker's name is reserved with its first event so the two
+		// land together or not at all; later events reserve only themselves.
+		lock_producers();
+		const bool announce = event.ticker_id.valid() && !announced(id);
+		const std::size_t total = event_size + (announce ? ticker_size : 0);
+		if (!reserve_locked(total, at, used)) {
+			return false;
+		}
+		if (announce) {
+			mark_announced(id);
+			write_record(at, WsLogRecordType::Ticker, recv_ns,
+						 std::string_view(reinterpret_cast<const char*>(&id), sizeof(id)), ticker);
+			at += ticker_size;
+		}
+		write_record(at, WsLogRecordType::Event, recv_ns, bytes, {});
+		commit(at + event_size, used + total);
+		return true;
+	}
+
+	// True when `id`'s name was already written. Producer lock held.
+	[[nodiscard]] bool announced(std::uint32_t id) const noexcept {
+		return id < tickers_logged.size() && tickers_logged[id];
+	}
+
+	// Producer lock held.
+	void mark_announced(std::uint32_t id) noexcept {
+		if (id >= tickers_logged.size()) {
+			try {
+				tickers_logged.resize(std::max<std::size_t>(id + 1, tickers_logged.size() * 2));
+			} catch (...) {
+				return; // Re-announcing is harmless
+			}
+		}
+		tickers_logged[id] = true;
+	}
+
+	// Writer thread only.
+	void drain() {
+		std::uint64_t t = tail.load(std::memory_order_relaxed);
+		const std::uint64_t h = head.load(std::memory_order_acquire);
+		if (t == h) {
+			return;
+		}
+		while (t < h) {
+			const std::size_t offset = static_cast<std::size_t>(t) & mask;
+			const std::size_t n = std::min<std::size_t>(h - t, capacity - offset);
+			const std::size_t wrote = std::fwrite(ring.get() + offset, 1, n, file);
+			bytes_written.fetch_add(wrote, std::memory_order_relaxed);
+			t += n; // A failed write loses the bytes rather than stalling producers.
+		}
+		std::fflush(file);
+		tail.store(t, std::memory_order_release);
+	}
+
+	void run_writer() {
+		std::unique_lock lock(wake_mutex);
+		for (;;) {
+			wake_cv.wait_for(lock, config.flush_interval,
+							 [this] { return stopping || flush_requested; });
+			const bool stop = stopping;
+			flush_requested = false;
+			lock.unlock();
+			drain();
+			lock.lock();
+			drained_cv.notify_all();
+			if (stop) {
+				return;
+			}
+		}
+	}
+
+	void flush() {
+		const std::uint64_t target = head.load(std::memory_order_acquire);
+		std::unique_lock lock(wake_mutex);
+		flush_requested = true;
+		wake_cv.notify_one();
+		drained_cv.wait(lock, [&] {
+			return stopping || tail.load(std::memory_order_acquire) >= target;
+		});
+	}
+};
+
+Result<WsRecorder> WsRecorder::open(WsRecorderConfig config) {
+	if (config.path.empty()) {
+		return std::unexpected(Error{ErrorCode::InvalidRequest, "Recorder path is empty"});
+	}
+
+	// Appending to an existing log: its header must be ours.
+	bool needs_header = true;
+	if (!config.truncate) {
+		std::ifstream existing(config.path, std::ios::binary);
+		if (existing) {
+			char header[kFileHeaderSize]{};
+			existing.read(header, sizeof(header));
+			const std::size_t got = static_cast<std::size_t>(existing.gcount());
+			if (got > 0) {
+				Result<std::size_t> checked = check_file_header(header, got);
+				if (!checked) {
+					return std::unexpected(checked.error());
+				}
+				needs_header = false;
+			}
+		}
+	}
+
+	std::unique_ptr<Impl> impl = std::make_unique<Impl>();
+	impl->file = std::fopen(config.path.c_str(), config.truncate ? "wb" : "ab");
+	if (impl->file == nullptr) {
+		return std::unexpected(
+			Error{ErrorCode::InvalidRequest, "Failed to open capture log: " + config.path});
+	}
+	if (needs_header) {
+		char header[kFileHeaderSize];
+		write_file_header(header);
+		if (std::fwrite(header, 1, sizeof(header), impl->file) != sizeof(header) ||
+			std::fflush(impl->file) != 0) {
+			return std::unexpected(
+				Error{ErrorCode::InvalidRequest, "Failed to write capture log: " + config.path});
+		}
+	}
+
+	impl->capacity = std::bit_ceil(std::max<std::size_t>(config.buffer_bytes, 4096));
+	impl->mask = impl->capacity - 1;
+	impl->ring = std::make_unique<char[]>(impl->capacity);
+	impl->config = std::move(config);
+	impl->writer = std::thread([raw = impl.get()] { raw->run_writer(); });
+	return WsRecorder(std::move(impl));
+}
+
+WsRecorder::WsRecorder(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+WsRecorder::~WsRecorder() = default;
+WsRecorder::WsRecorder(WsRecorder&&) noexcept = default;
+WsRecorder& WsRecorder::operator=(WsRecorder&&) noexcept = default;
+
+bool WsRecorder::record(std::string_view frame, std::uint64_t recv_ns) noexcept {
+	return impl_ && impl_->record(frame, recv_ns);
+}
+
+bool WsRecorder::record_event(const WsEvent& event, std::string_view ticker,
+							  std::uint64_t recv_ns) noexcept {
+	return impl_ && impl_->record_event(event, ticker, recv_ns);
+}
+
+bool WsRecorder::records_frames() const noexcept {
+	return impl_ && impl_->config.frames;
+}
+
+bool WsRecorder::records_events() const noexcept {
+	return impl_ && impl_->config.events;
+}
+
+void WsRecorder::flush() {
+	if (impl_) {
+		impl_->flush();
+	}
+}
+
+WsRecorderStats WsRecorder::stats() const noexcept {
+	if (!impl_) {
+		return {};
+	}
+	return WsRecorderStats{impl_->records.load(std::memory_order_relaxed),
+						   impl_->dropped.load(std::memory_order_relaxed),
+						   impl_->bytes_written.load(std::memory_order_relaxed)};
+}
+
+const std::string& WsRecorder::path() const noexcept {
+	static const std::string empty;
+	return impl_ ? impl_->config.path : empty;
+}
+
+// ===== WsLogReader =====
+
+struct WsLogReader::Impl {
+	const char* data{nullptr};
+	std::size_t size{0};
+	std::size_t first{0};
+	std::size_t pos{0};
+	bool truncated{false};
+
+#if !defined(_WIN32)
+	void* mapping{nullptr};
+#endif
+	std::string owned; // Fallback when the file cannot be mapped
+
+	~Impl() {
+#if !defined(_WIN32)
+		if (mapping != nullptr) {
+			::munmap(mapping, size);
+		}
+#endif
+	}
+};
+
+Result<WsLogReader> WsLogReader::open(const std::string& path) {
+	std::unique_ptr<Impl> impl = std::make_unique<Impl>();
+#if !defined(_WIN32)
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd >= 0) {
+		struct stat st {};
+		if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+			void* map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ,
+							   MAP_PRIVATE, fd, 0);
+			if (map != MAP_FAILED) {
+				impl->mapping = map;
+				impl->data = static_cast<const char*>(map);
+				impl->size = static_cast<std::size_t>(st.st_size);
+			}
+		}
+		::close(fd);
+	}
+#endif
+	if (impl->data == nullptr) {
+		std::ifstream in(path, std::ios::binary);
+		if (!in) {
+			return std::unexpected(
+				Error{ErrorCode::InvalidRequest, "Failed to open capture log: " + path});
+		}
+		impl->owned.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		impl->data = impl->owned.data();
+		impl->size = impl->owned.size();
+	}
+
+	Result<std::size_t> first = check_file_header(impl->data, impl->size);
+	if (!first) {
+		return std::unexpected(first.error());
+	}
+	impl->first = *first;
+	impl->pos = *first;
+	return WsLogReader(std::move(impl));
+}
+
+WsLogReader::WsLogReader(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+WsLogReader::~WsLogReader() = default;
+WsLogReader::WsLogReader(WsLogReader&&) noexcept = default;
+WsLogReader& WsLogReader::operator=(WsLogReader&&) noexcept = default;
+
+bool WsLogReader::next(WsLogRecord& out) noexcept {
+	if (!impl_) {
+		return false;
+	}
+	Impl& r = *impl_;
+	if (r.pos >= r.size) {
+		return false;
+	}
+	if (r.size - r.pos < kRecordHeaderSize) {
+		r.truncated = true;
+		r.pos = r.size;
+		return false;
+	}
+	std::uint32_t length = 0;
+	std::uint16_t type = 0;
+	std::uint64_t recv_ns = 0;
+	std::memcpy(&length, r.data + r.pos, sizeof(length));
+	std::memcpy(&type, r.data + r.pos + 4, sizeof(type));
+	std::memcpy(&recv_ns, r.data + r.pos + 8, sizeof(recv_ns));
+	const std::size_t body = r.pos + kRecordHeaderSize;
+	if (r.size - body < length) {
+		r.truncated = true;
+		r.pos = r.size;
+		return false;
+	}
+	out.recv_ns = recv_ns;
+	out.type = static_cast<WsLogRecordType>(type);
+	out.payload = std::string_view(r.data + body, length);
+	r.pos = std::min(r.size, body + padded(length));
+	return true;
+}
+
+void WsLogReader::rewind() noexcept {
+	if (impl_) {
+		impl_->pos = impl_->first;
+		impl_->truncated = false;
+	}
+}
+
+bool WsLogReader::truncated() const noexcept {
+	return impl_ && impl_->truncated;
+}
+
+std::size_t WsLogReader::size_bytes() const noexcept {
+	return impl_ ? impl_->size : 0;
+}
+
+} // namespace kalshi
@@ -0,0 +1,161 @@
+#pragma once
+
+// Wire payloads for hot_path_benchmark.cpp.
+//
+// Frames and objects carry the full field set of current Kalshi v2
+// messages, including the fields the SDK does not read and the legacy
+// integer forms still sent next to ``_dollars`` / ``_fp``, so the scanners
+// skip as much as they do live. REST pages repeat one object with the
+// ticker suffix and prices varied.
+
+#include <array>
+#include <string>
+#include <string_view>
+
+namespace kalshi::bench {
+
+// ===== WebSocket frames =====
+
+inline constexpr std::string_view kOrderbookDeltaFrame =
+	R"({"type":"orderbook_delta","sid":2,"seq":501,"msg":{"market_ticker":"KXHIGHDEN-26APR20-T62",)"
+	R"("market_id":"9b0f6d2e-3c55-4a6f-9b1e-0f3f5b7c2d11","price":42,"price_dollars":"0.4200",)"
+	R"("delta":-31,"delta_fp":"-30.87","side":"no","ts":"2026-04-20T08:19:13.898Z"}})";
+
+inline constexpr std::string_view kOrderbookSnapshotFrame =
+	R"({"type":"orderbook_snapshot","sid":3,"seq":1,)"
+	R"("msg":{"market_ticker":"KXHIGHDEN-26APR20-T62",)"
+	R"("market_id":"9b0f6d2e-3c55-4a6f-9b1e-0f3f5b7c2d11",)"
+	R"("yes":[[1,2500],[5,120],[18,40],[29,15],[33,260],[36,75],[39,12],[40,310],[41,48],[42,91]],)"
+	R"("no":[[1,1800],[10,60],[22,33],[34,18],[45,220],[51,64],[54,7],[55,150],[56,22],[57,31]]}})";
+
+inline constexpr std::string_view kTradeFrame =
+	R"({"type":"trade","sid":11,"msg":{"trade_id":"d91bc706-ee49-470d-82d8-11418bda6fed",)"
+	R"("market_ticker":"KXHIGHDEN-26APR20-T62","yes_price":32,"yes_price_dollars":"0.3200",)"
+	R"("no_price":68,"no_price_dollars":"0.6800","count":40,"count_fp":"40.00",)"
+	R"("taker_side":"yes","ts":1776673036}})";
+
+inline constexpr std::string_view kFillFrame =
+	R"({"type":"fill","sid":4,"msg":{"trade_id":"d91bc706-ee49-470d-82d8-11418bda6fed",)"
+	R"("order_id":"ee587a1c-8b87-4dcf-b721-9f6f790619fa","market_ticker":"KXHIGHDEN-26APR20-T62",)"
+	R"("is_taker":true,"side":"yes","yes_price":55,"yes_price_dollars":"0.5500",)"
+	R"("no_price_dollars":"0.4500","count":3,"count_fp":"3.00","action":"buy",)"
+	R"("post_position_fp":"12.00","ts":1776673036}})";
+
+inline constexpr std::string_view kLifecycleFrame =
+	R"({"type":"market_lifecycle_v2","sid":13,"msg":{"market_ticker":"KXHIGHDEN-26APR20-T62",)"
+	R"("event_type":"determined","open_ts":1776600000,"close_ts":1776686400,)"
+	R"("determination_ts":1776690000,"result":"no","is_deactivated":false}})";
+
+struct NamedFrame {
+	std::string_view type;
+	std::string_view frame;
+};
+
+inline constexpr std::array<NamedFrame, 5> kFrames{{
+	{"orderbook_delta", kOrderbookDeltaFrame},
+	{"orderbook_snapshot", kOrderbookSnapshotFrame},
+	{"trade", kTradeFrame},
+	{"fill", kFillFrame},
+	{"market_lifecycle", kLifecycleFrame},
+}};
+
+// ===== REST pages =====
+
+/// ``GET /markets`` page of ``n`` markets
+inline std::string markets_page(int n) {
+	std::string body = R"({"markets":[)";
+	for (int i = 0; i < n; ++i) {
+		const std::string strike = std::to_string(40 + i % 50);
+		const std::string bid = std::to_string(10 + i % 80);
+		const std::string ask = std::to_string(12 + i % 80);
+		if (i > 0) {
+			body += ',';
+		}
+		body += R"({"ticker":"KXHIGHDEN-26APR20-T)" + strike + "-" + std::to_string(i) +
+				R"(","event_ticker":"KXHIGHDEN-26APR20","market_type":"binary",)"
+				R"("title":"Will the high temp in Denver be >)" +
+				strike +
+				R"(° on Apr 20, 2026?","subtitle":")" + strike +
+				R"(° or above","yes_sub_title":")" + strike +
+				R"(° or above","no_sub_title":"Below )" + strike +
+				R"(°","open_time":"2026-04-19T14:00:00Z","close_time":"2026-04-21T04:59:00Z",)"
+				R"("expected_expiration_time":"2026-04-21T14:00:00Z",)"
+				R"("latest_expiration_time":"2026-04-27T14:00:00Z",)"
+				R"("settlement_timer_seconds":1800,)"
+				R"("status":"active","response_price_units":"usd_cent",)"
+				R"("yes_bid":)" + bid + R"(,"yes_bid_dollars":"0.)" + bid +
+				R"(00","yes_ask":)" + ask + R"(,"yes_ask_dollars":"0.)" + ask +
+				R"(00","no_bid":)" + std::to_string(100 - 12 - i % 80) +
+				R"(,"no_ask":)" + std::to_string(100 - 10 - i % 80) +
+				R"(,"last_price":)" + bid + R"(,"last_price_dollars":"0.)" + bid +
+				R"(00","previous_yes_bid":0,"previous_yes_ask":0,"previous_price":0,)"
+				R"("volume":15230,"volume_fp":"15230.00",)"
+				R"("volume_24h":4210,"volume_24h_fp":"4210.00",)"
+				R"("liquidity":1250000,"liquidity_dollars":"12500.0000","open_interest":8830,)"
+				R"("open_interest_fp":"8830.00","result":"","can_close_early":true,)"
+				R"("expiration_value":"","category":"Climate and Weather","risk_limit_cents":0,)"
+				R"("strike_type":"greater","floor_strike":)" + strike +
+				R"(,"rules_primary":"If the highest temperature recorded in Denver, CO )"
+				R"(for April 20, 2026 as reported by the National Weather Service's )"
+				R"(Climatological Report (Daily), is greater than )" + strike +
+				R"(°, then the market resolves to Yes.",)"
+				R"("rules_secondary":"Not all weather data is the same. While checking a )"
+				R"(source like Google or your phone's weather app can help guide your )"
+				R"(decision, the last (and only) line is the NWS report.","tick_size":1,)"
+				R"("price_level_structure":"linear_cent"})";
+	}
+	body += R"(],"cursor":"CgsI2Y2UvwYQgJqOAhIdS1hISUdIREVOLTI2QVBSMjAtVDYyLTk5OQ"})";
+	return body;
+}
+
+/// ``GET /markets/orderbooks`` page of ``n`` books, ten levels a side
+inline std::string orderbooks_page(int n) {
+	std::string body = R"({"orderbooks":[)";
+	for (int i = 0; i < n; ++i) {
+		if (i > 0) {
+			body += ',';
+		}
+		body += R"({"ticker":"KXHIGHDEN-26APR20-T)" + std::to_string(40 + i % 50) + "-" +
+				std::to_string(i) + R"(","orderbook_fp":{"yes_dollars":[)";
+		for (int level = 0; level < 10; ++level) {
+			const int cents = 1 + (i + level * 4) % 45;
+			body += (level > 0 ? "," : "") + std::string(R"([")") + "0." +
+					(cents < 10 ? "0" : "") + std::to_string(cents) + R"(00",")" +
+					std::to_string(10 + level * 37 % 500) + R"(.00"])";
+		}
+		body += R"(],"no_dollars":[)";
+		for (int level = 0; level < 10; ++level) {
+			const int cents = 50 + (i + level * 4) % 49;
+			body += (level > 0 ? "," : "") + std::string(R"([")") + "0." +
+					std::to_string(cents) + R"(00",")" + std::to_string(5 + level * 53 % 700) +
+					R"(.00"])";
+		}
+		body += "]}}";
+	}
+	body += "]}";
+	return body;
+}
+
+/// ``GET /markets/trades`` page of ``n`` trades
+inline std::string trades_page(int n) {
+	std::string body = R"({"trades":[)";
+	for (int i = 0; i < n; ++i) {
+		const int yes = 10 + i % 80;
+		if (i > 0) {
+			body += ',';
+		}
+		body += R"({"trade_id":"5b7f0c1e-2f4a-4d3e-9a61-)" + std::to_string(100000000000 + i) +
+				R"(","ticker":"KXHIGHDEN-26APR20-T)" + std::to_string(40 + i % 50) +
+				R"(","count":)" + std::to_string(1 + i % 250) + R"(,"count_fp":")" +
+				std::to_string(1 + i % 250) + R"(.00","yes_price":)" + std::to_string(yes) +
+				R"(,"no_price":)" + std::to_string(100 - yes) + R"(,"yes_price_dollars":"0.)" +
+				std::to_string(yes) + R"(00","no_price_dollars":"0.)" + std::to_string(100 - yes) +
+				R"(00","taker_side":")" + (i % 3 == 0 ? "no" : "yes") +
+				R"(","created_time":"2026-04-20T15:)" + std::to_string(10 + i % 50) +
+				R"(:07.123456Z","is_block_trade":false})";
+	}
+	body += R"(],"cursor":"CgsI2Y2UvwYQgJqOAhIQNWI3ZjBjMWUtMmY0YS00ZDNl"})";
+	return body;
+}
+
+} // namespace kalshi::bench
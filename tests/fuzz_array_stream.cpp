@@ -0,0 +1,294 @@
+// Copyright (c) 2026 PredictionMarketsAI
+// SPDX-License-Identifier: MIT
+//
+// Fuzz target for ArrayStreamParser, the splitter that cuts REST array
+// responses into objects while libcurl is still delivering them.
+//
+// An input is a selector byte (which array to split), a seed byte (how to
+// cut it into chunks), then the body. The body is split four ways: whole,
+// in seed-sized chunks, one byte at a time, and by a byte-at-a-time
+// reference state machine that shares none of the parser's scanning code.
+// All four must deliver the same objects and cursor, and a callback that
+// stops early must see exactly a prefix of them. Each object is then
+// decoded by its array's parser, so the ``extract_*`` helpers see the
+// same hostile input.
+//
+// With -DKALSHI_BUILD_FUZZERS=ON (Clang) this is a libFuzzer target.
+// Otherwise ``main`` below replays the files named on the command line,
+// or runs seeded random mutations of the benchmark pages, which is what
+// ctest runs:
+//
+//     kalshi_fuzz_array_stream [--iterations <n>] [file...]
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "array_stream.hpp"
+#include "bench_fixtures.hpp"
+#include "response_parsers.hpp"
+
+namespace {
+
+constexpr std::array<const char*, 5> kKeys{"markets", "orderbooks", "trades", "orders", "fills"};
+
+struct Split {
+	std::vector<std::string> objects;
+	std::string cursor;
+
+	bool operator==(const Split&) const = default;
+};
+
+/// Any disagreement is a bug: report it and abort so the fuzzer keeps the input.
+void check(bool ok, const char* what) {
+	if (!ok) {
+		std::fprintf(stderr, "fuzz_array_stream: %s\n", what);
+		std::abort();
+	}
+}
+
+/// Feed ``body`` in chunks of ``sizes`` (cycled), stopping after ``limit``
+/// objects.
+Split split(std::string_view body, const char* key, const std::vector<std::size_t>& sizes,
+			std::size_t limit = SIZE_MAX) {
+	Split out;
+	kalshi::api_detail::ArrayStreamParser parser(key, [&out, limit](const std::string& object) {
+		out.objects.push_back(object);
+		return out.objects.size() < limit;
+	});
+	std::size_t pos = 0;
+	for (std::size_t i = 0; pos < body.size(); ++i) {
+		const std::size_t n = sizes[i % sizes.size()];
+		if (!parser.feed(body.substr(pos, n))) {
+			check(out.objects.size() == limit, "stopped without the callback declining");
+			check(!parser.feed(body.substr(pos)), "fed again after stopping");
+			break;
+		}
+		pos += n;
+	}
+	check(parser.objects() == out.objects.size(), "objects() disagrees with the callback");
+	out.cursor = parser.cursor();
+	return out;
+}
+
+/// The same splitting rules, one byte at a time with no lookahead
+Split reference_split(std::string_view body, std::string_view key) {
+	Split out;
+	std::string object;
+	std::string current_key;
+	std::int32_t depth = 0;
+	std::int32_t object_depth = 0;
+	bool in_string = false;
+	bool escape = false;
+	bool expect_key = false;
+	bool in_array = false;
+	bool capture_key = false;
+	bool capture_cursor = false;
+	for (const char c : body) {
+		if (object_depth > 0) {
+			object.push_back(c);
+			if (escape) {
+				escape = false;
+			} else if (in_string) {
+				escape = c == '\\';
+				in_string = c != '"';
+			} else if (c == '"') {
+				in_string = true;
+			} else if (c == '{' || c == '[') {
+				++object_depth;
+			} else if ((c == '}' || c == ']') && --object_depth == 0) {
+				out.objects.push_back(object);
+			}
+			continue;
+		}
+		if (in_string) {
+			std::string* target = capture_key	   ? &current_key
+								  : capture_cursor ? &out.cursor
+												   : nullptr;
+			if (escape) {
+				escape = false;
+			} else if (c == '\\') {
+				escape = true;
+			} else if (c == '"') {
+				in_string = capture_key = capture_cursor = false;
+				continue;
+			}
+			if (target != nullptr) {
+				target->push_back(c);
+			}
+			continue;
+		}
+		if (c == '"') {
+			in_string = true;
+			capture_key = depth == 1 && expect_key;
+			capture_cursor = depth == 1 && !expect_key && current_key == "cursor";
+			if (capture_key) {
+				current_key.clear();
+			} else if (capture_cursor) {
+				out.cursor.clear();
+			}
+		} else if ((c == ':' || c == ',') && depth == 1) {
+			expect_key = c == ',';
+		} else if (c == '{' && in_array && depth == 2) {
+			object.assign(1, c);
+			object_depth = 1;
+		} else if (c == '{' || c == '[') {
+			if (c == '[' && depth == 1 && !expect_key && current_key == key) {
+				in_array = true;
+			}
+			if (++depth == 1 && c == '{') {
+				expect_key = true;
+			}
+		} else if (c == '}' || c == ']') {
+			if (--depth == 1) {
+				in_array = false;
+			}
+		}
+	}
+	return out;
+}
+
+void decode(std::size_t selector, const std::string& object) {
+	switch (selector) {
+		case 0:
+			(void)kalshi::api_detail::parse_market_object(object);
+			break;
+		case 1:
+			(void)kalshi::api_detail::parse_orderbook_response(object);
+			break;
+		case 2:
+			(void)kalshi::api_detail::parse_trade_object(object);
+			break;
+		case 4:
+			(void)kalshi::api_detail::parse_fill_object(object);
+			break;
+		default:
+			break; // Orders decode through a private KalshiClient helper.
+	}
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+	if (size < 2) {
+		return 0;
+	}
+	const std::size_t selector = data[0] % kKeys.size();
+	const char* key = kKeys[selector];
+	const std::uint8_t seed = data[1];
+	const std::string_view body(reinterpret_cast<const char*>(data + 2), size - 2);
+
+	const Split whole = split(body, key, {body.size() + 1});
+	check(reference_split(body, key) == whole, "reference splitter disagrees");
+	check(split(body, key, {1}) == whole, "byte-at-a-time split disagrees");
+	const std::vector<std::size_t> sizes{1u + seed % 7u, 1u + seed / 7u % 61u, 4096, 2};
+	check(split(body, key, sizes) == whole, "chunked split disagrees");
+
+	if (!whole.objects.empty()) {
+		const std::size_t limit = 1 + seed % whole.objects.size();
+		const Split stopped = split(body, key, sizes, limit);
+		check(stopped.objects.size() == limit &&
+				  std::equal(stopped.objects.begin(), stopped.objects.end(),
+							 whole.objects.begin()),
+			  "early stop did not deliver a prefix");
+	}
+	for (const std::string& object : whole.objects) {
+		decode(selector, object);
+	}
+	return 0;
+}
+
+#if !defined(KALSHI_LIBFUZZER)
+
+namespace {
+
+void run(const std::string& input) {
+	LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size());
+}
+
+std::vector<std::string> seed_bodies() {
+	return {
+		kalshi::bench::markets_page(3),
+		kalshi::bench::orderbooks_page(3),
+		kalshi::bench::trades_page(3),
+		R"({"orders":[{"order_id":"o1","ticker":"KXA","side":"yes","status":"resting",)"
+		R"("yes_price":41,"remaining_count":5}],"cursor":"c\"1"})",
+		R"({"cursor":"","fills":[{"trade_id":"t1","ticker":"KXA","side":"no","count":2,)"
+		R"("is_taker":true},{"trade_id":"t\\2","note":"}]{["}]})",
+	};
+}
+
+/// A few random edits biased toward the bytes the splitter cares about
+std::string mutate(std::string body, std::mt19937& rng) {
+	static constexpr std::string_view kStructural = "{}[]\":,\\";
+	const int edits = 1 + static_cast<int>(rng() % 8);
+	for (int e = 0; e < edits && !body.empty(); ++e) {
+		const std::size_t at = rng() % body.size();
+		switch (rng() % 5) {
+			case 0:
+				body[at] = kStructural[rng() % kStructural.size()];
+				break;
+			case 1:
+				body[at] = static_cast<char>(rng());
+				break;
+			case 2:
+				body.erase(at, 1 + rng() % 16);
+				break;
+			case 3:
+				body.insert(at, body.substr(rng() % body.size(), 1 + rng() % 32));
+				break;
+			default:
+				body.resize(at);
+				break;
+		}
+	}
+	return body;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	long iterations = 20000;
+	std::vector<std::string> files;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+			iterations = std::strtol(argv[++i], nullptr, 10);
+		} else {
+			files.emplace_back(argv[i]);
+		}
+	}
+
+	if (!files.empty()) {
+		for (const std::string& path : files) {
+			std::ifstream in(path, std::ios::binary);
+			run(std::string(std::istreambuf_iterator<char>(in), {}));
+		}
+		std::printf("fuzz_array_stream: replayed %zu inputs\n", files.size());
+		return 0;
+	}
+
+	const std::vector<std::string> seeds = seed_bodies();
+	std::mt19937 rng(42);
+	for (long i = 0; i < iterations; ++i) {
+		const std::size_t selector = static_cast<std::size_t>(i) % seeds.size();
+		std::string input(1, static_cast<char>(selector));
+		input.push_back(static_cast<char>(rng()));
+		input += i < static_cast<long>(seeds.size()) ? seeds[selector]
+													 : mutate(seeds[selector], rng);
+		run(input);
+	}
+	std::printf("fuzz_array_stream: %ld inputs ok\n", iterations);
+	return 0;
+}
+
+#endif
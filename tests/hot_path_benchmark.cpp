@@ -0,0 +1,423 @@
+// Copyright (c) 2026 PredictionMarketsAI
+// SPDX-License-Identifier: MIT
+//
+// Microbenchmarks for the SDK's hot paths, plus a ctest regression guard.
+//
+// parse_benchmark.cpp covers outgoing serialization; this covers the
+// receive side and the per-request fixed costs:
+//
+//   ws_decode/<type>      decode_frame as the service thread runs it for
+//                         each message type (rich structs, interned ids)
+//   ws_event/<type>       the same with WsConfig::compact_events
+//   rest/markets_<n>      parse_markets_response on an n-market page
+//   rest/orderbooks_<n>   parse_orderbooks_response on an n-book page
+//   stream/...            ArrayStreamParser fed a page in libcurl-sized
+//                         chunks: splitting alone (throughput in MB/s),
+//                         and splitting plus decoding each object
+//   sign/...              Signer::sign and the buffer-reusing sign_into
+//   rate_limit/...        RateLimiter::try_acquire from 1 / 4 threads
+//   book/...              OrderBookBook delta apply and top of book
+//
+// Each benchmark is calibrated to run ~20 ms per round; the median of
+// five rounds is reported in ns/op. Every benchmark has a cap of 20-30x
+// its measured x86_64-v3 -O3 time (Debug builds run the scanners ~15x
+// slower), and the run fails when one is exceeded. The caps only catch
+// gross regressions; finer ones are caught by comparing two refs:
+//
+//     ./tools/bench.sh --compare main HEAD
+//
+// which runs this binary in both builds (``--tsv``) and flags every
+// benchmark slower by more than BENCH_THRESHOLD percent.
+//
+// Recorded baseline (x86_64, GCC 13, -O2, single run):
+//
+//     ws_decode/*            0.5 - 0.9 us/frame (snapshot: 10 levels a side)
+//     ws_event/*             0.45 - 0.8 us/frame
+//     rest/markets_<n>       ~25 us/market
+//     rest/orderbooks_<n>    ~7 us/book
+//     stream/split_*         0.75 - 1.2 GB/s with 16 KiB chunks; ~730 MB/s with 64 B
+//     stream/markets_1000    within noise of rest/markets_1000 (the split is ~6%)
+//     sign/*                 ~400 us (RSA-PSS 2048)
+//     rate_limit/*           38 ns; 77 ns at 2 threads, 147 ns at 4
+//     book/apply_delta       5 ns; top_of_book 15 ns
+//
+// Usage: kalshi_hot_path_benchmark [--tsv] [--filter <substring>]
+
+#include "kalshi/orderbook_book.hpp"
+#include "kalshi/rate_limit.hpp"
+#include "kalshi/signer.hpp"
+#include "kalshi/ticker_table.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include "array_stream.hpp"
+#include "bench_fixtures.hpp"
+#include "frame_decoder.hpp"
+#include "response_parsers.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+	bool tsv{false};
+	std::string_view filter;
+};
+
+struct Outcome {
+	std::string name;
+	double ns_per_op{0};
+	double cap_ns{0};
+	std::size_t bytes_per_op{0}; ///< Also print MB/s when set
+};
+
+/// Keep the optimizer from discarding a result.
+template <typename T> void keep(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	static const void* volatile sink;
+	sink = &value;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/// Median ns/op of ``fn`` (one op per call) over five ~20 ms rounds.
+double measure(const std::function<void()>& fn) {
+	constexpr std::chrono::milliseconds kRound{20};
+	for (int i = 0; i < 16; ++i) {
+		fn(); // Warm caches, the allocator and any lazy state.
+	}
+	std::uint64_t batch = 1;
+	for (;;) {
+		const Clock::time_point t0 = Clock::now();
+		for (std::uint64_t i = 0; i < batch; ++i) {
+			fn();
+		}
+		if (Clock::now() - t0 >= kRound / 4 || batch >= (1u << 30)) {
+			break;
+		}
+		batch *= 2;
+	}
+	batch *= 4;
+	std::vector<double> rounds;
+	for (int r = 0; r < 5; ++r) {
+		const Clock::time_point t0 = Clock::now();
+		for (std::uint64_t i = 0; i < batch; ++i) {
+			fn();
+		}
+		const std::chrono::nanoseconds elapsed = Clock::now() - t0;
+		rounds.push_back(static_cast<double>(elapsed.count()) / static_cast<double>(batch));
+	}
+	std::sort(rounds.begin(), rounds.end());
+	return rounds[rounds.size() / 2];
+}
+
+/// ns per ``try_acquire`` as seen by each of ``threads`` threads hammering
+/// one limiter
+double measure_contended(kalshi::RateLimiter& limiter, int threads) {
+	constexpr int kOpsPerThread = 200000;
+	std::vector<double> rounds;
+	for (int r = 0; r < 5; ++r) {
+		std::atomic<int> ready{0};
+		std::atomic<bool> go{false};
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; ++t) {
+			workers.emplace_back([&] {
+				ready.fetch_add(1);
+				while (!go.load(std::memory_order_acquire)) {
+				}
+				bool any = false;
+				for (int i = 0; i < kOpsPerThread; ++i) {
+					any |= limiter.try_acquire();
+				}
+				keep(any);
+			});
+		}
+		while (ready.load() < threads) {
+		}
+		const Clock::time_point t0 = Clock::now();
+		go.store(true, std::memory_order_release);
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+		const std::chrono::nanoseconds elapsed = Clock::now() - t0;
+		rounds.push_back(static_cast<double>(elapsed.count()) / kOpsPerThread);
+	}
+	std::sort(rounds.begin(), rounds.end());
+	return rounds[rounds.size() / 2];
+}
+
+/// Fresh 2048-bit RSA key in PEM, so no key material is checked in
+std::string generate_pem() {
+	std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key(EVP_RSA_gen(2048), EVP_PKEY_free);
+	std::unique_ptr<BIO, decltype(&BIO_free)> bio(BIO_new(BIO_s_mem()), BIO_free);
+	if (!key || !bio ||
+		PEM_write_bio_PrivateKey(bio.get(), key.get(), nullptr, nullptr, 0, nullptr, nullptr) !=
+			1) {
+		return {};
+	}
+	char* data = nullptr;
+	const long size = BIO_get_mem_data(bio.get(), &data);
+	return std::string(data, static_cast<std::size_t>(size));
+}
+
+class Suite {
+public:
+	explicit Suite(Options options) : options_(options) {}
+
+	/// Run ``fn`` when ``name`` passes the filter. With ``bytes_per_op``
+	/// the throughput is printed too.
+	void run(std::string name, double cap_ns, const std::function<void()>& fn,
+			 std::size_t bytes_per_op = 0) {
+		if (!selected(name)) {
+			return;
+		}
+		report({std::move(name), measure(fn), cap_ns, bytes_per_op});
+	}
+
+	void report(Outcome outcome) {
+		if (options_.tsv) {
+			std::printf("%s\t%.1f\n", outcome.name.c_str(), outcome.ns_per_op);
+		} else {
+			std::printf("  %-32s %12.1f ns/op   (cap %.0f)%s", outcome.name.c_str(),
+						outcome.ns_per_op, outcome.cap_ns,
+						outcome.ns_per_op > outcome.cap_ns ? "  REGRESSION" : "");
+			if (outcome.bytes_per_op > 0) {
+				std::printf("   %.0f MB/s",
+							static_cast<double>(outcome.bytes_per_op) * 1e3 / outcome.ns_per_op);
+			}
+			std::printf("\n");
+		}
+		std::fflush(stdout);
+		if (outcome.ns_per_op > outcome.cap_ns) {
+			failures_.push_back(std::move(outcome));
+		}
+	}
+
+	[[nodiscard]] bool selected(std::string_view name) const {
+		return options_.filter.empty() || name.find(options_.filter) != std::string_view::npos;
+	}
+
+	[[nodiscard]] int finish() const {
+		for (const Outcome& f : failures_) {
+			std::fprintf(stderr, "REGRESSION: %s %.1f ns/op exceeds cap of %.0f ns/op\n",
+						 f.name.c_str(), f.ns_per_op, f.cap_ns);
+		}
+		return failures_.empty() ? 0 : 1;
+	}
+
+private:
+	Options options_;
+	std::vector<Outcome> failures_;
+};
+
+void bench_ws(Suite& suite) {
+	// As the service thread decodes: ids interned into a warm table and
+	// snapshot levels written to a reused buffer.
+	kalshi::TickerTable tickers;
+	std::vector<kalshi::OrderBookEntry> levels;
+	const kalshi::ws_detail::DecodeOptions rich{.tickers = &tickers,
+												.snapshot_levels = &levels};
+	kalshi::ws_detail::DecodeOptions compact = rich;
+	compact.compact_events = true;
+
+	for (const kalshi::bench::NamedFrame& frame : kalshi::bench::kFrames) {
+		suite.run("ws_decode/" + std::string(frame.type), 20000, [&] {
+			keep(kalshi::ws_detail::decode_frame(frame.frame, rich));
+		});
+	}
+	for (const kalshi::bench::NamedFrame& frame : kalshi::bench::kFrames) {
+		if (frame.type == "orderbook_snapshot" || frame.type == "market_lifecycle") {
+			continue; // Never compact.
+		}
+		suite.run("ws_event/" + std::string(frame.type), 20000, [&] {
+			keep(kalshi::ws_detail::decode_frame(frame.frame, compact));
+		});
+	}
+}
+
+void bench_rest(Suite& suite) {
+	for (const int n : {100, 1000}) {
+		const std::string markets = kalshi::bench::markets_page(n);
+		suite.run("rest/markets_" + std::to_string(n), 500000.0 * n, [&] {
+			keep(kalshi::api_detail::parse_markets_response(markets));
+		});
+		const std::string books = kalshi::bench::orderbooks_page(n);
+		suite.run("rest/orderbooks_" + std::to_string(n), 200000.0 * n, [&] {
+			keep(kalshi::api_detail::parse_orderbooks_response(books));
+		});
+	}
+}
+
+/// Feed ``body`` to ``parser`` in ``chunk``-byte pieces, as libcurl would
+void feed_chunked(kalshi::api_detail::ArrayStreamParser& parser, std::string_view body,
+				  std::size_t chunk) {
+	for (std::size_t pos = 0; pos < body.size(); pos += chunk) {
+		parser.feed(body.substr(pos, chunk));
+	}
+}
+
+void bench_stream(Suite& suite) {
+	// 16 KiB is libcurl's default write-callback size; 64 B stands in for a
+	// connection trickling in small TLS records.
+	constexpr std::size_t kCurlChunk = 16 * 1024;
+	const std::string markets = kalshi::bench::markets_page(1000);
+	const std::string trades = kalshi::bench::trades_page(1000);
+	std::size_t objects = 0;
+	const auto count = [&objects](const std::string&) {
+		++objects;
+		return true;
+	};
+
+	for (const std::size_t chunk : {kCurlChunk, std::size_t{64}}) {
+		const std::string suffix = chunk == kCurlChunk ? "_16k" : "_64b";
+		suite.run(
+			"stream/split_markets" + suffix, 30.0 * static_cast<double>(markets.size()),
+			[&] {
+				kalshi::api_detail::ArrayStreamParser parser("markets", count);
+				feed_chunked(parser, markets, chunk);
+				keep(parser.objects());
+			},
+			markets.size());
+		suite.run(
+			"stream/split_trades" + suffix, 30.0 * static_cast<double>(trades.size()),
+			[&] {
+				kalshi::api_detail::ArrayStreamParser parser("trades", count);
+				feed_chunked(parser, trades, chunk);
+				keep(parser.objects());
+			},
+			trades.size());
+	}
+
+	std::vector<kalshi::Market> parsed_markets;
+	suite.run(
+		"stream/markets_1000", 500000.0 * 1000,
+		[&] {
+			parsed_markets.clear();
+			kalshi::api_detail::ArrayStreamParser parser(
+				"markets", [&parsed_markets](const std::string& object) {
+					parsed_markets.push_back(kalshi::api_detail::parse_market_object(object));
+					return true;
+				});
+			feed_chunked(parser, markets, kCurlChunk);
+			keep(parsed_markets.size());
+		},
+		markets.size());
+	std::vector<kalshi::PublicTrade> parsed_trades;
+	suite.run(
+		"stream/trades_1000", 100000.0 * 1000,
+		[&] {
+			parsed_trades.clear();
+			kalshi::api_detail::ArrayStreamParser parser(
+				"trades", [&parsed_trades](const std::string& object) {
+					parsed_trades.push_back(kalshi::api_detail::parse_trade_object(object));
+					return true;
+				});
+			feed_chunked(parser, trades, kCurlChunk);
+			keep(parsed_trades.size());
+		},
+		trades.size());
+}
+
+void bench_sign(Suite& suite) {
+	if (!suite.selected("sign/")) {
+		return;
+	}
+	const std::string pem = generate_pem();
+	kalshi::Result<kalshi::Signer> signer = kalshi::Signer::from_pem("bench-key", pem);
+	if (!signer) {
+		std::fprintf(stderr, "sign: could not load generated key: %s\n",
+					 signer.error().message.c_str());
+		return;
+	}
+	suite.run("sign/sign", 10'000'000, [&] { keep(signer->sign("POST", "/portfolio/orders")); });
+	kalshi::AuthHeaders headers;
+	suite.run("sign/sign_into", 10'000'000,
+			  [&] { keep(signer->sign_into("POST", "/portfolio/orders", headers)); });
+}
+
+void bench_rate_limit(Suite& suite) {
+	// A bucket that never runs dry, so every call takes the CAS path.
+	kalshi::RateLimiter limiter({.max_tokens = 1'000'000,
+								 .refill_interval = std::chrono::nanoseconds{1},
+								 .initial_tokens = 1'000'000,
+								 .max_wait = std::nullopt});
+	suite.run("rate_limit/try_acquire", 2000, [&] { keep(limiter.try_acquire()); });
+	for (const int threads : {2, 4}) {
+		const std::string name = "rate_limit/try_acquire_" + std::to_string(threads) + "t";
+		if (suite.selected(name)) {
+			suite.report({name, measure_contended(limiter, threads), 20000});
+		}
+	}
+}
+
+void bench_book(Suite& suite) {
+	kalshi::OrderBookBook book(kalshi::SeqCheck::Monotonic);
+	const kalshi::ws_detail::DecodedFrame snapshot =
+		kalshi::ws_detail::decode_frame(kalshi::bench::kOrderbookSnapshotFrame);
+	book.apply(std::get<kalshi::OrderbookSnapshot>(snapshot.message));
+
+	// Add and remove size across the live price range, as deltas arrive.
+	std::vector<kalshi::OrderbookDelta> deltas(256);
+	for (std::size_t i = 0; i < deltas.size(); ++i) {
+		deltas[i].sid = 3;
+		deltas[i].price = 1 + static_cast<std::int32_t>(i * 7 % 98);
+		deltas[i].delta = (i % 2 == 0) ? 25 : -25;
+		deltas[i].side = (i % 4 < 2) ? kalshi::Side::Yes : kalshi::Side::No;
+	}
+	std::size_t next = 0;
+	std::int32_t seq = 1;
+	suite.run("book/apply_delta", 1000, [&] {
+		kalshi::OrderbookDelta& delta = deltas[next++ & (deltas.size() - 1)];
+		delta.seq = ++seq;
+		keep(book.apply(delta));
+	});
+	suite.run("book/top_of_book", 2000, [&] {
+		keep(book.best_bid(kalshi::Side::Yes));
+		keep(book.best_ask(kalshi::Side::Yes));
+	});
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	Options options;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--tsv") == 0) {
+			options.tsv = true;
+		} else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			options.filter = argv[++i];
+		} else {
+			std::fprintf(stderr, "usage: %s [--tsv] [--filter <substring>]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	Suite suite(options);
+	if (!options.tsv) {
+		std::printf("hot_path_benchmark: median of 5 rounds\n");
+	}
+	bench_ws(suite);
+	bench_rest(suite);
+	bench_stream(suite);
+	bench_sign(suite);
+	bench_rate_limit(suite);
+	bench_book(suite);
+	return suite.finish();
+}
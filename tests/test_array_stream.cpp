@@ -0,0 +1,130 @@
+// Unit tests for the incremental REST array splitter.
+//
+// ArrayStreamParser is fed straight from the libcurl write callback, so
+// chunk boundaries fall anywhere: inside keys, string values, escapes
+// and nested objects. Every test here feeds the same body at several
+// chunk sizes and expects identical output.
+
+#include "array_stream.hpp"
+#include "response_parsers.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using kalshi::api_detail::ArrayStreamParser;
+
+namespace {
+
+struct Split {
+	std::vector<std::string> objects;
+	std::string cursor;
+};
+
+Split split(std::string_view body, std::size_t chunk, const char* key = "markets") {
+	Split out;
+	ArrayStreamParser parser(key, [&out](const std::string& object) {
+		out.objects.push_back(object);
+		return true;
+	});
+	for (std::size_t i = 0; i < body.size(); i += chunk) {
+		parser.feed(body.substr(i, chunk));
+	}
+	out.cursor = parser.cursor();
+	return out;
+}
+
+} // namespace
+
+TEST(ArrayStream, SplitsObjectsAcrossAnyChunkBoundary) {
+	const std::string body =
+		R"({"markets":[{"ticker":"A","price_ranges":[{"start":"0"}]},)"
+		R"( {"ticker":"B}{\"","title":"x"}],"cursor":"c2"})";
+	for (std::size_t chunk : {1u, 2u, 7u, 4096u}) {
+		const Split s = split(body, chunk);
+		ASSERT_EQ(s.objects.size(), 2u) << "chunk " << chunk;
+		EXPECT_EQ(s.objects[0], R"({"ticker":"A","price_ranges":[{"start":"0"}]})");
+		EXPECT_EQ(s.objects[1], R"({"ticker":"B}{\"","title":"x"})");
+		EXPECT_EQ(s.cursor, "c2");
+	}
+}
+
+TEST(ArrayStream, EveryTwoChunkSplitMatchesWholeBody) {
+	const std::string body =
+		R"({"cursor":"a\"b","trades":[{"id":"\\","n":[1,{"x":"]}"}]},{"id":"t\u0022"}],)"
+		R"("more":{"trades":[{"no":1}]}})";
+	const Split whole = split(body, body.size(), "trades");
+	ASSERT_EQ(whole.objects.size(), 2u);
+	EXPECT_EQ(whole.cursor, R"(a\"b)");
+	for (std::size_t cut = 1; cut < body.size(); ++cut) {
+		Split s;
+		ArrayStreamParser parser("trades", [&s](const std::string& object) {
+			s.objects.push_back(object);
+			return true;
+		});
+		parser.feed(std::string_view(body).substr(0, cut));
+		parser.feed(std::string_view(body).substr(cut));
+		EXPECT_EQ(s.objects, whole.objects) << "cut at " << cut;
+		EXPECT_EQ(parser.cursor(), whole.cursor) << "cut at " << cut;
+	}
+}
+
+TEST(ArrayStream, CursorBeforeArrayAndNestedKeysIgnored) {
+	// Only the top-level array / "cursor" keys count.
+	const std::string body = R"({"cursor":"first","meta":{"markets":[{"x":1}],"cursor":"no"},)"
+							 R"("markets":[{"ticker":"A"}]})";
+	const Split s = split(body, 3);
+	ASSERT_EQ(s.objects.size(), 1u);
+	EXPECT_EQ(s.objects[0], R"({"ticker":"A"})");
+	EXPECT_EQ(s.cursor, "first");
+}
+
+TEST(ArrayStream, OnlyTheNamedArraySplits) {
+	const std::string body = R"({"orders":[{"order_id":"o1"}],"fills":[{"trade_id":"f1"}]})";
+	EXPECT_EQ(split(body, 5, "orders").objects,
+			  (std::vector<std::string>{R"({"order_id":"o1"})"}));
+	EXPECT_EQ(split(body, 5, "fills").objects,
+			  (std::vector<std::string>{R"({"trade_id":"f1"})"}));
+	EXPECT_TRUE(split(body, 5, "trades").objects.empty());
+}
+
+TEST(ArrayStream, StopsWhenCallbackDeclines) {
+	std::size_t seen = 0;
+	ArrayStreamParser parser("markets", [&seen](const std::string&) { return ++seen < 2; });
+	EXPECT_FALSE(parser.feed(R"({"markets":[{"a":1},{"a":2},{"a":3}]})"));
+	EXPECT_EQ(seen, 2u);
+	EXPECT_EQ(parser.objects(), 2u);
+	EXPECT_FALSE(parser.feed(R"({"a":4})"));
+}
+
+TEST(ArrayStream, EmptyOrMissingArray) {
+	EXPECT_TRUE(split(R"({"markets":[],"cursor":""})", 1).objects.empty());
+	EXPECT_TRUE(split(R"({"events":[{"a":1}]})", 1).objects.empty());
+	EXPECT_TRUE(split("", 1).objects.empty());
+}
+
+TEST(ArrayStream, ParseMarketsResponseUsesSplitter) {
+	const std::vector<kalshi::Market> markets = kalshi::api_detail::parse_markets_response(
+		R"({"markets":[{"ticker":"KXA","status":"active","yes_bid_dollars":"0.4100"},)"
+		R"({"ticker":"KXB","status":"settled"}],"cursor":"n"})");
+	ASSERT_EQ(markets.size(), 2u);
+	EXPECT_EQ(markets[0].ticker, "KXA");
+	EXPECT_EQ(markets[0].yes_bid, 41);
+	EXPECT_EQ(markets[1].status, kalshi::MarketStatus::Settled);
+}
+
+TEST(ArrayStream, ParseFillsResponseUsesSplitter) {
+	const std::vector<kalshi::Fill> fills = kalshi::api_detail::parse_fills_response(
+		R"({"fills":[{"trade_id":"t1","order_id":"o1","ticker":"KXA","side":"no",)"
+		R"("action":"sell","count":3,"yes_price":61,"no_price":39,"is_taker":true}],)"
+		R"("cursor":""})");
+	ASSERT_EQ(fills.size(), 1u);
+	EXPECT_EQ(fills[0].trade_id, "t1");
+	EXPECT_EQ(fills[0].market_ticker, "KXA");
+	EXPECT_EQ(fills[0].side, kalshi::Side::No);
+	EXPECT_EQ(fills[0].action, kalshi::Action::Sell);
+	EXPECT_EQ(fills[0].count, 3);
+	EXPECT_EQ(fills[0].no_price, 39);
+	EXPECT_TRUE(fills[0].is_taker);
+}
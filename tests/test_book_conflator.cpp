@@ -0,0 +1,183 @@
+// Unit tests for BookConflator: per-market merging, dirty-set draining in
+// bounded batches, gap invalidation and interval delivery on its own
+// thread while another thread feeds it.
+
+#include "kalshi/book_conflator.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using kalshi::BookConflator;
+using kalshi::ConflatedUpdate;
+using kalshi::TickerId;
+
+namespace {
+
+kalshi::OrderbookSnapshot snapshot(std::uint32_t market, std::int32_t sid = 2) {
+	kalshi::OrderbookSnapshot s;
+	s.sid = sid;
+	s.seq = 1;
+	s.yes = {{40, 10}, {42, 5}};
+	s.no = {{55, 7}};
+	s.ticker_id = TickerId{market};
+	return s;
+}
+
+kalshi::WsEvent delta(std::uint32_t market, std::int32_t seq, std::int16_t price,
+					  std::int32_t quantity) {
+	kalshi::WsEvent event;
+	event.kind = kalshi::WsEventKind::Delta;
+	event.sid = 2;
+	event.seq = seq;
+	event.ticker_id = TickerId{market};
+	event.side = kalshi::Side::Yes;
+	event.price = price;
+	event.quantity = quantity;
+	return event;
+}
+
+} // namespace
+
+TEST(BookConflator, MergesUpdatesPerMarket) {
+	BookConflator conflator;
+	conflator.apply(kalshi::WsMessage{snapshot(3)});
+	for (std::int32_t seq = 2; seq <= 101; ++seq) {
+		conflator.apply(delta(3, seq, 43, 1));
+	}
+	kalshi::WsTrade trade;
+	trade.ticker_id = TickerId{3};
+	trade.yes_price = 43;
+	trade.count = 9;
+	conflator.apply(kalshi::WsMessage{trade});
+
+	std::array<ConflatedUpdate, 8> out{};
+	ASSERT_EQ(conflator.drain(out), 1u);
+	EXPECT_EQ(out[0].top.ticker_id, TickerId{3});
+	EXPECT_TRUE(out[0].top.valid);
+	EXPECT_EQ(out[0].top.yes_bid.price_cents, 43);
+	EXPECT_EQ(out[0].top.yes_bid.quantity, 100);
+	EXPECT_EQ(out[0].top.no_bid.price_cents, 55);
+	EXPECT_EQ(out[0].top.seq, 101);
+	EXPECT_EQ(out[0].last_trade.price_cents, 43);
+	EXPECT_EQ(out[0].last_trade.quantity, 9);
+	EXPECT_EQ(out[0].merged, 102u);
+
+	// Nothing changed since.
+	EXPECT_EQ(conflator.drain(out), 0u);
+	conflator.apply(delta(3, 102, 43, -100));
+	ASSERT_EQ(conflator.drain(out), 1u);
+	EXPECT_EQ(out[0].top.yes_bid.price_cents, 42);
+	EXPECT_EQ(out[0].merged, 1u);
+
+	const kalshi::BookConflatorStats stats = conflator.stats();
+	EXPECT_EQ(stats.updates, 103u);
+	EXPECT_EQ(stats.delivered, 2u);
+}
+
+TEST(BookConflator, SmallBatchesReachEveryMarket) {
+	BookConflator conflator({.max_markets = 300});
+	for (std::uint32_t market = 0; market < 300; ++market) {
+		conflator.apply(kalshi::WsMessage{snapshot(market)});
+	}
+	std::vector<bool> seen(300, false);
+	std::array<ConflatedUpdate, 7> out{};
+	std::size_t total = 0;
+	for (std::size_t n = conflator.drain(out); n > 0; n = conflator.drain(out)) {
+		for (std::size_t i = 0; i < n; ++i) {
+			EXPECT_FALSE(seen[out[i].top.ticker_id.value]);
+			seen[out[i].top.ticker_id.value] = true;
+		}
+		total += n;
+	}
+	EXPECT_EQ(total, 300u);
+}
+
+TEST(BookConflator, IgnoresMarketsPastCapacity) {
+	BookConflator conflator({.max_markets = 4});
+	conflator.apply(kalshi::WsMessage{snapshot(4)});
+	conflator.apply(delta(9, 2, 40, 1));
+	EXPECT_EQ(conflator.stats().ignored, 2u);
+	EXPECT_FALSE(conflator.latest(TickerId{4}).has_value());
+	std::array<ConflatedUpdate, 2> out{};
+	EXPECT_EQ(conflator.drain(out), 0u);
+}
+
+TEST(BookConflator, GapInvalidatesSubscriptionBooks) {
+	BookConflator conflator;
+	conflator.apply(kalshi::WsMessage{snapshot(1, 2)});
+	conflator.apply(kalshi::WsMessage{snapshot(2, 5)});
+	std::array<ConflatedUpdate, 4> out{};
+	EXPECT_EQ(conflator.drain(out), 2u);
+
+	conflator.apply(
+		kalshi::WsSeqGap{.sid = 2, .expected_seq = 7, .received_seq = 9, .resync_tickers = {}});
+	ASSERT_EQ(conflator.drain(out), 1u);
+	EXPECT_EQ(out[0].top.ticker_id, TickerId{1});
+	EXPECT_FALSE(out[0].top.valid);
+	EXPECT_TRUE(conflator.latest(TickerId{2})->top.valid);
+	EXPECT_EQ(conflator.latest(TickerId{2})->merged, 0u);
+}
+
+TEST(BookConflator, IntervalDeliveryWhileFeeding) {
+	BookConflator conflator({.max_markets = 16, .interval = std::chrono::milliseconds(2)});
+	std::mutex mutex;
+	std::vector<std::uint64_t> merged(16, 0);
+	std::vector<std::int32_t> last_seq(16, 0);
+	conflator.on_update([&](std::span<const ConflatedUpdate> batch) {
+		std::lock_guard lock(mutex);
+		for (const ConflatedUpdate& update : batch) {
+			const std::uint32_t market = update.top.ticker_id.value;
+			EXPECT_GE(update.top.seq, last_seq[market]);
+			last_seq[market] = update.top.seq;
+			merged[market] += update.merged;
+		}
+	});
+
+	constexpr std::int32_t kDeltas = 20000;
+	std::thread feeder([&conflator] {
+		for (std::uint32_t market = 0; market < 16; ++market) {
+			conflator.apply(kalshi::WsMessage{snapshot(market)});
+		}
+		for (std::int32_t seq = 2; seq < kDeltas + 2; ++seq) {
+			conflator.apply(delta(static_cast<std::uint32_t>(seq % 16), seq, 41, 1));
+		}
+	});
+	feeder.join();
+
+	const std::chrono::steady_clock::time_point deadline =
+		std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	for (;;) {
+		{
+			std::lock_guard lock(mutex);
+			std::uint64_t total = 0;
+			for (std::uint64_t m : merged) {
+				total += m;
+			}
+			if (total == 16 + kDeltas || std::chrono::steady_clock::now() > deadline) {
+				EXPECT_EQ(total, 16u + kDeltas);
+				break;
+			}
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	const kalshi::BookConflatorStats stats = conflator.stats();
+	EXPECT_EQ(stats.updates, 16u + kDeltas);
+	EXPECT_LT(stats.delivered, stats.updates);
+}
+
+TEST(BookConflator, MovedFromIsSafe) {
+	BookConflator a;
+	BookConflator b(std::move(a));
+	a.apply(kalshi::WsMessage{snapshot(1)});
+	std::array<ConflatedUpdate, 1> out{};
+	EXPECT_EQ(a.drain(out), 0u);
+	EXPECT_FALSE(a.latest(TickerId{1}).has_value());
+	EXPECT_EQ(a.stats().updates, 0u);
+	b.apply(kalshi::WsMessage{snapshot(1)});
+	EXPECT_EQ(b.drain(out), 1u);
+}
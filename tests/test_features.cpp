@@ -4,9 +4,14 @@
 #include "kalshi/retry.hpp"
 #include "kalshi/websocket.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <future>
 #include <gtest/gtest.h>
+#include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 // --- Pagination tests ---
 
@@ -45,6 +50,108 @@ TEST(Pagination, ResponseHasMore) {
 	ASSERT_TRUE(response.has_more());
 }
 
+namespace {
+
+// Three-page fake: cursor "" -> items {0,1}, "p1" -> {2,3}, "p2" -> {4}.
+kalshi::HttpResponse fake_page(const kalshi::PaginationParams& params) {
+	const std::string cursor = params.cursor ? params.cursor->value : "";
+	kalshi::HttpResponse response{};
+	response.status_code = 200;
+	response.body = cursor.empty() ? "0,1|p1" : cursor == "p1" ? "2,3|p2" : "4|";
+	return response;
+}
+
+kalshi::PipelinedFetch<int> fake_pipeline(std::vector<std::string>& events) {
+	kalshi::PipelinedFetch<int> fetch;
+	fetch.request = [&events](const kalshi::PaginationParams& params) {
+		events.push_back("request " + (params.cursor ? params.cursor->value : std::string{}));
+		std::promise<kalshi::Result<kalshi::HttpResponse>> promise;
+		promise.set_value(fake_page(params));
+		return promise.get_future();
+	};
+	fetch.cursor = [](const kalshi::HttpResponse& response) -> std::optional<kalshi::Cursor> {
+		const std::string next = response.body.substr(response.body.find('|') + 1);
+		if (next.empty()) {
+			return std::nullopt;
+		}
+		return kalshi::Cursor{next};
+	};
+	fetch.parse = [&events](const kalshi::HttpResponse& response,
+							std::vector<int>& out) -> kalshi::Result<void> {
+		events.push_back("parse " + response.body);
+		for (char c : response.body.substr(0, response.body.find('|'))) {
+			if (c != ',') {
+				out.push_back(c - '0');
+			}
+		}
+		return {};
+	};
+	return fetch;
+}
+
+} // namespace
+
+TEST(Pagination, FetchAllIntoAppendsToReservedOutput) {
+	kalshi::PaginatedIterator<int> it(
+		[](const kalshi::PaginationParams& params)
+			-> kalshi::Result<kalshi::PaginatedResponse<int>> {
+			kalshi::PaginatedResponse<int> page;
+			const std::string cursor = params.cursor ? params.cursor->value : "";
+			page.items = cursor.empty() ? std::vector<int>{0, 1} : std::vector<int>{2};
+			if (cursor.empty()) {
+				page.next_cursor = kalshi::Cursor{"p1"};
+			}
+			return page;
+		});
+	std::vector<int> out;
+	out.reserve(16);
+	const int* storage = out.data();
+	ASSERT_TRUE(it.fetch_all_into(out).has_value());
+	EXPECT_EQ(out, (std::vector<int>{0, 1, 2}));
+	EXPECT_EQ(out.data(), storage);
+	EXPECT_FALSE(it.has_more());
+}
+
+TEST(Pagination, PipelinedRequestsNextPageBeforeParsing) {
+	std::vector<std::string> events;
+	kalshi::PaginatedIterator<int> it(fake_pipeline(events), 2);
+	kalshi::Result<std::vector<int>> all = it.fetch_all(5);
+	ASSERT_TRUE(all.has_value());
+	EXPECT_EQ(*all, (std::vector<int>{0, 1, 2, 3, 4}));
+	const std::vector<std::string> expected{"request ",	  "request p1",	  "parse 0,1|p1",
+											"request p2", "parse 2,3|p2", "parse 4|"};
+	EXPECT_EQ(events, expected);
+}
+
+TEST(Pagination, PipelinedNextPageMatchesSequential) {
+	std::vector<std::string> events;
+	kalshi::PaginatedIterator<int> it(fake_pipeline(events));
+	kalshi::Result<std::vector<int>> first = it.next_page();
+	ASSERT_TRUE(first.has_value());
+	EXPECT_EQ(*first, (std::vector<int>{0, 1}));
+	EXPECT_TRUE(it.has_more());
+	kalshi::Result<std::vector<int>> rest = it.fetch_all();
+	ASSERT_TRUE(rest.has_value());
+	EXPECT_EQ(*rest, (std::vector<int>{2, 3, 4}));
+}
+
+TEST(Pagination, PipelinedRejectsErrorStatus) {
+	std::vector<std::string> events;
+	kalshi::PipelinedFetch<int> fetch = fake_pipeline(events);
+	fetch.request = [](const kalshi::PaginationParams&) {
+		kalshi::HttpResponse response{};
+		response.status_code = 503;
+		std::promise<kalshi::Result<kalshi::HttpResponse>> promise;
+		promise.set_value(std::move(response));
+		return promise.get_future();
+	};
+	kalshi::PaginatedIterator<int> it(std::move(fetch));
+	kalshi::Result<std::vector<int>> all = it.fetch_all();
+	ASSERT_FALSE(all.has_value());
+	EXPECT_EQ(all.error().code, kalshi::ErrorCode::ServerError);
+	EXPECT_TRUE(events.empty());
+}
+
 // --- Rate limiter tests ---
 
 TEST(RateLimiter, InitialTokens) {
@@ -81,6 +188,133 @@ TEST(RateLimiter, Reset) {
 	ASSERT_EQ(limiter.available_tokens(), static_cast<std::uint16_t>(3));
 }
 
+TEST(RateLimiter, ChargesCost) {
+	kalshi::RateLimiter::Config config;
+	config.initial_tokens = 10;
+	config.max_tokens = 10;
+	config.refill_interval = std::chrono::hours{1};
+
+	kalshi::RateLimiter limiter(config);
+	ASSERT_TRUE(limiter.try_acquire(7));
+	EXPECT_EQ(limiter.available_tokens(), 3U);
+	EXPECT_FALSE(limiter.try_acquire(4));
+	EXPECT_TRUE(limiter.try_acquire(3));
+	EXPECT_GT(limiter.time_until_available(1), std::chrono::minutes{59});
+	// More than the whole bucket can never succeed, so don't wait for it.
+	EXPECT_FALSE(limiter.acquire_for(std::chrono::milliseconds{1}, 11));
+}
+
+TEST(RateLimiter, RefillsContinuously) {
+	kalshi::RateLimiter::Config config;
+	config.initial_tokens = 0;
+	config.max_tokens = 2;
+	config.refill_interval = std::chrono::milliseconds{5};
+
+	kalshi::RateLimiter limiter(config);
+	EXPECT_FALSE(limiter.try_acquire());
+	EXPECT_TRUE(limiter.acquire_for(std::chrono::milliseconds{500}));
+}
+
+TEST(RateLimiter, ReserveQueuesBehindDebt) {
+	kalshi::RateLimiter::Config config;
+	config.initial_tokens = 2;
+	config.max_tokens = 2;
+	config.refill_interval = std::chrono::seconds{1};
+	config.max_wait = std::chrono::milliseconds{2500};
+
+	kalshi::RateLimiter limiter(config);
+	EXPECT_EQ(limiter.reserve(2), std::chrono::nanoseconds{0});
+	const std::optional<std::chrono::nanoseconds> first = limiter.reserve();
+	const std::optional<std::chrono::nanoseconds> second = limiter.reserve();
+	ASSERT_TRUE(first.has_value());
+	ASSERT_TRUE(second.has_value());
+	EXPECT_GT(*first, std::chrono::milliseconds{900});
+	EXPECT_GT(*second, *first + std::chrono::milliseconds{900});
+	// A third second of debt is past max_wait: refused, nothing taken.
+	EXPECT_FALSE(limiter.reserve().has_value());
+	EXPECT_FALSE(limiter.reserve(3).has_value());
+	EXPECT_FALSE(limiter.try_acquire());
+}
+
+TEST(RateLimiter, ZeroIntervalIsUnlimited) {
+	kalshi::RateLimiter::Config config;
+	config.max_tokens = 1;
+	config.refill_interval = std::chrono::nanoseconds{0};
+
+	kalshi::RateLimiter limiter(config);
+	for (int i = 0; i < 100; ++i) {
+		ASSERT_TRUE(limiter.try_acquire(5));
+	}
+}
+
+TEST(RateLimiter, ConcurrentAcquireNeverOverspends) {
+	kalshi::RateLimiter::Config config;
+	config.initial_tokens = 1000;
+	config.max_tokens = 1000;
+	config.refill_interval = std::chrono::hours{1};
+
+	kalshi::RateLimiter limiter(config);
+	std::atomic<int> granted{0};
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 8; ++t) {
+		threads.emplace_back([&] {
+			for (int i = 0; i < 100; ++i) {
+				if (limiter.try_acquire(3)) {
+					granted.fetch_add(1);
+				}
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(granted.load(), 333);
+}
+
+TEST(RateLimiter, ConfigFromAccountBucket) {
+	const kalshi::RateLimiter::Config config =
+		kalshi::RateLimiter::Config::from_bucket({.refill_rate = 200, .bucket_capacity = 400});
+	EXPECT_EQ(config.max_tokens, 400U);
+	EXPECT_EQ(config.initial_tokens, 400U);
+	EXPECT_EQ(config.refill_interval, std::chrono::milliseconds{5});
+
+	EXPECT_EQ(kalshi::RateLimiter::Config::from_bucket({}).refill_interval.count(), 0);
+}
+
+TEST(EndpointRateLimiter, CostsFromTable) {
+	kalshi::EndpointCosts costs;
+	costs.default_cost = 10;
+	costs.endpoint_costs = {{.method = "DELETE", .path = "/portfolio/orders/{order_id}", .cost = 2},
+							{.method = "POST", .path = "/portfolio/orders/batched", .cost = 50}};
+
+	const kalshi::EndpointRateLimiter limiter({}, costs);
+	EXPECT_EQ(limiter.cost("DELETE", "/portfolio/orders/abc-123"), 2U);
+	EXPECT_EQ(limiter.cost("DELETE", "/trade-api/v2/portfolio/orders/abc?subaccount=1"), 2U);
+	EXPECT_EQ(limiter.cost("POST", "/portfolio/orders/batched"), 50U);
+	EXPECT_EQ(limiter.cost("GET", "/portfolio/orders/abc"), 10U);
+	EXPECT_EQ(limiter.cost("DELETE", "/portfolio/orders"), 10U);
+	EXPECT_EQ(limiter.cost("DELETE", "/portfolio/orders/abc/decrease"), 10U);
+
+	const kalshi::EndpointRateLimiter no_costs({}, {});
+	EXPECT_EQ(no_costs.cost("GET", "/markets"), 1U);
+}
+
+TEST(EndpointRateLimiter, RoutesReadsAndWrites) {
+	kalshi::AccountApiLimits limits;
+	limits.read = {.refill_rate = 1, .bucket_capacity = 20};
+	limits.write = {.refill_rate = 1, .bucket_capacity = 10};
+	kalshi::EndpointCosts costs;
+	costs.default_cost = 10;
+
+	kalshi::EndpointRateLimiter limiter(limits, costs);
+	EXPECT_TRUE(limiter.try_acquire("POST", "/portfolio/orders"));
+	EXPECT_FALSE(limiter.try_acquire("DELETE", "/portfolio/orders/x"));
+	EXPECT_TRUE(limiter.try_acquire("GET", "/markets"));
+	EXPECT_TRUE(limiter.try_acquire("GET", "/markets"));
+	EXPECT_FALSE(limiter.try_acquire("GET", "/markets"));
+	EXPECT_EQ(&limiter.bucket_for("PUT"), &limiter.write());
+}
+
 // --- Retry policy tests ---
 
 TEST(Retry, CalculateDelayFirstAttempt) {
@@ -0,0 +1,63 @@
+#include "kalshi/detail/json_scan.hpp"
+#include "kalshi/detail/ws_json.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+using kalshi::detail::find_any;
+using kalshi::detail::find_any_scalar;
+using kalshi::detail::find_matching_close;
+using kalshi::detail::parse_dollar_cents;
+using kalshi::detail::parse_dollars_canonical;
+using kalshi::detail::skip_json_string;
+
+TEST(JsonScan, FindAnyMatchesScalarAtEveryOffset) {
+	// Long enough to cross several 32-byte blocks plus a scalar tail.
+	std::string s(150, 'a');
+	s[3] = '"';
+	s[40] = '{';
+	s[77] = ':';
+	s[148] = ']';
+	for (std::size_t from = 0; from <= s.size(); ++from) {
+		EXPECT_EQ((find_any<'"', '{', ':', ']'>(s, from)),
+				  (find_any_scalar<'"', '{', ':', ']'>(s, from)))
+			<< "from=" << from;
+	}
+	EXPECT_EQ(find_any<'}'>(s, 0), std::string_view::npos);
+	EXPECT_EQ(find_any<'a'>(s, s.size() + 5), std::string_view::npos);
+}
+
+TEST(JsonScan, SkipJsonStringHonoursEscapes) {
+	const std::string_view s = R"("ab\"cd\\"x)";
+	EXPECT_EQ(skip_json_string(s, 1), 10u);
+	EXPECT_EQ(skip_json_string(R"("unterminated\")", 1), std::string_view::npos);
+}
+
+TEST(JsonScan, FindMatchingCloseSkipsBracketsInStrings) {
+	const std::string body = R"({"a":{"b":"}{"},"c":[1,"]",[2]]} tail)";
+	EXPECT_EQ(find_matching_close(body, 0), body.find(" tail"));
+	const std::size_t arr = body.find('[');
+	EXPECT_EQ(find_matching_close(body, arr), body.find("]}") + 1);
+	EXPECT_EQ(find_matching_close(body, 1), std::string_view::npos);
+	EXPECT_EQ(find_matching_close(R"({"a":[1,2)", 0), std::string_view::npos);
+}
+
+TEST(JsonScan, CanonicalDollarsAgreeWithGeneralParser) {
+	for (const char* s : {"0.0000", "0.4700", "0.4749", "0.4750", "0.9999", "1.0000", "9.9950"}) {
+		std::int32_t cents = -1;
+		ASSERT_TRUE(parse_dollars_canonical(s, cents)) << s;
+		EXPECT_EQ(cents, parse_dollar_cents(std::string_view(s).substr(0, 4)) +
+							 (s[4] >= '5' ? 1 : 0))
+			<< s;
+	}
+	std::int32_t cents = 7;
+	EXPECT_FALSE(parse_dollars_canonical("0.47", cents));
+	EXPECT_FALSE(parse_dollars_canonical("-0.470", cents));
+	EXPECT_FALSE(parse_dollars_canonical("0.47a0", cents));
+	EXPECT_FALSE(parse_dollars_canonical("0.4:00", cents));
+	EXPECT_EQ(cents, 7);
+	EXPECT_EQ(parse_dollar_cents("0.4750"), 48);
+	EXPECT_EQ(parse_dollar_cents("12.50"), 1250);
+}
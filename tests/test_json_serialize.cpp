@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "../src/api/json_bodies.hpp"
+#include "kalshi/api.hpp"
 #include "../src/ws/ws_cmd_bodies.hpp"
 
 namespace {
@@ -90,6 +91,20 @@ TEST(JsonSerialize, WsSubscribeWithoutMarketTickers) {
 	EXPECT_EQ(make_subscribe(1, "market_lifecycle_v2", {}), expected);
 }
 
+TEST(JsonSerialize, WsSubscribeSharded) {
+	// Server-side sharding keys follow market_tickers and are omitted when
+	// unset (pinned by the two tests above).
+	kalshi::ws_cmd::SubscribeCmd cmd;
+	cmd.id = 3;
+	cmd.cmd = "subscribe";
+	cmd.params.channels = {"orderbook_delta"};
+	cmd.params.shard_factor = 4;
+	cmd.params.shard_key = 1;
+	const std::string expected =
+		R"({"id":3,"cmd":"subscribe","params":{"channels":["orderbook_delta"],"shard_factor":4,"shard_key":1}})";
+	EXPECT_EQ(kalshi::ws_cmd::render_cmd(cmd), expected);
+}
+
 TEST(JsonSerialize, WsUnsubscribe) {
 	const std::string expected = R"({"id":7,"cmd":"unsubscribe","params":{"sids":[1234]}})";
 	EXPECT_EQ(make_unsubscribe(7, 1234), expected);
@@ -125,11 +140,11 @@ TEST(JsonSerialize, CreateOrderAllFields) {
 	body.action = "sell";
 	body.type = "limit";
 	body.count = 10;
-	body.count_fp = "10.00";
+	body.count_fp = kalshi::Quantity::from_contracts(10);
 	body.yes_price = 33;
 	body.no_price = 67;
-	body.yes_price_dollars = "0.3300";
-	body.no_price_dollars = "0.6700";
+	body.yes_price_dollars = kalshi::Price::from_cents(33);
+	body.no_price_dollars = kalshi::Price::parse("0.67").value();
 	body.client_order_id = "client-abc-123";
 	body.expiration_ts = 1788000000;
 	body.time_in_force = "fill_or_kill";
@@ -148,6 +163,21 @@ TEST(JsonSerialize, CreateOrderAllFields) {
 	EXPECT_EQ(kalshi::ser::render_body(body), expected);
 }
 
+TEST(JsonSerialize, CreateOrderSubCentPrice) {
+	kalshi::ser::CreateOrderBody body;
+	body.ticker = "KXBTCD-26MAY11-T100";
+	body.side = "yes";
+	body.action = "buy";
+	body.type = "limit";
+	body.count = 1;
+	body.count_fp = kalshi::Quantity::parse("1.5").value();
+	body.yes_price_dollars = kalshi::Price::from_ticks(4250);
+
+	const std::string expected =
+		R"({"ticker":"KXBTCD-26MAY11-T100","side":"yes","action":"buy","type":"limit","count":1,"count_fp":"1.50","yes_price_dollars":"0.4250"})";
+	EXPECT_EQ(kalshi::ser::render_body(body), expected);
+}
+
 TEST(JsonSerialize, AmendOrderPartial) {
 	kalshi::ser::AmendOrderBody body;
 	body.count = 12;
@@ -201,6 +231,34 @@ TEST(JsonSerialize, BatchOrders) {
 	EXPECT_EQ(kalshi::ser::render_body(body), expected);
 }
 
+TEST(JsonSerialize, RenderOrdersIntoReusedBuffer) {
+	kalshi::CreateOrderParams params;
+	params.ticker = "KXHIGHDEN-26MAY11-T80";
+	params.side = kalshi::Side::No;
+	params.action = kalshi::Action::Sell;
+	params.count = 5;
+	params.yes_price = 47;
+	params.client_order_id = "client-abc-123";
+
+	std::string buffer;
+	kalshi::KalshiClient::render_create_order(params, buffer);
+	EXPECT_EQ(buffer,
+			  R"({"ticker":"KXHIGHDEN-26MAY11-T80","side":"no","action":"sell","type":"limit","count":5,"yes_price":47,"client_order_id":"client-abc-123"})");
+
+	kalshi::BatchOrderRequest batch;
+	batch.orders = {params, params};
+	kalshi::KalshiClient::render_batch_create(batch, buffer);
+	const std::size_t capacity = buffer.capacity();
+	EXPECT_EQ(buffer.rfind(R"({"orders":[{"ticker":"KXHIGHDEN-26MAY11-T80",)", 0), 0U);
+
+	// A smaller body replaces the contents and keeps the grown capacity.
+	params.client_order_id.reset();
+	kalshi::KalshiClient::render_create_order(params, buffer);
+	EXPECT_EQ(buffer,
+			  R"({"ticker":"KXHIGHDEN-26MAY11-T80","side":"no","action":"sell","type":"limit","count":5,"yes_price":47})");
+	EXPECT_EQ(buffer.capacity(), capacity);
+}
+
 TEST(JsonSerialize, BatchCancel) {
 	kalshi::ser::BatchCancelBody body;
 	body.orders = {
@@ -0,0 +1,145 @@
+// Unit tests for LatencyStats: histogram bucketing and percentiles,
+// per-thread recording merged by snapshot, endpoint naming and the
+// Prometheus rendering.
+
+#include "kalshi/latency_stats.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using kalshi::LatencyCounter;
+using kalshi::LatencyHistogram;
+using kalshi::LatencySource;
+using kalshi::LatencyStage;
+
+TEST(LatencyHistogram, BucketsRoundTrip) {
+	for (std::uint64_t ns : {0ull, 1ull, 31ull, 32ull, 33ull, 1000ull, 123456ull, 999999999ull}) {
+		const std::size_t index = LatencyHistogram::bucket_index(ns);
+		EXPECT_LE(LatencyHistogram::bucket_lower(index), ns) << ns;
+		EXPECT_GT(LatencyHistogram::bucket_lower(index + 1), ns) << ns;
+	}
+	// Exact below 32 ns, then 16 buckets per power of two.
+	EXPECT_EQ(LatencyHistogram::bucket_index(31), 31u);
+	EXPECT_EQ(LatencyHistogram::bucket_index(32), 32u);
+	EXPECT_EQ(LatencyHistogram::bucket_index(34), 33u);
+	EXPECT_EQ(LatencyHistogram::bucket_index(~std::uint64_t{0}),
+			  LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(LatencyHistogram, PercentilesWithinBucketError) {
+	LatencyHistogram hist;
+	EXPECT_EQ(hist.percentile(0.5), 0u);
+	for (std::uint64_t us = 1; us <= 1000; ++us) {
+		hist.record(us * 1000);
+	}
+	EXPECT_EQ(hist.count(), 1000u);
+	EXPECT_EQ(hist.min_ns(), 1000u);
+	EXPECT_EQ(hist.max_ns(), 1000000u);
+	EXPECT_DOUBLE_EQ(hist.mean_ns(), 500500.0);
+	for (const double q : {0.5, 0.9, 0.99}) {
+		const double expected = q * 1e6;
+		EXPECT_GE(static_cast<double>(hist.percentile(q)), expected) << q;
+		EXPECT_LE(static_cast<double>(hist.percentile(q)), expected * (1.0 + 1.0 / 16)) << q;
+	}
+	EXPECT_EQ(hist.percentile(1.0), 1000000u);
+
+	LatencyHistogram other;
+	other.record(5);
+	hist.merge(other);
+	EXPECT_EQ(hist.count(), 1001u);
+	EXPECT_EQ(hist.min_ns(), 5u);
+}
+
+TEST(LatencyStats, EndpointNames) {
+	EXPECT_EQ(kalshi::latency_endpoint("GET", "/markets?limit=100&cursor=abc"), "GET /markets");
+	EXPECT_EQ(kalshi::latency_endpoint("GET", "/markets/KXBTC-26-T1/orderbook"),
+			  "GET /markets/{id}/orderbook");
+	EXPECT_EQ(kalshi::latency_endpoint("POST", "/portfolio/orders/3fa85f64-5717/amend"),
+			  "POST /portfolio/orders/{id}/amend");
+	EXPECT_EQ(kalshi::latency_endpoint("POST", "/portfolio/orders/batched"),
+			  "POST /portfolio/orders/batched");
+}
+
+TEST(LatencyStats, SnapshotMergesThreads) {
+	kalshi::LatencyStats stats;
+	constexpr int kThreads = 4;
+	constexpr int kPerThread = 1000;
+	constexpr std::uint64_t kTotal = std::uint64_t{kThreads} * kPerThread;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < kThreads; ++t) {
+		threads.emplace_back([&stats] {
+			for (int i = 0; i < kPerThread; ++i) {
+				kalshi::LatencyStats::Recorder rest =
+					stats.rest("POST", "/portfolio/orders/abc-123/amend");
+				rest.record(LatencyStage::Total, std::chrono::microseconds(100));
+				rest.add(LatencyCounter::Requests);
+				rest.add(LatencyCounter::BytesOut, 10);
+				stats.ws("orderbook_delta").add(LatencyCounter::Messages);
+			}
+		});
+	}
+	// Snapshots taken while recording see consistent, partial totals.
+	const kalshi::LatencySnapshot partial = stats.snapshot();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	if (const kalshi::LatencySeries* s =
+			partial.find(LatencySource::Rest, "POST /portfolio/orders/{id}/amend")) {
+		EXPECT_LE(s->stage(LatencyStage::Total).count(), kTotal);
+	}
+
+	const kalshi::LatencySnapshot snapshot = stats.snapshot();
+	ASSERT_EQ(snapshot.series.size(), 2u);
+	EXPECT_EQ(snapshot.series[0].source, LatencySource::Rest);
+
+	const kalshi::LatencySeries* rest =
+		snapshot.find(LatencySource::Rest, "POST /portfolio/orders/{id}/amend");
+	ASSERT_NE(rest, nullptr);
+	EXPECT_EQ(rest->stage(LatencyStage::Total).count(), kTotal);
+	EXPECT_EQ(rest->stage(LatencyStage::Total).max_ns(), 100000u);
+	EXPECT_EQ(rest->stage(LatencyStage::Sign).count(), 0u);
+	EXPECT_EQ(rest->counter(LatencyCounter::Requests), kTotal);
+	EXPECT_EQ(rest->counter(LatencyCounter::BytesOut), 10u * kTotal);
+
+	const kalshi::LatencySeries* ws = snapshot.find(LatencySource::WebSocket, "orderbook_delta");
+	ASSERT_NE(ws, nullptr);
+	EXPECT_EQ(ws->counter(LatencyCounter::Messages), kTotal);
+	EXPECT_EQ(snapshot.find(LatencySource::Rest, "orderbook_delta"), nullptr);
+}
+
+TEST(LatencyStats, InstancesAreIndependent) {
+	kalshi::LatencyStats a;
+	{
+		kalshi::LatencyStats b;
+		b.ws("trade").add(LatencyCounter::Messages);
+	}
+	a.ws("trade").add(LatencyCounter::Messages, 2);
+	kalshi::LatencyStats c;
+	EXPECT_TRUE(c.snapshot().series.empty());
+	ASSERT_EQ(a.snapshot().series.size(), 1u);
+	EXPECT_EQ(a.snapshot().series[0].counter(LatencyCounter::Messages), 2u);
+}
+
+TEST(LatencyStats, Prometheus) {
+	kalshi::LatencyStats stats;
+	kalshi::LatencyStats::Recorder rest = stats.rest("GET", "/portfolio/balance");
+	rest.record(LatencyStage::Total, 2000000);
+	rest.add(LatencyCounter::RateLimited);
+
+	const std::string text = kalshi::to_prometheus(stats.snapshot(), "kx");
+	EXPECT_NE(text.find("# TYPE kx_latency_seconds summary\n"), std::string::npos);
+	EXPECT_NE(text.find("kx_latency_seconds{source=\"rest\",name=\"GET /portfolio/balance\","
+						"stage=\"total\",quantile=\"0.99\"} 0.002"),
+			  std::string::npos);
+	EXPECT_NE(text.find("kx_latency_seconds_count{source=\"rest\",name=\"GET "
+						"/portfolio/balance\",stage=\"total\"} 1\n"),
+			  std::string::npos);
+	EXPECT_NE(text.find("kx_rate_limited_total{source=\"rest\",name=\"GET "
+						"/portfolio/balance\"} 1\n"),
+			  std::string::npos);
+	// Empty stages and zero counters are left out.
+	EXPECT_EQ(text.find("stage=\"sign\""), std::string::npos);
+	EXPECT_EQ(text.find("kx_requests_total{"), std::string::npos);
+}
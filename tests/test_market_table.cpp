@@ -0,0 +1,171 @@
+// Unit tests for MarketTable: upserts into the columns and string pool,
+// filtering and sorting, and keeping rows current from feed updates.
+
+#include "kalshi/market_table.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+kalshi::Market make_market(const std::string& ticker, std::int32_t yes_bid, std::int32_t yes_ask,
+						   std::int32_t volume, std::int64_t close_time) {
+	kalshi::Market market;
+	market.ticker = ticker;
+	market.title = "Title of " + ticker;
+	market.subtitle = "Sub " + ticker;
+	market.yes_bid = yes_bid;
+	market.yes_ask = yes_ask;
+	market.no_bid = 100 - yes_ask;
+	market.no_ask = 100 - yes_bid;
+	market.volume = volume;
+	market.open_interest = volume / 2;
+	market.close_time = close_time;
+	return market;
+}
+
+} // namespace
+
+TEST(MarketTable, UpsertFillsColumnsAndPool) {
+	kalshi::MarketTable table;
+	EXPECT_EQ(table.upsert(make_market("KXA", 40, 45, 100, 1000)), 0u);
+	EXPECT_EQ(table.upsert(make_market("KXB", 10, 30, 5, 2000)), 1u);
+	ASSERT_EQ(table.size(), 2u);
+	EXPECT_EQ(table.yes_bids()[1], 10);
+	EXPECT_EQ(table.close_times()[0], 1000);
+	EXPECT_EQ(table.ticker(1), "KXB");
+	EXPECT_EQ(table.title(0), "Title of KXA");
+	EXPECT_EQ(table.find("KXB"), 1u);
+	EXPECT_FALSE(table.find("KXC").has_value());
+
+	// Same ticker: the row is overwritten in place.
+	kalshi::Market update = make_market("KXA", 41, 44, 120, 1000);
+	update.title = "Renamed";
+	EXPECT_EQ(table.upsert(update), 0u);
+	EXPECT_EQ(table.size(), 2u);
+	EXPECT_EQ(table.yes_bids()[0], 41);
+	EXPECT_EQ(table.title(0), "Renamed");
+
+	const kalshi::Market rebuilt = table.market(0);
+	EXPECT_EQ(rebuilt.ticker, "KXA");
+	EXPECT_EQ(rebuilt.volume, 120);
+	EXPECT_EQ(rebuilt.yes_ask_dollars, kalshi::Price::from_cents(44));
+	EXPECT_FALSE(rebuilt.result.has_value());
+}
+
+TEST(MarketTable, SelectAppliesEveryBound) {
+	kalshi::MarketTable table;
+	// Enough rows to cross a select block boundary.
+	for (int i = 0; i < 1000; ++i) {
+		kalshi::Market market = make_market("KX" + std::to_string(i), i % 100, i % 100 + i % 7,
+											i, 1000 + i);
+		if (i % 10 == 0) {
+			market.status = kalshi::MarketStatus::Closed;
+		}
+		table.upsert(market);
+	}
+	const kalshi::MarketFilter filter{.status = kalshi::MarketStatus::Open,
+									  .min_yes_bid = 20,
+									  .max_yes_ask = 80,
+									  .max_spread = 3,
+									  .min_volume = 300,
+									  .close_before = 1900};
+	std::vector<std::uint32_t> rows;
+	const std::size_t count = table.select(filter, rows);
+	ASSERT_EQ(count, rows.size());
+
+	std::vector<std::uint32_t> expected;
+	for (std::uint32_t i = 0; i < 1000; ++i) {
+		const std::int32_t bid = static_cast<std::int32_t>(i % 100);
+		const std::int32_t spread = static_cast<std::int32_t>(i % 7);
+		if (i % 10 != 0 && bid >= 20 && bid + spread <= 80 && spread <= 3 && i >= 300 &&
+			1000 + i <= 1900) {
+			expected.push_back(i);
+		}
+	}
+	EXPECT_EQ(rows, expected);
+
+	EXPECT_EQ(table.select({}, rows), 1000u);
+}
+
+TEST(MarketTable, SortByColumn) {
+	kalshi::MarketTable table;
+	table.upsert(make_market("KXA", 40, 45, 100, 3000));
+	table.upsert(make_market("KXB", 10, 30, 500, 1000));
+	table.upsert(make_market("KXC", 50, 52, 100, 2000));
+	std::vector<std::uint32_t> rows;
+	table.select({}, rows);
+
+	table.sort(rows, kalshi::MarketColumn::Volume);
+	EXPECT_EQ(rows, (std::vector<std::uint32_t>{1, 0, 2})); // ties keep row order
+	table.sort(rows, kalshi::MarketColumn::Spread, kalshi::SortOrder::Ascending);
+	EXPECT_EQ(rows, (std::vector<std::uint32_t>{2, 0, 1}));
+	EXPECT_EQ(table.value(1, kalshi::MarketColumn::Spread), 20);
+	table.sort(rows, kalshi::MarketColumn::CloseTime, kalshi::SortOrder::Ascending);
+	EXPECT_EQ(rows, (std::vector<std::uint32_t>{1, 2, 0}));
+}
+
+TEST(MarketTable, AppliesBookTradesAndLifecycle) {
+	kalshi::MarketTable table;
+	kalshi::Market market = make_market("KXA", 40, 45, 100, 1000);
+	market.ticker_id = kalshi::TickerId{7};
+	table.upsert(market);
+	EXPECT_EQ(table.find(kalshi::TickerId{7}), 0u);
+
+	kalshi::TopOfBook top;
+	top.ticker_id = kalshi::TickerId{7};
+	top.yes_bid = {42, 10};
+	top.no_bid = {0, 0};
+	top.valid = true;
+	EXPECT_TRUE(table.apply(top));
+	EXPECT_EQ(table.yes_bids()[0], 42);
+	EXPECT_EQ(table.yes_asks()[0], 100); // no NO bids
+	EXPECT_EQ(table.no_asks()[0], 58);
+	top.ticker_id = kalshi::TickerId{8};
+	EXPECT_FALSE(table.apply(top));
+
+	kalshi::WsTrade trade;
+	trade.market_ticker = "KXA"; // no id: found by ticker
+	trade.yes_price = 43;
+	trade.count = 5;
+	EXPECT_TRUE(table.apply(kalshi::WsMessage{trade}));
+	EXPECT_EQ(table.volumes()[0], 105);
+	EXPECT_EQ(table.last_prices()[0], 43);
+
+	kalshi::WsEvent event;
+	event.kind = kalshi::WsEventKind::Trade;
+	event.ticker_id = kalshi::TickerId{7};
+	event.price = 44;
+	event.quantity = 2;
+	EXPECT_TRUE(table.apply(event));
+	EXPECT_EQ(table.volumes()[0], 107);
+
+	kalshi::MarketLifecycle lifecycle;
+	lifecycle.market_ticker = "KXA";
+	lifecycle.ticker_id = kalshi::TickerId{7};
+	lifecycle.yes_sub_title = "Above 51";
+	EXPECT_TRUE(table.apply(kalshi::WsMessage{lifecycle}));
+	EXPECT_EQ(table.subtitle(0), "Above 51");
+
+	lifecycle.settled_ts = 2000;
+	lifecycle.result = "yes";
+	EXPECT_TRUE(table.apply(kalshi::WsMessage{lifecycle}));
+	EXPECT_EQ(table.statuses()[0], kalshi::MarketStatus::Settled);
+	EXPECT_EQ(table.result(0), "yes");
+	EXPECT_EQ(table.market(0).result, "yes");
+}
+
+TEST(MarketTable, PoolReclaimsReplacedText) {
+	kalshi::MarketTable table;
+	table.upsert(make_market("KXA", 40, 45, 100, 1000));
+	kalshi::MarketLifecycle lifecycle;
+	lifecycle.market_ticker = "KXA";
+	for (int i = 0; i < 2000; ++i) {
+		lifecycle.yes_sub_title = "Subtitle revision " + std::to_string(i);
+		table.apply(kalshi::WsMessage{lifecycle});
+	}
+	EXPECT_EQ(table.subtitle(0), "Subtitle revision 1999");
+	EXPECT_EQ(table.ticker(0), "KXA");
+	EXPECT_LT(table.pool_bytes(), 16u * 1024);
+}
@@ -0,0 +1,161 @@
+// Unit tests for MetadataCache: TTL expiry, the close-time check, and
+// lifecycle patches / invalidations.
+
+#include "kalshi/metadata_cache.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace {
+
+std::int64_t unix_now() {
+	return std::chrono::duration_cast<std::chrono::seconds>(
+			   std::chrono::system_clock::now().time_since_epoch())
+		.count();
+}
+
+kalshi::Market open_market(const char* ticker) {
+	kalshi::Market market;
+	market.ticker = ticker;
+	market.title = "Bitcoin above 100k?";
+	market.close_time = unix_now() + 3600;
+	return market;
+}
+
+} // namespace
+
+TEST(MetadataCache, HitReturnsStoredObject) {
+	kalshi::MetadataCache cache;
+	EXPECT_EQ(cache.market("KXBTC"), nullptr);
+
+	const std::shared_ptr<const kalshi::Market> stored = cache.put(open_market("KXBTC"));
+	const std::shared_ptr<const kalshi::Market> hit = cache.market("KXBTC");
+	ASSERT_NE(hit, nullptr);
+	EXPECT_EQ(hit.get(), stored.get());
+	EXPECT_EQ(hit->title, "Bitcoin above 100k?");
+
+	kalshi::Series series;
+	series.ticker = "KXBTC";
+	cache.put(series);
+	EXPECT_NE(cache.series("KXBTC"), nullptr);
+	EXPECT_EQ(cache.event("KXBTC"), nullptr);
+
+	EXPECT_EQ(cache.stats().hits, 2u);
+	EXPECT_EQ(cache.stats().misses, 2u);
+}
+
+TEST(MetadataCache, EntriesExpire) {
+	kalshi::MetadataCache cache({.market_ttl = std::chrono::milliseconds{20}});
+	cache.put(open_market("KXBTC"));
+	EXPECT_NE(cache.market("KXBTC"), nullptr);
+	std::this_thread::sleep_for(std::chrono::milliseconds{40});
+	EXPECT_EQ(cache.market("KXBTC"), nullptr);
+}
+
+TEST(MetadataCache, EntriesCarryRemainingTtl) {
+	kalshi::MetadataCache cache;
+	cache.put(open_market("KXBTC"), std::chrono::minutes{5});
+	cache.put(open_market("KXETH"), std::chrono::milliseconds{0});
+	kalshi::Series series;
+	series.ticker = "KXBTC";
+	cache.put(series);
+
+	const kalshi::MetadataCacheEntries entries = cache.entries();
+	ASSERT_EQ(entries.markets.size(), 1u);
+	EXPECT_EQ(entries.markets[0].value->ticker, "KXBTC");
+	EXPECT_GT(entries.markets[0].ttl, std::chrono::minutes{4});
+	EXPECT_LE(entries.markets[0].ttl, std::chrono::minutes{5});
+	ASSERT_EQ(entries.series.size(), 1u);
+	EXPECT_LE(entries.series[0].ttl, cache.config().series_ttl);
+	EXPECT_TRUE(entries.events.empty());
+	EXPECT_TRUE(entries.event_metadata.empty());
+}
+
+TEST(MetadataCache, OpenMarketPastCloseTimeIsAMiss) {
+	kalshi::MetadataCache cache;
+	kalshi::Market market = open_market("KXBTC");
+	market.close_time = unix_now() - 1;
+	cache.put(market);
+	EXPECT_EQ(cache.market("KXBTC"), nullptr);
+
+	market.status = kalshi::MarketStatus::Closed;
+	cache.put(market);
+	EXPECT_NE(cache.market("KXBTC"), nullptr);
+}
+
+TEST(MetadataCache, LifecyclePatchesAndInvalidates) {
+	kalshi::MetadataCache cache;
+	const std::shared_ptr<const kalshi::Market> before = cache.put(open_market("KXBTC"));
+	cache.put(open_market("KXETH"));
+
+	kalshi::MarketLifecycle settled;
+	settled.market_ticker = "KXBTC";
+	settled.settled_ts = 1776673036;
+	settled.result = "yes";
+	EXPECT_TRUE(cache.apply(settled));
+
+	const std::shared_ptr<const kalshi::Market> after = cache.market("KXBTC");
+	ASSERT_NE(after, nullptr);
+	EXPECT_EQ(after->status, kalshi::MarketStatus::Settled);
+	EXPECT_EQ(after->result, "yes");
+	EXPECT_EQ(after->settlement_ts, 1776673036);
+	// Readers holding the old entry keep an unchanged snapshot.
+	EXPECT_EQ(before->status, kalshi::MarketStatus::Open);
+
+	kalshi::MarketLifecycle paused;
+	paused.market_ticker = "KXETH";
+	paused.is_deactivated = true;
+	EXPECT_TRUE(cache.apply(paused));
+	EXPECT_EQ(cache.market("KXETH")->status, kalshi::MarketStatus::Paused);
+
+	kalshi::MarketLifecycle reopened;
+	reopened.market_ticker = "KXETH";
+	reopened.open_ts = 1;
+	reopened.close_ts = unix_now() + 60;
+	EXPECT_TRUE(cache.apply(reopened));
+	EXPECT_EQ(cache.market("KXETH"), nullptr);
+
+	kalshi::MarketLifecycle unknown_market;
+	unknown_market.market_ticker = "KXSOL";
+	unknown_market.is_deactivated = true;
+	EXPECT_FALSE(cache.apply(unknown_market));
+
+	EXPECT_EQ(cache.stats().patches, 2u);
+	EXPECT_EQ(cache.stats().invalidations, 1u);
+}
+
+TEST(MetadataCache, InvalidateEventDropsMetadataToo) {
+	kalshi::MetadataCache cache;
+	kalshi::Event event;
+	event.event_ticker = "KXBTC-26";
+	kalshi::EventMetadata metadata;
+	metadata.event_ticker = "KXBTC-26";
+	cache.put(event);
+	cache.put(metadata);
+	EXPECT_NE(cache.event_metadata("KXBTC-26"), nullptr);
+
+	cache.invalidate_event("KXBTC-26");
+	EXPECT_EQ(cache.event("KXBTC-26"), nullptr);
+	EXPECT_EQ(cache.event_metadata("KXBTC-26"), nullptr);
+	EXPECT_EQ(cache.stats().invalidations, 2u);
+}
+
+TEST(MetadataCache, FullCacheEvicts) {
+	kalshi::MetadataCache cache({.max_entries = 2});
+	cache.put(open_market("A"));
+	cache.put(open_market("B"));
+	cache.put(open_market("C"));
+	const int present = (cache.market("A") != nullptr) + (cache.market("B") != nullptr) +
+						(cache.market("C") != nullptr);
+	EXPECT_EQ(present, 2);
+	EXPECT_NE(cache.market("C"), nullptr);
+}
+
+TEST(MetadataCache, ZeroMaxEntriesIsUnbounded) {
+	kalshi::MetadataCache cache({.max_entries = 0});
+	cache.put(open_market("A"));
+	cache.put(open_market("B"));
+	EXPECT_NE(cache.market("A"), nullptr);
+	EXPECT_NE(cache.market("B"), nullptr);
+}
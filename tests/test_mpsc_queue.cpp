@@ -0,0 +1,138 @@
+#include "kalshi/detail/mpsc_queue.hpp"
+
+#include "send_buffer_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using kalshi::detail::MpscQueue;
+using kalshi::ws_detail::SendBuffer;
+using kalshi::ws_detail::SendBufferPool;
+
+namespace {
+
+struct TestNode {
+	int producer{0};
+	int value{0};
+	std::atomic<TestNode*> next{nullptr};
+};
+
+} // namespace
+
+TEST(MpscQueue, PushPopPreservesFifoOrder) {
+	MpscQueue<TestNode> queue;
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(queue.pop(), nullptr);
+
+	std::vector<TestNode> nodes(4);
+	for (int i = 0; i < 4; ++i) {
+		nodes[static_cast<std::size_t>(i)].value = i;
+		queue.push(&nodes[static_cast<std::size_t>(i)]);
+	}
+	EXPECT_FALSE(queue.empty());
+	for (int i = 0; i < 4; ++i) {
+		TestNode* node = queue.pop();
+		ASSERT_NE(node, nullptr);
+		EXPECT_EQ(node->value, i);
+	}
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(queue.pop(), nullptr);
+}
+
+TEST(MpscQueue, NodesCanBeReusedAfterPop) {
+	MpscQueue<TestNode> queue;
+	TestNode node;
+	for (int round = 0; round < 3; ++round) {
+		node.value = round;
+		queue.push(&node);
+		TestNode* popped = queue.pop();
+		ASSERT_EQ(popped, &node);
+		EXPECT_EQ(popped->value, round);
+		EXPECT_TRUE(queue.empty());
+	}
+}
+
+TEST(MpscQueue, ConcurrentProducersKeepPerProducerOrder) {
+	constexpr int kProducers = 4;
+	constexpr int kPerProducer = 20000;
+	MpscQueue<TestNode> queue;
+	std::vector<std::unique_ptr<TestNode[]>> nodes;
+	for (int p = 0; p < kProducers; ++p) {
+		nodes.push_back(std::make_unique<TestNode[]>(kPerProducer));
+	}
+
+	std::vector<std::thread> producers;
+	for (int p = 0; p < kProducers; ++p) {
+		producers.emplace_back([&queue, &nodes, p] {
+			for (int i = 0; i < kPerProducer; ++i) {
+				TestNode& node = nodes[static_cast<std::size_t>(p)][i];
+				node.producer = p;
+				node.value = i;
+				queue.push(&node);
+			}
+		});
+	}
+
+	std::vector<int> next_expected(kProducers, 0);
+	int received = 0;
+	while (received < kProducers * kPerProducer) {
+		TestNode* node = queue.pop();
+		if (node == nullptr) {
+			std::this_thread::yield();
+			continue;
+		}
+		ASSERT_EQ(node->value, next_expected[static_cast<std::size_t>(node->producer)]);
+		++next_expected[static_cast<std::size_t>(node->producer)];
+		++received;
+	}
+	for (std::thread& producer : producers) {
+		producer.join();
+	}
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST(SendBufferPool, SealOpensHeadroomInFrontOfPayload) {
+	SendBufferPool pool(16);
+	std::unique_ptr<SendBuffer> buffer = pool.acquire();
+	buffer->frame = R"({"id":1})";
+	buffer->seal();
+	ASSERT_EQ(buffer->frame.size(), 16u + 8u);
+	EXPECT_EQ(buffer->payload_size(), 8u);
+	EXPECT_EQ(std::string(reinterpret_cast<const char*>(buffer->payload()), buffer->payload_size()),
+			  R"({"id":1})");
+}
+
+TEST(SendBufferPool, ReleasedBuffersAreReusedWithCapacity) {
+	SendBufferPool pool(16);
+	std::unique_ptr<SendBuffer> buffer = pool.acquire();
+	buffer->frame.assign(512, 'x');
+	const SendBuffer* first = buffer.get();
+	pool.release(std::move(buffer));
+	EXPECT_EQ(pool.free_count(), 1u);
+
+	std::unique_ptr<SendBuffer> again = pool.acquire();
+	EXPECT_EQ(again.get(), first);
+	EXPECT_TRUE(again->frame.empty());
+	EXPECT_GE(again->frame.capacity(), 512u);
+	EXPECT_EQ(pool.allocated(), 1u);
+}
+
+TEST(SendBufferPool, OversizedAndSurplusBuffersAreFreed) {
+	SendBufferPool pool(16, 1);
+	std::unique_ptr<SendBuffer> big = pool.acquire();
+	big->frame.assign(SendBufferPool::kMaxRetainedBytes + 1, 'x');
+	pool.release(std::move(big));
+	EXPECT_EQ(pool.free_count(), 0u);
+
+	std::unique_ptr<SendBuffer> a = pool.acquire();
+	std::unique_ptr<SendBuffer> b = pool.acquire();
+	pool.release(std::move(a));
+	pool.release(std::move(b));
+	EXPECT_EQ(pool.free_count(), 1u);
+	EXPECT_EQ(pool.allocated(), 3u);
+}
@@ -0,0 +1,171 @@
+#include "kalshi/orderbook_book.hpp"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <span>
+
+using kalshi::BookUpdate;
+using kalshi::OrderbookDelta;
+using kalshi::OrderbookSnapshot;
+using kalshi::OrderBookBook;
+using kalshi::SeqCheck;
+using kalshi::Side;
+
+namespace {
+
+OrderbookSnapshot make_snapshot(std::int32_t seq) {
+	OrderbookSnapshot snap;
+	snap.seq = seq;
+	snap.market_ticker = "KXTEST";
+	snap.yes = {{40, 100}, {42, 25}, {1, 5}};
+	snap.no = {{55, 10}, {57, 3}, {99, 1}};
+	return snap;
+}
+
+OrderbookDelta make_delta(std::int32_t seq, Side side, std::int32_t price, std::int32_t qty) {
+	OrderbookDelta delta;
+	delta.seq = seq;
+	delta.market_ticker = "KXTEST";
+	delta.side = side;
+	delta.price = price;
+	delta.delta = qty;
+	return delta;
+}
+
+} // namespace
+
+TEST(OrderBookBook, SnapshotSetsLevelsAndTopOfBook) {
+	OrderBookBook book;
+	EXPECT_FALSE(book.valid());
+	EXPECT_EQ(book.apply(make_snapshot(1)), BookUpdate::Applied);
+	EXPECT_TRUE(book.valid());
+	EXPECT_EQ(book.last_seq(), 1);
+	EXPECT_EQ(book.quantity(Side::Yes, 42), 25);
+	EXPECT_EQ(book.level_count(Side::Yes), 3u);
+
+	ASSERT_TRUE(book.best_bid(Side::Yes).has_value());
+	EXPECT_EQ(book.best_bid(Side::Yes)->price_cents, 42);
+	EXPECT_EQ(book.best_bid(Side::No)->price_cents, 99);
+	// YES ask is implied by the best NO bid: 100 - 99 = 1.
+	EXPECT_EQ(book.best_ask(Side::Yes)->price_cents, 1);
+	EXPECT_EQ(book.best_ask(Side::Yes)->quantity, 1);
+	EXPECT_EQ(book.best_ask(Side::No)->price_cents, 58);
+}
+
+TEST(OrderBookBook, ToSnapshotRebuildsTheBook) {
+	OrderBookBook book;
+	book.apply(make_snapshot(1));
+	book.apply(make_delta(2, Side::No, 60, 7));
+
+	const OrderbookSnapshot snap = book.to_snapshot("KXTEST");
+	EXPECT_EQ(snap.seq, 2);
+	EXPECT_EQ(snap.market_ticker, "KXTEST");
+	OrderBookBook copy;
+	EXPECT_EQ(copy.apply(snap), BookUpdate::Applied);
+	EXPECT_EQ(copy.last_seq(), 2);
+	for (std::int32_t p = OrderBookBook::kMinPrice; p <= OrderBookBook::kMaxPrice; ++p) {
+		EXPECT_EQ(copy.quantity(Side::Yes, p), book.quantity(Side::Yes, p));
+		EXPECT_EQ(copy.quantity(Side::No, p), book.quantity(Side::No, p));
+	}
+}
+
+TEST(OrderBookBook, DeltaAddsAndRemovesLevels) {
+	OrderBookBook book;
+	ASSERT_EQ(book.apply(make_snapshot(1)), BookUpdate::Applied);
+
+	EXPECT_EQ(book.apply(make_delta(2, Side::Yes, 45, 7)), BookUpdate::Applied);
+	EXPECT_EQ(book.best_bid(Side::Yes)->price_cents, 45);
+	EXPECT_EQ(book.best_bid(Side::Yes)->quantity, 7);
+
+	// Over-removal clamps to an empty level instead of going negative.
+	EXPECT_EQ(book.apply(make_delta(3, Side::Yes, 45, -10)), BookUpdate::Applied);
+	EXPECT_EQ(book.quantity(Side::Yes, 45), 0);
+	EXPECT_EQ(book.best_bid(Side::Yes)->price_cents, 42);
+
+	EXPECT_EQ(book.apply(make_delta(4, Side::No, 99, -1)), BookUpdate::Applied);
+	EXPECT_EQ(book.best_bid(Side::No)->price_cents, 57);
+	EXPECT_EQ(book.last_seq(), 4);
+}
+
+TEST(OrderBookBook, EmptySideHasNoTopOfBook) {
+	OrderBookBook book;
+	OrderbookSnapshot snap;
+	snap.seq = 1;
+	ASSERT_EQ(book.apply(snap), BookUpdate::Applied);
+	EXPECT_FALSE(book.best_bid(Side::Yes).has_value());
+	EXPECT_FALSE(book.best_ask(Side::No).has_value());
+	EXPECT_EQ(book.level_count(Side::No), 0u);
+}
+
+TEST(OrderBookBook, DeltaBeforeSnapshotIsRejected) {
+	OrderBookBook book;
+	EXPECT_EQ(book.apply(make_delta(1, Side::Yes, 40, 1)), BookUpdate::NeedsSnapshot);
+	EXPECT_EQ(book.quantity(Side::Yes, 40), 0);
+}
+
+TEST(OrderBookBook, ContiguousGapInvalidatesUntilSnapshot) {
+	OrderBookBook book(SeqCheck::Contiguous);
+	ASSERT_EQ(book.apply(make_snapshot(10)), BookUpdate::Applied);
+	EXPECT_EQ(book.apply(make_delta(10, Side::Yes, 40, 1)), BookUpdate::Stale);
+	EXPECT_EQ(book.apply(make_delta(12, Side::Yes, 40, 1)), BookUpdate::Gap);
+	EXPECT_FALSE(book.valid());
+	EXPECT_EQ(book.apply(make_delta(13, Side::Yes, 40, 1)), BookUpdate::NeedsSnapshot);
+	EXPECT_EQ(book.quantity(Side::Yes, 40), 100);
+
+	ASSERT_EQ(book.apply(make_snapshot(20)), BookUpdate::Applied);
+	EXPECT_EQ(book.apply(make_delta(21, Side::Yes, 40, 1)), BookUpdate::Applied);
+	EXPECT_EQ(book.quantity(Side::Yes, 40), 101);
+}
+
+TEST(OrderBookBook, MonotonicToleratesSkipsButRejectsReplays) {
+	OrderBookBook book(SeqCheck::Monotonic);
+	ASSERT_EQ(book.apply(make_snapshot(10)), BookUpdate::Applied);
+	EXPECT_EQ(book.apply(make_delta(15, Side::Yes, 40, 1)), BookUpdate::Applied);
+	EXPECT_EQ(book.apply(make_delta(14, Side::Yes, 40, 1)), BookUpdate::Stale);
+	EXPECT_TRUE(book.valid());
+	EXPECT_EQ(book.quantity(Side::Yes, 40), 101);
+}
+
+TEST(OrderBookBook, OutOfRangePriceIsIgnored) {
+	OrderBookBook book;
+	ASSERT_EQ(book.apply(make_snapshot(1)), BookUpdate::Applied);
+	EXPECT_EQ(book.apply(make_delta(2, Side::Yes, 100, 5)), BookUpdate::OutOfRange);
+	EXPECT_EQ(book.apply(make_delta(0, Side::Yes, 0, 5)), BookUpdate::OutOfRange);
+	EXPECT_EQ(book.quantity(Side::Yes, 100), 0);
+}
+
+TEST(OrderBookBook, OutOfRangeDeltaStillAdvancesSeq) {
+	OrderBookBook book(SeqCheck::Contiguous);
+	ASSERT_EQ(book.apply(make_snapshot(1)), BookUpdate::Applied);
+	EXPECT_EQ(book.apply(make_delta(2, Side::Yes, 100, 5)), BookUpdate::OutOfRange);
+	EXPECT_EQ(book.apply(make_delta(3, Side::Yes, 40, 1)), BookUpdate::Applied);
+	EXPECT_TRUE(book.valid());
+	EXPECT_EQ(book.quantity(Side::Yes, 40), 101);
+	EXPECT_EQ(book.apply(make_delta(2, Side::Yes, 40, 1)), BookUpdate::Stale);
+}
+
+TEST(OrderBookBook, ToOrderBookIsAscending) {
+	OrderBookBook book;
+	ASSERT_EQ(book.apply(make_snapshot(1)), BookUpdate::Applied);
+	const kalshi::OrderBook ob = book.to_order_book("KXTEST");
+	EXPECT_EQ(ob.market_ticker, "KXTEST");
+	ASSERT_EQ(ob.yes_bids.size(), 3u);
+	EXPECT_EQ(ob.yes_bids[0].price_cents, 1);
+	EXPECT_EQ(ob.yes_bids[2].price_cents, 42);
+	ASSERT_EQ(ob.no_bids.size(), 3u);
+	EXPECT_EQ(ob.no_bids[2].price_cents, 99);
+}
+
+TEST(OrderBookBook, AppliesBorrowedSnapshotLevels) {
+	const std::array<kalshi::OrderBookEntry, 3> levels{{{40, 100}, {42, 25}, {57, 3}}};
+	OrderbookSnapshot snap;
+	snap.seq = 4;
+	snap.yes_view = std::span<const kalshi::OrderBookEntry>{levels}.first(2);
+	snap.no_view = std::span<const kalshi::OrderBookEntry>{levels}.subspan(2);
+
+	OrderBookBook book;
+	EXPECT_EQ(book.apply(snap), BookUpdate::Applied);
+	EXPECT_EQ(book.quantity(Side::Yes, 42), 25);
+	EXPECT_EQ(book.quantity(Side::No, 57), 3);
+	EXPECT_EQ(book.level_count(Side::No), 1u);
+}
@@ -0,0 +1,201 @@
+// Unit tests for PortfolioState: fills, order acks and snapshots applied
+// offline, and torn-read freedom of the lock-free exposure read.
+
+#include "kalshi/portfolio_state.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace {
+
+kalshi::PortfolioStateConfig offline_config() {
+	kalshi::PortfolioStateConfig config;
+	config.reconcile_interval = std::chrono::milliseconds{0};
+	config.max_markets = 64;
+	return config;
+}
+
+kalshi::WsFill fill(const char* order_id, kalshi::Side side, kalshi::Action action,
+					std::int32_t count, std::int32_t yes_price) {
+	kalshi::WsFill f;
+	f.market_ticker = "KXBTC";
+	f.order_id = order_id;
+	f.side = side;
+	f.action = action;
+	f.count = count;
+	f.yes_price = yes_price;
+	f.no_price = 100 - yes_price;
+	return f;
+}
+
+kalshi::Order ack(const char* order_id, kalshi::Side side, kalshi::Action action,
+				  std::int32_t remaining, std::int32_t filled,
+				  kalshi::OrderStatus status = kalshi::OrderStatus::Open) {
+	kalshi::Order o;
+	o.order_id = order_id;
+	o.market_ticker = "KXBTC";
+	o.side = side;
+	o.action = action;
+	o.remaining_count = remaining;
+	o.filled_count = filled;
+	o.status = status;
+	return o;
+}
+
+} // namespace
+
+using kalshi::Action;
+using kalshi::Side;
+
+TEST(PortfolioState, FillsMovePositionAndCash) {
+	kalshi::PortfolioState state(offline_config());
+	EXPECT_FALSE(state.exposure("KXBTC").has_value());
+
+	state.on_fill(fill("a", Side::Yes, Action::Buy, 10, 40));
+	ASSERT_TRUE(state.exposure("KXBTC").has_value());
+	EXPECT_EQ(state.exposure("KXBTC")->position, 10);
+	EXPECT_EQ(state.cash_cents(), -400);
+
+	// Buying NO against a YES position closes it at the YES price.
+	state.on_fill(fill("b", Side::No, Action::Buy, 4, 45));
+	EXPECT_EQ(state.exposure("KXBTC")->position, 6);
+	EXPECT_EQ(state.cash_cents(), -400 + 4 * 45);
+
+	// Selling past flat opens NO exposure for the remainder.
+	state.on_fill(fill("c", Side::Yes, Action::Sell, 8, 50));
+	EXPECT_EQ(state.exposure("KXBTC")->position, -2);
+	EXPECT_EQ(state.cash_cents(), -400 + 180 + 6 * 50 - 2 * 50);
+	EXPECT_EQ(state.stats().fills, 3u);
+}
+
+TEST(PortfolioState, AcksSetRestingQuantities) {
+	kalshi::PortfolioState state(offline_config());
+	state.on_order(ack("a", Side::Yes, Action::Buy, 10, 0));
+	state.on_order(ack("b", Side::Yes, Action::Sell, 5, 0));
+	kalshi::MarketExposure e = *state.exposure("KXBTC");
+	EXPECT_EQ(e.resting_yes, 10);
+	EXPECT_EQ(e.resting_no, 5);
+
+	state.on_fill(fill("a", Side::Yes, Action::Buy, 3, 40));
+	e = *state.exposure("KXBTC");
+	EXPECT_EQ(e.position, 3);
+	EXPECT_EQ(e.resting_yes, 7);
+	EXPECT_EQ(e.max_yes(), 10);
+	EXPECT_EQ(e.max_no(), 2);
+
+	// An ack that already counts the fill does not subtract it twice.
+	state.on_order(ack("a", Side::Yes, Action::Buy, 7, 3));
+	EXPECT_EQ(state.exposure("KXBTC")->resting_yes, 7);
+
+	state.on_order(ack("b", Side::Yes, Action::Sell, 0, 0, kalshi::OrderStatus::Cancelled));
+	EXPECT_EQ(state.exposure("KXBTC")->resting_no, 0);
+	EXPECT_EQ(state.stats().orders, 4u);
+}
+
+TEST(PortfolioState, FillBeforeAckIsNotLost) {
+	kalshi::PortfolioState state(offline_config());
+	state.on_fill(fill("a", Side::No, Action::Buy, 2, 30));
+	EXPECT_EQ(state.exposure("KXBTC")->resting_no, 0);
+
+	// The create ack was built before the fill.
+	state.on_order(ack("a", Side::No, Action::Buy, 10, 0));
+	const kalshi::MarketExposure e = *state.exposure("KXBTC");
+	EXPECT_EQ(e.position, -2);
+	EXPECT_EQ(e.resting_no, 8);
+}
+
+TEST(PortfolioState, ResetInstallsSnapshot) {
+	kalshi::PortfolioState state(offline_config());
+	state.on_fill(fill("a", Side::Yes, Action::Buy, 10, 40));
+
+	kalshi::PortfolioSnapshot snapshot;
+	snapshot.balance.balance = 5000;
+	kalshi::Position position;
+	position.market_ticker = "KXBTC";
+	position.yes_contracts = 7;
+	snapshot.positions.push_back(position);
+	snapshot.orders.push_back(ack("r", Side::No, Action::Buy, 4, 1));
+	snapshot.orders.push_back(ack("gone", Side::Yes, Action::Buy, 0, 5));
+	state.reset(snapshot);
+
+	const kalshi::MarketExposure e = *state.exposure("KXBTC");
+	EXPECT_EQ(e.position, 7);
+	EXPECT_EQ(e.resting_yes, 0);
+	EXPECT_EQ(e.resting_no, 4);
+	EXPECT_EQ(state.cash_cents(), 5000);
+	EXPECT_EQ(state.stats().reconciles, 1u);
+	EXPECT_EQ(state.stats().corrections, 1u);
+
+	// Fills after the snapshot build on it.
+	state.on_fill(fill("r", Side::No, Action::Buy, 1, 40));
+	EXPECT_EQ(state.exposure("KXBTC")->resting_no, 3);
+	EXPECT_EQ(state.cash_cents(), 5000 + 40);
+}
+
+TEST(PortfolioState, SnapshotReproducesExposure) {
+	kalshi::PortfolioState state(offline_config());
+	state.on_order(ack("a", Side::Yes, Action::Buy, 10, 0));
+	state.on_order(ack("b", Side::Yes, Action::Sell, 5, 0));
+	state.on_fill(fill("a", Side::Yes, Action::Buy, 3, 40));
+
+	const kalshi::PortfolioSnapshot snapshot = state.snapshot();
+	EXPECT_EQ(snapshot.balance.balance, state.cash_cents());
+	ASSERT_EQ(snapshot.positions.size(), 1u);
+	EXPECT_EQ(snapshot.positions[0].yes_contracts, 3);
+	EXPECT_EQ(snapshot.orders.size(), 2u);
+
+	kalshi::PortfolioState copy(offline_config());
+	copy.reset(snapshot);
+	const kalshi::MarketExposure want = *state.exposure("KXBTC");
+	const kalshi::MarketExposure got = *copy.exposure("KXBTC");
+	EXPECT_EQ(got.position, want.position);
+	EXPECT_EQ(got.resting_yes, want.resting_yes);
+	EXPECT_EQ(got.resting_no, want.resting_no);
+	EXPECT_EQ(copy.cash_cents(), state.cash_cents());
+}
+
+TEST(PortfolioState, MarketsPastCapacityAreDropped) {
+	kalshi::PortfolioStateConfig config = offline_config();
+	config.max_markets = 1;
+	kalshi::PortfolioState state(config);
+	state.on_fill(fill("a", Side::Yes, Action::Buy, 1, 40));
+	kalshi::WsFill other = fill("b", Side::Yes, Action::Buy, 1, 40);
+	other.market_ticker = "KXETH";
+	state.on_fill(other);
+	EXPECT_EQ(state.exposure("KXBTC")->position, 1);
+	EXPECT_EQ(state.exposure("KXETH")->position, 0);
+	EXPECT_EQ(state.stats().dropped, 1u);
+}
+
+TEST(PortfolioState, ReconcileWithoutClientFails) {
+	kalshi::PortfolioState state(offline_config());
+	EXPECT_FALSE(state.reconcile().has_value());
+}
+
+TEST(PortfolioState, ReadsNeverSeeTornUpdates) {
+	kalshi::PortfolioState state(offline_config());
+	const kalshi::TickerId id = state.ticker_table()->intern("KXBTC");
+	constexpr std::int32_t kOrder = 100000;
+	state.on_order(ack("a", Side::Yes, Action::Buy, kOrder, 0));
+
+	std::atomic<bool> done{false};
+	std::atomic<int> torn{0};
+	std::thread reader([&] {
+		while (!done.load(std::memory_order_relaxed)) {
+			const kalshi::MarketExposure e = state.exposure(id);
+			if (e.max_yes() != kOrder) {
+				torn.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	});
+	for (std::int32_t i = 0; i < kOrder; ++i) {
+		state.on_fill(fill("a", Side::Yes, Action::Buy, 1, 40));
+	}
+	done.store(true, std::memory_order_relaxed);
+	reader.join();
+
+	EXPECT_EQ(torn.load(), 0);
+	EXPECT_EQ(state.exposure(id).position, kOrder);
+	EXPECT_EQ(state.exposure(id).resting_yes, 0);
+}
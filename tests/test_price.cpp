@@ -0,0 +1,88 @@
+// Unit tests for the fixed-point Price / Quantity types: parsing,
+// formatting, rounding to cents and contracts, and constexpr use.
+
+#include "kalshi/models/price.hpp"
+
+#include <gtest/gtest.h>
+#include <string_view>
+
+using kalshi::Price;
+using kalshi::Quantity;
+
+namespace {
+
+std::string_view format(const Price& price, char* buf) {
+	return {buf, static_cast<std::size_t>(price.format_to(buf) - buf)};
+}
+
+} // namespace
+
+// Usable in constant expressions, so price limits can be compile-time constants.
+static_assert(Price::parse("0.4250")->ticks() == 4250);
+static_assert(Price::from_cents(99).ticks() == 9900);
+static_assert(Price::from_ticks(4250).cents() == 43);
+static_assert(Quantity::parse("40.00")->contracts() == 40);
+
+TEST(Price, ParsesWireShapes) {
+	EXPECT_EQ(Price::parse("0.3200"), Price::from_cents(32));
+	EXPECT_EQ(Price::parse("0.32"), Price::from_cents(32));
+	EXPECT_EQ(Price::parse("1"), Price::from_cents(100));
+	EXPECT_EQ(Price::parse(".5"), Price::from_cents(50));
+	EXPECT_EQ(Price::parse("-0.0100"), Price::from_cents(-1));
+	EXPECT_EQ(Price::parse("0.4250")->ticks(), 4250);
+	// Past the tick, round half away from zero on the first dropped digit.
+	EXPECT_EQ(Price::parse("0.42505")->ticks(), 4251);
+	EXPECT_EQ(Price::parse("0.42504")->ticks(), 4250);
+	EXPECT_EQ(Price::parse("-0.00005")->ticks(), -1);
+}
+
+TEST(Price, RejectsMalformed) {
+	EXPECT_FALSE(Price::parse("").has_value());
+	EXPECT_FALSE(Price::parse("-").has_value());
+	EXPECT_FALSE(Price::parse(".").has_value());
+	EXPECT_FALSE(Price::parse("0.42a").has_value());
+	EXPECT_FALSE(Price::parse("\"0.42\"").has_value());
+	EXPECT_FALSE(Price::parse("99999999999999999999").has_value());
+}
+
+TEST(Price, CentsRoundHalfAwayFromZero) {
+	EXPECT_EQ(Price::from_ticks(4249).cents(), 42);
+	EXPECT_EQ(Price::from_ticks(4250).cents(), 43);
+	EXPECT_EQ(Price::from_ticks(-4250).cents(), -43);
+	EXPECT_TRUE(Price::from_ticks(4200).whole_cents());
+	EXPECT_FALSE(Price::from_ticks(4250).whole_cents());
+}
+
+TEST(Price, FormatsFourDecimals) {
+	char buf[Price::kMaxChars];
+	EXPECT_EQ(format(Price::from_cents(33), buf), "0.3300");
+	EXPECT_EQ(format(Price::from_ticks(4250), buf), "0.4250");
+	EXPECT_EQ(format(Price::from_ticks(7), buf), "0.0007");
+	EXPECT_EQ(format(Price::from_cents(-150), buf), "-1.5000");
+	EXPECT_EQ(format(Price{}, buf), "0.0000");
+	EXPECT_EQ(format(Price::from_ticks(INT64_MIN), buf), "-922337203685477.5808");
+	EXPECT_EQ(Price::from_cents(1).to_string(), "0.0100");
+}
+
+TEST(Price, RoundTripsThroughText) {
+	char buf[Price::kMaxChars];
+	for (std::int64_t ticks = -10'000; ticks <= 10'000; ticks += 37) {
+		const Price price = Price::from_ticks(ticks);
+		EXPECT_EQ(Price::parse(format(price, buf)), price) << ticks;
+	}
+}
+
+TEST(Quantity, ParsesAndFormats) {
+	EXPECT_EQ(Quantity::parse("40.00"), Quantity::from_contracts(40));
+	EXPECT_EQ(Quantity::parse("-30.87")->units(), -3087);
+	EXPECT_EQ(Quantity::parse("-30.87")->contracts(), -31);
+	EXPECT_EQ(Quantity::parse("2.49")->contracts(), 2);
+	EXPECT_EQ(Quantity::parse("2.50")->contracts(), 3);
+	EXPECT_FALSE(Quantity::parse("x").has_value());
+
+	char buf[Quantity::kMaxChars];
+	const Quantity q = Quantity::from_units(1050);
+	EXPECT_EQ(std::string_view(buf, static_cast<std::size_t>(q.format_to(buf) - buf)), "10.50");
+	EXPECT_EQ(Quantity::from_contracts(3).to_string(), "3.00");
+	EXPECT_EQ((Quantity::from_contracts(3) - Quantity::from_units(50)).units(), 250);
+}
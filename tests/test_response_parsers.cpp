@@ -169,6 +169,30 @@ TEST(ResponseParsers, OrderbooksParseBatchedResponse) {
 	EXPECT_EQ(books[1].no_bids[0].quantity, 3);
 }
 
+TEST(ResponseParsers, ForEachOrderbookStreamsAndStops) {
+	const std::string body = R"json({"orderbooks": [
+		{"ticker": "A", "orderbook_fp": {"yes_dollars": [["0.1000", "1.00"]], "no_dollars": []}},
+		{"ticker": "B", "orderbook_fp": {"yes_dollars": [], "no_dollars": [["0.2000", "2.00"]]}},
+		{"ticker": "C", "orderbook_fp": {"yes_dollars": [], "no_dollars": []}}
+	]})json";
+
+	std::vector<std::string> seen;
+	const std::size_t delivered =
+		kalshi::api_detail::for_each_orderbook(body, [&](const kalshi::OrderBook& book) {
+			seen.push_back(book.market_ticker);
+			return book.market_ticker != "B";
+		});
+	EXPECT_EQ(delivered, 2U);
+	EXPECT_EQ(seen, (std::vector<std::string>{"A", "B"}));
+
+	EXPECT_EQ(kalshi::api_detail::for_each_orderbook(R"({"orderbooks": []})",
+													 [](const kalshi::OrderBook&) { return true; }),
+			  0U);
+	EXPECT_EQ(kalshi::api_detail::for_each_orderbook(R"({"error": "x"})",
+													 [](const kalshi::OrderBook&) { return true; }),
+			  0U);
+}
+
 TEST(ResponseParsers, MarketParsesCurrentLifecycleAndSettlementFields) {
 	const std::string body = R"json({
 		"market": {
@@ -225,6 +249,39 @@ TEST(ResponseParsers, MarketParsesCurrentLifecycleAndSettlementFields) {
 	EXPECT_EQ(*market.result, "yes");
 }
 
+TEST(ResponseParsers, MarketKeepsSubCentQuotes) {
+	const std::string body = R"json({
+		"market": {
+			"ticker": "KXBTCD-26MAY19-T100",
+			"yes_bid_dollars": "0.4250",
+			"yes_ask_dollars": "0.4260",
+			"no_bid": 57,
+			"no_ask_dollars": "0.5750"
+		}
+	})json";
+
+	const kalshi::Market market = kalshi::api_detail::parse_market_response(body);
+
+	EXPECT_EQ(market.yes_bid_dollars.ticks(), 4250);
+	EXPECT_EQ(market.yes_ask_dollars.ticks(), 4260);
+	EXPECT_EQ(market.no_bid_dollars, kalshi::Price::from_cents(57));
+	EXPECT_EQ(market.no_ask_dollars.ticks(), 5750);
+	EXPECT_EQ(market.yes_bid, 43);
+	EXPECT_EQ(market.yes_ask, 43);
+	EXPECT_EQ(market.no_bid, 57);
+	EXPECT_EQ(market.no_ask, 58);
+}
+
+TEST(ResponseParsers, MarketRejectsOutOfRangeMonth) {
+	// Found by fuzz_array_stream: month 14 used to index past the
+	// days-in-month table.
+	const kalshi::Market market = kalshi::api_detail::parse_market_object(
+		R"({"ticker":"KXA","open_time":"2026-14-01T00:00:00Z",)"
+		R"("close_time":"2026-00-01T00:00:00Z"})");
+	EXPECT_EQ(market.open_time, 0);
+	EXPECT_EQ(market.close_time, 0);
+}
+
 TEST(ResponseParsers, MarketsParseUnopenedArray) {
 	const std::string body = R"json({
 		"markets": [
@@ -243,6 +300,44 @@ TEST(ResponseParsers, MarketsParseUnopenedArray) {
 	EXPECT_EQ(markets[1].status, kalshi::MarketStatus::Open);
 }
 
+TEST(ResponseParsers, MarketsParseOnlyMaskedFields) {
+	const std::string body = R"json({
+		"markets": [
+			{"ticker": "A", "title": "Alpha", "status": "open",
+			 "close_time": "2023-11-08T05:31:56Z", "yes_bid_dollars": "0.4200",
+			 "yes_ask_dollars": "0.4400", "volume": 1000, "result": "yes"}
+		],
+		"cursor": ""
+	})json";
+	constexpr kalshi::MarketFields fields{kalshi::MarketField::Ticker, kalshi::MarketField::YesBid,
+										  kalshi::MarketField::YesAsk};
+
+	const std::vector<kalshi::Market> markets =
+		kalshi::api_detail::parse_markets_response(body, fields);
+
+	ASSERT_EQ(markets.size(), 1U);
+	EXPECT_EQ(markets[0].ticker, "A");
+	EXPECT_EQ(markets[0].yes_bid, 42);
+	EXPECT_EQ(markets[0].yes_ask, 44);
+	EXPECT_TRUE(markets[0].title.empty());
+	EXPECT_EQ(markets[0].close_time, 0);
+	EXPECT_EQ(markets[0].volume, 0);
+	EXPECT_FALSE(markets[0].result.has_value());
+}
+
+TEST(ResponseParsers, FieldMaskSetOperations) {
+	constexpr kalshi::TradeFields prices{kalshi::TradeField::YesPrice, kalshi::TradeField::NoPrice};
+	constexpr kalshi::TradeFields with_count =
+		prices | kalshi::TradeFields{kalshi::TradeField::Count};
+
+	static_assert(prices.has(kalshi::TradeField::YesPrice));
+	static_assert(!prices.has(kalshi::TradeField::Count));
+	static_assert(with_count.has(kalshi::TradeField::Count));
+	static_assert(kalshi::TradeFields::all().has(kalshi::TradeField::IsBlockTrade));
+	static_assert(kalshi::TradeFields{}.bits() == 0);
+	EXPECT_NE(prices, with_count);
+}
+
 TEST(ResponseParsers, TradesParseBlockTradeFlag) {
 	// Kalshi 2026-05-29: public trade responses flag block trades via the
 	// new boolean ``is_block_trade``. First row carries it true; second row
@@ -270,6 +365,30 @@ TEST(ResponseParsers, TradesParseBlockTradeFlag) {
 	EXPECT_FALSE(trades[1].is_block_trade);
 }
 
+TEST(ResponseParsers, TradesParseOnlyMaskedFields) {
+	const std::string body = R"json({
+		"trades": [
+			{"trade_id": "t1", "ticker": "KXHIGHDEN-26JUN03-B80", "yes_price": 42,
+			 "no_price": 58, "count": 10, "taker_side": "no",
+			 "created_time": 1780000000, "is_block_trade": true}
+		],
+		"cursor": ""
+	})json";
+	constexpr kalshi::TradeFields fields{kalshi::TradeField::YesPrice, kalshi::TradeField::Count};
+
+	const std::vector<kalshi::PublicTrade> trades =
+		kalshi::api_detail::parse_trades_response(body, fields);
+
+	ASSERT_EQ(trades.size(), 1U);
+	EXPECT_EQ(trades[0].yes_price, 42);
+	EXPECT_EQ(trades[0].count, 10);
+	EXPECT_TRUE(trades[0].trade_id.empty());
+	EXPECT_TRUE(trades[0].market_ticker.empty());
+	EXPECT_EQ(trades[0].no_price, 0);
+	EXPECT_EQ(trades[0].created_time, 0);
+	EXPECT_FALSE(trades[0].is_block_trade);
+}
+
 TEST(ResponseParsers, DepositsParseFinalizedAndPending) {
 	const std::string body = R"json({
 		"deposits": [
@@ -428,6 +547,23 @@ TEST(ResponseParsers, BatchOrderCancelResultParsesV2Errors) {
 	EXPECT_EQ(results[1].error->service, "matching_engine");
 }
 
+TEST(ResponseParsers, BatchCreateErrorsInRequestOrder) {
+	const std::string body = R"json({
+		"orders": [
+			{"client_order_id": "a", "order": {"order_id": "order-1", "ticker": "T"}},
+			{"client_order_id": "b", "error": {"code": "insufficient_balance",
+				"message": "not enough balance"}},
+			{"client_order_id": "c", "error": {"code": "market_closed"}}
+		]
+	})json";
+
+	const std::vector<std::string> errors = kalshi::api_detail::parse_batch_create_errors(body);
+
+	ASSERT_EQ(errors.size(), 2U);
+	EXPECT_EQ(errors[0], "not enough balance");
+	EXPECT_EQ(errors[1], "market_closed");
+}
+
 TEST(ResponseParsers, AccountApiLimitsParseReadWriteBuckets) {
 	const std::string body = R"json({
 		"usage_tier": "advanced",
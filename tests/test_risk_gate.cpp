@@ -0,0 +1,156 @@
+// Unit tests for RiskGate: limit lookup, clipping, price band, self-cross
+// and position checks against a PortfolioState.
+
+#include "kalshi/risk_gate.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace {
+
+using Verdict = kalshi::RiskDecision::Verdict;
+
+kalshi::CreateOrderParams buy_yes(const char* ticker, std::int32_t count, std::int32_t cents) {
+	kalshi::CreateOrderParams params;
+	params.ticker = ticker;
+	params.side = kalshi::Side::Yes;
+	params.action = kalshi::Action::Buy;
+	params.count = count;
+	params.yes_price = cents;
+	return params;
+}
+
+} // namespace
+
+TEST(RiskGate, NoLimitsAccepts) {
+	kalshi::RiskGate gate;
+	const kalshi::RiskDecision d = gate.check(buy_yes("KXBTC-26-T1", 1000, 50));
+	EXPECT_EQ(d.verdict, Verdict::Accept);
+	EXPECT_EQ(d.count, 1000);
+
+	kalshi::CreateOrderParams unpriced = buy_yes("KXBTC-26-T1", 1, 50);
+	unpriced.yes_price.reset();
+	EXPECT_EQ(gate.check(unpriced).reason, kalshi::RiskReason::NoPrice);
+	unpriced.type = "market";
+	EXPECT_TRUE(gate.check(unpriced).accepted());
+}
+
+TEST(RiskGate, TickerOverridesSeriesOverridesDefaults) {
+	kalshi::RiskGate gate(
+		{.defaults = {.max_order_contracts = 100}, .portfolio = nullptr, .tickers = nullptr});
+	ASSERT_TRUE(gate.set_series_limits("KXBTC", {.max_order_contracts = 10}).has_value());
+	ASSERT_TRUE(gate.set_limits("KXBTC-26-T2", {.max_order_contracts = 5}).has_value());
+
+	EXPECT_EQ(gate.check(buy_yes("KXETH-26-T1", 50, 50)).count, 50);
+	EXPECT_EQ(gate.check(buy_yes("KXBTC-26-T1", 50, 50)).count, 10);
+	EXPECT_EQ(gate.check(buy_yes("KXBTC-26-T2", 50, 50)).count, 5);
+
+	// A series change reaches markets that were already checked.
+	ASSERT_TRUE(gate.set_series_limits("KXBTC", {.max_order_contracts = 20}).has_value());
+	EXPECT_EQ(gate.check(buy_yes("KXBTC-26-T1", 50, 50)).count, 20);
+	EXPECT_EQ(gate.check(buy_yes("KXBTC-26-T2", 50, 50)).count, 5);
+}
+
+TEST(RiskGate, ClipOrReject) {
+	kalshi::RiskGate gate(
+		{.defaults = {.max_order_notional_cents = 1000}, .portfolio = nullptr, .tickers = nullptr});
+	// $10 buys 25 contracts at 40c.
+	kalshi::RiskDecision d = gate.check(buy_yes("A", 100, 40));
+	EXPECT_EQ(d.verdict, Verdict::Clip);
+	EXPECT_EQ(d.reason, kalshi::RiskReason::Notional);
+	EXPECT_EQ(d.count, 25);
+
+	// Selling YES costs the NO price.
+	kalshi::CreateOrderParams sell = buy_yes("A", 100, 40);
+	sell.action = kalshi::Action::Sell;
+	EXPECT_EQ(gate.check(sell).count, 16);
+
+	ASSERT_TRUE(
+		gate.set_limits("B", {.max_order_notional_cents = 1000, .clip = false}).has_value());
+	d = gate.check(buy_yes("B", 100, 40));
+	EXPECT_EQ(d.verdict, Verdict::Reject);
+	EXPECT_EQ(d.count, 0);
+
+	gate.set_halted(true);
+	EXPECT_EQ(gate.check(buy_yes("A", 1, 40)).reason, kalshi::RiskReason::Halted);
+	EXPECT_EQ(gate.stats().checked, 4u);
+	EXPECT_EQ(gate.stats().clipped, 2u);
+	EXPECT_EQ(gate.stats().rejected, 2u);
+}
+
+TEST(RiskGate, PriceThroughTheMarket) {
+	kalshi::RiskGate gate({.defaults = {.max_price_through = kalshi::Price::from_cents(5)},
+						   .portfolio = nullptr,
+						   .tickers = nullptr});
+	const kalshi::TickerId id = gate.ticker_table()->intern("A");
+	gate.on_quote(id, kalshi::Price::from_cents(40), kalshi::Price::from_cents(45));
+
+	EXPECT_TRUE(gate.check(buy_yes("A", 1, 50)).accepted());
+	EXPECT_EQ(gate.check(buy_yes("A", 1, 51)).reason, kalshi::RiskReason::PriceThrough);
+
+	// Buying NO at 70c is a YES ask at 30c, 10c under the bid.
+	kalshi::CreateOrderParams buy_no;
+	buy_no.ticker = "A";
+	buy_no.side = kalshi::Side::No;
+	buy_no.count = 1;
+	buy_no.no_price = 70;
+	EXPECT_EQ(gate.check(buy_no).reason, kalshi::RiskReason::PriceThrough);
+	buy_no.no_price = 64;
+	EXPECT_TRUE(gate.check(buy_no).accepted());
+
+	// An empty side does not constrain.
+	gate.on_quote(id, kalshi::Price::from_cents(40), std::nullopt);
+	EXPECT_TRUE(gate.check(buy_yes("A", 1, 99)).accepted());
+}
+
+TEST(RiskGate, SelfCross) {
+	kalshi::RiskGate gate;
+	kalshi::Order ask;
+	ask.order_id = "o1";
+	ask.market_ticker = "A";
+	ask.side = kalshi::Side::Yes;
+	ask.action = kalshi::Action::Sell;
+	ask.price = 55;
+	ask.remaining_count = 3;
+	ask.status = kalshi::OrderStatus::Open;
+	gate.on_order(ask);
+
+	EXPECT_TRUE(gate.check(buy_yes("A", 1, 54)).accepted());
+	EXPECT_EQ(gate.check(buy_yes("A", 1, 55)).reason, kalshi::RiskReason::SelfCross);
+
+	ask.status = kalshi::OrderStatus::Cancelled;
+	gate.on_order(ask);
+	EXPECT_TRUE(gate.check(buy_yes("A", 1, 55)).accepted());
+}
+
+TEST(RiskGate, PositionLimitCountsRestingOrders) {
+	std::shared_ptr<kalshi::PortfolioState> portfolio = std::make_shared<kalshi::PortfolioState>(
+		kalshi::PortfolioStateConfig{.reconcile_interval = std::chrono::milliseconds{0},
+									 .tickers = nullptr});
+	kalshi::RiskGate gate(
+		{.defaults = {.max_position = 10}, .portfolio = portfolio, .tickers = nullptr});
+	EXPECT_EQ(gate.ticker_table(), portfolio->ticker_table());
+
+	kalshi::WsFill fill;
+	fill.market_ticker = "A";
+	fill.count = 4;
+	fill.yes_price = 40;
+	fill.no_price = 60;
+	portfolio->on_fill(fill);
+	kalshi::Order resting;
+	resting.order_id = "o1";
+	resting.market_ticker = "A";
+	resting.remaining_count = 3;
+	resting.status = kalshi::OrderStatus::Open;
+	portfolio->on_order(resting);
+
+	const kalshi::RiskDecision d = gate.check(buy_yes("A", 10, 40));
+	EXPECT_EQ(d.verdict, Verdict::Clip);
+	EXPECT_EQ(d.reason, kalshi::RiskReason::Position);
+	EXPECT_EQ(d.count, 3);
+
+	// NO exposure has its own room: 10 plus the 4 YES it would close.
+	kalshi::CreateOrderParams buy_no = buy_yes("A", 20, 40);
+	buy_no.side = kalshi::Side::No;
+	EXPECT_EQ(gate.check(buy_no).count, 14);
+}
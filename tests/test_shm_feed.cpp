@@ -0,0 +1,165 @@
+// Unit tests for the shared-memory feed: a ShmFeedWriter and
+// ShmFeedReaders attached to the same segment within one process.
+
+#include "kalshi/shm_feed.hpp"
+
+#include <array>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+std::string segment_name(const char* suffix) {
+	return "/kalshi-test-" + std::to_string(::getpid()) + "-" + suffix;
+}
+
+kalshi::WsEvent delta(std::int32_t seq, std::int32_t quantity) {
+	kalshi::WsEvent event;
+	event.kind = kalshi::WsEventKind::Delta;
+	event.sid = 2;
+	event.seq = seq;
+	event.ticker_id = kalshi::TickerId{1};
+	event.price = 42;
+	event.quantity = quantity;
+	return event;
+}
+
+} // namespace
+
+TEST(ShmFeed, ReaderSeesEventsPublishedAfterOpen) {
+	const std::string name = segment_name("events");
+	kalshi::Result<kalshi::ShmFeedWriter> writer =
+		kalshi::ShmFeedWriter::create({.name = name, .event_capacity = 8, .max_markets = 4});
+	ASSERT_TRUE(writer.has_value()) << writer.error().message;
+	writer->publish(delta(1, 5));
+
+	kalshi::Result<kalshi::ShmFeedReader> reader = kalshi::ShmFeedReader::open(name);
+	ASSERT_TRUE(reader.has_value()) << reader.error().message;
+	EXPECT_TRUE(reader->publisher_alive());
+
+	std::array<kalshi::WsEvent, 4> out{};
+	EXPECT_EQ(reader->poll(out), 0u);
+	writer->publish(delta(2, 6));
+	writer->publish(delta(3, -7));
+	ASSERT_EQ(reader->poll(out), 2u);
+	EXPECT_EQ(out[0].seq, 2);
+	EXPECT_EQ(out[1].quantity, -7);
+	EXPECT_EQ(out[1].ticker_id, kalshi::TickerId{1});
+	EXPECT_EQ(reader->poll(out), 0u);
+	EXPECT_EQ(reader->stats().received, 2u);
+
+	writer = std::unexpected(kalshi::Error::parse("closed"));
+	EXPECT_FALSE(reader->publisher_alive());
+	EXPECT_FALSE(kalshi::ShmFeedReader::open(name).has_value());
+}
+
+TEST(ShmFeed, LappedReaderCountsOverruns) {
+	const std::string name = segment_name("overrun");
+	kalshi::Result<kalshi::ShmFeedWriter> writer =
+		kalshi::ShmFeedWriter::create({.name = name, .event_capacity = 8, .max_markets = 4});
+	ASSERT_TRUE(writer.has_value());
+	kalshi::Result<kalshi::ShmFeedReader> reader = kalshi::ShmFeedReader::open(name);
+	ASSERT_TRUE(reader.has_value());
+
+	for (std::int32_t seq = 1; seq <= 20; ++seq) {
+		writer->publish(delta(seq, 1));
+	}
+	std::array<kalshi::WsEvent, 32> out{};
+	const std::size_t n = reader->poll(out);
+	ASSERT_EQ(n, 7u);
+	EXPECT_EQ(out[0].seq, 14);
+	EXPECT_EQ(out[n - 1].seq, 20);
+	EXPECT_EQ(reader->stats().overruns, 13u);
+}
+
+TEST(ShmFeed, TopOfBookAndTickerNames) {
+	const std::string name = segment_name("book");
+	kalshi::Result<kalshi::ShmFeedWriter> writer =
+		kalshi::ShmFeedWriter::create({.name = name, .event_capacity = 8, .max_markets = 4});
+	ASSERT_TRUE(writer.has_value());
+	kalshi::Result<kalshi::ShmFeedReader> reader = kalshi::ShmFeedReader::open(name);
+	ASSERT_TRUE(reader.has_value());
+
+	const kalshi::TickerId id{3};
+	EXPECT_FALSE(reader->top_of_book(id).has_value());
+	EXPECT_FALSE(reader->top_of_book(kalshi::TickerId{9}).has_value());
+
+	EXPECT_TRUE(writer->register_ticker(id, "KXBTC"));
+	EXPECT_TRUE(writer->register_ticker(id, "IGNORED"));
+	EXPECT_EQ(reader->ticker_name(id), "KXBTC");
+	const std::string too_long(kalshi::kShmMaxTickerName + 1, 'X');
+	EXPECT_FALSE(writer->register_ticker(kalshi::TickerId{1}, too_long));
+	EXPECT_TRUE(reader->ticker_name(kalshi::TickerId{1}).empty());
+	EXPECT_TRUE(writer->register_ticker(kalshi::TickerId{1}, too_long.substr(1)));
+	EXPECT_EQ(reader->ticker_name(kalshi::TickerId{1}).size(), kalshi::kShmMaxTickerName);
+	EXPECT_EQ(reader->find("KXBTC"), id);
+	EXPECT_FALSE(reader->find("KXETH").has_value());
+
+	kalshi::OrderBookBook book(kalshi::SeqCheck::Monotonic);
+	kalshi::OrderbookSnapshot snapshot;
+	snapshot.seq = 10;
+	snapshot.yes = {{40, 100}, {45, 20}};
+	snapshot.no = {{50, 7}};
+	book.apply(snapshot);
+	writer->update_book(id, book);
+
+	std::optional<kalshi::TopOfBook> top = reader->top_of_book(id);
+	ASSERT_TRUE(top.has_value());
+	EXPECT_TRUE(top->valid);
+	EXPECT_EQ(top->yes_bid.price_cents, 45);
+	EXPECT_EQ(top->yes_bid.quantity, 20);
+	EXPECT_EQ(top->no_bid.price_cents, 50);
+	EXPECT_EQ(top->seq, 10);
+	EXPECT_EQ(top->version, 1u);
+	EXPECT_GT(top->updated_ns, 0);
+
+	book.clear();
+	writer->update_book(id, book);
+	top = reader->top_of_book(id);
+	ASSERT_TRUE(top.has_value());
+	EXPECT_FALSE(top->valid);
+	EXPECT_EQ(top->yes_bid.quantity, 0);
+	EXPECT_EQ(top->version, 2u);
+}
+
+TEST(ShmFeed, ConcurrentReaderNeverSeesTornEvents) {
+	const std::string name = segment_name("torn");
+	kalshi::Result<kalshi::ShmFeedWriter> writer =
+		kalshi::ShmFeedWriter::create({.name = name, .event_capacity = 16, .max_markets = 1});
+	ASSERT_TRUE(writer.has_value());
+	kalshi::Result<kalshi::ShmFeedReader> reader = kalshi::ShmFeedReader::open(name);
+	ASSERT_TRUE(reader.has_value());
+
+	constexpr std::int32_t kEvents = 200'000;
+	std::atomic<bool> done{false};
+	std::thread producer([&] {
+		for (std::int32_t seq = 1; seq <= kEvents; ++seq) {
+			writer->publish(delta(seq, seq));
+		}
+		done.store(true, std::memory_order_release);
+	});
+
+	std::array<kalshi::WsEvent, 8> out{};
+	std::int32_t last = 0;
+	bool ordered = true;
+	for (;;) {
+		const bool finished = done.load(std::memory_order_acquire);
+		const std::size_t n = reader->poll(out);
+		for (std::size_t i = 0; i < n; ++i) {
+			// Every field comes from the same publish, in order.
+			ordered = ordered && out[i].seq == out[i].quantity && out[i].seq > last;
+			last = out[i].seq;
+		}
+		if (finished && n == 0) {
+			break;
+		}
+	}
+	producer.join();
+	EXPECT_TRUE(ordered);
+	EXPECT_EQ(last, kEvents);
+	EXPECT_EQ(reader->stats().received + reader->stats().overruns,
+			  static_cast<std::uint64_t>(kEvents));
+}
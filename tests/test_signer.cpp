@@ -1,7 +1,15 @@
 #include "kalshi/signer.hpp"
 
+#include <array>
+#include <atomic>
 #include <gtest/gtest.h>
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
 #include <string>
+#include <thread>
+#include <vector>
 
 // Throwaway 2048-bit RSA private key for tests only. Generated via
 // ``openssl genrsa -traditional 2048``. Never used to sign live
@@ -70,3 +78,152 @@ TEST(Signer, SignProducesHeaders) {
 	ASSERT_EQ(headers.timestamp, std::string("1234567890000"));
 	ASSERT_FALSE(headers.signature.empty());
 }
+
+namespace {
+
+// Decode ``b64`` and check it is a valid RSA-PSS/SHA-256 signature of
+// ``message`` under TEST_RSA_KEY.
+bool verifies(const std::string& message, const std::string& b64) {
+	std::vector<unsigned char> sig(b64.size());
+	const int decoded = EVP_DecodeBlock(sig.data(),
+										reinterpret_cast<const unsigned char*>(b64.data()),
+										static_cast<int>(b64.size()));
+	if (decoded < 0) {
+		return false;
+	}
+	std::size_t sig_len = static_cast<std::size_t>(decoded);
+	if (b64.size() >= 2 && b64[b64.size() - 1] == '=') {
+		sig_len -= b64[b64.size() - 2] == '=' ? 2 : 1;
+	}
+
+	BIO* bio = BIO_new_mem_buf(TEST_RSA_KEY, -1);
+	EVP_PKEY* pkey = PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr);
+	BIO_free(bio);
+	EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+	EVP_PKEY_CTX* pkey_ctx = nullptr;
+	bool ok = EVP_DigestVerifyInit(ctx, &pkey_ctx, EVP_sha256(), nullptr, pkey) == 1 &&
+			  EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) == 1 &&
+			  EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, RSA_PSS_SALTLEN_DIGEST) == 1 &&
+			  EVP_DigestVerify(ctx, sig.data(), sig_len,
+							   reinterpret_cast<const unsigned char*>(message.data()),
+							   message.size()) == 1;
+	EVP_MD_CTX_free(ctx);
+	EVP_PKEY_free(pkey);
+	return ok;
+}
+
+std::string encode(std::string_view raw) {
+	std::string out(kalshi::base64_encoded_size(raw.size()), '\0');
+	const std::size_t written = kalshi::base64_encode(
+		std::span(reinterpret_cast<const unsigned char*>(raw.data()), raw.size()),
+		std::span(out.data(), out.size()));
+	out.resize(written);
+	return out;
+}
+
+} // namespace
+
+TEST(Signer, SignatureVerifiesAgainstKey) {
+	kalshi::Result<kalshi::Signer> signer = kalshi::Signer::from_pem("test_key", TEST_RSA_KEY);
+	ASSERT_TRUE(signer.has_value());
+
+	kalshi::Result<kalshi::AuthHeaders> headers =
+		signer->sign_with_timestamp("POST", "/trade-api/v2/portfolio/orders", 1700000000123);
+	ASSERT_TRUE(headers.has_value());
+	EXPECT_TRUE(verifies("1700000000123POST/trade-api/v2/portfolio/orders", headers->signature));
+	EXPECT_FALSE(verifies("1700000000124POST/trade-api/v2/portfolio/orders", headers->signature));
+}
+
+TEST(Signer, SignIntoReusesHeaders) {
+	kalshi::Result<kalshi::Signer> signer = kalshi::Signer::from_pem("test_key", TEST_RSA_KEY);
+	ASSERT_TRUE(signer.has_value());
+
+	kalshi::AuthHeaders headers;
+	ASSERT_TRUE(signer->sign_into("GET", "/a", 1, headers).has_value());
+	ASSERT_TRUE(signer->sign_into("DELETE", "/trade-api/v2/b", 1234567890000, headers).has_value());
+	EXPECT_EQ(headers.access_key, "test_key");
+	EXPECT_EQ(headers.timestamp, "1234567890000");
+	EXPECT_TRUE(verifies("1234567890000DELETE/trade-api/v2/b", headers.signature));
+}
+
+TEST(Signer, ConcurrentSigningVerifies) {
+	kalshi::Result<kalshi::Signer> signer = kalshi::Signer::from_pem("test_key", TEST_RSA_KEY);
+	ASSERT_TRUE(signer.has_value());
+
+	std::atomic<int> failures{0};
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.emplace_back([&, t] {
+			for (int i = 0; i < 8; ++i) {
+				const std::string path = "/p/" + std::to_string(t) + "/" + std::to_string(i);
+				kalshi::Result<kalshi::AuthHeaders> headers =
+					signer->sign_with_timestamp("GET", path, 1000 + i);
+				if (!headers || !verifies(std::to_string(1000 + i) + "GET" + path,
+										  headers->signature)) {
+					++failures;
+				}
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(failures.load(), 0);
+}
+
+TEST(Base64, EncodesRfc4648Vectors) {
+	EXPECT_EQ(encode(""), "");
+	EXPECT_EQ(encode("f"), "Zg==");
+	EXPECT_EQ(encode("fo"), "Zm8=");
+	EXPECT_EQ(encode("foo"), "Zm9v");
+	EXPECT_EQ(encode("foob"), "Zm9vYg==");
+	EXPECT_EQ(encode("fooba"), "Zm9vYmE=");
+	EXPECT_EQ(encode("foobar"), "Zm9vYmFy");
+	EXPECT_EQ(encode("\xff\xfe\xfd"), "//79");
+}
+
+TEST(Base64, RejectsShortBuffer) {
+	const std::array<unsigned char, 3> raw{1, 2, 3};
+	std::array<char, 3> out{};
+	EXPECT_EQ(kalshi::base64_encode(raw, out), 0U);
+}
+
+TEST(PresignedHeaderPool, RefillThenTake) {
+	kalshi::Result<kalshi::Signer> signer = kalshi::Signer::from_pem("test_key", TEST_RSA_KEY);
+	ASSERT_TRUE(signer.has_value());
+
+	kalshi::PresignedHeaderPool pool(*signer, "GET", "/trade-api/ws/v2", 3);
+	EXPECT_EQ(pool.size(), 0U);
+	ASSERT_TRUE(pool.refill().has_value());
+	EXPECT_EQ(pool.size(), 3U);
+
+	kalshi::Result<kalshi::AuthHeaders> headers = pool.take();
+	ASSERT_TRUE(headers.has_value());
+	EXPECT_EQ(pool.size(), 2U);
+	EXPECT_TRUE(verifies(headers->timestamp + "GET/trade-api/ws/v2", headers->signature));
+}
+
+TEST(PresignedHeaderPool, StaleEntriesAreResigned) {
+	kalshi::Result<kalshi::Signer> signer = kalshi::Signer::from_pem("test_key", TEST_RSA_KEY);
+	ASSERT_TRUE(signer.has_value());
+
+	kalshi::PresignedHeaderPool pool(*signer, "GET", "/trade-api/ws/v2", 2,
+									 std::chrono::milliseconds{0});
+	ASSERT_TRUE(pool.refill().has_value());
+
+	// Every entry is already past max_age, so take() signs on demand.
+	kalshi::Result<kalshi::AuthHeaders> headers = pool.take();
+	ASSERT_TRUE(headers.has_value());
+	EXPECT_EQ(pool.size(), 0U);
+	EXPECT_TRUE(verifies(headers->timestamp + "GET/trade-api/ws/v2", headers->signature));
+}
+
+TEST(PresignedHeaderPool, MovedFromReportsError) {
+	kalshi::Result<kalshi::Signer> signer = kalshi::Signer::from_pem("test_key", TEST_RSA_KEY);
+	ASSERT_TRUE(signer.has_value());
+
+	kalshi::PresignedHeaderPool pool(*signer, "GET", "/trade-api/ws/v2");
+	kalshi::PresignedHeaderPool moved = std::move(pool);
+	EXPECT_FALSE(pool.take().has_value());
+	EXPECT_EQ(moved.path(), "/trade-api/ws/v2");
+}
@@ -0,0 +1,81 @@
+#include "kalshi/detail/spsc_ring.hpp"
+
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+using kalshi::detail::SpscRing;
+
+TEST(SpscRing, CapacityRoundsUpToPowerOfTwo) {
+	EXPECT_EQ(SpscRing<int>(0).capacity(), 2u);
+	EXPECT_EQ(SpscRing<int>(5).capacity(), 8u);
+	EXPECT_EQ(SpscRing<int>(1024).capacity(), 1024u);
+}
+
+TEST(SpscRing, PushPopPreservesFifoOrder) {
+	SpscRing<int> ring(4);
+	for (int i = 0; i < 4; ++i) {
+		EXPECT_TRUE(ring.try_push(int{i}));
+	}
+	EXPECT_EQ(ring.size(), 4u);
+	for (int i = 0; i < 4; ++i) {
+		int out = -1;
+		ASSERT_TRUE(ring.try_pop(out));
+		EXPECT_EQ(out, i);
+	}
+	int out = -1;
+	EXPECT_FALSE(ring.try_pop(out));
+}
+
+TEST(SpscRing, FullRingRejectsWithoutConsumingValue) {
+	SpscRing<std::string> ring(2);
+	EXPECT_TRUE(ring.try_push(std::string("a")));
+	EXPECT_TRUE(ring.try_push(std::string("b")));
+	std::string extra = "c";
+	EXPECT_FALSE(ring.try_push(std::move(extra)));
+	EXPECT_EQ(extra, "c");
+}
+
+TEST(SpscRing, PopBulkWrapsAround) {
+	SpscRing<int> ring(4);
+	std::array<int, 4> buf{};
+	for (int round = 0; round < 3; ++round) {
+		for (int i = 0; i < 3; ++i) {
+			ASSERT_TRUE(ring.try_push(round * 10 + i));
+		}
+		ASSERT_EQ(ring.pop_bulk(buf), 3u);
+		EXPECT_EQ(buf[0], round * 10);
+		EXPECT_EQ(buf[2], round * 10 + 2);
+	}
+	EXPECT_EQ(ring.pop_bulk(buf), 0u);
+}
+
+TEST(SpscRing, ConcurrentProducerConsumerSeesEverySequence) {
+	constexpr std::int64_t kCount = 200000;
+	SpscRing<std::int64_t> ring(256);
+
+	std::thread producer([&ring]() {
+		for (std::int64_t i = 0; i < kCount; ++i) {
+			while (!ring.try_push(std::int64_t{i})) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	std::int64_t expected = 0;
+	std::array<std::int64_t, 64> batch{};
+	while (expected < kCount) {
+		const std::size_t n = ring.pop_bulk(batch);
+		if (n == 0) {
+			std::this_thread::yield();
+		}
+		for (std::size_t i = 0; i < n; ++i) {
+			ASSERT_EQ(batch[i], expected);
+			++expected;
+		}
+	}
+	producer.join();
+	EXPECT_EQ(ring.size(), 0u);
+}
@@ -0,0 +1,69 @@
+#include "kalshi/ticker_table.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using kalshi::TickerId;
+using kalshi::TickerTable;
+
+TEST(TickerTable, AssignsDenseIdsInFirstSeenOrder) {
+	TickerTable table;
+	EXPECT_EQ(table.intern("KXHIGHDEN-26MAY11-T50").value, 0u);
+	EXPECT_EQ(table.intern("KXBTC-26MAY11-B100000").value, 1u);
+	EXPECT_EQ(table.intern("KXHIGHDEN-26MAY11-T50").value, 0u);
+	EXPECT_EQ(table.size(), 2u);
+}
+
+TEST(TickerTable, ResolvesIdsBackToNames) {
+	TickerTable table;
+	const TickerId id = table.intern("KXHIGHDEN-26MAY11-T50");
+	EXPECT_EQ(table.name(id), "KXHIGHDEN-26MAY11-T50");
+	EXPECT_EQ(table.name(TickerId{}), "");
+	EXPECT_EQ(table.name(TickerId{42}), "");
+}
+
+TEST(TickerTable, FindDoesNotAssign) {
+	TickerTable table;
+	EXPECT_FALSE(table.find("KX").has_value());
+	EXPECT_EQ(table.size(), 0u);
+	(void)table.intern("KX");
+	ASSERT_TRUE(table.find("KX").has_value());
+	EXPECT_EQ(table.find("KX")->value, 0u);
+}
+
+TEST(TickerTable, EmptyTickerIsNotInterned) {
+	TickerTable table;
+	EXPECT_FALSE(table.intern("").valid());
+	EXPECT_EQ(table.size(), 0u);
+}
+
+TEST(TickerTable, NameViewsSurviveGrowth) {
+	TickerTable table;
+	const std::string_view first = table.name(table.intern("KX-FIRST"));
+	for (int i = 0; i < 10000; ++i) {
+		(void)table.intern("KX-" + std::to_string(i));
+	}
+	EXPECT_EQ(first, "KX-FIRST");
+}
+
+TEST(TickerTable, ConcurrentInternAgreesOnIds) {
+	TickerTable table;
+	std::vector<std::thread> threads;
+	std::vector<std::vector<std::uint32_t>> seen(4);
+	for (std::size_t t = 0; t < seen.size(); ++t) {
+		threads.emplace_back([&table, &seen, t]() {
+			for (int i = 0; i < 500; ++i) {
+				seen[t].push_back(table.intern("KX-" + std::to_string(i)).value);
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(table.size(), 500u);
+	for (std::size_t t = 1; t < seen.size(); ++t) {
+		EXPECT_EQ(seen[t], seen[0]);
+	}
+}
@@ -0,0 +1,212 @@
+// Unit tests for WarmState: the snapshot file round trip for markets,
+// metadata, portfolio and books, and rejection of damaged files.
+
+#include "kalshi/warm_state.hpp"
+
+#include "kalshi/orderbook_book.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string temp_file(const char* name) {
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+	std::filesystem::remove(path);
+	return path.string();
+}
+
+kalshi::Market make_market(const std::string& ticker, std::int32_t yes_bid,
+						   std::int64_t close_time) {
+	kalshi::Market market;
+	market.ticker = ticker;
+	market.title = "Title of " + ticker;
+	market.subtitle = "Sub " + ticker;
+	market.yes_bid = yes_bid;
+	market.yes_ask = yes_bid + 2;
+	market.volume = 100;
+	market.close_time = close_time;
+	return market;
+}
+
+kalshi::WarmState open_state(const std::string& path) {
+	kalshi::Result<kalshi::WarmState> state = kalshi::WarmState::open(path);
+	EXPECT_TRUE(state.has_value());
+	return std::move(*state);
+}
+
+} // namespace
+
+TEST(WarmState, MarketTableRoundTrip) {
+	kalshi::MarketTable table;
+	table.upsert(make_market("KXA", 40, 1000));
+	table.upsert(make_market("KXB", 10, 2000));
+	kalshi::Market settled = make_market("KXC", 99, 3000);
+	settled.status = kalshi::MarketStatus::Settled;
+	settled.result = "yes";
+	table.upsert(settled);
+	kalshi::WsTrade trade;
+	trade.market_ticker = "KXB";
+	trade.yes_price = 12;
+	trade.count = 5;
+	table.apply(kalshi::WsMessage{trade});
+
+	const std::string path = temp_file("kalshi_warm_markets.bin");
+	kalshi::WarmStateSources sources;
+	sources.markets = &table;
+	ASSERT_TRUE(kalshi::WarmState::save(path, sources).has_value());
+
+	const kalshi::WarmState state = open_state(path);
+	kalshi::MarketTable restored;
+	restored.upsert(make_market("STALE", 1, 1));
+	kalshi::TickerTable tickers;
+	EXPECT_EQ(state.restore(restored, &tickers), 3u);
+	ASSERT_EQ(restored.size(), 3u);
+	EXPECT_FALSE(restored.find("STALE").has_value());
+	EXPECT_EQ(restored.find("KXB"), 1u);
+	EXPECT_EQ(restored.find(*tickers.find("KXC")), 2u);
+	EXPECT_EQ(restored.title(0), "Title of KXA");
+	EXPECT_EQ(restored.result(2), "yes");
+	EXPECT_EQ(restored.statuses()[2], kalshi::MarketStatus::Settled);
+	EXPECT_EQ(restored.close_times()[1], 2000);
+	EXPECT_EQ(restored.volumes()[1], 105);
+	EXPECT_EQ(restored.last_prices()[1], 12);
+
+	// Restored rows keep taking updates.
+	EXPECT_EQ(restored.upsert(make_market("KXD", 50, 4000)), 3u);
+	EXPECT_EQ(restored.ticker(3), "KXD");
+
+	EXPECT_FALSE(state.portfolio().has_value());
+	EXPECT_TRUE(state.books().empty());
+	std::filesystem::remove(path);
+}
+
+TEST(WarmState, MetadataKeepsWhatIsLeftOfItsTtl) {
+	kalshi::MetadataCache cache;
+	kalshi::Market market = make_market("KXA", 40, 0);
+	market.expiration_value = "above";
+	market.yes_bid_dollars = kalshi::Price::from_ticks(4012);
+	cache.put(market, std::chrono::minutes{5});
+	cache.put(make_market("KXB", 10, 0), std::chrono::milliseconds{30});
+	kalshi::Event event;
+	event.event_ticker = "KXEVT";
+	event.market_tickers = {"KXA", "KXB"};
+	cache.put(event);
+	kalshi::Series series;
+	series.ticker = "KXSER";
+	series.frequency = "daily";
+	cache.put(series);
+
+	const std::string path = temp_file("kalshi_warm_metadata.bin");
+	kalshi::WarmStateSources sources;
+	sources.metadata = &cache;
+	ASSERT_TRUE(kalshi::WarmState::save(path, sources).has_value());
+	std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+	const kalshi::WarmState state = open_state(path);
+	kalshi::MetadataCache restored;
+	EXPECT_EQ(state.restore(restored), 3u);
+	const std::shared_ptr<const kalshi::Market> hit = restored.market("KXA");
+	ASSERT_NE(hit, nullptr);
+	EXPECT_EQ(hit->expiration_value, "above");
+	EXPECT_EQ(hit->yes_bid_dollars, kalshi::Price::from_ticks(4012));
+	EXPECT_EQ(restored.market("KXB"), nullptr); // expired while "down"
+	ASSERT_NE(restored.event("KXEVT"), nullptr);
+	EXPECT_EQ(restored.event("KXEVT")->market_tickers.size(), 2u);
+	ASSERT_NE(restored.series("KXSER"), nullptr);
+	EXPECT_EQ(restored.series("KXSER")->frequency, "daily");
+	std::filesystem::remove(path);
+}
+
+TEST(WarmState, PortfolioAndBooksRoundTrip) {
+	kalshi::PortfolioStateConfig config;
+	config.reconcile_interval = std::chrono::milliseconds{0};
+	config.max_markets = 64;
+	kalshi::PortfolioState portfolio(config);
+	kalshi::Order order;
+	order.order_id = "o1";
+	order.market_ticker = "KXA";
+	order.side = kalshi::Side::No;
+	order.remaining_count = 8;
+	order.status = kalshi::OrderStatus::Open;
+	portfolio.on_order(order);
+	kalshi::WsFill fill;
+	fill.market_ticker = "KXA";
+	fill.order_id = "o1";
+	fill.side = kalshi::Side::No;
+	fill.count = 3;
+	fill.yes_price = 60;
+	fill.no_price = 40;
+	portfolio.on_fill(fill);
+
+	kalshi::OrderBookBook book;
+	kalshi::OrderbookSnapshot snapshot;
+	snapshot.seq = 7;
+	snapshot.yes = {{40, 100}, {42, 25}};
+	snapshot.no = {{55, 10}};
+	book.apply(snapshot);
+	kalshi::OrderbookDelta delta;
+	delta.seq = 8;
+	delta.side = kalshi::Side::Yes;
+	delta.price = 43;
+	delta.delta = 4;
+	book.apply(delta);
+
+	const std::string path = temp_file("kalshi_warm_portfolio.bin");
+	kalshi::WarmStateSources sources;
+	sources.portfolio = &portfolio;
+	sources.user_data_timestamp = 1700000000;
+	sources.books = {book.to_snapshot("KXA")};
+	ASSERT_TRUE(kalshi::WarmState::save(path, sources).has_value());
+
+	const kalshi::WarmState state = open_state(path);
+	EXPECT_EQ(state.user_data_timestamp(), 1700000000);
+	EXPECT_LE(std::chrono::system_clock::now() - state.saved_at(), std::chrono::minutes{1});
+
+	const std::optional<kalshi::PortfolioSnapshot> saved = state.portfolio();
+	ASSERT_TRUE(saved.has_value());
+	kalshi::PortfolioState resumed(config);
+	resumed.reset(*saved);
+	EXPECT_EQ(resumed.exposure("KXA")->position, -3);
+	EXPECT_EQ(resumed.exposure("KXA")->resting_no, 5);
+	EXPECT_EQ(resumed.cash_cents(), portfolio.cash_cents());
+
+	const std::vector<kalshi::OrderbookSnapshot> books = state.books();
+	ASSERT_EQ(books.size(), 1u);
+	EXPECT_EQ(books[0].market_ticker, "KXA");
+	EXPECT_EQ(books[0].seq, 8);
+	kalshi::OrderBookBook warm;
+	EXPECT_EQ(warm.apply(books[0]), kalshi::BookUpdate::Applied);
+	EXPECT_EQ(warm.last_seq(), 8);
+	EXPECT_EQ(warm.quantity(kalshi::Side::Yes, 43), 4);
+	EXPECT_EQ(warm.quantity(kalshi::Side::No, 55), 10);
+	std::filesystem::remove(path);
+}
+
+TEST(WarmState, RejectsMissingForeignAndTruncatedFiles) {
+	const std::string path = temp_file("kalshi_warm_bad.bin");
+	EXPECT_FALSE(kalshi::WarmState::open(path).has_value());
+
+	{
+		std::ofstream out(path, std::ios::binary);
+		out << std::string(128, 'x');
+	}
+	EXPECT_FALSE(kalshi::WarmState::open(path).has_value());
+
+	kalshi::MarketTable table;
+	for (int i = 0; i < 100; ++i) {
+		table.upsert(make_market("KX" + std::to_string(i), i % 99, i));
+	}
+	kalshi::WarmStateSources sources;
+	sources.markets = &table;
+	ASSERT_TRUE(kalshi::WarmState::save(path, sources).has_value());
+	ASSERT_TRUE(kalshi::WarmState::open(path).has_value());
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+	EXPECT_FALSE(kalshi::WarmState::open(path).has_value());
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,159 @@
+// Unit tests for the queue-mode inbound queue's overflow operations and
+// byte cap, and for watermark hysteresis.
+
+#include "backpressure.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <variant>
+
+using kalshi::OrderbookDelta;
+using kalshi::WsMessage;
+using kalshi::ws_detail::MessageQueue;
+using kalshi::ws_detail::WatermarkGate;
+
+namespace {
+
+WsMessage delta(std::int32_t seq) {
+	OrderbookDelta d;
+	d.seq = seq;
+	d.market_ticker = "KXTEST-26OCT15";
+	return d;
+}
+
+std::int32_t seq_of(const WsMessage& msg) {
+	return std::get<OrderbookDelta>(msg).seq;
+}
+
+} // namespace
+
+TEST(WsMessageQueue, FullRingRejects) {
+	MessageQueue queue(4, 0, false);
+	for (std::int32_t i = 0; i < 4; ++i) {
+		ASSERT_TRUE(queue.try_push(delta(i)));
+	}
+	WsMessage extra = delta(4);
+	EXPECT_FALSE(queue.try_push(std::move(extra)));
+	// Left untouched for the overflow policy.
+	EXPECT_EQ(std::get<OrderbookDelta>(extra).market_ticker, "KXTEST-26OCT15");
+	EXPECT_EQ(queue.size(), 4u);
+	EXPECT_EQ(queue.bytes(), 0u);
+}
+
+TEST(WsMessageQueue, ByteCapBoundsQueuedMessages) {
+	const std::size_t each = kalshi::ws_detail::message_bytes(delta(0));
+	MessageQueue queue(64, 3 * each, false);
+	for (std::int32_t i = 0; i < 3; ++i) {
+		ASSERT_TRUE(queue.try_push(delta(i)));
+	}
+	EXPECT_FALSE(queue.try_push(delta(3)));
+	EXPECT_EQ(queue.bytes(), 3 * each);
+
+	std::array<WsMessage, 2> out;
+	ASSERT_EQ(queue.pop_bulk(out), 2u);
+	EXPECT_EQ(queue.bytes(), each);
+	EXPECT_TRUE(queue.try_push(delta(3)));
+
+	// An empty queue takes any one message.
+	MessageQueue tiny(4, 1, false);
+	EXPECT_TRUE(tiny.try_push(delta(0)));
+	EXPECT_FALSE(tiny.try_push(delta(1)));
+}
+
+TEST(WsMessageQueue, EvictionDropsOldestFirst) {
+	MessageQueue queue(4, 0, true);
+	for (std::int32_t i = 0; i < 4; ++i) {
+		ASSERT_TRUE(queue.try_push(delta(i)));
+	}
+	EXPECT_EQ(queue.push_evict(delta(4)), 1u);
+	EXPECT_EQ(queue.push_evict(delta(5)), 1u);
+
+	std::array<WsMessage, 8> out;
+	ASSERT_EQ(queue.pop_bulk(out), 4u);
+	EXPECT_EQ(seq_of(out[0]), 2);
+	EXPECT_EQ(seq_of(out[3]), 5);
+
+	ASSERT_TRUE(queue.try_push(delta(6)));
+	EXPECT_EQ(queue.clear(), 1u);
+	EXPECT_EQ(queue.pop_bulk(out), 0u);
+}
+
+TEST(WsMessageQueue, EvictionAgainstConcurrentConsumer) {
+	constexpr std::int32_t kMessages = 20000;
+	MessageQueue queue(8, 0, true);
+	std::atomic<bool> done{false};
+	std::int32_t last = -1;
+	std::size_t received = 0;
+	std::thread consumer([&] {
+		std::array<WsMessage, 4> out;
+		while (!done.load(std::memory_order_acquire) || queue.size() > 0) {
+			const std::size_t n = queue.pop_bulk(out);
+			for (std::size_t i = 0; i < n; ++i) {
+				EXPECT_GT(seq_of(out[i]), last);
+				last = seq_of(out[i]);
+			}
+			received += n;
+		}
+	});
+	std::size_t evicted = 0;
+	for (std::int32_t i = 0; i < kMessages; ++i) {
+		if (!queue.try_push(delta(i))) {
+			evicted += queue.push_evict(delta(i));
+		}
+	}
+	done.store(true, std::memory_order_release);
+	consumer.join();
+	EXPECT_EQ(received + evicted, static_cast<std::size_t>(kMessages));
+	EXPECT_EQ(last, kMessages - 1);
+}
+
+TEST(WsMessageQueue, PushWaitGivesUpOnStop) {
+	MessageQueue queue(2, 0, false);
+	ASSERT_TRUE(queue.try_push(delta(0)));
+	ASSERT_TRUE(queue.try_push(delta(1)));
+	std::atomic<bool> stop{false};
+	std::thread stopper([&stop] {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		stop.store(true, std::memory_order_release);
+	});
+	EXPECT_FALSE(queue.push_wait(delta(2), stop));
+	stopper.join();
+
+	std::thread drainer([&queue] {
+		std::array<WsMessage, 1> out;
+		while (queue.pop_bulk(out) == 0) {
+			std::this_thread::yield();
+		}
+	});
+	stop.store(false);
+	EXPECT_TRUE(queue.push_wait(delta(2), stop));
+	drainer.join();
+}
+
+TEST(WsWatermarkGate, ReportsCrossingsWithHysteresis) {
+	WatermarkGate gate(100, 0, 0.75);
+	EXPECT_FALSE(gate.update(74, 0).has_value());
+	EXPECT_EQ(gate.update(75, 0), true);
+	EXPECT_FALSE(gate.update(90, 0).has_value());
+	// Stays high until it drains below half the mark.
+	EXPECT_FALSE(gate.update(50, 0).has_value());
+	EXPECT_EQ(gate.update(37, 0), false);
+	EXPECT_FALSE(gate.high());
+}
+
+TEST(WsWatermarkGate, WatchesBytesToo) {
+	WatermarkGate gate(1000, 4000, 0.5);
+	EXPECT_EQ(gate.update(1, 2000), true);
+	EXPECT_FALSE(gate.update(1, 1500).has_value());
+	EXPECT_EQ(gate.update(1, 1000), false);
+
+	// Without a byte cap bytes are ignored.
+	WatermarkGate depth_only(10, 0, 1.0);
+	EXPECT_FALSE(depth_only.update(9, 1'000'000).has_value());
+	EXPECT_EQ(depth_only.update(10, 0), true);
+}
@@ -0,0 +1,224 @@
+// Unit tests for the decode worker pipeline: per-key ordering across
+// workers, buffer recycling, waiting out a full ring, stop delivering
+// everything already queued, and the other overflow modes, the byte cap
+// and flush.
+
+#include "decode_pipeline.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using kalshi::ws_detail::DecodePipeline;
+using kalshi::ws_detail::DecodePipelineStats;
+using kalshi::ws_detail::PipelineFrame;
+
+namespace {
+
+std::string frame_for(std::uint32_t key, std::uint32_t n) {
+	return std::to_string(key) + ":" + std::to_string(n);
+}
+
+} // namespace
+
+TEST(WsDecodePipeline, KeepsOrderPerKey) {
+	constexpr std::uint32_t kKeys = 37;
+	constexpr std::uint32_t kPerKey = 2000;
+	DecodePipeline pipeline(4, 64);
+	std::mutex mutex;
+	std::vector<std::uint32_t> next(kKeys, 0);
+	std::vector<std::size_t> worker_of(kKeys, SIZE_MAX);
+	std::atomic<std::uint32_t> handled{0};
+	pipeline.start([&](std::size_t worker, PipelineFrame& frame) {
+		const std::size_t colon = frame.bytes.find(':');
+		const std::uint32_t key =
+			static_cast<std::uint32_t>(std::stoul(frame.bytes.substr(0, colon)));
+		const std::uint32_t n =
+			static_cast<std::uint32_t>(std::stoul(frame.bytes.substr(colon + 1)));
+		{
+			std::lock_guard lock(mutex);
+			EXPECT_EQ(n, next[key]);
+			next[key] = n + 1;
+			if (worker_of[key] == SIZE_MAX) {
+				worker_of[key] = worker;
+			}
+			EXPECT_EQ(worker_of[key], worker);
+		}
+		handled.fetch_add(1, std::memory_order_relaxed);
+	});
+
+	for (std::uint32_t n = 0; n < kPerKey; ++n) {
+		for (std::uint32_t key = 0; key < kKeys; ++key) {
+			ASSERT_TRUE(pipeline.push(key, frame_for(key, n), {}, 0));
+		}
+	}
+	pipeline.stop();
+	EXPECT_EQ(handled.load(), kKeys * kPerKey);
+	EXPECT_EQ(pipeline.stats().frames, std::uint64_t{kKeys} * kPerKey);
+	EXPECT_EQ(pipeline.depth(), 0u);
+	for (std::uint32_t key = 0; key < kKeys; ++key) {
+		EXPECT_EQ(worker_of[key], key % 4);
+	}
+}
+
+TEST(WsDecodePipeline, RecyclesFrameBuffers) {
+	DecodePipeline pipeline(1, 8);
+	std::atomic<std::uint32_t> handled{0};
+	std::mutex mutex;
+	std::vector<const char*> seen;
+	pipeline.start([&](std::size_t, PipelineFrame& frame) {
+		std::lock_guard lock(mutex);
+		seen.push_back(frame.bytes.data());
+		handled.fetch_add(1, std::memory_order_release);
+	});
+	const std::string frame(200, 'x'); // past the small-string buffer
+	for (std::uint32_t i = 0; i < 4; ++i) {
+		ASSERT_TRUE(pipeline.push(0, frame, {}, 0));
+		while (handled.load(std::memory_order_acquire) <= i) {
+			std::this_thread::yield();
+		}
+	}
+	pipeline.stop();
+	ASSERT_EQ(seen.size(), 4u);
+	// After the first round trip every frame lands in the returned buffer.
+	EXPECT_EQ(seen[1], seen[2]);
+	EXPECT_EQ(seen[2], seen[3]);
+}
+
+TEST(WsDecodePipeline, WaitsOutAFullRing) {
+	DecodePipeline pipeline(1, 2);
+	std::atomic<bool> release{false};
+	std::atomic<std::uint32_t> handled{0};
+	pipeline.start([&](std::size_t, PipelineFrame&) {
+		while (!release.load(std::memory_order_acquire)) {
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+		}
+		handled.fetch_add(1, std::memory_order_relaxed);
+	});
+	std::thread releaser([&release] {
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		release.store(true, std::memory_order_release);
+	});
+	for (std::uint32_t i = 0; i < 16; ++i) {
+		ASSERT_TRUE(pipeline.push(0, frame_for(0, i), {}, 0));
+	}
+	releaser.join();
+	pipeline.stop();
+	EXPECT_EQ(handled.load(), 16u);
+	EXPECT_GE(pipeline.stats().stalls, 1u);
+}
+
+TEST(WsDecodePipeline, RestartsAfterStop) {
+	DecodePipeline pipeline(2, 16);
+	std::atomic<std::uint32_t> handled{0};
+	const auto count = [&handled](std::size_t, PipelineFrame&) {
+		handled.fetch_add(1, std::memory_order_relaxed);
+	};
+	pipeline.start(count);
+	ASSERT_TRUE(pipeline.push(1, "a", {}, 0));
+	pipeline.stop();
+	pipeline.stop();
+	pipeline.start(count);
+	ASSERT_TRUE(pipeline.push(2, "b", {}, 0));
+	ASSERT_TRUE(pipeline.push(3, "c", {}, 0));
+	pipeline.stop();
+	EXPECT_EQ(handled.load(), 3u);
+	EXPECT_EQ(pipeline.workers(), 2u);
+}
+
+namespace {
+
+// Handler that holds every worker until `release` is set.
+struct Gate {
+	std::atomic<bool> release{false};
+	std::atomic<std::uint32_t> handled{0};
+	std::mutex mutex;
+	std::vector<std::string> seen;
+
+	void operator()(std::size_t, PipelineFrame& frame) {
+		while (!release.load(std::memory_order_acquire)) {
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+		}
+		std::lock_guard lock(mutex);
+		seen.push_back(frame.bytes);
+		handled.fetch_add(1, std::memory_order_relaxed);
+	}
+};
+
+} // namespace
+
+TEST(WsDecodePipeline, RejectDropsTheNewFrame) {
+	DecodePipeline pipeline(1, 2);
+	Gate gate;
+	pipeline.start([&gate](std::size_t worker, PipelineFrame& frame) { gate(worker, frame); });
+	std::uint32_t accepted = 0;
+	for (std::uint32_t i = 0; i < 8; ++i) {
+		accepted += pipeline.push(0, frame_for(0, i), {}, 0, DecodePipeline::Overflow::Reject);
+	}
+	gate.release.store(true, std::memory_order_release);
+	pipeline.stop();
+	// Two in the ring plus, at most, one the worker had already taken.
+	EXPECT_GE(accepted, 2u);
+	EXPECT_LE(accepted, 3u);
+	EXPECT_EQ(gate.handled.load(), accepted);
+	EXPECT_EQ(pipeline.stats().dropped, 8u - accepted);
+	EXPECT_EQ(pipeline.stats().stalls, 0u);
+	EXPECT_EQ(gate.seen.front(), frame_for(0, 0));
+}
+
+TEST(WsDecodePipeline, EvictOldestKeepsTheNewest) {
+	DecodePipeline pipeline(1, 2, 0, true);
+	Gate gate;
+	pipeline.start([&gate](std::size_t worker, PipelineFrame& frame) { gate(worker, frame); });
+	for (std::uint32_t i = 0; i < 8; ++i) {
+		ASSERT_TRUE(
+			pipeline.push(0, frame_for(0, i), {}, 0, DecodePipeline::Overflow::EvictOldest));
+	}
+	gate.release.store(true, std::memory_order_release);
+	pipeline.stop();
+	const DecodePipelineStats stats = pipeline.stats();
+	EXPECT_EQ(gate.handled.load() + stats.evicted, 8u);
+	ASSERT_GE(gate.seen.size(), 2u);
+	EXPECT_EQ(gate.seen[gate.seen.size() - 2], frame_for(0, 6));
+	EXPECT_EQ(gate.seen.back(), frame_for(0, 7));
+}
+
+TEST(WsDecodePipeline, ByteCapCountsQueuedFrames) {
+	DecodePipeline pipeline(2, 64, 250);
+	Gate gate;
+	pipeline.start([&gate](std::size_t worker, PipelineFrame& frame) { gate(worker, frame); });
+	const std::string frame(100, 'x');
+	// Room for 64 frames per ring, but only 250 bytes across both workers.
+	EXPECT_TRUE(pipeline.push(0, frame, {}, 0, DecodePipeline::Overflow::Reject));
+	EXPECT_TRUE(pipeline.push(1, frame, {}, 0, DecodePipeline::Overflow::Reject));
+	EXPECT_FALSE(pipeline.push(0, frame, {}, 0, DecodePipeline::Overflow::Reject));
+	EXPECT_EQ(pipeline.bytes(), 200u);
+	EXPECT_EQ(pipeline.max_bytes(), 250u);
+	EXPECT_EQ(pipeline.capacity(), 128u);
+	gate.release.store(true, std::memory_order_release);
+	pipeline.stop();
+	EXPECT_EQ(pipeline.bytes(), 0u);
+	EXPECT_EQ(pipeline.stats().dropped, 1u);
+}
+
+TEST(WsDecodePipeline, FlushSkipsQueuedFrames) {
+	DecodePipeline pipeline(1, 16);
+	Gate gate;
+	pipeline.start([&gate](std::size_t worker, PipelineFrame& frame) { gate(worker, frame); });
+	for (std::uint32_t i = 0; i < 6; ++i) {
+		ASSERT_TRUE(pipeline.push(0, frame_for(0, i), {}, 0));
+	}
+	pipeline.flush();
+	ASSERT_TRUE(pipeline.push(0, frame_for(0, 6), {}, 0));
+	gate.release.store(true, std::memory_order_release);
+	pipeline.stop();
+	// The frame the worker was already holding still goes out.
+	EXPECT_LE(gate.handled.load(), 2u);
+	EXPECT_EQ(gate.handled.load() + pipeline.stats().flushed, 7u);
+	EXPECT_EQ(gate.seen.back(), frame_for(0, 6));
+}
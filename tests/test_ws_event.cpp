@@ -0,0 +1,163 @@
+// Unit tests for the compact WsEvent layout: Uuid round trips, the
+// WsMessage <-> WsEvent conversions, and the decoder's compact path.
+
+#include "kalshi/websocket.hpp"
+#include "kalshi/ws_event.hpp"
+#include "kalshi/ws_recorder.hpp"
+
+#include "frame_decoder.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <string>
+#include <variant>
+#include <vector>
+
+using kalshi::ws_detail::decode_frame;
+using kalshi::ws_detail::DecodedFrame;
+using kalshi::ws_detail::DecodeOptions;
+using kalshi::ws_detail::FrameKind;
+
+namespace {
+
+constexpr std::string_view kTradeId = "9a3c4f1e-02b7-4d8e-a1f0-6b5c3d2e1f00";
+constexpr std::string_view kOrderId = "00112233-4455-6677-8899-AABBCCDDEEFF";
+
+const std::string kFillFrame =
+	R"({"type":"fill","sid":4,"msg":{"trade_id":"9a3c4f1e-02b7-4d8e-a1f0-6b5c3d2e1f00",)"
+	R"("order_id":"00112233-4455-6677-8899-AABBCCDDEEFF","market_ticker":"KXBTC",)"
+	R"("is_taker":true,"side":"no","yes_price_dollars":"0.5500","no_price_dollars":"0.4500",)"
+	R"("count_fp":"3.00","action":"sell","ts":1776673036}})";
+
+} // namespace
+
+TEST(Uuid, ParsesAndRendersHyphenatedForm) {
+	const std::optional<kalshi::Uuid> id = kalshi::Uuid::parse(kTradeId);
+	ASSERT_TRUE(id.has_value());
+	EXPECT_EQ(id->bytes[0], 0x9a);
+	EXPECT_EQ(id->bytes[15], 0x00);
+	EXPECT_EQ(id->to_string(), kTradeId);
+
+	const std::optional<kalshi::Uuid> upper = kalshi::Uuid::parse(kOrderId);
+	ASSERT_TRUE(upper.has_value());
+	EXPECT_EQ(upper->to_string(), "00112233-4455-6677-8899-aabbccddeeff");
+	EXPECT_EQ(kalshi::Uuid::parse("00112233445566778899aabbccddeeff"), upper);
+}
+
+TEST(Uuid, RejectsOtherShapes) {
+	EXPECT_FALSE(kalshi::Uuid::parse("").has_value());
+	EXPECT_FALSE(kalshi::Uuid::parse("t-1").has_value());
+	EXPECT_FALSE(kalshi::Uuid::parse("9a3c4f1e-02b7-4d8e-a1f0_6b5c3d2e1f00").has_value());
+	EXPECT_FALSE(kalshi::Uuid::parse("9a3c4f1e-02b7-4d8e-a1f0-6b5c3d2e1fzz").has_value());
+	EXPECT_TRUE(kalshi::Uuid{}.is_nil());
+	EXPECT_EQ(kalshi::Uuid{}.to_string(), "");
+}
+
+TEST(WsEvent, RoundTripsFillThroughRichView) {
+	kalshi::TickerTable tickers;
+	DecodeOptions options;
+	options.tickers = &tickers;
+	const DecodedFrame decoded = decode_frame(kFillFrame, options);
+	ASSERT_EQ(decoded.kind, FrameKind::Message);
+
+	const std::optional<kalshi::WsEvent> event = kalshi::to_event(decoded.message);
+	ASSERT_TRUE(event.has_value());
+	EXPECT_EQ(event->kind, kalshi::WsEventKind::Fill);
+	EXPECT_EQ(event->price, 55);
+	EXPECT_EQ(event->no_price, 45);
+	EXPECT_EQ(event->quantity, 3);
+	EXPECT_EQ(event->action, kalshi::Action::Sell);
+	EXPECT_TRUE(event->is_taker);
+
+	const kalshi::WsMessage back = kalshi::to_message(*event, &tickers);
+	const kalshi::WsFill* fill = std::get_if<kalshi::WsFill>(&back);
+	ASSERT_NE(fill, nullptr);
+	EXPECT_EQ(fill->trade_id, kTradeId);
+	EXPECT_EQ(fill->order_id, "00112233-4455-6677-8899-aabbccddeeff");
+	EXPECT_EQ(fill->market_ticker, "KXBTC");
+	EXPECT_EQ(fill->side, kalshi::Side::No);
+	EXPECT_EQ(fill->timestamp, 1776673036);
+}
+
+TEST(WsEvent, SnapshotsAndLifecycleHaveNoCompactForm) {
+	EXPECT_FALSE(kalshi::to_event(kalshi::OrderbookSnapshot{}).has_value());
+	EXPECT_FALSE(kalshi::to_event(kalshi::MarketLifecycle{}).has_value());
+}
+
+TEST(WsFrameDecoder, CompactEventsSkipRichStructs) {
+	kalshi::TickerTable tickers;
+	DecodeOptions options;
+	options.tickers = &tickers;
+	options.compact_events = true;
+
+	const DecodedFrame delta = decode_frame(
+		R"({"type":"orderbook_delta","sid":2,"seq":501,"msg":{"market_ticker":"KXBTC",)"
+		R"("price_dollars":"0.4200","delta_fp":"-30.87","side":"no"}})",
+		options);
+	ASSERT_EQ(delta.kind, FrameKind::Event);
+	EXPECT_EQ(delta.event.kind, kalshi::WsEventKind::Delta);
+	EXPECT_EQ(delta.event.sid, 2);
+	EXPECT_EQ(delta.event.seq, 501);
+	EXPECT_EQ(delta.event.price, 42);
+	EXPECT_EQ(delta.event.quantity, -31);
+	EXPECT_EQ(delta.event.side, kalshi::Side::No);
+	EXPECT_EQ(tickers.name(delta.event.ticker_id), "KXBTC");
+
+	const DecodedFrame fill = decode_frame(kFillFrame, options);
+	ASSERT_EQ(fill.kind, FrameKind::Event);
+	EXPECT_EQ(fill.event.trade_id, kalshi::Uuid::parse(kTradeId));
+	EXPECT_EQ(fill.event.ticker_id, delta.event.ticker_id);
+
+	// Snapshots keep their rich form.
+	const DecodedFrame snap = decode_frame(
+		R"({"type":"orderbook_snapshot","sid":2,"seq":1,"msg":{"market_ticker":"KXBTC","yes":[[40,1]]}})",
+		options);
+	EXPECT_EQ(snap.kind, FrameKind::Message);
+}
+
+TEST(WsEvent, RecordedEventsReplayWithTickerNames) {
+	const std::string path =
+		(std::filesystem::temp_directory_path() / "kalshi_ws_event_replay.log").string();
+	std::filesystem::remove(path);
+
+	// Recorded under one table, replayed into another with different ids.
+	kalshi::TickerTable recorded;
+	(void)recorded.intern("PADDING");
+	kalshi::WsEvent event;
+	event.kind = kalshi::WsEventKind::Trade;
+	event.ticker_id = recorded.intern("KXBTC");
+	event.price = 61;
+	event.trade_id = *kalshi::Uuid::parse(kTradeId);
+	{
+		kalshi::Result<kalshi::WsRecorder> rec =
+			kalshi::WsRecorder::open({.path = path, .frames = false, .events = true});
+		ASSERT_TRUE(rec.has_value());
+		EXPECT_TRUE(rec->record_event(event, "KXBTC", 1));
+		EXPECT_TRUE(rec->record_event(event, "KXBTC", 2));
+	}
+
+	kalshi::Result<kalshi::ReplayClient> replay =
+		kalshi::ReplayClient::open(path, {.speed = 0.0, .ticker_table = nullptr,
+										  .ticker_strings = true});
+	ASSERT_TRUE(replay.has_value());
+	std::vector<kalshi::WsEvent> events;
+	replay->on_event([&](const kalshi::WsEvent& e) { events.push_back(e); });
+	kalshi::Result<kalshi::ReplayStats> stats = replay->run();
+	ASSERT_TRUE(stats.has_value());
+	EXPECT_EQ(stats->messages, 2u);
+	ASSERT_EQ(events.size(), 2u);
+	EXPECT_EQ(replay->ticker_table()->name(events[0].ticker_id), "KXBTC");
+	EXPECT_EQ(events[1].price, 61);
+
+	// Without on_event, events arrive as rich messages.
+	replay->on_event(nullptr);
+	std::vector<std::string> trade_ids;
+	replay->on_message([&](const kalshi::WsMessage& msg) {
+		trade_ids.push_back(std::get<kalshi::WsTrade>(msg).trade_id);
+	});
+	replay->rewind();
+	ASSERT_TRUE(replay->run().has_value());
+	ASSERT_EQ(trade_ids.size(), 2u);
+	EXPECT_EQ(trade_ids[0], kTradeId);
+}
@@ -0,0 +1,337 @@
+// Unit tests for the single-pass WebSocket frame decoder.
+//
+// The decoder replaced per-field find-by-key rescans in
+// WsImplData::handle_message. These tests pin the per-type conversions
+// (same wire formats as test_ws_parser.cpp) plus the cases the old
+// scanners got wrong: key names matched inside string values, and JSON
+// boolean literals read as strings.
+
+#include "frame_assembler.hpp"
+#include "frame_decoder.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <variant>
+#include <vector>
+
+using kalshi::ws_detail::decode_frame;
+using kalshi::ws_detail::DecodedFrame;
+using kalshi::ws_detail::FrameKind;
+
+TEST(WsFrameDecoder, OrderbookDelta) {
+	const std::string frame = R"({"type":"orderbook_delta","sid":2,"seq":501,"msg":{)"
+							  R"("market_ticker":"KXHIGHDEN-26APR20-T62","price_dollars":"0.4200",)"
+							  R"("delta_fp":"-30.87","side":"no","ts":"2026-04-20T08:19:13.898Z"}})";
+	const DecodedFrame decoded = decode_frame(frame);
+	ASSERT_EQ(decoded.kind, FrameKind::Message);
+	const kalshi::OrderbookDelta* delta = std::get_if<kalshi::OrderbookDelta>(&decoded.message);
+	ASSERT_NE(delta, nullptr);
+	EXPECT_EQ(delta->sid, 2);
+	EXPECT_EQ(delta->seq, 501);
+	EXPECT_EQ(delta->market_ticker, "KXHIGHDEN-26APR20-T62");
+	EXPECT_EQ(delta->price, 42);
+	EXPECT_EQ(delta->delta, -31);
+	EXPECT_EQ(delta->side, kalshi::Side::No);
+}
+
+TEST(WsFrameDecoder, OrderbookSnapshot) {
+	const std::string frame = R"({"type":"orderbook_snapshot","sid":3,"seq":1,"msg":{)"
+							  R"("market_ticker":"KXBTC","yes":[[40,100],["41","25"]],)"
+							  R"("no":[[55, 7]]}})";
+	const DecodedFrame decoded = decode_frame(frame);
+	ASSERT_EQ(decoded.kind, FrameKind::Message);
+	const kalshi::OrderbookSnapshot* snap =
+		std::get_if<kalshi::OrderbookSnapshot>(&decoded.message);
+	ASSERT_NE(snap, nullptr);
+	EXPECT_EQ(snap->market_ticker, "KXBTC");
+	ASSERT_EQ(snap->yes.size(), 2u);
+	EXPECT_EQ(snap->yes[1].price_cents, 41);
+	EXPECT_EQ(snap->yes[1].quantity, 25);
+	ASSERT_EQ(snap->no.size(), 1u);
+	EXPECT_EQ(snap->no[0].price_cents, 55);
+	EXPECT_EQ(snap->no[0].quantity, 7);
+}
+
+TEST(WsFrameDecoder, Trade) {
+	const std::string frame = R"({"type":"trade","sid":11,"msg":{"trade_id":"t-1",)"
+							  R"("market_ticker":"KXHIGHDEN","yes_price_dollars":"0.3200",)"
+							  R"("no_price_dollars":"0.6800","count_fp":"40.00",)"
+							  R"("taker_side":"yes","ts":1776673036}})";
+	const DecodedFrame decoded = decode_frame(frame);
+	ASSERT_EQ(decoded.kind, FrameKind::Message);
+	const kalshi::WsTrade* trade = std::get_if<kalshi::WsTrade>(&decoded.message);
+	ASSERT_NE(trade, nullptr);
+	EXPECT_EQ(trade->sid, 11);
+	EXPECT_EQ(trade->trade_id, "t-1");
+	EXPECT_EQ(trade->yes_price, 32);
+	EXPECT_EQ(trade->no_price, 68);
+	EXPECT_EQ(trade->count, 40);
+	EXPECT_EQ(trade->taker_side, kalshi::Side::Yes);
+	EXPECT_EQ(trade->timestamp, 1776673036);
+}
+
+TEST(WsFrameDecoder, FillReadsBooleanLiteral) {
+	// `is_taker` is a JSON boolean on the wire. The old string scanner
+	// jumped to the next quote and always reported false.
+	const std::string frame = R"({"type":"fill","sid":4,"msg":{"trade_id":"t-9",)"
+							  R"("order_id":"o-9","market_ticker":"KXBTC","is_taker":true,)"
+							  R"("side":"yes","yes_price_dollars":"0.5500","no_price_dollars":"0.4500",)"
+							  R"("count_fp":"3.00","action":"buy","ts":1776673036}})";
+	const DecodedFrame decoded = decode_frame(frame);
+	ASSERT_EQ(decoded.kind, FrameKind::Message);
+	const kalshi::WsFill* fill = std::get_if<kalshi::WsFill>(&decoded.message);
+	ASSERT_NE(fill, nullptr);
+	EXPECT_TRUE(fill->is_taker);
+	EXPECT_EQ(fill->order_id, "o-9");
+	EXPECT_EQ(fill->side, kalshi::Side::Yes);
+	EXPECT_EQ(fill->action, kalshi::Action::Buy);
+	EXPECT_EQ(fill->yes_price, 55);
+	EXPECT_EQ(fill->count, 3);
+}
+
+TEST(WsFrameDecoder, FillKeepsSubCentPrice) {
+	const std::string frame = R"({"type":"fill","sid":4,"msg":{"trade_id":"t-9",)"
+							  R"("order_id":"o-9","market_ticker":"KXBTC","is_taker":false,)"
+							  R"("side":"yes","yes_price_dollars":"0.4250","no_price_dollars":"0.5750",)"
+							  R"("count_fp":"2.50","action":"buy","ts":1776673036}})";
+	const DecodedFrame decoded = decode_frame(frame);
+	const kalshi::WsFill* fill = std::get_if<kalshi::WsFill>(&decoded.message);
+	ASSERT_NE(fill, nullptr);
+	EXPECT_EQ(fill->yes_price_dollars, kalshi::Price::from_ticks(4250));
+	EXPECT_EQ(fill->no_price_dollars.ticks(), 5750);
+	EXPECT_EQ(fill->count_fp, kalshi::Quantity::from_units(250));
+	EXPECT_EQ(fill->yes_price, 43);
+	EXPECT_EQ(fill->no_price, 58);
+	EXPECT_EQ(fill->count, 3);
+}
+
+TEST(WsFrameDecoder, LifecycleOptionalFields) {
+	const std::string frame = R"({"type":"market_lifecycle_v2","sid":5,"msg":{)"
+							  R"("market_ticker":"KXBTC","open_ts":1700000000,"close_ts":1700003600,)"
+							  R"("is_deactivated":false,"yes_sub_title":"Above 100k"}})";
+	const DecodedFrame decoded = decode_frame(frame);
+	ASSERT_EQ(decoded.kind, FrameKind::Message);
+	const kalshi::MarketLifecycle* lc = std::get_if<kalshi::MarketLifecycle>(&decoded.message);
+	ASSERT_NE(lc, nullptr);
+	EXPECT_EQ(lc->open_ts, 1700000000);
+	EXPECT_EQ(lc->close_ts, 1700003600);
+	EXPECT_FALSE(lc->determination_ts.has_value());
+	EXPECT_FALSE(lc->result.has_value());
+	EXPECT_FALSE(lc->is_deactivated);
+	ASSERT_TRUE(lc->yes_sub_title.has_value());
+	EXPECT_EQ(*lc->yes_sub_title, "Above 100k");
+}
+
+TEST(WsFrameDecoder, SubscribedAck) {
+	const DecodedFrame decoded =
+		decode_frame(R"({"id":7,"type":"subscribed","msg":{"channel":"trade","sid":1234}})");
+	EXPECT_EQ(decoded.kind, FrameKind::Subscribed);
+	EXPECT_EQ(decoded.client_id, 7);
+	EXPECT_EQ(decoded.server_sid, 1234);
+}
+
+TEST(WsFrameDecoder, ErrorFallsBackToCodeName) {
+	const DecodedFrame decoded = decode_frame(R"({"id":3,"type":"error","msg":{"code":7}})");
+	EXPECT_EQ(decoded.kind, FrameKind::Error);
+	EXPECT_EQ(decoded.error.code, 7);
+	EXPECT_EQ(decoded.error.message, kalshi::ws_error_code_name(7));
+}
+
+TEST(WsFrameDecoder, KeyNamesInsideValuesAreNotMatched) {
+	// A string value spelled like a key must not shadow the real key.
+	const std::string frame = R"({"type":"trade","sid":1,"msg":{"trade_id":"\"ts\":99",)"
+							  R"("market_ticker":"KX","ts":1776673036}})";
+	const DecodedFrame decoded = decode_frame(frame);
+	const kalshi::WsTrade* trade = std::get_if<kalshi::WsTrade>(&decoded.message);
+	ASSERT_NE(trade, nullptr);
+	EXPECT_EQ(trade->timestamp, 1776673036);
+	EXPECT_EQ(trade->market_ticker, "KX");
+}
+
+TEST(WsFrameDecoder, UnknownOrMalformedIsIgnored) {
+	EXPECT_EQ(decode_frame(R"({"type":"ok","id":1})").kind, FrameKind::Ignored);
+	EXPECT_EQ(decode_frame(R"({"sid":1})").kind, FrameKind::Ignored);
+	EXPECT_EQ(decode_frame("").kind, FrameKind::Ignored);
+	EXPECT_EQ(decode_frame(R"({"type":)").kind, FrameKind::Ignored);
+	EXPECT_EQ(decode_frame(R"({"type":"trade","msg":{"ts":"12)").kind, FrameKind::Message);
+}
+
+TEST(WsFrameDecoder, InternsTickerWhenTableAttached) {
+	kalshi::TickerTable table;
+	const kalshi::TickerId known = table.intern("KXOTHER");
+	kalshi::ws_detail::DecodeOptions options;
+	options.tickers = &table;
+
+	const std::string frame = R"({"type":"orderbook_delta","sid":2,"seq":5,"msg":{)"
+							  R"("market_ticker":"KXHIGHDEN-26MAY11-T50","price_dollars":"0.4200",)"
+							  R"("delta_fp":"1.00","side":"yes"}})";
+	const DecodedFrame decoded = decode_frame(frame, options);
+	const kalshi::OrderbookDelta* delta = std::get_if<kalshi::OrderbookDelta>(&decoded.message);
+	ASSERT_NE(delta, nullptr);
+	EXPECT_EQ(delta->market_ticker, "KXHIGHDEN-26MAY11-T50");
+	EXPECT_EQ(delta->ticker_id.value, known.value + 1);
+	EXPECT_EQ(table.name(delta->ticker_id), "KXHIGHDEN-26MAY11-T50");
+}
+
+TEST(WsFrameDecoder, IdOnlyModeSkipsTickerString) {
+	kalshi::TickerTable table;
+	kalshi::ws_detail::DecodeOptions options;
+	options.tickers = &table;
+	options.ticker_strings = false;
+
+	const DecodedFrame decoded = decode_frame(
+		R"({"type":"trade","sid":1,"msg":{"market_ticker":"KXBTC","ts":1}})", options);
+	const kalshi::WsTrade* trade = std::get_if<kalshi::WsTrade>(&decoded.message);
+	ASSERT_NE(trade, nullptr);
+	EXPECT_TRUE(trade->market_ticker.empty());
+	ASSERT_TRUE(trade->ticker_id.valid());
+	EXPECT_EQ(table.name(trade->ticker_id), "KXBTC");
+}
+
+TEST(WsFrameDecoder, NoTableLeavesIdInvalid) {
+	const DecodedFrame decoded =
+		decode_frame(R"({"type":"trade","sid":1,"msg":{"market_ticker":"KXBTC"}})");
+	const kalshi::WsTrade* trade = std::get_if<kalshi::WsTrade>(&decoded.message);
+	ASSERT_NE(trade, nullptr);
+	EXPECT_FALSE(trade->ticker_id.valid());
+}
+
+TEST(WsFrameDecoder, SnapshotBorrowsLevelsFromArena) {
+	std::vector<kalshi::OrderBookEntry> arena;
+	arena.push_back(kalshi::OrderBookEntry{1, 1}); // stale contents must be cleared
+	kalshi::ws_detail::DecodeOptions options;
+	options.snapshot_levels = &arena;
+
+	const std::string frame = R"({"type":"orderbook_snapshot","sid":3,"seq":1,"msg":{)"
+							  R"("market_ticker":"KXBTC","yes":[[40,100],[41,25]],"no":[[55,7]]}})";
+	DecodedFrame decoded = decode_frame(frame, options);
+	kalshi::OrderbookSnapshot* snap = std::get_if<kalshi::OrderbookSnapshot>(&decoded.message);
+	ASSERT_NE(snap, nullptr);
+	EXPECT_TRUE(snap->yes.empty());
+	EXPECT_TRUE(snap->no.empty());
+	ASSERT_EQ(arena.size(), 3u);
+	ASSERT_EQ(snap->yes_levels().size(), 2u);
+	EXPECT_EQ(snap->yes_levels().data(), arena.data());
+	EXPECT_EQ(snap->yes_levels()[1].quantity, 25);
+	ASSERT_EQ(snap->no_levels().size(), 1u);
+	EXPECT_EQ(snap->no_levels()[0].price_cents, 55);
+
+	snap->make_owned();
+	EXPECT_TRUE(snap->yes_view.empty());
+	ASSERT_EQ(snap->yes.size(), 2u);
+	ASSERT_EQ(snap->no.size(), 1u);
+	EXPECT_NE(snap->yes_levels().data(), arena.data());
+	EXPECT_EQ(snap->no[0].quantity, 7);
+}
+
+TEST(WsFrameDecoder, OwnedSnapshotLevelsAreTheVectors) {
+	const DecodedFrame decoded = decode_frame(
+		R"({"type":"orderbook_snapshot","sid":3,"msg":{"yes":[[40,100]],"no":[]}})");
+	const kalshi::OrderbookSnapshot* snap =
+		std::get_if<kalshi::OrderbookSnapshot>(&decoded.message);
+	ASSERT_NE(snap, nullptr);
+	EXPECT_EQ(snap->yes_levels().data(), snap->yes.data());
+	EXPECT_TRUE(snap->no_levels().empty());
+}
+
+// --- FrameAssembler ---
+
+TEST(WsFrameAssembler, SingleChunkIsPassedThroughUncopied) {
+	kalshi::ws_detail::FrameAssembler assembler;
+	const std::string chunk = R"({"type":"trade"})";
+	const char* seen = nullptr;
+	assembler.feed(chunk, true, true, [&](std::string_view frame) { seen = frame.data(); });
+	EXPECT_EQ(seen, chunk.data());
+	EXPECT_EQ(assembler.reassembled(), 0u);
+	EXPECT_EQ(assembler.capacity(), std::string().capacity());
+}
+
+TEST(WsFramePeek, ReadsRoutingFieldsOnly) {
+	using kalshi::ws_detail::peek_frame;
+	using kalshi::ws_detail::PeekKind;
+	const kalshi::ws_detail::FramePeek delta =
+		peek_frame(R"({"type":"orderbook_delta","sid":2,"seq":501,"msg":{)"
+				   R"("market_ticker":"KXHIGHDEN-26APR20-T62","price_dollars":"0.4200"}})");
+	EXPECT_EQ(delta.kind, PeekKind::Delta);
+	EXPECT_EQ(delta.sid, 2);
+	EXPECT_EQ(delta.seq, 501);
+	EXPECT_EQ(delta.market_ticker, "KXHIGHDEN-26APR20-T62");
+
+	// Stops once all four are seen, before the malformed tail.
+	const kalshi::ws_detail::FramePeek snapshot =
+		peek_frame(R"({"type":"orderbook_snapshot","sid":3,"seq":1,"msg":{)"
+				   R"("market_ticker":"KXBTC","yes":[[40,)");
+	EXPECT_EQ(snapshot.kind, PeekKind::Snapshot);
+	EXPECT_EQ(snapshot.market_ticker, "KXBTC");
+
+	const kalshi::ws_detail::FramePeek trade = peek_frame(
+		R"({"type":"trade","sid":4,"msg":{"trade_id":"x","market_ticker":"KXETH"}})");
+	EXPECT_EQ(trade.kind, PeekKind::Data);
+	EXPECT_EQ(trade.seq, 0);
+	EXPECT_EQ(trade.market_ticker, "KXETH");
+
+	EXPECT_EQ(peek_frame(R"({"type":"subscribed","id":1,"msg":{"sid":9}})").kind,
+			  PeekKind::Control);
+	EXPECT_EQ(peek_frame(R"({"type":"error","msg":{"code":7}})").kind, PeekKind::Control);
+	EXPECT_EQ(peek_frame("").kind, PeekKind::Control);
+}
+
+TEST(WsFramePeek, AgreesWithDecode) {
+	// First occurrence wins in both, even with a decoy key in a value.
+	const std::string frame = R"({"type":"orderbook_delta","note":"\"sid\":9","sid":2,)"
+							  R"("seq":7,"msg":{"market_ticker":"A","market_ticker":"B",)"
+							  R"("price_dollars":"0.10","delta_fp":"1","side":"yes"}})";
+	const kalshi::ws_detail::FramePeek peek = kalshi::ws_detail::peek_frame(frame);
+	const DecodedFrame decoded = decode_frame(frame);
+	const kalshi::OrderbookDelta& delta = std::get<kalshi::OrderbookDelta>(decoded.message);
+	EXPECT_EQ(peek.sid, delta.sid);
+	EXPECT_EQ(peek.seq, delta.seq);
+	EXPECT_EQ(peek.market_ticker, delta.market_ticker);
+	EXPECT_EQ(peek.market_ticker, "A");
+}
+
+TEST(WsFrameAssembler, ChunksAreJoinedAndBufferReused) {
+	kalshi::ws_detail::FrameAssembler assembler;
+	std::vector<std::string> frames;
+	const auto collect = [&](std::string_view frame) { frames.emplace_back(frame); };
+	assembler.feed(R"({"type":)", true, false, collect);
+	assembler.feed(R"("orderbook_delta",)", false, false, collect);
+	assembler.feed(R"("sid":1})", false, true, collect);
+	ASSERT_EQ(frames.size(), 1u);
+	EXPECT_EQ(frames[0], R"({"type":"orderbook_delta","sid":1})");
+	const std::size_t capacity = assembler.capacity();
+	EXPECT_GE(capacity, frames[0].size());
+
+	assembler.feed("{\"a\":", true, false, collect);
+	assembler.feed("1}", false, true, collect);
+	ASSERT_EQ(frames.size(), 2u);
+	EXPECT_EQ(frames[1], R"({"a":1})");
+	EXPECT_EQ(assembler.capacity(), capacity);
+	EXPECT_EQ(assembler.reassembled(), 2u);
+}
+
+TEST(WsFrameAssembler, NewMessageDropsAbandonedPartial) {
+	kalshi::ws_detail::FrameAssembler assembler;
+	std::vector<std::string> frames;
+	const auto collect = [&](std::string_view frame) { frames.emplace_back(frame); };
+	assembler.feed(R"({"lost":)", true, false, collect);
+	assembler.feed(R"({"type":"fill"})", true, true, collect);
+	ASSERT_EQ(frames.size(), 1u);
+	EXPECT_EQ(frames[0], R"({"type":"fill"})");
+}
+
+TEST(WsFrameAssembler, OversizedMessageIsSkipped) {
+	kalshi::ws_detail::FrameAssembler assembler(16);
+	std::vector<std::string> frames;
+	const auto collect = [&](std::string_view frame) { frames.emplace_back(frame); };
+	EXPECT_TRUE(assembler.feed("0123456789", true, false, collect));
+	EXPECT_FALSE(assembler.feed("0123456789", false, false, collect));
+	// The rest of the message is dropped quietly.
+	EXPECT_TRUE(assembler.feed("0123456789", false, true, collect));
+	EXPECT_FALSE(assembler.feed(std::string(17, 'x'), true, true, collect));
+	EXPECT_TRUE(assembler.feed(R"({"type":"fill"})", true, true, collect));
+	ASSERT_EQ(frames.size(), 1u);
+	EXPECT_EQ(frames[0], R"({"type":"fill"})");
+	EXPECT_EQ(assembler.oversized(), 2u);
+	EXPECT_LE(assembler.capacity(), 32u);
+}
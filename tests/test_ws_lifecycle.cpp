@@ -17,10 +17,16 @@
 /// scope here (no creds, no exchange round-trip on CI). These tests
 /// don't connect, so they don't need network access.
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <gtest/gtest.h>
+#include <kalshi/sharded_websocket.hpp>
 #include <kalshi/signer.hpp>
 #include <kalshi/websocket.hpp>
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace {
 
@@ -165,3 +171,166 @@ TEST(WsLifecycle, DefaultIsConnectedFalseAfterMove) {
 	EXPECT_FALSE(b.is_connected());
 	EXPECT_FALSE(a.is_connected());
 }
+
+TEST(WsLifecycle, PollWithoutQueueModeReturnsZero) {
+	// Default config dispatches inline; poll() is a no-op and the
+	// queue counters stay zero.
+	kalshi::Signer signer = make_test_signer();
+	kalshi::WebSocketClient ws(signer);
+	std::array<kalshi::WsMessage, 4> buf{};
+	EXPECT_EQ(ws.poll(buf), 0u);
+	const kalshi::WsQueueStats stats = ws.queue_stats();
+	EXPECT_EQ(stats.capacity, 0u);
+	EXPECT_EQ(stats.dropped, 0u);
+}
+
+TEST(WsLifecycle, QueueModeReportsRoundedCapacity) {
+	kalshi::Signer signer = make_test_signer();
+	kalshi::WsConfig cfg;
+	cfg.message_queue_capacity = 1000;
+	kalshi::WebSocketClient ws(signer, cfg);
+	const kalshi::WsQueueStats stats = ws.queue_stats();
+	EXPECT_EQ(stats.capacity, 1024u);
+	EXPECT_EQ(stats.depth, 0u);
+	EXPECT_EQ(stats.enqueued, 0u);
+	std::array<kalshi::WsMessage, 4> buf{};
+	EXPECT_EQ(ws.poll(buf), 0u);
+}
+
+TEST(WsLifecycle, MovedFromPollAndStatsAreSafe) {
+	kalshi::Signer signer = make_test_signer();
+	kalshi::WsConfig cfg;
+	cfg.message_queue_capacity = 16;
+	kalshi::WebSocketClient a(signer, cfg);
+	kalshi::WebSocketClient b(std::move(a));
+	std::array<kalshi::WsMessage, 2> buf{};
+	EXPECT_EQ(a.poll(buf), 0u);
+	EXPECT_EQ(a.queue_stats().capacity, 0u);
+	EXPECT_EQ(b.queue_stats().capacity, 16u);
+}
+
+TEST(WsLifecycle, CompressionStatsStartEmpty) {
+	kalshi::Signer signer = make_test_signer();
+	kalshi::WsConfig cfg;
+	cfg.permessage_deflate = true;
+	kalshi::WebSocketClient a(signer, cfg);
+	const kalshi::WsCompressionStats stats = a.compression_stats();
+	EXPECT_FALSE(stats.negotiated);
+	EXPECT_EQ(stats.wire_bytes, 0u);
+	EXPECT_EQ(stats.ratio(), 0.0);
+	EXPECT_EQ((kalshi::WsCompressionStats{.wire_bytes = 100, .inflated_bytes = 850}.ratio()), 8.5);
+
+	kalshi::WebSocketClient b(std::move(a));
+	EXPECT_EQ(a.compression_stats().inflated_bytes, 0u);
+	EXPECT_TRUE(b.config().permessage_deflate);
+}
+
+TEST(WsLifecycle, PollOnceNeedsExternalMode) {
+	kalshi::Signer signer = make_test_signer();
+	kalshi::WebSocketClient threaded(signer);
+	kalshi::Result<void> rc = threaded.poll_once();
+	ASSERT_FALSE(rc.has_value());
+	EXPECT_EQ(rc.error().code, kalshi::ErrorCode::InvalidRequest);
+
+	kalshi::WsConfig cfg;
+	cfg.service_mode = kalshi::WsServiceMode::External;
+	kalshi::WebSocketClient external(signer, cfg);
+	// No connection yet, so nothing to service.
+	rc = external.poll_once(std::chrono::milliseconds{10});
+	ASSERT_FALSE(rc.has_value());
+	EXPECT_EQ(rc.error().code, kalshi::ErrorCode::NetworkError);
+	external.disconnect();
+	EXPECT_FALSE(external.poll_once().has_value());
+
+	kalshi::WebSocketClient moved(std::move(external));
+	EXPECT_FALSE(external.poll_once().has_value());
+}
+
+TEST(WsLifecycle, OwnsTickerTableUnlessOneIsShared) {
+	kalshi::Signer signer = make_test_signer();
+	kalshi::WebSocketClient own(signer);
+	EXPECT_NE(own.ticker_table(), nullptr);
+
+	kalshi::WsConfig cfg;
+	cfg.ticker_table = std::make_shared<kalshi::TickerTable>();
+	kalshi::WebSocketClient shared(signer, cfg);
+	EXPECT_EQ(shared.ticker_table(), cfg.ticker_table);
+
+	kalshi::WebSocketClient moved(std::move(shared));
+	EXPECT_EQ(shared.ticker_table(), nullptr);
+}
+
+// --- ShardedWebSocketClient ---
+
+TEST(WsLifecycle, ShardedClientSharesOneTickerTable) {
+	kalshi::Signer signer = make_test_signer();
+	kalshi::ShardedWsConfig cfg;
+	cfg.shards = 3;
+	cfg.connection.message_queue_capacity = 16;
+	kalshi::ShardedWebSocketClient ws(signer, cfg);
+	EXPECT_EQ(ws.shard_count(), 3u);
+	EXPECT_FALSE(ws.is_connected());
+	EXPECT_NE(ws.ticker_table(), nullptr);
+	EXPECT_EQ(ws.queue_stats().size(), 3u);
+	EXPECT_EQ(ws.shard_load(), (std::vector<std::uint64_t>{0, 0, 0}));
+	std::array<kalshi::WsMessage, 8> buf{};
+	EXPECT_EQ(ws.poll(buf), 0u);
+}
+
+TEST(WsLifecycle, ShardedClientPlacementIsStable) {
+	kalshi::Signer signer = make_test_signer();
+	kalshi::ShardedWsConfig cfg;
+	cfg.shards = 4;
+	kalshi::ShardedWebSocketClient a(signer, cfg);
+	kalshi::ShardedWebSocketClient b(signer, cfg);
+	for (const char* ticker : {"KXHIGHNY-26OCT14-B70", "KXBTC-26OCT1417-T99999", "INXD-26OCT14"}) {
+		EXPECT_LT(a.shard_for(ticker), 4u);
+		EXPECT_EQ(a.shard_for(ticker), b.shard_for(ticker));
+	}
+}
+
+TEST(WsLifecycle, ShardedSubscribeWhileDisconnectedFails) {
+	kalshi::Signer signer = make_test_signer();
+	kalshi::ShardedWebSocketClient ws(signer);
+	EXPECT_FALSE(ws.subscribe_orderbook({"A", "B", "C"}).has_value());
+	EXPECT_FALSE(ws.subscribe_trades().has_value());
+	EXPECT_FALSE(ws.subscribe_lifecycle().has_value());
+	// Nothing was registered for a later unsubscribe.
+	EXPECT_FALSE(ws.unsubscribe(kalshi::ShardedSubscription{.id = 1}).has_value());
+	EXPECT_TRUE(ws.rebalance().empty());
+}
+
+TEST(WsLifecycle, ShardedMovedFromIsSafe) {
+	kalshi::Signer signer = make_test_signer();
+	kalshi::ShardedWebSocketClient a(signer);
+	kalshi::ShardedWebSocketClient b(std::move(a));
+	EXPECT_EQ(a.shard_count(), 0u);
+	EXPECT_FALSE(a.is_connected());
+	EXPECT_FALSE(a.connect().has_value());
+	EXPECT_FALSE(a.subscribe_orderbook({"A"}).has_value());
+	a.on_message([](const kalshi::WsMessage&) {});
+	a.on_state_change([](std::size_t, bool) {});
+	std::array<kalshi::WsMessage, 4> buf{};
+	EXPECT_EQ(a.poll(buf), 0u);
+	EXPECT_TRUE(a.rebalance().empty());
+	EXPECT_EQ(a.ticker_table(), nullptr);
+	EXPECT_EQ(b.shard_count(), 4u);
+}
+
+TEST(WsLifecycle, PipelineStatsReportWorkers) {
+	kalshi::Signer signer = make_test_signer();
+	kalshi::WsConfig cfg;
+	cfg.decode_workers = 3;
+	kalshi::WebSocketClient a(signer, cfg);
+	EXPECT_EQ(a.pipeline_stats().workers, 3u);
+	EXPECT_EQ(a.pipeline_stats().frames, 0u);
+
+	// Queue mode keeps decoding on the service thread.
+	cfg.message_queue_capacity = 64;
+	kalshi::WebSocketClient queued(signer, cfg);
+	EXPECT_EQ(queued.pipeline_stats().workers, 0u);
+
+	kalshi::WebSocketClient b(std::move(a));
+	EXPECT_EQ(a.pipeline_stats().workers, 0u);
+	EXPECT_EQ(b.pipeline_stats().workers, 3u);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "reconnect_tracker.hpp"
+
+#include <chrono>
+#include <optional>
+
+using kalshi::ws_detail::ReconnectTracker;
+
+namespace {
+
+kalshi::RetryPolicy no_jitter() {
+	kalshi::RetryPolicy policy = kalshi::default_reconnect_backoff();
+	policy.jitter_factor = 0.0;
+	return policy;
+}
+
+} // namespace
+
+TEST(WsReconnectTracker, FirstConnectIsNotAResume) {
+	ReconnectTracker tracker;
+	EXPECT_FALSE(tracker.established());
+	EXPECT_FALSE(tracker.awaiting_message());
+	EXPECT_EQ(tracker.stats().reconnects, 0u);
+}
+
+TEST(WsReconnectTracker, BackoffDoublesUpToTheCap) {
+	ReconnectTracker tracker;
+	const ReconnectTracker::Clock::time_point t0 = ReconnectTracker::Clock::now();
+	const kalshi::RetryPolicy policy = no_jitter();
+
+	std::optional<std::chrono::milliseconds> delay = tracker.next_attempt(t0, policy, 0);
+	ASSERT_TRUE(delay.has_value());
+	EXPECT_EQ(delay->count(), 100);
+	delay = tracker.next_attempt(t0, policy, 0);
+	ASSERT_TRUE(delay.has_value());
+	EXPECT_EQ(delay->count(), 200);
+	for (int i = 0; i < 10; ++i) {
+		delay = tracker.next_attempt(t0, policy, 0);
+	}
+	ASSERT_TRUE(delay.has_value());
+	EXPECT_EQ(delay->count(), 5000);
+
+	const kalshi::WsReconnectStats stats = tracker.stats();
+	EXPECT_EQ(stats.pending_attempts, 12u);
+	EXPECT_EQ(stats.failed_attempts, 11u);
+}
+
+TEST(WsReconnectTracker, GivesUpAfterMaxAttempts) {
+	ReconnectTracker tracker;
+	const ReconnectTracker::Clock::time_point t0 = ReconnectTracker::Clock::now();
+	EXPECT_TRUE(tracker.next_attempt(t0, no_jitter(), 2).has_value());
+	EXPECT_TRUE(tracker.next_attempt(t0, no_jitter(), 2).has_value());
+	EXPECT_FALSE(tracker.next_attempt(t0, no_jitter(), 2).has_value());
+}
+
+TEST(WsReconnectTracker, MeasuresDropToFirstResumedMessage) {
+	ReconnectTracker tracker;
+	const ReconnectTracker::Clock::time_point t0 = ReconnectTracker::Clock::now();
+	ASSERT_TRUE(tracker.next_attempt(t0, no_jitter(), 0).has_value());
+	ASSERT_TRUE(tracker.next_attempt(t0 + std::chrono::milliseconds(100), no_jitter(), 0));
+
+	EXPECT_TRUE(tracker.established());
+	EXPECT_TRUE(tracker.awaiting_message());
+	tracker.message(t0 + std::chrono::milliseconds(350));
+	EXPECT_FALSE(tracker.awaiting_message());
+	// Later messages do not move the measurement.
+	tracker.message(t0 + std::chrono::seconds(5));
+
+	kalshi::WsReconnectStats stats = tracker.stats();
+	EXPECT_EQ(stats.reconnects, 1u);
+	EXPECT_EQ(stats.failed_attempts, 1u);
+	EXPECT_EQ(stats.pending_attempts, 0u);
+	EXPECT_EQ(stats.last_resume_latency, std::chrono::milliseconds(350));
+	EXPECT_EQ(stats.max_resume_latency, std::chrono::milliseconds(350));
+
+	// A shorter second outage keeps the maximum.
+	const ReconnectTracker::Clock::time_point t1 = t0 + std::chrono::seconds(10);
+	ASSERT_TRUE(tracker.next_attempt(t1, no_jitter(), 0).has_value());
+	EXPECT_TRUE(tracker.established());
+	tracker.message(t1 + std::chrono::milliseconds(120));
+	stats = tracker.stats();
+	EXPECT_EQ(stats.reconnects, 2u);
+	EXPECT_EQ(stats.last_resume_latency, std::chrono::milliseconds(120));
+	EXPECT_EQ(stats.max_resume_latency, std::chrono::milliseconds(350));
+}
+
+TEST(WsReconnectTracker, DropBeforeFirstMessageExtendsTheOutage) {
+	ReconnectTracker tracker;
+	const ReconnectTracker::Clock::time_point t0 = ReconnectTracker::Clock::now();
+	ASSERT_TRUE(tracker.next_attempt(t0, no_jitter(), 0).has_value());
+	EXPECT_TRUE(tracker.established());
+	// Dropped again before any data: not a failed attempt, same outage.
+	ASSERT_TRUE(tracker.next_attempt(t0 + std::chrono::milliseconds(200), no_jitter(), 0));
+	EXPECT_TRUE(tracker.established());
+	tracker.message(t0 + std::chrono::milliseconds(500));
+
+	const kalshi::WsReconnectStats stats = tracker.stats();
+	EXPECT_EQ(stats.failed_attempts, 0u);
+	EXPECT_EQ(stats.last_resume_latency, std::chrono::milliseconds(500));
+}
+
+TEST(WsReconnectTracker, ResetForgetsTheOutage) {
+	ReconnectTracker tracker;
+	ASSERT_TRUE(tracker.next_attempt(ReconnectTracker::Clock::now(), no_jitter(), 0));
+	tracker.reset();
+	EXPECT_FALSE(tracker.established());
+	EXPECT_EQ(tracker.stats().pending_attempts, 0u);
+}
@@ -0,0 +1,182 @@
+// Unit tests for the WebSocket capture log: WsRecorder writes it,
+// WsLogReader reads it back, ReplayClient decodes it into on_message.
+
+#include "kalshi/ws_recorder.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace {
+
+const std::string kDelta = R"({"type":"orderbook_delta","sid":2,"seq":7,"msg":{)"
+						   R"("market_ticker":"KXBTC","price_dollars":"0.4200",)"
+						   R"("delta_fp":"5.00","side":"yes"}})";
+const std::string kError = R"({"type":"error","id":3,"msg":{"code":6,"msg":"Already subscribed"}})";
+const std::string kAck = R"({"type":"subscribed","id":1,"msg":{"channel":"trade","sid":9}})";
+
+std::string temp_log(const char* name) {
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+	std::filesystem::remove(path);
+	return path.string();
+}
+
+} // namespace
+
+TEST(WsRecorder, RoundTripsFramesAndTimestamps) {
+	const std::string path = temp_log("kalshi_ws_recorder_roundtrip.log");
+	{
+		kalshi::Result<kalshi::WsRecorder> rec = kalshi::WsRecorder::open({.path = path});
+		ASSERT_TRUE(rec.has_value()) << rec.error().message;
+		EXPECT_TRUE(rec->record(kDelta, 1'000));
+		EXPECT_TRUE(rec->record("", 2'000));
+		EXPECT_TRUE(rec->record(kAck, 3'000));
+		rec->flush();
+		EXPECT_EQ(rec->stats().records, 3u);
+		EXPECT_EQ(rec->stats().dropped, 0u);
+		EXPECT_EQ(rec->stats().bytes_written % 8, 0u);
+	}
+
+	kalshi::Result<kalshi::WsLogReader> reader = kalshi::WsLogReader::open(path);
+	ASSERT_TRUE(reader.has_value()) << reader.error().message;
+	kalshi::WsLogRecord record;
+	ASSERT_TRUE(reader->next(record));
+	EXPECT_EQ(record.recv_ns, 1'000u);
+	EXPECT_EQ(record.type, kalshi::WsLogRecordType::Frame);
+	EXPECT_EQ(record.payload, kDelta);
+	ASSERT_TRUE(reader->next(record));
+	EXPECT_EQ(record.recv_ns, 2'000u);
+	EXPECT_TRUE(record.payload.empty());
+	ASSERT_TRUE(reader->next(record));
+	EXPECT_EQ(record.payload, kAck);
+	EXPECT_FALSE(reader->next(record));
+	EXPECT_FALSE(reader->truncated());
+
+	reader->rewind();
+	ASSERT_TRUE(reader->next(record));
+	EXPECT_EQ(record.recv_ns, 1'000u);
+}
+
+TEST(WsRecorder, AppendsToExistingLogAndRejectsForeignFiles) {
+	const std::string path = temp_log("kalshi_ws_recorder_append.log");
+	for (std::uint64_t ts : {10u, 20u}) {
+		kalshi::Result<kalshi::WsRecorder> rec = kalshi::WsRecorder::open({.path = path});
+		ASSERT_TRUE(rec.has_value());
+		EXPECT_TRUE(rec->record(kDelta, ts));
+	}
+	kalshi::Result<kalshi::WsLogReader> reader = kalshi::WsLogReader::open(path);
+	ASSERT_TRUE(reader.has_value());
+	kalshi::WsLogRecord record;
+	int count = 0;
+	while (reader->next(record)) {
+		++count;
+	}
+	EXPECT_EQ(count, 2);
+
+	const std::string foreign = temp_log("kalshi_ws_recorder_foreign.log");
+	std::ofstream(foreign) << "not a capture log at all";
+	EXPECT_FALSE(kalshi::WsRecorder::open({.path = foreign}).has_value());
+	EXPECT_FALSE(kalshi::WsLogReader::open(foreign).has_value());
+}
+
+TEST(WsRecorder, DropsWhenRingIsFull) {
+	const std::string path = temp_log("kalshi_ws_recorder_full.log");
+	kalshi::Result<kalshi::WsRecorder> rec = kalshi::WsRecorder::open(
+		{.path = path, .buffer_bytes = 4096, .flush_interval = std::chrono::hours{1}});
+	ASSERT_TRUE(rec.has_value());
+	const std::string big(3000, 'x');
+	EXPECT_TRUE(rec->record(big, 1));
+	EXPECT_FALSE(rec->record(big, 2)); // Writer has not drained yet
+	EXPECT_FALSE(rec->record(std::string(5000, 'y'), 3)); // Larger than the ring
+	EXPECT_EQ(rec->stats().dropped, 2u);
+	rec->flush();
+	EXPECT_TRUE(rec->record(big, 4));
+}
+
+TEST(WsLogReader, StopsCleanlyAtTruncatedRecord) {
+	const std::string path = temp_log("kalshi_ws_recorder_truncated.log");
+	{
+		kalshi::Result<kalshi::WsRecorder> rec = kalshi::WsRecorder::open({.path = path});
+		ASSERT_TRUE(rec.has_value());
+		EXPECT_TRUE(rec->record(kDelta, 1));
+		EXPECT_TRUE(rec->record(kDelta, 2));
+	}
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 12);
+	kalshi::Result<kalshi::WsLogReader> reader = kalshi::WsLogReader::open(path);
+	ASSERT_TRUE(reader.has_value());
+	kalshi::WsLogRecord record;
+	EXPECT_TRUE(reader->next(record));
+	EXPECT_FALSE(reader->next(record));
+	EXPECT_TRUE(reader->truncated());
+}
+
+TEST(ReplayClient, DecodesFramesIntoCallbacks) {
+	const std::string path = temp_log("kalshi_ws_replay.log");
+	{
+		kalshi::Result<kalshi::WsRecorder> rec = kalshi::WsRecorder::open({.path = path});
+		ASSERT_TRUE(rec.has_value());
+		EXPECT_TRUE(rec->record(kAck, 1'000'000));
+		EXPECT_TRUE(rec->record(kDelta, 2'000'000));
+		EXPECT_TRUE(rec->record(kError, 3'000'000));
+		EXPECT_TRUE(rec->record(kDelta, 50'000'000));
+	}
+
+	kalshi::Result<kalshi::ReplayClient> replay =
+		kalshi::ReplayClient::open(path, {.speed = 0.0, .ticker_table = nullptr,
+										  .ticker_strings = false});
+	ASSERT_TRUE(replay.has_value()) << replay.error().message;
+	std::vector<kalshi::OrderbookDelta> deltas;
+	std::vector<std::int32_t> errors;
+	replay->on_message([&](const kalshi::WsMessage& msg) {
+		deltas.push_back(std::get<kalshi::OrderbookDelta>(msg));
+	});
+	replay->on_error([&](const kalshi::WsError& err) { errors.push_back(err.code); });
+
+	kalshi::Result<kalshi::ReplayStats> stats = replay->run();
+	ASSERT_TRUE(stats.has_value());
+	EXPECT_EQ(stats->frames, 4u);
+	EXPECT_EQ(stats->messages, 2u);
+	EXPECT_EQ(stats->errors, 1u);
+	EXPECT_EQ(stats->recorded_span, std::chrono::milliseconds{49});
+	ASSERT_EQ(deltas.size(), 2u);
+	EXPECT_EQ(deltas[0].price, 42);
+	EXPECT_TRUE(deltas[0].market_ticker.empty());
+	EXPECT_EQ(replay->ticker_table()->name(deltas[0].ticker_id), "KXBTC");
+	EXPECT_EQ(errors, std::vector<std::int32_t>{6});
+}
+
+TEST(ReplayClient, PacesBySpeedAndStops) {
+	const std::string path = temp_log("kalshi_ws_replay_paced.log");
+	{
+		kalshi::Result<kalshi::WsRecorder> rec = kalshi::WsRecorder::open({.path = path});
+		ASSERT_TRUE(rec.has_value());
+		for (std::uint64_t i = 0; i < 5; ++i) {
+			EXPECT_TRUE(rec->record(kDelta, i * 20'000'000)); // 20 ms apart
+		}
+	}
+
+	// 80 ms of recorded time at 4x takes at least 20 ms.
+	kalshi::Result<kalshi::ReplayClient> replay = kalshi::ReplayClient::open(
+		path, {.speed = 4.0, .ticker_table = nullptr, .ticker_strings = true});
+	ASSERT_TRUE(replay.has_value());
+	kalshi::Result<kalshi::ReplayStats> stats = replay->run();
+	ASSERT_TRUE(stats.has_value());
+	EXPECT_EQ(stats->messages, 5u);
+	EXPECT_GE(stats->elapsed, std::chrono::milliseconds{20});
+
+	replay->rewind();
+	int seen = 0;
+	replay->on_message([&](const kalshi::WsMessage&) {
+		if (++seen == 2) {
+			replay->stop();
+		}
+	});
+	stats = replay->run();
+	ASSERT_TRUE(stats.has_value());
+	EXPECT_EQ(stats->messages, 2u);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include "seq_tracker.hpp"
+
+using kalshi::ws_detail::SeqObservation;
+using kalshi::ws_detail::SeqStatus;
+using kalshi::ws_detail::SeqTracker;
+
+TEST(WsSeqTracker, FirstMessageBecomesBase) {
+	SeqTracker tracker;
+	EXPECT_EQ(tracker.observe(1, 40).status, SeqStatus::First);
+	EXPECT_EQ(tracker.observe(1, 41).status, SeqStatus::InOrder);
+	EXPECT_EQ(tracker.observe(1, 42).status, SeqStatus::InOrder);
+}
+
+TEST(WsSeqTracker, GapReportsMissingSeqAndRebases) {
+	SeqTracker tracker;
+	(void)tracker.observe(1, 1);
+	const SeqObservation gap = tracker.observe(1, 5);
+	EXPECT_EQ(gap.status, SeqStatus::Gap);
+	EXPECT_EQ(gap.expected, 2);
+	// Later frames continue from the received seq.
+	EXPECT_EQ(tracker.observe(1, 6).status, SeqStatus::InOrder);
+}
+
+TEST(WsSeqTracker, ReplayedFrameIsDuplicate) {
+	SeqTracker tracker;
+	(void)tracker.observe(1, 10);
+	(void)tracker.observe(1, 11);
+	EXPECT_EQ(tracker.observe(1, 11).status, SeqStatus::Duplicate);
+	EXPECT_EQ(tracker.observe(1, 3).status, SeqStatus::Duplicate);
+	EXPECT_EQ(tracker.observe(1, 12).status, SeqStatus::InOrder);
+}
+
+TEST(WsSeqTracker, SidsAreIndependent) {
+	SeqTracker tracker;
+	(void)tracker.observe(1, 100);
+	EXPECT_EQ(tracker.observe(2, 1).status, SeqStatus::First);
+	EXPECT_EQ(tracker.observe(1, 101).status, SeqStatus::InOrder);
+	EXPECT_EQ(tracker.observe(2, 2).status, SeqStatus::InOrder);
+}
+
+TEST(WsSeqTracker, UnsequencedFramesAndClear) {
+	SeqTracker tracker;
+	EXPECT_EQ(tracker.observe(1, 0).status, SeqStatus::InOrder);
+	(void)tracker.observe(1, 7);
+	tracker.clear();
+	EXPECT_EQ(tracker.observe(1, 1).status, SeqStatus::First);
+}
+
+TEST(WsSeqTracker, EraseForgetsOneSid) {
+	SeqTracker tracker;
+	(void)tracker.observe(1, 7);
+	(void)tracker.observe(2, 3);
+	tracker.erase(1);
+	EXPECT_EQ(tracker.observe(1, 1).status, SeqStatus::First);
+	EXPECT_EQ(tracker.observe(2, 4).status, SeqStatus::InOrder);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "service_tuning.hpp"
+
+// Thread placement and the socket options are Linux-only features.
+#if defined(__linux__)
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+using kalshi::ws_detail::tune_thread;
+
+TEST(WsServiceTuning, DefaultsLeaveTheThreadAlone) {
+	EXPECT_TRUE(tune_thread(pthread_self(), -1, 0).has_value());
+}
+
+TEST(WsServiceTuning, RejectsOutOfRangeSettings) {
+	for (const auto& [cpu, priority] : {std::pair{-2, 0}, std::pair{-1, -1}, std::pair{-1, 100}}) {
+		kalshi::Result<void> tuned = tune_thread(pthread_self(), cpu, priority);
+		ASSERT_FALSE(tuned.has_value()) << cpu << " " << priority;
+		EXPECT_EQ(tuned.error().code, kalshi::ErrorCode::InvalidRequest);
+	}
+}
+
+TEST(WsServiceTuning, PinsToOneCpu) {
+	cpu_set_t original;
+	ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(original), &original), 0);
+	int allowed = -1;
+	for (int cpu = 0; cpu < CPU_SETSIZE && allowed < 0; ++cpu) {
+		if (CPU_ISSET(cpu, &original)) {
+			allowed = cpu;
+		}
+	}
+	ASSERT_GE(allowed, 0);
+
+	ASSERT_TRUE(tune_thread(pthread_self(), allowed, 0).has_value());
+	cpu_set_t pinned;
+	ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(pinned), &pinned), 0);
+	EXPECT_EQ(CPU_COUNT(&pinned), 1);
+	EXPECT_TRUE(CPU_ISSET(allowed, &pinned));
+
+	EXPECT_FALSE(tune_thread(pthread_self(), CPU_SETSIZE, 0).has_value());
+	pthread_setaffinity_np(pthread_self(), sizeof(original), &original);
+}
+
+TEST(WsServiceTuning, SetsNoDelay) {
+	const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+	ASSERT_GE(fd, 0);
+	EXPECT_TRUE(kalshi::ws_detail::tune_socket(fd, true, 0).has_value());
+	int on = 0;
+	socklen_t len = sizeof(on);
+	ASSERT_EQ(::getsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, &len), 0);
+	EXPECT_NE(on, 0);
+	::close(fd);
+
+	EXPECT_FALSE(kalshi::ws_detail::tune_socket(-1, true, 0).has_value());
+}
+
+#endif
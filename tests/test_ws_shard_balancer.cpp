@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "shard_balancer.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using kalshi::ws_detail::MarketLoad;
+using kalshi::ws_detail::plan_rebalance;
+using kalshi::ws_detail::PlannedMove;
+using kalshi::ws_detail::shard_of;
+
+TEST(WsShardBalancer, ShardOfIsStableAndInRange) {
+	static_assert(shard_of("KXHIGHNY-26OCT14-B70", 1) == 0);
+	EXPECT_EQ(shard_of("KXHIGHNY-26OCT14-B70", 8), shard_of("KXHIGHNY-26OCT14-B70", 8));
+	std::array<int, 4> hits{};
+	for (int i = 0; i < 400; ++i) {
+		const std::size_t shard = shard_of("MKT-" + std::to_string(i), hits.size());
+		ASSERT_LT(shard, hits.size());
+		++hits[shard];
+	}
+	// Every shard gets a fair share of a uniform ticker set.
+	for (int count : hits) {
+		EXPECT_GT(count, 60);
+	}
+}
+
+TEST(WsShardBalancer, BalancedShardsStayPut) {
+	const std::vector<MarketLoad> markets{{.ticker = 0, .shard = 0, .messages = 100},
+										  {.ticker = 1, .shard = 1, .messages = 110}};
+	const std::vector<std::uint64_t> shards{100, 110};
+	EXPECT_TRUE(plan_rebalance(markets, shards, 0.25, 8).empty());
+}
+
+TEST(WsShardBalancer, MovesHeaviestMarketThatNarrowsTheGap) {
+	// Shard 0 carries 1000; the 700 market would just flip the imbalance,
+	// so the 250 one moves, which leaves 750 / 550: within 25% of the mean.
+	const std::vector<MarketLoad> markets{{.ticker = 0, .shard = 0, .messages = 700},
+										  {.ticker = 1, .shard = 0, .messages = 250},
+										  {.ticker = 2, .shard = 0, .messages = 50},
+										  {.ticker = 3, .shard = 1, .messages = 300}};
+	const std::vector<std::uint64_t> shards{1000, 300};
+	const std::vector<PlannedMove> moves = plan_rebalance(markets, shards, 0.25, 8);
+	ASSERT_EQ(moves.size(), 1u);
+	EXPECT_EQ(moves[0].market, 1u);
+	EXPECT_EQ(moves[0].from, 0u);
+	EXPECT_EQ(moves[0].to, 1u);
+}
+
+TEST(WsShardBalancer, UnmovableLoadCountsButIsNotMoved) {
+	// Shard 0's traffic is a server-sharded firehose with no movable
+	// markets; nothing can be done about it.
+	const std::vector<MarketLoad> markets{{.ticker = 0, .shard = 1, .messages = 10}};
+	const std::vector<std::uint64_t> shards{5000, 10, 0};
+	EXPECT_TRUE(plan_rebalance(markets, shards, 0.25, 8).empty());
+}
+
+TEST(WsShardBalancer, RespectsMoveBudget) {
+	std::vector<MarketLoad> markets;
+	for (std::uint32_t i = 0; i < 10; ++i) {
+		markets.push_back({.ticker = i, .shard = 0, .messages = 100});
+	}
+	const std::vector<std::uint64_t> shards{1000, 0, 0, 0};
+	EXPECT_EQ(plan_rebalance(markets, shards, 0.0, 3).size(), 3u);
+	EXPECT_TRUE(plan_rebalance(markets, std::vector<std::uint64_t>{1000}, 0.0, 3).empty());
+}
@@ -2,6 +2,12 @@
 
 #include "subscription_registry.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
 TEST(WsSubscriptionRegistry, FallsBackToClientIdBeforeAck) {
 	kalshi::ws_detail::SubscriptionRegistry registry;
 
@@ -15,6 +21,8 @@ TEST(WsSubscriptionRegistry, ResolvesServerSidAfterSubscribedAck) {
 
 	EXPECT_EQ(registry.resolve(12), 9876);
 	EXPECT_EQ(registry.resolve(13), 13);
+	EXPECT_EQ(registry.server_sid(12), 9876);
+	EXPECT_EQ(registry.server_sid(13), 0);
 }
 
 TEST(WsSubscriptionRegistry, EraseDropsStaleMappingAfterUnsubscribe) {
@@ -36,3 +44,124 @@ TEST(WsSubscriptionRegistry, ClearDropsMappingsAfterReconnectOrClose) {
 	EXPECT_EQ(registry.resolve(12), 12);
 	EXPECT_EQ(registry.resolve(13), 13);
 }
+
+TEST(WsSubscriptionRegistry, TracksMarketsPerSubscriptionForResync) {
+	kalshi::ws_detail::SubscriptionRegistry registry;
+	registry.set_markets(12, {"KX-A", "KX-B"});
+	// Not acked yet: the server sid is unknown, so nothing to resync.
+	EXPECT_TRUE(registry.markets_for_sid(9876).empty());
+
+	registry.register_ack(12, 9876);
+	registry.add_markets(12, {"KX-B", "KX-C"});
+	registry.remove_markets(12, {"KX-A"});
+
+	const std::vector<std::string> markets = registry.markets_for_sid(9876);
+	ASSERT_EQ(markets.size(), 2u);
+	EXPECT_EQ(markets[0], "KX-B");
+	EXPECT_EQ(markets[1], "KX-C");
+
+	registry.erase(12);
+	EXPECT_TRUE(registry.markets_for_sid(9876).empty());
+}
+
+TEST(WsSubscriptionRegistry, ReplaySurvivesLostServerSids) {
+	kalshi::ws_detail::SubscriptionRegistry registry;
+	registry.track(12, kalshi::Channel::OrderbookDelta, {"KX-A"});
+	registry.track(14, kalshi::Channel::Trade, {}, kalshi::WsShard{.factor = 4, .key = 1});
+	registry.track(13, kalshi::Channel::Fill, {});
+	registry.register_ack(12, 9876);
+	registry.add_markets(12, {"KX-B"});
+	registry.erase(13);
+
+	registry.forget_server_sids();
+	EXPECT_EQ(registry.resolve(12), 12);
+
+	const std::vector<kalshi::ws_detail::SubscriptionReplay> replay = registry.replay();
+	ASSERT_EQ(replay.size(), 2u);
+	EXPECT_EQ(replay[0].client_id, 12);
+	EXPECT_EQ(replay[0].channel, kalshi::Channel::OrderbookDelta);
+	ASSERT_EQ(replay[0].markets.size(), 2u);
+	EXPECT_EQ(replay[0].markets[1], "KX-B");
+	EXPECT_FALSE(replay[0].shard.has_value());
+	EXPECT_EQ(replay[1].client_id, 14);
+	EXPECT_EQ(replay[1].channel, kalshi::Channel::Trade);
+	ASSERT_TRUE(replay[1].shard.has_value());
+	EXPECT_EQ(replay[1].shard->key, 1);
+
+	// The replayed subscribe is acked under the same client id.
+	registry.register_ack(12, 5555);
+	EXPECT_EQ(registry.markets_for_sid(5555).size(), 2u);
+}
+
+TEST(WsSubscriptionRegistry, FindSidIndexesAckedSubscriptions) {
+	kalshi::ws_detail::SubscriptionRegistry registry;
+	registry.track(12, kalshi::Channel::Trade, {"KX-A"});
+	registry.track(10, kalshi::Channel::OrderbookDelta, {});
+	registry.register_ack(12, 3);
+	registry.register_ack(10, 1 << 20); // beyond the flat index
+
+	const kalshi::ws_detail::SubscriptionEntry* trade = registry.find_sid(3);
+	ASSERT_NE(trade, nullptr);
+	EXPECT_EQ(trade->client_id, 12);
+	EXPECT_EQ(trade->channel, kalshi::Channel::Trade);
+	const kalshi::ws_detail::SubscriptionEntry* book = registry.find_sid(1 << 20);
+	ASSERT_NE(book, nullptr);
+	EXPECT_EQ(book->client_id, 10);
+	EXPECT_EQ(registry.find_sid(4), nullptr);
+	EXPECT_EQ(registry.find_sid(0), nullptr);
+
+	registry.erase(10);
+	ASSERT_NE(registry.find_sid(3), nullptr);
+	EXPECT_EQ(registry.find_sid(3)->client_id, 12);
+}
+
+TEST(WsSubscriptionRegistry, RetiredSnapshotsWaitForReaderQuiescence) {
+	kalshi::ws_detail::SubscriptionRegistry registry;
+	registry.reader_online();
+	const kalshi::ws_detail::SubscriptionRegistry::Snapshot& held = registry.read();
+
+	registry.track(1, kalshi::Channel::Fill, {});
+	registry.track(2, kalshi::Channel::Fill, {});
+	// The reader may still hold the first snapshot.
+	EXPECT_TRUE(held.entries.empty());
+	EXPECT_EQ(registry.retired_count(), 2u);
+
+	registry.quiesce();
+	registry.track(3, kalshi::Channel::Fill, {});
+	// Retired before the quiesce: freed. The one just retired: kept.
+	EXPECT_EQ(registry.retired_count(), 1u);
+
+	registry.reader_offline();
+	registry.track(4, kalshi::Channel::Fill, {});
+	EXPECT_EQ(registry.retired_count(), 0u);
+	EXPECT_EQ(registry.read().entries.size(), 4u);
+}
+
+TEST(WsSubscriptionRegistry, ReaderNeverBlocksOnConcurrentWriters) {
+	kalshi::ws_detail::SubscriptionRegistry registry;
+	std::atomic<bool> done{false};
+	std::thread reader([&registry, &done] {
+		registry.reader_online();
+		std::uint64_t reads = 0;
+		do {
+			const kalshi::ws_detail::SubscriptionEntry* entry = registry.find_sid(7);
+			if (entry && entry->markets) {
+				EXPECT_GE(entry->markets->size(), 2u);
+			}
+			++reads;
+			registry.quiesce();
+		} while (!done.load());
+		registry.reader_offline();
+		EXPECT_GT(reads, 0u);
+	});
+
+	for (std::int32_t i = 0; i < 2000; ++i) {
+		registry.track(i, kalshi::Channel::OrderbookDelta, {"KX-A", "KX-B"});
+		registry.register_ack(i, 7);
+		registry.add_markets(i, {"KX-C"});
+		registry.erase(i);
+	}
+	done.store(true);
+	reader.join();
+	EXPECT_EQ(registry.resolve(5), 5);
+}
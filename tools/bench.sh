@@ -20,6 +20,11 @@
 #   ./tools/bench.sh --compare 50              # Compare with 50 iterations
 #   ./tools/bench.sh --compare main feature    # Compare two branches
 #   ./tools/bench.sh --compare abc123 def456 100  # Compare commits with 100 iterations
+#
+# Both modes also run the hot-path microbenchmarks
+# (tests/kalshi_hot_path_benchmark) when the build has them. Compare mode
+# exits non-zero if any is slower than the old ref by more than
+# BENCH_THRESHOLD percent (default: 10).
 
 set -euo pipefail
 
@@ -39,6 +44,8 @@ ITERATIONS=100
 OLD_REF=""
 NEW_REF=""
 BUILD_DIR="${PROJECT_DIR}/build"
+BENCH_THRESHOLD="${BENCH_THRESHOLD:-10}"
+MICRO_BENCH="tests/kalshi_hot_path_benchmark"
 
 # Parse arguments
 while [[ $# -gt 0 ]]; do
@@ -48,7 +55,7 @@ while [[ $# -gt 0 ]]; do
             shift
             ;;
         -h|--help)
-            head -25 "$0" | tail -22
+            head -30 "$0" | tail -27
             exit 0
             ;;
         *)
@@ -159,6 +166,15 @@ benchmark_one() {
     echo "$name $min $p50 $mean $p95 $max $size"
 }
 
+# Run the hot-path microbenchmarks in a build, output: "name ns_per_op" lines
+run_micro() {
+    local exe="$1/${MICRO_BENCH}"
+    [[ -x "$exe" ]] || return 0
+    echo -e "  Running: $(basename "$exe")..." >&2
+    # A cap breach exits non-zero; the numbers are still wanted here.
+    "$exe" --tsv 2>/dev/null || true
+}
+
 #------------------------------------------------------------------------------
 # Single build benchmark mode
 #------------------------------------------------------------------------------
@@ -208,6 +224,17 @@ run_single_benchmark() {
     
     echo ""
     echo "Legend: Min=fastest, P50=median, Mean=average, P95=95th percentile, Max=slowest"
+
+    if [[ -x "${build_dir}/${MICRO_BENCH}" ]]; then
+        echo ""
+        echo "--- Hot-Path Microbenchmarks (ns/op) ---"
+        printf "%-32s %14s\n" "Benchmark" "ns/op"
+        printf "%-32s %14s\n" "---------" "-----"
+        while read -r name ns; do
+            [[ -z "$name" ]] && continue
+            printf "%-32s %14s\n" "$name" "$ns"
+        done < <(run_micro "$build_dir")
+    fi
 }
 
 #------------------------------------------------------------------------------
@@ -292,6 +319,8 @@ run_comparison() {
     # Collect data
     declare -A old_lib_sizes new_lib_sizes old_exe_sizes new_exe_sizes
     declare -A old_times new_times
+    declare -A old_micro new_micro
+    local -a micro_names=()
     
     # Library sizes
     while IFS= read -r lib; do
@@ -322,6 +351,11 @@ run_comparison() {
         old_times["${name}_p95"]=$p95
         old_times["${name}_max"]=$max
     done < <(find_executables "$build_old")
+    while read -r name ns; do
+        [[ -z "$name" ]] && continue
+        old_micro["$name"]=$ns
+        micro_names+=("$name")
+    done < <(run_micro "$build_old")
     
     # Benchmark new
     echo -e "${BLUE}Benchmarking NEW...${NC}"
@@ -335,6 +369,10 @@ run_comparison() {
         new_times["${name}_p95"]=$p95
         new_times["${name}_max"]=$max
     done < <(find_executables "$build_new")
+    while read -r name ns; do
+        [[ -z "$name" ]] && continue
+        new_micro["$name"]=$ns
+    done < <(run_micro "$build_new")
     
     # Print size comparison
     echo ""
@@ -440,7 +478,41 @@ run_comparison() {
         done
     done
     
+    # Microbenchmarks present in both builds, in run order. Timings are
+    # fractional ns, so the arithmetic goes through awk.
+    local regressions=0
+    if (( ${#micro_names[@]} > 0 )); then
+        echo ""
+        echo -e "${BLUE}=== Hot-Path Microbenchmarks (ns/op, threshold ${BENCH_THRESHOLD}%) ===${NC}"
+        echo ""
+        printf "%-32s %14s %14s %18s\n" "Benchmark" "Old" "New" "Delta"
+        printf "%-32s %14s %14s %18s\n" "---------" "---" "---" "-----"
+        for name in "${micro_names[@]}"; do
+            local old_val=${old_micro[$name]}
+            local new_val=${new_micro[$name]:-}
+            [[ -z "$new_val" ]] && continue
+            local pct verdict
+            pct=$(awk -v o="$old_val" -v n="$new_val" 'BEGIN { printf "%+.1f", (o > 0) ? (n - o) * 100 / o : 0 }')
+            verdict=$(awk -v p="$pct" -v t="$BENCH_THRESHOLD" 'BEGIN { print ((p > t) ? "slower" : (p < -t) ? "faster" : "same") }')
+            local delta_str
+            case "$verdict" in
+                slower)
+                    delta_str="${RED}${pct}% REGRESSION${NC}"
+                    regressions=$((regressions + 1))
+                    ;;
+                faster) delta_str="${GREEN}${pct}%${NC}" ;;
+                *) delta_str="${pct}%" ;;
+            esac
+            printf "%-32s %14s %14s " "$name" "$old_val" "$new_val"
+            echo -e "$delta_str"
+        done
+    fi
+
     echo ""
+    if (( regressions > 0 )); then
+        echo -e "${RED}${regressions} microbenchmark(s) regressed by more than ${BENCH_THRESHOLD}%${NC}"
+        return 1
+    fi
     echo -e "${GREEN}Done!${NC}"
 }
 